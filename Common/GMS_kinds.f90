@@ -40,7 +40,7 @@ module mod_kinds
     ! Tab:10,11 col - Type , function and subroutine code blocks.
      
     use ISO_FORTRAN_ENV, only : INT8,INT16,INT32,INT64
-    use intrinsic :: IEEE_ARITHMETIC
+    use, intrinsic :: IEEE_ARITHMETIC
     implicit none
     
     ! Integral intrinsic primitives
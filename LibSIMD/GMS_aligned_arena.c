@@ -0,0 +1,583 @@
+
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "GMS_aligned_arena.h"
+
+
+#if !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+
+#define GMS_PAGE_2M   (2097152UL)
+#define GMS_PAGE_1G   (1073741824UL)
+#define GMS_MPOL_PREFERRED 1
+#define GMS_CHUNK_HDR GMS_MEM_ALIGN
+
+
+            struct gms_arena_chunk_t {
+
+                   gms_arena_chunk_t * next;
+                   size_t              size;   // mapped bytes (incl. header)
+                   size_t              off;    // next free byte relative to the chunk
+            };
+
+
+            typedef struct gms_slab_t {
+
+                   struct gms_slab_t * next;
+                   void *              base;
+                   size_t              size;
+            } gms_slab_t;
+
+
+            struct gms_pool_t {
+
+                   int32_t             flags;
+                   pthread_mutex_t     lock[GMS_POOL_NCLASSES];
+                   void *              freelist[GMS_POOL_NCLASSES];
+                   pthread_mutex_t     slab_lock;
+                   gms_slab_t *        slabs;
+                   size_t              requested;
+                   size_t              in_use;
+                   size_t              peak;
+                   size_t              reserved;
+                   size_t              nallocs;
+                   size_t              nfrees;
+                   size_t              nregions;
+            };
+
+
+            static gms_mem_hook_t g_hook      = NULL;
+            static void *         g_hook_user = NULL;
+
+
+            __attribute__((always_inline))
+            static inline
+            size_t round_up(const size_t x,
+                            const size_t a) {
+                   return ((x+a-1)&~(a-1));
+            }
+
+
+            __attribute__((always_inline))
+            static inline
+            void finish_stats(gms_mem_stats_t * __restrict s) {
+                   s->fragmentation = (s->reserved > 0) ?
+                                      1.0-(double)s->requested/(double)s->reserved : 0.0;
+            }
+
+
+            __attribute__((always_inline))
+            static inline
+            void call_hook(const char * __restrict who,
+                           gms_mem_stats_t * __restrict s) {
+                   gms_mem_hook_t h = g_hook;
+                   if(NULL != h) {
+                      finish_stats(s);
+                      h(who,s,g_hook_user);
+                   }
+            }
+
+
+            static
+            void bind_local_node(void * __restrict p,
+                                 const size_t len) {
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+                   unsigned int cpu  = 0U;
+                   unsigned int node = 0U;
+                   unsigned long mask[16];
+                   if(syscall(SYS_getcpu,&cpu,&node,NULL) != 0) { return;}
+                   if(node >= 16U*8U*sizeof(unsigned long)) { return;}
+                   memset(&mask[0],0,sizeof(mask));
+                   mask[node/(8U*sizeof(unsigned long))] |= 1UL<<(node%(8U*sizeof(unsigned long)));
+                   // Best effort: a failing mbind (no NUMA, no permission) leaves first-touch.
+                   (void)syscall(SYS_mbind,p,len,GMS_MPOL_PREFERRED,&mask[0],
+                                 (unsigned long)(16U*8U*sizeof(unsigned long)),0U);
+#else
+                   (void)p; (void)len;
+#endif
+            }
+
+
+            void *
+            gms_region_map(const size_t bytes,
+                           const int32_t flags,
+                           size_t * __restrict mapped) {
+
+                   void * p = MAP_FAILED;
+                   size_t len = 0;
+                   const size_t pg = (size_t)sysconf(_SC_PAGESIZE);
+                   // Page rounding (up to 1GiB plus the 2MiB trim slack) must not wrap.
+                   if(__builtin_expect(0==bytes,0) ||
+                      __builtin_expect(bytes > SIZE_MAX-2*GMS_PAGE_1G,0)) { return (NULL);}
+#if defined(MAP_HUGETLB)
+                   if(flags & GMS_MEM_HUGE_1G) {
+                      len = round_up(bytes,GMS_PAGE_1G);
+                      p = mmap(NULL,len,PROT_READ|PROT_WRITE,
+                               MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|(30<<MAP_HUGE_SHIFT),-1,0);
+                   }
+                   if(p == MAP_FAILED && (flags & (GMS_MEM_HUGE_2M|GMS_MEM_HUGE_1G))) {
+                      len = round_up(bytes,GMS_PAGE_2M);
+                      p = mmap(NULL,len,PROT_READ|PROT_WRITE,
+                               MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|(21<<MAP_HUGE_SHIFT),-1,0);
+                   }
+#endif
+                   if(p == MAP_FAILED && (flags & (GMS_MEM_HUGE_2M|GMS_MEM_HUGE_1G))) {
+                      // No reserved huge pages: over-map, trim to a 2MiB boundary, ask for THP.
+                      const size_t want = round_up(bytes,GMS_PAGE_2M);
+                      char * raw = (char*)mmap(NULL,want+GMS_PAGE_2M,PROT_READ|PROT_WRITE,
+                                               MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+                      if(raw != (char*)MAP_FAILED) {
+                         char * al = (char*)round_up((size_t)raw,GMS_PAGE_2M);
+                         const size_t head = (size_t)(al-raw);
+                         const size_t tail = GMS_PAGE_2M-head;
+                         if(head) { munmap(raw,head);}
+                         if(tail) { munmap(al+want,tail);}
+#if defined(MADV_HUGEPAGE)
+                         (void)madvise(al,want,MADV_HUGEPAGE);
+#endif
+                         p   = al;
+                         len = want;
+                      }
+                   }
+                   if(p == MAP_FAILED) {
+                      len = round_up(bytes,pg);
+                      p = mmap(NULL,len,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+                      if(p == MAP_FAILED) { return (NULL);}
+                   }
+                   if(flags & GMS_MEM_NUMA_LOCAL) {
+                      bind_local_node(p,len);
+                   }
+                   if(flags & GMS_MEM_PREFAULT) {
+                      // Touch after mbind so the pages land on the requested node.
+                      volatile char * q = (volatile char*)p;
+                      size_t i;
+                      for(i = 0; i < len; i += pg) { q[i] = 0;}
+                   }
+                   if(NULL != mapped) { *mapped = len;}
+                   return (p);
+            }
+
+
+            void
+            gms_region_unmap(void * __restrict p,
+                             const size_t len) {
+                   if(NULL != p && len > 0) { munmap(p,len);}
+            }
+
+
+            static
+            gms_arena_chunk_t * new_chunk(const size_t bytes,
+                                          const int32_t flags) {
+                   size_t len = 0;
+                   gms_arena_chunk_t * c = (gms_arena_chunk_t*)gms_region_map(bytes,flags,&len);
+                   if(NULL == c) { return (NULL);}
+                   c->next = NULL;
+                   c->size = len;
+                   c->off  = GMS_CHUNK_HDR;
+                   return (c);
+            }
+
+
+            gms_arena_t *
+            gms_arena_create(const size_t chunk,
+                             const int32_t flags) {
+
+                   gms_arena_t * a = (gms_arena_t*)malloc(sizeof(gms_arena_t));
+                   if(NULL == a) { return (NULL);}
+                   memset(a,0,sizeof(gms_arena_t));
+                   a->chunk = (chunk > 0) ? chunk : (size_t)GMS_ARENA_TLS_CHUNK;
+                   a->flags = flags;
+                   a->first = new_chunk(a->chunk,flags);
+                   if(NULL == a->first) {
+                      free(a);
+                      return (NULL);
+                   }
+                   a->cur = a->first;
+                   a->stats.reserved = a->first->size;
+                   a->stats.nregions = 1;
+                   call_hook("arena",&a->stats);
+                   return (a);
+            }
+
+
+            void
+            gms_arena_destroy(gms_arena_t * __restrict a) {
+                   gms_arena_chunk_t * c;
+                   if(NULL == a) { return;}
+                   c = a->first;
+                   while(NULL != c) {
+                         gms_arena_chunk_t * nx = c->next;
+                         gms_region_unmap(c,c->size);
+                         c = nx;
+                   }
+                   free(a);
+            }
+
+
+            void *
+            gms_arena_alloc(gms_arena_t * __restrict a,
+                            const size_t bytes,
+                            const size_t align) {
+
+                   const size_t al = (align > GMS_MEM_ALIGN) ? align : GMS_MEM_ALIGN;
+                   if(__builtin_expect(NULL==a,0) ||
+                      __builtin_expect(0==bytes,0) ||
+                      __builtin_expect((al&(al-1))!=0,0)) { return (NULL);}
+                   for(;;) {
+                       gms_arena_chunk_t * c = a->cur;
+                       const size_t base = (size_t)c;
+                       const size_t off  = round_up(base+c->off,al)-base;
+                       if(__builtin_expect(off <= c->size && bytes <= c->size-off,1)) {
+                          a->stats.in_use    += (off-c->off)+bytes;
+                          a->stats.requested += bytes;
+                          a->stats.nallocs   += 1;
+                          if(a->stats.in_use > a->stats.peak) { a->stats.peak = a->stats.in_use;}
+                          c->off = off+bytes;
+                          return ((void*)(base+off));
+                       }
+                       if(NULL != c->next) {
+                          // Chunk kept from before a rewind/reset.
+                          a->stats.in_use += c->size-c->off;
+                          c->off = c->size;
+                          a->cur = c->next;
+                          a->cur->off = GMS_CHUNK_HDR;
+                          continue;
+                       }
+                       if(__builtin_expect(bytes > SIZE_MAX-al-GMS_CHUNK_HDR,0)) { return (NULL);}
+                       {
+                          const size_t need = bytes+al+GMS_CHUNK_HDR;
+                          gms_arena_chunk_t * nc = new_chunk(need > a->chunk ? need : a->chunk,a->flags);
+                          if(NULL == nc) { return (NULL);}
+                          a->stats.in_use += c->size-c->off;
+                          c->off  = c->size;
+                          c->next = nc;
+                          a->cur  = nc;
+                          a->stats.reserved += nc->size;
+                          a->stats.nregions += 1;
+                          call_hook("arena",&a->stats);
+                       }
+                   }
+            }
+
+
+            float *
+            gms_arena_alloc_r4(gms_arena_t * __restrict a,
+                               const size_t n) {
+                   if(__builtin_expect(n > SIZE_MAX/sizeof(float),0)) { return (NULL);}
+                   return ((float*)gms_arena_alloc(a,n*sizeof(float),GMS_MEM_ALIGN));
+            }
+
+
+            double *
+            gms_arena_alloc_r8(gms_arena_t * __restrict a,
+                               const size_t n) {
+                   if(__builtin_expect(n > SIZE_MAX/sizeof(double),0)) { return (NULL);}
+                   return ((double*)gms_arena_alloc(a,n*sizeof(double),GMS_MEM_ALIGN));
+            }
+
+
+            gms_arena_mark_t
+            gms_arena_mark(const gms_arena_t * __restrict a) {
+                   gms_arena_mark_t m;
+                   m.chunk     = a->cur;
+                   m.offset    = a->cur->off;
+                   m.requested = a->stats.requested;
+                   m.in_use    = a->stats.in_use;
+                   return (m);
+            }
+
+
+            void
+            gms_arena_rewind(gms_arena_t * __restrict a,
+                             const gms_arena_mark_t m) {
+                   if(__builtin_expect(NULL==a,0) ||
+                      __builtin_expect(NULL==m.chunk,0)) { return;}
+                   a->cur = m.chunk;
+                   a->cur->off = m.offset;
+                   a->stats.requested = m.requested;
+                   a->stats.in_use    = m.in_use;
+                   a->stats.nfrees   += 1;
+            }
+
+
+            void
+            gms_arena_reset(gms_arena_t * __restrict a) {
+                   if(__builtin_expect(NULL==a,0)) { return;}
+                   a->cur = a->first;
+                   a->cur->off = GMS_CHUNK_HDR;
+                   a->stats.requested = 0;
+                   a->stats.in_use    = 0;
+                   a->stats.nfrees   += 1;
+            }
+
+
+            void
+            gms_arena_get_stats(const gms_arena_t * __restrict a,
+                                gms_mem_stats_t * __restrict s) {
+                   if(NULL == a || NULL == s) { return;}
+                   *s = a->stats;
+                   finish_stats(s);
+            }
+
+
+            static pthread_key_t  g_tls_key;
+            static pthread_once_t g_tls_once = PTHREAD_ONCE_INIT;
+            static __thread gms_arena_t * t_arena = NULL;
+
+
+            static
+            void tls_arena_dtor(void * p) {
+                   gms_arena_destroy((gms_arena_t*)p);
+            }
+
+
+            static
+            void tls_key_init(void) {
+                   (void)pthread_key_create(&g_tls_key,tls_arena_dtor);
+            }
+
+
+            gms_arena_t *
+            gms_arena_thread(void) {
+                   if(__builtin_expect(NULL!=t_arena,1)) { return (t_arena);}
+                   pthread_once(&g_tls_once,tls_key_init);
+                   t_arena = gms_arena_create(GMS_ARENA_TLS_CHUNK,GMS_ARENA_TLS_FLAGS);
+                   if(NULL != t_arena) {
+                      (void)pthread_setspecific(g_tls_key,t_arena);
+                   }
+                   return (t_arena);
+            }
+
+
+/*
+     Pools.
+*/
+
+            __attribute__((always_inline))
+            static inline
+            void stat_add(size_t * __restrict p,
+                          const size_t v) {
+                   __atomic_fetch_add(p,v,__ATOMIC_RELAXED);
+            }
+
+
+            __attribute__((always_inline))
+            static inline
+            void stat_sub(size_t * __restrict p,
+                          const size_t v) {
+                   __atomic_fetch_sub(p,v,__ATOMIC_RELAXED);
+            }
+
+
+            __attribute__((always_inline))
+            static inline
+            void stat_peak(gms_pool_t * __restrict pl,
+                           const size_t v) {
+                   size_t cur = __atomic_load_n(&pl->peak,__ATOMIC_RELAXED);
+                   while(v > cur &&
+                         !__atomic_compare_exchange_n(&pl->peak,&cur,v,1,
+                                                      __ATOMIC_RELAXED,__ATOMIC_RELAXED)) {}
+            }
+
+
+            __attribute__((always_inline))
+            static inline
+            int32_t size_class(const size_t bytes) {
+                   int32_t k = 0;
+                   size_t  c = GMS_MEM_ALIGN;
+                   while(c < bytes && k < GMS_POOL_NCLASSES) {
+                         c <<= 1;
+                         ++k;
+                   }
+                   return (k);
+            }
+
+
+            static
+            void snapshot(gms_pool_t * __restrict pl,
+                          gms_mem_stats_t * __restrict s) {
+                   s->requested = __atomic_load_n(&pl->requested,__ATOMIC_RELAXED);
+                   s->in_use    = __atomic_load_n(&pl->in_use,__ATOMIC_RELAXED);
+                   s->peak      = __atomic_load_n(&pl->peak,__ATOMIC_RELAXED);
+                   s->reserved  = __atomic_load_n(&pl->reserved,__ATOMIC_RELAXED);
+                   s->nallocs   = __atomic_load_n(&pl->nallocs,__ATOMIC_RELAXED);
+                   s->nfrees    = __atomic_load_n(&pl->nfrees,__ATOMIC_RELAXED);
+                   s->nregions  = __atomic_load_n(&pl->nregions,__ATOMIC_RELAXED);
+                   finish_stats(s);
+            }
+
+
+            static
+            void region_mapped(gms_pool_t * __restrict pl,
+                               const size_t len) {
+                   stat_add(&pl->reserved,len);
+                   stat_add(&pl->nregions,1);
+                   if(NULL != g_hook) {
+                      gms_mem_stats_t s;
+                      snapshot(pl,&s);
+                      call_hook("pool",&s);
+                   }
+            }
+
+
+            gms_pool_t *
+            gms_pool_create(const int32_t flags) {
+                   gms_pool_t * pl = (gms_pool_t*)malloc(sizeof(gms_pool_t));
+                   int32_t k;
+                   if(NULL == pl) { return (NULL);}
+                   memset(pl,0,sizeof(gms_pool_t));
+                   pl->flags = flags;
+                   for(k = 0; k != GMS_POOL_NCLASSES; ++k) {
+                       pthread_mutex_init(&pl->lock[k],NULL);
+                   }
+                   pthread_mutex_init(&pl->slab_lock,NULL);
+                   return (pl);
+            }
+
+
+            void
+            gms_pool_destroy(gms_pool_t * __restrict pl) {
+                   gms_slab_t * s;
+                   int32_t k;
+                   if(NULL == pl) { return;}
+                   s = pl->slabs;
+                   while(NULL != s) {
+                         gms_slab_t * nx = s->next;
+                         gms_region_unmap(s->base,s->size);
+                         free(s);
+                         s = nx;
+                   }
+                   for(k = 0; k != GMS_POOL_NCLASSES; ++k) {
+                       pthread_mutex_destroy(&pl->lock[k]);
+                   }
+                   pthread_mutex_destroy(&pl->slab_lock);
+                   free(pl);
+            }
+
+
+            // Called with lock[k] held.
+            static
+            int32_t refill(gms_pool_t * __restrict pl,
+                           const int32_t k) {
+                   const size_t bsz = (size_t)GMS_MEM_ALIGN<<k;
+                   const size_t want = bsz > GMS_POOL_SLAB ? bsz : (size_t)GMS_POOL_SLAB;
+                   gms_slab_t * node = (gms_slab_t*)malloc(sizeof(gms_slab_t));
+                   size_t len = 0;
+                   char * base;
+                   size_t i,nb;
+                   if(NULL == node) { return (-1);}
+                   base = (char*)gms_region_map(want,pl->flags,&len);
+                   if(NULL == base) {
+                      free(node);
+                      return (-1);
+                   }
+                   node->base = base;
+                   node->size = len;
+                   pthread_mutex_lock(&pl->slab_lock);
+                   node->next = pl->slabs;
+                   pl->slabs  = node;
+                   pthread_mutex_unlock(&pl->slab_lock);
+                   nb = len/bsz;
+                   for(i = 0; i != nb; ++i) {
+                       void ** blk = (void**)(base+i*bsz);
+                       *blk = pl->freelist[k];
+                       pl->freelist[k] = blk;
+                   }
+                   region_mapped(pl,len);
+                   return (0);
+            }
+
+
+            void *
+            gms_pool_alloc(gms_pool_t * __restrict pl,
+                           const size_t bytes) {
+
+                   int32_t k;
+                   void ** blk;
+                   if(__builtin_expect(NULL==pl,0) ||
+                      __builtin_expect(0==bytes,0)) { return (NULL);}
+                   k = size_class(bytes);
+                   if(__builtin_expect(k >= GMS_POOL_NCLASSES,0)) {
+                      // Direct mapping; the header keeps the mapped length.
+                      size_t len = 0;
+                      char * base;
+                      if(__builtin_expect(bytes > SIZE_MAX-GMS_MEM_ALIGN,0)) { return (NULL);}
+                      base = (char*)gms_region_map(bytes+GMS_MEM_ALIGN,pl->flags,&len);
+                      if(NULL == base) { return (NULL);}
+                      *(size_t*)base = len;
+                      region_mapped(pl,len);
+                      stat_add(&pl->requested,bytes);
+                      stat_add(&pl->in_use,len);
+                      stat_add(&pl->nallocs,1);
+                      stat_peak(pl,__atomic_load_n(&pl->in_use,__ATOMIC_RELAXED));
+                      return ((void*)(base+GMS_MEM_ALIGN));
+                   }
+                   pthread_mutex_lock(&pl->lock[k]);
+                   if(NULL == pl->freelist[k] && refill(pl,k) != 0) {
+                      pthread_mutex_unlock(&pl->lock[k]);
+                      return (NULL);
+                   }
+                   blk = (void**)pl->freelist[k];
+                   pl->freelist[k] = *blk;
+                   pthread_mutex_unlock(&pl->lock[k]);
+                   stat_add(&pl->requested,bytes);
+                   stat_add(&pl->in_use,(size_t)GMS_MEM_ALIGN<<k);
+                   stat_add(&pl->nallocs,1);
+                   stat_peak(pl,__atomic_load_n(&pl->in_use,__ATOMIC_RELAXED));
+                   return ((void*)blk);
+            }
+
+
+            void
+            gms_pool_free(gms_pool_t * __restrict pl,
+                          void * __restrict p,
+                          const size_t bytes) {
+
+                   int32_t k;
+                   if(__builtin_expect(NULL==pl,0) ||
+                      __builtin_expect(NULL==p,0)) { return;}
+                   k = size_class(bytes);
+                   if(__builtin_expect(k >= GMS_POOL_NCLASSES,0)) {
+                      char * base = (char*)p-GMS_MEM_ALIGN;
+                      const size_t len = *(size_t*)base;
+                      gms_region_unmap(base,len);
+                      stat_sub(&pl->requested,bytes);
+                      stat_sub(&pl->in_use,len);
+                      stat_sub(&pl->reserved,len);
+                      stat_sub(&pl->nregions,1);
+                      stat_add(&pl->nfrees,1);
+                      return;
+                   }
+                   pthread_mutex_lock(&pl->lock[k]);
+                   *(void**)p = pl->freelist[k];
+                   pl->freelist[k] = p;
+                   pthread_mutex_unlock(&pl->lock[k]);
+                   stat_sub(&pl->requested,bytes);
+                   stat_sub(&pl->in_use,(size_t)GMS_MEM_ALIGN<<k);
+                   stat_add(&pl->nfrees,1);
+            }
+
+
+            void
+            gms_pool_get_stats(gms_pool_t * __restrict pl,
+                               gms_mem_stats_t * __restrict s) {
+                   if(NULL == pl || NULL == s) { return;}
+                   snapshot(pl,s);
+            }
+
+
+            void
+            gms_mem_set_hook(gms_mem_hook_t hook,
+                             void * __restrict user) {
+                   g_hook_user = user;
+                   g_hook      = hook;
+            }
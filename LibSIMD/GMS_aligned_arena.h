@@ -0,0 +1,215 @@
+
+
+#ifndef __GMS_ALIGNED_ARENA_H__
+#define __GMS_ALIGNED_ARENA_H__ 181020261330
+
+
+
+    const unsigned int gGMS_ALIGNED_ARENA_MAJOR = 1U;
+    const unsigned int gGMS_ALIGNED_ARENA_MINOR = 0U;
+    const unsigned int gGMS_ALIGNED_ARENA_MICRO = 0U;
+    const unsigned int gGMS_ALIGNED_ARENA_FULLVER =
+      1000U*gGMS_ALIGNED_ARENA_MAJOR+
+      100U*gGMS_ALIGNED_ARENA_MINOR+
+      10U*gGMS_ALIGNED_ARENA_MICRO;
+    const char * const pgGMS_ALIGNED_ARENA_CREATION_DATE = "18-10-2026 13:30 PM +00200 (SUN 18 OCT 2026 GMT+2)";
+    const char * const pgGMS_ALIGNED_ARENA_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const pgGMS_ALIGNED_ARENA_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const pgGMS_ALIGNED_ARENA_DESCRIPTION   = "Aligned arena/pool allocators for the _a (aligned) SIMD kernels.";
+
+
+/*
+     Allocation subsystem for the aligned (_a) kernel variants.
+     Every pointer returned is at least 64-byte aligned (one ZMM register,
+     one cache line).
+       1) Regions   -> mmap-backed memory, optionally on huge pages
+                       (2MiB via MAP_HUGETLB or THP madvise, 1GiB via MAP_HUGETLB),
+                       optionally bound to the calling thread's NUMA node
+                       (mbind before first touch) and pre-faulted.
+       2) Arenas    -> bump allocators over chained regions, single-threaded.
+                       Mark/rewind and reset make per-frame scratch buffers free
+                       of allocation churn and of page faults after the first frame.
+                       gms_arena_thread() returns a lazily created per-thread arena.
+       3) Pools     -> thread-safe size-class pools (64B .. 512KiB, powers of two)
+                       carved from slabs, with sized free. Larger requests are
+                       mapped directly.
+     Statistics (in-use, peak, reserved, fragmentation) are available on demand
+     and through an optional hook called whenever a new region is mapped.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#define GMS_MEM_DEFAULT     0
+#define GMS_MEM_HUGE_2M     1
+#define GMS_MEM_HUGE_1G     2
+#define GMS_MEM_NUMA_LOCAL  4
+#define GMS_MEM_PREFAULT    8
+
+#if !defined(GMS_MEM_ALIGN)
+    #define GMS_MEM_ALIGN 64
+#endif
+
+// Default chunk size of the per-thread arenas.
+#if !defined(GMS_ARENA_TLS_CHUNK)
+    #define GMS_ARENA_TLS_CHUNK 16777216
+#endif
+
+#if !defined(GMS_ARENA_TLS_FLAGS)
+    #define GMS_ARENA_TLS_FLAGS (GMS_MEM_HUGE_2M|GMS_MEM_NUMA_LOCAL)
+#endif
+
+#if !defined(GMS_POOL_NCLASSES)
+    #define GMS_POOL_NCLASSES 14
+#endif
+
+#if !defined(GMS_POOL_SLAB)
+    #define GMS_POOL_SLAB 2097152
+#endif
+
+
+        typedef struct gms_mem_stats_t {
+
+                size_t  requested;   // live bytes as requested by the callers
+                size_t  in_use;      // live bytes incl. alignment padding/class rounding
+                size_t  peak;        // high-water mark of in_use
+                size_t  reserved;    // bytes mapped from the OS
+                size_t  nallocs;
+                size_t  nfrees;
+                size_t  nregions;
+                double  fragmentation; // 1 - requested/reserved
+        } gms_mem_stats_t;
+
+
+        typedef void (*gms_mem_hook_t)(const char * __restrict,
+                                       const gms_mem_stats_t * __restrict,
+                                       void * __restrict);
+
+
+        typedef struct gms_arena_chunk_t gms_arena_chunk_t;
+
+        typedef struct gms_arena_t {
+
+                gms_arena_chunk_t * first;
+                gms_arena_chunk_t * cur;
+                size_t              chunk;
+                int32_t             flags;
+                gms_mem_stats_t     stats;
+        } gms_arena_t;
+
+
+        typedef struct gms_arena_mark_t {
+
+                gms_arena_chunk_t * chunk;
+                size_t              offset;
+                size_t              requested;
+                size_t              in_use;
+        } gms_arena_mark_t;
+
+
+        typedef struct gms_pool_t gms_pool_t;
+
+
+        // Regions
+        void *
+        gms_region_map(const size_t,
+                       const int32_t,
+                       size_t * __restrict)           __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_region_unmap(void * __restrict,
+                         const size_t)                __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        // Arenas
+        gms_arena_t *
+        gms_arena_create(const size_t,
+                         const int32_t)               __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_arena_destroy(gms_arena_t * __restrict)   __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        void *
+        gms_arena_alloc(gms_arena_t * __restrict,
+                        const size_t,
+                        const size_t)                 __attribute__((hot))
+                                                      __attribute__((malloc))
+                                                      __attribute__((aligned(32)));
+
+        float *
+        gms_arena_alloc_r4(gms_arena_t * __restrict,
+                           const size_t)              __attribute__((hot))
+                                                      __attribute__((malloc))
+                                                      __attribute__((aligned(32)));
+
+        double *
+        gms_arena_alloc_r8(gms_arena_t * __restrict,
+                           const size_t)              __attribute__((hot))
+                                                      __attribute__((malloc))
+                                                      __attribute__((aligned(32)));
+
+        gms_arena_mark_t
+        gms_arena_mark(const gms_arena_t * __restrict) __attribute__((hot))
+                                                       __attribute__((aligned(32)));
+
+        void
+        gms_arena_rewind(gms_arena_t * __restrict,
+                         const gms_arena_mark_t)      __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_arena_reset(gms_arena_t * __restrict)     __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+        gms_arena_t *
+        gms_arena_thread(void)                        __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_arena_get_stats(const gms_arena_t * __restrict,
+                            gms_mem_stats_t * __restrict) __attribute__((cold))
+                                                          __attribute__((aligned(32)));
+
+        // Pools
+        gms_pool_t *
+        gms_pool_create(const int32_t)                __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_pool_destroy(gms_pool_t * __restrict)     __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+        void *
+        gms_pool_alloc(gms_pool_t * __restrict,
+                       const size_t)                  __attribute__((hot))
+                                                      __attribute__((malloc))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_pool_free(gms_pool_t * __restrict,
+                      void * __restrict,
+                      const size_t)                   __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+        void
+        gms_pool_get_stats(gms_pool_t * __restrict,
+                           gms_mem_stats_t * __restrict) __attribute__((cold))
+                                                         __attribute__((aligned(32)));
+
+        // Hook called (with the owner's name and stats) on every region mapping.
+        void
+        gms_mem_set_hook(gms_mem_hook_t,
+                         void * __restrict)           __attribute__((cold))
+                                                      __attribute__((aligned(32)));
+
+
+
+
+
+
+
+#endif /*__GMS_ALIGNED_ARENA_H__*/
@@ -0,0 +1,537 @@
+
+
+#include <omp.h>
+#include "GMS_fdiff_tabulated_avx512.h"
+
+
+/*
+     Stencil weights (already scaled by 1/h) of node j on a uniform grid.
+     Returns the number of points, r0 is the index of the first one.
+*/
+                        __attribute__((always_inline))
+                        static inline
+                        int32_t uni_weights(const int64_t j,
+                                            const int64_t n,
+                                            const double h,
+                                            double * __restrict w,
+                                            int64_t * __restrict r0) {
+
+                             if(n >= 5) {
+                                const double r12h = 1.0/(12.0*h);
+                                if(j == 0) {
+                                   *r0 = 0;
+                                   w[0] = -25.0*r12h; w[1] = 48.0*r12h; w[2] = -36.0*r12h;
+                                   w[3] = 16.0*r12h;  w[4] = -3.0*r12h;
+                                }
+                                else if(j == 1) {
+                                   *r0 = 0;
+                                   w[0] = -3.0*r12h; w[1] = -10.0*r12h; w[2] = 18.0*r12h;
+                                   w[3] = -6.0*r12h; w[4] = r12h;
+                                }
+                                else if(j == n-2) {
+                                   *r0 = n-5;
+                                   w[0] = -r12h;      w[1] = 6.0*r12h; w[2] = -18.0*r12h;
+                                   w[3] = 10.0*r12h;  w[4] = 3.0*r12h;
+                                }
+                                else if(j == n-1) {
+                                   *r0 = n-5;
+                                   w[0] = 3.0*r12h;   w[1] = -16.0*r12h; w[2] = 36.0*r12h;
+                                   w[3] = -48.0*r12h; w[4] = 25.0*r12h;
+                                }
+                                else {
+                                   *r0 = j-2;
+                                   w[0] = r12h;      w[1] = -8.0*r12h; w[2] = 0.0;
+                                   w[3] = 8.0*r12h;  w[4] = -r12h;
+                                }
+                                return (5);
+                             }
+                             else if(n >= 3) {
+                                const double r2h = 0.5/h;
+                                if(j == 0) {
+                                   *r0 = 0;
+                                   w[0] = -3.0*r2h; w[1] = 4.0*r2h; w[2] = -r2h;
+                                }
+                                else if(j == n-1) {
+                                   *r0 = n-3;
+                                   w[0] = r2h; w[1] = -4.0*r2h; w[2] = 3.0*r2h;
+                                }
+                                else {
+                                   *r0 = j-1;
+                                   w[0] = -r2h; w[1] = 0.0; w[2] = r2h;
+                                }
+                                return (3);
+                             }
+                             *r0 = 0;
+                             w[0] = -1.0/h; w[1] = 1.0/h;
+                             return (2);
+                        }
+
+
+/*
+     Lagrange weights of node j on a non-uniform grid x[0..n-1].
+*/
+                        __attribute__((always_inline))
+                        static inline
+                        int32_t nonuni_weights(const double * __restrict x,
+                                               const int64_t j,
+                                               const int64_t n,
+                                               double * __restrict w,
+                                               int64_t * __restrict r0) {
+
+                             double h1,h2,s;
+                             if(n < 3) {
+                                const double rh = 1.0/(x[1]-x[0]);
+                                *r0 = 0;
+                                w[0] = -rh; w[1] = rh;
+                                return (2);
+                             }
+                             if(j == 0) {
+                                h1 = x[1]-x[0];
+                                h2 = x[2]-x[1];
+                                s  = h1+h2;
+                                *r0 = 0;
+                                w[0] = -(2.0*h1+h2)/(h1*s);
+                                w[1] = s/(h1*h2);
+                                w[2] = -h1/(h2*s);
+                             }
+                             else if(j == n-1) {
+                                h1 = x[n-2]-x[n-3];
+                                h2 = x[n-1]-x[n-2];
+                                s  = h1+h2;
+                                *r0 = n-3;
+                                w[0] = h2/(h1*s);
+                                w[1] = -s/(h1*h2);
+                                w[2] = (2.0*h2+h1)/(h2*s);
+                             }
+                             else {
+                                h1 = x[j]-x[j-1];
+                                h2 = x[j+1]-x[j];
+                                s  = h1+h2;
+                                *r0 = j-1;
+                                w[0] = -h2/(h1*s);
+                                w[1] = (h2-h1)/(h1*h2);
+                                w[2] = h1/(h2*s);
+                             }
+                             return (3);
+                        }
+
+
+                        __attribute__((always_inline))
+                        static inline
+                        int32_t use_streaming(const double * D,
+                                              const int64_t nelems) {
+                             return ((nelems*(int64_t)sizeof(double)) >= (int64_t)GMS_FDIFF_NT_THRESHOLD &&
+                                     ((uintptr_t)D & 63) == 0);
+                        }
+
+
+/*
+     D[k] = sum_p w[p]*F[(r0+p)*inner+k], k = 0..inner-1.
+     Every stencil point is a contiguous row, hence full-width loads.
+*/
+                        static
+                        void apply_rows(const double * __restrict F,
+                                        double * __restrict D,
+                                        const int64_t inner,
+                                        const int32_t np,
+                                        const double * __restrict w,
+                                        const int64_t r0,
+                                        const int32_t nt) {
+
+                             const double * __restrict R[5];
+                             __m512d vw[5];
+                             int64_t k;
+                             int32_t p;
+                             const int32_t stream = nt && ((uintptr_t)D & 63) == 0;
+                             for(p = 0; p != np; ++p) {
+                                 R[p]  = &F[(r0+p)*inner];
+                                 vw[p] = _mm512_set1_pd(w[p]);
+                             }
+                             for(k = 0; (k+7) < inner; k += 8) {
+                                 __m512d acc = _mm512_mul_pd(vw[0],_mm512_loadu_pd(&R[0][k]));
+                                 for(p = 1; p != np; ++p) {
+                                     acc = _mm512_fmadd_pd(vw[p],_mm512_loadu_pd(&R[p][k]),acc);
+                                 }
+                                 if(stream) {
+                                    _mm512_stream_pd(&D[k],acc);
+                                 }
+                                 else {
+                                    _mm512_storeu_pd(&D[k],acc);
+                                 }
+                             }
+                             if(k < inner) {
+                                const __mmask8 m = (__mmask8)((1U<<(inner-k))-1U);
+                                __m512d acc = _mm512_mul_pd(vw[0],_mm512_maskz_loadu_pd(m,&R[0][k]));
+                                for(p = 1; p != np; ++p) {
+                                    acc = _mm512_fmadd_pd(vw[p],_mm512_maskz_loadu_pd(m,&R[p][k]),acc);
+                                }
+                                _mm512_mask_storeu_pd(&D[k],m,acc);
+                             }
+                        }
+
+
+                        // Boundary (scalar) node of a contiguous line.
+                        __attribute__((always_inline))
+                        static inline
+                        double dot_stencil(const double * __restrict f,
+                                           const int32_t np,
+                                           const double * __restrict w,
+                                           const int64_t r0) {
+                             double s = 0.0;
+                             int32_t p;
+                             for(p = 0; p != np; ++p) {
+                                 s += w[p]*f[r0+p];
+                             }
+                             return (s);
+                        }
+
+
+                        static
+                        void line_uni(const double * __restrict f,
+                                      double * __restrict df,
+                                      const int64_t n,
+                                      const double h,
+                                      const int32_t nt) {
+
+                             double w[5];
+                             int64_t r0;
+                             int64_t i;
+                             int32_t np;
+                             if(n < 5) {
+                                for(i = 0; i != n; ++i) {
+                                    np = uni_weights(i,n,h,&w[0],&r0);
+                                    df[i] = dot_stencil(f,np,&w[0],r0);
+                                }
+                                return;
+                             }
+                             np = uni_weights(0,n,h,&w[0],&r0);
+                             df[0]   = dot_stencil(f,np,&w[0],r0);
+                             np = uni_weights(1,n,h,&w[0],&r0);
+                             df[1]   = dot_stencil(f,np,&w[0],r0);
+                             np = uni_weights(n-2,n,h,&w[0],&r0);
+                             df[n-2] = dot_stencil(f,np,&w[0],r0);
+                             np = uni_weights(n-1,n,h,&w[0],&r0);
+                             df[n-1] = dot_stencil(f,np,&w[0],r0);
+                             // Interior: (f[i-2]-f[i+2] + 8*(f[i+1]-f[i-1]))/(12h)
+                             const double r12h = 1.0/(12.0*h);
+                             const __m512d vr12h = _mm512_set1_pd(r12h);
+                             const __m512d v8    = _mm512_set1_pd(8.0);
+                             const int64_t iend  = n-2;
+                             i = 2;
+                             if(nt) {
+                                // Peel up to the first 64-byte aligned output.
+                                while(i < iend && ((uintptr_t)&df[i] & 63) != 0) {
+                                      df[i] = (f[i-2]-f[i+2]+8.0*(f[i+1]-f[i-1]))*r12h;
+                                      ++i;
+                                }
+                                for(; (i+15) < iend; i += 16) {
+                                    __m512d a0,a1;
+                                    _mm_prefetch((const char*)&f[i+64],_MM_HINT_T0);
+                                    a0 = _mm512_sub_pd(_mm512_loadu_pd(&f[i-2]),_mm512_loadu_pd(&f[i+2]));
+                                    a1 = _mm512_sub_pd(_mm512_loadu_pd(&f[i+6]),_mm512_loadu_pd(&f[i+10]));
+                                    a0 = _mm512_fmadd_pd(v8,_mm512_sub_pd(_mm512_loadu_pd(&f[i+1]),
+                                                                          _mm512_loadu_pd(&f[i-1])),a0);
+                                    a1 = _mm512_fmadd_pd(v8,_mm512_sub_pd(_mm512_loadu_pd(&f[i+9]),
+                                                                          _mm512_loadu_pd(&f[i+7])),a1);
+                                    _mm512_stream_pd(&df[i+0],_mm512_mul_pd(a0,vr12h));
+                                    _mm512_stream_pd(&df[i+8],_mm512_mul_pd(a1,vr12h));
+                                }
+                             }
+                             else {
+                                for(; (i+15) < iend; i += 16) {
+                                    __m512d a0,a1;
+                                    _mm_prefetch((const char*)&f[i+64],_MM_HINT_T0);
+                                    a0 = _mm512_sub_pd(_mm512_loadu_pd(&f[i-2]),_mm512_loadu_pd(&f[i+2]));
+                                    a1 = _mm512_sub_pd(_mm512_loadu_pd(&f[i+6]),_mm512_loadu_pd(&f[i+10]));
+                                    a0 = _mm512_fmadd_pd(v8,_mm512_sub_pd(_mm512_loadu_pd(&f[i+1]),
+                                                                          _mm512_loadu_pd(&f[i-1])),a0);
+                                    a1 = _mm512_fmadd_pd(v8,_mm512_sub_pd(_mm512_loadu_pd(&f[i+9]),
+                                                                          _mm512_loadu_pd(&f[i+7])),a1);
+                                    _mm512_storeu_pd(&df[i+0],_mm512_mul_pd(a0,vr12h));
+                                    _mm512_storeu_pd(&df[i+8],_mm512_mul_pd(a1,vr12h));
+                                }
+                             }
+                             for(; (i+7) < iend; i += 8) {
+                                 __m512d a0;
+                                 a0 = _mm512_sub_pd(_mm512_loadu_pd(&f[i-2]),_mm512_loadu_pd(&f[i+2]));
+                                 a0 = _mm512_fmadd_pd(v8,_mm512_sub_pd(_mm512_loadu_pd(&f[i+1]),
+                                                                       _mm512_loadu_pd(&f[i-1])),a0);
+                                 _mm512_storeu_pd(&df[i],_mm512_mul_pd(a0,vr12h));
+                             }
+                             for(; i < iend; ++i) {
+                                 df[i] = (f[i-2]-f[i+2]+8.0*(f[i+1]-f[i-1]))*r12h;
+                             }
+                        }
+
+
+                        static
+                        void line_nonuni(const double * __restrict x,
+                                         const double * __restrict f,
+                                         double * __restrict df,
+                                         const int64_t n,
+                                         const int32_t nt) {
+
+                             double w[3];
+                             int64_t r0;
+                             int64_t i;
+                             int32_t np;
+                             np = nonuni_weights(x,0,n,&w[0],&r0);
+                             df[0] = dot_stencil(f,np,&w[0],r0);
+                             if(n < 3) {
+                                df[1] = df[0];
+                                return;
+                             }
+                             np = nonuni_weights(x,n-1,n,&w[0],&r0);
+                             df[n-1] = dot_stencil(f,np,&w[0],r0);
+                             /*
+                                  With h1 = x[i]-x[i-1], h2 = x[i+1]-x[i]:
+                                  df = (h1^2*f[i+1] + (h2^2-h1^2)*f[i] - h2^2*f[i-1]) / (h1*h2*(h1+h2))
+                                  i.e. a single division per node.
+                             */
+                             const int64_t iend = n-1;
+                             i = 1;
+                             for(; (i+7) < iend; i += 8) {
+                                 const __m512d xm = _mm512_loadu_pd(&x[i-1]);
+                                 const __m512d x0 = _mm512_loadu_pd(&x[i]);
+                                 const __m512d xp = _mm512_loadu_pd(&x[i+1]);
+                                 const __m512d h1 = _mm512_sub_pd(x0,xm);
+                                 const __m512d h2 = _mm512_sub_pd(xp,x0);
+                                 const __m512d q1 = _mm512_mul_pd(h1,h1);
+                                 const __m512d q2 = _mm512_mul_pd(h2,h2);
+                                 const __m512d dn = _mm512_mul_pd(_mm512_mul_pd(h1,h2),_mm512_add_pd(h1,h2));
+                                 __m512d num;
+                                 num = _mm512_mul_pd(q1,_mm512_loadu_pd(&f[i+1]));
+                                 num = _mm512_fmadd_pd(_mm512_sub_pd(q2,q1),_mm512_loadu_pd(&f[i]),num);
+                                 num = _mm512_fnmadd_pd(q2,_mm512_loadu_pd(&f[i-1]),num);
+                                 num = _mm512_div_pd(num,dn);
+                                 if(nt && ((uintptr_t)&df[i] & 63) == 0) {
+                                    _mm512_stream_pd(&df[i],num);
+                                 }
+                                 else {
+                                    _mm512_storeu_pd(&df[i],num);
+                                 }
+                             }
+                             for(; i < iend; ++i) {
+                                 const double h1 = x[i]-x[i-1];
+                                 const double h2 = x[i+1]-x[i];
+                                 df[i] = (h1*h1*f[i+1]+(h2*h2-h1*h1)*f[i]-h2*h2*f[i-1])/
+                                         (h1*h2*(h1+h2));
+                             }
+                        }
+
+
+                        void
+                        fdiff_d1_uni_zmm8r8(const double * __restrict f,
+                                            double * __restrict df,
+                                            const int64_t n,
+                                            const double h) {
+
+                             if(__builtin_expect(n<2,0) ||
+                                __builtin_expect(0.0==h,0)) { return;}
+                             const int32_t nt = use_streaming(df,n);
+                             line_uni(f,df,n,h,nt);
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_d1_uni_axis_zmm8r8(const double * __restrict f,
+                                                 double * __restrict df,
+                                                 const int64_t outer,
+                                                 const int64_t n,
+                                                 const int64_t inner,
+                                                 const double h) {
+
+                             if(__builtin_expect(n<2,0)     ||
+                                __builtin_expect(outer<1,0) ||
+                                __builtin_expect(inner<1,0) ||
+                                __builtin_expect(0.0==h,0)) { return;}
+                             const int32_t nt = use_streaming(df,outer*n*inner);
+                             int64_t o,j;
+                             if(inner == 1) {
+                                for(o = 0; o != outer; ++o) {
+                                    line_uni(&f[o*n],&df[o*n],n,h,nt);
+                                }
+                             }
+                             else {
+                                double w[5];
+                                int64_t r0;
+                                int32_t np;
+                                for(o = 0; o != outer; ++o) {
+                                    const double * __restrict F = &f[o*n*inner];
+                                    for(j = 0; j != n; ++j) {
+                                        np = uni_weights(j,n,h,&w[0],&r0);
+                                        apply_rows(F,&df[(o*n+j)*inner],inner,np,&w[0],r0,nt);
+                                    }
+                                }
+                             }
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_d1_uni_axis_zmm8r8_omp(const double * __restrict f,
+                                                     double * __restrict df,
+                                                     const int64_t outer,
+                                                     const int64_t n,
+                                                     const int64_t inner,
+                                                     const double h) {
+
+                             if(__builtin_expect(n<2,0)     ||
+                                __builtin_expect(outer<1,0) ||
+                                __builtin_expect(inner<1,0) ||
+                                __builtin_expect(0.0==h,0)) { return;}
+                             const int32_t nt = use_streaming(df,outer*n*inner);
+                             int64_t o,j;
+                             if(inner == 1) {
+#pragma omp parallel for schedule(static) default(none) shared(f,df,outer,n,h,nt) private(o)
+                                for(o = 0; o < outer; ++o) {
+                                    line_uni(&f[o*n],&df[o*n],n,h,nt);
+                                }
+                             }
+                             else {
+#pragma omp parallel for collapse(2) schedule(static) default(none) \
+            shared(f,df,outer,n,inner,h,nt) private(o,j)
+                                for(o = 0; o < outer; ++o) {
+                                    for(j = 0; j < n; ++j) {
+                                        double w[5];
+                                        int64_t r0;
+                                        const int32_t np = uni_weights(j,n,h,&w[0],&r0);
+                                        apply_rows(&f[o*n*inner],&df[(o*n+j)*inner],inner,np,&w[0],r0,nt);
+                                    }
+                                }
+                             }
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_d1_nonuni_zmm8r8(const double * __restrict x,
+                                               const double * __restrict f,
+                                               double * __restrict df,
+                                               const int64_t n) {
+
+                             if(__builtin_expect(n<2,0)) { return;}
+                             const int32_t nt = use_streaming(df,n);
+                             line_nonuni(x,f,df,n,nt);
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_d1_nonuni_axis_zmm8r8(const double * __restrict x,
+                                                    const double * __restrict f,
+                                                    double * __restrict df,
+                                                    const int64_t outer,
+                                                    const int64_t n,
+                                                    const int64_t inner) {
+
+                             if(__builtin_expect(n<2,0)     ||
+                                __builtin_expect(outer<1,0) ||
+                                __builtin_expect(inner<1,0)) { return;}
+                             const int32_t nt = use_streaming(df,outer*n*inner);
+                             int64_t o,j;
+                             if(inner == 1) {
+                                for(o = 0; o != outer; ++o) {
+                                    line_nonuni(x,&f[o*n],&df[o*n],n,nt);
+                                }
+                             }
+                             else {
+                                double w[3];
+                                int64_t r0;
+                                int32_t np;
+                                for(o = 0; o != outer; ++o) {
+                                    const double * __restrict F = &f[o*n*inner];
+                                    for(j = 0; j != n; ++j) {
+                                        np = nonuni_weights(x,j,n,&w[0],&r0);
+                                        apply_rows(F,&df[(o*n+j)*inner],inner,np,&w[0],r0,nt);
+                                    }
+                                }
+                             }
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_d1_nonuni_axis_zmm8r8_omp(const double * __restrict x,
+                                                        const double * __restrict f,
+                                                        double * __restrict df,
+                                                        const int64_t outer,
+                                                        const int64_t n,
+                                                        const int64_t inner) {
+
+                             if(__builtin_expect(n<2,0)     ||
+                                __builtin_expect(outer<1,0) ||
+                                __builtin_expect(inner<1,0)) { return;}
+                             const int32_t nt = use_streaming(df,outer*n*inner);
+                             int64_t o,j;
+                             if(inner == 1) {
+#pragma omp parallel for schedule(static) default(none) shared(x,f,df,outer,n,nt) private(o)
+                                for(o = 0; o < outer; ++o) {
+                                    line_nonuni(x,&f[o*n],&df[o*n],n,nt);
+                                }
+                             }
+                             else {
+#pragma omp parallel for collapse(2) schedule(static) default(none) \
+            shared(x,f,df,outer,n,inner,nt) private(o,j)
+                                for(o = 0; o < outer; ++o) {
+                                    for(j = 0; j < n; ++j) {
+                                        double w[3];
+                                        int64_t r0;
+                                        const int32_t np = nonuni_weights(x,j,n,&w[0],&r0);
+                                        apply_rows(&f[o*n*inner],&df[(o*n+j)*inner],inner,np,&w[0],r0,nt);
+                                    }
+                                }
+                             }
+                             if(nt) { _mm_sfence();}
+                        }
+
+
+                        void
+                        fdiff_grad2d_uni_zmm8r8(const double * __restrict f,
+                                                const int64_t ny,
+                                                const int64_t nx,
+                                                const double hy,
+                                                const double hx,
+                                                double * __restrict dfdy,
+                                                double * __restrict dfdx) {
+
+                             fdiff_d1_uni_axis_zmm8r8(f,dfdy,1,ny,nx,hy);
+                             fdiff_d1_uni_axis_zmm8r8(f,dfdx,ny,nx,1,hx);
+                        }
+
+
+                        void
+                        fdiff_grad3d_uni_zmm8r8_omp(const double * __restrict f,
+                                                    const int64_t nz,
+                                                    const int64_t ny,
+                                                    const int64_t nx,
+                                                    const double hz,
+                                                    const double hy,
+                                                    const double hx,
+                                                    double * __restrict dfdz,
+                                                    double * __restrict dfdy,
+                                                    double * __restrict dfdx) {
+
+                             fdiff_d1_uni_axis_zmm8r8_omp(f,dfdz,1,nz,ny*nx,hz);
+                             fdiff_d1_uni_axis_zmm8r8_omp(f,dfdy,nz,ny,nx,hy);
+                             fdiff_d1_uni_axis_zmm8r8_omp(f,dfdx,nz*ny,nx,1,hx);
+                        }
+
+
+                        void
+                        fdiff_grad3d_nonuni_zmm8r8_omp(const double * __restrict f,
+                                                       const double * __restrict z,
+                                                       const double * __restrict y,
+                                                       const double * __restrict x,
+                                                       const int64_t nz,
+                                                       const int64_t ny,
+                                                       const int64_t nx,
+                                                       double * __restrict dfdz,
+                                                       double * __restrict dfdy,
+                                                       double * __restrict dfdx) {
+
+                             fdiff_d1_nonuni_axis_zmm8r8_omp(z,f,dfdz,1,nz,ny*nx);
+                             fdiff_d1_nonuni_axis_zmm8r8_omp(y,f,dfdy,nz,ny,nx);
+                             fdiff_d1_nonuni_axis_zmm8r8_omp(x,f,dfdx,nz*ny,nx,1);
+                        }
@@ -0,0 +1,166 @@
+
+
+#ifndef __GMS_FDIFF_TABULATED_AVX512_H__
+#define __GMS_FDIFF_TABULATED_AVX512_H__ 181020261030
+
+
+
+    const unsigned int gGMS_FDIFF_TABULATED_AVX512_MAJOR = 1U;
+    const unsigned int gGMS_FDIFF_TABULATED_AVX512_MINOR = 0U;
+    const unsigned int gGMS_FDIFF_TABULATED_AVX512_MICRO = 0U;
+    const unsigned int gGMS_FDIFF_TABULATED_AVX512_FULLVER =
+      1000U*gGMS_FDIFF_TABULATED_AVX512_MAJOR+
+      100U*gGMS_FDIFF_TABULATED_AVX512_MINOR+
+      10U*gGMS_FDIFF_TABULATED_AVX512_MICRO;
+    const char * const pgGMS_FDIFF_TABULATED_AVX512_CREATION_DATE = "18-10-2026 10:30 AM +00200 (SUN 18 OCT 2026 GMT+2)";
+    const char * const pgGMS_FDIFF_TABULATED_AVX512_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const pgGMS_FDIFF_TABULATED_AVX512_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const pgGMS_FDIFF_TABULATED_AVX512_DESCRIPTION   = "Vectorized (AVX512) finite differences of tabulated data.";
+
+
+/*
+     First derivative of tabulated (gridded) data, as opposed to the
+     function-pointer stencils of GMS_stencils_5P_4P_avx512.
+     Uniform grids:
+        interior   -> 5-point central stencil, O(h^4)
+        boundaries -> 5-point one-sided stencils (nodes 0,1 and n-2,n-1), O(h^4)
+        n < 5      -> 3-point (n>=3) or 2-point (n==2) fallback.
+     Non-uniform grids (node coordinates x[0..n-1], strictly monotone):
+        interior   -> 3-point Lagrange stencil, O(h^2)
+        boundaries -> 3-point one-sided Lagrange stencils, O(h^2).
+     Multi-dimensional arrays are addressed as a row-major (outer,n,inner)
+     view, the derivative being taken along the middle axis:
+        1D            -> (1,n,1)
+        2D d/dx       -> (ny,nx,1)       2D d/dy -> (1,ny,nx)
+        3D d/dx       -> (nz*ny,nx,1)    3D d/dy -> (nz,ny,nx)   3D d/dz -> (1,nz,ny*nx)
+     When inner==1 the kernel vectorizes along the axis, otherwise across the
+     contiguous inner dimension (full cache lines for every stencil point).
+     Outputs larger than GMS_FDIFF_NT_THRESHOLD bytes are streamed to memory
+     (non-temporal stores, sfence on exit).
+*/
+
+#include <immintrin.h>
+#include <stdint.h>
+
+
+#if !defined(GMS_FDIFF_NT_THRESHOLD)
+    #define GMS_FDIFF_NT_THRESHOLD 4194304
+#endif
+
+
+void
+fdiff_d1_uni_zmm8r8(const double * __restrict,
+                    double * __restrict,
+                    const int64_t,
+                    const double)          __attribute__((noinline))
+			                   __attribute__((hot))
+				           __attribute__((aligned(32)));
+
+
+void
+fdiff_d1_uni_axis_zmm8r8(const double * __restrict,
+                         double * __restrict,
+                         const int64_t,
+                         const int64_t,
+                         const int64_t,
+                         const double)     __attribute__((noinline))
+			                   __attribute__((hot))
+				           __attribute__((aligned(32)));
+
+
+void
+fdiff_d1_uni_axis_zmm8r8_omp(const double * __restrict,
+                             double * __restrict,
+                             const int64_t,
+                             const int64_t,
+                             const int64_t,
+                             const double) __attribute__((noinline))
+			                   __attribute__((hot))
+				           __attribute__((aligned(32)));
+
+
+void
+fdiff_d1_nonuni_zmm8r8(const double * __restrict,
+                       const double * __restrict,
+                       double * __restrict,
+                       const int64_t)      __attribute__((noinline))
+			                   __attribute__((hot))
+				           __attribute__((aligned(32)));
+
+
+void
+fdiff_d1_nonuni_axis_zmm8r8(const double * __restrict,
+                            const double * __restrict,
+                            double * __restrict,
+                            const int64_t,
+                            const int64_t,
+                            const int64_t) __attribute__((noinline))
+			                   __attribute__((hot))
+				           __attribute__((aligned(32)));
+
+
+void
+fdiff_d1_nonuni_axis_zmm8r8_omp(const double * __restrict,
+                                const double * __restrict,
+                                double * __restrict,
+                                const int64_t,
+                                const int64_t,
+                                const int64_t) __attribute__((noinline))
+			                       __attribute__((hot))
+				               __attribute__((aligned(32)));
+
+
+// Gradient of f(ny,nx) on a uniform grid: dfdy, dfdx.
+void
+fdiff_grad2d_uni_zmm8r8(const double * __restrict,
+                        const int64_t,
+                        const int64_t,
+                        const double,
+                        const double,
+                        double * __restrict,
+                        double * __restrict) __attribute__((noinline))
+			                     __attribute__((hot))
+				             __attribute__((aligned(32)));
+
+
+// Gradient of f(nz,ny,nx) on a uniform grid: dfdz, dfdy, dfdx.
+void
+fdiff_grad3d_uni_zmm8r8_omp(const double * __restrict,
+                            const int64_t,
+                            const int64_t,
+                            const int64_t,
+                            const double,
+                            const double,
+                            const double,
+                            double * __restrict,
+                            double * __restrict,
+                            double * __restrict) __attribute__((noinline))
+			                         __attribute__((hot))
+				                 __attribute__((aligned(32)));
+
+
+// Gradient of f(nz,ny,nx) on a rectilinear, non-uniform grid (z[nz],y[ny],x[nx]).
+void
+fdiff_grad3d_nonuni_zmm8r8_omp(const double * __restrict,
+                               const double * __restrict,
+                               const double * __restrict,
+                               const double * __restrict,
+                               const int64_t,
+                               const int64_t,
+                               const int64_t,
+                               double * __restrict,
+                               double * __restrict,
+                               double * __restrict) __attribute__((noinline))
+			                            __attribute__((hot))
+				                    __attribute__((aligned(32)));
+
+
+
+
+
+
+
+
+
+
+#endif /*__GMS_FDIFF_TABULATED_AVX512_H__*/
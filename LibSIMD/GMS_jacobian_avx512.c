@@ -0,0 +1,467 @@
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "GMS_jacobian_avx512.h"
+
+
+                     // eps^(1/2), eps^(1/3), eps^(1/5) for double precision.
+                     __attribute__((always_inline))
+                     static inline
+                     double step_coeff(const int32_t scheme) {
+                            switch(scheme) {
+                               case GMS_JAC_CENTRAL : return (6.0554544523933395e-06);
+                               case GMS_JAC_5P      : return (7.4009597974140505e-04);
+                               default              : return (1.4901161193847656e-08);
+                            }
+                     }
+
+
+                     // Step actually representable around x (x+h)-x.
+                     __attribute__((always_inline))
+                     static inline
+                     double exact_step(const double x,
+                                       const double c) {
+                            volatile double t;
+                            const double h = c*fmax(fabs(x),1.0);
+                            t = x+h;
+                            return (t-x);
+                     }
+
+
+                     // X[k] = x[k] in all lanes, lane l of X[j0+l] shifted by s*h[l].
+                     __attribute__((always_inline))
+                     static inline
+                     void perturbed_states(const int32_t n,
+                                           const double * __restrict x,
+                                           const int32_t j0,
+                                           const int32_t nl,
+                                           const double * __restrict h,
+                                           const double s,
+                                           __m512d * __restrict X) {
+                            int32_t k,l;
+                            for(k = 0; k != n; ++k) {
+                                X[k] = _mm512_set1_pd(x[k]);
+                            }
+                            for(l = 0; l != nl; ++l) {
+                                const __m512d vx = X[j0+l];
+                                X[j0+l] = _mm512_mask_add_pd(vx,(__mmask8)(1U<<l),vx,
+                                                             _mm512_set1_pd(s*h[l]));
+                            }
+                     }
+
+
+                     // J(i,j0+l) = D[i] lane l, l < nl.
+                     __attribute__((always_inline))
+                     static inline
+                     void scatter_columns(const int32_t m,
+                                          const __m512d * __restrict D,
+                                          const int32_t j0,
+                                          const int32_t nl,
+                                          double * __restrict J,
+                                          const int32_t ldj) {
+                            const __mmask8 msk = (__mmask8)((1U<<nl)-1U);
+                            const int64_t ld = (int64_t)ldj;
+                            const __m512i vidx = _mm512_set_epi64(7*ld,6*ld,5*ld,4*ld,
+                                                                  3*ld,2*ld,ld,0);
+                            double * __restrict Jc = &J[(int64_t)j0*ld];
+                            int32_t i;
+                            for(i = 0; i != m; ++i) {
+                                _mm512_mask_i64scatter_pd(&Jc[i],msk,vidx,D[i],8);
+                            }
+                     }
+
+
+                     static
+                     void fd_batch(jac_vfun_zmm8r8 fun,
+                                   const int32_t n,
+                                   const int32_t m,
+                                   const double * __restrict x,
+                                   const double * __restrict f0,
+                                   const int32_t j0,
+                                   const int32_t scheme,
+                                   __m512d * __restrict X,
+                                   __m512d * __restrict F,
+                                   __m512d * __restrict G,
+                                   double * __restrict J,
+                                   const int32_t ldj,
+                                   void * __restrict user) {
+
+                            double h[8];
+                            __m512d vrh;
+                            const double c = step_coeff(scheme);
+                            const int32_t nl = (n-j0) < 8 ? (n-j0) : 8;
+                            int32_t i,l;
+                            for(l = 0; l != 8; ++l) {
+                                h[l] = (l < nl) ? exact_step(x[j0+l],c) : 1.0;
+                            }
+                            switch(scheme) {
+                               case GMS_JAC_CENTRAL : {
+                                    vrh = _mm512_div_pd(_mm512_set1_pd(0.5),_mm512_loadu_pd(&h[0]));
+                                    perturbed_states(n,x,j0,nl,&h[0],1.0,X);
+                                    fun(n,X,m,F,user);
+                                    perturbed_states(n,x,j0,nl,&h[0],-1.0,X);
+                                    fun(n,X,m,G,user);
+                                    for(i = 0; i != m; ++i) {
+                                        F[i] = _mm512_mul_pd(_mm512_sub_pd(F[i],G[i]),vrh);
+                                    }
+                               }
+                               break;
+                               case GMS_JAC_5P : {
+                                    // (f(x-2h) - 8f(x-h) + 8f(x+h) - f(x+2h))/(12h)
+                                    const double s[4] = {-2.0,-1.0,1.0,2.0};
+                                    const double w[4] = {1.0,-8.0,8.0,-1.0};
+                                    int32_t p;
+                                    vrh = _mm512_div_pd(_mm512_set1_pd(1.0/12.0),_mm512_loadu_pd(&h[0]));
+                                    for(i = 0; i != m; ++i) {
+                                        F[i] = _mm512_setzero_pd();
+                                    }
+                                    for(p = 0; p != 4; ++p) {
+                                        const __m512d vw = _mm512_set1_pd(w[p]);
+                                        perturbed_states(n,x,j0,nl,&h[0],s[p],X);
+                                        fun(n,X,m,G,user);
+                                        for(i = 0; i != m; ++i) {
+                                            F[i] = _mm512_fmadd_pd(vw,G[i],F[i]);
+                                        }
+                                    }
+                                    for(i = 0; i != m; ++i) {
+                                        F[i] = _mm512_mul_pd(F[i],vrh);
+                                    }
+                               }
+                               break;
+                               default : {
+                                    vrh = _mm512_div_pd(_mm512_set1_pd(1.0),_mm512_loadu_pd(&h[0]));
+                                    perturbed_states(n,x,j0,nl,&h[0],1.0,X);
+                                    fun(n,X,m,F,user);
+                                    for(i = 0; i != m; ++i) {
+                                        F[i] = _mm512_mul_pd(_mm512_sub_pd(F[i],
+                                                             _mm512_set1_pd(f0[i])),vrh);
+                                    }
+                               }
+                            }
+                            scatter_columns(m,F,j0,nl,J,ldj);
+                     }
+
+
+                     static
+                     void cs_batch(jac_cfun_zmm8r8 fun,
+                                   const int32_t n,
+                                   const int32_t m,
+                                   const double * __restrict x,
+                                   const double h,
+                                   const int32_t j0,
+                                   __m512d * __restrict Xr,
+                                   __m512d * __restrict Xi,
+                                   __m512d * __restrict Fr,
+                                   __m512d * __restrict Fi,
+                                   double * __restrict J,
+                                   const int32_t ldj,
+                                   void * __restrict user) {
+
+                            const __m512d vrh = _mm512_set1_pd(1.0/h);
+                            const __m512d vh  = _mm512_set1_pd(h);
+                            const int32_t nl = (n-j0) < 8 ? (n-j0) : 8;
+                            int32_t i,k,l;
+                            for(k = 0; k != n; ++k) {
+                                Xr[k] = _mm512_set1_pd(x[k]);
+                                Xi[k] = _mm512_setzero_pd();
+                            }
+                            for(l = 0; l != nl; ++l) {
+                                Xi[j0+l] = _mm512_maskz_mov_pd((__mmask8)(1U<<l),vh);
+                            }
+                            fun(n,Xr,Xi,m,Fr,Fi,user);
+                            for(i = 0; i != m; ++i) {
+                                Fi[i] = _mm512_mul_pd(Fi[i],vrh);
+                            }
+                            scatter_columns(m,Fi,j0,nl,J,ldj);
+                     }
+
+
+                     // f(x) via lane 0 of a broadcast evaluation.
+                     static
+                     void base_value(jac_vfun_zmm8r8 fun,
+                                     const int32_t n,
+                                     const int32_t m,
+                                     const double * __restrict x,
+                                     __m512d * __restrict X,
+                                     __m512d * __restrict F,
+                                     double * __restrict f0,
+                                     void * __restrict user) {
+                            int32_t k;
+                            for(k = 0; k != n; ++k) {
+                                X[k] = _mm512_set1_pd(x[k]);
+                            }
+                            fun(n,X,m,F,user);
+                            for(k = 0; k != m; ++k) {
+                                f0[k] = _mm512_cvtsd_f64(F[k]);
+                            }
+                     }
+
+
+                     int32_t
+                     jacobian_fd_zmm8r8(jac_vfun_zmm8r8 fun,
+                                        const int32_t n,
+                                        const int32_t m,
+                                        const double * __restrict x,
+                                        const double * __restrict f0,
+                                        double * __restrict J,
+                                        const int32_t ldj,
+                                        const int32_t scheme,
+                                        void * __restrict user) {
+
+                            if(__builtin_expect(NULL==fun,0) ||
+                               __builtin_expect(n<=0,0)      ||
+                               __builtin_expect(m<=0,0)      ||
+                               __builtin_expect(ldj<m,0)      ||
+                               __builtin_expect(scheme<GMS_JAC_FORWARD || scheme>GMS_JAC_5P,0)) { return (-1);}
+                            __m512d * __restrict X = NULL;
+                            __m512d * __restrict F = NULL;
+                            __m512d * __restrict G = NULL;
+                            double  * __restrict fb = NULL;
+                            const double * __restrict fx = f0;
+                            int32_t j0;
+                            X = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                            F = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                            G = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                            if(NULL==X || NULL==F || NULL==G) {
+                               _mm_free(X); _mm_free(F); _mm_free(G);
+                               return (-2);
+                            }
+                            if(scheme == GMS_JAC_FORWARD && NULL == f0) {
+                               fb = (double*)malloc((size_t)m*sizeof(double));
+                               if(NULL==fb) {
+                                  _mm_free(X); _mm_free(F); _mm_free(G);
+                                  return (-2);
+                               }
+                               base_value(fun,n,m,x,X,F,fb,user);
+                               fx = fb;
+                            }
+                            for(j0 = 0; j0 < n; j0 += 8) {
+                                fd_batch(fun,n,m,x,fx,j0,scheme,X,F,G,J,ldj,user);
+                            }
+                            free(fb);
+                            _mm_free(X); _mm_free(F); _mm_free(G);
+                            return (0);
+                     }
+
+
+                     int32_t
+                     jacobian_fd_zmm8r8_omp(jac_vfun_zmm8r8 fun,
+                                            const int32_t n,
+                                            const int32_t m,
+                                            const double * __restrict x,
+                                            const double * __restrict f0,
+                                            double * __restrict J,
+                                            const int32_t ldj,
+                                            const int32_t scheme,
+                                            void * __restrict user) {
+
+                            if(__builtin_expect(NULL==fun,0) ||
+                               __builtin_expect(n<=0,0)      ||
+                               __builtin_expect(m<=0,0)      ||
+                               __builtin_expect(ldj<m,0)      ||
+                               __builtin_expect(scheme<GMS_JAC_FORWARD || scheme>GMS_JAC_5P,0)) { return (-1);}
+                            double * __restrict fb = NULL;
+                            const double * __restrict fx = f0;
+                            const int32_t nb = (n+7)/8;
+                            int32_t stat = 0;
+                            if(scheme == GMS_JAC_FORWARD && NULL == f0) {
+                               __m512d * __restrict X = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                               __m512d * __restrict F = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                               fb = (double*)malloc((size_t)m*sizeof(double));
+                               if(NULL==X || NULL==F || NULL==fb) {
+                                  _mm_free(X); _mm_free(F); free(fb);
+                                  return (-2);
+                               }
+                               base_value(fun,n,m,x,X,F,fb,user);
+                               _mm_free(X); _mm_free(F);
+                               fx = fb;
+                            }
+#pragma omp parallel default(none) shared(fun,n,m,x,fx,J,ldj,scheme,user,nb,stat)
+                            {
+                                __m512d * __restrict X = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                                __m512d * __restrict F = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                                __m512d * __restrict G = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                                const int32_t ok = (NULL!=X && NULL!=F && NULL!=G);
+                                int32_t b;
+                                if(!ok) {
+#pragma omp atomic write
+                                   stat = -2;
+                                }
+                                // Every thread must reach the worksharing loop.
+#pragma omp for schedule(dynamic,1)
+                                for(b = 0; b < nb; ++b) {
+                                    if(ok) {
+                                       fd_batch(fun,n,m,x,fx,8*b,scheme,X,F,G,J,ldj,user);
+                                    }
+                                }
+                                _mm_free(X); _mm_free(F); _mm_free(G);
+                            }
+                            free(fb);
+                            return (stat);
+                     }
+
+
+                     int32_t
+                     jacobian_cs_zmm8r8(jac_cfun_zmm8r8 fun,
+                                        const int32_t n,
+                                        const int32_t m,
+                                        const double * __restrict x,
+                                        const double h,
+                                        double * __restrict J,
+                                        const int32_t ldj,
+                                        void * __restrict user) {
+
+                            if(__builtin_expect(NULL==fun,0) ||
+                               __builtin_expect(n<=0,0)      ||
+                               __builtin_expect(m<=0,0)      ||
+                               __builtin_expect(ldj<m,0)) { return (-1);}
+                            const double hs = (h > 0.0) ? h : 1.0e-20;
+                            __m512d * __restrict Xr = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                            __m512d * __restrict Xi = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                            __m512d * __restrict Fr = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                            __m512d * __restrict Fi = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                            int32_t j0;
+                            if(NULL==Xr || NULL==Xi || NULL==Fr || NULL==Fi) {
+                               _mm_free(Xr); _mm_free(Xi); _mm_free(Fr); _mm_free(Fi);
+                               return (-2);
+                            }
+                            for(j0 = 0; j0 < n; j0 += 8) {
+                                cs_batch(fun,n,m,x,hs,j0,Xr,Xi,Fr,Fi,J,ldj,user);
+                            }
+                            _mm_free(Xr); _mm_free(Xi); _mm_free(Fr); _mm_free(Fi);
+                            return (0);
+                     }
+
+
+                     int32_t
+                     jacobian_cs_zmm8r8_omp(jac_cfun_zmm8r8 fun,
+                                            const int32_t n,
+                                            const int32_t m,
+                                            const double * __restrict x,
+                                            const double h,
+                                            double * __restrict J,
+                                            const int32_t ldj,
+                                            void * __restrict user) {
+
+                            if(__builtin_expect(NULL==fun,0) ||
+                               __builtin_expect(n<=0,0)      ||
+                               __builtin_expect(m<=0,0)      ||
+                               __builtin_expect(ldj<m,0)) { return (-1);}
+                            const double hs = (h > 0.0) ? h : 1.0e-20;
+                            const int32_t nb = (n+7)/8;
+                            int32_t stat = 0;
+#pragma omp parallel default(none) shared(fun,n,m,x,hs,J,ldj,user,nb,stat)
+                            {
+                                __m512d * __restrict Xr = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                                __m512d * __restrict Xi = (__m512d*)_mm_malloc((size_t)n*sizeof(__m512d),64);
+                                __m512d * __restrict Fr = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                                __m512d * __restrict Fi = (__m512d*)_mm_malloc((size_t)m*sizeof(__m512d),64);
+                                const int32_t ok = (NULL!=Xr && NULL!=Xi && NULL!=Fr && NULL!=Fi);
+                                int32_t b;
+                                if(!ok) {
+#pragma omp atomic write
+                                   stat = -2;
+                                }
+#pragma omp for schedule(dynamic,1)
+                                for(b = 0; b < nb; ++b) {
+                                    if(ok) {
+                                       cs_batch(fun,n,m,x,hs,8*b,Xr,Xi,Fr,Fi,J,ldj,user);
+                                    }
+                                }
+                                _mm_free(Xr); _mm_free(Xi); _mm_free(Fr); _mm_free(Fi);
+                            }
+                            return (stat);
+                     }
+
+
+                     int32_t
+                     jacobian_fd_r8_omp(jac_sfun_r8 fun,
+                                        const int32_t n,
+                                        const int32_t m,
+                                        const double * __restrict x,
+                                        const double * __restrict f0,
+                                        double * __restrict J,
+                                        const int32_t ldj,
+                                        const int32_t scheme,
+                                        void * __restrict user) {
+
+                            if(__builtin_expect(NULL==fun,0) ||
+                               __builtin_expect(n<=0,0)      ||
+                               __builtin_expect(m<=0,0)      ||
+                               __builtin_expect(ldj<m,0)      ||
+                               __builtin_expect(scheme<GMS_JAC_FORWARD || scheme>GMS_JAC_5P,0)) { return (-1);}
+                            double * __restrict fb = NULL;
+                            const double * __restrict fx = f0;
+                            const double c = step_coeff(scheme);
+                            int32_t stat = 0;
+                            if(scheme == GMS_JAC_FORWARD && NULL == f0) {
+                               fb = (double*)malloc((size_t)m*sizeof(double));
+                               if(NULL==fb) { return (-2);}
+                               fun(n,x,m,fb,user);
+                               fx = fb;
+                            }
+#pragma omp parallel default(none) shared(fun,n,m,x,fx,J,ldj,scheme,user,c,stat)
+                            {
+                                double * __restrict xt = (double*)malloc((size_t)n*sizeof(double));
+                                double * __restrict fp = (double*)malloc((size_t)m*sizeof(double));
+                                double * __restrict fm = (double*)malloc((size_t)m*sizeof(double));
+                                const int32_t ok = (NULL!=xt && NULL!=fp && NULL!=fm);
+                                int32_t i,j;
+                                if(!ok) {
+#pragma omp atomic write
+                                   stat = -2;
+                                }
+                                else {
+                                   memcpy(xt,x,(size_t)n*sizeof(double));
+                                }
+#pragma omp for schedule(dynamic,1)
+                                for(j = 0; j < n; ++j) {
+                                    if(!ok) { continue;}
+                                    double * __restrict Jc = &J[(int64_t)j*ldj];
+                                    const double xj = x[j];
+                                    const double h  = exact_step(xj,c);
+                                    if(scheme == GMS_JAC_CENTRAL) {
+                                       const double r2h = 0.5/h;
+                                       xt[j] = xj+h;
+                                       fun(n,xt,m,fp,user);
+                                       xt[j] = xj-h;
+                                       fun(n,xt,m,fm,user);
+                                       for(i = 0; i != m; ++i) {
+                                           Jc[i] = (fp[i]-fm[i])*r2h;
+                                       }
+                                    }
+                                    else if(scheme == GMS_JAC_5P) {
+                                       const double r12h = 1.0/(12.0*h);
+                                       xt[j] = xj-2.0*h;
+                                       fun(n,xt,m,fp,user);
+                                       xt[j] = xj-h;
+                                       fun(n,xt,m,fm,user);
+                                       for(i = 0; i != m; ++i) {
+                                           Jc[i] = fp[i]-8.0*fm[i];
+                                       }
+                                       xt[j] = xj+h;
+                                       fun(n,xt,m,fp,user);
+                                       xt[j] = xj+2.0*h;
+                                       fun(n,xt,m,fm,user);
+                                       for(i = 0; i != m; ++i) {
+                                           Jc[i] = (Jc[i]+8.0*fp[i]-fm[i])*r12h;
+                                       }
+                                    }
+                                    else {
+                                       const double rh = 1.0/h;
+                                       xt[j] = xj+h;
+                                       fun(n,xt,m,fp,user);
+                                       for(i = 0; i != m; ++i) {
+                                           Jc[i] = (fp[i]-fx[i])*rh;
+                                       }
+                                    }
+                                    xt[j] = xj;
+                                }
+                                free(xt); free(fp); free(fm);
+                            }
+                            free(fb);
+                            return (stat);
+                     }
@@ -0,0 +1,148 @@
+
+
+#ifndef __GMS_JACOBIAN_AVX512_H__
+#define __GMS_JACOBIAN_AVX512_H__ 181020261200
+
+
+
+    const unsigned int gGMS_JACOBIAN_AVX512_MAJOR = 1U;
+    const unsigned int gGMS_JACOBIAN_AVX512_MINOR = 0U;
+    const unsigned int gGMS_JACOBIAN_AVX512_MICRO = 0U;
+    const unsigned int gGMS_JACOBIAN_AVX512_FULLVER =
+      1000U*gGMS_JACOBIAN_AVX512_MAJOR+
+      100U*gGMS_JACOBIAN_AVX512_MINOR+
+      10U*gGMS_JACOBIAN_AVX512_MICRO;
+    const char * const pgGMS_JACOBIAN_AVX512_CREATION_DATE = "18-10-2026 12:00 PM +00200 (SUN 18 OCT 2026 GMT+2)";
+    const char * const pgGMS_JACOBIAN_AVX512_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const pgGMS_JACOBIAN_AVX512_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const pgGMS_JACOBIAN_AVX512_DESCRIPTION   = "Vectorized (AVX512) batched Jacobian estimation.";
+
+
+/*
+     Jacobian J(m,n) = df/dx of a vector function f: R^n -> R^m.
+     The vectorized drivers evaluate eight perturbed states per call:
+     lane l of x[k] holds component k of the state perturbed along
+     column j0+l, so one call of the user function yields eight columns.
+     Schemes:
+        GMS_JAC_FORWARD  -> 1 evaluation per column,  O(h),   h = eps^(1/2)*max(|x|,1)
+        GMS_JAC_CENTRAL  -> 2 evaluations per column, O(h^2), h = eps^(1/3)*max(|x|,1)
+        GMS_JAC_5P       -> 4 evaluations per column, O(h^4), h = eps^(1/5)*max(|x|,1)
+                            (same 5-point central stencil as stencil_5P_central_zmm8r8)
+        complex step     -> 1 complex evaluation per column, Im(f(x+ih))/h,
+                            free of subtractive cancellation (h = 1.0e-20 by default).
+     J is stored column-major with leading dimension ldj (MINPACK fjac(ldfjac,n)).
+     The scalar driver jacobian_fd_r8_omp takes one state per call of a C
+     callback (jac_sfun_r8) and threads over the columns. MINPACK fcn_lmder /
+     fcn_hybrj procedures reach it through the bind(c) adapters of
+     Mathematics/GMS_jacobian_minpack_iface.f90 (jacobian_fd_lmder/_hybrj).
+     Return values: 0 success, -1 invalid arguments (also a scheme other than
+     the three GMS_JAC_* above), -2 allocation failure.
+*/
+
+#include <immintrin.h>
+#include <stdint.h>
+
+
+#define GMS_JAC_FORWARD 0
+#define GMS_JAC_CENTRAL 1
+#define GMS_JAC_5P      2
+
+
+    // f(8 states) : x[n] -> f[m], lane l = state l.
+    typedef void (*jac_vfun_zmm8r8)(const int32_t,
+                                    const __m512d * __restrict,
+                                    const int32_t,
+                                    __m512d * __restrict,
+                                    void * __restrict);
+
+    // Complex-valued counterpart for the complex-step scheme (re,im split).
+    typedef void (*jac_cfun_zmm8r8)(const int32_t,
+                                    const __m512d * __restrict,
+                                    const __m512d * __restrict,
+                                    const int32_t,
+                                    __m512d * __restrict,
+                                    __m512d * __restrict,
+                                    void * __restrict);
+
+    // Scalar function (one state per call).
+    typedef void (*jac_sfun_r8)(const int32_t,
+                                const double * __restrict,
+                                const int32_t,
+                                double * __restrict,
+                                void * __restrict);
+
+
+int32_t
+jacobian_fd_zmm8r8(jac_vfun_zmm8r8,
+                   const int32_t,
+                   const int32_t,
+                   const double * __restrict,
+                   const double * __restrict,
+                   double * __restrict,
+                   const int32_t,
+                   const int32_t,
+                   void * __restrict)       __attribute__((noinline))
+			                    __attribute__((hot))
+				            __attribute__((aligned(32)));
+
+
+int32_t
+jacobian_fd_zmm8r8_omp(jac_vfun_zmm8r8,
+                       const int32_t,
+                       const int32_t,
+                       const double * __restrict,
+                       const double * __restrict,
+                       double * __restrict,
+                       const int32_t,
+                       const int32_t,
+                       void * __restrict)   __attribute__((noinline))
+			                    __attribute__((hot))
+				            __attribute__((aligned(32)));
+
+
+int32_t
+jacobian_cs_zmm8r8(jac_cfun_zmm8r8,
+                   const int32_t,
+                   const int32_t,
+                   const double * __restrict,
+                   const double,
+                   double * __restrict,
+                   const int32_t,
+                   void * __restrict)       __attribute__((noinline))
+			                    __attribute__((hot))
+				            __attribute__((aligned(32)));
+
+
+int32_t
+jacobian_cs_zmm8r8_omp(jac_cfun_zmm8r8,
+                       const int32_t,
+                       const int32_t,
+                       const double * __restrict,
+                       const double,
+                       double * __restrict,
+                       const int32_t,
+                       void * __restrict)   __attribute__((noinline))
+			                    __attribute__((hot))
+				            __attribute__((aligned(32)));
+
+
+int32_t
+jacobian_fd_r8_omp(jac_sfun_r8,
+                   const int32_t,
+                   const int32_t,
+                   const double * __restrict,
+                   const double * __restrict,
+                   double * __restrict,
+                   const int32_t,
+                   const int32_t,
+                   void * __restrict)       __attribute__((noinline))
+			                    __attribute__((hot))
+				            __attribute__((aligned(32)));
+
+
+
+
+
+
+
+#endif /*__GMS_JACOBIAN_AVX512_H__*/
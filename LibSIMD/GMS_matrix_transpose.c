@@ -0,0 +1,874 @@
+
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "GMS_matrix_transpose.h"
+
+
+/*
+     Register-resident tile kernels.
+     The shuffle network is the same one as used by transpose_u_zmm16r4_16x16
+     and transpose_u_ymm8r4_8x8, but the tiles are addressed through leading
+     dimensions so that they can be applied to sub-blocks of arbitrary matrices.
+     Loads are always unaligned, stores are either unaligned or streaming
+     (the caller checks the alignment before asking for the latter).
+*/
+
+#if defined(__AVX512F__)
+
+#define R4_TILE 16
+#define R8_TILE 8
+
+                  __attribute__((always_inline))
+                  static inline
+                  void transpose_zmm16r4_regs(__m512 * __restrict r) {
+
+                         __m512 t[16];
+                         __m512 u[16];
+                         int32_t k;
+                         for(k = 0; k != 16; k += 2) {
+                             t[k+0] = _mm512_unpacklo_ps(r[k+0],r[k+1]);
+                             t[k+1] = _mm512_unpackhi_ps(r[k+0],r[k+1]);
+                         }
+                         for(k = 0; k != 16; k += 4) {
+                             u[k+0] = _mm512_shuffle_ps(t[k+0],t[k+2],_MM_SHUFFLE(1,0,1,0));
+                             u[k+1] = _mm512_shuffle_ps(t[k+0],t[k+2],_MM_SHUFFLE(3,2,3,2));
+                             u[k+2] = _mm512_shuffle_ps(t[k+1],t[k+3],_MM_SHUFFLE(1,0,1,0));
+                             u[k+3] = _mm512_shuffle_ps(t[k+1],t[k+3],_MM_SHUFFLE(3,2,3,2));
+                         }
+                         for(k = 0; k != 4; ++k) {
+                             t[k+0]  = _mm512_shuffle_f32x4(u[k+0],u[k+4],0x88);
+                             t[k+4]  = _mm512_shuffle_f32x4(u[k+0],u[k+4],0xdd);
+                             t[k+8]  = _mm512_shuffle_f32x4(u[k+8],u[k+12],0x88);
+                             t[k+12] = _mm512_shuffle_f32x4(u[k+8],u[k+12],0xdd);
+                         }
+                         for(k = 0; k != 8; ++k) {
+                             r[k+0] = _mm512_shuffle_f32x4(t[k+0],t[k+8],0x88);
+                             r[k+8] = _mm512_shuffle_f32x4(t[k+0],t[k+8],0xdd);
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void transpose_zmm8r8_regs(__m512d * __restrict r) {
+
+                         __m512d t[8];
+                         __m512d u[8];
+                         int32_t k;
+                         for(k = 0; k != 8; k += 2) {
+                             t[k+0] = _mm512_unpacklo_pd(r[k+0],r[k+1]);
+                             t[k+1] = _mm512_unpackhi_pd(r[k+0],r[k+1]);
+                         }
+                         for(k = 0; k != 8; k += 4) {
+                             u[k+0] = _mm512_shuffle_f64x2(t[k+0],t[k+2],0x88);
+                             u[k+1] = _mm512_shuffle_f64x2(t[k+1],t[k+3],0x88);
+                             u[k+2] = _mm512_shuffle_f64x2(t[k+0],t[k+2],0xdd);
+                             u[k+3] = _mm512_shuffle_f64x2(t[k+1],t[k+3],0xdd);
+                         }
+                         for(k = 0; k != 4; ++k) {
+                             r[k+0] = _mm512_shuffle_f64x2(u[k+0],u[k+4],0x88);
+                             r[k+4] = _mm512_shuffle_f64x2(u[k+0],u[k+4],0xdd);
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r4(const float * A,
+                               const int64_t lda,
+                               float * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         __m512 r[16];
+                         int32_t k;
+                         for(k = 0; k != 16; ++k) {
+                             r[k] = _mm512_loadu_ps(&A[k*lda]);
+                         }
+                         transpose_zmm16r4_regs(&r[0]);
+                         if(nt) {
+                            for(k = 0; k != 16; ++k) {
+                                _mm512_stream_ps(&B[k*ldb],r[k]);
+                            }
+                         }
+                         else {
+                            for(k = 0; k != 16; ++k) {
+                                _mm512_storeu_ps(&B[k*ldb],r[k]);
+                            }
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r8(const double * A,
+                               const int64_t lda,
+                               double * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         __m512d r[8];
+                         int32_t k;
+                         for(k = 0; k != 8; ++k) {
+                             r[k] = _mm512_loadu_pd(&A[k*lda]);
+                         }
+                         transpose_zmm8r8_regs(&r[0]);
+                         if(nt) {
+                            for(k = 0; k != 8; ++k) {
+                                _mm512_stream_pd(&B[k*ldb],r[k]);
+                            }
+                         }
+                         else {
+                            for(k = 0; k != 8; ++k) {
+                                _mm512_storeu_pd(&B[k*ldb],r[k]);
+                            }
+                         }
+                  }
+
+
+                  // Swaps the tile at X with the transposed tile at Y (X may equal Y).
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r4_swap(float * X,
+                                    float * Y,
+                                    const int64_t ld) {
+
+                         __m512 rx[16];
+                         __m512 ry[16];
+                         int32_t k;
+                         for(k = 0; k != 16; ++k) {
+                             rx[k] = _mm512_loadu_ps(&X[k*ld]);
+                             ry[k] = _mm512_loadu_ps(&Y[k*ld]);
+                         }
+                         transpose_zmm16r4_regs(&rx[0]);
+                         transpose_zmm16r4_regs(&ry[0]);
+                         for(k = 0; k != 16; ++k) {
+                             _mm512_storeu_ps(&X[k*ld],ry[k]);
+                             _mm512_storeu_ps(&Y[k*ld],rx[k]);
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r8_swap(double * X,
+                                    double * Y,
+                                    const int64_t ld) {
+
+                         __m512d rx[8];
+                         __m512d ry[8];
+                         int32_t k;
+                         for(k = 0; k != 8; ++k) {
+                             rx[k] = _mm512_loadu_pd(&X[k*ld]);
+                             ry[k] = _mm512_loadu_pd(&Y[k*ld]);
+                         }
+                         transpose_zmm8r8_regs(&rx[0]);
+                         transpose_zmm8r8_regs(&ry[0]);
+                         for(k = 0; k != 8; ++k) {
+                             _mm512_storeu_pd(&X[k*ld],ry[k]);
+                             _mm512_storeu_pd(&Y[k*ld],rx[k]);
+                         }
+                  }
+
+#define NT_ALIGN 64
+
+#elif defined(__AVX2__) || defined(__AVX__)
+
+#define R4_TILE 8
+#define R8_TILE 4
+
+                  __attribute__((always_inline))
+                  static inline
+                  void transpose_ymm8r4_regs(__m256 * __restrict r) {
+
+                         __m256 t[8];
+                         __m256 u[8];
+                         int32_t k;
+                         for(k = 0; k != 8; k += 2) {
+                             t[k+0] = _mm256_unpacklo_ps(r[k+0],r[k+1]);
+                             t[k+1] = _mm256_unpackhi_ps(r[k+0],r[k+1]);
+                         }
+                         for(k = 0; k != 8; k += 4) {
+                             u[k+0] = _mm256_shuffle_ps(t[k+0],t[k+2],_MM_SHUFFLE(1,0,1,0));
+                             u[k+1] = _mm256_shuffle_ps(t[k+0],t[k+2],_MM_SHUFFLE(3,2,3,2));
+                             u[k+2] = _mm256_shuffle_ps(t[k+1],t[k+3],_MM_SHUFFLE(1,0,1,0));
+                             u[k+3] = _mm256_shuffle_ps(t[k+1],t[k+3],_MM_SHUFFLE(3,2,3,2));
+                         }
+                         for(k = 0; k != 4; ++k) {
+                             r[k+0] = _mm256_permute2f128_ps(u[k+0],u[k+4],0x20);
+                             r[k+4] = _mm256_permute2f128_ps(u[k+0],u[k+4],0x31);
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void transpose_ymm4r8_regs(__m256d * __restrict r) {
+
+                         __m256d t0,t1,t2,t3;
+                         t0 = _mm256_unpacklo_pd(r[0],r[1]);
+                         t1 = _mm256_unpackhi_pd(r[0],r[1]);
+                         t2 = _mm256_unpacklo_pd(r[2],r[3]);
+                         t3 = _mm256_unpackhi_pd(r[2],r[3]);
+                         r[0] = _mm256_permute2f128_pd(t0,t2,0x20);
+                         r[1] = _mm256_permute2f128_pd(t1,t3,0x20);
+                         r[2] = _mm256_permute2f128_pd(t0,t2,0x31);
+                         r[3] = _mm256_permute2f128_pd(t1,t3,0x31);
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r4(const float * A,
+                               const int64_t lda,
+                               float * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         __m256 r[8];
+                         int32_t k;
+                         for(k = 0; k != 8; ++k) {
+                             r[k] = _mm256_loadu_ps(&A[k*lda]);
+                         }
+                         transpose_ymm8r4_regs(&r[0]);
+                         if(nt) {
+                            for(k = 0; k != 8; ++k) {
+                                _mm256_stream_ps(&B[k*ldb],r[k]);
+                            }
+                         }
+                         else {
+                            for(k = 0; k != 8; ++k) {
+                                _mm256_storeu_ps(&B[k*ldb],r[k]);
+                            }
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r8(const double * A,
+                               const int64_t lda,
+                               double * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         __m256d r[4];
+                         int32_t k;
+                         for(k = 0; k != 4; ++k) {
+                             r[k] = _mm256_loadu_pd(&A[k*lda]);
+                         }
+                         transpose_ymm4r8_regs(&r[0]);
+                         if(nt) {
+                            for(k = 0; k != 4; ++k) {
+                                _mm256_stream_pd(&B[k*ldb],r[k]);
+                            }
+                         }
+                         else {
+                            for(k = 0; k != 4; ++k) {
+                                _mm256_storeu_pd(&B[k*ldb],r[k]);
+                            }
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r4_swap(float * X,
+                                    float * Y,
+                                    const int64_t ld) {
+
+                         __m256 rx[8];
+                         __m256 ry[8];
+                         int32_t k;
+                         for(k = 0; k != 8; ++k) {
+                             rx[k] = _mm256_loadu_ps(&X[k*ld]);
+                             ry[k] = _mm256_loadu_ps(&Y[k*ld]);
+                         }
+                         transpose_ymm8r4_regs(&rx[0]);
+                         transpose_ymm8r4_regs(&ry[0]);
+                         for(k = 0; k != 8; ++k) {
+                             _mm256_storeu_ps(&X[k*ld],ry[k]);
+                             _mm256_storeu_ps(&Y[k*ld],rx[k]);
+                         }
+                  }
+
+
+                  __attribute__((always_inline))
+                  static inline
+                  void tile_r8_swap(double * X,
+                                    double * Y,
+                                    const int64_t ld) {
+
+                         __m256d rx[4];
+                         __m256d ry[4];
+                         int32_t k;
+                         for(k = 0; k != 4; ++k) {
+                             rx[k] = _mm256_loadu_pd(&X[k*ld]);
+                             ry[k] = _mm256_loadu_pd(&Y[k*ld]);
+                         }
+                         transpose_ymm4r8_regs(&rx[0]);
+                         transpose_ymm4r8_regs(&ry[0]);
+                         for(k = 0; k != 4; ++k) {
+                             _mm256_storeu_pd(&X[k*ld],ry[k]);
+                             _mm256_storeu_pd(&Y[k*ld],rx[k]);
+                         }
+                  }
+
+#define NT_ALIGN 32
+
+#else
+
+#define R4_TILE 8
+#define R8_TILE 4
+#define NT_ALIGN 0
+
+                  static inline
+                  void tile_r4(const float * A,
+                               const int64_t lda,
+                               float * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+                         int32_t i,j;
+                         (void)nt;
+                         for(i = 0; i != R4_TILE; ++i) {
+                             for(j = 0; j != R4_TILE; ++j) {
+                                 B[j*ldb+i] = A[i*lda+j];
+                             }
+                         }
+                  }
+
+
+                  static inline
+                  void tile_r8(const double * A,
+                               const int64_t lda,
+                               double * B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+                         int32_t i,j;
+                         (void)nt;
+                         for(i = 0; i != R8_TILE; ++i) {
+                             for(j = 0; j != R8_TILE; ++j) {
+                                 B[j*ldb+i] = A[i*lda+j];
+                             }
+                         }
+                  }
+
+
+                  static inline
+                  void tile_r4_swap(float * X,
+                                    float * Y,
+                                    const int64_t ld) {
+                         float t[R4_TILE*R4_TILE];
+                         int32_t i,j;
+                         for(i = 0; i != R4_TILE; ++i) {
+                             for(j = 0; j != R4_TILE; ++j) {
+                                 t[j*R4_TILE+i] = X[i*ld+j];
+                             }
+                         }
+                         for(i = 0; i != R4_TILE; ++i) {
+                             for(j = 0; j != R4_TILE; ++j) {
+                                 X[j*ld+i] = Y[i*ld+j];
+                             }
+                         }
+                         for(i = 0; i != R4_TILE; ++i) {
+                             for(j = 0; j != R4_TILE; ++j) {
+                                 Y[i*ld+j] = t[i*R4_TILE+j];
+                             }
+                         }
+                  }
+
+
+                  static inline
+                  void tile_r8_swap(double * X,
+                                    double * Y,
+                                    const int64_t ld) {
+                         double t[R8_TILE*R8_TILE];
+                         int32_t i,j;
+                         for(i = 0; i != R8_TILE; ++i) {
+                             for(j = 0; j != R8_TILE; ++j) {
+                                 t[j*R8_TILE+i] = X[i*ld+j];
+                             }
+                         }
+                         for(i = 0; i != R8_TILE; ++i) {
+                             for(j = 0; j != R8_TILE; ++j) {
+                                 X[j*ld+i] = Y[i*ld+j];
+                             }
+                         }
+                         for(i = 0; i != R8_TILE; ++i) {
+                             for(j = 0; j != R8_TILE; ++j) {
+                                 Y[i*ld+j] = t[i*R8_TILE+j];
+                             }
+                         }
+                  }
+
+#endif
+
+
+/*
+     Leaf blocks: full tiles through the SIMD kernels, ragged edges scalar.
+*/
+
+                  static
+                  void leaf_r4(const int64_t m,
+                               const int64_t n,
+                               const float * __restrict A,
+                               const int64_t lda,
+                               float * __restrict B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         const int64_t mt = m-(m%R4_TILE);
+                         const int64_t nt0 = n-(n%R4_TILE);
+                         int64_t i,j;
+                         for(i = 0; i != mt; i += R4_TILE) {
+                             for(j = 0; j != nt0; j += R4_TILE) {
+                                 tile_r4(&A[i*lda+j],lda,&B[j*ldb+i],ldb,nt);
+                             }
+                             for(j = nt0; j != n; ++j) {
+                                 int64_t ii;
+                                 for(ii = i; ii != i+R4_TILE; ++ii) {
+                                     B[j*ldb+ii] = A[ii*lda+j];
+                                 }
+                             }
+                         }
+                         for(i = mt; i != m; ++i) {
+                             for(j = 0; j != n; ++j) {
+                                 B[j*ldb+i] = A[i*lda+j];
+                             }
+                         }
+                  }
+
+
+                  static
+                  void leaf_r8(const int64_t m,
+                               const int64_t n,
+                               const double * __restrict A,
+                               const int64_t lda,
+                               double * __restrict B,
+                               const int64_t ldb,
+                               const int32_t nt) {
+
+                         const int64_t mt = m-(m%R8_TILE);
+                         const int64_t nt0 = n-(n%R8_TILE);
+                         int64_t i,j;
+                         for(i = 0; i != mt; i += R8_TILE) {
+                             for(j = 0; j != nt0; j += R8_TILE) {
+                                 tile_r8(&A[i*lda+j],lda,&B[j*ldb+i],ldb,nt);
+                             }
+                             for(j = nt0; j != n; ++j) {
+                                 int64_t ii;
+                                 for(ii = i; ii != i+R8_TILE; ++ii) {
+                                     B[j*ldb+ii] = A[ii*lda+j];
+                                 }
+                             }
+                         }
+                         for(i = mt; i != m; ++i) {
+                             for(j = 0; j != n; ++j) {
+                                 B[j*ldb+i] = A[i*lda+j];
+                             }
+                         }
+                  }
+
+
+/*
+     Cache-oblivious recursion: split the longer side (on a tile boundary)
+     until the block fits into the leaf.
+*/
+
+                  static
+                  void rec_r4(const int64_t m,
+                              const int64_t n,
+                              const float * __restrict A,
+                              const int64_t lda,
+                              float * __restrict B,
+                              const int64_t ldb,
+                              const int32_t nt) {
+
+                         if(m <= GMS_TRANSPOSE_LEAF && n <= GMS_TRANSPOSE_LEAF) {
+                            leaf_r4(m,n,A,lda,B,ldb,nt);
+                            return;
+                         }
+                         if(m >= n) {
+                            int64_t h = (m/2);
+                            h = (h+R4_TILE-1)/R4_TILE*R4_TILE;
+                            rec_r4(h,n,A,lda,B,ldb,nt);
+                            rec_r4(m-h,n,&A[h*lda],lda,&B[h],ldb,nt);
+                         }
+                         else {
+                            int64_t h = (n/2);
+                            h = (h+R4_TILE-1)/R4_TILE*R4_TILE;
+                            rec_r4(m,h,A,lda,B,ldb,nt);
+                            rec_r4(m,n-h,&A[h],lda,&B[h*ldb],ldb,nt);
+                         }
+                  }
+
+
+                  static
+                  void rec_r8(const int64_t m,
+                              const int64_t n,
+                              const double * __restrict A,
+                              const int64_t lda,
+                              double * __restrict B,
+                              const int64_t ldb,
+                              const int32_t nt) {
+
+                         if(m <= GMS_TRANSPOSE_LEAF && n <= GMS_TRANSPOSE_LEAF) {
+                            leaf_r8(m,n,A,lda,B,ldb,nt);
+                            return;
+                         }
+                         if(m >= n) {
+                            int64_t h = (m/2);
+                            h = (h+R8_TILE-1)/R8_TILE*R8_TILE;
+                            rec_r8(h,n,A,lda,B,ldb,nt);
+                            rec_r8(m-h,n,&A[h*lda],lda,&B[h],ldb,nt);
+                         }
+                         else {
+                            int64_t h = (n/2);
+                            h = (h+R8_TILE-1)/R8_TILE*R8_TILE;
+                            rec_r8(m,h,A,lda,B,ldb,nt);
+                            rec_r8(m,n-h,&A[h],lda,&B[h*ldb],ldb,nt);
+                         }
+                  }
+
+
+                  // Streaming stores need every destination row of a full tile aligned.
+                  __attribute__((always_inline))
+                  static inline
+                  int32_t use_streaming(const void * B,
+                                        const int64_t ldb,
+                                        const int64_t nbytes,
+                                        const int64_t esize) {
+#if NT_ALIGN > 0
+                         if(nbytes < (int64_t)GMS_TRANSPOSE_NT_THRESHOLD) { return (0);}
+                         if(((uintptr_t)B % NT_ALIGN) != 0) { return (0);}
+                         if(((ldb*esize) % NT_ALIGN) != 0) { return (0);}
+                         return (1);
+#else
+                         (void)B; (void)ldb; (void)nbytes; (void)esize;
+                         return (0);
+#endif
+                  }
+
+
+                  void
+                  transpose_r4_oop(const int64_t m,
+                                   const int64_t n,
+                                   const float * __restrict A,
+                                   const int64_t lda,
+                                   float * __restrict B,
+                                   const int64_t ldb) {
+
+                         if(__builtin_expect(m<=0,0) ||
+                            __builtin_expect(n<=0,0)) { return;}
+                         if(__builtin_expect(lda<n,0) ||
+                            __builtin_expect(ldb<m,0)) { return;}
+                         const int32_t nt = use_streaming(B,ldb,m*n*(int64_t)sizeof(float),
+                                                          (int64_t)sizeof(float));
+                         rec_r4(m,n,A,lda,B,ldb,nt);
+                         if(nt) { _mm_sfence();}
+                  }
+
+
+                  void
+                  transpose_r8_oop(const int64_t m,
+                                   const int64_t n,
+                                   const double * __restrict A,
+                                   const int64_t lda,
+                                   double * __restrict B,
+                                   const int64_t ldb) {
+
+                         if(__builtin_expect(m<=0,0) ||
+                            __builtin_expect(n<=0,0)) { return;}
+                         if(__builtin_expect(lda<n,0) ||
+                            __builtin_expect(ldb<m,0)) { return;}
+                         const int32_t nt = use_streaming(B,ldb,m*n*(int64_t)sizeof(double),
+                                                          (int64_t)sizeof(double));
+                         rec_r8(m,n,A,lda,B,ldb,nt);
+                         if(nt) { _mm_sfence();}
+                  }
+
+
+                  void
+                  transpose_r4_oop_omp(const int64_t m,
+                                       const int64_t n,
+                                       const float * __restrict A,
+                                       const int64_t lda,
+                                       float * __restrict B,
+                                       const int64_t ldb) {
+
+                         if(__builtin_expect(m<=0,0) ||
+                            __builtin_expect(n<=0,0)) { return;}
+                         if(__builtin_expect(lda<n,0) ||
+                            __builtin_expect(ldb<m,0)) { return;}
+                         const int64_t bs = GMS_TRANSPOSE_OMP_BLOCK;
+                         const int64_t mb = (m+bs-1)/bs;
+                         const int64_t nb = (n+bs-1)/bs;
+                         const int32_t nt = use_streaming(B,ldb,m*n*(int64_t)sizeof(float),
+                                                          (int64_t)sizeof(float));
+                         int64_t bi,bj;
+#pragma omp parallel for collapse(2) schedule(dynamic,1) default(none) \
+            shared(A,B,lda,ldb,m,n,mb,nb,bs,nt) private(bi,bj)
+                         for(bi = 0; bi < mb; ++bi) {
+                             for(bj = 0; bj < nb; ++bj) {
+                                 const int64_t i0 = bi*bs;
+                                 const int64_t j0 = bj*bs;
+                                 const int64_t mm = (m-i0) < bs ? (m-i0) : bs;
+                                 const int64_t nn = (n-j0) < bs ? (n-j0) : bs;
+                                 rec_r4(mm,nn,&A[i0*lda+j0],lda,&B[j0*ldb+i0],ldb,nt);
+                             }
+                         }
+                         if(nt) { _mm_sfence();}
+                  }
+
+
+                  void
+                  transpose_r8_oop_omp(const int64_t m,
+                                       const int64_t n,
+                                       const double * __restrict A,
+                                       const int64_t lda,
+                                       double * __restrict B,
+                                       const int64_t ldb) {
+
+                         if(__builtin_expect(m<=0,0) ||
+                            __builtin_expect(n<=0,0)) { return;}
+                         if(__builtin_expect(lda<n,0) ||
+                            __builtin_expect(ldb<m,0)) { return;}
+                         const int64_t bs = GMS_TRANSPOSE_OMP_BLOCK;
+                         const int64_t mb = (m+bs-1)/bs;
+                         const int64_t nb = (n+bs-1)/bs;
+                         const int32_t nt = use_streaming(B,ldb,m*n*(int64_t)sizeof(double),
+                                                          (int64_t)sizeof(double));
+                         int64_t bi,bj;
+#pragma omp parallel for collapse(2) schedule(dynamic,1) default(none) \
+            shared(A,B,lda,ldb,m,n,mb,nb,bs,nt) private(bi,bj)
+                         for(bi = 0; bi < mb; ++bi) {
+                             for(bj = 0; bj < nb; ++bj) {
+                                 const int64_t i0 = bi*bs;
+                                 const int64_t j0 = bj*bs;
+                                 const int64_t mm = (m-i0) < bs ? (m-i0) : bs;
+                                 const int64_t nn = (n-j0) < bs ? (n-j0) : bs;
+                                 rec_r8(mm,nn,&A[i0*lda+j0],lda,&B[j0*ldb+i0],ldb,nt);
+                             }
+                         }
+                         if(nt) { _mm_sfence();}
+                  }
+
+
+/*
+     In-place, square: swap tile pairs (bi,bj) <-> (bj,bi), ragged edges scalar.
+*/
+
+                  static
+                  void square_row_r4(float * __restrict A,
+                                     const int64_t n,
+                                     const int64_t bi) {
+
+                         const int64_t nt0 = n-(n%R4_TILE);
+                         const int64_t i = bi*R4_TILE;
+                         int64_t j;
+                         for(j = i; j != nt0; j += R4_TILE) {
+                             tile_r4_swap(&A[i*n+j],&A[j*n+i],n);
+                         }
+                         for(j = nt0; j != n; ++j) {
+                             int64_t ii;
+                             for(ii = i; ii != i+R4_TILE; ++ii) {
+                                 const float t = A[ii*n+j];
+                                 A[ii*n+j] = A[j*n+ii];
+                                 A[j*n+ii] = t;
+                             }
+                         }
+                  }
+
+
+                  static
+                  void square_row_r8(double * __restrict A,
+                                     const int64_t n,
+                                     const int64_t bi) {
+
+                         const int64_t nt0 = n-(n%R8_TILE);
+                         const int64_t i = bi*R8_TILE;
+                         int64_t j;
+                         for(j = i; j != nt0; j += R8_TILE) {
+                             tile_r8_swap(&A[i*n+j],&A[j*n+i],n);
+                         }
+                         for(j = nt0; j != n; ++j) {
+                             int64_t ii;
+                             for(ii = i; ii != i+R8_TILE; ++ii) {
+                                 const double t = A[ii*n+j];
+                                 A[ii*n+j] = A[j*n+ii];
+                                 A[j*n+ii] = t;
+                             }
+                         }
+                  }
+
+
+                  static
+                  void square_tail_r4(float * __restrict A,
+                                      const int64_t n) {
+
+                         const int64_t nt0 = n-(n%R4_TILE);
+                         int64_t i,j;
+                         for(i = nt0; i != n; ++i) {
+                             for(j = i+1; j != n; ++j) {
+                                 const float t = A[i*n+j];
+                                 A[i*n+j] = A[j*n+i];
+                                 A[j*n+i] = t;
+                             }
+                         }
+                  }
+
+
+                  static
+                  void square_tail_r8(double * __restrict A,
+                                      const int64_t n) {
+
+                         const int64_t nt0 = n-(n%R8_TILE);
+                         int64_t i,j;
+                         for(i = nt0; i != n; ++i) {
+                             for(j = i+1; j != n; ++j) {
+                                 const double t = A[i*n+j];
+                                 A[i*n+j] = A[j*n+i];
+                                 A[j*n+i] = t;
+                             }
+                         }
+                  }
+
+
+/*
+     In-place, rectangular: element (i,j) at k = i*n+j moves to j*m+i,
+     i.e. k -> k*m mod (m*n-1). Each cycle is rotated once, the bitmap
+     marks the already visited positions.
+*/
+
+#define CYCLE_FOLLOW_BODY(type)                                             \
+                         const int64_t mn1 = m*n-1;                         \
+                         const int64_t nw  = (m*n+63)/64;                   \
+                         uint64_t * __restrict vis = NULL;                  \
+                         int64_t s;                                         \
+                         vis = (uint64_t*)calloc((size_t)nw,sizeof(uint64_t)); \
+                         if(__builtin_expect(NULL==vis,0)) { return (-1);}  \
+                         for(s = 1; s < mn1; ++s) {                         \
+                             int64_t k;                                     \
+                             type carry;                                    \
+                             if(vis[s>>6] & (1ULL<<(s&63))) { continue;}    \
+                             carry = A[s];                                  \
+                             k = s;                                         \
+                             do {                                           \
+                                 const int64_t d = (k*m) % mn1;             \
+                                 const type t = A[d];                       \
+                                 A[d] = carry;                              \
+                                 carry = t;                                 \
+                                 vis[d>>6] |= (1ULL<<(d&63));               \
+                                 k = d;                                     \
+                             } while(k != s);                               \
+                         }                                                  \
+                         free(vis);                                         \
+                         return (0);
+
+
+                  static
+                  int32_t cycle_follow_r4(float * __restrict A,
+                                          const int64_t m,
+                                          const int64_t n) {
+                         CYCLE_FOLLOW_BODY(float)
+                  }
+
+
+                  static
+                  int32_t cycle_follow_r8(double * __restrict A,
+                                          const int64_t m,
+                                          const int64_t n) {
+                         CYCLE_FOLLOW_BODY(double)
+                  }
+
+
+                  int32_t
+                  transpose_r4_ip(float * __restrict A,
+                                  const int64_t m,
+                                  const int64_t n) {
+
+                         if(__builtin_expect(NULL==A,0) ||
+                            __builtin_expect(m<=0,0)    ||
+                            __builtin_expect(n<=0,0)) { return (-1);}
+                         if(m == n) {
+                            const int64_t nb = n/R4_TILE;
+                            int64_t bi;
+                            for(bi = 0; bi != nb; ++bi) {
+                                square_row_r4(A,n,bi);
+                            }
+                            square_tail_r4(A,n);
+                            return (0);
+                         }
+                         if(m == 1 || n == 1) { return (0);}
+                         return (cycle_follow_r4(A,m,n));
+                  }
+
+
+                  int32_t
+                  transpose_r8_ip(double * __restrict A,
+                                  const int64_t m,
+                                  const int64_t n) {
+
+                         if(__builtin_expect(NULL==A,0) ||
+                            __builtin_expect(m<=0,0)    ||
+                            __builtin_expect(n<=0,0)) { return (-1);}
+                         if(m == n) {
+                            const int64_t nb = n/R8_TILE;
+                            int64_t bi;
+                            for(bi = 0; bi != nb; ++bi) {
+                                square_row_r8(A,n,bi);
+                            }
+                            square_tail_r8(A,n);
+                            return (0);
+                         }
+                         if(m == 1 || n == 1) { return (0);}
+                         return (cycle_follow_r8(A,m,n));
+                  }
+
+
+                  int32_t
+                  transpose_r4_ip_omp(float * __restrict A,
+                                      const int64_t m,
+                                      const int64_t n) {
+
+                         if(__builtin_expect(NULL==A,0) ||
+                            __builtin_expect(m<=0,0)    ||
+                            __builtin_expect(n<=0,0)) { return (-1);}
+                         if(m == n) {
+                            const int64_t nb = n/R4_TILE;
+                            int64_t bi;
+                            // Tile rows get shorter towards the bottom, hence dynamic.
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(A,n,nb) private(bi)
+                            for(bi = 0; bi < nb; ++bi) {
+                                square_row_r4(A,n,bi);
+                            }
+                            square_tail_r4(A,n);
+                            return (0);
+                         }
+                         return (transpose_r4_ip(A,m,n));
+                  }
+
+
+                  int32_t
+                  transpose_r8_ip_omp(double * __restrict A,
+                                      const int64_t m,
+                                      const int64_t n) {
+
+                         if(__builtin_expect(NULL==A,0) ||
+                            __builtin_expect(m<=0,0)    ||
+                            __builtin_expect(n<=0,0)) { return (-1);}
+                         if(m == n) {
+                            const int64_t nb = n/R8_TILE;
+                            int64_t bi;
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(A,n,nb) private(bi)
+                            for(bi = 0; bi < nb; ++bi) {
+                                square_row_r8(A,n,bi);
+                            }
+                            square_tail_r8(A,n);
+                            return (0);
+                         }
+                         return (transpose_r8_ip(A,m,n));
+                  }
@@ -0,0 +1,149 @@
+
+
+#ifndef __GMS_MATRIX_TRANSPOSE_H__
+#define __GMS_MATRIX_TRANSPOSE_H__ 181020260900
+
+
+
+const unsigned int gGMS_MATRIX_TRANSPOSE_MAJOR = 1U;
+const unsigned int gGMS_MATRIX_TRANSPOSE_MINOR = 0U;
+const unsigned int gGMS_MATRIX_TRANSPOSE_MICRO = 0U;
+const unsigned int gGMS_MATRIX_TRANSPOSE_FULLVER =
+       1000U*gGMS_MATRIX_TRANSPOSE_MAJOR+
+       100U*gGMS_MATRIX_TRANSPOSE_MINOR +
+       10U*gGMS_MATRIX_TRANSPOSE_MICRO;
+const char * const pgGMS_MATRIX_TRANSPOSE_CREATION_DATE = "18-10-2026 09:00 AM +00200 (SUN 18 OCT 2026 GMT+2)";
+const char * const pgGMS_MATRIX_TRANSPOSE_BUILD_DATE    = __DATE__ ":" __TIME__;
+const char * const pgGMS_MATRIX_TRANSPOSE_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+const char * const pgGMS_MATRIX_TRANSPOSE_DESCRIPTION   = "Cache-oblivious MxN matrix transposition built on 8x8/16x16 SIMD tiles.";
+
+
+/*
+     General MxN transposition (out-of-place and in-place) for float and double
+     matrices. The traversal is recursive (cache-oblivious): the longer dimension
+     is halved until the sub-block fits into GMS_TRANSPOSE_LEAF x GMS_TRANSPOSE_LEAF,
+     where the register-resident tile kernels take over:
+       AVX512F -> 16x16 (r4) and 8x8 (r8) tiles,
+       AVX2    ->  8x8  (r4) and 4x4 (r8) tiles,
+     with scalar code for the ragged edges.
+     Storage is row-major with explicit leading dimensions, i.e.
+     A(i,j) = A[i*lda+j], B(j,i) = B[j*ldb+i]. Because transposition is symmetric
+     the very same calls serve column-major (Fortran) arrays: just pass the
+     Fortran leading dimensions and swap m and n.
+     When the output exceeds GMS_TRANSPOSE_NT_THRESHOLD bytes and the destination
+     rows are 64-byte (AVX512) or 32-byte (AVX2) aligned, full tiles are written
+     with non-temporal stores.
+*/
+
+#include <stdint.h>
+
+// Leaf size (elements) of the recursive traversal.
+#if !defined(GMS_TRANSPOSE_LEAF)
+    #define GMS_TRANSPOSE_LEAF 64
+#endif
+
+// Block size (elements) distributed over the OpenMP threads.
+#if !defined(GMS_TRANSPOSE_OMP_BLOCK)
+    #define GMS_TRANSPOSE_OMP_BLOCK 256
+#endif
+
+// Output size (bytes) above which streaming stores are used.
+#if !defined(GMS_TRANSPOSE_NT_THRESHOLD)
+    #define GMS_TRANSPOSE_NT_THRESHOLD 8388608
+#endif
+
+
+             // B(n x m) = A(m x n)^T
+             void
+             transpose_r4_oop(const int64_t,
+                              const int64_t,
+                              const float * __restrict,
+                              const int64_t,
+                              float * __restrict,
+                              const int64_t)  __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+
+             void
+             transpose_r8_oop(const int64_t,
+                              const int64_t,
+                              const double * __restrict,
+                              const int64_t,
+                              double * __restrict,
+                              const int64_t)  __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+
+             void
+             transpose_r4_oop_omp(const int64_t,
+                                  const int64_t,
+                                  const float * __restrict,
+                                  const int64_t,
+                                  float * __restrict,
+                                  const int64_t)  __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+             void
+             transpose_r8_oop_omp(const int64_t,
+                                  const int64_t,
+                                  const double * __restrict,
+                                  const int64_t,
+                                  double * __restrict,
+                                  const int64_t)  __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+             /*
+                  In-place transposition of a densely stored m x n matrix
+                  (leading dimension n on input, m on output).
+                  Square matrices are transposed by tile-pair swapping,
+                  rectangular ones by cycle-following with a visited bitmap
+                  (m*n/8 bytes of scratch).
+                  Returns 0 on success, -1 on invalid arguments or when
+                  the bitmap cannot be allocated.
+             */
+             int32_t
+             transpose_r4_ip(float * __restrict,
+                             const int64_t,
+                             const int64_t)   __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+
+             int32_t
+             transpose_r8_ip(double * __restrict,
+                             const int64_t,
+                             const int64_t)   __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+
+             // Only the square case is threaded, rectangular falls back to serial.
+             int32_t
+             transpose_r4_ip_omp(float * __restrict,
+                                 const int64_t,
+                                 const int64_t)   __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+             int32_t
+             transpose_r8_ip_omp(double * __restrict,
+                                 const int64_t,
+                                 const int64_t)   __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+
+
+
+
+
+
+#endif /*__GMS_MATRIX_TRANSPOSE_H__*/
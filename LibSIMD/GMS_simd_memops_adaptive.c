@@ -0,0 +1,680 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_simd_memops_adaptive.h"
+#include "GMS_cpuid.h"
+
+
+// Implemented in GMS_cpuid_x86.c
+extern int get_cacheinfo(int, cache_info_t *);
+
+
+#if defined(__AVX512F__)
+    #define MOPS_VLEN 64
+    typedef __m512i mops_vec_t;
+    #define MOPS_LOADU(p)     _mm512_loadu_si512((const void*)(p))
+    #define MOPS_STOREU(p,v)  _mm512_storeu_si512((void*)(p),(v))
+    #define MOPS_STOREA(p,v)  _mm512_store_si512((void*)(p),(v))
+    #define MOPS_STREAM(p,v)  _mm512_stream_si512((__m512i*)(p),(v))
+    #define MOPS_SET1(c)      _mm512_set1_epi8((char)(c))
+#else
+    #define MOPS_VLEN 32
+    typedef __m256i mops_vec_t;
+    #define MOPS_LOADU(p)     _mm256_loadu_si256((const __m256i*)(p))
+    #define MOPS_STOREU(p,v)  _mm256_storeu_si256((__m256i*)(p),(v))
+    #define MOPS_STOREA(p,v)  _mm256_store_si256((__m256i*)(p),(v))
+    #define MOPS_STREAM(p,v)  _mm256_stream_si256((__m256i*)(p),(v))
+    #define MOPS_SET1(c)      _mm256_set1_epi8((char)(c))
+#endif
+
+#define MOPS_PAGE 4096
+
+
+static gms_memops_cfg_t gms_mops_cfg = {0,0,0,0};
+static volatile int32_t gms_mops_ready = 0;
+
+
+void gms_memops_init(void) {
+
+       cache_info_t l3;
+       size_t llc;
+       memset(&l3,0,sizeof(l3));
+       llc = 0;
+       // get_cacheinfo reports sizes in KiB (0 when the level is absent).
+       get_cacheinfo(CACHE_INFO_L3,&l3);
+       if(l3.size > 0) {
+          llc = (size_t)l3.size*1024ULL;
+       }
+       else {
+          cache_info_t l2;
+          memset(&l2,0,sizeof(l2));
+          get_cacheinfo(CACHE_INFO_L2,&l2);
+          if(l2.size > 0)
+             llc = (size_t)l2.size*1024ULL;
+       }
+       if(llc == 0) llc = GMS_MEMOPS_DEFAULT_LLC;
+       gms_mops_cfg.llc     = llc;
+       gms_mops_cfg.rep_max = GMS_MEMOPS_REP_MAX;
+       // Streaming pays off once the copy would evict a sizeable part of the LLC
+       // (source and destination both compete for it).
+       gms_mops_cfg.nt_min  = llc/2;
+       gms_mops_cfg.mt_min  = (2*llc > GMS_MEMOPS_MT_FLOOR) ? 2*llc : GMS_MEMOPS_MT_FLOOR;
+       __atomic_store_n(&gms_mops_ready,1,__ATOMIC_RELEASE);
+}
+
+
+void gms_memops_set_thresholds(const size_t rep_max,
+                               const size_t nt_min,
+                               const size_t mt_min) {
+
+       if(!__atomic_load_n(&gms_mops_ready,__ATOMIC_ACQUIRE))
+          gms_memops_init();
+       if(rep_max != 0) gms_mops_cfg.rep_max = rep_max;
+       if(nt_min  != 0) gms_mops_cfg.nt_min  = nt_min;
+       if(mt_min  != 0) gms_mops_cfg.mt_min  = mt_min;
+}
+
+
+void gms_memops_get_config(gms_memops_cfg_t * __restrict cfg) {
+
+       if(__builtin_expect(NULL==cfg,0)) return;
+       if(!__atomic_load_n(&gms_mops_ready,__ATOMIC_ACQUIRE))
+          gms_memops_init();
+       *cfg = gms_mops_cfg;
+}
+
+
+static inline
+const gms_memops_cfg_t * mops_cfg(void) {
+
+       if(__builtin_expect(!__atomic_load_n(&gms_mops_ready,__ATOMIC_ACQUIRE),0))
+          gms_memops_init();
+       return (&gms_mops_cfg);
+}
+
+
+/*
+     Small sizes: ERMSB 'rep movsb'/'rep stosb'.
+*/
+static inline
+void mops_rep_movsb(void * dst,
+                    const void * src,
+                    size_t n) {
+
+       __asm__ __volatile__("rep movsb"
+                            : "+D"(dst), "+S"(src), "+c"(n)
+                            :
+                            : "memory");
+}
+
+
+static inline
+void mops_rep_stosb(void * dst,
+                    const int32_t c,
+                    size_t n) {
+
+       __asm__ __volatile__("rep stosb"
+                            : "+D"(dst), "+c"(n)
+                            : "a"(c)
+                            : "memory");
+}
+
+
+/*
+     Tiny sizes (n <= 2*MOPS_VLEN): two overlapping loads/stores of the widest
+     fitting width, avoiding the start-up latency of the string instructions.
+*/
+static inline
+void mops_copy_tiny(unsigned char * d,
+                    const unsigned char * s,
+                    const size_t n) {
+
+       if(n >= MOPS_VLEN) {
+          const mops_vec_t v0 = MOPS_LOADU(s);
+          const mops_vec_t v1 = MOPS_LOADU(s+n-MOPS_VLEN);
+          MOPS_STOREU(d,v0);
+          MOPS_STOREU(d+n-MOPS_VLEN,v1);
+       }
+#if MOPS_VLEN == 64
+       else if(n >= 32) {
+          const __m256i v0 = _mm256_loadu_si256((const __m256i*)s);
+          const __m256i v1 = _mm256_loadu_si256((const __m256i*)(s+n-32));
+          _mm256_storeu_si256((__m256i*)d,v0);
+          _mm256_storeu_si256((__m256i*)(d+n-32),v1);
+       }
+#endif
+       else if(n >= 16) {
+          const __m128i v0 = _mm_loadu_si128((const __m128i*)s);
+          const __m128i v1 = _mm_loadu_si128((const __m128i*)(s+n-16));
+          _mm_storeu_si128((__m128i*)d,v0);
+          _mm_storeu_si128((__m128i*)(d+n-16),v1);
+       }
+       else if(n >= 8) {
+          uint64_t a,b;
+          memcpy(&a,s,8); memcpy(&b,s+n-8,8);
+          memcpy(d,&a,8); memcpy(d+n-8,&b,8);
+       }
+       else if(n >= 4) {
+          uint32_t a,b;
+          memcpy(&a,s,4); memcpy(&b,s+n-4,4);
+          memcpy(d,&a,4); memcpy(d+n-4,&b,4);
+       }
+       else if(n != 0) {
+          const unsigned char a = s[0];
+          const unsigned char b = s[n>>1];
+          const unsigned char c = s[n-1];
+          d[0] = a; d[n>>1] = b; d[n-1] = c;
+       }
+}
+
+
+static inline
+void mops_set_tiny(unsigned char * __restrict d,
+                   const int32_t c,
+                   const size_t n) {
+
+       if(n >= MOPS_VLEN) {
+          const mops_vec_t v = MOPS_SET1(c);
+          MOPS_STOREU(d,v);
+          MOPS_STOREU(d+n-MOPS_VLEN,v);
+       }
+       else if(n >= 16) {
+          const __m128i v = _mm_set1_epi8((char)c);
+          size_t i;
+          for(i = 0; i+16 <= n; i += 16)
+              _mm_storeu_si128((__m128i*)(d+i),v);
+          _mm_storeu_si128((__m128i*)(d+n-16),v);
+       }
+       else {
+          const uint64_t v = 0x0101010101010101ULL*(uint64_t)(c&0xFF);
+          if(n >= 8) {
+             memcpy(d,&v,8); memcpy(d+n-8,&v,8);
+          }
+          else if(n >= 4) {
+             memcpy(d,&v,4); memcpy(d+n-4,&v,4);
+          }
+          else if(n != 0) {
+             d[0] = (unsigned char)c; d[n>>1] = (unsigned char)c; d[n-1] = (unsigned char)c;
+          }
+       }
+}
+
+
+/*
+     Copy of n >= MOPS_VLEN bytes: unaligned head, destination-aligned 4x unrolled
+     body (temporal or streaming), overlapping unaligned tail.
+*/
+static inline
+void mops_copy_vec(unsigned char * __restrict d,
+                   const unsigned char * __restrict s,
+                   const size_t n,
+                   const int32_t nt) {
+
+       const mops_vec_t head = MOPS_LOADU(s);
+       const mops_vec_t tail = MOPS_LOADU(s+n-MOPS_VLEN);
+       size_t skew,i,len;
+       unsigned char * __restrict da;
+       const unsigned char * __restrict sa;
+       skew = (size_t)(-(uintptr_t)d) & (MOPS_VLEN-1);
+       da   = d+skew;
+       sa   = s+skew;
+       len  = n-skew;
+       i    = 0;
+       if(nt) {
+          for(; i+4*MOPS_VLEN <= len; i += 4*MOPS_VLEN) {
+              _mm_prefetch((const char*)&sa[i+8*MOPS_VLEN],_MM_HINT_NTA);
+              const mops_vec_t v0 = MOPS_LOADU(&sa[i+0*MOPS_VLEN]);
+              const mops_vec_t v1 = MOPS_LOADU(&sa[i+1*MOPS_VLEN]);
+              const mops_vec_t v2 = MOPS_LOADU(&sa[i+2*MOPS_VLEN]);
+              const mops_vec_t v3 = MOPS_LOADU(&sa[i+3*MOPS_VLEN]);
+              MOPS_STREAM(&da[i+0*MOPS_VLEN],v0);
+              MOPS_STREAM(&da[i+1*MOPS_VLEN],v1);
+              MOPS_STREAM(&da[i+2*MOPS_VLEN],v2);
+              MOPS_STREAM(&da[i+3*MOPS_VLEN],v3);
+          }
+          for(; i+MOPS_VLEN <= len; i += MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&sa[i]);
+              MOPS_STREAM(&da[i],v0);
+          }
+          _mm_sfence();
+       }
+       else {
+          for(; i+4*MOPS_VLEN <= len; i += 4*MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&sa[i+0*MOPS_VLEN]);
+              const mops_vec_t v1 = MOPS_LOADU(&sa[i+1*MOPS_VLEN]);
+              const mops_vec_t v2 = MOPS_LOADU(&sa[i+2*MOPS_VLEN]);
+              const mops_vec_t v3 = MOPS_LOADU(&sa[i+3*MOPS_VLEN]);
+              MOPS_STOREA(&da[i+0*MOPS_VLEN],v0);
+              MOPS_STOREA(&da[i+1*MOPS_VLEN],v1);
+              MOPS_STOREA(&da[i+2*MOPS_VLEN],v2);
+              MOPS_STOREA(&da[i+3*MOPS_VLEN],v3);
+          }
+          for(; i+MOPS_VLEN <= len; i += MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&sa[i]);
+              MOPS_STOREA(&da[i],v0);
+          }
+       }
+       // Head and tail were loaded up-front, so the overlapping stores are safe.
+       MOPS_STOREU(d,head);
+       MOPS_STOREU(d+n-MOPS_VLEN,tail);
+}
+
+
+static inline
+void mops_set_vec(unsigned char * __restrict d,
+                  const int32_t c,
+                  const size_t n,
+                  const int32_t nt) {
+
+       const mops_vec_t v = MOPS_SET1(c);
+       size_t skew,i,len;
+       unsigned char * __restrict da;
+       skew = (size_t)(-(uintptr_t)d) & (MOPS_VLEN-1);
+       da   = d+skew;
+       len  = n-skew;
+       i    = 0;
+       MOPS_STOREU(d,v);
+       if(nt) {
+          for(; i+4*MOPS_VLEN <= len; i += 4*MOPS_VLEN) {
+              MOPS_STREAM(&da[i+0*MOPS_VLEN],v);
+              MOPS_STREAM(&da[i+1*MOPS_VLEN],v);
+              MOPS_STREAM(&da[i+2*MOPS_VLEN],v);
+              MOPS_STREAM(&da[i+3*MOPS_VLEN],v);
+          }
+          for(; i+MOPS_VLEN <= len; i += MOPS_VLEN)
+              MOPS_STREAM(&da[i],v);
+          _mm_sfence();
+       }
+       else {
+          for(; i+4*MOPS_VLEN <= len; i += 4*MOPS_VLEN) {
+              MOPS_STOREA(&da[i+0*MOPS_VLEN],v);
+              MOPS_STOREA(&da[i+1*MOPS_VLEN],v);
+              MOPS_STOREA(&da[i+2*MOPS_VLEN],v);
+              MOPS_STOREA(&da[i+3*MOPS_VLEN],v);
+          }
+          for(; i+MOPS_VLEN <= len; i += MOPS_VLEN)
+              MOPS_STOREA(&da[i],v);
+       }
+       MOPS_STOREU(d+n-MOPS_VLEN,v);
+}
+
+
+/*
+     Huge sizes: destination split into page-aligned chunks, one per thread.
+     Each thread runs the streaming kernel (and its own sfence) on its chunk.
+*/
+static
+void mops_copy_mt(unsigned char * __restrict d,
+                  const unsigned char * __restrict s,
+                  const size_t n) {
+
+#if defined(_OPENMP)
+       int32_t nth;
+       nth = omp_get_max_threads();
+       if(nth > 1) {
+#pragma omp parallel default(none) shared(d,s) firstprivate(n,nth)
+          {
+              const int32_t tid = omp_get_thread_num();
+              const int32_t nt  = omp_get_num_threads();
+              size_t chunk,lo,hi;
+              chunk = (n/(size_t)nt+MOPS_PAGE-1) & ~((size_t)MOPS_PAGE-1);
+              lo    = (size_t)tid*chunk;
+              hi    = lo+chunk;
+              if(hi > n) hi = n;
+              if(lo < hi) {
+                 if(hi-lo >= MOPS_VLEN)
+                    mops_copy_vec(d+lo,s+lo,hi-lo,1);
+                 else
+                    mops_rep_movsb(d+lo,s+lo,hi-lo);
+              }
+          }
+          return;
+       }
+#endif
+       mops_copy_vec(d,s,n,1);
+}
+
+
+static
+void mops_set_mt(unsigned char * __restrict d,
+                 const int32_t c,
+                 const size_t n) {
+
+#if defined(_OPENMP)
+       int32_t nth;
+       nth = omp_get_max_threads();
+       if(nth > 1) {
+#pragma omp parallel default(none) shared(d) firstprivate(c,n,nth)
+          {
+              const int32_t tid = omp_get_thread_num();
+              const int32_t nt  = omp_get_num_threads();
+              size_t chunk,lo,hi;
+              chunk = (n/(size_t)nt+MOPS_PAGE-1) & ~((size_t)MOPS_PAGE-1);
+              lo    = (size_t)tid*chunk;
+              hi    = lo+chunk;
+              if(hi > n) hi = n;
+              if(lo < hi) {
+                 if(hi-lo >= MOPS_VLEN)
+                    mops_set_vec(d+lo,c,hi-lo,1);
+                 else
+                    mops_rep_stosb(d+lo,c,hi-lo);
+              }
+          }
+          return;
+       }
+#endif
+       mops_set_vec(d,c,n,1);
+}
+
+
+void * gms_memcpy(void * __restrict dst,
+                  const void * __restrict src,
+                  const size_t n) {
+
+       const gms_memops_cfg_t * __restrict cfg = mops_cfg();
+       unsigned char * __restrict d = (unsigned char*)dst;
+       const unsigned char * __restrict s = (const unsigned char*)src;
+       if(n <= 2*MOPS_VLEN) {
+          mops_copy_tiny(d,s,n);
+       }
+       else if(n <= cfg->rep_max) {
+          mops_rep_movsb(d,s,n);
+       }
+       else if(n <= cfg->nt_min) {
+          mops_copy_vec(d,s,n,0);
+       }
+       else if(n <= cfg->mt_min) {
+          mops_copy_vec(d,s,n,1);
+       }
+       else {
+          mops_copy_mt(d,s,n);
+       }
+       return (dst);
+}
+
+
+void * gms_memset(void * __restrict dst,
+                  const int32_t c,
+                  const size_t n) {
+
+       const gms_memops_cfg_t * __restrict cfg = mops_cfg();
+       unsigned char * __restrict d = (unsigned char*)dst;
+       // memset only writes, so streaming starts at twice the copy threshold.
+       if(n <= 2*MOPS_VLEN) {
+          mops_set_tiny(d,c,n);
+       }
+       else if(n <= cfg->rep_max) {
+          mops_rep_stosb(d,c&0xFF,n);
+       }
+       else if(n <= 2*cfg->nt_min) {
+          mops_set_vec(d,c,n,0);
+       }
+       else if(n <= cfg->mt_min) {
+          mops_set_vec(d,c,n,1);
+       }
+       else {
+          mops_set_mt(d,c,n);
+       }
+       return (dst);
+}
+
+
+void * gms_memmove(void * dst,
+                   const void * src,
+                   const size_t n) {
+
+       unsigned char * d = (unsigned char*)dst;
+       const unsigned char * s = (const unsigned char*)src;
+       const uintptr_t ud = (uintptr_t)d;
+       const uintptr_t us = (uintptr_t)s;
+       if(__builtin_expect(0==n || d==s,0)) return (dst);
+       if(ud-us >= n && us-ud >= n) {
+          // Disjoint ranges.
+          return (gms_memcpy(dst,src,n));
+       }
+       if(n <= 2*MOPS_VLEN) {
+          // All loads precede all stores in the tiny kernel.
+          mops_copy_tiny(d,s,n);
+          return (dst);
+       }
+       if(ud < us) {
+          // Forward copy: every block is loaded before the stores that may clobber
+          // it, the tail block is preloaded.
+          const mops_vec_t tail = MOPS_LOADU(s+n-MOPS_VLEN);
+          size_t i;
+          i = 0;
+          for(; i+4*MOPS_VLEN <= n-MOPS_VLEN; i += 4*MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&s[i+0*MOPS_VLEN]);
+              const mops_vec_t v1 = MOPS_LOADU(&s[i+1*MOPS_VLEN]);
+              const mops_vec_t v2 = MOPS_LOADU(&s[i+2*MOPS_VLEN]);
+              const mops_vec_t v3 = MOPS_LOADU(&s[i+3*MOPS_VLEN]);
+              MOPS_STOREU(&d[i+0*MOPS_VLEN],v0);
+              MOPS_STOREU(&d[i+1*MOPS_VLEN],v1);
+              MOPS_STOREU(&d[i+2*MOPS_VLEN],v2);
+              MOPS_STOREU(&d[i+3*MOPS_VLEN],v3);
+          }
+          for(; i+MOPS_VLEN <= n-MOPS_VLEN; i += MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&s[i]);
+              MOPS_STOREU(&d[i],v0);
+          }
+          for(; i < n-MOPS_VLEN; ++i) d[i] = s[i];
+          MOPS_STOREU(d+n-MOPS_VLEN,tail);
+       }
+       else {
+          // Backward copy, the head block is preloaded.
+          const mops_vec_t head = MOPS_LOADU(s);
+          size_t i;
+          i = n;
+          for(; i >= 4*MOPS_VLEN+MOPS_VLEN; i -= 4*MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&s[i-1*MOPS_VLEN]);
+              const mops_vec_t v1 = MOPS_LOADU(&s[i-2*MOPS_VLEN]);
+              const mops_vec_t v2 = MOPS_LOADU(&s[i-3*MOPS_VLEN]);
+              const mops_vec_t v3 = MOPS_LOADU(&s[i-4*MOPS_VLEN]);
+              MOPS_STOREU(&d[i-1*MOPS_VLEN],v0);
+              MOPS_STOREU(&d[i-2*MOPS_VLEN],v1);
+              MOPS_STOREU(&d[i-3*MOPS_VLEN],v2);
+              MOPS_STOREU(&d[i-4*MOPS_VLEN],v3);
+          }
+          for(; i >= 2*MOPS_VLEN; i -= MOPS_VLEN) {
+              const mops_vec_t v0 = MOPS_LOADU(&s[i-MOPS_VLEN]);
+              MOPS_STOREU(&d[i-MOPS_VLEN],v0);
+          }
+          for(; i > MOPS_VLEN; --i) d[i-1] = s[i-1];
+          MOPS_STOREU(d,head);
+       }
+       return (dst);
+}
+
+
+void zmm16r4_memcpy_adaptive(float * __restrict dst,
+                             const float * __restrict src,
+                             const int64_t len) {
+
+       if(__builtin_expect(len<=0,0)) return;
+       gms_memcpy(dst,src,(size_t)len*sizeof(float));
+}
+
+
+void zmm8r8_memcpy_adaptive(double * __restrict dst,
+                            const double * __restrict src,
+                            const int64_t len) {
+
+       if(__builtin_expect(len<=0,0)) return;
+       gms_memcpy(dst,src,(size_t)len*sizeof(double));
+}
+
+
+void zmm16r4_init_adaptive(float * __restrict dst,
+                           const int64_t len,
+                           const float val) {
+
+       if(__builtin_expect(len<=0,0)) return;
+       if(val == 0.0f && !__builtin_signbit(val)) {
+          gms_memset(dst,0,(size_t)len*sizeof(float));
+          return;
+       }
+       {
+          const gms_memops_cfg_t * __restrict cfg = mops_cfg();
+          const size_t n = (size_t)len*sizeof(float);
+          const int32_t nt = (n > 2*cfg->nt_min && ((uintptr_t)dst & (MOPS_VLEN-1)) == 0);
+          int64_t i;
+#if defined(__AVX512F__)
+          const __m512 v = _mm512_set1_ps(val);
+          if(nt) {
+             for(i = 0; i+16 <= len; i += 16)
+                 _mm512_stream_ps(&dst[i],v);
+             _mm_sfence();
+          }
+          else {
+             for(i = 0; i+16 <= len; i += 16)
+                 _mm512_storeu_ps(&dst[i],v);
+          }
+#else
+          const __m256 v = _mm256_set1_ps(val);
+          if(nt) {
+             for(i = 0; i+8 <= len; i += 8)
+                 _mm256_stream_ps(&dst[i],v);
+             _mm_sfence();
+          }
+          else {
+             for(i = 0; i+8 <= len; i += 8)
+                 _mm256_storeu_ps(&dst[i],v);
+          }
+#endif
+          for(; i != len; ++i) dst[i] = val;
+       }
+}
+
+
+void zmm8r8_init_adaptive(double * __restrict dst,
+                          const int64_t len,
+                          const double val) {
+
+       if(__builtin_expect(len<=0,0)) return;
+       if(val == 0.0 && !__builtin_signbit(val)) {
+          gms_memset(dst,0,(size_t)len*sizeof(double));
+          return;
+       }
+       {
+          const gms_memops_cfg_t * __restrict cfg = mops_cfg();
+          const size_t n = (size_t)len*sizeof(double);
+          const int32_t nt = (n > 2*cfg->nt_min && ((uintptr_t)dst & (MOPS_VLEN-1)) == 0);
+          int64_t i;
+#if defined(__AVX512F__)
+          const __m512d v = _mm512_set1_pd(val);
+          if(nt) {
+             for(i = 0; i+8 <= len; i += 8)
+                 _mm512_stream_pd(&dst[i],v);
+             _mm_sfence();
+          }
+          else {
+             for(i = 0; i+8 <= len; i += 8)
+                 _mm512_storeu_pd(&dst[i],v);
+          }
+#else
+          const __m256d v = _mm256_set1_pd(val);
+          if(nt) {
+             for(i = 0; i+4 <= len; i += 4)
+                 _mm256_stream_pd(&dst[i],v);
+             _mm_sfence();
+          }
+          else {
+             for(i = 0; i+4 <= len; i += 4)
+                 _mm256_storeu_pd(&dst[i],v);
+          }
+#endif
+          for(; i != len; ++i) dst[i] = val;
+       }
+}
+
+
+/*
+     Benchmark driver.
+*/
+static inline
+double mops_wtime(void) {
+#if defined(_OPENMP)
+       return (omp_get_wtime());
+#else
+       struct timespec ts;
+       clock_gettime(CLOCK_MONOTONIC,&ts);
+       return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+#endif
+}
+
+
+void gms_memops_bench(FILE * __restrict fp,
+                      const size_t minsz,
+                      const size_t maxsz,
+                      const int32_t nrep) {
+
+       unsigned char * __restrict a = NULL;
+       unsigned char * __restrict b = NULL;
+       size_t sz;
+       int32_t r,reps;
+       double t0,tg,tc,gib;
+       if(NULL==fp) fp = stdout;
+       if(__builtin_expect(0==minsz || maxsz<minsz || nrep<=0,0)) return;
+       // One extra page so that the moves can overlap.
+       a = (unsigned char*)_mm_malloc(maxsz+MOPS_PAGE,64);
+       b = (unsigned char*)_mm_malloc(maxsz+MOPS_PAGE,64);
+       if(__builtin_expect(NULL==a || NULL==b,0)) {
+          if(a) _mm_free(a);
+          if(b) _mm_free(b);
+          return;
+       }
+       memset(a,0x5A,maxsz+MOPS_PAGE);
+       memset(b,0xA5,maxsz+MOPS_PAGE);
+       {
+          gms_memops_cfg_t cfg;
+          gms_memops_get_config(&cfg);
+          fprintf(fp,"# LLC=%zu rep_max=%zu nt_min=%zu mt_min=%zu\n",
+                  cfg.llc,cfg.rep_max,cfg.nt_min,cfg.mt_min);
+       }
+       fprintf(fp,"# %12s %12s %12s %12s %12s %12s %12s\n","bytes",
+               "cpy_glibc","cpy_gms","set_glibc","set_gms","mov_glibc","mov_gms");
+       for(sz = minsz; sz <= maxsz; sz *= 2) {
+           double res[6];
+           // Keep the number of bytes moved per measurement roughly constant.
+           reps = (int32_t)((size_t)nrep*(maxsz/sz));
+           if(reps > 1000000) reps = 1000000;
+           if(reps < 1) reps = 1;
+           gib = (double)sz*(double)reps/1073741824.0;
+
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { memcpy(b,a,sz); __asm__ __volatile__("" ::: "memory"); }
+           tg = mops_wtime()-t0;
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { gms_memcpy(b,a,sz); __asm__ __volatile__("" ::: "memory"); }
+           tc = mops_wtime()-t0;
+           res[0] = gib/tg; res[1] = gib/tc;
+
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { memset(b,r&0xFF,sz); __asm__ __volatile__("" ::: "memory"); }
+           tg = mops_wtime()-t0;
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { gms_memset(b,r&0xFF,sz); __asm__ __volatile__("" ::: "memory"); }
+           tc = mops_wtime()-t0;
+           res[2] = gib/tg; res[3] = gib/tc;
+
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { memmove(a+64,a,sz); __asm__ __volatile__("" ::: "memory"); }
+           tg = mops_wtime()-t0;
+           t0 = mops_wtime();
+           for(r = 0; r != reps; ++r) { gms_memmove(a+64,a,sz); __asm__ __volatile__("" ::: "memory"); }
+           tc = mops_wtime()-t0;
+           res[4] = gib/tg; res[5] = gib/tc;
+
+           fprintf(fp,"  %12zu %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+                   sz,res[0],res[1],res[2],res[3],res[4],res[5]);
+           if(sz > maxsz/2) break;
+       }
+       _mm_free(a);
+       _mm_free(b);
+}
@@ -0,0 +1,130 @@
+
+
+#ifndef __GMS_SIMD_MEMOPS_ADAPTIVE_H__
+#define __GMS_SIMD_MEMOPS_ADAPTIVE_H__ 181020261500
+
+
+   const unsigned int GMS_SIMD_MEMOPS_ADAPTIVE_MAJOR = 1U;
+   const unsigned int GMS_SIMD_MEMOPS_ADAPTIVE_MINOR = 0U;
+   const unsigned int GMS_SIMD_MEMOPS_ADAPTIVE_MICRO = 0U;
+   const unsigned int GMS_SIMD_MEMOPS_ADAPTIVE_FULLVER =
+         1000U*GMS_SIMD_MEMOPS_ADAPTIVE_MAJOR+100U*GMS_SIMD_MEMOPS_ADAPTIVE_MINOR+10U*GMS_SIMD_MEMOPS_ADAPTIVE_MICRO;
+   const char * const GMS_SIMD_MEMOPS_ADAPTIVE_CREATE_DATE = "18-10-2026 3:00PM +00200 (SUN 18 OCT 2026 GMT+2)";
+   const char * const GMS_SIMD_MEMOPS_ADAPTIVE_BUILD_DATE  = __DATE__ ":" __TIME__;
+   const char * const GMS_SIMD_MEMOPS_ADAPTIVE_AUTHOR      = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+
+
+/*
+     Size-adaptive memcpy/memset/memmove.
+     Strategy by size n (bytes):
+        n <= 2*VLEN         -> two overlapping loads/stores
+        n <= rep_max        -> rep movsb / rep stosb (fast-strings microcode)
+        n <= nt_min         -> unrolled (4x) AVX512/AVX loads/stores, destination aligned
+        n <= mt_min         -> non-temporal (streaming) stores + sfence
+        n >  mt_min         -> the NT path split over OpenMP threads in page-aligned chunks
+     nt_min and mt_min are derived from the last-level cache size returned by
+     get_cacheinfo (GMS_cpuid_x86.c) on the first call (or by gms_memops_init),
+     and may be overridden by gms_memops_set_thresholds.
+     Overlapping gms_memmove is always serial and temporal.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+#if !defined(GMS_MEMOPS_REP_MAX)
+    #define GMS_MEMOPS_REP_MAX 2048
+#endif
+
+// Fallback LLC size when CPUID does not report one (e.g. some VMs).
+#if !defined(GMS_MEMOPS_DEFAULT_LLC)
+    #define GMS_MEMOPS_DEFAULT_LLC 8388608
+#endif
+
+#if !defined(GMS_MEMOPS_MT_FLOOR)
+    #define GMS_MEMOPS_MT_FLOOR 16777216
+#endif
+
+
+             typedef struct gms_memops_cfg_t {
+
+                     size_t rep_max;
+                     size_t nt_min;
+                     size_t mt_min;
+                     size_t llc;
+             } gms_memops_cfg_t;
+
+
+             void gms_memops_init(void)                      __attribute__((cold))
+                                                             __attribute__((aligned(32)));
+
+
+             void gms_memops_set_thresholds(const size_t,
+                                            const size_t,
+                                            const size_t)    __attribute__((cold))
+                                                             __attribute__((aligned(32)));
+
+
+             void gms_memops_get_config(gms_memops_cfg_t * __restrict) __attribute__((cold))
+                                                                       __attribute__((aligned(32)));
+
+
+             void * gms_memcpy(void * __restrict,
+                               const void * __restrict,
+                               const size_t)                 __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             void * gms_memset(void * __restrict,
+                               const int32_t,
+                               const size_t)                 __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             void * gms_memmove(void *,
+                                const void *,
+                                const size_t)                __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             // Element-count wrappers in the style of zmm16r4_memcpy_unroll8x.
+             void zmm16r4_memcpy_adaptive(float * __restrict,
+                                          const float * __restrict,
+                                          const int64_t)     __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             void zmm8r8_memcpy_adaptive(double * __restrict,
+                                         const double * __restrict,
+                                         const int64_t)      __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             void zmm16r4_init_adaptive(float * __restrict,
+                                        const int64_t,
+                                        const float)         __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             void zmm8r8_init_adaptive(double * __restrict,
+                                       const int64_t,
+                                       const double)         __attribute__((hot))
+                                                             __attribute__((aligned(32)));
+
+
+             /*
+                  Benchmark against glibc memcpy/memset/memmove.
+                  For every size in [minsz,maxsz] (doubling) prints a line with
+                  GiB/s of both implementations to the given stream (stdout if NULL).
+             */
+             void gms_memops_bench(FILE * __restrict,
+                                   const size_t,
+                                   const size_t,
+                                   const int32_t)            __attribute__((cold))
+                                                             __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_SIMD_MEMOPS_ADAPTIVE_H__*/
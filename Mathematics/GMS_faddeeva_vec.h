@@ -0,0 +1,99 @@
+
+
+#ifndef __GMS_FADDEEVA_VEC_H__
+#define __GMS_FADDEEVA_VEC_H__ 191020260000
+
+//
+// Array (AVX2/AVX512, OpenMP) versions of the Faddeeva package
+// (Faddeeva.h, S. G. Johnson): w(z), erfcx, erf, Dawson and the Voigt
+// profile.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 00:00 AM +00200
+//
+// The kernels run the algorithms of Faddeeva.cc at machine precision
+// (relerr = DBL_EPSILON) with lane masks in place of its branches.
+// Arguments are first sorted by region. Each block of FADV_BLOCK points
+// is classified and packed into one list per algorithm:
+//   - axes: Re z = 0 -> erfcx(Im z); Im z = 0 -> exp(-x^2), w_im(x)
+//     (Chebyshev tables transcribed from erfcx_y100 / w_im_y100);
+//   - |z| large (the Faddeeva.cc continued-fraction region): the
+//     continued fraction, each lane with its own number of terms;
+//   - |Re z| < 10 otherwise: Algorithm 916 (Zaghloul & Ali), its sums
+//     running until every lane has converged;
+//   - the rest (NaN or Inf, |z| > 1e7, 10 <= |Re z| <= 28 with
+//     |Im z| <= 1e-10): scalar Faddeeva_w.
+// Each list is evaluated without divergence between algorithms, then
+// scattered back. exp/sin/cos are the VMATH_U10 kernels of GMS_vmath.h.
+// The ISA is the one of vmath_get_isa(); the scalar ISA calls Faddeeva.c.
+// Blocks run in parallel (OpenMP) when n >= FADV_OMP_MIN.
+//
+// Agreement with the scalar code (faddeeva_vec_validate measures it):
+// each component of w, erfcx, Dawson and Voigt within FADV_TOL relative
+// to the modulus of the result, and erf within FADV_TOL of libm erf.
+// Return values: 0 success, -1 invalid argument.
+//
+
+#include <complex.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Points classified and packed per block.
+#if !defined(FADV_BLOCK)
+#define FADV_BLOCK 512
+#endif
+
+// Smallest n that runs the blocks in parallel.
+#if !defined(FADV_OMP_MIN)
+#define FADV_OMP_MIN 16384
+#endif
+
+// Documented agreement with the scalar code.
+#define FADV_TOL 1.0e-13
+
+
+// w[i] = w(z[i]) = exp(-z^2) erfc(-iz)
+int32_t faddeeva_w_vec(const double complex * __restrict,   // z
+                       double complex * __restrict,         // w
+                       const int64_t)                       // n
+                                            __attribute__((hot));
+
+// r[i] = erfcx(z[i]) = exp(z^2) erfc(z) = w(iz)
+int32_t faddeeva_erfcx_vec(const double complex * __restrict,
+                           double complex * __restrict,
+                           const int64_t)   __attribute__((hot));
+
+// Real arguments: erfcx(x), erf(x), Dawson(x) = sqrt(pi)/2 exp(-x^2) erfi(x).
+int32_t faddeeva_erfcx_re_vec(const double * __restrict,
+                              double * __restrict,
+                              const int64_t)  __attribute__((hot));
+
+int32_t faddeeva_erf_re_vec(const double * __restrict,
+                            double * __restrict,
+                            const int64_t)    __attribute__((hot));
+
+int32_t faddeeva_dawson_re_vec(const double * __restrict,
+                               double * __restrict,
+                               const int64_t) __attribute__((hot));
+
+// Voigt profile of the offsets x[i] from line centre:
+//   V(x) = Re w((x + i*gamma)/(sigma*sqrt(2))) / (sigma*sqrt(2*pi))
+// (sigma > 0 Gaussian standard deviation, gamma >= 0 Lorentzian HWHM).
+int32_t faddeeva_voigt_vec(const double * __restrict,   // x
+                           double * __restrict,         // V
+                           const int64_t,               // n
+                           const double,                // sigma
+                           const double)                // gamma
+                                            __attribute__((hot));
+
+// Compares every array function with the scalar code on npts random
+// arguments per region (seeded), prints one line per function and
+// returns the number of functions outside FADV_TOL.
+int32_t faddeeva_vec_validate(FILE * __restrict,
+                              const int64_t,      // npts
+                              const uint64_t);    // seed
+
+
+
+
+#endif /*__GMS_FADDEEVA_VEC_H__*/
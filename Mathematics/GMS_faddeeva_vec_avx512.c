@@ -0,0 +1,89 @@
+
+
+//
+// AVX512 instantiation of the Faddeeva array kernels (GMS_faddeeva_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 00:00 AM +00200
+//
+// The unit carries its own target; GMS_faddeeva_vec.c calls into it only
+// when vmath_get_isa() reports AVX512. Contraction is disabled so the
+// kernels round like the scalar Faddeeva.c.
+//
+
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_vmath.h"
+#include "GMS_faddeeva_vec_private.h"
+
+
+typedef __m512d  vd;
+typedef __mmask8 md;
+typedef __m256i  vi;
+
+#define VD_W 8
+
+#define FV_PRIM static inline __attribute__((always_inline))
+
+
+FV_PRIM vd vd_c(const double c)                  { return _mm512_set1_pd(c); }
+FV_PRIM vd vd_load(const double * __restrict p)  { return _mm512_loadu_pd(p); }
+FV_PRIM void vd_store(double * __restrict p, const vd x) { _mm512_storeu_pd(p,x); }
+FV_PRIM vd vd_add(const vd a, const vd b)        { return _mm512_add_pd(a,b); }
+FV_PRIM vd vd_sub(const vd a, const vd b)        { return _mm512_sub_pd(a,b); }
+FV_PRIM vd vd_mul(const vd a, const vd b)        { return _mm512_mul_pd(a,b); }
+FV_PRIM vd vd_div(const vd a, const vd b)        { return _mm512_div_pd(a,b); }
+FV_PRIM vd vd_abs(const vd x)                    { return _mm512_abs_pd(x); }
+FV_PRIM vd vd_neg(const vd x) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x),
+                                   _mm512_set1_epi64(INT64_MIN)));
+}
+FV_PRIM vd vd_mulsign(const vd x, const vd y) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x),
+                                   _mm512_and_si512(_mm512_castpd_si512(y),
+                                                    _mm512_set1_epi64(INT64_MIN))));
+}
+// NaN in a selects b.
+FV_PRIM vd vd_min(const vd a, const vd b)        { return _mm512_min_pd(a,b); }
+FV_PRIM vd vd_max(const vd a, const vd b)        { return _mm512_max_pd(a,b); }
+FV_PRIM vd vd_floor(const vd x) {
+        return _mm512_roundscale_pd(x,_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC);
+}
+FV_PRIM md vd_lt(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_LT_OQ); }
+FV_PRIM md vd_le(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_LE_OQ); }
+FV_PRIM md vd_gt(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_GT_OQ); }
+FV_PRIM md vd_ge(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_GE_OQ); }
+FV_PRIM md vd_eq(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_EQ_OQ); }
+FV_PRIM vd vd_sel(const md m, const vd a, const vd b) { return _mm512_mask_blend_pd(m,b,a); }
+FV_PRIM md vd_sel_m(const md m, const md a, const md b) { return (md)((m&a)|(~m&b)); }
+FV_PRIM md md_andnot(const md a, const md b)     { return (md)(~a&b); }
+FV_PRIM int32_t md_any(const md m)               { return m != 0; }
+// Table row offsets of the integer-valued k, and gathers base[offset].
+FV_PRIM vi vd_index(const vd k, const int32_t stride) {
+        return _mm256_mullo_epi32(_mm512_cvttpd_epi32(k),_mm256_set1_epi32(stride));
+}
+FV_PRIM vd vd_gather(const double * __restrict base, const vi ix) {
+        return _mm512_i32gather_pd(ix,base,8);
+}
+FV_PRIM double vd_hmax(const vd x)               { return _mm512_reduce_max_pd(x); }
+FV_PRIM vd vd_exp(const vd x)                    { return vmath_exp_zmm8r8(x,VMATH_U10); }
+FV_PRIM vd vd_sin(const vd x)                    { return vmath_sin_zmm8r8(x,VMATH_U10); }
+FV_PRIM void vd_sincos(const vd x, vd * __restrict s, vd * __restrict c) {
+        vmath_sincos_zmm8r8(x,s,c,VMATH_U10);
+}
+
+
+#include "GMS_faddeeva_vec_kernels.h"
+
+
+const fadv_isa_tab_t fadv_tab_avx512 = {
+        fv_w_cf_list,
+        fv_w_sum_list,
+        fv_w_axis_list,
+        fv_erfcx_loop,
+        fv_erf_loop,
+        fv_dawson_loop,
+        VD_W
+};
@@ -0,0 +1,326 @@
+
+
+#ifndef __GMS_FADDEEVA_VEC_KERNELS_H__
+#define __GMS_FADDEEVA_VEC_KERNELS_H__
+
+//
+// Faddeeva kernels over a per-ISA primitive layer; included by
+// GMS_faddeeva_vec_avx2.c and GMS_faddeeva_vec_avx512.c after they define
+// vd/md/vi, VD_W, the vd_* primitives and vd_exp/vd_sin/vd_sincos.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 00:00 AM +00200
+//
+// Every kernel follows Faddeeva.cc at relerr = DBL_EPSILON, term by term
+// and in the same operation order, so the results differ from the scalar
+// code only through exp/sin/cos (VMATH_U10, <= 1 ULP).
+//
+
+#include <float.h>
+#include <stdint.h>
+#include "GMS_faddeeva_vec_private.h"
+
+
+#define FV_INLINE static inline __attribute__((always_inline))
+
+#define FV_ISPI  0.56418958354775628694807945156       // 1/sqrt(pi)
+#define FV_SPI2  0.8862269254527580136490837416705725913990   // sqrt(pi)/2
+// Algorithm 916 at relerr = DBL_EPSILON.
+#define FV_A     0.518321480430085929872      // pi/sqrt(-log(eps*0.5))
+#define FV_C     0.329973702884629072537      // (2/pi)*a
+#define FV_A2    0.268657157075235951582      // a^2
+
+
+/*
+     Real-argument functions
+*/
+
+// erfcx_y100(400/(4+|x|)) (y100 in [0,100]; NaN reads row 0 and stays NaN).
+FV_INLINE vd fv_erfcx_y100(const vd y100) {
+         const vd k = vd_floor(vd_min(vd_max(y100,vd_c(0.0)),vd_c(100.0)));
+         const vi ix = vd_index(k,7);
+         const vd t = vd_sub(vd_mul(vd_c(2.0),y100),
+                             vd_add(vd_mul(vd_c(2.0),k),vd_c(1.0)));
+         const double * __restrict c = &fadv_erfcx_y100[0][0];
+         vd r = vd_gather(c+6,ix);
+         int32_t j;
+         for(j = 5; j >= 0; --j) r = vd_add(vd_gather(c+j,ix),vd_mul(r,t));
+         return (r);
+}
+
+FV_INLINE vd fv_erfcx(const vd x) {
+         const vd ax  = vd_abs(x);
+         const vd tab = fv_erfcx_y100(vd_div(vd_c(400.0),vd_add(vd_c(4.0),ax)));
+         const vd x2  = vd_mul(x,x);
+         const md big = vd_gt(x,vd_c(50.0));
+         const md neg = md_andnot(vd_ge(x,vd_c(0.0)),vd_eq(x,x));
+         vd r = tab;
+         if(md_any(big)) {
+            // x > 50: 5-term continued fraction; x > 5e7: one term.
+            const vd cf = vd_div(vd_mul(vd_c(FV_ISPI),vd_add(vd_mul(x2,vd_add(x2,vd_c(4.5))),vd_c(2.0))),
+                                 vd_mul(x,vd_add(vd_mul(x2,vd_add(x2,vd_c(5.0))),vd_c(3.75))));
+            r = vd_sel(big,vd_sel(vd_gt(x,vd_c(5.0e7)),vd_div(vd_c(FV_ISPI),x),cf),r);
+         }
+         if(md_any(neg)) {
+            // erfcx(x) = 2 exp(x^2) - erfcx(-x)
+            const vd e2 = vd_mul(vd_c(2.0),vd_exp(x2));
+            vd rn = vd_sel(vd_lt(x,vd_c(-6.1)),e2,vd_sub(e2,tab));
+            rn = vd_sel(vd_lt(x,vd_c(-26.7)),vd_c(__builtin_inf()),rn);
+            r  = vd_sel(neg,rn,r);
+         }
+         return (vd_sel(vd_eq(x,x),r,x));
+}
+
+// w_im(x) = Im w(x) for real x (= 2 Dawson(x)/sqrt(pi)), odd in x.
+FV_INLINE vd fv_w_im(const vd x) {
+         const vd ax   = vd_abs(x);
+         const vd y100 = vd_div(vd_c(100.0),vd_add(vd_c(1.0),ax));
+         const vd k    = vd_floor(vd_min(vd_max(y100,vd_c(0.0)),vd_c(100.0)));
+         const vi ix   = vd_index(vd_min(k,vd_c(96.0)),9);
+         const vd t    = vd_sub(vd_mul(vd_c(2.0),y100),
+                                vd_add(vd_mul(vd_c(2.0),k),vd_c(1.0)));
+         const double * __restrict c = &fadv_w_im_y100[0][0];
+         const vd x2   = vd_mul(ax,ax);
+         const md big  = vd_gt(ax,vd_c(45.0));
+         vd r = vd_gather(c+8,ix);
+         vd ty,cf;
+         int32_t j;
+         for(j = 7; j >= 0; --j) r = vd_add(vd_gather(c+j,ix),vd_mul(r,t));
+         // |x| <= 0.0309 (rows 97..100): Taylor expansion.
+         ty = vd_mul(ax,vd_sub(vd_c(1.1283791670955125739),
+                  vd_mul(x2,vd_sub(vd_c(0.75225277806367504925),
+                  vd_mul(x2,vd_sub(vd_c(0.30090111122547001970),
+                  vd_mul(x2,vd_sub(vd_c(0.085971746064420005629),
+                  vd_mul(x2,vd_c(0.016931216931216931217))))))))));
+         r  = vd_sel(vd_ge(k,vd_c(97.0)),ty,r);
+         if(md_any(big)) {
+            cf = vd_div(vd_mul(vd_c(FV_ISPI),vd_add(vd_mul(x2,vd_sub(x2,vd_c(4.5))),vd_c(2.0))),
+                        vd_mul(ax,vd_add(vd_mul(x2,vd_sub(x2,vd_c(5.0))),vd_c(3.75))));
+            r  = vd_sel(big,vd_sel(vd_gt(ax,vd_c(5.0e7)),vd_div(vd_c(FV_ISPI),ax),cf),r);
+         }
+         return (vd_mulsign(r,x));
+}
+
+FV_INLINE vd fv_dawson(const vd x) {
+         return (vd_mul(vd_c(FV_SPI2),fv_w_im(x)));
+}
+
+// erf(x): Taylor series for |x| < 0.5, 1 - exp(-x^2) erfcx(|x|) above.
+FV_INLINE vd fv_erf(const vd x) {
+         const vd ax   = vd_abs(x);
+         const md tayl = vd_lt(ax,vd_c(0.5));
+         vd r = x;
+         if(md_any(tayl)) {
+            const vd mx2 = vd_neg(vd_mul(x,x));
+            vd ts = vd_c(9.42275906465041125293e-11);
+            ts = vd_add(vd_c(1.22905553017179283506e-09),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.48071928158792175650e-08),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.63658446912349244681e-07),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.64621143658892484563e-06),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.49256503584062503526e-05),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.20553329817896636030e-04),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(8.54832702345085333404e-04),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(5.22397762544218793174e-03),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(2.68661706451312522204e-02),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.12837916709551261407e-01),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(3.76126389031837538024e-01),vd_mul(mx2,ts));
+            ts = vd_add(vd_c(1.12837916709551255856e+00),vd_mul(mx2,ts));
+            r  = vd_sel(tayl,vd_mul(x,ts),r);
+         }
+         if(md_any(md_andnot(tayl,vd_eq(x,x)))) {
+            const vd e = vd_sub(vd_c(1.0),vd_mul(vd_exp(vd_neg(vd_mul(x,x))),fv_erfcx(ax)));
+            r = vd_sel(tayl,r,vd_mulsign(e,x));
+         }
+         return (r);
+}
+
+
+/*
+     w(z) regions
+*/
+
+// sin(x)/x given sin(x).
+FV_INLINE vd fv_sinc(const vd x, const vd sinx) {
+         return (vd_sel(vd_lt(vd_abs(x),vd_c(1.0e-4)),
+                        vd_sub(vd_c(1.0),vd_mul(vd_mul(vd_c(0.1666666666666666666667),x),x)),
+                        vd_div(sinx,x)));
+}
+
+// Continued fraction (|Im z| > 7, or |Re z| > 6 with the Faddeeva.cc
+// conditions on Im z; |Re z| + |Im z| <= 1e7). Each lane runs its own
+// number of terms nu; lanes with fewer terms join the recurrence late.
+FV_INLINE void fv_w_cf(const vd zr, const vd zi, vd * __restrict pwr, vd * __restrict pwi) {
+         const vd x   = vd_abs(zr);
+         const vd ya  = vd_abs(zi);
+         const md lhp = vd_lt(zi,vd_c(0.0));
+         const vd xs  = vd_sel(lhp,vd_neg(zr),zr);   // w(-z) for Im z < 0
+         const md nu2 = vd_gt(vd_add(x,ya),vd_c(4000.0));
+         vd wr,wi,den,nu,m0,r,i;
+         double v;
+         // nu == 2: w(z) = i/sqrt(pi) z/(z^2 - 0.5)
+         {
+            const vd dr = vd_sub(vd_sub(vd_mul(xs,xs),vd_mul(ya,ya)),vd_c(0.5));
+            const vd di = vd_mul(vd_mul(vd_c(2.0),xs),ya);
+            den = vd_div(vd_c(FV_ISPI),vd_add(vd_mul(dr,dr),vd_mul(di,di)));
+            r   = vd_mul(den,vd_sub(vd_mul(xs,di),vd_mul(ya,dr)));
+            i   = vd_mul(den,vd_add(vd_mul(xs,dr),vd_mul(ya,di)));
+         }
+         nu = vd_floor(vd_add(vd_c(3.9),vd_div(vd_c(11.398),
+                       vd_add(vd_add(vd_mul(vd_c(0.08254),x),vd_mul(vd_c(0.1421),ya)),
+                              vd_c(0.2023)))));
+         m0 = vd_sel(nu2,vd_c(0.0),vd_mul(vd_c(0.5),vd_sub(nu,vd_c(1.0))));
+         wr = xs;
+         wi = ya;
+         for(v = vd_hmax(m0); v > 0.4; v -= 0.5) {
+             const md act = vd_le(vd_c(v),m0);
+             // w <- z - nu/w
+             den = vd_div(vd_c(v),vd_add(vd_mul(wr,wr),vd_mul(wi,wi)));
+             wr  = vd_sel(act,vd_sub(xs,vd_mul(wr,den)),wr);
+             wi  = vd_sel(act,vd_add(ya,vd_mul(wi,den)),wi);
+         }
+         den = vd_div(vd_c(FV_ISPI),vd_add(vd_mul(wr,wr),vd_mul(wi,wi)));
+         r   = vd_sel(nu2,r,vd_mul(den,wi));
+         i   = vd_sel(nu2,i,vd_mul(den,wr));
+         if(md_any(lhp)) {
+            // w(z) = 2 exp(-z^2) - w(-z)
+            const vd er = vd_mul(vd_sub(ya,xs),vd_add(xs,ya));
+            const vd ei = vd_mul(vd_mul(vd_c(2.0),xs),zi);
+            const vd e  = vd_exp(er);
+            vd s,c;
+            vd_sincos(ei,&s,&c);
+            r = vd_sel(lhp,vd_sub(vd_mul(vd_c(2.0),vd_mul(e,c)),r),r);
+            i = vd_sel(lhp,vd_sub(vd_mul(vd_c(2.0),vd_mul(e,s)),i),i);
+         }
+         *pwr = r;
+         *pwi = i;
+}
+
+// Algorithm 916 (|Re z| < 10, Re z != 0, Im z != 0, outside the
+// continued-fraction region). The sums run until every lane meets the
+// Faddeeva.cc stopping test; converged lanes keep their sums.
+FV_INLINE void fv_w_sum(const vd zr, const vd zi, vd * __restrict pwr, vd * __restrict pwi) {
+         const vd x     = vd_abs(zr);
+         const vd y     = zi;
+         const vd y2    = vd_mul(y,y);
+         const md small = vd_lt(x,vd_c(5.0e-4));
+         const vd eps   = vd_c(DBL_EPSILON);
+         vd sum1 = vd_c(0.0), sum2 = vd_c(0.0), sum3 = vd_c(0.0);
+         vd sum4 = vd_c(0.0), sum5 = vd_c(0.0);
+         vd prod2ax = vd_c(1.0), prodm2ax = vd_c(1.0);
+         vd expx2,exp2ax,expm2ax,expx2erfcxy,coef1,coef2;
+         vd sinxy,sin2xy,cos2xy,xy,r,i;
+         md act = vd_eq(x,x);
+         int32_t n;
+         {
+            // x < 5e-4: exp(-x^2), exp(+-2ax) via Taylor.
+            const vd x2  = vd_mul(x,x);
+            const vd ax2 = vd_mul(vd_c(1.036642960860171859744),x);
+            const vd e2b = vd_exp(vd_mul(vd_c(2.0*FV_A),x));
+            expx2   = vd_sel(small,vd_sub(vd_c(1.0),vd_mul(x2,vd_sub(vd_c(1.0),vd_mul(vd_c(0.5),x2)))),
+                             vd_exp(vd_neg(vd_mul(x,x))));
+            exp2ax  = vd_sel(small,vd_add(vd_c(1.0),vd_mul(ax2,vd_add(vd_c(1.0),
+                             vd_mul(ax2,vd_add(vd_c(0.5),vd_mul(vd_c(0.166666666666666666667),ax2)))))),e2b);
+            expm2ax = vd_sel(small,vd_sub(vd_c(1.0),vd_mul(ax2,vd_sub(vd_c(1.0),
+                             vd_mul(ax2,vd_sub(vd_c(0.5),vd_mul(vd_c(0.166666666666666666667),ax2)))))),
+                             vd_div(vd_c(1.0),e2b));
+         }
+         for(n = 1; n <= 52 && md_any(act); ++n) {
+             const double dn = (double)n;
+             const vd coef = vd_div(vd_mul(vd_c(fadv_expa2n2[n-1]),expx2),
+                                    vd_add(vd_c(FV_A2*(double)(n*n)),y2));
+             const vd p2 = vd_mul(prod2ax,exp2ax);
+             const vd m2 = vd_mul(prodm2ax,expm2ax);
+             const vd t3 = vd_mul(coef,p2);
+             const vd t4 = vd_mul(vd_mul(coef,m2),vd_c(FV_A*dn));
+             const vd t5 = vd_mul(t3,vd_c(FV_A*dn));
+             // x < 5e-4: sum5 accumulates sum5 - sum4 directly.
+             const vd s  = vd_mul(vd_c(2.0*FV_A*dn),x);
+             const vd t5s = vd_mul(vd_mul(vd_mul(coef,vd_c(2.0*FV_A)),vd_c(dn)),
+                                   vd_mul(s,vd_add(vd_c(1.0),vd_mul(vd_mul(s,s),
+                                   vd_add(vd_c(0.1666666666666666666667),
+                                          vd_mul(vd_c(0.00833333333333333333333),vd_mul(s,s)))))));
+             md done;
+             prod2ax  = vd_sel(act,p2,prod2ax);
+             prodm2ax = vd_sel(act,m2,prodm2ax);
+             sum1 = vd_sel(act,vd_add(sum1,coef),sum1);
+             sum2 = vd_sel(act,vd_add(sum2,vd_mul(coef,m2)),sum2);
+             sum3 = vd_sel(act,vd_add(sum3,t3),sum3);
+             sum4 = vd_sel(md_andnot(small,act),vd_add(sum4,t4),sum4);
+             sum5 = vd_sel(act,vd_add(sum5,vd_sel(small,t5s,t5)),sum5);
+             done = vd_sel_m(small,vd_lt(t3,vd_mul(eps,sum3)),vd_lt(t5,vd_mul(eps,sum5)));
+             act  = md_andnot(done,act);
+         }
+         // y > -6: exp(-x^2) erfcx(y); below, erfcx(y) = 2 exp(y^2).
+         expx2erfcxy = vd_mul(expx2,fv_erfcx(y));
+         {
+            const md ylo = vd_le(y,vd_c(-6.0));
+            if(md_any(ylo))
+               expx2erfcxy = vd_sel(ylo,vd_mul(vd_c(2.0),vd_exp(vd_sub(y2,vd_mul(x,x)))),
+                                    expx2erfcxy);
+         }
+         xy    = vd_mul(zr,y);
+         sinxy = vd_sin(xy);
+         vd_sincos(vd_mul(vd_mul(vd_c(2.0),zr),y),&sin2xy,&cos2xy);
+         coef1 = vd_sub(expx2erfcxy,vd_mul(vd_mul(vd_c(FV_C),y),sum1));
+         coef2 = vd_mul(vd_mul(vd_c(FV_C),zr),expx2);
+         r = vd_add(vd_mul(coef1,cos2xy),vd_mul(vd_mul(coef2,sinxy),fv_sinc(xy,sinxy)));
+         i = vd_sub(vd_mul(coef2,fv_sinc(vd_mul(vd_mul(vd_c(2.0),zr),y),sin2xy)),
+                    vd_mul(coef1,sin2xy));
+         // y > 5: the imaginary terms cancel.
+         i = vd_sel(vd_gt(y,vd_c(5.0)),vd_c(0.0),i);
+         *pwr = vd_add(r,vd_mul(vd_mul(vd_c(0.5*FV_C),y),vd_add(sum2,sum3)));
+         *pwi = vd_add(i,vd_mul(vd_c(0.5*FV_C),vd_mulsign(vd_abs(vd_sub(sum5,sum4)),zr)));
+}
+
+// Im z = 0: w(x) = exp(-x^2) + i w_im(x).
+FV_INLINE void fv_w_axis(const vd zr, vd * __restrict pwr, vd * __restrict pwi) {
+         *pwr = vd_exp(vd_neg(vd_mul(zr,zr)));
+         *pwi = fv_w_im(zr);
+}
+
+
+/*
+     Array loops
+*/
+#define FV_DEF_LIST(name,KERN)                                              \
+static void name(const double * __restrict zr,                              \
+                 const double * __restrict zi,                              \
+                 double * __restrict wr,                                    \
+                 double * __restrict wi,                                    \
+                 const int64_t m) {                                         \
+         int64_t k;                                                         \
+         for(k = 0; k < m; k += VD_W) {                                     \
+             vd r,i;                                                        \
+             KERN(vd_load(&zr[k]),vd_load(&zi[k]),&r,&i);                   \
+             vd_store(&wr[k],r);                                            \
+             vd_store(&wi[k],i);                                            \
+         }                                                                  \
+}
+
+#define FV_AXIS(zr,zi,r,i) do { (void)(zi); fv_w_axis(zr,r,i); } while(0)
+
+#define FV_DEF_UN(name,KERN,pad)                                            \
+static void name(const double * __restrict x,                               \
+                 double * __restrict y,                                     \
+                 const int64_t n) {                                         \
+         double buf[VD_W] __attribute__((aligned(64)));                     \
+         int64_t i,j;                                                       \
+         for(i = 0; i+VD_W <= n; i += VD_W)                                 \
+             vd_store(&y[i],KERN(vd_load(&x[i])));                          \
+         if(i < n) {                                                        \
+            for(j = 0; j != VD_W; ++j) buf[j] = (i+j < n) ? x[i+j] : (pad); \
+            vd_store(buf,KERN(vd_load(buf)));                               \
+            for(j = 0; i+j < n; ++j) y[i+j] = buf[j];                       \
+         }                                                                  \
+}
+
+FV_DEF_LIST(fv_w_cf_list,fv_w_cf)
+FV_DEF_LIST(fv_w_sum_list,fv_w_sum)
+FV_DEF_LIST(fv_w_axis_list,FV_AXIS)
+FV_DEF_UN(fv_erfcx_loop,fv_erfcx,1.0)
+FV_DEF_UN(fv_erf_loop,fv_erf,1.0)
+FV_DEF_UN(fv_dawson_loop,fv_dawson,1.0)
+
+
+
+
+#endif /*__GMS_FADDEEVA_VEC_KERNELS_H__*/
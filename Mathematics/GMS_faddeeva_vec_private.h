@@ -0,0 +1,51 @@
+
+
+#ifndef __GMS_FADDEEVA_VEC_PRIVATE_H__
+#define __GMS_FADDEEVA_VEC_PRIVATE_H__
+
+//
+// Internal kernel tables of the Faddeeva array functions (GMS_faddeeva_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 00:00 AM +00200
+//
+
+#include <stdint.h>
+#include "GMS_faddeeva_vec.h"
+
+
+// Chebyshev tables of Faddeeva.cc (GMS_faddeeva_vec.c).
+extern const double fadv_erfcx_y100[101][7];
+extern const double fadv_w_im_y100[97][9];
+// exp(-a^2 n^2), n = 1..52, of Algorithm 916 (a^2 = 0.26865...).
+extern const double fadv_expa2n2[52];
+
+// Region lists: (zr[k],zi[k]) -> (wr[k],wi[k]), m a multiple of the
+// vector width.
+typedef void (*fadv_list_fn)(const double * __restrict,
+                             const double * __restrict,
+                             double * __restrict,
+                             double * __restrict,
+                             const int64_t);
+
+// Real arrays, any n.
+typedef void (*fadv_un_fn)(const double * __restrict,
+                           double * __restrict,
+                           const int64_t);
+
+typedef struct {
+        fadv_list_fn w_cf;      // continued fraction
+        fadv_list_fn w_sum;     // Algorithm 916
+        fadv_list_fn w_axis;    // Im z = 0: exp(-x^2), w_im(x)
+        fadv_un_fn   erfcx;
+        fadv_un_fn   erf;
+        fadv_un_fn   dawson;
+        int32_t      width;     // doubles per vector
+} fadv_isa_tab_t;
+
+extern const fadv_isa_tab_t fadv_tab_avx2;
+extern const fadv_isa_tab_t fadv_tab_avx512;
+
+
+
+
+#endif /*__GMS_FADDEEVA_VEC_PRIVATE_H__*/
@@ -0,0 +1,160 @@
+module jacobian_minpack_iface
+
+
+!===========================================================!
+! MINPACK callbacks on the threaded finite-difference       !
+! Jacobian jacobian_fd_r8_omp (LibSIMD/GMS_jacobian_avx512) !
+! The C driver calls fun(n,x,m,f,user) with n and m by      !
+! value; fcn_lmder/fcn_hybrj (GMS_minpack.f90) take         !
+! (m,n,x,fvec,fjac,ldfjac,iflag) by reference. The bind(c)  !
+! adapters below carry the Fortran procedure in user and    !
+! call it with iflag = 1 (function values only).            !
+! fjac(ldfjac,n) receives df/dx as fdjac2 would return it.  !
+! The columns are evaluated on all OpenMP threads, so fcn   !
+! must not keep state between calls (set OMP_NUM_THREADS=1  !
+! otherwise). iflag returns 0, or the negative value fcn    !
+! set to stop; stat is the return value of the C driver     !
+! (0, -1 invalid argument, -2 allocation failure).          !
+!===========================================================!
+
+
+use, intrinsic :: ISO_C_BINDING
+use mod_kinds, only : i4, dp
+use minpack,   only : fcn_lmder, fcn_hybrj
+implicit none
+private
+public :: jacobian_fd_lmder, jacobian_fd_hybrj
+
+
+integer(c_int32_t), parameter, public :: GMS_JAC_FORWARD = 0_c_int32_t
+integer(c_int32_t), parameter, public :: GMS_JAC_CENTRAL = 1_c_int32_t
+integer(c_int32_t), parameter, public :: GMS_JAC_5P      = 2_c_int32_t
+
+
+type :: jac_minpack_ctx
+     procedure(fcn_lmder), pointer, nopass :: lmder => null()
+     procedure(fcn_hybrj), pointer, nopass :: hybrj => null()
+     integer(i4) :: iflag = 0_i4
+end type jac_minpack_ctx
+
+
+#if 0
+int32_t jacobian_fd_r8_omp(jac_sfun_r8 fun,
+                           const int32_t n,
+                           const int32_t m,
+                           const double * __restrict x,
+                           const double * __restrict f0,
+                           double * __restrict J,
+                           const int32_t ldj,
+                           const int32_t scheme,
+                           void * __restrict user);
+#endif
+
+interface
+
+   function jacobian_fd_r8_omp(fun,n,m,x,f0,J,ldj,scheme,user) &
+                               result(stat)                    &
+                               bind(c,name='jacobian_fd_r8_omp')
+            use, intrinsic :: ISO_C_BINDING
+            type(c_funptr),                       intent(in), value :: fun
+            integer(c_int32_t),                   intent(in), value :: n
+            integer(c_int32_t),                   intent(in), value :: m
+            integer(c_int32_t),                   intent(in), value :: ldj
+            integer(c_int32_t),                   intent(in), value :: scheme
+            real(c_double),  dimension(*),        intent(in)        :: x
+            type(c_ptr),                          intent(in), value :: f0
+            real(c_double),  dimension(ldj,*),    intent(inout)     :: J
+            type(c_ptr),                          intent(in), value :: user
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+contains
+
+
+   ! fjac(ldfjac,n) = df/dx of fcn at x; fvec = f(x) is used by the
+   ! forward scheme.
+   function jacobian_fd_lmder(fcn,m,n,x,fvec,fjac,ldfjac,scheme,iflag) &
+                              result(stat)
+            procedure(fcn_lmder)                                 :: fcn
+            integer(i4),                          intent(in)     :: m
+            integer(i4),                          intent(in)     :: n
+            integer(i4),                          intent(in)     :: ldfjac
+            real(dp),    dimension(n),            intent(in)     :: x
+            real(dp),    dimension(m),            intent(in), target :: fvec
+            real(dp),    dimension(ldfjac,n),     intent(inout)  :: fjac
+            integer(i4),                          intent(in)     :: scheme
+            integer(i4),                          intent(out)    :: iflag
+            integer(i4) :: stat
+            type(jac_minpack_ctx), target :: ctx
+            ctx%lmder => fcn
+            ctx%iflag =  0_i4
+            stat = jacobian_fd_r8_omp(c_funloc(jac_lmder_fun),n,m,x,c_loc(fvec), &
+                                      fjac,ldfjac,scheme,c_loc(ctx))
+            iflag = ctx%iflag
+   end function jacobian_fd_lmder
+
+
+   ! Square system of hybrj: fjac(ldfjac,n) = df/dx, fvec = f(x).
+   function jacobian_fd_hybrj(fcn,n,x,fvec,fjac,ldfjac,scheme,iflag) &
+                              result(stat)
+            procedure(fcn_hybrj)                                 :: fcn
+            integer(i4),                          intent(in)     :: n
+            integer(i4),                          intent(in)     :: ldfjac
+            real(dp),    dimension(n),            intent(in)     :: x
+            real(dp),    dimension(n),            intent(in), target :: fvec
+            real(dp),    dimension(ldfjac,n),     intent(inout)  :: fjac
+            integer(i4),                          intent(in)     :: scheme
+            integer(i4),                          intent(out)    :: iflag
+            integer(i4) :: stat
+            type(jac_minpack_ctx), target :: ctx
+            ctx%hybrj => fcn
+            ctx%iflag =  0_i4
+            stat = jacobian_fd_r8_omp(c_funloc(jac_hybrj_fun),n,n,x,c_loc(fvec), &
+                                      fjac,ldfjac,scheme,c_loc(ctx))
+            iflag = ctx%iflag
+   end function jacobian_fd_hybrj
+
+
+   ! jac_sfun_r8 adapters (called from the OpenMP threads of the driver).
+   subroutine jac_lmder_fun(n,x,m,f,user) bind(c)
+            integer(c_int32_t),                   intent(in), value :: n
+            integer(c_int32_t),                   intent(in), value :: m
+            real(c_double),  dimension(n),        intent(in)        :: x
+            real(c_double),  dimension(m),        intent(inout)     :: f
+            type(c_ptr),                          intent(in), value :: user
+            type(jac_minpack_ctx), pointer :: ctx
+            real(dp),    dimension(1,n) :: fjd   ! not referenced with iflag = 1
+            integer(i4) :: iflag
+            call c_f_pointer(user,ctx)
+            iflag = 1_i4
+            call ctx%lmder(m,n,x,f,fjd,1_i4,iflag)
+            if(iflag < 0_i4) then
+!$omp atomic write
+               ctx%iflag = iflag
+            end if
+   end subroutine jac_lmder_fun
+
+
+   subroutine jac_hybrj_fun(n,x,m,f,user) bind(c)
+            integer(c_int32_t),                   intent(in), value :: n
+            integer(c_int32_t),                   intent(in), value :: m
+            real(c_double),  dimension(n),        intent(in)        :: x
+            real(c_double),  dimension(m),        intent(inout)     :: f
+            type(c_ptr),                          intent(in), value :: user
+            type(jac_minpack_ctx), pointer :: ctx
+            real(dp),    dimension(1,n) :: fjd   ! not referenced with iflag = 1
+            integer(i4) :: iflag
+            call c_f_pointer(user,ctx)
+            iflag = 1_i4
+            call ctx%hybrj(n,x,f,fjd,1_i4,iflag)
+            if(iflag < 0_i4) then
+!$omp atomic write
+               ctx%iflag = iflag
+            end if
+   end subroutine jac_hybrj_fun
+
+
+end module jacobian_minpack_iface
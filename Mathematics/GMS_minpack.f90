@@ -24,7 +24,7 @@ module minpack
     abstract interface
         subroutine func(n, x, fvec, iflag)
             !! user-supplied subroutine for [[hybrd]], [[hybrd1]], and [[fdjac1]]
-            import :: dp
+            import :: dp, i4
             implicit none
             integer(i4), intent(in) :: n !! the number of variables.
             real(dp), intent(in) :: x(n) !! independent variable vector
@@ -34,7 +34,7 @@ module minpack
 
         subroutine func2(m, n, x, fvec, iflag)
             !! user-supplied subroutine for [[fdjac2]], [[lmdif]], and [[lmdif1]]
-            import :: dp
+            import :: dp, i4
             implicit none
             integer(i4), intent(in) :: m !! the number of functions.
             integer(i4), intent(in) :: n !! the number of variables.
@@ -47,7 +47,7 @@ module minpack
 
         subroutine fcn_hybrj(n, x, fvec, fjac, ldfjac, iflag)
             !! user-supplied subroutine for [[hybrj]] and [[hybrj1]]
-            import :: dp
+            import :: dp, i4
             implicit none
             integer(i4), intent(in) :: n !! the number of variables.
             real(dp), dimension(n), intent(in) :: x !! independent variable vector
@@ -66,7 +66,7 @@ module minpack
 
         subroutine fcn_lmder(m, n, x, fvec, fjac, ldfjac, iflag)
             !! user-supplied subroutine for [[lmder]] and [[lmder1]]
-            import :: dp
+            import :: dp, i4
             implicit none
             integer(i4), intent(in) :: m !! the number of functions.
             integer(i4), intent(in) :: n !! the number of variables.
@@ -85,7 +85,7 @@ module minpack
         end subroutine fcn_lmder
 
         subroutine fcn_lmstr(m, n, x, fvec, fjrow, iflag)
-            import :: dp
+            import :: dp, i4
             implicit none
             integer(i4), intent(in) :: m !! the number of functions.
             integer(i4), intent(in) :: n !! the number of variables.
@@ -0,0 +1,656 @@
+
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "GMS_mixed_prec_solver.h"
+#include "GMS_sgemm_kernel_32x12_skx.h"
+#include "GMS_dgemm_driver_skx.h"
+#include "blas_extended.h"
+
+
+#define MPS_IDX(i,j,ld) ((size_t)(j)*(size_t)(ld)+(size_t)(i))
+#define MPS_MAX(a,b)    (((a) > (b)) ? (a) : (b))
+
+
+/*
+     The factorizations and triangular solves are written once and
+     instantiated for fp32 (sgemm_skx_omp) and fp64 (dgemm_skx_omp).
+*/
+
+/*
+     Blocked right-looking LU with partial pivoting. The panel is factored
+     column by column (rank-1 updates vectorized over the contiguous rows),
+     U12 by a unit-lower forward substitution and the trailing matrix by
+     one GEMM per panel. Pivot rows are swapped across the full width.
+     Returns 0, k > 0 (exact zero pivot in column k) or -2 (GEMM buffers).
+*/
+#define MPS_DEF_GETRF(NAME,T,GEMM)                                             \
+static int32_t NAME(const int32_t n,                                           \
+                    T * __restrict a,                                          \
+                    const int32_t lda,                                         \
+                    int32_t * __restrict ipiv) {                               \
+         int32_t info = 0;                                                     \
+         int32_t j,jb,k,i,c,p;                                                 \
+         for(j = 0; j < n; j += MPS_NB) {                                      \
+             jb = (n-j < MPS_NB) ? n-j : MPS_NB;                               \
+             for(k = j; k < j+jb; ++k) {                                       \
+                 T * __restrict ak = &a[MPS_IDX(0,k,lda)];                     \
+                 T amax = (T)0;                                                \
+                 p = k;                                                        \
+                 for(i = k; i < n; ++i) {                                      \
+                     const T v = (ak[i] < (T)0) ? -ak[i] : ak[i];              \
+                     if(v > amax) { amax = v; p = i; }                         \
+                 }                                                             \
+                 ipiv[k] = p;                                                  \
+                 if(amax == (T)0) {                                            \
+                    if(info == 0) info = k+1;                                  \
+                    continue;                                                  \
+                 }                                                             \
+                 if(p != k) {                                                  \
+                    for(c = 0; c < n; ++c) {                                   \
+                        const T t = a[MPS_IDX(k,c,lda)];                       \
+                        a[MPS_IDX(k,c,lda)] = a[MPS_IDX(p,c,lda)];             \
+                        a[MPS_IDX(p,c,lda)] = t;                               \
+                    }                                                          \
+                 }                                                             \
+                 {                                                             \
+                    const T r = (T)1/ak[k];                                    \
+                    _Pragma("omp simd")                                        \
+                    for(i = k+1; i < n; ++i) ak[i] *= r;                       \
+                 }                                                             \
+                 for(c = k+1; c < j+jb; ++c) {                                 \
+                     T * __restrict ac = &a[MPS_IDX(0,c,lda)];                 \
+                     const T u = ac[k];                                        \
+                     if(u == (T)0) continue;                                   \
+                     _Pragma("omp simd")                                       \
+                     for(i = k+1; i < n; ++i) ac[i] -= ak[i]*u;                \
+                 }                                                             \
+             }                                                                 \
+             if(j+jb < n) {                                                    \
+                for(c = j+jb; c < n; ++c) {                                    \
+                    T * __restrict ac = &a[MPS_IDX(0,c,lda)];                  \
+                    for(k = j; k < j+jb; ++k) {                                \
+                        const T * __restrict lk = &a[MPS_IDX(0,k,lda)];        \
+                        const T u = ac[k];                                     \
+                        if(u == (T)0) continue;                                \
+                        _Pragma("omp simd")                                    \
+                        for(i = k+1; i < j+jb; ++i) ac[i] -= lk[i]*u;          \
+                    }                                                          \
+                }                                                              \
+                if(GEMM('N','N',n-j-jb,n-j-jb,jb,(T)-1,                        \
+                        &a[MPS_IDX(j+jb,j,lda)],lda,                           \
+                        &a[MPS_IDX(j,j+jb,lda)],lda,(T)1,                      \
+                        &a[MPS_IDX(j+jb,j+jb,lda)],lda) != 0) return (-2);     \
+             }                                                                 \
+         }                                                                     \
+         return (info);                                                        \
+}
+
+
+/*
+     Blocked left-looking Cholesky A = L*L^T (lower triangle, the strict
+     upper part of the diagonal blocks is overwritten by the GEMM update).
+     Returns 0, k > 0 (non-positive diagonal in column k) or -2.
+*/
+#define MPS_DEF_POTRF(NAME,T,GEMM)                                             \
+static int32_t NAME(const int32_t n,                                           \
+                    T * __restrict a,                                          \
+                    const int32_t lda) {                                       \
+         int32_t j,jb,k,i,c;                                                   \
+         for(j = 0; j < n; j += MPS_NB) {                                      \
+             jb = (n-j < MPS_NB) ? n-j : MPS_NB;                               \
+             if(j > 0) {                                                       \
+                if(GEMM('N','T',jb,jb,j,(T)-1,                                 \
+                        &a[MPS_IDX(j,0,lda)],lda,&a[MPS_IDX(j,0,lda)],lda,     \
+                        (T)1,&a[MPS_IDX(j,j,lda)],lda) != 0) return (-2);      \
+             }                                                                 \
+             for(k = j; k < j+jb; ++k) {                                       \
+                 T * __restrict ak = &a[MPS_IDX(0,k,lda)];                     \
+                 T d = ak[k];                                                  \
+                 if(!(d > (T)0)) return (k+1);                                 \
+                 d = (T)sqrt((double)d);                                       \
+                 ak[k] = d;                                                    \
+                 {                                                             \
+                    const T r = (T)1/d;                                        \
+                    _Pragma("omp simd")                                        \
+                    for(i = k+1; i < j+jb; ++i) ak[i] *= r;                    \
+                 }                                                             \
+                 for(c = k+1; c < j+jb; ++c) {                                 \
+                     T * __restrict ac = &a[MPS_IDX(0,c,lda)];                 \
+                     const T u = ak[c];                                        \
+                     _Pragma("omp simd")                                       \
+                     for(i = c; i < j+jb; ++i) ac[i] -= ak[i]*u;               \
+                 }                                                             \
+             }                                                                 \
+             if(j+jb < n) {                                                    \
+                const int32_t m2 = n-j-jb;                                     \
+                if(j > 0) {                                                    \
+                   if(GEMM('N','T',m2,jb,j,(T)-1,                              \
+                           &a[MPS_IDX(j+jb,0,lda)],lda,                        \
+                           &a[MPS_IDX(j,0,lda)],lda,(T)1,                      \
+                           &a[MPS_IDX(j+jb,j,lda)],lda) != 0) return (-2);     \
+                }                                                              \
+                for(k = j; k < j+jb; ++k) {                                    \
+                    T * __restrict ak = &a[MPS_IDX(0,k,lda)];                  \
+                    const T r = (T)1/ak[k];                                    \
+                    _Pragma("omp simd")                                        \
+                    for(i = j+jb; i < n; ++i) ak[i] *= r;                      \
+                    for(c = k+1; c < j+jb; ++c) {                              \
+                        T * __restrict ac = &a[MPS_IDX(0,c,lda)];              \
+                        const T u = ak[c];                                     \
+                        _Pragma("omp simd")                                    \
+                        for(i = j+jb; i < n; ++i) ac[i] -= ak[i]*u;            \
+                    }                                                          \
+                }                                                              \
+             }                                                                 \
+         }                                                                     \
+         return (0);                                                           \
+}
+
+
+// b := (P*L*U)^-1 * b
+#define MPS_DEF_GETRS(NAME,T)                                                  \
+static void NAME(const int32_t n,                                              \
+                 const T * __restrict a,                                       \
+                 const int32_t lda,                                            \
+                 const int32_t * __restrict ipiv,                              \
+                 T * __restrict b) {                                           \
+         int32_t k,i;                                                          \
+         for(k = 0; k < n; ++k) {                                              \
+             const int32_t p = ipiv[k];                                        \
+             if(p != k) { const T t = b[k]; b[k] = b[p]; b[p] = t; }           \
+         }                                                                     \
+         for(k = 0; k < n; ++k) {                                              \
+             const T * __restrict lk = &a[MPS_IDX(0,k,lda)];                   \
+             const T bk = b[k];                                                \
+             if(bk == (T)0) continue;                                          \
+             _Pragma("omp simd")                                               \
+             for(i = k+1; i < n; ++i) b[i] -= lk[i]*bk;                        \
+         }                                                                     \
+         for(k = n-1; k >= 0; --k) {                                           \
+             const T * __restrict uk = &a[MPS_IDX(0,k,lda)];                   \
+             const T bk = (b[k] /= uk[k]);                                     \
+             if(bk == (T)0) continue;                                          \
+             _Pragma("omp simd")                                               \
+             for(i = 0; i < k; ++i) b[i] -= uk[i]*bk;                          \
+         }                                                                     \
+}
+
+
+// b := (L*L^T)^-1 * b
+#define MPS_DEF_POTRS(NAME,T)                                                  \
+static void NAME(const int32_t n,                                              \
+                 const T * __restrict a,                                       \
+                 const int32_t lda,                                            \
+                 T * __restrict b) {                                           \
+         int32_t k,i;                                                          \
+         for(k = 0; k < n; ++k) {                                              \
+             const T * __restrict lk = &a[MPS_IDX(0,k,lda)];                   \
+             const T bk = (b[k] /= lk[k]);                                     \
+             _Pragma("omp simd")                                               \
+             for(i = k+1; i < n; ++i) b[i] -= lk[i]*bk;                        \
+         }                                                                     \
+         for(k = n-1; k >= 0; --k) {                                           \
+             const T * __restrict lk = &a[MPS_IDX(0,k,lda)];                   \
+             T s = b[k];                                                       \
+             _Pragma("omp simd reduction(-:s)")                                \
+             for(i = k+1; i < n; ++i) s -= lk[i]*b[i];                         \
+             b[k] = s/lk[k];                                                   \
+         }                                                                     \
+}
+
+
+MPS_DEF_GETRF(mps_sgetrf,float,sgemm_skx_omp)
+MPS_DEF_GETRF(mps_dgetrf,double,dgemm_skx_omp)
+MPS_DEF_POTRF(mps_spotrf,float,sgemm_skx_omp)
+MPS_DEF_POTRF(mps_dpotrf,double,dgemm_skx_omp)
+MPS_DEF_GETRS(mps_sgetrs,float)
+MPS_DEF_GETRS(mps_dgetrs,double)
+MPS_DEF_POTRS(mps_spotrs,float)
+MPS_DEF_POTRS(mps_dpotrs,double)
+
+
+/*
+     fp64 -> fp32 with overflow test (returns 0 when some |x| > FLT_MAX).
+*/
+static int32_t mps_d2s(const int32_t n,
+                       const double * __restrict x,
+                       float * __restrict y) {
+
+         const __m512d vmax = _mm512_set1_pd((double)FLT_MAX);
+         __mmask8 ovf = 0;
+         int32_t i = 0;
+         for(; (i+7) < n; i += 8) {
+             const __m512d v = _mm512_loadu_pd(&x[i]);
+             ovf |= _mm512_cmp_pd_mask(_mm512_abs_pd(v),vmax,_CMP_GT_OQ);
+             _mm256_storeu_ps(&y[i],_mm512_cvtpd_ps(v));
+         }
+         if(i < n) {
+            const __mmask8 k = (__mmask8)((1U << (n-i))-1U);
+            const __m512d  v = _mm512_maskz_loadu_pd(k,&x[i]);
+            ovf |= _mm512_cmp_pd_mask(_mm512_abs_pd(v),vmax,_CMP_GT_OQ);
+            _mm256_mask_storeu_ps(&y[i],k,_mm512_cvtpd_ps(v));
+         }
+         return (ovf == 0);
+}
+
+
+static inline double mps_amax(const int32_t n,
+                              const double * __restrict x) {
+         double m = 0.0;
+         int32_t i;
+#pragma omp simd reduction(max:m)
+         for(i = 0; i < n; ++i) m = MPS_MAX(m,fabs(x[i]));
+         return (m);
+}
+
+
+/*
+     Refinement loop shared by both solvers. solve32 applies the fp32
+     factor to one vector. Returns 1 on convergence (and sets *iter),
+     0 when MPS_IR_ITERMAX corrections were not enough or a correction
+     overflowed fp32.
+*/
+typedef void (*mps_solve32_fn)(const int32_t,
+                               const float * __restrict,
+                               const int32_t,
+                               const int32_t * __restrict,
+                               float * __restrict);
+
+static void mps_getrs32(const int32_t n, const float * __restrict a, const int32_t lda,
+                        const int32_t * __restrict ipiv, float * __restrict b) {
+         mps_sgetrs(n,a,lda,ipiv,b);
+}
+
+static void mps_potrs32(const int32_t n, const float * __restrict a, const int32_t lda,
+                        const int32_t * __restrict ipiv, float * __restrict b) {
+         (void)ipiv;
+         mps_spotrs(n,a,lda,b);
+}
+
+
+static int32_t mps_refine(const int32_t n,
+                          const int32_t nrhs,
+                          const double * __restrict A,
+                          const int32_t lda,
+                          const double * __restrict B,
+                          const int32_t ldb,
+                          double * __restrict X,
+                          const int32_t ldx,
+                          const float * __restrict F,
+                          const int32_t * __restrict ipiv,
+                          const mps_solve32_fn solve32,
+                          const double cte,
+                          double * __restrict r,
+                          float * __restrict w,
+                          int32_t * __restrict iter) {
+
+         int32_t it,c,i,done;
+         // Initial fp32 solve.
+         for(c = 0; c < nrhs; ++c) {
+             double * __restrict xc = &X[MPS_IDX(0,c,ldx)];
+             if(!mps_d2s(n,&B[MPS_IDX(0,c,ldb)],w)) return (0);
+             solve32(n,F,n,ipiv,w);
+             for(i = 0; i < n; ++i) xc[i] = (double)w[i];
+         }
+         for(it = 0; ; ++it) {
+             done = 1;
+             for(c = 0; c < nrhs; ++c) {
+                 double * __restrict xc = &X[MPS_IDX(0,c,ldx)];
+                 double xnrm,rnrm;
+                 memcpy(r,&B[MPS_IDX(0,c,ldb)],(size_t)n*sizeof(double));
+                 // r := b - A*x with double-double accumulation.
+                 BLAS_dgemv_x(blas_colmajor,blas_no_trans,n,n,-1.0,(double*)A,lda,
+                              xc,1,1.0,r,1,blas_prec_extra);
+                 xnrm = mps_amax(n,xc);
+                 rnrm = mps_amax(n,r);
+                 if(rnrm <= xnrm*cte) continue;
+                 if(!(rnrm == rnrm) || !(xnrm == xnrm)) return (0);
+                 done = 0;
+                 if(it == MPS_IR_ITERMAX) break;
+                 if(!mps_d2s(n,r,w)) return (0);
+                 solve32(n,F,n,ipiv,w);
+                 for(i = 0; i < n; ++i) xc[i] += (double)w[i];
+             }
+             if(done) {
+                *iter = it;
+                return (1);
+             }
+             if(it == MPS_IR_ITERMAX) return (0);
+         }
+}
+
+
+static double mps_anrm_inf(const int32_t n,
+                           const double * __restrict A,
+                           const int32_t lda,
+                           double * __restrict rs) {
+         double m = 0.0;
+         int32_t i,j;
+         memset(rs,0,(size_t)n*sizeof(double));
+         for(j = 0; j < n; ++j) {
+             const double * __restrict aj = &A[MPS_IDX(0,j,lda)];
+#pragma omp simd
+             for(i = 0; i < n; ++i) rs[i] += fabs(aj[i]);
+         }
+         for(i = 0; i < n; ++i) m = MPS_MAX(m,rs[i]);
+         return (m);
+}
+
+
+static int32_t mps_check_args(const int32_t n,
+                              const int32_t nrhs,
+                              const int32_t lda,
+                              const int32_t ldb,
+                              const int32_t ldx) {
+         const int32_t ld = MPS_MAX(1,n);
+         return (n >= 0 && nrhs >= 0 && lda >= ld && ldb >= ld && ldx >= ld);
+}
+
+
+int32_t dsgesv_ir(const int32_t n,
+                  const int32_t nrhs,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  double * __restrict X,
+                  const int32_t ldx,
+                  int32_t * __restrict iter) {
+
+         const size_t nn = (size_t)n*(size_t)n;
+         unsigned char * __restrict buf = NULL;
+         float   * __restrict F;
+         double  * __restrict r;
+         float   * __restrict w;
+         int32_t * __restrict ipiv;
+         double * __restrict D;
+         double cte;
+         int32_t ret,j,c,ok;
+         if(__builtin_expect(NULL==iter || !mps_check_args(n,nrhs,lda,ldb,ldx),0)) return (-1);
+         *iter = 0;
+         if(n == 0 || nrhs == 0) return (0);
+         if(__builtin_expect(NULL==A || NULL==B || NULL==X,0)) return (-1);
+         buf = (unsigned char*)_mm_malloc(nn*sizeof(float)+(size_t)n*(sizeof(double)+sizeof(float)+sizeof(int32_t))+64,64);
+         if(__builtin_expect(NULL==buf,0)) return (-2);
+         r    = (double*)buf;
+         F    = (float*)(buf+(size_t)n*sizeof(double));
+         w    = F+nn;
+         ipiv = (int32_t*)(w+n);
+
+         cte = mps_anrm_inf(n,A,lda,r)*(0.5*DBL_EPSILON)*sqrt((double)n);
+         ok = 1;
+         for(j = 0; j < n && ok; ++j) ok = mps_d2s(n,&A[MPS_IDX(0,j,lda)],&F[MPS_IDX(0,j,n)]);
+         if(!ok) {
+            *iter = -2;
+         }
+         else {
+            ret = mps_sgetrf(n,F,n,ipiv);
+            if(ret == -2) { _mm_free(buf); return (-2); }
+            if(ret != 0) {
+               *iter = -3;
+            }
+            else if(mps_refine(n,nrhs,A,lda,B,ldb,X,ldx,F,ipiv,mps_getrs32,cte,r,w,iter)) {
+               _mm_free(buf);
+               return (0);
+            }
+            else {
+               *iter = -MPS_IR_ITERMAX-1;
+            }
+         }
+         // fp64 fallback.
+         D = (double*)_mm_malloc(nn*sizeof(double),64);
+         if(__builtin_expect(NULL==D,0)) { _mm_free(buf); return (-2); }
+         for(j = 0; j < n; ++j)
+             memcpy(&D[MPS_IDX(0,j,n)],&A[MPS_IDX(0,j,lda)],(size_t)n*sizeof(double));
+         ret = mps_dgetrf(n,D,n,ipiv);
+         if(ret == 0) {
+            for(c = 0; c < nrhs; ++c) {
+                double * __restrict xc = &X[MPS_IDX(0,c,ldx)];
+                memcpy(xc,&B[MPS_IDX(0,c,ldb)],(size_t)n*sizeof(double));
+                mps_dgetrs(n,D,n,ipiv,xc);
+            }
+         }
+         _mm_free(D);
+         _mm_free(buf);
+         return (ret);
+}
+
+
+int32_t dsposv_ir(const char uplo,
+                  const int32_t n,
+                  const int32_t nrhs,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  double * __restrict X,
+                  const int32_t ldx,
+                  int32_t * __restrict iter) {
+
+         const size_t nn = (size_t)n*(size_t)n;
+         const int32_t lower = (uplo == 'L' || uplo == 'l');
+         unsigned char * __restrict buf = NULL;
+         double  * __restrict S;
+         float   * __restrict F;
+         double  * __restrict r;
+         float   * __restrict w;
+         double cte;
+         int32_t ret,i,j,c,ok;
+         if(__builtin_expect(NULL==iter || !mps_check_args(n,nrhs,lda,ldb,ldx),0)) return (-1);
+         if(__builtin_expect(!lower && uplo != 'U' && uplo != 'u',0)) return (-1);
+         *iter = 0;
+         if(n == 0 || nrhs == 0) return (0);
+         if(__builtin_expect(NULL==A || NULL==B || NULL==X,0)) return (-1);
+         // S: full symmetric fp64 copy (residuals, fp64 fallback), F: fp32 factor.
+         buf = (unsigned char*)_mm_malloc(nn*(sizeof(double)+sizeof(float))+(size_t)n*(sizeof(double)+sizeof(float))+64,64);
+         if(__builtin_expect(NULL==buf,0)) return (-2);
+         S = (double*)buf;
+         r = S+nn;
+         F = (float*)(r+n);
+         w = F+nn;
+         for(j = 0; j < n; ++j) {
+             for(i = j; i < n; ++i) {
+                 const double v = lower ? A[MPS_IDX(i,j,lda)] : A[MPS_IDX(j,i,lda)];
+                 S[MPS_IDX(i,j,n)] = v;
+                 S[MPS_IDX(j,i,n)] = v;
+             }
+         }
+
+         cte = mps_anrm_inf(n,S,n,r)*(0.5*DBL_EPSILON)*sqrt((double)n);
+         ok = 1;
+         for(j = 0; j < n && ok; ++j) ok = mps_d2s(n,&S[MPS_IDX(0,j,n)],&F[MPS_IDX(0,j,n)]);
+         if(!ok) {
+            *iter = -2;
+         }
+         else {
+            ret = mps_spotrf(n,F,n);
+            if(ret == -2) { _mm_free(buf); return (-2); }
+            if(ret != 0) {
+               *iter = -3;
+            }
+            else if(mps_refine(n,nrhs,S,n,B,ldb,X,ldx,F,NULL,mps_potrs32,cte,r,w,iter)) {
+               _mm_free(buf);
+               return (0);
+            }
+            else {
+               *iter = -MPS_IR_ITERMAX-1;
+            }
+         }
+         // fp64 fallback, factored in place of S.
+         ret = mps_dpotrf(n,S,n);
+         if(ret == 0) {
+            for(c = 0; c < nrhs; ++c) {
+                double * __restrict xc = &X[MPS_IDX(0,c,ldx)];
+                memcpy(xc,&B[MPS_IDX(0,c,ldb)],(size_t)n*sizeof(double));
+                mps_dpotrs(n,S,n,xc);
+            }
+         }
+         _mm_free(buf);
+         return (ret);
+}
+
+
+/*
+     Validation
+*/
+static uint64_t mps_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double mps_draw(uint64_t * __restrict s) {
+
+         return ((double)(mps_rng(s) >> 11) * 0x1.0p-52 - 1.0);
+}
+
+// Test matrices.
+#define MPS_VAL_RAND  0   // general: uniform [-1,1]; SPD: diagonally dominant
+#define MPS_VAL_BIG   1   // MPS_VAL_RAND * 2^130 (overflows fp32)
+#define MPS_VAL_SING  2   // identity with the block [1 1; 1 1+2^-40] (singular in fp32)
+#define MPS_VAL_HILB  3   // Hilbert matrix (cond ~ 1e16)
+
+typedef struct {
+        char    solver;   // 'G' dsgesv_ir, 'L'/'U' dsposv_ir
+        int32_t n;
+        int32_t mat;
+        int32_t iter;     // expected *iter (0: any converged count)
+} mps_case_t;
+
+static const mps_case_t mps_cases[] = {
+        {'G',  1,MPS_VAL_RAND, 0},{'L',  1,MPS_VAL_RAND, 0},{'U',  1,MPS_VAL_RAND, 0},
+        {'G', 37,MPS_VAL_RAND, 0},{'L', 37,MPS_VAL_RAND, 0},{'U', 37,MPS_VAL_RAND, 0},
+        {'G',300,MPS_VAL_RAND, 0},{'L',300,MPS_VAL_RAND, 0},{'U',300,MPS_VAL_RAND, 0},
+        {'G', 37,MPS_VAL_BIG, -2},{'L', 37,MPS_VAL_BIG, -2},{'U', 37,MPS_VAL_BIG, -2},
+        {'G', 37,MPS_VAL_SING,-3},{'L', 37,MPS_VAL_SING,-3},{'U', 37,MPS_VAL_SING,-3},
+        {'G', 12,MPS_VAL_HILB,-MPS_IR_ITERMAX-1},
+        {'L',  8,MPS_VAL_HILB,-MPS_IR_ITERMAX-1},{'U',  8,MPS_VAL_HILB,-MPS_IR_ITERMAX-1}
+};
+
+#define MPS_VAL_NRHS 3
+
+// Backward error max|B-A*X| / (||A||_inf * max|X| * eps * sqrt(n)),
+// residual in long double, worst right-hand side.
+static double mps_berr(const int32_t n,
+                       const double * __restrict A,
+                       const int32_t lda,
+                       const double * __restrict B,
+                       const int32_t ldb,
+                       const double * __restrict X,
+                       const int32_t ldx) {
+
+         double anrm = 0.0,e = 0.0;
+         int32_t i,j,c;
+         for(i = 0; i < n; ++i) {
+             double s = 0.0;
+             for(j = 0; j < n; ++j) s += fabs(A[MPS_IDX(i,j,lda)]);
+             anrm = MPS_MAX(anrm,s);
+         }
+         for(c = 0; c < MPS_VAL_NRHS; ++c) {
+             const double * __restrict xc = &X[MPS_IDX(0,c,ldx)];
+             double rn = 0.0;
+             for(i = 0; i < n; ++i) {
+                 long double s = (long double)B[MPS_IDX(i,c,ldb)];
+                 for(j = 0; j < n; ++j) s -= (long double)A[MPS_IDX(i,j,lda)]*(long double)xc[j];
+                 rn = MPS_MAX(rn,(double)fabsl(s));
+             }
+             rn /= anrm*mps_amax(n,xc)*DBL_EPSILON*sqrt((double)n);
+             if(!(rn <= e)) e = rn;
+         }
+         return (e);
+}
+
+int32_t mixed_prec_solver_validate(FILE * __restrict fp,
+                                   const uint64_t seed) {
+
+         const int32_t ncase = (int32_t)(sizeof(mps_cases)/sizeof(mps_cases[0]));
+         const int32_t nmax  = 300;
+         const int32_t lda   = nmax+1,ldb = nmax+2,ldx = nmax+3;
+         double *A = NULL,*S = NULL,*B = NULL,*X = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t cs,i,j,it,st;
+         if(NULL==fp) return (-1);
+         A = (double*)malloc((size_t)lda*(size_t)nmax*sizeof(double));
+         S = (double*)malloc((size_t)lda*(size_t)nmax*sizeof(double));
+         B = (double*)malloc((size_t)ldb*MPS_VAL_NRHS*sizeof(double));
+         X = (double*)malloc((size_t)ldx*MPS_VAL_NRHS*sizeof(double));
+         if(NULL==A || NULL==S || NULL==B || NULL==X) {
+            nbad = -1;
+            goto done;
+         }
+         fprintf(fp,"Mixed-precision solvers, %d right-hand sides, backward error tol %.1f\n",
+                 MPS_VAL_NRHS,MPS_VAL_TOL);
+         for(cs = 0; cs != ncase; ++cs) {
+             const mps_case_t * __restrict q = &mps_cases[cs];
+             const int32_t n = q->n;
+             const int32_t spd = (q->solver != 'G');
+             const double sc = (q->mat == MPS_VAL_BIG) ? 0x1.0p130 : 1.0;
+             double e;
+             int32_t bad;
+             // Full matrix in S (the reference), the solver's view in A.
+             for(j = 0; j < n; ++j) {
+                 for(i = 0; i < n; ++i) {
+                     double v;
+                     if(q->mat == MPS_VAL_HILB) {
+                        v = 1.0/(double)(i+j+1);
+                     }
+                     else if(q->mat == MPS_VAL_SING) {
+                        v = (i == j) ? 1.0 : 0.0;
+                        if(i < 2 && j < 2) v = (i+j == 2) ? 1.0+0x1.0p-40 : 1.0;
+                     }
+                     else if(spd) {
+                        if(i < j) continue;
+                        v = (i == j) ? (double)n+mps_draw(&s) : mps_draw(&s);
+                     }
+                     else {
+                        v = mps_draw(&s);
+                     }
+                     S[MPS_IDX(i,j,lda)] = v*sc;
+                 }
+             }
+             if(spd) {
+                for(j = 0; j < n; ++j)
+                    for(i = 0; i < j; ++i) S[MPS_IDX(i,j,lda)] = S[MPS_IDX(j,i,lda)];
+             }
+             // The triangle dsposv_ir must not read is NaN.
+             for(j = 0; j < n; ++j) {
+                 for(i = 0; i < n; ++i) {
+                     const int32_t unref = (q->solver == 'L' && i < j) || (q->solver == 'U' && i > j);
+                     A[MPS_IDX(i,j,lda)] = unref ? NAN : S[MPS_IDX(i,j,lda)];
+                 }
+             }
+             for(j = 0; j < MPS_VAL_NRHS; ++j)
+                 for(i = 0; i < n; ++i) B[MPS_IDX(i,j,ldb)] = mps_draw(&s)*sc;
+             if(spd) st = dsposv_ir(q->solver,n,MPS_VAL_NRHS,A,lda,B,ldb,X,ldx,&it);
+             else    st = dsgesv_ir(n,MPS_VAL_NRHS,A,lda,B,ldb,X,ldx,&it);
+             e = (st == 0) ? mps_berr(n,S,lda,B,ldb,X,ldx) : NAN;
+             bad = (st != 0 || !(e <= MPS_VAL_TOL) ||
+                    ((q->iter == 0) ? (it < 0) : (it != q->iter)));
+             nbad += bad;
+             fprintf(fp,"  %s%c n=%4d %-5s stat %d iter %3d (expected %s%3d) berr %.3f%s\n",
+                     spd ? "dsposv_ir " : "dsgesv_ir",spd ? q->solver : ' ',n,
+                     (q->mat == MPS_VAL_RAND) ? "rand" : (q->mat == MPS_VAL_BIG) ? "big" :
+                     (q->mat == MPS_VAL_SING) ? "sing" : "hilb",
+                     st,it,(q->iter == 0) ? ">=" : "  ",q->iter,e,bad ? "  FAIL" : "");
+         }
+         // Argument checks.
+         st  = (dsgesv_ir(4,1,A,3,B,ldb,X,ldx,&it) != -1);
+         st += (dsposv_ir('X',4,1,A,lda,B,ldb,X,ldx,&it) != -1);
+         st += (dsposv_ir('L',4,1,A,lda,B,ldb,X,ldx,NULL) != -1);
+         fprintf(fp,"  invalid arguments -> -1%s\n",st ? "  FAIL" : "");
+         nbad += (st != 0);
+done:
+         free(A);
+         free(S);
+         free(B);
+         free(X);
+         return (nbad);
+}
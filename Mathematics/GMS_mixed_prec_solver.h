@@ -0,0 +1,95 @@
+
+
+#ifndef __GMS_MIXED_PREC_SOLVER_H__
+#define __GMS_MIXED_PREC_SOLVER_H__
+
+//
+// Mixed-precision dense linear solvers with iterative refinement.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 21:00 PM +00200
+//
+// A*X = B (A general: LU with partial pivoting, A symmetric positive
+// definite: Cholesky) is factored in fp32, where the blocked factorizations
+// run their trailing updates through the AVX512 sgemm_skx kernels at twice
+// the fp64 rate, and X is refined to fp64 accuracy:
+//     X := fp64(solve32(B))
+//     repeat: R := B - A*X      (xblas BLAS_dgemv_x, blas_prec_extra)
+//             X := X + fp64(solve32(fp32(R)))
+//     until  max|R| <= max|X| * ||A||_inf * eps * sqrt(n)   (dsgesv criterion)
+// If A does not fit into fp32, the fp32 factorization breaks down or the
+// refinement does not converge in MPS_IR_ITERMAX steps, the solvers fall
+// back to an fp64 factorization (dgemm_skx trailing updates) and solve.
+//
+// Storage is column-major (Fortran); A and B are not modified.
+// *iter reports the path taken (LAPACK dsgesv/dsposv convention):
+//     >= 0  refinement converged after *iter corrections
+//     -2    A overflowed fp32                      -> fp64 solve
+//     -3    fp32 factorization failed              -> fp64 solve
+//     -31   no convergence after MPS_IR_ITERMAX    -> fp64 solve
+// Return values: 0 success, -1 invalid argument, -2 allocation failure,
+// k > 0: the fp64 factorization found a zero pivot (or non-positive
+// diagonal for Cholesky) in column k (1-based); X is not computed.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+#if !defined(MPS_IR_ITERMAX)
+    #define MPS_IR_ITERMAX 30
+#endif
+
+// Panel width of the blocked factorizations.
+#if !defined(MPS_NB)
+    #define MPS_NB 128
+#endif
+
+// Largest accepted backward error of mixed_prec_solver_validate, in units
+// of ||A||_inf * max|X| * eps * sqrt(n).
+#if !defined(MPS_VAL_TOL)
+    #define MPS_VAL_TOL 1.0
+#endif
+
+
+// General A: fp32 LU + refinement (cf. LAPACK DSGESV).
+int32_t dsgesv_ir(const int32_t,             // n
+                  const int32_t,             // nrhs
+                  const double * __restrict, // A(lda,n)
+                  const int32_t,             // lda
+                  const double * __restrict, // B(ldb,nrhs)
+                  const int32_t,             // ldb
+                  double * __restrict,       // X(ldx,nrhs)
+                  const int32_t,             // ldx
+                  int32_t * __restrict)      // iter
+                                             __attribute__((noinline))
+                                             __attribute__((hot))
+                                             __attribute__((aligned(32)));
+
+// Symmetric positive definite A ('L' or 'U' triangle referenced):
+// fp32 Cholesky + refinement (cf. LAPACK DSPOSV).
+int32_t dsposv_ir(const char,                // uplo
+                  const int32_t,             // n
+                  const int32_t,             // nrhs
+                  const double * __restrict, // A(lda,n)
+                  const int32_t,             // lda
+                  const double * __restrict, // B(ldb,nrhs)
+                  const int32_t,             // ldb
+                  double * __restrict,       // X(ldx,nrhs)
+                  const int32_t,             // ldx
+                  int32_t * __restrict)      // iter
+                                             __attribute__((noinline))
+                                             __attribute__((hot))
+                                             __attribute__((aligned(32)));
+
+// Solves random general and SPD systems (n = 1, 37, 300; both triangles
+// for dsposv_ir) and the fallback cases: A scaled out of fp32 range (-2),
+// singular after rounding to fp32 (-3) and Hilbert matrices (-31). Checks
+// the status, the reported path and the backward error; prints one line
+// per case and returns the number of failures.
+int32_t mixed_prec_solver_validate(FILE * __restrict,
+                                   const uint64_t);        // seed
+
+
+
+
+#endif /*__GMS_MIXED_PREC_SOLVER_H__*/
@@ -0,0 +1,90 @@
+
+
+module mixed_prec_solver_iface
+
+
+!===========================================================!
+! Interfaces to the mixed-precision (fp32 factorization +   !
+! extra-precision iterative refinement) dense solvers       !
+! GMS_mixed_prec_solver.c                                   !
+! Arrays are column-major, A and B are not modified.        !
+! iter >= 0: refinement converged, iter < 0: fp64 fallback  !
+! (-2 A overflows fp32, -3 fp32 factorization failed,       !
+!  -31 no convergence).                                     !
+!===========================================================!
+
+
+use, intrinsic :: ISO_C_BINDING
+implicit none
+public
+
+
+#if 0
+int32_t dsgesv_ir(const int32_t n,
+                  const int32_t nrhs,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  double * __restrict X,
+                  const int32_t ldx,
+                  int32_t * __restrict iter);
+#endif
+
+interface
+
+   function dsgesv_ir(n,nrhs,A,lda,B,ldb,X,ldx,iter) &
+                      result(stat)                   &
+                      bind(c,name='dsgesv_ir')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int32_t),                   intent(in), value :: n
+            integer(c_int32_t),                   intent(in), value :: nrhs
+            integer(c_int32_t),                   intent(in), value :: lda
+            integer(c_int32_t),                   intent(in), value :: ldb
+            integer(c_int32_t),                   intent(in), value :: ldx
+            real(c_double),  dimension(lda,*),    intent(in)        :: A
+            real(c_double),  dimension(ldb,*),    intent(in)        :: B
+            real(c_double),  dimension(ldx,*),    intent(out)       :: X
+            integer(c_int32_t),                   intent(out)       :: iter
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t dsposv_ir(const char uplo,
+                  const int32_t n,
+                  const int32_t nrhs,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  double * __restrict X,
+                  const int32_t ldx,
+                  int32_t * __restrict iter);
+#endif
+
+interface
+
+   function dsposv_ir(uplo,n,nrhs,A,lda,B,ldb,X,ldx,iter) &
+                      result(stat)                        &
+                      bind(c,name='dsposv_ir')
+            use, intrinsic :: ISO_C_BINDING
+            character(kind=c_char),               intent(in), value :: uplo
+            integer(c_int32_t),                   intent(in), value :: n
+            integer(c_int32_t),                   intent(in), value :: nrhs
+            integer(c_int32_t),                   intent(in), value :: lda
+            integer(c_int32_t),                   intent(in), value :: ldb
+            integer(c_int32_t),                   intent(in), value :: ldx
+            real(c_double),  dimension(lda,*),    intent(in)        :: A
+            real(c_double),  dimension(ldb,*),    intent(in)        :: B
+            real(c_double),  dimension(ldx,*),    intent(out)       :: X
+            integer(c_int32_t),                   intent(out)       :: iter
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+end module mixed_prec_solver_iface
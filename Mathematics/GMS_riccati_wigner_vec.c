@@ -0,0 +1,636 @@
+
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_riccati_wigner_vec.h"
+#include "GMS_riccati_wigner_vec_private.h"
+#include "GMS_vmath.h"
+
+//
+// Scalar recurrences, threading and ISA dispatch of the Riccati-Bessel
+// and Wigner-d array functions.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 02:00 AM +00200
+//
+
+
+/*
+     Scalar kernels (one argument at a time, same operations as the
+     vector kernels of GMS_riccati_wigner_vec_avx512.c)
+*/
+static void rwv_jr_scalar(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          const int32_t ric,
+                          double * __restrict j,
+                          double * __restrict u,
+                          const int64_t ld) {
+
+         int64_t i;
+         for(i = 0; i != m; ++i) {
+             const double xi = x[i];
+             const double xx = 1.0/xi;
+             const int32_t l = rwv_start(nmax,nnmax,xi);
+             const double sc = ric ? xi : 1.0;
+             double z = 1.0/((double)(2*l+1)*xx);
+             double jp,j1,jk;
+             int32_t k;
+             // Ratios j_k/j_{k-1}, kept in j for k <= nmax.
+             for(k = l-1; k > nmax; --k) z = 1.0/((double)(2*k+1)*xx-z);
+             for(k = nmax; k >= 1; --k) {
+                 z = 1.0/((double)(2*k+1)*xx-z);
+                 j[(int64_t)(k-1)*ld+i] = z;
+             }
+             // j_0, j_1 in closed form; the larger one normalizes the ratios
+             // (near a zero of j_0, j_0 times j_1/j_0 loses digits).
+             jp = sin(xi)*xx;
+             j1 = (jp-cos(xi))*xx;
+             for(k = 1; k <= nmax; ++k) {
+                 const int64_t o = (int64_t)(k-1)*ld+i;
+                 jk = (k == 1 && fabs(j1) > fabs(jp)) ? j1 : jp*j[o];
+                 u[o] = (jp-(double)k*jk*xx)*sc;
+                 j[o] = jk*sc;
+                 jp = jk;
+             }
+         }
+}
+
+static void rwv_yr_scalar(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t ric,
+                          double * __restrict y,
+                          double * __restrict v,
+                          const int64_t ld) {
+
+         int64_t i;
+         for(i = 0; i != m; ++i) {
+             const double xi = x[i];
+             const double x1 = 1.0/xi;
+             const double c  = cos(xi);
+             const double s  = sin(xi);
+             const double sc = ric ? xi : 1.0;
+             double yp = -c*x1;
+             double yk = -c*x1*x1-s*x1;
+             double yn;
+             int32_t k;
+             for(k = 1; k <= nmax; ++k) {
+                 const int64_t o = (int64_t)(k-1)*ld+i;
+                 y[o] = yk*sc;
+                 v[o] = (yp-(double)k*x1*yk)*sc;
+                 yn = (double)(2*k+1)*x1*yk-yp;
+                 yp = yk;
+                 yk = yn;
+             }
+         }
+}
+
+static void rwv_jc_scalar(const double * __restrict xr,
+                          const double * __restrict xi,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          const int32_t ric,
+                          double * __restrict jr,
+                          double * __restrict ji,
+                          double * __restrict ur,
+                          double * __restrict ui,
+                          const int64_t ld) {
+
+         int64_t i;
+         for(i = 0; i != m; ++i) {
+             const double zr = xr[i];
+             const double zi = xi[i];
+             const double r2 = 1.0/(zr*zr+zi*zi);
+             const double cr = zr*r2;           // 1/z
+             const double ci = -zi*r2;
+             const int32_t l = rwv_start(nmax,nnmax,sqrt(zr*zr+zi*zi));
+             const double qf = 1.0/(double)(2*l+1);
+             const double sr = sin(zr)*cosh(zi);  // sin(z)
+             const double si = cos(zr)*sinh(zi);
+             double ar,ai,d,pr,pi,qr,qi,wr,wi,j1r,j1i;
+             int32_t big;
+             double czr = zr*qf;
+             double czi = zi*qf;
+             int32_t k;
+             for(k = l-1; k >= 1; --k) {
+                 ar  = (double)(2*k+1)*cr-czr;
+                 ai  = (double)(2*k+1)*ci-czi;
+                 d   = 1.0/(ar*ar+ai*ai);
+                 czr = ar*d;
+                 czi = -ai*d;
+                 if(k <= nmax) {
+                    jr[(int64_t)(k-1)*ld+i] = czr;
+                    ji[(int64_t)(k-1)*ld+i] = czi;
+                 }
+             }
+             pr = sr*cr-si*ci;                  // j_0 = sin(z)/z
+             pi = si*cr+sr*ci;
+             ar = pr-cos(zr)*cosh(zi);          // j_1 = (j_0 - cos(z))/z
+             ai = pi+sin(zr)*sinh(zi);
+             j1r = ar*cr-ai*ci;
+             j1i = ai*cr+ar*ci;
+             big = j1r*j1r+j1i*j1i > pr*pr+pi*pi;
+             for(k = 1; k <= nmax; ++k) {
+                 const int64_t o = (int64_t)(k-1)*ld+i;
+                 czr = jr[o];
+                 czi = ji[o];
+                 qr  = pr*czr-pi*czi;           // j_k
+                 qi  = pi*czr+pr*czi;
+                 if(k == 1 && big) {
+                    qr = j1r;
+                    qi = j1i;
+                 }
+                 ar  = qr*cr-qi*ci;             // j_k/z
+                 ai  = qi*cr+qr*ci;
+                 wr  = pr-(double)k*ar;         // u_k
+                 wi  = pi-(double)k*ai;
+                 if(ric) {
+                    jr[o] = qr*zr-qi*zi;
+                    ji[o] = qi*zr+qr*zi;
+                    ur[o] = wr*zr-wi*zi;
+                    ui[o] = wi*zr+wr*zi;
+                 } else {
+                    jr[o] = qr;
+                    ji[o] = qi;
+                    ur[o] = wr;
+                    ui[o] = wi;
+                 }
+                 pr = qr;
+                 pi = qi;
+             }
+         }
+}
+
+static void rwv_dw_scalar(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t mm,
+                          const int32_t ampl,
+                          double * __restrict dv1,
+                          double * __restrict dv2,
+                          const int64_t ld) {
+
+         const double a0 = rwv_dstart(mm);
+         int64_t i;
+         int32_t n,k;
+         for(n = 1; n < mm && n <= nmax; ++n) {
+             memset(&dv1[(int64_t)(n-1)*ld],0,(size_t)m*sizeof(double));
+             memset(&dv2[(int64_t)(n-1)*ld],0,(size_t)m*sizeof(double));
+         }
+         for(i = 0; i != m; ++i) {
+             const double xi  = x[i];
+             const double qs  = sqrt(1.0-xi*xi);
+             const double qs1 = 1.0/qs;
+             const int32_t pole = fabs(1.0-fabs(xi)) <= RWV_POLE;
+             double d1 = 0.0,d2 = a0,d3;
+             for(k = 0; k != mm; ++k) d2 *= qs;
+             for(n = mm; n <= nmax; ++n) {
+                 const rwv_dcoef_t c = rwv_dcoef(n,mm);
+                 d3 = c.a*xi*d2-c.b*d1;
+                 if(n >= 1) {
+                    const int64_t o = (int64_t)(n-1)*ld+i;
+                    if(pole) {
+                       rwv_dpole(xi,n,mm,ampl,&dv1[o],&dv2[o]);
+                    } else {
+                       dv1[o] = ampl ? d2*qs1 : d2;
+                       dv2[o] = qs1*(c.e*d3-c.f*d1);
+                    }
+                 }
+                 d1 = d2;
+                 d2 = d3;
+             }
+         }
+}
+
+const rwv_isa_tab_t rwv_tab_scalar = {
+        rwv_jr_scalar,
+        rwv_yr_scalar,
+        rwv_jc_scalar,
+        rwv_dw_scalar
+};
+
+
+/*
+     Drivers
+*/
+static const rwv_isa_tab_t * rwv_tab(void) {
+
+         return ((vmath_get_isa() == VMATH_ISA_AVX512) ? &rwv_tab_avx512 : &rwv_tab_scalar);
+}
+
+enum {
+        RWV_K_J,          // j, u
+        RWV_K_Y,          // y, v
+        RWV_K_JC,         // complex j, u
+        RWV_K_BESS,       // all of BESS
+        RWV_K_RIC,        // psi, dpsi, chi, dchi
+        RWV_K_RICC,       // complex psi, dpsi
+        RWV_K_D           // d^n_{0m}
+};
+
+typedef struct {
+        const double * __restrict x;
+        const double * __restrict xr;
+        const double * __restrict xi;
+        double * __restrict f[8];
+        int64_t nx;
+        int64_t ld;
+        int32_t nmax;
+        int32_t nn1;           // nnmax (x) or m (Wigner)
+        int32_t nn2;           // nnmax (z) or ampl (Wigner)
+} rwv_args_t;
+
+static void rwv_drive(const int32_t kind,
+                      const rwv_args_t * __restrict a) {
+
+         const rwv_isa_tab_t * __restrict tab = rwv_tab();
+         const int64_t nblk = (a->nx+RWV_BLOCK-1)/RWV_BLOCK;
+         const int32_t par  = a->nx*(int64_t)a->nmax >= RWV_OMP_MIN;
+         int64_t b;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic,1) if(par) default(none) \
+        shared(tab,a) firstprivate(kind,nblk)
+#endif
+         for(b = 0; b < nblk; ++b) {
+             const int64_t i0 = b*RWV_BLOCK;
+             const int64_t m  = (a->nx-i0 < RWV_BLOCK) ? a->nx-i0 : RWV_BLOCK;
+             const int64_t ld = a->ld;
+             switch(kind) {
+             case RWV_K_J:
+                  tab->jr(&a->x[i0],m,a->nmax,a->nn1,0,&a->f[0][i0],&a->f[1][i0],ld);
+                  break;
+             case RWV_K_Y:
+                  tab->yr(&a->x[i0],m,a->nmax,0,&a->f[0][i0],&a->f[1][i0],ld);
+                  break;
+             case RWV_K_JC:
+                  tab->jc(&a->xr[i0],&a->xi[i0],m,a->nmax,a->nn1,0,&a->f[0][i0],
+                          &a->f[1][i0],&a->f[2][i0],&a->f[3][i0],ld);
+                  break;
+             case RWV_K_BESS:
+                  tab->jr(&a->x[i0],m,a->nmax,a->nn1,0,&a->f[0][i0],&a->f[4][i0],ld);
+                  tab->yr(&a->x[i0],m,a->nmax,0,&a->f[1][i0],&a->f[5][i0],ld);
+                  tab->jc(&a->xr[i0],&a->xi[i0],m,a->nmax,a->nn2,0,&a->f[2][i0],
+                          &a->f[3][i0],&a->f[6][i0],&a->f[7][i0],ld);
+                  break;
+             case RWV_K_RIC:
+                  tab->jr(&a->x[i0],m,a->nmax,a->nn1,1,&a->f[0][i0],&a->f[1][i0],ld);
+                  tab->yr(&a->x[i0],m,a->nmax,1,&a->f[2][i0],&a->f[3][i0],ld);
+                  break;
+             case RWV_K_RICC:
+                  tab->jc(&a->xr[i0],&a->xi[i0],m,a->nmax,a->nn1,1,&a->f[0][i0],
+                          &a->f[1][i0],&a->f[2][i0],&a->f[3][i0],ld);
+                  break;
+             default:
+                  tab->dw(&a->x[i0],m,a->nmax,a->nn1,a->nn2,&a->f[0][i0],&a->f[1][i0],ld);
+                  break;
+             }
+         }
+}
+
+// Common checks: sizes, output pointers, and arguments > 0.
+static int32_t rwv_check(const double * __restrict x,
+                         const int64_t nx,
+                         const int32_t nmax,
+                         const int64_t ld,
+                         double * __restrict const * f,
+                         const int32_t nf) {
+
+         int64_t i;
+         int32_t k;
+         if(__builtin_expect(nx<0,0) || __builtin_expect(nmax<1,0) ||
+            __builtin_expect(ld<nx,0)) return (-1);
+         for(k = 0; k != nf; ++k) if(NULL == f[k]) return (-1);
+         if(NULL == x) return (-1);
+         for(i = 0; i != nx; ++i) if(!(x[i] > 0.0)) return (-1);
+         return (0);
+}
+
+
+int32_t rwv_sphj_vec(const double * __restrict x,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     const int32_t nnmax,
+                     double * __restrict j,
+                     double * __restrict u,
+                     const int64_t ld) {
+
+         rwv_args_t a = {x,NULL,NULL,{j,u},nx,ld,nmax,nnmax,0};
+         if(rwv_check(x,nx,nmax,ld,a.f,2)) return (-1);
+         rwv_drive(RWV_K_J,&a);
+         return (0);
+}
+
+
+int32_t rwv_sphy_vec(const double * __restrict x,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     double * __restrict y,
+                     double * __restrict v,
+                     const int64_t ld) {
+
+         rwv_args_t a = {x,NULL,NULL,{y,v},nx,ld,nmax,0,0};
+         if(rwv_check(x,nx,nmax,ld,a.f,2)) return (-1);
+         rwv_drive(RWV_K_Y,&a);
+         return (0);
+}
+
+
+int32_t rwv_sphj_c_vec(const double * __restrict xr,
+                       const double * __restrict xi,
+                       const int64_t nx,
+                       const int32_t nmax,
+                       const int32_t nnmax,
+                       double * __restrict jr,
+                       double * __restrict ji,
+                       double * __restrict ur,
+                       double * __restrict ui,
+                       const int64_t ld) {
+
+         rwv_args_t a = {NULL,xr,xi,{jr,ji,ur,ui},nx,ld,nmax,nnmax,0};
+         if(NULL == xi || rwv_check(xr,nx,nmax,ld,a.f,4)) return (-1);
+         rwv_drive(RWV_K_JC,&a);
+         return (0);
+}
+
+
+int32_t rwv_bess_vec(const double * __restrict x,
+                     const double * __restrict xr,
+                     const double * __restrict xi,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     const int32_t nnmax1,
+                     const int32_t nnmax2,
+                     double * __restrict j,
+                     double * __restrict y,
+                     double * __restrict jr,
+                     double * __restrict ji,
+                     double * __restrict dj,
+                     double * __restrict dy,
+                     double * __restrict djr,
+                     double * __restrict dji,
+                     const int64_t ld) {
+
+         rwv_args_t a = {x,xr,xi,{j,y,jr,ji,dj,dy,djr,dji},nx,ld,nmax,nnmax1,nnmax2};
+         if(NULL == xi || rwv_check(x,nx,nmax,ld,a.f,8) ||
+            rwv_check(xr,nx,nmax,ld,a.f,0)) return (-1);
+         rwv_drive(RWV_K_BESS,&a);
+         return (0);
+}
+
+
+int32_t rwv_riccati_vec(const double * __restrict x,
+                        const int64_t nx,
+                        const int32_t nmax,
+                        const int32_t nnmax,
+                        double * __restrict psi,
+                        double * __restrict dpsi,
+                        double * __restrict chi,
+                        double * __restrict dchi,
+                        const int64_t ld) {
+
+         rwv_args_t a = {x,NULL,NULL,{psi,dpsi,chi,dchi},nx,ld,nmax,nnmax,0};
+         if(rwv_check(x,nx,nmax,ld,a.f,4)) return (-1);
+         rwv_drive(RWV_K_RIC,&a);
+         return (0);
+}
+
+
+int32_t rwv_riccati_c_vec(const double * __restrict xr,
+                          const double * __restrict xi,
+                          const int64_t nx,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          double * __restrict psir,
+                          double * __restrict psii,
+                          double * __restrict dpsir,
+                          double * __restrict dpsii,
+                          const int64_t ld) {
+
+         rwv_args_t a = {NULL,xr,xi,{psir,psii,dpsir,dpsii},nx,ld,nmax,nnmax,0};
+         if(NULL == xi || rwv_check(xr,nx,nmax,ld,a.f,4)) return (-1);
+         rwv_drive(RWV_K_RICC,&a);
+         return (0);
+}
+
+
+int32_t rwv_wigner_d_vec(const double * __restrict x,
+                         const int64_t nx,
+                         const int32_t nmax,
+                         const int32_t m,
+                         const int32_t ampl,
+                         double * __restrict dv1,
+                         double * __restrict dv2,
+                         const int64_t ld) {
+
+         rwv_args_t a = {x,NULL,NULL,{dv1,dv2},nx,ld,nmax,m,ampl};
+         int64_t i;
+         if(NULL==x || NULL==dv1 || NULL==dv2 || nx<0 || nmax<1 || ld<nx || m<0)
+            return (-1);
+         for(i = 0; i != nx; ++i) if(!(fabs(x[i]) <= 1.0)) return (-1);
+         rwv_drive(RWV_K_D,&a);
+         return (0);
+}
+
+
+/*
+     Validation against the scalar recurrences
+*/
+static uint64_t rwv_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double rwv_draw(uint64_t * __restrict s,
+                       const double lo,
+                       const double hi) {
+
+         const double u = (double)(rwv_rng(s) >> 11) * 0x1.0p-53;
+         return (lo*(1.0-u)+hi*u);
+}
+
+typedef struct {
+        const char * name;
+        int32_t kind;
+        double  lo,hi;       // x, Re z or cos(theta)
+        double  ihi;         // Im z in [0,ihi]
+        int32_t nmax;
+        int32_t nn1,nn2;     // nnmax, or m and ampl
+} rwv_case_t;
+
+static const rwv_case_t rwv_cases[] = {
+        {"j x<=5",       RWV_K_J,    0.05,   5.0,  0.0,  12,  0, 0},
+        {"j x<=60",      RWV_K_J,    1.0,   60.0,  0.0,  80,  0, 0},
+        {"j x<=200",     RWV_K_J,   20.0,  200.0,  0.0, 240, 20, 0},
+        {"y x<=60",      RWV_K_Y,    0.5,   60.0,  0.0,  60,  0, 0},
+        {"j(z)",         RWV_K_JC,   0.1,   60.0,  5.0,  80,  0, 0},
+        {"psi,chi",      RWV_K_RIC,  0.5,   60.0,  0.0,  60,  0, 0},
+        {"psi(z)",       RWV_K_RICC, 0.1,   60.0,  1.0,  80, 30, 0},
+        {"d m=0",        RWV_K_D,   -1.0,    1.0,  0.0,  60,  0, 0},
+        {"d/sin m=1",    RWV_K_D,   -1.0,    1.0,  0.0,  60,  1, 1},
+        {"d m=5",        RWV_K_D,   -1.0,    1.0,  0.0,  60,  5, 0},
+        {"d/sin m=20",   RWV_K_D,   -1.0,    1.0,  0.0,  60, 20, 1}
+};
+
+#define RWV_VBATCH 256
+
+// Per order n, max_i |f(i,n) - g(i,n)| / max_i |g(i,n)| (NaN and Inf must
+// match).
+static double rwv_cmp(const double * __restrict f,
+                      const double * __restrict g,
+                      const int64_t m,
+                      const int32_t nmax,
+                      int64_t * __restrict im,
+                      int32_t * __restrict nm) {
+
+         double emax = 0.0;
+         int64_t i;
+         int32_t n;
+         for(n = 1; n <= nmax; ++n) {
+             const double * __restrict fn = &f[(int64_t)(n-1)*m];
+             const double * __restrict gn = &g[(int64_t)(n-1)*m];
+             double gmax = 0.0,e;
+             for(i = 0; i != m; ++i) if(isfinite(gn[i])) gmax = fmax(gmax,fabs(gn[i]));
+             for(i = 0; i != m; ++i) {
+                 if(!isfinite(gn[i]) || !isfinite(fn[i]))
+                    e = (isnan(gn[i]) == isnan(fn[i]) && (isnan(gn[i]) || gn[i] == fn[i])) ?
+                        0.0 : INFINITY;
+                 else
+                    e = (gmax > 0.0) ? fabs(fn[i]-gn[i])/gmax : fabs(fn[i]);
+                 if(!(e <= emax)) {
+                    emax = e;
+                    *im = i;
+                    *nm = n;
+                 }
+             }
+         }
+         return (emax);
+}
+
+int32_t rwv_vec_validate(FILE * __restrict fp,
+                         const int64_t npts,
+                         const uint64_t seed) {
+
+         const int32_t ncase = (int32_t)(sizeof(rwv_cases)/sizeof(rwv_cases[0]));
+         const int64_t ld = RWV_VBATCH;
+         double x[RWV_VBATCH],xi[RWV_VBATCH];
+         double *f,*g;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t c,k;
+         int64_t i,p;
+         if(NULL==fp || npts <= 0) return (-1);
+         f = (double*)malloc(16*(size_t)ld*240*sizeof(double));
+         if(NULL == f) return (-1);
+         g = f+8*ld*240;
+         fprintf(fp,"Riccati-Bessel / Wigner-d arrays vs scalar recurrences, ISA %d\n",
+                 vmath_get_isa());
+         for(c = 0; c != ncase; ++c) {
+             const rwv_case_t * __restrict cs = &rwv_cases[c];
+             const int32_t nmax = cs->nmax;
+             const int64_t sz = ld*nmax;
+             double emax = 0.0,xm = 0.0;
+             int32_t nm = 0;
+             for(p = 0; p < npts; p += RWV_VBATCH) {
+                 const int64_t m = (npts-p < RWV_VBATCH) ? npts-p : RWV_VBATCH;
+                 int64_t im = 0;
+                 int32_t nw = 0,nf;
+                 double e;
+                 for(i = 0; i != m; ++i) {
+                     x[i]  = rwv_draw(&s,cs->lo,cs->hi);
+                     xi[i] = rwv_draw(&s,0.0,cs->ihi);
+                 }
+                 if(cs->kind == RWV_K_D && m >= 2) {
+                    x[0] = 1.0;
+                    x[1] = -1.0;
+                 }
+                 switch(cs->kind) {
+                 case RWV_K_J:
+                      nf = 2;
+                      rwv_sphj_vec(x,m,nmax,cs->nn1,f,f+sz,m);
+                      rwv_tab_scalar.jr(x,m,nmax,cs->nn1,0,g,g+sz,m);
+                      break;
+                 case RWV_K_Y:
+                      nf = 2;
+                      rwv_sphy_vec(x,m,nmax,f,f+sz,m);
+                      rwv_tab_scalar.yr(x,m,nmax,0,g,g+sz,m);
+                      break;
+                 case RWV_K_JC:
+                      nf = 4;
+                      rwv_sphj_c_vec(x,xi,m,nmax,cs->nn1,f,f+sz,f+2*sz,f+3*sz,m);
+                      rwv_tab_scalar.jc(x,xi,m,nmax,cs->nn1,0,g,g+sz,g+2*sz,g+3*sz,m);
+                      break;
+                 case RWV_K_RIC:
+                      nf = 4;
+                      rwv_riccati_vec(x,m,nmax,cs->nn1,f,f+sz,f+2*sz,f+3*sz,m);
+                      rwv_tab_scalar.jr(x,m,nmax,cs->nn1,1,g,g+sz,m);
+                      rwv_tab_scalar.yr(x,m,nmax,1,g+2*sz,g+3*sz,m);
+                      break;
+                 case RWV_K_RICC:
+                      nf = 4;
+                      rwv_riccati_c_vec(x,xi,m,nmax,cs->nn1,f,f+sz,f+2*sz,f+3*sz,m);
+                      rwv_tab_scalar.jc(x,xi,m,nmax,cs->nn1,1,g,g+sz,g+2*sz,g+3*sz,m);
+                      break;
+                 default:
+                      nf = 2;
+                      rwv_wigner_d_vec(x,m,nmax,cs->nn1,cs->nn2,f,f+sz,m);
+                      rwv_tab_scalar.dw(x,m,nmax,cs->nn1,cs->nn2,g,g+sz,m);
+                      break;
+                 }
+                 for(k = 0; k != nf; ++k) {
+                     e = rwv_cmp(f+k*sz,g+k*sz,m,nmax,&im,&nw);
+                     if(!(e <= emax)) {
+                        emax = e;
+                        xm = x[im];
+                        nm = nw;
+                     }
+                 }
+             }
+             fprintf(fp,"%-12s %9lld pts  max err %.3e  (bound %.1e)  at x = %.17g, n = %d%s\n",
+                     cs->name,(long long)npts,emax,RWV_TOL,xm,nm,(emax <= RWV_TOL) ? "" : "  FAIL");
+             if(!(emax <= RWV_TOL)) ++nbad;
+         }
+         // Wronskian j_n y_{n-1} - j_{n-1} y_n = 1/x^2 of the drivers.
+         {
+             const int32_t nmax = 60;
+             const int64_t sz = ld*nmax;
+             double emax = 0.0,xm = 0.0;
+             int32_t nm = 0;
+             for(p = 0; p < npts; p += RWV_VBATCH) {
+                 const int64_t m = (npts-p < RWV_VBATCH) ? npts-p : RWV_VBATCH;
+                 int32_t n;
+                 for(i = 0; i != m; ++i) x[i] = rwv_draw(&s,0.5,60.0);
+                 rwv_sphj_vec(x,m,nmax,0,f,f+sz,m);
+                 rwv_sphy_vec(x,m,nmax,g,g+sz,m);
+                 for(i = 0; i != m; ++i) {
+                     const double x2 = x[i]*x[i];
+                     double jp = sin(x[i])/x[i],yp = -cos(x[i])/x[i];
+                     for(n = 1; n <= nmax; ++n) {
+                         const double jn = f[(int64_t)(n-1)*m+i];
+                         const double yn = g[(int64_t)(n-1)*m+i];
+                         const double e  = fabs((jn*yp-jp*yn)*x2-1.0);
+                         if(!(e <= emax)) {
+                            emax = e;
+                            xm = x[i];
+                            nm = n;
+                         }
+                         jp = jn;
+                         yp = yn;
+                     }
+                 }
+             }
+             fprintf(fp,"%-12s %9lld pts  max err %.3e  (bound %.1e)  at x = %.17g, n = %d%s\n",
+                     "Wronskian",(long long)npts,emax,RWV_TOL,xm,nm,(emax <= RWV_TOL) ? "" : "  FAIL");
+             if(!(emax <= RWV_TOL)) ++nbad;
+         }
+         free(f);
+         return (nbad);
+}
@@ -0,0 +1,160 @@
+
+
+#ifndef __GMS_RICCATI_WIGNER_VEC_H__
+#define __GMS_RICCATI_WIGNER_VEC_H__ 191020260200
+
+//
+// Spherical Bessel, Riccati-Bessel and Wigner-d functions of the T-matrix
+// codes (GMS_mod_tmatrix.f90, GMS_mod_tmatrix_mps.f90) over arrays of
+// arguments: sizes, wavelengths or angles run in the lanes of AVX512
+// registers, orders run in the recurrences.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 02:00 AM +00200
+//
+// The recurrences are those of RJB, RYB, CJB, VIG and VIGAMPL:
+//   - j_n(x) and j_n(z), z complex: downward recurrence of the ratios
+//     j_n/j_{n-1} from order L = nmax+nnmax, then j_n = j_0 times the
+//     ratios (stable for n > x). nnmax <= 0 selects
+//     L = nmax + 1.1*max|x| + 10 over the lanes of each vector. j_0 is
+//     sin(z)/z (RJB and CJB take it from the ratio j_0/j_{-1}).
+//   - y_n(x): upward recurrence from y_0, y_1 (stable).
+//   - u_n = (1/x) d/dx [x f_n(x)] = f_{n-1} - n f_n/x for f = j, y.
+//   - d^n_{0m}(theta) and d/dtheta of it, upward in n from n = m.
+//     ampl != 0 divides d by sin(theta) (VIGAMPL). The closed forms at
+//     |cos(theta)| = 1 replace the 1/sin(theta) of the recurrence.
+// The scalar functions run the same operations one argument at a time
+// and are the fallback of the drivers. sin/cos are the VMATH_U10 kernels
+// of GMS_vmath.h (<= 1 ULP), cosh/sinh of Im z come from libm. The AVX512
+// downward recurrences take 1/x by rcp14 and two Newton steps.
+// The ISA is the one of vmath_get_isa(). Blocks of RWV_BLOCK arguments
+// run in parallel (OpenMP) when nx*nmax >= RWV_OMP_MIN.
+//
+// Output arrays are column-major, f(i,n) at f[(n-1)*ld + i], i < nx,
+// n = 1..nmax: the Fortran arrays f(ld,nmax), e.g. the /CBESS/ arrays of
+// BESS with ld = NPNG2. Arguments (x, Re z) must be > 0.
+// Results agree with the scalar recurrences within RWV_TOL relative to
+// max|f(:,n)| of each order (rwv_vec_validate measures it).
+// Return values: 0 success, -1 invalid argument.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Arguments per parallel block.
+#if !defined(RWV_BLOCK)
+#define RWV_BLOCK 64
+#endif
+
+// Smallest nx*nmax that runs the blocks in parallel.
+#if !defined(RWV_OMP_MIN)
+#define RWV_OMP_MIN 65536
+#endif
+
+// Documented agreement with the scalar recurrences.
+#define RWV_TOL 1.0e-12
+
+
+// j(i,n) = j_n(x[i]), u(i,n) = (1/x) d/dx [x j_n(x)] at x[i]   (RJB)
+int32_t rwv_sphj_vec(const double * __restrict,   // x
+                     const int64_t,               // nx
+                     const int32_t,               // nmax
+                     const int32_t,               // nnmax
+                     double * __restrict,         // j
+                     double * __restrict,         // u
+                     const int64_t)               // ld
+                                        __attribute__((hot));
+
+// y(i,n) = y_n(x[i]), v(i,n) = (1/x) d/dx [x y_n(x)] at x[i]   (RYB)
+int32_t rwv_sphy_vec(const double * __restrict,   // x
+                     const int64_t,               // nx
+                     const int32_t,               // nmax
+                     double * __restrict,         // y
+                     double * __restrict,         // v
+                     const int64_t)               // ld
+                                        __attribute__((hot));
+
+// j_n and (1/z) d/dz [z j_n(z)] of z = xr[i] + i*xi[i]   (CJB)
+int32_t rwv_sphj_c_vec(const double * __restrict, // xr
+                       const double * __restrict, // xi
+                       const int64_t,             // nx
+                       const int32_t,             // nmax
+                       const int32_t,             // nnmax
+                       double * __restrict,       // jr
+                       double * __restrict,       // ji
+                       double * __restrict,       // ur
+                       double * __restrict,       // ui
+                       const int64_t)             // ld
+                                        __attribute__((hot));
+
+// All the arrays of BESS in one pass: j, y, dj, dy of x and jr, ji, djr,
+// dji of xr + i*xi (nnmax1 for x, nnmax2 for the complex argument).
+int32_t rwv_bess_vec(const double * __restrict,   // x
+                     const double * __restrict,   // xr
+                     const double * __restrict,   // xi
+                     const int64_t,               // nx
+                     const int32_t,               // nmax
+                     const int32_t,               // nnmax1
+                     const int32_t,               // nnmax2
+                     double * __restrict,         // j
+                     double * __restrict,         // y
+                     double * __restrict,         // jr
+                     double * __restrict,         // ji
+                     double * __restrict,         // dj
+                     double * __restrict,         // dy
+                     double * __restrict,         // djr
+                     double * __restrict,         // dji
+                     const int64_t)               // ld
+                                        __attribute__((hot));
+
+// Riccati-Bessel functions of real x:
+//   psi_n = x j_n(x), chi_n = x y_n(x), xi_n = psi_n + i*chi_n = x h1_n(x)
+// and their derivatives d/dx.
+int32_t rwv_riccati_vec(const double * __restrict,   // x
+                        const int64_t,               // nx
+                        const int32_t,               // nmax
+                        const int32_t,               // nnmax
+                        double * __restrict,         // psi
+                        double * __restrict,         // dpsi
+                        double * __restrict,         // chi
+                        double * __restrict,         // dchi
+                        const int64_t)               // ld
+                                        __attribute__((hot));
+
+// psi_n(z) = z j_n(z) and d/dz psi_n(z) of z = xr[i] + i*xi[i] (m*x of Mie).
+int32_t rwv_riccati_c_vec(const double * __restrict, // xr
+                          const double * __restrict, // xi
+                          const int64_t,             // nx
+                          const int32_t,             // nmax
+                          const int32_t,             // nnmax
+                          double * __restrict,       // psir
+                          double * __restrict,       // psii
+                          double * __restrict,       // dpsir
+                          double * __restrict,       // dpsii
+                          const int64_t)             // ld
+                                        __attribute__((hot));
+
+// dv1(i,n) = d^n_{0m}(theta_i) (/sin(theta_i) when ampl != 0),
+// dv2(i,n) = d/dtheta d^n_{0m}(theta_i), x[i] = cos(theta_i) in [-1,1],
+// zero for n < m.   (VIG, VIGAMPL)
+int32_t rwv_wigner_d_vec(const double * __restrict,  // x
+                         const int64_t,              // nx
+                         const int32_t,              // nmax
+                         const int32_t,              // m >= 0
+                         const int32_t,              // ampl
+                         double * __restrict,        // dv1
+                         double * __restrict,        // dv2
+                         const int64_t)              // ld
+                                        __attribute__((hot));
+
+// Compares the drivers with the scalar recurrences (npts random arguments
+// per case, seeded) and checks the Wronskian j_n y_{n-1} - j_{n-1} y_n =
+// 1/x^2; prints one line per case and returns the number over RWV_TOL.
+int32_t rwv_vec_validate(FILE * __restrict,
+                         const int64_t,      // npts
+                         const uint64_t);    // seed
+
+
+
+
+#endif /*__GMS_RICCATI_WIGNER_VEC_H__*/
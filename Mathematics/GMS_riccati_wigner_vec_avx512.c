@@ -0,0 +1,361 @@
+
+
+//
+// AVX512 kernels of the Riccati-Bessel and Wigner-d array functions
+// (GMS_riccati_wigner_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 02:00 AM +00200
+//
+// Eight arguments per register. The downward recurrences carry RWV_IL
+// registers at once so that the divisions of independent lanes overlap;
+// they share the start order of the largest argument of the group.
+// Contraction is disabled so the kernels round like the scalar ones,
+// except for the reciprocals of the downward recurrences (vd_rcp).
+//
+
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+
+#include <immintrin.h>
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include "GMS_vmath.h"
+#include "GMS_riccati_wigner_vec_private.h"
+
+
+// Registers per group of the downward recurrences.
+#if !defined(RWV_IL)
+#define RWV_IL 4
+#endif
+
+typedef __m512d  vd;
+typedef __mmask8 md;
+
+#define VD_W 8
+
+#define RW_PRIM static inline __attribute__((always_inline))
+
+
+RW_PRIM vd vd_c(const double c)                  { return _mm512_set1_pd(c); }
+RW_PRIM vd vd_add(const vd a, const vd b)        { return _mm512_add_pd(a,b); }
+RW_PRIM vd vd_sub(const vd a, const vd b)        { return _mm512_sub_pd(a,b); }
+RW_PRIM vd vd_mul(const vd a, const vd b)        { return _mm512_mul_pd(a,b); }
+RW_PRIM vd vd_div(const vd a, const vd b)        { return _mm512_div_pd(a,b); }
+// 1/d: rcp14 and two Newton steps (about 1 ULP); the divider would bound
+// the downward recurrences.
+RW_PRIM vd vd_rcp(const vd d) {
+        const vd one = _mm512_set1_pd(1.0);
+        vd r = _mm512_rcp14_pd(d);
+        r = _mm512_fmadd_pd(r,_mm512_fnmadd_pd(d,r,one),r);
+        return (_mm512_fmadd_pd(r,_mm512_fnmadd_pd(d,r,one),r));
+}
+RW_PRIM vd vd_abs(const vd x)                    { return _mm512_abs_pd(x); }
+RW_PRIM vd vd_neg(const vd x) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x),
+                                   _mm512_set1_epi64(INT64_MIN)));
+}
+// Masked-off lanes read 1.0 (a valid argument) and are not written.
+RW_PRIM md vd_tail(const int64_t r) {
+        return (md)((r >= VD_W) ? 0xFF : ((1U << r)-1U));
+}
+RW_PRIM vd vd_load(const md k, const double * __restrict p) {
+        return _mm512_mask_loadu_pd(vd_c(1.0),k,p);
+}
+RW_PRIM void vd_store(double * __restrict p, const md k, const vd x) {
+        _mm512_mask_storeu_pd(p,k,x);
+}
+RW_PRIM double vd_hmax(const vd x)               { return _mm512_reduce_max_pd(x); }
+RW_PRIM void vd_sincos(const vd x, vd * __restrict s, vd * __restrict c) {
+        vmath_sincos_zmm8r8(x,s,c,VMATH_U10);
+}
+
+
+/*
+     j_n(x), u_n(x)
+*/
+static void rwv_jr_avx512(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          const int32_t ric,
+                          double * __restrict j,
+                          double * __restrict u,
+                          const int64_t ld) {
+
+        int64_t i0;
+        for(i0 = 0; i0 < m; i0 += RWV_IL*VD_W) {
+            vd xv[RWV_IL],xx[RWV_IL],z[RWV_IL],jp[RWV_IL],j1[RWV_IL],sc[RWV_IL];
+            md km[RWV_IL],bg[RWV_IL];
+            double amax = 0.0;
+            int32_t nv = 0,v,k,l;
+            for(v = 0; v != RWV_IL && i0+v*VD_W < m; ++v) {
+                km[v] = vd_tail(m-i0-v*VD_W);
+                xv[v] = vd_load(km[v],&x[i0+v*VD_W]);
+                xx[v] = vd_div(vd_c(1.0),xv[v]);
+                sc[v] = ric ? xv[v] : vd_c(1.0);
+                amax  = fmax(amax,vd_hmax(xv[v]));
+                nv    = v+1;
+            }
+            l = rwv_start(nmax,nnmax,amax);
+            for(v = 0; v != nv; ++v)
+                z[v] = vd_div(vd_c(1.0),vd_mul(vd_c((double)(2*l+1)),xx[v]));
+            for(k = l-1; k > nmax; --k) {
+                const vd ck = vd_c((double)(2*k+1));
+                for(v = 0; v != nv; ++v)
+                    z[v] = vd_rcp(vd_sub(vd_mul(ck,xx[v]),z[v]));
+            }
+            for(k = nmax; k >= 1; --k) {
+                const vd ck = vd_c((double)(2*k+1));
+                double * __restrict jk = &j[(int64_t)(k-1)*ld+i0];
+                for(v = 0; v != nv; ++v) {
+                    z[v] = vd_rcp(vd_sub(vd_mul(ck,xx[v]),z[v]));
+                    vd_store(jk+v*VD_W,km[v],z[v]);
+                }
+            }
+            for(v = 0; v != nv; ++v) {
+                vd s,c;
+                vd_sincos(xv[v],&s,&c);
+                jp[v] = vd_mul(s,xx[v]);
+                j1[v] = vd_mul(vd_sub(jp[v],c),xx[v]);
+                bg[v] = _mm512_cmp_pd_mask(vd_abs(j1[v]),vd_abs(jp[v]),_CMP_GT_OQ);
+            }
+            for(k = 1; k <= nmax; ++k) {
+                const vd qk = vd_c((double)k);
+                const int64_t o = (int64_t)(k-1)*ld+i0;
+                for(v = 0; v != nv; ++v) {
+                    const vd r  = vd_load(km[v],&j[o+v*VD_W]);
+                    const vd jk = (k == 1) ? _mm512_mask_blend_pd(bg[v],vd_mul(jp[v],r),j1[v])
+                                           : vd_mul(jp[v],r);
+                    vd_store(&u[o+v*VD_W],km[v],
+                             vd_mul(vd_sub(jp[v],vd_mul(vd_mul(qk,jk),xx[v])),sc[v]));
+                    vd_store(&j[o+v*VD_W],km[v],vd_mul(jk,sc[v]));
+                    jp[v] = jk;
+                }
+            }
+        }
+}
+
+
+/*
+     y_n(x), v_n(x)
+*/
+static void rwv_yr_avx512(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t ric,
+                          double * __restrict y,
+                          double * __restrict v,
+                          const int64_t ld) {
+
+        int64_t i;
+        for(i = 0; i < m; i += VD_W) {
+            const md km = vd_tail(m-i);
+            const vd xv = vd_load(km,&x[i]);
+            const vd x1 = vd_div(vd_c(1.0),xv);
+            const vd sc = ric ? xv : vd_c(1.0);
+            vd s,c,yp,yk,yn;
+            int32_t k;
+            vd_sincos(xv,&s,&c);
+            yp = vd_mul(vd_neg(c),x1);
+            yk = vd_sub(vd_mul(vd_mul(vd_neg(c),x1),x1),vd_mul(s,x1));
+            for(k = 1; k <= nmax; ++k) {
+                const int64_t o = (int64_t)(k-1)*ld+i;
+                vd_store(&y[o],km,vd_mul(yk,sc));
+                vd_store(&v[o],km,vd_mul(vd_sub(yp,vd_mul(vd_mul(vd_c((double)k),x1),yk)),sc));
+                yn = vd_sub(vd_mul(vd_mul(vd_c((double)(2*k+1)),x1),yk),yp);
+                yp = yk;
+                yk = yn;
+            }
+        }
+}
+
+
+/*
+     j_n(z), u_n(z)
+*/
+static void rwv_jc_avx512(const double * __restrict xr,
+                          const double * __restrict xi,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          const int32_t ric,
+                          double * __restrict jr,
+                          double * __restrict ji,
+                          double * __restrict ur,
+                          double * __restrict ui,
+                          const int64_t ld) {
+
+        int64_t i0;
+        for(i0 = 0; i0 < m; i0 += RWV_IL*VD_W) {
+            vd zr[RWV_IL],zi[RWV_IL],cr[RWV_IL],ci[RWV_IL];
+            vd czr[RWV_IL],czi[RWV_IL],pr[RWV_IL],pi[RWV_IL],j1r[RWV_IL],j1i[RWV_IL];
+            md km[RWV_IL],bg[RWV_IL];
+            double amax = 0.0;
+            int32_t nv = 0,v,k,l;
+            for(v = 0; v != RWV_IL && i0+v*VD_W < m; ++v) {
+                vd r2;
+                km[v] = vd_tail(m-i0-v*VD_W);
+                zr[v] = vd_load(km[v],&xr[i0+v*VD_W]);
+                zi[v] = _mm512_maskz_loadu_pd(km[v],&xi[i0+v*VD_W]);
+                r2    = vd_add(vd_mul(zr[v],zr[v]),vd_mul(zi[v],zi[v]));
+                amax  = fmax(amax,vd_hmax(r2));
+                r2    = vd_div(vd_c(1.0),r2);
+                cr[v] = vd_mul(zr[v],r2);
+                ci[v] = vd_mul(vd_neg(zi[v]),r2);
+                nv    = v+1;
+            }
+            l = rwv_start(nmax,nnmax,sqrt(amax));
+            {
+                const vd qf = vd_c(1.0/(double)(2*l+1));
+                for(v = 0; v != nv; ++v) {
+                    czr[v] = vd_mul(zr[v],qf);
+                    czi[v] = vd_mul(zi[v],qf);
+                }
+            }
+            for(k = l-1; k >= 1; --k) {
+                const vd ck = vd_c((double)(2*k+1));
+                for(v = 0; v != nv; ++v) {
+                    const vd ar = vd_sub(vd_mul(ck,cr[v]),czr[v]);
+                    const vd ai = vd_sub(vd_mul(ck,ci[v]),czi[v]);
+                    const vd d  = vd_rcp(vd_add(vd_mul(ar,ar),vd_mul(ai,ai)));
+                    czr[v] = vd_mul(ar,d);
+                    czi[v] = vd_mul(vd_neg(ai),d);
+                }
+                if(k <= nmax) {
+                   const int64_t o = (int64_t)(k-1)*ld+i0;
+                   for(v = 0; v != nv; ++v) {
+                       vd_store(&jr[o+v*VD_W],km[v],czr[v]);
+                       vd_store(&ji[o+v*VD_W],km[v],czi[v]);
+                   }
+                }
+            }
+            // j_0 = sin(z)/z, j_1 = (j_0 - cos(z))/z; cosh, sinh of Im z per
+            // lane from libm. The larger of j_0, j_1 normalizes the ratios.
+            for(v = 0; v != nv; ++v) {
+                double __attribute__((aligned(64))) t[VD_W],ch[VD_W],sh[VD_W];
+                vd s,c,sr,si,ar,ai;
+                int32_t q;
+                _mm512_store_pd(t,zi[v]);
+                for(q = 0; q != VD_W; ++q) {
+                    ch[q] = cosh(t[q]);
+                    sh[q] = sinh(t[q]);
+                }
+                vd_sincos(zr[v],&s,&c);
+                sr = vd_mul(s,_mm512_load_pd(ch));
+                si = vd_mul(c,_mm512_load_pd(sh));
+                pr[v] = vd_sub(vd_mul(sr,cr[v]),vd_mul(si,ci[v]));
+                pi[v] = vd_add(vd_mul(si,cr[v]),vd_mul(sr,ci[v]));
+                ar = vd_sub(pr[v],vd_mul(c,_mm512_load_pd(ch)));
+                ai = vd_add(pi[v],vd_mul(s,_mm512_load_pd(sh)));
+                j1r[v] = vd_sub(vd_mul(ar,cr[v]),vd_mul(ai,ci[v]));
+                j1i[v] = vd_add(vd_mul(ai,cr[v]),vd_mul(ar,ci[v]));
+                bg[v]  = _mm512_cmp_pd_mask(vd_add(vd_mul(j1r[v],j1r[v]),vd_mul(j1i[v],j1i[v])),
+                                            vd_add(vd_mul(pr[v],pr[v]),vd_mul(pi[v],pi[v])),
+                                            _CMP_GT_OQ);
+            }
+            for(k = 1; k <= nmax; ++k) {
+                const vd qk = vd_c((double)k);
+                const int64_t o = (int64_t)(k-1)*ld+i0;
+                for(v = 0; v != nv; ++v) {
+                    const md kv = km[v];
+                    const vd rr = _mm512_maskz_loadu_pd(kv,&jr[o+v*VD_W]);
+                    const vd ri = _mm512_maskz_loadu_pd(kv,&ji[o+v*VD_W]);
+                    vd qr = vd_sub(vd_mul(pr[v],rr),vd_mul(pi[v],ri));
+                    vd qi = vd_add(vd_mul(pi[v],rr),vd_mul(pr[v],ri));
+                    if(k == 1) {
+                       qr = _mm512_mask_blend_pd(bg[v],qr,j1r[v]);
+                       qi = _mm512_mask_blend_pd(bg[v],qi,j1i[v]);
+                    }
+                    const vd ar = vd_sub(vd_mul(qr,cr[v]),vd_mul(qi,ci[v]));
+                    const vd ai = vd_add(vd_mul(qi,cr[v]),vd_mul(qr,ci[v]));
+                    const vd wr = vd_sub(pr[v],vd_mul(qk,ar));
+                    const vd wi = vd_sub(pi[v],vd_mul(qk,ai));
+                    if(ric) {
+                       vd_store(&jr[o+v*VD_W],kv,vd_sub(vd_mul(qr,zr[v]),vd_mul(qi,zi[v])));
+                       vd_store(&ji[o+v*VD_W],kv,vd_add(vd_mul(qi,zr[v]),vd_mul(qr,zi[v])));
+                       vd_store(&ur[o+v*VD_W],kv,vd_sub(vd_mul(wr,zr[v]),vd_mul(wi,zi[v])));
+                       vd_store(&ui[o+v*VD_W],kv,vd_add(vd_mul(wi,zr[v]),vd_mul(wr,zi[v])));
+                    } else {
+                       vd_store(&jr[o+v*VD_W],kv,qr);
+                       vd_store(&ji[o+v*VD_W],kv,qi);
+                       vd_store(&ur[o+v*VD_W],kv,wr);
+                       vd_store(&ui[o+v*VD_W],kv,wi);
+                    }
+                    pr[v] = qr;
+                    pi[v] = qi;
+                }
+            }
+        }
+}
+
+
+/*
+     d^n_{0m}(theta): orders in the outer loop, so the coefficients of
+     each order are computed once per RWV_BLOCK angles.
+*/
+static void rwv_dw_avx512(const double * __restrict x,
+                          const int64_t m,
+                          const int32_t nmax,
+                          const int32_t mm,
+                          const int32_t ampl,
+                          double * __restrict dv1,
+                          double * __restrict dv2,
+                          const int64_t ld) {
+
+        const double a0 = rwv_dstart(mm);
+        int64_t i0;
+        int32_t n;
+        for(n = 1; n < mm && n <= nmax; ++n) {
+            memset(&dv1[(int64_t)(n-1)*ld],0,(size_t)m*sizeof(double));
+            memset(&dv2[(int64_t)(n-1)*ld],0,(size_t)m*sizeof(double));
+        }
+        for(i0 = 0; i0 < m; i0 += RWV_BLOCK) {
+            const int64_t mb = (m-i0 < RWV_BLOCK) ? m-i0 : RWV_BLOCK;
+            const int32_t nv = (int32_t)((mb+VD_W-1)/VD_W);
+            vd xv[RWV_BLOCK/VD_W],qs1[RWV_BLOCK/VD_W];
+            vd d1[RWV_BLOCK/VD_W],d2[RWV_BLOCK/VD_W];
+            md km[RWV_BLOCK/VD_W];
+            int32_t pl[RWV_BLOCK];
+            int32_t np = 0,v,k,q;
+            for(v = 0; v != nv; ++v) {
+                const vd a = vd_c(1.0);
+                vd qs;
+                km[v]  = vd_tail(mb-v*VD_W);
+                xv[v]  = _mm512_maskz_loadu_pd(km[v],&x[i0+v*VD_W]);
+                qs     = _mm512_sqrt_pd(vd_sub(a,vd_mul(xv[v],xv[v])));
+                qs1[v] = vd_div(a,qs);
+                d1[v]  = _mm512_setzero_pd();
+                d2[v]  = vd_c(a0);
+                for(k = 0; k != mm; ++k) d2[v] = vd_mul(d2[v],qs);
+            }
+            for(q = 0; q != (int32_t)mb; ++q)
+                if(fabs(1.0-fabs(x[i0+q])) <= RWV_POLE) pl[np++] = q;
+            for(n = mm; n <= nmax; ++n) {
+                const rwv_dcoef_t c = rwv_dcoef(n,mm);
+                const vd ca = vd_c(c.a),cb = vd_c(c.b),ce = vd_c(c.e),cf = vd_c(c.f);
+                const int64_t o = (int64_t)(n-1)*ld+i0;
+                for(v = 0; v != nv; ++v) {
+                    const vd d3 = vd_sub(vd_mul(vd_mul(ca,xv[v]),d2[v]),vd_mul(cb,d1[v]));
+                    if(n >= 1) {
+                       vd_store(&dv1[o+v*VD_W],km[v],ampl ? vd_mul(d2[v],qs1[v]) : d2[v]);
+                       vd_store(&dv2[o+v*VD_W],km[v],
+                                vd_mul(qs1[v],vd_sub(vd_mul(ce,d3),vd_mul(cf,d1[v]))));
+                    }
+                    d1[v] = d2[v];
+                    d2[v] = d3;
+                }
+                if(n >= 1)
+                   for(q = 0; q != np; ++q)
+                       rwv_dpole(x[i0+pl[q]],n,mm,ampl,&dv1[o+pl[q]],&dv2[o+pl[q]]);
+            }
+        }
+}
+
+
+const rwv_isa_tab_t rwv_tab_avx512 = {
+        rwv_jr_avx512,
+        rwv_yr_avx512,
+        rwv_jc_avx512,
+        rwv_dw_avx512
+};
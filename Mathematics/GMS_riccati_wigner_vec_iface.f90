@@ -0,0 +1,258 @@
+
+
+module riccati_wigner_vec_iface
+
+
+!===========================================================!
+! Interfaces to the spherical Bessel, Riccati-Bessel and    !
+! Wigner-d array functions GMS_riccati_wigner_vec.c         !
+! (AVX512 lanes over sizes or angles, OpenMP blocks).       !
+! Outputs f(ld,nmax): f(i,n) of argument i and order n,     !
+! e.g. the /CBESS/ arrays of BESS with ld = NPNG2.          !
+! stat: 0 success, -1 invalid argument.                     !
+!===========================================================!
+
+
+use, intrinsic :: ISO_C_BINDING
+implicit none
+public
+
+
+#if 0
+int32_t rwv_sphj_vec(const double * __restrict x,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     const int32_t nnmax,
+                     double * __restrict j,
+                     double * __restrict u,
+                     const int64_t ld);
+#endif
+
+interface
+
+   function rwv_sphj_vec(x,nx,nmax,nnmax,j,u,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_sphj_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: x
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: nnmax
+            real(c_double),  dimension(ld,*),    intent(out)        :: j
+            real(c_double),  dimension(ld,*),    intent(out)        :: u
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_sphy_vec(const double * __restrict x,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     double * __restrict y,
+                     double * __restrict v,
+                     const int64_t ld);
+#endif
+
+interface
+
+   function rwv_sphy_vec(x,nx,nmax,y,v,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_sphy_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: x
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            real(c_double),  dimension(ld,*),    intent(out)        :: y
+            real(c_double),  dimension(ld,*),    intent(out)        :: v
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_sphj_c_vec(const double * __restrict xr,
+                       const double * __restrict xi,
+                       const int64_t nx,
+                       const int32_t nmax,
+                       const int32_t nnmax,
+                       double * __restrict jr,
+                       double * __restrict ji,
+                       double * __restrict ur,
+                       double * __restrict ui,
+                       const int64_t ld);
+#endif
+
+interface
+
+   function rwv_sphj_c_vec(xr,xi,nx,nmax,nnmax,jr,ji,ur,ui,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_sphj_c_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: xr
+            real(c_double),  dimension(*),       intent(in)         :: xi
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: nnmax
+            real(c_double),  dimension(ld,*),    intent(out)        :: jr
+            real(c_double),  dimension(ld,*),    intent(out)        :: ji
+            real(c_double),  dimension(ld,*),    intent(out)        :: ur
+            real(c_double),  dimension(ld,*),    intent(out)        :: ui
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_bess_vec(const double * __restrict x,
+                     const double * __restrict xr,
+                     const double * __restrict xi,
+                     const int64_t nx,
+                     const int32_t nmax,
+                     const int32_t nnmax1,
+                     const int32_t nnmax2,
+                     double * __restrict j,
+                     double * __restrict y,
+                     double * __restrict jr,
+                     double * __restrict ji,
+                     double * __restrict dj,
+                     double * __restrict dy,
+                     double * __restrict djr,
+                     double * __restrict dji,
+                     const int64_t ld);
+#endif
+
+interface
+
+   function rwv_bess_vec(x,xr,xi,nx,nmax,nnmax1,nnmax2,j,y,jr,ji,dj,dy,djr,dji,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_bess_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: x
+            real(c_double),  dimension(*),       intent(in)         :: xr
+            real(c_double),  dimension(*),       intent(in)         :: xi
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: nnmax1
+            integer(c_int32_t),                  intent(in), value  :: nnmax2
+            real(c_double),  dimension(ld,*),    intent(out)        :: j
+            real(c_double),  dimension(ld,*),    intent(out)        :: y
+            real(c_double),  dimension(ld,*),    intent(out)        :: jr
+            real(c_double),  dimension(ld,*),    intent(out)        :: ji
+            real(c_double),  dimension(ld,*),    intent(out)        :: dj
+            real(c_double),  dimension(ld,*),    intent(out)        :: dy
+            real(c_double),  dimension(ld,*),    intent(out)        :: djr
+            real(c_double),  dimension(ld,*),    intent(out)        :: dji
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_riccati_vec(const double * __restrict x,
+                        const int64_t nx,
+                        const int32_t nmax,
+                        const int32_t nnmax,
+                        double * __restrict psi,
+                        double * __restrict dpsi,
+                        double * __restrict chi,
+                        double * __restrict dchi,
+                        const int64_t ld);
+#endif
+
+interface
+
+   function rwv_riccati_vec(x,nx,nmax,nnmax,psi,dpsi,chi,dchi,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_riccati_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: x
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: nnmax
+            real(c_double),  dimension(ld,*),    intent(out)        :: psi
+            real(c_double),  dimension(ld,*),    intent(out)        :: dpsi
+            real(c_double),  dimension(ld,*),    intent(out)        :: chi
+            real(c_double),  dimension(ld,*),    intent(out)        :: dchi
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_riccati_c_vec(const double * __restrict xr,
+                          const double * __restrict xi,
+                          const int64_t nx,
+                          const int32_t nmax,
+                          const int32_t nnmax,
+                          double * __restrict psir,
+                          double * __restrict psii,
+                          double * __restrict dpsir,
+                          double * __restrict dpsii,
+                          const int64_t ld);
+#endif
+
+interface
+
+   function rwv_riccati_c_vec(xr,xi,nx,nmax,nnmax,psir,psii,dpsir,dpsii,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_riccati_c_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: xr
+            real(c_double),  dimension(*),       intent(in)         :: xi
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: nnmax
+            real(c_double),  dimension(ld,*),    intent(out)        :: psir
+            real(c_double),  dimension(ld,*),    intent(out)        :: psii
+            real(c_double),  dimension(ld,*),    intent(out)        :: dpsir
+            real(c_double),  dimension(ld,*),    intent(out)        :: dpsii
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t rwv_wigner_d_vec(const double * __restrict x,
+                         const int64_t nx,
+                         const int32_t nmax,
+                         const int32_t m,
+                         const int32_t ampl,
+                         double * __restrict dv1,
+                         double * __restrict dv2,
+                         const int64_t ld);
+#endif
+
+interface
+
+   function rwv_wigner_d_vec(x,nx,nmax,m,ampl,dv1,dv2,ld) &
+                      result(stat)                   &
+                      bind(c,name='rwv_wigner_d_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int64_t),                  intent(in), value  :: ld
+            real(c_double),  dimension(*),       intent(in)         :: x
+            integer(c_int64_t),                  intent(in), value  :: nx
+            integer(c_int32_t),                  intent(in), value  :: nmax
+            integer(c_int32_t),                  intent(in), value  :: m
+            integer(c_int32_t),                  intent(in), value  :: ampl
+            real(c_double),  dimension(ld,*),    intent(out)        :: dv1
+            real(c_double),  dimension(ld,*),    intent(out)        :: dv2
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+end module riccati_wigner_vec_iface
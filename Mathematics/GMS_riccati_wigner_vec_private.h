@@ -0,0 +1,130 @@
+
+
+#ifndef __GMS_RICCATI_WIGNER_VEC_PRIVATE_H__
+#define __GMS_RICCATI_WIGNER_VEC_PRIVATE_H__
+
+//
+// Kernel tables of the Riccati-Bessel and Wigner-d array functions
+// (GMS_riccati_wigner_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 02:00 AM +00200
+//
+
+#include <stdint.h>
+#include "GMS_riccati_wigner_vec.h"
+
+
+// |1 - |cos(theta)|| at or below which the closed forms are used (VIGAMPL).
+#define RWV_POLE 1.0e-10
+
+// Kernels over m arguments; outputs at f[(n-1)*ld + i]. ric != 0 scales
+// the results by the argument (Riccati-Bessel functions).
+typedef void (*rwv_jr_fn)(const double * __restrict,   // x
+                          const int64_t,               // m
+                          const int32_t,               // nmax
+                          const int32_t,               // nnmax
+                          const int32_t,               // ric
+                          double * __restrict,         // j
+                          double * __restrict,         // u
+                          const int64_t);              // ld
+
+typedef void (*rwv_yr_fn)(const double * __restrict,   // x
+                          const int64_t,
+                          const int32_t,               // nmax
+                          const int32_t,               // ric
+                          double * __restrict,         // y
+                          double * __restrict,         // v
+                          const int64_t);
+
+typedef void (*rwv_jc_fn)(const double * __restrict,   // xr
+                          const double * __restrict,   // xi
+                          const int64_t,
+                          const int32_t,               // nmax
+                          const int32_t,               // nnmax
+                          const int32_t,               // ric
+                          double * __restrict,         // jr
+                          double * __restrict,         // ji
+                          double * __restrict,         // ur
+                          double * __restrict,         // ui
+                          const int64_t);
+
+typedef void (*rwv_dw_fn)(const double * __restrict,   // x = cos(theta)
+                          const int64_t,
+                          const int32_t,               // nmax
+                          const int32_t,               // m
+                          const int32_t,               // ampl
+                          double * __restrict,         // dv1
+                          double * __restrict,         // dv2
+                          const int64_t);
+
+typedef struct {
+        rwv_jr_fn jr;
+        rwv_yr_fn yr;
+        rwv_jc_fn jc;
+        rwv_dw_fn dw;
+} rwv_isa_tab_t;
+
+extern const rwv_isa_tab_t rwv_tab_scalar;
+extern const rwv_isa_tab_t rwv_tab_avx512;
+
+// Start order of the downward recurrences of an argument of modulus ax.
+static inline int32_t rwv_start(const int32_t nmax,
+                                const int32_t nnmax,
+                                const double ax) {
+        return ((nnmax > 0) ? nmax+nnmax : nmax+(int32_t)(1.1*ax)+10);
+}
+
+// Per-order coefficients of the d^n_{0m} recurrence (n = m..nmax):
+//   d_{n+1} = a x d_n - b d_{n-1},  d' = (e d_{n+1} - f d_{n-1})/sin(theta)
+typedef struct {
+        double a,b,e,f;
+} rwv_dcoef_t;
+
+static inline rwv_dcoef_t rwv_dcoef(const int32_t n,
+                                    const int32_t m) {
+        const double qn   = (double)n;
+        const double qn1  = (double)(n+1);
+        const double qn2  = (double)(2*n+1);
+        const double qmm  = (double)m*(double)m;
+        const double qnm  = __builtin_sqrt(qn*qn-qmm);
+        const double qnm1 = __builtin_sqrt(qn1*qn1-qmm);
+        const double rq   = 1.0/qnm1;
+        rwv_dcoef_t c;
+        c.a = qn2*rq;
+        c.b = qnm*rq;
+        c.e = qn*qnm1/qn2;
+        c.f = qn1*qnm/qn2;
+        return (c);
+}
+
+// prod_{i=1..m} sqrt((2i-1)/(2i)): d^m_{0m} = this * sin(theta)^m.
+static inline double rwv_dstart(const int32_t m) {
+        double a = 1.0;
+        int32_t i;
+        for(i = 1; i <= m; ++i) a *= __builtin_sqrt((double)(2*i-1)/(double)(2*i));
+        return (a);
+}
+
+// Values at cos(theta) = +-1 (ampl: VIGAMPL; otherwise the limits of VIG).
+static inline void rwv_dpole(const double x,
+                             const int32_t n,
+                             const int32_t mm,
+                             const int32_t ampl,
+                             double * __restrict d1,
+                             double * __restrict d2) {
+        const double sg = (x < 0.0 && (n & 1)) ? -1.0 : 1.0;   // x^n
+        *d1 = 0.0;
+        *d2 = 0.0;
+        if(mm == 0) {
+           if(!ampl) *d1 = sg;
+        } else if(mm == 1) {
+           const double dn = 0.5*__builtin_sqrt((double)n*(double)(n+1));
+           *d2 = (x < 0.0) ? dn*sg : dn;
+           if(ampl) *d1 = (x < 0.0) ? -dn*sg : dn;
+        }
+}
+
+
+
+
+#endif /*__GMS_RICCATI_WIGNER_VEC_PRIVATE_H__*/
@@ -0,0 +1,849 @@
+
+
+#include <immintrin.h>
+#include <cpuid.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_blas1_autotune.h"
+#include "GMS_cpuid.h"
+
+
+// Implemented in GMS_cpuid_x86.c
+extern int get_cacheinfo(int, cache_info_t *);
+
+
+typedef void   (*at_axpy_fn)(const int32_t, const double,
+                             const double * __restrict, double * __restrict);
+typedef double (*at_dot_fn)(const int32_t,
+                            const double * __restrict, const double * __restrict);
+typedef void   (*at_scal_fn)(const int32_t, const double, double * __restrict);
+typedef void   (*at_copy_fn)(const int32_t,
+                             const double * __restrict, double * __restrict);
+
+typedef union {
+        at_axpy_fn axpy;
+        at_dot_fn  dot;
+        at_scal_fn scal;
+        at_copy_fn copy;
+} at_fn_t;
+
+// Host ISA levels a variant may require.
+#define AT_ISA_NONE 0x0
+#define AT_ISA_YMM  0x1  // AVX2 + FMA
+#define AT_ISA_ZMM  0x2  // AVX512F
+
+typedef struct {
+        const char * name;
+        int32_t      isa;
+        at_fn_t      fn;
+} at_variant_t;
+
+
+/*
+     Candidate kernels (unit stride).
+     One body per operation, instantiated for ymm/zmm and unroll 4/8/16.
+*/
+#define AT_YMM_ATTR   __attribute__((target("avx2,fma")))
+#define AT_YMM_VT     __m256d
+#define AT_YMM_W      4
+#define AT_YMM_LD     _mm256_loadu_pd
+#define AT_YMM_ST     _mm256_storeu_pd
+#define AT_YMM_FMA    _mm256_fmadd_pd
+#define AT_YMM_MUL    _mm256_mul_pd
+#define AT_YMM_ADD    _mm256_add_pd
+#define AT_YMM_SET1   _mm256_set1_pd
+#define AT_YMM_ZERO   _mm256_setzero_pd
+#define AT_YMM_HSUM   at_hsum_ymm
+
+#define AT_ZMM_ATTR   __attribute__((target("avx512f")))
+#define AT_ZMM_VT     __m512d
+#define AT_ZMM_W      8
+#define AT_ZMM_LD     _mm512_loadu_pd
+#define AT_ZMM_ST     _mm512_storeu_pd
+#define AT_ZMM_FMA    _mm512_fmadd_pd
+#define AT_ZMM_MUL    _mm512_mul_pd
+#define AT_ZMM_ADD    _mm512_add_pd
+#define AT_ZMM_SET1   _mm512_set1_pd
+#define AT_ZMM_ZERO   _mm512_setzero_pd
+#define AT_ZMM_HSUM   _mm512_reduce_add_pd
+
+
+static inline AT_YMM_ATTR
+double at_hsum_ymm(const __m256d v) {
+
+         __m128d t = _mm_add_pd(_mm256_castpd256_pd128(v),
+                                _mm256_extractf128_pd(v,1));
+         t = _mm_add_sd(t,_mm_unpackhi_pd(t,t));
+         return (_mm_cvtsd_f64(t));
+}
+
+
+#define AT_DEF_KERNELS(T,U)                                                     \
+static AT_##T##_ATTR __attribute__((noinline))                                  \
+void at_daxpy_##T##_u##U(const int32_t n,                                       \
+                         const double a,                                        \
+                         const double * __restrict x,                           \
+                         double * __restrict y) {                               \
+         const AT_##T##_VT va = AT_##T##_SET1(a);                               \
+         int32_t i = 0, j;                                                      \
+         for(; i+(U)*AT_##T##_W <= n; i += (U)*AT_##T##_W) {                    \
+             _Pragma("GCC unroll 16")                                           \
+             for(j = 0; j != (U); ++j) {                                        \
+                 const int32_t k = i+j*AT_##T##_W;                              \
+                 AT_##T##_ST(&y[k],AT_##T##_FMA(va,AT_##T##_LD(&x[k]),          \
+                                                   AT_##T##_LD(&y[k])));        \
+             }                                                                  \
+         }                                                                      \
+         for(; i+AT_##T##_W <= n; i += AT_##T##_W)                              \
+             AT_##T##_ST(&y[i],AT_##T##_FMA(va,AT_##T##_LD(&x[i]),              \
+                                               AT_##T##_LD(&y[i])));            \
+         for(; i != n; ++i) y[i] += a*x[i];                                     \
+}                                                                               \
+                                                                                \
+static AT_##T##_ATTR __attribute__((noinline))                                  \
+double at_ddot_##T##_u##U(const int32_t n,                                      \
+                          const double * __restrict x,                          \
+                          const double * __restrict y) {                        \
+         AT_##T##_VT acc[(U)];                                                  \
+         double s;                                                              \
+         int32_t i = 0, j;                                                      \
+         _Pragma("GCC unroll 16")                                               \
+         for(j = 0; j != (U); ++j) acc[j] = AT_##T##_ZERO();                    \
+         for(; i+(U)*AT_##T##_W <= n; i += (U)*AT_##T##_W) {                    \
+             _Pragma("GCC unroll 16")                                           \
+             for(j = 0; j != (U); ++j) {                                        \
+                 const int32_t k = i+j*AT_##T##_W;                              \
+                 acc[j] = AT_##T##_FMA(AT_##T##_LD(&x[k]),AT_##T##_LD(&y[k]),   \
+                                       acc[j]);                                 \
+             }                                                                  \
+         }                                                                      \
+         _Pragma("GCC unroll 16")                                               \
+         for(j = 1; j != (U); ++j) acc[0] = AT_##T##_ADD(acc[0],acc[j]);        \
+         for(; i+AT_##T##_W <= n; i += AT_##T##_W)                              \
+             acc[0] = AT_##T##_FMA(AT_##T##_LD(&x[i]),AT_##T##_LD(&y[i]),       \
+                                   acc[0]);                                     \
+         s = AT_##T##_HSUM(acc[0]);                                             \
+         for(; i != n; ++i) s += x[i]*y[i];                                     \
+         return (s);                                                            \
+}                                                                               \
+                                                                                \
+static AT_##T##_ATTR __attribute__((noinline))                                  \
+void at_dscal_##T##_u##U(const int32_t n,                                       \
+                         const double a,                                        \
+                         double * __restrict x) {                               \
+         const AT_##T##_VT va = AT_##T##_SET1(a);                               \
+         int32_t i = 0, j;                                                      \
+         for(; i+(U)*AT_##T##_W <= n; i += (U)*AT_##T##_W) {                    \
+             _Pragma("GCC unroll 16")                                           \
+             for(j = 0; j != (U); ++j) {                                        \
+                 const int32_t k = i+j*AT_##T##_W;                              \
+                 AT_##T##_ST(&x[k],AT_##T##_MUL(va,AT_##T##_LD(&x[k])));        \
+             }                                                                  \
+         }                                                                      \
+         for(; i+AT_##T##_W <= n; i += AT_##T##_W)                              \
+             AT_##T##_ST(&x[i],AT_##T##_MUL(va,AT_##T##_LD(&x[i])));            \
+         for(; i != n; ++i) x[i] *= a;                                          \
+}                                                                               \
+                                                                                \
+static AT_##T##_ATTR __attribute__((noinline))                                  \
+void at_dcopy_##T##_u##U(const int32_t n,                                       \
+                         const double * __restrict x,                           \
+                         double * __restrict y) {                               \
+         int32_t i = 0, j;                                                      \
+         for(; i+(U)*AT_##T##_W <= n; i += (U)*AT_##T##_W) {                    \
+             _Pragma("GCC unroll 16")                                           \
+             for(j = 0; j != (U); ++j) {                                        \
+                 const int32_t k = i+j*AT_##T##_W;                              \
+                 AT_##T##_ST(&y[k],AT_##T##_LD(&x[k]));                         \
+             }                                                                  \
+         }                                                                      \
+         for(; i+AT_##T##_W <= n; i += AT_##T##_W)                              \
+             AT_##T##_ST(&y[i],AT_##T##_LD(&x[i]));                             \
+         for(; i != n; ++i) y[i] = x[i];                                        \
+}
+
+AT_DEF_KERNELS(YMM,4)
+AT_DEF_KERNELS(YMM,8)
+AT_DEF_KERNELS(YMM,16)
+AT_DEF_KERNELS(ZMM,4)
+AT_DEF_KERNELS(ZMM,8)
+AT_DEF_KERNELS(ZMM,16)
+
+
+// Baseline for hosts without AVX2 (and reference for strided calls).
+static __attribute__((noinline))
+void at_daxpy_scalar(const int32_t n, const double a,
+                     const double * __restrict x, double * __restrict y) {
+         int32_t i;
+         for(i = 0; i != n; ++i) y[i] += a*x[i];
+}
+
+static __attribute__((noinline))
+double at_ddot_scalar(const int32_t n,
+                      const double * __restrict x, const double * __restrict y) {
+         double s = 0.0;
+         int32_t i;
+         for(i = 0; i != n; ++i) s += x[i]*y[i];
+         return (s);
+}
+
+static __attribute__((noinline))
+void at_dscal_scalar(const int32_t n, const double a, double * __restrict x) {
+         int32_t i;
+         for(i = 0; i != n; ++i) x[i] *= a;
+}
+
+static __attribute__((noinline))
+void at_dcopy_scalar(const int32_t n,
+                     const double * __restrict x, double * __restrict y) {
+         memcpy(y,x,(size_t)n*sizeof(double));
+}
+
+
+#if defined(GMS_BLAS1_AUTOTUNE_LEGACY)
+// Fixed-unroll kernels of the *_unrolled*x files (unit-stride entry points).
+// Declared here: the dotv headers redefine the vector typedefs of
+// GMS_blas_kernels_defs.h and cannot be included next to the others.
+// dcopy_u_zmm8r8_unroll16x is declared on float* and is not registered.
+extern void daxpy_u_ymm4r8_unroll10x(const int32_t, const double, double * __restrict,
+                                     const int32_t, double * __restrict, const int32_t);
+extern void daxpy_u_zmm8r8_unroll10x(const int32_t, const double, double * __restrict,
+                                     const int32_t, double * __restrict, const int32_t);
+extern void ddotv_u_ymm4r8_unroll10x(const int32_t, double * __restrict, const int32_t,
+                                     double * __restrict, const int32_t, double * __restrict);
+extern void ddotv_u_zmm8r8_unroll10x(const int32_t, double * __restrict, const int32_t,
+                                     double * __restrict, const int32_t, double * __restrict);
+extern void dscalv_u_ymm4r8_unroll8x(const int32_t, const double, double * __restrict,
+                                     const int32_t);
+extern void dscalv_u_zmm8r8_unroll8x(const int32_t, const double, double * __restrict,
+                                     const int32_t);
+extern void dcopy_u_ymm4r8_unroll16x(const int32_t, double * __restrict, const int32_t,
+                                     double * __restrict, const int32_t);
+
+static void at_daxpy_ymm_u10(const int32_t n, const double a,
+                             const double * __restrict x, double * __restrict y) {
+         daxpy_u_ymm4r8_unroll10x(n,a,(double*)x,1,y,1);
+}
+
+static void at_daxpy_zmm_u10(const int32_t n, const double a,
+                             const double * __restrict x, double * __restrict y) {
+         daxpy_u_zmm8r8_unroll10x(n,a,(double*)x,1,y,1);
+}
+
+static double at_ddot_ymm_u10(const int32_t n,
+                              const double * __restrict x, const double * __restrict y) {
+         double r = 0.0;
+         ddotv_u_ymm4r8_unroll10x(n,(double*)x,1,(double*)y,1,&r);
+         return (r);
+}
+
+static double at_ddot_zmm_u10(const int32_t n,
+                              const double * __restrict x, const double * __restrict y) {
+         double r = 0.0;
+         ddotv_u_zmm8r8_unroll10x(n,(double*)x,1,(double*)y,1,&r);
+         return (r);
+}
+
+static void at_dscal_ymm_u8(const int32_t n, const double a, double * __restrict x) {
+         dscalv_u_ymm4r8_unroll8x(n,a,x,1);
+}
+
+static void at_dscal_zmm_u8(const int32_t n, const double a, double * __restrict x) {
+         dscalv_u_zmm8r8_unroll8x(n,a,x,1);
+}
+
+static void at_dcopy_ymm_u16(const int32_t n,
+                             const double * __restrict x, double * __restrict y) {
+         dcopy_u_ymm4r8_unroll16x(n,(double*)x,1,y,1);
+}
+#endif
+
+
+#define AT_V(T,op,U) { #T "_u" #U, AT_ISA_##T, { .op = at_d##op##_##T##_u##U } }
+
+static const at_variant_t at_axpy_tab[] = {
+        { "scalar", AT_ISA_NONE, { .axpy = at_daxpy_scalar } },
+        AT_V(YMM,axpy,4), AT_V(YMM,axpy,8), AT_V(YMM,axpy,16),
+        AT_V(ZMM,axpy,4), AT_V(ZMM,axpy,8), AT_V(ZMM,axpy,16),
+#if defined(GMS_BLAS1_AUTOTUNE_LEGACY)
+        { "YMM_u10_legacy", AT_ISA_YMM, { .axpy = at_daxpy_ymm_u10 } },
+        { "ZMM_u10_legacy", AT_ISA_ZMM, { .axpy = at_daxpy_zmm_u10 } },
+#endif
+};
+
+static const at_variant_t at_dot_tab[] = {
+        { "scalar", AT_ISA_NONE, { .dot = at_ddot_scalar } },
+        AT_V(YMM,dot,4), AT_V(YMM,dot,8), AT_V(YMM,dot,16),
+        AT_V(ZMM,dot,4), AT_V(ZMM,dot,8), AT_V(ZMM,dot,16),
+#if defined(GMS_BLAS1_AUTOTUNE_LEGACY)
+        { "YMM_u10_legacy", AT_ISA_YMM, { .dot = at_ddot_ymm_u10 } },
+        { "ZMM_u10_legacy", AT_ISA_ZMM, { .dot = at_ddot_zmm_u10 } },
+#endif
+};
+
+static const at_variant_t at_scal_tab[] = {
+        { "scalar", AT_ISA_NONE, { .scal = at_dscal_scalar } },
+        AT_V(YMM,scal,4), AT_V(YMM,scal,8), AT_V(YMM,scal,16),
+        AT_V(ZMM,scal,4), AT_V(ZMM,scal,8), AT_V(ZMM,scal,16),
+#if defined(GMS_BLAS1_AUTOTUNE_LEGACY)
+        { "YMM_u8_legacy", AT_ISA_YMM, { .scal = at_dscal_ymm_u8 } },
+        { "ZMM_u8_legacy", AT_ISA_ZMM, { .scal = at_dscal_zmm_u8 } },
+#endif
+};
+
+static const at_variant_t at_copy_tab[] = {
+        { "scalar", AT_ISA_NONE, { .copy = at_dcopy_scalar } },
+        AT_V(YMM,copy,4), AT_V(YMM,copy,8), AT_V(YMM,copy,16),
+        AT_V(ZMM,copy,4), AT_V(ZMM,copy,8), AT_V(ZMM,copy,16),
+#if defined(GMS_BLAS1_AUTOTUNE_LEGACY)
+        { "YMM_u16_legacy", AT_ISA_YMM, { .copy = at_dcopy_ymm_u16 } },
+#endif
+};
+
+#define AT_NELEMS(t) ((int32_t)(sizeof(t)/sizeof((t)[0])))
+
+static const at_variant_t * const at_tabs[BLAS1_AT_NOPS] = {
+        at_axpy_tab, at_dot_tab, at_scal_tab, at_copy_tab
+};
+
+static const int32_t at_ntabs[BLAS1_AT_NOPS] = {
+        AT_NELEMS(at_axpy_tab), AT_NELEMS(at_dot_tab),
+        AT_NELEMS(at_scal_tab), AT_NELEMS(at_copy_tab)
+};
+
+static const char * const at_op_names[BLAS1_AT_NOPS] = {
+        "daxpy", "ddot", "dscal", "dcopy"
+};
+
+// Vectors streamed per element (working set = n*8*nvec bytes).
+static const int32_t at_op_nvec[BLAS1_AT_NOPS] = { 2, 2, 1, 2 };
+
+
+/*
+     Tuning state.
+*/
+static pthread_mutex_t at_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int32_t at_ready = 0;
+static int32_t  at_host_isa = -1;
+static char     at_cpu_brand[52];
+static char     at_host_name[64];
+// Class upper bounds in bytes: L1, L2, LLC.
+static int64_t  at_bounds[BLAS1_AT_NCLS-1] = { 32768LL, 1048576LL, 8388608LL };
+// Selected variant (index into at_tabs[op]) and its entry point.
+static int32_t  at_sel_idx[BLAS1_AT_NOPS][BLAS1_AT_NCLS];
+static at_fn_t  at_sel[BLAS1_AT_NOPS][BLAS1_AT_NCLS] = {
+        { {.axpy = at_daxpy_scalar}, {.axpy = at_daxpy_scalar},
+          {.axpy = at_daxpy_scalar}, {.axpy = at_daxpy_scalar} },
+        { {.dot  = at_ddot_scalar},  {.dot  = at_ddot_scalar},
+          {.dot  = at_ddot_scalar},  {.dot  = at_ddot_scalar}  },
+        { {.scal = at_dscal_scalar}, {.scal = at_dscal_scalar},
+          {.scal = at_dscal_scalar}, {.scal = at_dscal_scalar} },
+        { {.copy = at_dcopy_scalar}, {.copy = at_dcopy_scalar},
+          {.copy = at_dcopy_scalar}, {.copy = at_dcopy_scalar} }
+};
+
+
+static inline
+double at_wtime(void) {
+#if defined(_OPENMP)
+         return (omp_get_wtime());
+#else
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+#endif
+}
+
+
+static void at_setup_host(void) {
+
+         cache_info_t l1,l2,l3;
+         unsigned int r[4];
+         int64_t L1,L2,L3;
+         int32_t i;
+         if(at_host_isa >= 0) return;
+         __builtin_cpu_init();
+         at_host_isa = AT_ISA_NONE;
+         if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            at_host_isa |= AT_ISA_YMM;
+         if(__builtin_cpu_supports("avx512f"))
+            at_host_isa |= AT_ISA_ZMM;
+         memset(at_cpu_brand,0,sizeof(at_cpu_brand));
+         if(__get_cpuid_max(0x80000000u,NULL) >= 0x80000004u) {
+            for(i = 0; i != 3; ++i) {
+                __get_cpuid(0x80000002u+(unsigned)i,&r[0],&r[1],&r[2],&r[3]);
+                memcpy(&at_cpu_brand[16*i],r,16);
+            }
+         }
+         // Trim the padding; the brand string is the profile key.
+         for(i = (int32_t)strlen(at_cpu_brand); i > 0 && at_cpu_brand[i-1] == ' '; --i)
+             at_cpu_brand[i-1] = '\0';
+         if(at_cpu_brand[0] == '\0') strcpy(at_cpu_brand,"unknown");
+         if(gethostname(at_host_name,sizeof(at_host_name)-1) != 0 || at_host_name[0] == '\0')
+            strcpy(at_host_name,"localhost");
+         at_host_name[sizeof(at_host_name)-1] = '\0';
+         memset(&l1,0,sizeof(l1));
+         memset(&l2,0,sizeof(l2));
+         memset(&l3,0,sizeof(l3));
+         // Sizes are reported in KiB, 0 when the level is absent.
+         get_cacheinfo(CACHE_INFO_L1_D,&l1);
+         get_cacheinfo(CACHE_INFO_L2,&l2);
+         get_cacheinfo(CACHE_INFO_L3,&l3);
+         L1 = (l1.size > 0) ? (int64_t)l1.size*1024LL : 32768LL;
+         L2 = (l2.size > 0) ? (int64_t)l2.size*1024LL : 1048576LL;
+         L3 = (l3.size > 0) ? (int64_t)l3.size*1024LL : 8LL*L2;
+         if(L2 <= L1) L2 = 8LL*L1;
+         if(L3 <= L2) L3 = 8LL*L2;
+         at_bounds[0] = L1;
+         at_bounds[1] = L2;
+         at_bounds[2] = L3;
+}
+
+
+// Widest ISA, unroll 8: used until the host is tuned or a profile is loaded.
+static void at_set_defaults(void) {
+
+         const char * const name = (at_host_isa & AT_ISA_ZMM) ? "ZMM_u8" :
+                                   (at_host_isa & AT_ISA_YMM) ? "YMM_u8" : "scalar";
+         int32_t op,c,v;
+         for(op = 0; op != BLAS1_AT_NOPS; ++op) {
+             for(v = 0; v != at_ntabs[op]; ++v)
+                 if(strcmp(at_tabs[op][v].name,name) == 0) break;
+             if(v == at_ntabs[op]) v = 0;
+             for(c = 0; c != BLAS1_AT_NCLS; ++c) {
+                 at_sel_idx[op][c] = v;
+                 at_sel[op][c]     = at_tabs[op][v].fn;
+             }
+         }
+}
+
+
+static inline
+int32_t at_runnable(const at_variant_t * __restrict v) {
+
+         return ((v->isa & ~at_host_isa) == 0);
+}
+
+
+static inline
+double at_call(const int32_t op,
+               const at_fn_t fn,
+               const int32_t n,
+               double * __restrict x,
+               double * __restrict y) {
+
+         switch(op) {
+         case BLAS1_AT_DAXPY: fn.axpy(n,1.0e-9,x,y);   return (0.0);
+         case BLAS1_AT_DDOT:  return (fn.dot(n,x,y));
+         case BLAS1_AT_DSCAL: fn.scal(n,1.0,x);        return (0.0);
+         default:             fn.copy(n,x,y);          return (0.0);
+         }
+}
+
+
+// Seconds per call of variant fn on n elements (fastest of BLAS1_AT_NSAMPLES).
+static double at_time_variant(const int32_t op,
+                              const at_fn_t fn,
+                              const int32_t n,
+                              double * __restrict x,
+                              double * __restrict y) {
+
+         volatile double sink = 0.0;
+         double t0,t,best;
+         int64_t reps,r;
+         int32_t s;
+         sink += at_call(op,fn,n,x,y);
+         // Calibrate the repetition count to BLAS1_AT_SAMPLE_SEC.
+         reps = 1;
+         for(;;) {
+             t0 = at_wtime();
+             for(r = 0; r != reps; ++r) sink += at_call(op,fn,n,x,y);
+             t = at_wtime()-t0;
+             if(t >= BLAS1_AT_SAMPLE_SEC || reps >= (1LL<<30)) break;
+             reps *= 2;
+         }
+         best = t/(double)reps;
+         for(s = 1; s < BLAS1_AT_NSAMPLES; ++s) {
+             t0 = at_wtime();
+             for(r = 0; r != reps; ++r) sink += at_call(op,fn,n,x,y);
+             t = (at_wtime()-t0)/(double)reps;
+             if(t < best) best = t;
+         }
+         (void)sink;
+         return (best);
+}
+
+
+// Benchmark length of class c for an operation streaming nvec vectors:
+// half of the class' cache level (four times the LLC, capped, for DRAM).
+static int32_t at_class_len(const int32_t c, const int32_t nvec) {
+
+         int64_t ws,n;
+         ws = (c == BLAS1_AT_DRAM) ? 4LL*at_bounds[2] : at_bounds[c]/2LL;
+         n  = ws/(8LL*nvec);
+         if(n > BLAS1_AT_DRAM_NMAX) n = BLAS1_AT_DRAM_NMAX;
+         n &= ~7LL;
+         if(n < 256) n = 256;
+         return ((int32_t)n);
+}
+
+
+static int32_t at_run_locked(const int32_t flags) {
+
+         double * __restrict x = NULL;
+         double * __restrict y = NULL;
+         int64_t nmax,i;
+         int32_t op,c,v,n,best;
+         double t,tbest;
+         at_setup_host();
+         at_set_defaults();
+         nmax = 0;
+         for(c = 0; c != BLAS1_AT_NCLS; ++c)
+             if(at_class_len(c,1) > nmax) nmax = at_class_len(c,1);
+         x = (double*)_mm_malloc((size_t)nmax*sizeof(double),64);
+         y = (double*)_mm_malloc((size_t)nmax*sizeof(double),64);
+         if(__builtin_expect(NULL==x || NULL==y,0)) {
+            if(x) _mm_free(x);
+            if(y) _mm_free(y);
+            return (-2);
+         }
+         for(i = 0; i != nmax; ++i) {
+             x[i] = 1.0+1.0e-3*(double)(i&1023);
+             y[i] = 2.0-1.0e-3*(double)(i&511);
+         }
+         for(op = 0; op != BLAS1_AT_NOPS; ++op) {
+             for(c = 0; c != BLAS1_AT_NCLS; ++c) {
+                 n = at_class_len(c,at_op_nvec[op]);
+                 best  = at_sel_idx[op][c];
+                 tbest = 1.0e+300;
+                 for(v = 0; v != at_ntabs[op]; ++v) {
+                     if(!at_runnable(&at_tabs[op][v])) continue;
+                     t = at_time_variant(op,at_tabs[op][v].fn,n,x,y);
+                     if(flags & BLAS1_AT_VERBOSE)
+                        fprintf(stderr,"blas1_autotune: %-6s class=%d n=%-9d %-16s %8.3f GB/s\n",
+                                at_op_names[op],c,n,at_tabs[op][v].name,
+                                1.0e-9*8.0*(double)n*(double)at_op_nvec[op]/t);
+                     if(t < tbest) { tbest = t; best = v; }
+                 }
+                 at_sel_idx[op][c] = best;
+                 at_sel[op][c]     = at_tabs[op][best].fn;
+             }
+         }
+         _mm_free(x);
+         _mm_free(y);
+         return (0);
+}
+
+
+static void at_default_path(char * __restrict path,
+                            const size_t len) {
+
+         const char * p = getenv("GMS_BLAS1_AUTOTUNE_PROFILE");
+         const char * h;
+         if(p != NULL && p[0] != '\0') {
+            snprintf(path,len,"%s",p);
+            return;
+         }
+         h = getenv("HOME");
+         snprintf(path,len,"%s/.gms_blas1_autotune.%s",
+                  (h != NULL && h[0] != '\0') ? h : ".",at_host_name);
+}
+
+
+static int32_t at_save_locked(const char * __restrict path) {
+
+         char buf[512];
+         FILE * fp = NULL;
+         int32_t op,c;
+         if(NULL==path) {
+            at_default_path(buf,sizeof(buf));
+            path = buf;
+         }
+         fp = fopen(path,"w");
+         if(NULL==fp) return (-3);
+         fprintf(fp,"# GMS_blas1_autotune profile v1\n");
+         fprintf(fp,"host %s\n",at_host_name);
+         fprintf(fp,"cpu %s\n",at_cpu_brand);
+         fprintf(fp,"bounds %lld %lld %lld\n",(long long)at_bounds[0],
+                 (long long)at_bounds[1],(long long)at_bounds[2]);
+         for(op = 0; op != BLAS1_AT_NOPS; ++op) {
+             fprintf(fp,"%s",at_op_names[op]);
+             for(c = 0; c != BLAS1_AT_NCLS; ++c)
+                 fprintf(fp," %s",at_tabs[op][at_sel_idx[op][c]].name);
+             fprintf(fp,"\n");
+         }
+         return ((fclose(fp) == 0) ? 0 : -3);
+}
+
+
+// The tables are only replaced when the whole profile is valid for this host.
+static int32_t at_load_locked(const char * __restrict path) {
+
+         char buf[512];
+         char line[256];
+         char names[BLAS1_AT_NCLS][32];
+         int32_t idx[BLAS1_AT_NOPS][BLAS1_AT_NCLS];
+         long long b[BLAS1_AT_NCLS-1];
+         FILE * fp = NULL;
+         int32_t op,c,v,seen_cpu,seen_bnd,seen_ops;
+         size_t len;
+         if(NULL==path) {
+            at_default_path(buf,sizeof(buf));
+            path = buf;
+         }
+         fp = fopen(path,"r");
+         if(NULL==fp) return (-3);
+         seen_cpu = seen_bnd = seen_ops = 0;
+         while(fgets(line,sizeof(line),fp) != NULL) {
+             len = strlen(line);
+             while(len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')) line[--len] = '\0';
+             if(line[0] == '#' || line[0] == '\0') continue;
+             if(strncmp(line,"cpu ",4) == 0) {
+                if(strcmp(&line[4],at_cpu_brand) != 0) break;
+                seen_cpu = 1;
+             }
+             else if(strncmp(line,"bounds ",7) == 0) {
+                if(sscanf(&line[7],"%lld %lld %lld",&b[0],&b[1],&b[2]) != 3 ||
+                   b[0] <= 0 || b[1] <= b[0] || b[2] <= b[1]) break;
+                seen_bnd = 1;
+             }
+             else {
+                for(op = 0; op != BLAS1_AT_NOPS; ++op) {
+                    len = strlen(at_op_names[op]);
+                    if(strncmp(line,at_op_names[op],len) == 0 && line[len] == ' ') break;
+                }
+                if(op == BLAS1_AT_NOPS) continue; // host line, unknown keys
+                if(sscanf(&line[len],"%31s %31s %31s %31s",names[0],names[1],
+                          names[2],names[3]) != BLAS1_AT_NCLS) break;
+                for(c = 0; c != BLAS1_AT_NCLS; ++c) {
+                    for(v = 0; v != at_ntabs[op]; ++v)
+                        if(strcmp(at_tabs[op][v].name,names[c]) == 0) break;
+                    if(v == at_ntabs[op] || !at_runnable(&at_tabs[op][v])) break;
+                    idx[op][c] = v;
+                }
+                if(c != BLAS1_AT_NCLS) break;
+                seen_ops |= 1 << op;
+             }
+         }
+         fclose(fp);
+         if(!seen_cpu || !seen_bnd || seen_ops != (1 << BLAS1_AT_NOPS)-1) return (-3);
+         for(c = 0; c != BLAS1_AT_NCLS-1; ++c) at_bounds[c] = (int64_t)b[c];
+         for(op = 0; op != BLAS1_AT_NOPS; ++op) {
+             for(c = 0; c != BLAS1_AT_NCLS; ++c) {
+                 at_sel_idx[op][c] = idx[op][c];
+                 at_sel[op][c]     = at_tabs[op][idx[op][c]].fn;
+             }
+         }
+         return (0);
+}
+
+
+int32_t blas1_autotune_init(const int32_t flags) {
+
+         int32_t stat = 0;
+         pthread_mutex_lock(&at_lock);
+         if(at_ready && !(flags & BLAS1_AT_FORCE)) {
+            pthread_mutex_unlock(&at_lock);
+            return (0);
+         }
+         at_setup_host();
+         if((flags & BLAS1_AT_FORCE) || at_load_locked(NULL) != 0) {
+            stat = at_run_locked(flags);
+            if(stat != 0)
+               at_set_defaults();
+            else if(!(flags & BLAS1_AT_NOSAVE))
+               stat = at_save_locked(NULL);
+         }
+         __atomic_store_n(&at_ready,1,__ATOMIC_RELEASE);
+         pthread_mutex_unlock(&at_lock);
+         return (stat);
+}
+
+
+// Implicit first use (dispatchers, queries): the host profile if there is
+// one, else the defaults; never benchmarks and never writes the profile.
+static void at_init_implicit(void) {
+
+         pthread_mutex_lock(&at_lock);
+         if(!at_ready) {
+            at_setup_host();
+            if(at_load_locked(NULL) != 0) at_set_defaults();
+            __atomic_store_n(&at_ready,1,__ATOMIC_RELEASE);
+         }
+         pthread_mutex_unlock(&at_lock);
+}
+
+
+int32_t blas1_autotune_run(const int32_t flags) {
+
+         int32_t stat;
+         pthread_mutex_lock(&at_lock);
+         stat = at_run_locked(flags);
+         if(stat != 0) at_set_defaults();
+         __atomic_store_n(&at_ready,1,__ATOMIC_RELEASE);
+         pthread_mutex_unlock(&at_lock);
+         return (stat);
+}
+
+
+int32_t blas1_autotune_load(const char * __restrict path) {
+
+         int32_t stat;
+         pthread_mutex_lock(&at_lock);
+         at_setup_host();
+         stat = at_load_locked(path);
+         if(stat == 0) __atomic_store_n(&at_ready,1,__ATOMIC_RELEASE);
+         pthread_mutex_unlock(&at_lock);
+         return (stat);
+}
+
+
+int32_t blas1_autotune_save(const char * __restrict path) {
+
+         int32_t stat;
+         pthread_mutex_lock(&at_lock);
+         at_setup_host();
+         if(!at_ready) at_set_defaults();
+         stat = at_save_locked(path);
+         pthread_mutex_unlock(&at_lock);
+         return (stat);
+}
+
+
+const char * blas1_autotune_variant(const int32_t op,
+                                    const int32_t c) {
+
+         if(op < 0 || op >= BLAS1_AT_NOPS || c < 0 || c >= BLAS1_AT_NCLS) return (NULL);
+         if(!__atomic_load_n(&at_ready,__ATOMIC_ACQUIRE)) at_init_implicit();
+         return (at_tabs[op][at_sel_idx[op][c]].name);
+}
+
+
+void blas1_autotune_bounds(int64_t * __restrict bounds) {
+
+         int32_t c;
+         if(NULL==bounds) return;
+         if(!__atomic_load_n(&at_ready,__ATOMIC_ACQUIRE)) at_init_implicit();
+         for(c = 0; c != BLAS1_AT_NCLS-1; ++c) bounds[c] = at_bounds[c];
+}
+
+
+/*
+     Dispatchers.
+*/
+static inline
+int32_t at_class_of(const int64_t bytes) {
+
+         if(bytes <= at_bounds[0]) return (BLAS1_AT_L1);
+         if(bytes <= at_bounds[1]) return (BLAS1_AT_L2);
+         if(bytes <= at_bounds[2]) return (BLAS1_AT_LLC);
+         return (BLAS1_AT_DRAM);
+}
+
+#define AT_ENSURE_READY()                                              \
+         if(__builtin_expect(!__atomic_load_n(&at_ready,__ATOMIC_ACQUIRE),0)) \
+            at_init_implicit()
+
+// Elements per call of the int32-counted kernels (a multiple of 64).
+#define AT_CHUNK (1LL << 30)
+
+// First element in memory of a vector walked with increment inc (BLAS rule).
+#define AT_BASE(n,inc) (((inc) < 0) ? (int64_t)(1-(n))*(inc) : 0LL)
+
+
+void daxpy_tuned(const int64_t n,
+                 const double a,
+                 const double * __restrict x,
+                 const int64_t incx,
+                 double * __restrict y,
+                 const int64_t incy) {
+
+         at_axpy_fn fn;
+         int64_t i,ix,iy;
+         if(__builtin_expect(n<=0 || a==0.0,0)) return;
+         if(__builtin_expect(incx!=1 || incy!=1,0)) {
+            ix = AT_BASE(n,incx);
+            iy = AT_BASE(n,incy);
+            for(i = 0; i != n; ++i, ix += incx, iy += incy) y[iy] += a*x[ix];
+            return;
+         }
+         AT_ENSURE_READY();
+         fn = at_sel[BLAS1_AT_DAXPY][at_class_of(16LL*n)].axpy;
+         for(i = 0; n-i > AT_CHUNK; i += AT_CHUNK)
+             fn((int32_t)AT_CHUNK,a,&x[i],&y[i]);
+         fn((int32_t)(n-i),a,&x[i],&y[i]);
+}
+
+
+double ddot_tuned(const int64_t n,
+                  const double * __restrict x,
+                  const int64_t incx,
+                  const double * __restrict y,
+                  const int64_t incy) {
+
+         at_dot_fn fn;
+         double s = 0.0;
+         int64_t i,ix,iy;
+         if(__builtin_expect(n<=0,0)) return (0.0);
+         if(__builtin_expect(incx!=1 || incy!=1,0)) {
+            ix = AT_BASE(n,incx);
+            iy = AT_BASE(n,incy);
+            for(i = 0; i != n; ++i, ix += incx, iy += incy) s += x[ix]*y[iy];
+            return (s);
+         }
+         AT_ENSURE_READY();
+         fn = at_sel[BLAS1_AT_DDOT][at_class_of(16LL*n)].dot;
+         for(i = 0; n-i > AT_CHUNK; i += AT_CHUNK)
+             s += fn((int32_t)AT_CHUNK,&x[i],&y[i]);
+         return (s+fn((int32_t)(n-i),&x[i],&y[i]));
+}
+
+
+void dscal_tuned(const int64_t n,
+                 const double a,
+                 double * __restrict x,
+                 const int64_t incx) {
+
+         at_scal_fn fn;
+         int64_t i,ix;
+         if(__builtin_expect(n<=0 || incx<=0,0)) return;
+         if(__builtin_expect(incx!=1,0)) {
+            for(i = 0, ix = 0; i != n; ++i, ix += incx) x[ix] *= a;
+            return;
+         }
+         AT_ENSURE_READY();
+         fn = at_sel[BLAS1_AT_DSCAL][at_class_of(8LL*n)].scal;
+         for(i = 0; n-i > AT_CHUNK; i += AT_CHUNK)
+             fn((int32_t)AT_CHUNK,a,&x[i]);
+         fn((int32_t)(n-i),a,&x[i]);
+}
+
+
+void dcopy_tuned(const int64_t n,
+                 const double * __restrict x,
+                 const int64_t incx,
+                 double * __restrict y,
+                 const int64_t incy) {
+
+         at_copy_fn fn;
+         int64_t i,ix,iy;
+         if(__builtin_expect(n<=0,0)) return;
+         if(__builtin_expect(incx!=1 || incy!=1,0)) {
+            ix = AT_BASE(n,incx);
+            iy = AT_BASE(n,incy);
+            for(i = 0; i != n; ++i, ix += incx, iy += incy) y[iy] = x[ix];
+            return;
+         }
+         AT_ENSURE_READY();
+         fn = at_sel[BLAS1_AT_DCOPY][at_class_of(16LL*n)].copy;
+         for(i = 0; n-i > AT_CHUNK; i += AT_CHUNK)
+             fn((int32_t)AT_CHUNK,&x[i],&y[i]);
+         fn((int32_t)(n-i),&x[i],&y[i]);
+}
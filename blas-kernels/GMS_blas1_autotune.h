@@ -0,0 +1,132 @@
+
+
+#ifndef __GMS_BLAS1_AUTOTUNE_H__
+#define __GMS_BLAS1_AUTOTUNE_H__
+
+//
+// Per-host autotuning of the BLAS-1 unroll factor and vector ISA.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 22:00 PM +00200
+//
+// The unrolled kernels fix their unroll factor in the file name and pick
+// AVX or AVX512 at compile time; the best choice differs between Skylake-SP
+// (two 512-bit FMA ports) and Zen (256-bit datapaths, larger L3 share).
+// Every operation has a table of candidate variants
+//     {ymm, zmm} x {unroll 4, 8, 16}
+// compiled with function-level target attributes, so a single object runs
+// on either machine; variants whose ISA is absent on the host are skipped.
+// With -DGMS_BLAS1_AUTOTUNE_LEGACY the fixed-unroll kernels of
+// GMS_{axpy,dotv,scalv,copy}_avx*_unrolled*x.c join the tables as well.
+//
+// blas1_autotune_init() benchmarks every variant on one vector length per
+// working-set class (L1, L2, LLC, DRAM; bounds from get_cacheinfo) and
+// writes the winners to a per-host profile file, keyed by host name and
+// CPU brand string. Subsequent runs load the profile instead of tuning
+// (a profile from a different CPU, or naming a variant the host cannot
+// execute, is discarded and the host is re-tuned).
+// Profile path: $GMS_BLAS1_AUTOTUNE_PROFILE, else
+//               $HOME/.gms_blas1_autotune.<hostname>, else ./ .
+// The *_tuned dispatchers classify the call by its working set and jump
+// through the profile table. They never tune or write files: if the caller
+// did not run blas1_autotune_init, the first call loads the host profile
+// or, without one, selects the widest-ISA unroll-8 defaults. Counts and
+// strides are int64_t, as in GMS_blas1_i64.h. Non-unit strides take the
+// scalar reference loop.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure,
+// -3 profile I/O failure (the in-memory tables remain valid).
+//
+
+#include <stdint.h>
+
+
+// Operations.
+#define BLAS1_AT_DAXPY  0
+#define BLAS1_AT_DDOT   1
+#define BLAS1_AT_DSCAL  2
+#define BLAS1_AT_DCOPY  3
+#define BLAS1_AT_NOPS   4
+
+// Working-set classes.
+#define BLAS1_AT_L1     0
+#define BLAS1_AT_L2     1
+#define BLAS1_AT_LLC    2
+#define BLAS1_AT_DRAM   3
+#define BLAS1_AT_NCLS   4
+
+// blas1_autotune_init flags.
+#define BLAS1_AT_FORCE   0x1  // re-tune even if a valid profile exists
+#define BLAS1_AT_NOSAVE  0x2  // do not write the profile file
+#define BLAS1_AT_VERBOSE 0x4  // print per-variant timings to stderr
+
+// Minimum wall time of one timed sample (seconds).
+#if !defined(BLAS1_AT_SAMPLE_SEC)
+    #define BLAS1_AT_SAMPLE_SEC 2.0e-3
+#endif
+
+// Timed samples per variant (the fastest one is kept).
+#if !defined(BLAS1_AT_NSAMPLES)
+    #define BLAS1_AT_NSAMPLES 5
+#endif
+
+// Upper bound of the DRAM-class benchmark vector (elements).
+#if !defined(BLAS1_AT_DRAM_NMAX)
+    #define BLAS1_AT_DRAM_NMAX 8388608LL
+#endif
+
+
+// Loads the host profile or, failing that, tunes and saves it.
+// Thread-safe; call it once at start-up to tune a host without a profile.
+int32_t blas1_autotune_init(const int32_t);
+
+// Benchmarks all variants and fills the in-memory tables.
+int32_t blas1_autotune_run(const int32_t);
+
+// Profile I/O (path == NULL -> default path).
+int32_t blas1_autotune_load(const char * __restrict);
+
+int32_t blas1_autotune_save(const char * __restrict);
+
+// Name of the variant selected for (op,class), NULL on invalid arguments.
+const char * blas1_autotune_variant(const int32_t,
+                                    const int32_t);
+
+// Working-set class boundaries in bytes (L1, L2, LLC).
+void    blas1_autotune_bounds(int64_t * __restrict);
+
+
+// y := a*x + y
+void    daxpy_tuned(const int64_t,
+                    const double,
+                    const double * __restrict,
+                    const int64_t,
+                    double * __restrict,
+                    const int64_t)            __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// x.y
+double  ddot_tuned(const int64_t,
+                   const double * __restrict,
+                   const int64_t,
+                   const double * __restrict,
+                   const int64_t)             __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// x := a*x
+void    dscal_tuned(const int64_t,
+                    const double,
+                    double * __restrict,
+                    const int64_t)            __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// y := x
+void    dcopy_tuned(const int64_t,
+                    const double * __restrict,
+                    const int64_t,
+                    double * __restrict,
+                    const int64_t)            __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_BLAS1_AUTOTUNE_H__*/
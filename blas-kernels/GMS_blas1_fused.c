@@ -0,0 +1,365 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_blas1_fused.h"
+
+
+void blas1_prog_init(blas1_prog_t * __restrict p) {
+
+         if(__builtin_expect(NULL==p,0)) return;
+         memset(p,0,sizeof(*p));
+}
+
+
+int32_t blas1_prog_vec(blas1_prog_t * __restrict p,
+                       double * __restrict v) {
+
+         int32_t i;
+         if(__builtin_expect(NULL==p || NULL==v,0)) return (-1);
+         for(i = 0; i != p->nvec; ++i) {
+             if(p->vec[i] == v) return (i);
+         }
+         if(p->nvec == BLAS1_FUSED_MAX_VEC) return (-1);
+         p->vec[p->nvec] = v;
+         return (p->nvec++);
+}
+
+
+static inline
+int32_t blas1_prog_push(blas1_prog_t * __restrict p,
+                        const int32_t op,
+                        const int32_t d,
+                        const int32_t s1,
+                        const int32_t s2,
+                        const double a,
+                        const double b) {
+
+         blas1_op_t * __restrict o;
+         if(__builtin_expect(NULL==p,0)) return (-1);
+         if(p->nops == BLAS1_FUSED_MAX_OPS) return (-1);
+         if(d < 0 || d >= p->nvec || s1 < 0 || s1 >= p->nvec ||
+            s2 < 0 || s2 >= p->nvec) return (-1);
+         o     = &p->ops[p->nops];
+         o->op = op;
+         o->d  = d;
+         o->s1 = s1;
+         o->s2 = s2;
+         o->r  = -1;
+         o->a  = a;
+         o->b  = b;
+         return (p->nops++);
+}
+
+
+int32_t blas1_prog_axpby(blas1_prog_t * __restrict p,
+                         const double a,
+                         const int32_t x,
+                         const double b,
+                         const int32_t y) {
+
+         return (blas1_prog_push(p,BLAS1_OP_AXPBY,y,x,x,a,b) < 0 ? -1 : y);
+}
+
+
+int32_t blas1_prog_scal(blas1_prog_t * __restrict p,
+                        const double a,
+                        const int32_t x) {
+
+         return (blas1_prog_push(p,BLAS1_OP_SCAL,x,x,x,a,0.0) < 0 ? -1 : x);
+}
+
+
+int32_t blas1_prog_copy(blas1_prog_t * __restrict p,
+                        const int32_t x,
+                        const int32_t y) {
+
+         return (blas1_prog_push(p,BLAS1_OP_COPY,y,x,x,0.0,0.0) < 0 ? -1 : y);
+}
+
+
+int32_t blas1_prog_set(blas1_prog_t * __restrict p,
+                       const double a,
+                       const int32_t x) {
+
+         return (blas1_prog_push(p,BLAS1_OP_SET,x,x,x,a,0.0) < 0 ? -1 : x);
+}
+
+
+int32_t blas1_prog_xmy(blas1_prog_t * __restrict p,
+                       const int32_t x,
+                       const int32_t y,
+                       const int32_t w) {
+
+         return (blas1_prog_push(p,BLAS1_OP_XMY,w,x,y,0.0,0.0) < 0 ? -1 : w);
+}
+
+
+int32_t blas1_prog_dot(blas1_prog_t * __restrict p,
+                       const int32_t x,
+                       const int32_t y) {
+
+         int32_t k;
+         if(__builtin_expect(NULL==p,0)) return (-1);
+         if(p->nred == BLAS1_FUSED_MAX_RED) return (-1);
+         k = blas1_prog_push(p,BLAS1_OP_DOT,x,x,y,0.0,0.0);
+         if(k < 0) return (-1);
+         p->ops[k].r = p->nred;
+         return (p->nred++);
+}
+
+
+/*
+     Block kernels, len <= BLAS1_FUSED_BLK. The operands are accessed
+     through unaligned loads (the vectors carry no alignment contract);
+     the tail is handled with a mask. The operands may alias each other
+     element-wise (same index), never with an offset.
+*/
+__attribute__((always_inline))
+static inline
+__mmask8 blas1_tail_mask(const int32_t rem) {
+         return ((__mmask8)((1U << rem)-1U));
+}
+
+
+static
+void blas1_blk_axpby(const int32_t len,
+                     const double a,
+                     const double * x,
+                     const double b,
+                     double * y) {
+
+         const __m512d va = _mm512_set1_pd(a);
+         const __m512d vb = _mm512_set1_pd(b);
+         int32_t i = 0;
+         if(b == 0.0) {
+            for(; (i+31) < len; i += 32) {
+                _mm512_storeu_pd(&y[i+0], _mm512_mul_pd(va,_mm512_loadu_pd(&x[i+0])));
+                _mm512_storeu_pd(&y[i+8], _mm512_mul_pd(va,_mm512_loadu_pd(&x[i+8])));
+                _mm512_storeu_pd(&y[i+16],_mm512_mul_pd(va,_mm512_loadu_pd(&x[i+16])));
+                _mm512_storeu_pd(&y[i+24],_mm512_mul_pd(va,_mm512_loadu_pd(&x[i+24])));
+            }
+            for(; (i+7) < len; i += 8) {
+                _mm512_storeu_pd(&y[i],_mm512_mul_pd(va,_mm512_loadu_pd(&x[i])));
+            }
+            if(i < len) {
+               const __mmask8 k = blas1_tail_mask(len-i);
+               _mm512_mask_storeu_pd(&y[i],k,_mm512_mul_pd(va,_mm512_maskz_loadu_pd(k,&x[i])));
+            }
+            return;
+         }
+         for(; (i+31) < len; i += 32) {
+             _mm512_storeu_pd(&y[i+0], _mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+0]),
+                                                      _mm512_mul_pd(vb,_mm512_loadu_pd(&y[i+0]))));
+             _mm512_storeu_pd(&y[i+8], _mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+8]),
+                                                      _mm512_mul_pd(vb,_mm512_loadu_pd(&y[i+8]))));
+             _mm512_storeu_pd(&y[i+16],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+16]),
+                                                      _mm512_mul_pd(vb,_mm512_loadu_pd(&y[i+16]))));
+             _mm512_storeu_pd(&y[i+24],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+24]),
+                                                      _mm512_mul_pd(vb,_mm512_loadu_pd(&y[i+24]))));
+         }
+         for(; (i+7) < len; i += 8) {
+             _mm512_storeu_pd(&y[i],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i]),
+                                                   _mm512_mul_pd(vb,_mm512_loadu_pd(&y[i]))));
+         }
+         if(i < len) {
+            const __mmask8 k = blas1_tail_mask(len-i);
+            _mm512_mask_storeu_pd(&y[i],k,_mm512_fmadd_pd(va,_mm512_maskz_loadu_pd(k,&x[i]),
+                                                         _mm512_mul_pd(vb,_mm512_maskz_loadu_pd(k,&y[i]))));
+         }
+}
+
+
+static
+void blas1_blk_set(const int32_t len,
+                   const double a,
+                   double * y) {
+
+         const __m512d va = _mm512_set1_pd(a);
+         int32_t i = 0;
+         for(; (i+31) < len; i += 32) {
+             _mm512_storeu_pd(&y[i+0], va);
+             _mm512_storeu_pd(&y[i+8], va);
+             _mm512_storeu_pd(&y[i+16],va);
+             _mm512_storeu_pd(&y[i+24],va);
+         }
+         for(; (i+7) < len; i += 8) _mm512_storeu_pd(&y[i],va);
+         if(i < len) _mm512_mask_storeu_pd(&y[i],blas1_tail_mask(len-i),va);
+}
+
+
+static
+void blas1_blk_copy(const int32_t len,
+                    const double * x,
+                    double * y) {
+
+         int32_t i = 0;
+         if(x == y) return;
+         for(; (i+31) < len; i += 32) {
+             _mm512_storeu_pd(&y[i+0], _mm512_loadu_pd(&x[i+0]));
+             _mm512_storeu_pd(&y[i+8], _mm512_loadu_pd(&x[i+8]));
+             _mm512_storeu_pd(&y[i+16],_mm512_loadu_pd(&x[i+16]));
+             _mm512_storeu_pd(&y[i+24],_mm512_loadu_pd(&x[i+24]));
+         }
+         for(; (i+7) < len; i += 8) _mm512_storeu_pd(&y[i],_mm512_loadu_pd(&x[i]));
+         if(i < len) {
+            const __mmask8 k = blas1_tail_mask(len-i);
+            _mm512_mask_storeu_pd(&y[i],k,_mm512_maskz_loadu_pd(k,&x[i]));
+         }
+}
+
+
+static
+void blas1_blk_xmy(const int32_t len,
+                   const double * x,
+                   const double * y,
+                   double * w) {
+
+         int32_t i = 0;
+         for(; (i+31) < len; i += 32) {
+             _mm512_storeu_pd(&w[i+0], _mm512_mul_pd(_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0])));
+             _mm512_storeu_pd(&w[i+8], _mm512_mul_pd(_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8])));
+             _mm512_storeu_pd(&w[i+16],_mm512_mul_pd(_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16])));
+             _mm512_storeu_pd(&w[i+24],_mm512_mul_pd(_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24])));
+         }
+         for(; (i+7) < len; i += 8) {
+             _mm512_storeu_pd(&w[i],_mm512_mul_pd(_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i])));
+         }
+         if(i < len) {
+            const __mmask8 k = blas1_tail_mask(len-i);
+            _mm512_mask_storeu_pd(&w[i],k,_mm512_mul_pd(_mm512_maskz_loadu_pd(k,&x[i]),
+                                                       _mm512_maskz_loadu_pd(k,&y[i])));
+         }
+}
+
+
+static
+__m512d blas1_blk_dot(const int32_t len,
+                      const double * x,
+                      const double * y,
+                      __m512d acc) {
+
+         __m512d s0 = _mm512_setzero_pd();
+         __m512d s1 = _mm512_setzero_pd();
+         __m512d s2 = _mm512_setzero_pd();
+         __m512d s3 = _mm512_setzero_pd();
+         int32_t i = 0;
+         for(; (i+31) < len; i += 32) {
+             s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0]), s0);
+             s1 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8]), s1);
+             s2 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16]),s2);
+             s3 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24]),s3);
+         }
+         for(; (i+7) < len; i += 8) {
+             s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i]),s0);
+         }
+         if(i < len) {
+            const __mmask8 k = blas1_tail_mask(len-i);
+            s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k,&x[i]),_mm512_maskz_loadu_pd(k,&y[i]),s1);
+         }
+         return (_mm512_add_pd(acc,_mm512_add_pd(_mm512_add_pd(s0,s1),_mm512_add_pd(s2,s3))));
+}
+
+
+/*
+     Runs the whole program on elements [i0,i1), block by block.
+     acc[r] receives the vector partial sums of reduction r.
+*/
+static
+void blas1_prog_range(const blas1_prog_t * __restrict p,
+                      const int64_t i0,
+                      const int64_t i1,
+                      __m512d * __restrict acc) {
+
+         int64_t i;
+         int32_t k,len;
+         for(i = i0; i < i1; i += BLAS1_FUSED_BLK) {
+             len = (i1-i < BLAS1_FUSED_BLK) ? (int32_t)(i1-i) : BLAS1_FUSED_BLK;
+             for(k = 0; k != p->nops; ++k) {
+                 const blas1_op_t * __restrict o = &p->ops[k];
+                 double * d        = p->vec[o->d]+i;
+                 const double * s1 = p->vec[o->s1]+i;
+                 const double * s2 = p->vec[o->s2]+i;
+                 switch(o->op) {
+                     case BLAS1_OP_AXPBY: blas1_blk_axpby(len,o->a,s1,o->b,d);    break;
+                     case BLAS1_OP_SCAL:  blas1_blk_axpby(len,o->a,d,0.0,d);      break;
+                     case BLAS1_OP_COPY:  blas1_blk_copy(len,s1,d);               break;
+                     case BLAS1_OP_SET:   blas1_blk_set(len,o->a,d);              break;
+                     case BLAS1_OP_XMY:   blas1_blk_xmy(len,s1,s2,d);             break;
+                     case BLAS1_OP_DOT:   acc[o->r] = blas1_blk_dot(len,s1,s2,acc[o->r]); break;
+                     default: break;
+                 }
+             }
+         }
+}
+
+
+static inline
+int32_t blas1_prog_check(const blas1_prog_t * __restrict p,
+                         const int64_t n,
+                         const double * __restrict red) {
+
+         if(NULL == p || n < 0) return (-1);
+         if(p->nred > 0 && NULL == red) return (-1);
+         return (0);
+}
+
+
+int32_t blas1_prog_run(const blas1_prog_t * __restrict p,
+                       const int64_t n,
+                       double * __restrict red) {
+
+         __m512d acc[BLAS1_FUSED_MAX_RED];
+         int32_t r;
+         if(__builtin_expect(blas1_prog_check(p,n,red)!=0,0)) return (-1);
+         for(r = 0; r != p->nred; ++r) acc[r] = _mm512_setzero_pd();
+         blas1_prog_range(p,0,n,&acc[0]);
+         for(r = 0; r != p->nred; ++r) red[r] = _mm512_reduce_add_pd(acc[r]);
+         return (0);
+}
+
+
+int32_t blas1_prog_run_omp(const blas1_prog_t * __restrict p,
+                           const int64_t n,
+                           double * __restrict red) {
+
+#if defined(_OPENMP)
+         double part[256][BLAS1_FUSED_MAX_RED];
+         int32_t nth,nused,t,r;
+         if(__builtin_expect(blas1_prog_check(p,n,red)!=0,0)) return (-1);
+         nth = omp_get_max_threads();
+         if(nth > 256) nth = 256;
+         if(nth <= 1 || n < BLAS1_FUSED_OMP_MIN) return (blas1_prog_run(p,n,red));
+         nused = nth;
+#pragma omp parallel num_threads(nth) default(none) shared(p,part,nused) firstprivate(n)
+         {
+               __m512d acc[BLAS1_FUSED_MAX_RED];
+               const int32_t tid  = omp_get_thread_num();
+               const int32_t nthr = omp_get_num_threads();
+               // Static partition on whole blocks: thread tid always gets
+               // the same elements for a given thread count.
+               const int64_t nblk = (n+BLAS1_FUSED_BLK-1)/BLAS1_FUSED_BLK;
+               const int64_t b0   = (nblk*tid)/nthr;
+               const int64_t b1   = (nblk*(tid+1))/nthr;
+               const int64_t i0   = b0*BLAS1_FUSED_BLK;
+               const int64_t i1   = (b1*BLAS1_FUSED_BLK < n) ? b1*BLAS1_FUSED_BLK : n;
+               int32_t rr;
+               if(tid == 0) nused = nthr;
+               for(rr = 0; rr != p->nred; ++rr) acc[rr] = _mm512_setzero_pd();
+               if(i1 > i0) blas1_prog_range(p,i0,i1,&acc[0]);
+               for(rr = 0; rr != p->nred; ++rr) part[tid][rr] = _mm512_reduce_add_pd(acc[rr]);
+         }
+         // Partial sums combined in thread order.
+         for(r = 0; r != p->nred; ++r) {
+             double s = 0.0;
+             for(t = 0; t != nused; ++t) s += part[t][r];
+             red[r] = s;
+         }
+         return (0);
+#else
+         return (blas1_prog_run(p,n,red));
+#endif
+}
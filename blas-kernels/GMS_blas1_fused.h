@@ -0,0 +1,132 @@
+
+
+#ifndef __GMS_BLAS1_FUSED_H__
+#define __GMS_BLAS1_FUSED_H__
+
+//
+// Fused BLAS-1 sequences: a short list of vector operations evaluated in
+// one memory pass.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 19:00 PM +00200
+//
+// Chains such as
+//     y := a*x + b*y;  r := dot(y,z);  w := y
+// cost one full memory pass per call when issued as separate kernels
+// (daxpy_..., dscalv_..., ddotv_..., dcopy). Here the operations are
+// recorded once into a program (blas1_prog_t) and executed block by block:
+// every BLAS1_FUSED_BLK-element block of the operands is loaded from memory
+// once, all operations of the list are applied to it while it is L1-resident,
+// and written back once. Dot products are accumulated in ZMM registers per
+// block and reduced at the end.
+// The _omp version splits the blocks statically over the threads and
+// combines the partial dot products in thread order, so the result does
+// not depend on scheduling (it depends on the thread count only).
+//
+// Usage:
+//     blas1_prog_t p;
+//     blas1_prog_init(&p);
+//     const int32_t x = blas1_prog_vec(&p,X), y = blas1_prog_vec(&p,Y), z = blas1_prog_vec(&p,Z);
+//     blas1_prog_axpby(&p,a,x,b,y);
+//     const int32_t r = blas1_prog_dot(&p,y,z);
+//     blas1_prog_run_omp(&p,n,red);      // red[r] = dot(a*X+b*Y,Z)
+//
+// Return values: builders return the vector/reduction slot or -1 when the
+// program is full; run returns 0 success, -1 invalid argument.
+//
+
+#include <stdint.h>
+
+
+#if !defined(BLAS1_FUSED_BLK)
+    #define BLAS1_FUSED_BLK 512   // elements per block (4 KiB per operand)
+#endif
+#define BLAS1_FUSED_MAX_VEC 8
+#define BLAS1_FUSED_MAX_OPS 16
+#define BLAS1_FUSED_MAX_RED 4
+
+// Below this length the _omp version runs serially.
+#if !defined(BLAS1_FUSED_OMP_MIN)
+    #define BLAS1_FUSED_OMP_MIN 65536
+#endif
+
+
+typedef enum {
+        BLAS1_OP_AXPBY = 0,   // v[d] := a*v[s1] + b*v[d]   (b == 0: v[d] is not read)
+        BLAS1_OP_SCAL,        // v[d] := a*v[d]
+        BLAS1_OP_COPY,        // v[d] := v[s1]
+        BLAS1_OP_SET,         // v[d] := a
+        BLAS1_OP_XMY,         // v[d] := v[s1] .* v[s2]
+        BLAS1_OP_DOT          // red[r] += dot(v[s1],v[s2])
+} blas1_opcode_t;
+
+
+typedef struct {
+        int32_t op;
+        int32_t d;
+        int32_t s1;
+        int32_t s2;
+        int32_t r;
+        double  a;
+        double  b;
+} blas1_op_t;
+
+
+typedef struct {
+        double *            vec[BLAS1_FUSED_MAX_VEC];
+        blas1_op_t          ops[BLAS1_FUSED_MAX_OPS];
+        int32_t             nvec;
+        int32_t             nops;
+        int32_t             nred;
+} blas1_prog_t;
+
+
+void    blas1_prog_init(blas1_prog_t * __restrict);
+
+int32_t blas1_prog_vec(blas1_prog_t * __restrict,
+                       double * __restrict);
+
+int32_t blas1_prog_axpby(blas1_prog_t * __restrict,
+                         const double,
+                         const int32_t,
+                         const double,
+                         const int32_t);
+
+int32_t blas1_prog_scal(blas1_prog_t * __restrict,
+                        const double,
+                        const int32_t);
+
+int32_t blas1_prog_copy(blas1_prog_t * __restrict,
+                        const int32_t,
+                        const int32_t);
+
+int32_t blas1_prog_set(blas1_prog_t * __restrict,
+                       const double,
+                       const int32_t);
+
+int32_t blas1_prog_xmy(blas1_prog_t * __restrict,
+                       const int32_t,
+                       const int32_t,
+                       const int32_t);
+
+int32_t blas1_prog_dot(blas1_prog_t * __restrict,
+                       const int32_t,
+                       const int32_t);
+
+
+int32_t blas1_prog_run(const blas1_prog_t * __restrict,
+                       const int64_t,
+                       double * __restrict)           __attribute__((noinline))
+                                                      __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+
+int32_t blas1_prog_run_omp(const blas1_prog_t * __restrict,
+                           const int64_t,
+                           double * __restrict)       __attribute__((noinline))
+                                                      __attribute__((hot))
+                                                      __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_BLAS1_FUSED_H__*/
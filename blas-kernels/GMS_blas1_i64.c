@@ -0,0 +1,872 @@
+
+
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_blas1_i64.h"
+
+
+static volatile int32_t blas1_i64_nthreads = 0;
+
+#define BLAS1_I64_MAX_THREADS 256
+// Smallest per-thread range (elements); also the split granularity is 64.
+#define BLAS1_I64_MIN_CHUNK   32768LL
+
+// First element in memory of a vector walked with increment inc (BLAS rule).
+#define BLAS1_I64_BASE(p,n,inc) (((inc) < 0) ? (p)+(1-(n))*(inc) : (p))
+
+
+void blas1_i64_set_num_threads(const int32_t nth) {
+
+         __atomic_store_n(&blas1_i64_nthreads,(nth > 0) ? nth : 0,__ATOMIC_RELEASE);
+}
+
+
+int32_t blas1_i64_get_num_threads(void) {
+
+         const int32_t nth = __atomic_load_n(&blas1_i64_nthreads,__ATOMIC_ACQUIRE);
+#if defined(_OPENMP)
+         return ((nth > 0) ? nth : omp_get_max_threads());
+#else
+         (void)nth;
+         return (1);
+#endif
+}
+
+
+double blas1_i64_parallel(const int64_t n,
+                          const blas1_i64_body_fn body,
+                          const blas1_i64_args_t * __restrict args) {
+
+#if defined(_OPENMP)
+         double part[BLAS1_I64_MAX_THREADS];
+         double s;
+         int32_t nth,nused,t;
+         nth = blas1_i64_get_num_threads();
+         if(nth > BLAS1_I64_MAX_THREADS) nth = BLAS1_I64_MAX_THREADS;
+         if((int64_t)nth > n/BLAS1_I64_MIN_CHUNK) nth = (int32_t)(n/BLAS1_I64_MIN_CHUNK);
+         if(nth <= 1 || n < BLAS1_I64_PAR_MIN) return (body(0,n,args));
+         nused = nth;
+#pragma omp parallel num_threads(nth) default(none) shared(part,nused) firstprivate(n,body,args)
+         {
+               const int32_t tid  = omp_get_thread_num();
+               const int32_t nthr = omp_get_num_threads();
+               const int64_t lo   = ((n*tid)/nthr) & ~63LL;
+               const int64_t hi   = (tid == nthr-1) ? n : ((n*(tid+1))/nthr) & ~63LL;
+               if(tid == 0) nused = nthr;
+               part[tid] = (hi > lo) ? body(lo,hi,args) : 0.0;
+         }
+         s = 0.0;
+         for(t = 0; t != nused; ++t) s += part[t];
+         return (s);
+#else
+         return (body(0,n,args));
+#endif
+}
+
+
+/*
+     Gather/scatter index vectors: lane l addresses element l*inc.
+*/
+__attribute__((always_inline))
+static inline
+__m512i blas1_i64_vidx(const int64_t inc) {
+         return (_mm512_set_epi64(7*inc,6*inc,5*inc,4*inc,3*inc,2*inc,inc,0));
+}
+
+
+__attribute__((always_inline))
+static inline
+__mmask8 blas1_i64_mask8(const int64_t rem) {
+         return ((__mmask8)((1U << rem)-1U));
+}
+
+
+__attribute__((always_inline))
+static inline
+__mmask16 blas1_i64_mask16(const int64_t rem) {
+         return ((__mmask16)((1U << rem)-1U));
+}
+
+
+/*
+     ============================== AXPY ==============================
+*/
+static
+double daxpy_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const double * __restrict x = (const double*)g->x+lo*incx;
+         double * __restrict y       = (double*)g->y+lo*incy;
+         const int64_t n  = hi-lo;
+         const __m512d va = _mm512_set1_pd(g->a);
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                _mm512_storeu_pd(&y[i+0], _mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0])));
+                _mm512_storeu_pd(&y[i+8], _mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8])));
+                _mm512_storeu_pd(&y[i+16],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16])));
+                _mm512_storeu_pd(&y[i+24],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24])));
+            }
+            for(; (i+7) < n; i += 8) {
+                _mm512_storeu_pd(&y[i],_mm512_fmadd_pd(va,_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i])));
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               _mm512_mask_storeu_pd(&y[i],k,_mm512_fmadd_pd(va,_mm512_maskz_loadu_pd(k,&x[i]),
+                                                            _mm512_maskz_loadu_pd(k,&y[i])));
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m512d xv = _mm512_i64gather_pd(vix,&x[i*incx],8);
+                const __m512d yv = _mm512_i64gather_pd(viy,&y[i*incy],8);
+                _mm512_i64scatter_pd(&y[i*incy],viy,_mm512_fmadd_pd(va,xv,yv),8);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m512d  z  = _mm512_setzero_pd();
+               const __m512d  xv = _mm512_mask_i64gather_pd(z,k,vix,&x[i*incx],8);
+               const __m512d  yv = _mm512_mask_i64gather_pd(z,k,viy,&y[i*incy],8);
+               _mm512_mask_i64scatter_pd(&y[i*incy],k,viy,_mm512_fmadd_pd(va,xv,yv),8);
+            }
+         }
+         return (0.0);
+}
+
+
+static
+double saxpy_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const float * __restrict x = (const float*)g->x+lo*incx;
+         float * __restrict y       = (float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            const __m512 va = _mm512_set1_ps(g->af);
+            for(; (i+63) < n; i += 64) {
+                _mm512_storeu_ps(&y[i+0], _mm512_fmadd_ps(va,_mm512_loadu_ps(&x[i+0]), _mm512_loadu_ps(&y[i+0])));
+                _mm512_storeu_ps(&y[i+16],_mm512_fmadd_ps(va,_mm512_loadu_ps(&x[i+16]),_mm512_loadu_ps(&y[i+16])));
+                _mm512_storeu_ps(&y[i+32],_mm512_fmadd_ps(va,_mm512_loadu_ps(&x[i+32]),_mm512_loadu_ps(&y[i+32])));
+                _mm512_storeu_ps(&y[i+48],_mm512_fmadd_ps(va,_mm512_loadu_ps(&x[i+48]),_mm512_loadu_ps(&y[i+48])));
+            }
+            for(; (i+15) < n; i += 16) {
+                _mm512_storeu_ps(&y[i],_mm512_fmadd_ps(va,_mm512_loadu_ps(&x[i]),_mm512_loadu_ps(&y[i])));
+            }
+            if(i < n) {
+               const __mmask16 k = blas1_i64_mask16(n-i);
+               _mm512_mask_storeu_ps(&y[i],k,_mm512_fmadd_ps(va,_mm512_maskz_loadu_ps(k,&x[i]),
+                                                            _mm512_maskz_loadu_ps(k,&y[i])));
+            }
+         }
+         else {
+            const __m256  va  = _mm256_set1_ps(g->af);
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m256 xv = _mm512_i64gather_ps(vix,&x[i*incx],4);
+                const __m256 yv = _mm512_i64gather_ps(viy,&y[i*incy],4);
+                _mm512_i64scatter_ps(&y[i*incy],viy,_mm256_fmadd_ps(va,xv,yv),4);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m256   z  = _mm256_setzero_ps();
+               const __m256   xv = _mm512_mask_i64gather_ps(z,k,vix,&x[i*incx],4);
+               const __m256   yv = _mm512_mask_i64gather_ps(z,k,viy,&y[i*incy],4);
+               _mm512_mask_i64scatter_ps(&y[i*incy],k,viy,_mm256_fmadd_ps(va,xv,yv),4);
+            }
+         }
+         return (0.0);
+}
+
+
+/*
+     ============================== SCAL ==============================
+*/
+static
+double dscal_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incy = g->incy;
+         double * __restrict y = (double*)g->y+lo*incy;
+         const int64_t n  = hi-lo;
+         const __m512d va = _mm512_set1_pd(g->a);
+         int64_t i = 0;
+         if(incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                _mm512_storeu_pd(&y[i+0], _mm512_mul_pd(va,_mm512_loadu_pd(&y[i+0])));
+                _mm512_storeu_pd(&y[i+8], _mm512_mul_pd(va,_mm512_loadu_pd(&y[i+8])));
+                _mm512_storeu_pd(&y[i+16],_mm512_mul_pd(va,_mm512_loadu_pd(&y[i+16])));
+                _mm512_storeu_pd(&y[i+24],_mm512_mul_pd(va,_mm512_loadu_pd(&y[i+24])));
+            }
+            for(; (i+7) < n; i += 8) _mm512_storeu_pd(&y[i],_mm512_mul_pd(va,_mm512_loadu_pd(&y[i])));
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               _mm512_mask_storeu_pd(&y[i],k,_mm512_mul_pd(va,_mm512_maskz_loadu_pd(k,&y[i])));
+            }
+         }
+         else {
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m512d yv = _mm512_i64gather_pd(viy,&y[i*incy],8);
+                _mm512_i64scatter_pd(&y[i*incy],viy,_mm512_mul_pd(va,yv),8);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m512d  yv = _mm512_mask_i64gather_pd(_mm512_setzero_pd(),k,viy,&y[i*incy],8);
+               _mm512_mask_i64scatter_pd(&y[i*incy],k,viy,_mm512_mul_pd(va,yv),8);
+            }
+         }
+         return (0.0);
+}
+
+
+static
+double sscal_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incy = g->incy;
+         float * __restrict y = (float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incy == 1) {
+            const __m512 va = _mm512_set1_ps(g->af);
+            for(; (i+63) < n; i += 64) {
+                _mm512_storeu_ps(&y[i+0], _mm512_mul_ps(va,_mm512_loadu_ps(&y[i+0])));
+                _mm512_storeu_ps(&y[i+16],_mm512_mul_ps(va,_mm512_loadu_ps(&y[i+16])));
+                _mm512_storeu_ps(&y[i+32],_mm512_mul_ps(va,_mm512_loadu_ps(&y[i+32])));
+                _mm512_storeu_ps(&y[i+48],_mm512_mul_ps(va,_mm512_loadu_ps(&y[i+48])));
+            }
+            for(; (i+15) < n; i += 16) _mm512_storeu_ps(&y[i],_mm512_mul_ps(va,_mm512_loadu_ps(&y[i])));
+            if(i < n) {
+               const __mmask16 k = blas1_i64_mask16(n-i);
+               _mm512_mask_storeu_ps(&y[i],k,_mm512_mul_ps(va,_mm512_maskz_loadu_ps(k,&y[i])));
+            }
+         }
+         else {
+            const __m256  va  = _mm256_set1_ps(g->af);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m256 yv = _mm512_i64gather_ps(viy,&y[i*incy],4);
+                _mm512_i64scatter_ps(&y[i*incy],viy,_mm256_mul_ps(va,yv),4);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m256   yv = _mm512_mask_i64gather_ps(_mm256_setzero_ps(),k,viy,&y[i*incy],4);
+               _mm512_mask_i64scatter_ps(&y[i*incy],k,viy,_mm256_mul_ps(va,yv),4);
+            }
+         }
+         return (0.0);
+}
+
+
+/*
+     ============================== COPY ==============================
+*/
+static
+double dcopy_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const double * __restrict x = (const double*)g->x+lo*incx;
+         double * __restrict y       = (double*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                _mm512_storeu_pd(&y[i+0], _mm512_loadu_pd(&x[i+0]));
+                _mm512_storeu_pd(&y[i+8], _mm512_loadu_pd(&x[i+8]));
+                _mm512_storeu_pd(&y[i+16],_mm512_loadu_pd(&x[i+16]));
+                _mm512_storeu_pd(&y[i+24],_mm512_loadu_pd(&x[i+24]));
+            }
+            for(; (i+7) < n; i += 8) _mm512_storeu_pd(&y[i],_mm512_loadu_pd(&x[i]));
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               _mm512_mask_storeu_pd(&y[i],k,_mm512_maskz_loadu_pd(k,&x[i]));
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                _mm512_i64scatter_pd(&y[i*incy],viy,_mm512_i64gather_pd(vix,&x[i*incx],8),8);
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               _mm512_mask_i64scatter_pd(&y[i*incy],k,viy,
+                                         _mm512_mask_i64gather_pd(_mm512_setzero_pd(),k,vix,&x[i*incx],8),8);
+            }
+         }
+         return (0.0);
+}
+
+
+static
+double scopy_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const float * __restrict x = (const float*)g->x+lo*incx;
+         float * __restrict y       = (float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+63) < n; i += 64) {
+                _mm512_storeu_ps(&y[i+0], _mm512_loadu_ps(&x[i+0]));
+                _mm512_storeu_ps(&y[i+16],_mm512_loadu_ps(&x[i+16]));
+                _mm512_storeu_ps(&y[i+32],_mm512_loadu_ps(&x[i+32]));
+                _mm512_storeu_ps(&y[i+48],_mm512_loadu_ps(&x[i+48]));
+            }
+            for(; (i+15) < n; i += 16) _mm512_storeu_ps(&y[i],_mm512_loadu_ps(&x[i]));
+            if(i < n) {
+               const __mmask16 k = blas1_i64_mask16(n-i);
+               _mm512_mask_storeu_ps(&y[i],k,_mm512_maskz_loadu_ps(k,&x[i]));
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                _mm512_i64scatter_ps(&y[i*incy],viy,_mm512_i64gather_ps(vix,&x[i*incx],4),4);
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               _mm512_mask_i64scatter_ps(&y[i*incy],k,viy,
+                                         _mm512_mask_i64gather_ps(_mm256_setzero_ps(),k,vix,&x[i*incx],4),4);
+            }
+         }
+         return (0.0);
+}
+
+
+/*
+     ============================== SWAP ==============================
+*/
+static
+double dswap_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         double * __restrict x = (double*)g->x+lo*incx;
+         double * __restrict y = (double*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+15) < n; i += 16) {
+                const __m512d x0 = _mm512_loadu_pd(&x[i+0]);
+                const __m512d x1 = _mm512_loadu_pd(&x[i+8]);
+                const __m512d y0 = _mm512_loadu_pd(&y[i+0]);
+                const __m512d y1 = _mm512_loadu_pd(&y[i+8]);
+                _mm512_storeu_pd(&x[i+0],y0);
+                _mm512_storeu_pd(&x[i+8],y1);
+                _mm512_storeu_pd(&y[i+0],x0);
+                _mm512_storeu_pd(&y[i+8],x1);
+            }
+            for(; (i+7) < n; i += 8) {
+                const __m512d x0 = _mm512_loadu_pd(&x[i]);
+                _mm512_storeu_pd(&x[i],_mm512_loadu_pd(&y[i]));
+                _mm512_storeu_pd(&y[i],x0);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m512d  x0 = _mm512_maskz_loadu_pd(k,&x[i]);
+               _mm512_mask_storeu_pd(&x[i],k,_mm512_maskz_loadu_pd(k,&y[i]));
+               _mm512_mask_storeu_pd(&y[i],k,x0);
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m512d xv = _mm512_i64gather_pd(vix,&x[i*incx],8);
+                const __m512d yv = _mm512_i64gather_pd(viy,&y[i*incy],8);
+                _mm512_i64scatter_pd(&x[i*incx],vix,yv,8);
+                _mm512_i64scatter_pd(&y[i*incy],viy,xv,8);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m512d  z  = _mm512_setzero_pd();
+               const __m512d  xv = _mm512_mask_i64gather_pd(z,k,vix,&x[i*incx],8);
+               const __m512d  yv = _mm512_mask_i64gather_pd(z,k,viy,&y[i*incy],8);
+               _mm512_mask_i64scatter_pd(&x[i*incx],k,vix,yv,8);
+               _mm512_mask_i64scatter_pd(&y[i*incy],k,viy,xv,8);
+            }
+         }
+         return (0.0);
+}
+
+
+static
+double sswap_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         float * __restrict x = (float*)g->x+lo*incx;
+         float * __restrict y = (float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                const __m512 x0 = _mm512_loadu_ps(&x[i+0]);
+                const __m512 x1 = _mm512_loadu_ps(&x[i+16]);
+                const __m512 y0 = _mm512_loadu_ps(&y[i+0]);
+                const __m512 y1 = _mm512_loadu_ps(&y[i+16]);
+                _mm512_storeu_ps(&x[i+0], y0);
+                _mm512_storeu_ps(&x[i+16],y1);
+                _mm512_storeu_ps(&y[i+0], x0);
+                _mm512_storeu_ps(&y[i+16],x1);
+            }
+            for(; (i+15) < n; i += 16) {
+                const __m512 x0 = _mm512_loadu_ps(&x[i]);
+                _mm512_storeu_ps(&x[i],_mm512_loadu_ps(&y[i]));
+                _mm512_storeu_ps(&y[i],x0);
+            }
+            if(i < n) {
+               const __mmask16 k  = blas1_i64_mask16(n-i);
+               const __m512    x0 = _mm512_maskz_loadu_ps(k,&x[i]);
+               _mm512_mask_storeu_ps(&x[i],k,_mm512_maskz_loadu_ps(k,&y[i]));
+               _mm512_mask_storeu_ps(&y[i],k,x0);
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) {
+                const __m256 xv = _mm512_i64gather_ps(vix,&x[i*incx],4);
+                const __m256 yv = _mm512_i64gather_ps(viy,&y[i*incy],4);
+                _mm512_i64scatter_ps(&x[i*incx],vix,yv,4);
+                _mm512_i64scatter_ps(&y[i*incy],viy,xv,4);
+            }
+            if(i < n) {
+               const __mmask8 k  = blas1_i64_mask8(n-i);
+               const __m256   z  = _mm256_setzero_ps();
+               const __m256   xv = _mm512_mask_i64gather_ps(z,k,vix,&x[i*incx],4);
+               const __m256   yv = _mm512_mask_i64gather_ps(z,k,viy,&y[i*incy],4);
+               _mm512_mask_i64scatter_ps(&x[i*incx],k,vix,yv,4);
+               _mm512_mask_i64scatter_ps(&y[i*incy],k,viy,xv,4);
+            }
+         }
+         return (0.0);
+}
+
+
+/*
+     ============================== SETV ==============================
+*/
+static
+double dsetv_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incy = g->incy;
+         double * __restrict y = (double*)g->y+lo*incy;
+         const int64_t n  = hi-lo;
+         const __m512d va = _mm512_set1_pd(g->a);
+         int64_t i = 0;
+         if(incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                _mm512_storeu_pd(&y[i+0], va);
+                _mm512_storeu_pd(&y[i+8], va);
+                _mm512_storeu_pd(&y[i+16],va);
+                _mm512_storeu_pd(&y[i+24],va);
+            }
+            for(; (i+7) < n; i += 8) _mm512_storeu_pd(&y[i],va);
+            if(i < n) _mm512_mask_storeu_pd(&y[i],blas1_i64_mask8(n-i),va);
+         }
+         else {
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) _mm512_i64scatter_pd(&y[i*incy],viy,va,8);
+            if(i < n) _mm512_mask_i64scatter_pd(&y[i*incy],blas1_i64_mask8(n-i),viy,va,8);
+         }
+         return (0.0);
+}
+
+
+static
+double ssetv_i64_body(const int64_t lo,
+                      const int64_t hi,
+                      const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incy = g->incy;
+         float * __restrict y = (float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incy == 1) {
+            const __m512 va = _mm512_set1_ps(g->af);
+            for(; (i+63) < n; i += 64) {
+                _mm512_storeu_ps(&y[i+0], va);
+                _mm512_storeu_ps(&y[i+16],va);
+                _mm512_storeu_ps(&y[i+32],va);
+                _mm512_storeu_ps(&y[i+48],va);
+            }
+            for(; (i+15) < n; i += 16) _mm512_storeu_ps(&y[i],va);
+            if(i < n) _mm512_mask_storeu_ps(&y[i],blas1_i64_mask16(n-i),va);
+         }
+         else {
+            const __m256  va  = _mm256_set1_ps(g->af);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+7) < n; i += 8) _mm512_i64scatter_ps(&y[i*incy],viy,va,4);
+            if(i < n) _mm512_mask_i64scatter_ps(&y[i*incy],blas1_i64_mask8(n-i),viy,va,4);
+         }
+         return (0.0);
+}
+
+
+/*
+     ============================== DOT ===============================
+*/
+static
+double ddot_i64_body(const int64_t lo,
+                     const int64_t hi,
+                     const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const double * __restrict x = (const double*)g->x+lo*incx;
+         const double * __restrict y = (const double*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         __m512d s0 = _mm512_setzero_pd();
+         __m512d s1 = _mm512_setzero_pd();
+         __m512d s2 = _mm512_setzero_pd();
+         __m512d s3 = _mm512_setzero_pd();
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            for(; (i+31) < n; i += 32) {
+                s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0]), s0);
+                s1 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8]), s1);
+                s2 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16]),s2);
+                s3 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24]),s3);
+            }
+            for(; (i+7) < n; i += 8) {
+                s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i]),s0);
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k,&x[i]),_mm512_maskz_loadu_pd(k,&y[i]),s1);
+            }
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            for(; (i+15) < n; i += 16) {
+                s0 = _mm512_fmadd_pd(_mm512_i64gather_pd(vix,&x[i*incx],8),
+                                     _mm512_i64gather_pd(viy,&y[i*incy],8),s0);
+                s1 = _mm512_fmadd_pd(_mm512_i64gather_pd(vix,&x[(i+8)*incx],8),
+                                     _mm512_i64gather_pd(viy,&y[(i+8)*incy],8),s1);
+            }
+            for(; (i+7) < n; i += 8) {
+                s2 = _mm512_fmadd_pd(_mm512_i64gather_pd(vix,&x[i*incx],8),
+                                     _mm512_i64gather_pd(viy,&y[i*incy],8),s2);
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               const __m512d  z = _mm512_setzero_pd();
+               s3 = _mm512_fmadd_pd(_mm512_mask_i64gather_pd(z,k,vix,&x[i*incx],8),
+                                    _mm512_mask_i64gather_pd(z,k,viy,&y[i*incy],8),s3);
+            }
+         }
+         return (_mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0,s1),_mm512_add_pd(s2,s3))));
+}
+
+
+static
+double sdot_i64_body(const int64_t lo,
+                     const int64_t hi,
+                     const blas1_i64_args_t * __restrict g) {
+
+         const int64_t incx = g->incx;
+         const int64_t incy = g->incy;
+         const float * __restrict x = (const float*)g->x+lo*incx;
+         const float * __restrict y = (const float*)g->y+lo*incy;
+         const int64_t n = hi-lo;
+         int64_t i = 0;
+         if(incx == 1 && incy == 1) {
+            __m512 s0 = _mm512_setzero_ps();
+            __m512 s1 = _mm512_setzero_ps();
+            __m512 s2 = _mm512_setzero_ps();
+            __m512 s3 = _mm512_setzero_ps();
+            for(; (i+63) < n; i += 64) {
+                s0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+0]), _mm512_loadu_ps(&y[i+0]), s0);
+                s1 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+16]),_mm512_loadu_ps(&y[i+16]),s1);
+                s2 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+32]),_mm512_loadu_ps(&y[i+32]),s2);
+                s3 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+48]),_mm512_loadu_ps(&y[i+48]),s3);
+            }
+            for(; (i+15) < n; i += 16) {
+                s0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i]),_mm512_loadu_ps(&y[i]),s0);
+            }
+            if(i < n) {
+               const __mmask16 k = blas1_i64_mask16(n-i);
+               s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k,&x[i]),_mm512_maskz_loadu_ps(k,&y[i]),s1);
+            }
+            return ((double)_mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(s0,s1),_mm512_add_ps(s2,s3))));
+         }
+         else {
+            const __m512i vix = blas1_i64_vidx(incx);
+            const __m512i viy = blas1_i64_vidx(incy);
+            __m256 s0 = _mm256_setzero_ps();
+            __m256 s1 = _mm256_setzero_ps();
+            for(; (i+15) < n; i += 16) {
+                s0 = _mm256_fmadd_ps(_mm512_i64gather_ps(vix,&x[i*incx],4),
+                                     _mm512_i64gather_ps(viy,&y[i*incy],4),s0);
+                s1 = _mm256_fmadd_ps(_mm512_i64gather_ps(vix,&x[(i+8)*incx],4),
+                                     _mm512_i64gather_ps(viy,&y[(i+8)*incy],4),s1);
+            }
+            for(; (i+7) < n; i += 8) {
+                s0 = _mm256_fmadd_ps(_mm512_i64gather_ps(vix,&x[i*incx],4),
+                                     _mm512_i64gather_ps(viy,&y[i*incy],4),s0);
+            }
+            if(i < n) {
+               const __mmask8 k = blas1_i64_mask8(n-i);
+               const __m256   z = _mm256_setzero_ps();
+               s1 = _mm256_fmadd_ps(_mm512_mask_i64gather_ps(z,k,vix,&x[i*incx],4),
+                                    _mm512_mask_i64gather_ps(z,k,viy,&y[i*incy],4),s1);
+            }
+            s0 = _mm256_add_ps(s0,s1);
+            {
+               const __m128 h = _mm_add_ps(_mm256_castps256_ps128(s0),_mm256_extractf128_ps(s0,1));
+               const __m128 q = _mm_add_ps(h,_mm_movehl_ps(h,h));
+               return ((double)_mm_cvtss_f32(_mm_add_ss(q,_mm_shuffle_ps(q,q,0x55))));
+            }
+         }
+}
+
+
+/*
+     ============================ Entry points ========================
+*/
+int32_t daxpy_i64(const int64_t n,
+                  const double a,
+                  const double * __restrict x,
+                  const int64_t incx,
+                  double * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incy == 0,0)) return (-1);
+         if(n == 0 || a == 0.0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = a; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,daxpy_i64_body,&g);
+         return (0);
+}
+
+
+int32_t saxpy_i64(const int64_t n,
+                  const float a,
+                  const float * __restrict x,
+                  const int64_t incx,
+                  float * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incy == 0,0)) return (-1);
+         if(n == 0 || a == 0.0f) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = a;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,saxpy_i64_body,&g);
+         return (0);
+}
+
+
+int32_t dscal_i64(const int64_t n,
+                  const double a,
+                  double * __restrict x,
+                  const int64_t incx) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         g.a = a; g.af = 0.0f;
+         g.x = NULL; g.incx = 0;
+         g.y = BLAS1_I64_BASE(x,n,incx); g.incy = incx;
+         (void)blas1_i64_parallel(n,dscal_i64_body,&g);
+         return (0);
+}
+
+
+int32_t sscal_i64(const int64_t n,
+                  const float a,
+                  float * __restrict x,
+                  const int64_t incx) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         g.a = 0.0; g.af = a;
+         g.x = NULL; g.incx = 0;
+         g.y = BLAS1_I64_BASE(x,n,incx); g.incy = incx;
+         (void)blas1_i64_parallel(n,sscal_i64_body,&g);
+         return (0);
+}
+
+
+int32_t dcopy_i64(const int64_t n,
+                  const double * __restrict x,
+                  const int64_t incx,
+                  double * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incy == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,dcopy_i64_body,&g);
+         return (0);
+}
+
+
+int32_t scopy_i64(const int64_t n,
+                  const float * __restrict x,
+                  const int64_t incx,
+                  float * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incy == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,scopy_i64_body,&g);
+         return (0);
+}
+
+
+int32_t dswap_i64(const int64_t n,
+                  double * __restrict x,
+                  const int64_t incx,
+                  double * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0 || incy == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,dswap_i64_body,&g);
+         return (0);
+}
+
+
+int32_t sswap_i64(const int64_t n,
+                  float * __restrict x,
+                  const int64_t incx,
+                  float * __restrict y,
+                  const int64_t incy) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0 || incy == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         (void)blas1_i64_parallel(n,sswap_i64_body,&g);
+         return (0);
+}
+
+
+int32_t dsetv_i64(const int64_t n,
+                  const double a,
+                  double * __restrict x,
+                  const int64_t incx) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         g.a = a; g.af = 0.0f;
+         g.x = NULL; g.incx = 0;
+         g.y = BLAS1_I64_BASE(x,n,incx); g.incy = incx;
+         (void)blas1_i64_parallel(n,dsetv_i64_body,&g);
+         return (0);
+}
+
+
+int32_t ssetv_i64(const int64_t n,
+                  const float a,
+                  float * __restrict x,
+                  const int64_t incx) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(n < 0 || incx == 0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         g.a = 0.0; g.af = a;
+         g.x = NULL; g.incx = 0;
+         g.y = BLAS1_I64_BASE(x,n,incx); g.incy = incx;
+         (void)blas1_i64_parallel(n,ssetv_i64_body,&g);
+         return (0);
+}
+
+
+int32_t ddot_i64(const int64_t n,
+                 const double * __restrict x,
+                 const int64_t incx,
+                 const double * __restrict y,
+                 const int64_t incy,
+                 double * __restrict rho) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(NULL==rho || n < 0,0)) return (-1);
+         *rho = 0.0;
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = (void*)BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         *rho = blas1_i64_parallel(n,ddot_i64_body,&g);
+         return (0);
+}
+
+
+int32_t sdot_i64(const int64_t n,
+                 const float * __restrict x,
+                 const int64_t incx,
+                 const float * __restrict y,
+                 const int64_t incy,
+                 float * __restrict rho) {
+
+         blas1_i64_args_t g;
+         if(__builtin_expect(NULL==rho || n < 0,0)) return (-1);
+         *rho = 0.0f;
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         g.a = 0.0; g.af = 0.0f;
+         g.x = BLAS1_I64_BASE(x,n,incx); g.incx = incx;
+         g.y = (void*)BLAS1_I64_BASE(y,n,incy); g.incy = incy;
+         *rho = (float)blas1_i64_parallel(n,sdot_i64_body,&g);
+         return (0);
+}
@@ -0,0 +1,167 @@
+
+
+#ifndef __GMS_BLAS1_I64_H__
+#define __GMS_BLAS1_I64_H__
+
+//
+// BLAS-1 kernels with 64-bit element counts, arbitrary strides and a
+// single threading backend.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 19:30 PM +00200
+//
+// Counts and strides are int64_t (ensemble buffers above 2^31 elements).
+// Strides follow the reference BLAS rules: negative increments walk the
+// vector backwards from x[(1-n)*incx], incx == 0 on an input broadcasts
+// one element; an output increment of 0 is rejected.
+// incx == incy == 1  -> contiguous AVX512 loops (unaligned loads, masked tail)
+// otherwise          -> AVX512 gathers/scatters with 64-bit indices.
+// There is one entry point per kernel (no _omp duplicates): every kernel
+// hands its chunk body to blas1_i64_parallel(), which splits [0,n) into one
+// contiguous range per thread above BLAS1_I64_PAR_MIN elements and runs it
+// serially below. Reductions (dot) are combined in range order, so results
+// are reproducible for a given thread count.
+// Return values: 0 success, -1 invalid argument.
+//
+
+#include <stdint.h>
+
+
+// Below this count the kernels run on the calling thread.
+#if !defined(BLAS1_I64_PAR_MIN)
+    #define BLAS1_I64_PAR_MIN 131072LL
+#endif
+
+
+typedef struct {
+        double       a;
+        float        af;
+        const void * x;
+        int64_t      incx;
+        void *       y;
+        int64_t      incy;
+} blas1_i64_args_t;
+
+// Chunk body: processes elements [lo,hi), returns its partial reduction (or 0).
+typedef double (*blas1_i64_body_fn)(const int64_t,
+                                    const int64_t,
+                                    const blas1_i64_args_t * __restrict);
+
+
+// Thread count used by the backend: 0 -> omp_get_max_threads().
+void    blas1_i64_set_num_threads(const int32_t);
+
+int32_t blas1_i64_get_num_threads(void);
+
+// Runs body over [0,n) and returns the sum of the partial results in range order.
+double  blas1_i64_parallel(const int64_t,
+                           const blas1_i64_body_fn,
+                           const blas1_i64_args_t * __restrict)  __attribute__((hot))
+                                                                 __attribute__((aligned(32)));
+
+
+// y := a*x + y
+int32_t daxpy_i64(const int64_t,
+                  const double,
+                  const double * __restrict,
+                  const int64_t,
+                  double * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t saxpy_i64(const int64_t,
+                  const float,
+                  const float * __restrict,
+                  const int64_t,
+                  float * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+// x := a*x
+int32_t dscal_i64(const int64_t,
+                  const double,
+                  double * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t sscal_i64(const int64_t,
+                  const float,
+                  float * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+// y := x
+int32_t dcopy_i64(const int64_t,
+                  const double * __restrict,
+                  const int64_t,
+                  double * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t scopy_i64(const int64_t,
+                  const float * __restrict,
+                  const int64_t,
+                  float * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+// x <-> y
+int32_t dswap_i64(const int64_t,
+                  double * __restrict,
+                  const int64_t,
+                  double * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t sswap_i64(const int64_t,
+                  float * __restrict,
+                  const int64_t,
+                  float * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+// x := a
+int32_t dsetv_i64(const int64_t,
+                  const double,
+                  double * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t ssetv_i64(const int64_t,
+                  const float,
+                  float * __restrict,
+                  const int64_t)          __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+// *rho := x'*y (sdot accumulates in fp32 per lane, partial sums combined in fp64)
+int32_t ddot_i64(const int64_t,
+                 const double * __restrict,
+                 const int64_t,
+                 const double * __restrict,
+                 const int64_t,
+                 double * __restrict)     __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+int32_t sdot_i64(const int64_t,
+                 const float * __restrict,
+                 const int64_t,
+                 const float * __restrict,
+                 const int64_t,
+                 float * __restrict)      __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_BLAS1_I64_H__*/
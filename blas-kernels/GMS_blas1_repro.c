@@ -0,0 +1,589 @@
+
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_blas1_repro.h"
+
+
+#define REPRO_DOT  0
+#define REPRO_SSQ  1
+#define REPRO_ASUM 2
+
+// Chunk partials kept on the stack up to this many chunks.
+#define REPRO_STK_CHUNKS 256
+// sum(x^2) below this may have lost underflowed squares -> scaled pass.
+#define REPRO_SSQ_TINY   0x1p-900
+
+
+typedef struct {
+        double hi;
+        double lo;
+} repro_dd_t;
+
+typedef repro_dd_t (*repro_chunk_fn)(const double * __restrict,
+                                     const double * __restrict,
+                                     const int64_t,
+                                     const double);
+
+
+/*
+     Error-free transformations.
+*/
+__attribute__((always_inline))
+static inline
+void repro_two_sum(const double a,
+                   const double b,
+                   double * __restrict s,
+                   double * __restrict e) {
+         const double t = a+b;
+         const double z = t-a;
+         *s = t;
+         *e = (a-(t-z))+(b-z);
+}
+
+
+__attribute__((always_inline))
+static inline
+repro_dd_t repro_dd_add(const repro_dd_t a,
+                        const repro_dd_t b) {
+         repro_dd_t r;
+         double s,e,t;
+         repro_two_sum(a.hi,b.hi,&s,&e);
+         e += a.lo+b.lo;
+         t    = s+e;
+         r.lo = e-(t-s);
+         r.hi = t;
+         return (r);
+}
+
+
+/*
+     Per-element term: p (+ its rounding error pe for the compensated mode).
+*/
+__attribute__((always_inline))
+static inline
+__m512d repro_term(const int32_t kind,
+                   const __m512d xv,
+                   const __m512d yv,
+                   const __m512d vs,
+                   __m512d * __restrict pe) {
+         __m512d p;
+         switch(kind) {
+         case REPRO_DOT:
+              p   = _mm512_mul_pd(xv,yv);
+              *pe = _mm512_fmsub_pd(xv,yv,p);
+              break;
+         case REPRO_SSQ: {
+              const __m512d xs = _mm512_mul_pd(xv,vs);
+              p   = _mm512_mul_pd(xs,xs);
+              *pe = _mm512_fmsub_pd(xs,xs,p);
+              }
+              break;
+         default:
+              p   = _mm512_abs_pd(xv);
+              *pe = _mm512_setzero_pd();
+              break;
+         }
+         return (p);
+}
+
+
+__attribute__((always_inline))
+static inline
+__m512d repro_fma(const int32_t kind,
+                  const __m512d xv,
+                  const __m512d yv,
+                  const __m512d vs,
+                  const __m512d acc) {
+         switch(kind) {
+         case REPRO_DOT:
+              return (_mm512_fmadd_pd(xv,yv,acc));
+         case REPRO_SSQ: {
+              const __m512d xs = _mm512_mul_pd(xv,vs);
+              return (_mm512_fmadd_pd(xs,xs,acc));
+              }
+         default:
+              return (_mm512_add_pd(_mm512_abs_pd(xv),acc));
+         }
+}
+
+
+/*
+     Plain chunk: 4 ZMM accumulators, fixed reduction order.
+*/
+__attribute__((always_inline))
+static inline
+repro_dd_t repro_chunk_tree(const int32_t kind,
+                            const double * __restrict x,
+                            const double * __restrict y,
+                            const int64_t len,
+                            const double scale) {
+
+         const __m512d vs = _mm512_set1_pd(scale);
+         __m512d a0 = _mm512_setzero_pd();
+         __m512d a1 = _mm512_setzero_pd();
+         __m512d a2 = _mm512_setzero_pd();
+         __m512d a3 = _mm512_setzero_pd();
+         repro_dd_t r;
+         int64_t i = 0;
+         for(; (i+31) < len; i += 32) {
+             a0 = repro_fma(kind,_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0]), vs,a0);
+             a1 = repro_fma(kind,_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8]), vs,a1);
+             a2 = repro_fma(kind,_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16]),vs,a2);
+             a3 = repro_fma(kind,_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24]),vs,a3);
+         }
+         for(; (i+7) < len; i += 8) {
+             a0 = repro_fma(kind,_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i]),vs,a0);
+         }
+         if(i < len) {
+            const __mmask8 k = (__mmask8)((1U << (len-i))-1U);
+            a1 = repro_fma(kind,_mm512_maskz_loadu_pd(k,&x[i]),_mm512_maskz_loadu_pd(k,&y[i]),vs,a1);
+         }
+         r.hi = _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0,a1),_mm512_add_pd(a2,a3)));
+         r.lo = 0.0;
+         return (r);
+}
+
+
+/*
+     Compensated chunk (Ogita/Rump/Oishi Dot2 per lane): s accumulates the
+     rounded terms, c the TwoProd and TwoSum errors. 4 independent (s,c)
+     pairs keep the FP pipes busy; the 32 lanes are folded in a fixed order
+     with TwoSum at the end of the chunk.
+*/
+#define REPRO_COMP_STEP(s,c,xv,yv) do {                         \
+            __m512d pe_,z_,t_,e_;                               \
+            const __m512d p_ = repro_term(kind,xv,yv,vs,&pe_);  \
+            t_ = _mm512_add_pd(s,p_);                           \
+            z_ = _mm512_sub_pd(t_,s);                           \
+            e_ = _mm512_add_pd(_mm512_sub_pd(s,_mm512_sub_pd(t_,z_)), \
+                               _mm512_sub_pd(p_,z_));           \
+            c  = _mm512_add_pd(c,_mm512_add_pd(e_,pe_));        \
+            s  = t_;                                            \
+        } while(0)
+
+__attribute__((always_inline))
+static inline
+repro_dd_t repro_chunk_comp(const int32_t kind,
+                            const double * __restrict x,
+                            const double * __restrict y,
+                            const int64_t len,
+                            const double scale) {
+
+         __attribute__((aligned(64))) double sv[32];
+         __attribute__((aligned(64))) double cv[32];
+         const __m512d vs = _mm512_set1_pd(scale);
+         __m512d s0 = _mm512_setzero_pd(), c0 = _mm512_setzero_pd();
+         __m512d s1 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd();
+         __m512d s2 = _mm512_setzero_pd(), c2 = _mm512_setzero_pd();
+         __m512d s3 = _mm512_setzero_pd(), c3 = _mm512_setzero_pd();
+         repro_dd_t r;
+         double hi,lo,e;
+         int64_t i = 0;
+         int32_t j;
+         for(; (i+31) < len; i += 32) {
+             REPRO_COMP_STEP(s0,c0,_mm512_loadu_pd(&x[i+0]), _mm512_loadu_pd(&y[i+0]));
+             REPRO_COMP_STEP(s1,c1,_mm512_loadu_pd(&x[i+8]), _mm512_loadu_pd(&y[i+8]));
+             REPRO_COMP_STEP(s2,c2,_mm512_loadu_pd(&x[i+16]),_mm512_loadu_pd(&y[i+16]));
+             REPRO_COMP_STEP(s3,c3,_mm512_loadu_pd(&x[i+24]),_mm512_loadu_pd(&y[i+24]));
+         }
+         for(; (i+7) < len; i += 8) {
+             REPRO_COMP_STEP(s0,c0,_mm512_loadu_pd(&x[i]),_mm512_loadu_pd(&y[i]));
+         }
+         if(i < len) {
+            const __mmask8 k = (__mmask8)((1U << (len-i))-1U);
+            REPRO_COMP_STEP(s1,c1,_mm512_maskz_loadu_pd(k,&x[i]),_mm512_maskz_loadu_pd(k,&y[i]));
+         }
+         _mm512_store_pd(&sv[0], s0); _mm512_store_pd(&cv[0], c0);
+         _mm512_store_pd(&sv[8], s1); _mm512_store_pd(&cv[8], c1);
+         _mm512_store_pd(&sv[16],s2); _mm512_store_pd(&cv[16],c2);
+         _mm512_store_pd(&sv[24],s3); _mm512_store_pd(&cv[24],c3);
+         hi = 0.0;
+         lo = 0.0;
+         for(j = 0; j != 32; ++j) {
+             repro_two_sum(hi,sv[j],&hi,&e);
+             lo += e+cv[j];
+         }
+         r.hi = hi+lo;
+         r.lo = lo-(r.hi-hi);
+         return (r);
+}
+
+
+#define REPRO_CHUNK_DEF(name,kind,mode)                                  \
+static repro_dd_t name(const double * __restrict x,                      \
+                       const double * __restrict y,                      \
+                       const int64_t len,                                \
+                       const double scale) {                             \
+         return (repro_chunk_##mode(kind,x,y,len,scale));                \
+}
+
+REPRO_CHUNK_DEF(repro_dot_tree, REPRO_DOT, tree)
+REPRO_CHUNK_DEF(repro_dot_comp, REPRO_DOT, comp)
+REPRO_CHUNK_DEF(repro_ssq_tree, REPRO_SSQ, tree)
+REPRO_CHUNK_DEF(repro_ssq_comp, REPRO_SSQ, comp)
+REPRO_CHUNK_DEF(repro_asum_tree,REPRO_ASUM,tree)
+REPRO_CHUNK_DEF(repro_asum_comp,REPRO_ASUM,comp)
+
+static const repro_chunk_fn repro_chunk_tab[3][2] = {
+        {repro_dot_tree, repro_dot_comp},
+        {repro_ssq_tree, repro_ssq_comp},
+        {repro_asum_tree,repro_asum_comp}
+};
+
+
+/*
+     Fixed pairwise tree over the chunk partials (split point depends on
+     the chunk count only).
+*/
+static
+repro_dd_t repro_tree(const repro_dd_t * __restrict p,
+                      const int64_t n,
+                      const int32_t comp) {
+
+         repro_dd_t l,r;
+         if(n == 1) return (p[0]);
+         l = repro_tree(p,n/2,comp);
+         r = repro_tree(p+n/2,n-n/2,comp);
+         if(comp) return (repro_dd_add(l,r));
+         l.hi += r.hi;
+         return (l);
+}
+
+
+static
+int32_t repro_reduce(const int32_t kind,
+                     const int32_t mode,
+                     const int32_t par,
+                     const int64_t n,
+                     const double * __restrict x,
+                     const double * __restrict y,
+                     const double scale,
+                     repro_dd_t * __restrict res) {
+
+         repro_dd_t stk[REPRO_STK_CHUNKS];
+         repro_dd_t * __restrict part = &stk[0];
+         const int32_t comp = (mode == BLAS1_REPRO_COMP);
+         const repro_chunk_fn fn = repro_chunk_tab[kind][comp];
+         const int64_t nch = (n+BLAS1_REPRO_CHUNK-1)/BLAS1_REPRO_CHUNK;
+         int64_t c;
+         if(nch > REPRO_STK_CHUNKS) {
+            part = (repro_dd_t*)malloc((size_t)nch*sizeof(repro_dd_t));
+            if(__builtin_expect(NULL==part,0)) return (-2);
+         }
+#if defined(_OPENMP)
+         if(par && n >= BLAS1_REPRO_OMP_MIN && omp_get_max_threads() > 1) {
+#pragma omp parallel for schedule(static) default(none) shared(part,x,y) \
+                         firstprivate(nch,n,fn,scale) private(c)
+            for(c = 0; c < nch; ++c) {
+                const int64_t lo  = c*BLAS1_REPRO_CHUNK;
+                const int64_t len = (n-lo < BLAS1_REPRO_CHUNK) ? n-lo : BLAS1_REPRO_CHUNK;
+                part[c] = fn(&x[lo],&y[lo],len,scale);
+            }
+         }
+         else
+#endif
+         {
+            (void)par;
+            for(c = 0; c < nch; ++c) {
+                const int64_t lo  = c*BLAS1_REPRO_CHUNK;
+                const int64_t len = (n-lo < BLAS1_REPRO_CHUNK) ? n-lo : BLAS1_REPRO_CHUNK;
+                part[c] = fn(&x[lo],&y[lo],len,scale);
+            }
+         }
+         *res = repro_tree(part,nch,comp);
+         if(part != &stk[0]) free(part);
+         return (0);
+}
+
+
+// max|x| is order independent, so any partition is reproducible.
+static
+double repro_amax(const int64_t n,
+                  const double * __restrict x,
+                  const int32_t par) {
+
+         double m = 0.0;
+         int64_t i;
+         (void)par;
+#if defined(_OPENMP)
+#pragma omp parallel for simd schedule(static) default(none) shared(x) \
+                         firstprivate(n,par) private(i) reduction(max:m) if(par && n >= BLAS1_REPRO_OMP_MIN)
+#endif
+         for(i = 0; i < n; ++i) {
+             const double a = fabs(x[i]);
+             m = (a > m) ? a : m;
+         }
+         return (m);
+}
+
+
+static
+int32_t ddot_repro_impl(const int64_t n,
+                        const double * __restrict x,
+                        const double * __restrict y,
+                        const int32_t mode,
+                        const int32_t par,
+                        double * __restrict rho) {
+
+         repro_dd_t r;
+         int32_t ret;
+         if(__builtin_expect(NULL==rho || n < 0,0)) return (-1);
+         if(__builtin_expect(mode != BLAS1_REPRO_TREE && mode != BLAS1_REPRO_COMP,0)) return (-1);
+         *rho = 0.0;
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         ret = repro_reduce(REPRO_DOT,mode,par,n,x,y,1.0,&r);
+         if(ret == 0) *rho = r.hi;
+         return (ret);
+}
+
+
+static
+int32_t dasum_repro_impl(const int64_t n,
+                         const double * __restrict x,
+                         const int32_t mode,
+                         const int32_t par,
+                         double * __restrict asum) {
+
+         repro_dd_t r;
+         int32_t ret;
+         if(__builtin_expect(NULL==asum || n < 0,0)) return (-1);
+         if(__builtin_expect(mode != BLAS1_REPRO_TREE && mode != BLAS1_REPRO_COMP,0)) return (-1);
+         *asum = 0.0;
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         ret = repro_reduce(REPRO_ASUM,mode,par,n,x,x,1.0,&r);
+         if(ret == 0) *asum = r.hi;
+         return (ret);
+}
+
+
+// sqrt of a double-double, rounded once (lo == 0 in the plain mode).
+__attribute__((always_inline))
+static inline
+double repro_sqrt_dd(const repro_dd_t r) {
+         const double q = sqrt(r.hi);
+         if(q == 0.0 || !isfinite(q)) return (q);
+         return (q+(fma(-q,q,r.hi)+r.lo)/(2.0*q));
+}
+
+
+static
+int32_t dnrm2_repro_impl(const int64_t n,
+                         const double * __restrict x,
+                         const int32_t mode,
+                         const int32_t par,
+                         double * __restrict nrm) {
+
+         repro_dd_t r;
+         double amax;
+         int32_t ret,e;
+         if(__builtin_expect(NULL==nrm || n < 0,0)) return (-1);
+         if(__builtin_expect(mode != BLAS1_REPRO_TREE && mode != BLAS1_REPRO_COMP,0)) return (-1);
+         *nrm = 0.0;
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x,0)) return (-1);
+         ret = repro_reduce(REPRO_SSQ,mode,par,n,x,x,1.0,&r);
+         if(ret != 0) return (ret);
+         if(isfinite(r.hi) && r.hi >= REPRO_SSQ_TINY) {
+            *nrm = repro_sqrt_dd(r);
+            return (0);
+         }
+         // Overflow (inf, or NaN from inf-inf in the TwoSum), NaN input or
+         // possible underflow: rescale by an exact power of 2. A NaN in x
+         // propagates through the scaled pass.
+         amax = repro_amax(n,x,par);
+         if(amax == 0.0 || isinf(amax)) {
+            *nrm = amax;
+            return (0);
+         }
+         e = -ilogb(amax);
+         if(e >  1023) e =  1023;
+         if(e < -1022) e = -1022;
+         ret = repro_reduce(REPRO_SSQ,mode,par,n,x,x,ldexp(1.0,e),&r);
+         if(ret == 0) *nrm = ldexp(repro_sqrt_dd(r),-e);
+         return (ret);
+}
+
+
+int32_t ddot_repro(const int64_t n,
+                   const double * __restrict x,
+                   const double * __restrict y,
+                   const int32_t mode,
+                   double * __restrict rho) {
+         return (ddot_repro_impl(n,x,y,mode,0,rho));
+}
+
+
+int32_t ddot_repro_omp(const int64_t n,
+                       const double * __restrict x,
+                       const double * __restrict y,
+                       const int32_t mode,
+                       double * __restrict rho) {
+         return (ddot_repro_impl(n,x,y,mode,1,rho));
+}
+
+
+int32_t dnrm2_repro(const int64_t n,
+                    const double * __restrict x,
+                    const int32_t mode,
+                    double * __restrict nrm) {
+         return (dnrm2_repro_impl(n,x,mode,0,nrm));
+}
+
+
+int32_t dnrm2_repro_omp(const int64_t n,
+                        const double * __restrict x,
+                        const int32_t mode,
+                        double * __restrict nrm) {
+         return (dnrm2_repro_impl(n,x,mode,1,nrm));
+}
+
+
+int32_t dasum_repro(const int64_t n,
+                    const double * __restrict x,
+                    const int32_t mode,
+                    double * __restrict asum) {
+         return (dasum_repro_impl(n,x,mode,0,asum));
+}
+
+
+int32_t dasum_repro_omp(const int64_t n,
+                        const double * __restrict x,
+                        const int32_t mode,
+                        double * __restrict asum) {
+         return (dasum_repro_impl(n,x,mode,1,asum));
+}
+
+
+/*
+     Validation
+*/
+static uint64_t repro_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+// Uniform in [-1,1) times 2^k, k in [-20,19].
+static double repro_draw(uint64_t * __restrict s) {
+
+         const double u = (double)(repro_rng(s) >> 11) * 0x1.0p-52 - 1.0;
+         return (ldexp(u,(int32_t)(repro_rng(s) % 40ULL)-20));
+}
+
+// Result of op (0 dot, 1 nrm2, 2 asum) in mode, serial or _omp.
+static int32_t repro_call(const int32_t op,
+                          const int32_t mode,
+                          const int32_t par,
+                          const int64_t n,
+                          const double * __restrict x,
+                          const double * __restrict y,
+                          double * __restrict r) {
+
+         switch(op) {
+         case 0:  return (par ? ddot_repro_omp(n,x,y,mode,r)  : ddot_repro(n,x,y,mode,r));
+         case 1:  return (par ? dnrm2_repro_omp(n,x,mode,r)   : dnrm2_repro(n,x,mode,r));
+         default: return (par ? dasum_repro_omp(n,x,mode,r)   : dasum_repro(n,x,mode,r));
+         }
+}
+
+int32_t blas1_repro_validate(FILE * __restrict fp,
+                             const uint64_t seed) {
+
+         static const char * const opn[3] = {"dot","nrm2","asum"};
+         static const int32_t nthr[] = {1,2,3,4,7,8,16,32};
+         const int64_t C = BLAS1_REPRO_CHUNK;
+         const int64_t M = BLAS1_REPRO_OMP_MIN;
+         // Lengths around the chunk, OpenMP and stack/heap partial boundaries.
+         const int64_t lens[] = {1,7,8,33,C-1,C,C+1,3*C+17,M-1,M,M+C/2+3,
+                                 REPRO_STK_CHUNKS*C,REPRO_STK_CHUNKS*C+1};
+         const int32_t nlen = (int32_t)(sizeof(lens)/sizeof(lens[0]));
+         const int64_t nmax = REPRO_STK_CHUNKS*C+1;
+         double *x = NULL,*y = NULL,*xe = NULL,*ye = NULL;
+         uint64_t s = seed;
+         int32_t tmax = 1;
+         int32_t nbad = 0;
+         int32_t l,mode,op,t;
+         int64_t i;
+         if(NULL==fp) return (-1);
+#if defined(_OPENMP)
+         tmax = omp_get_max_threads();
+#endif
+         x  = (double*)malloc((size_t)nmax*sizeof(double));
+         y  = (double*)malloc((size_t)nmax*sizeof(double));
+         xe = (double*)malloc((size_t)nmax*sizeof(double));
+         ye = (double*)malloc((size_t)nmax*sizeof(double));
+         if(NULL==x || NULL==y || NULL==xe || NULL==ye) {
+            nbad = -1;
+            goto done;
+         }
+         // x, y: full-precision values over 40 binades (the sums round);
+         // xe, ye: multiples of 2^-10 below 1, whose sums are exact in any order.
+         for(i = 0; i != nmax; ++i) {
+             x[i]  = repro_draw(&s);
+             y[i]  = repro_draw(&s);
+             xe[i] = (double)((int64_t)(repro_rng(&s) % 2001ULL)-1000)*0x1.0p-10;
+             ye[i] = (double)((int64_t)(repro_rng(&s) % 2001ULL)-1000)*0x1.0p-10;
+         }
+         fprintf(fp,"Reproducible reductions, chunk %lld, 1..%d threads: bitwise equal to the\n"
+                    "serial result on random data, exact on exactly summable data\n",
+                 (long long)C,(tmax > 4) ? tmax : 4);
+         for(l = 0; l != nlen; ++l) {
+             const int64_t n = lens[l];
+             int64_t idot = 0,issq = 0,iasum = 0;
+             double ex[3];
+             for(i = 0; i != n; ++i) {
+                 const int64_t a = (int64_t)(xe[i]*1024.0);
+                 const int64_t b = (int64_t)(ye[i]*1024.0);
+                 idot  += a*b;
+                 issq  += a*a;
+                 iasum += (a < 0) ? -a : a;
+             }
+             ex[0] = (double)idot*0x1.0p-20;
+             ex[1] = sqrt((double)issq*0x1.0p-20);
+             ex[2] = (double)iasum*0x1.0p-10;
+             for(mode = BLAS1_REPRO_TREE; mode <= BLAS1_REPRO_COMP; ++mode) {
+                 fprintf(fp,"  n=%8lld %-4s",(long long)n,(mode == BLAS1_REPRO_TREE) ? "tree" : "comp");
+                 for(op = 0; op != 3; ++op) {
+                     double r0,r,re;
+                     int32_t bad = 0;
+                     bad |= (repro_call(op,mode,0,n,x,y,&r0) != 0);
+                     bad |= (repro_call(op,mode,0,n,xe,ye,&re) != 0 || re != ex[op]);
+                     for(t = 0; t != (int32_t)(sizeof(nthr)/sizeof(nthr[0])); ++t) {
+                         if(nthr[t] > 4 && nthr[t] > tmax) break;
+#if defined(_OPENMP)
+                         omp_set_num_threads(nthr[t]);
+#endif
+                         bad |= (repro_call(op,mode,1,n,x,y,&r) != 0 || memcmp(&r,&r0,sizeof(r)) != 0);
+                         bad |= (repro_call(op,mode,1,n,xe,ye,&re) != 0 || re != ex[op]);
+                     }
+#if defined(_OPENMP)
+                     if(tmax > 32) {
+                        omp_set_num_threads(tmax);
+                        bad |= (repro_call(op,mode,1,n,x,y,&r) != 0 || memcmp(&r,&r0,sizeof(r)) != 0);
+                     }
+                     omp_set_num_threads(tmax);
+#endif
+                     nbad += bad;
+                     fprintf(fp,"  %s %s",opn[op],bad ? "FAIL" : "ok");
+                 }
+                 fprintf(fp,"\n");
+             }
+         }
+done:
+         free(x);
+         free(y);
+         free(xe);
+         free(ye);
+         return (nbad);
+}
@@ -0,0 +1,109 @@
+
+
+#ifndef __GMS_BLAS1_REPRO_H__
+#define __GMS_BLAS1_REPRO_H__
+
+//
+// Reproducible (and optionally compensated) reductions: dot, nrm2, asum.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 20:00 PM +00200
+//
+// ddotv_a_zmm8r8_unroll10x_omp and friends combine per-thread partial sums
+// in scheduling order, so the last bits of the result change from run to
+// run and with the thread count. The kernels below fix the summation order
+// independently of threading:
+//   - [0,n) is cut into fixed BLAS1_REPRO_CHUNK-element chunks (counted from
+//     element 0, not from the thread ranges);
+//   - every chunk is reduced by the same AVX512 lane/accumulator schedule;
+//   - the chunk partials are combined by a fixed pairwise tree.
+// Serial and _omp versions therefore return bitwise identical results for
+// any thread count and schedule (on the same ISA/build).
+//
+// Modes:
+//   BLAS1_REPRO_TREE  plain FMA accumulation, fixed tree (speed of the plain kernels)
+//   BLAS1_REPRO_COMP  Dot2/Kahan-style compensated accumulation: TwoProd (FMA)
+//                     + TwoSum per lane, double-double chunk partials and tree;
+//                     result as if computed in ~2x working precision, then rounded.
+//
+// dnrm2_repro computes sum(x^2) in one pass and falls back to a power-of-2
+// scaled second pass only if that overflows or underflows.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+#define BLAS1_REPRO_TREE 0
+#define BLAS1_REPRO_COMP 1
+
+// Elements per chunk (fixed reduction unit, must stay constant for reproducibility).
+#if !defined(BLAS1_REPRO_CHUNK)
+    #define BLAS1_REPRO_CHUNK 2048LL
+#endif
+
+// Below this count the _omp versions run serially (same result either way).
+#if !defined(BLAS1_REPRO_OMP_MIN)
+    #define BLAS1_REPRO_OMP_MIN 65536LL
+#endif
+
+
+// *rho := x'*y
+int32_t ddot_repro(const int64_t,
+                   const double * __restrict,
+                   const double * __restrict,
+                   const int32_t,
+                   double * __restrict)       __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+int32_t ddot_repro_omp(const int64_t,
+                       const double * __restrict,
+                       const double * __restrict,
+                       const int32_t,
+                       double * __restrict)   __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// *nrm := sqrt(x'*x)
+int32_t dnrm2_repro(const int64_t,
+                    const double * __restrict,
+                    const int32_t,
+                    double * __restrict)      __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+int32_t dnrm2_repro_omp(const int64_t,
+                        const double * __restrict,
+                        const int32_t,
+                        double * __restrict)  __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// *asum := sum(|x|)
+int32_t dasum_repro(const int64_t,
+                    const double * __restrict,
+                    const int32_t,
+                    double * __restrict)      __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+int32_t dasum_repro_omp(const int64_t,
+                        const double * __restrict,
+                        const int32_t,
+                        double * __restrict)  __attribute__((noinline))
+                                              __attribute__((hot))
+                                              __attribute__((aligned(32)));
+
+// Runs every function and mode on lengths around the chunk, OpenMP and
+// partial-buffer boundaries: the _omp results must be bitwise equal to the
+// serial ones for 1, 2, 3, 4 and up to omp_get_max_threads() threads, and
+// exact on data (multiples of 2^-10) whose sums never round. Prints one
+// line per length and mode; returns the number of failures.
+int32_t blas1_repro_validate(FILE * __restrict,
+                             const uint64_t);          // seed
+
+
+
+
+#endif /*__GMS_BLAS1_REPRO_H__*/
@@ -0,0 +1,424 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_dgemm_driver_skx.h"
+#include "GMS_dgemm_kernel_4x8_skx.h"
+
+
+static gemm_blocking_t dgemm_skx_blk = {0,0,0,0,0};
+static volatile int32_t dgemm_skx_blk_ready = 0;
+
+
+static inline
+const gemm_blocking_t * dgemm_skx_blocking(void) {
+
+         if(__builtin_expect(!__atomic_load_n(&dgemm_skx_blk_ready,__ATOMIC_ACQUIRE),0)) {
+            gemm_blocking_t b;
+            gemm_cache_blocking((int32_t)sizeof(double),DGEMM_SKX_MR,DGEMM_SKX_NR,&b);
+            dgemm_skx_blk = b;
+            __atomic_store_n(&dgemm_skx_blk_ready,1,__ATOMIC_RELEASE);
+         }
+         return (&dgemm_skx_blk);
+}
+
+
+void dgemm_skx_get_blocking(gemm_blocking_t * __restrict blk) {
+
+         if(__builtin_expect(NULL==blk,0)) return;
+         *blk = *dgemm_skx_blocking();
+}
+
+
+void dgemm_skx_set_blocking(const int32_t mc,
+                            const int32_t kc,
+                            const int32_t nc) {
+
+         (void)dgemm_skx_blocking();
+         // The packed panels must stay 64-byte aligned: KC multiple of 8,
+         // MC multiple of the 8-row panel, NC multiple of NR.
+         if(mc > 0) dgemm_skx_blk.mc = ((mc+7)/8)*8;
+         if(kc > 0) dgemm_skx_blk.kc = ((kc+7)/8)*8;
+         if(nc > 0) dgemm_skx_blk.nc = ((nc+DGEMM_SKX_NR-1)/DGEMM_SKX_NR)*DGEMM_SKX_NR;
+}
+
+
+/*
+     Width of the next A row panel / B column panel (8, then 4,2,1),
+     in the order dgemm_kernel_4x8_skx walks them.
+*/
+static inline
+int32_t dgemm_panel_width(const int32_t rem) {
+         return ((rem >= 8) ? 8 : (rem >= 4) ? 4 : (rem >= 2) ? 2 : 1);
+}
+
+
+/*
+     Packs op(A)(i0:i0+mb,p0:p0+kb) into Ap.
+     transa == 0: op(A)(i,p) = A[i+p*lda], otherwise A[p+i*lda].
+*/
+static
+void dgemm_pack_a(const int32_t transa,
+                  const int32_t mb,
+                  const int32_t kb,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const int32_t i0,
+                  const int32_t p0,
+                  double * __restrict Ap) {
+
+         int32_t i,w,p,r;
+         i = 0;
+         while(i < mb) {
+               w = dgemm_panel_width(mb-i);
+               if(!transa) {
+                  const double * __restrict a = &A[(int64_t)(i0+i)+(int64_t)p0*lda];
+                  if(w == 8) {
+                     for(p = 0; p != kb; ++p) {
+                         _mm512_store_pd(&Ap[p*8],_mm512_loadu_pd(&a[(int64_t)p*lda]));
+                     }
+                  }
+                  else if(w == 4) {
+                     for(p = 0; p != kb; ++p) {
+                         _mm256_storeu_pd(&Ap[p*4],_mm256_loadu_pd(&a[(int64_t)p*lda]));
+                     }
+                  }
+                  else {
+                     for(p = 0; p != kb; ++p) {
+                         for(r = 0; r != w; ++r) Ap[p*w+r] = a[(int64_t)p*lda+r];
+                     }
+                  }
+               }
+               else {
+                  for(r = 0; r != w; ++r) {
+                      const double * __restrict a = &A[(int64_t)p0+(int64_t)(i0+i+r)*lda];
+                      for(p = 0; p != kb; ++p) Ap[p*w+r] = a[p];
+                  }
+               }
+               Ap += (int64_t)w*kb;
+               i  += w;
+         }
+}
+
+
+/*
+     Packs op(B)(p0:p0+kb,j0:j0+nb) into Bp.
+     transb == 0: op(B)(p,j) = B[p+j*ldb], otherwise B[j+p*ldb].
+*/
+static
+void dgemm_pack_b(const int32_t transb,
+                  const int32_t kb,
+                  const int32_t nb,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  const int32_t p0,
+                  const int32_t j0,
+                  double * __restrict Bp) {
+
+         int32_t j,w,p,c;
+         j = 0;
+         while(j < nb) {
+               w = dgemm_panel_width(nb-j);
+               if(transb) {
+                  const double * __restrict b = &B[(int64_t)(j0+j)+(int64_t)p0*ldb];
+                  if(w == 8) {
+                     for(p = 0; p != kb; ++p) {
+                         _mm512_store_pd(&Bp[p*8],_mm512_loadu_pd(&b[(int64_t)p*ldb]));
+                     }
+                  }
+                  else {
+                     for(p = 0; p != kb; ++p) {
+                         for(c = 0; c != w; ++c) Bp[p*w+c] = b[(int64_t)p*ldb+c];
+                     }
+                  }
+               }
+               else {
+                  for(c = 0; c != w; ++c) {
+                      const double * __restrict b = &B[(int64_t)p0+(int64_t)(j0+j+c)*ldb];
+                      for(p = 0; p != kb; ++p) Bp[p*w+c] = b[p];
+                  }
+               }
+               Bp += (int64_t)w*kb;
+               j  += w;
+         }
+}
+
+
+static
+void dgemm_scale_c(const int32_t m,
+                   const int32_t n,
+                   const double beta,
+                   double * __restrict C,
+                   const int32_t ldc) {
+
+         int32_t i,j;
+         if(beta == 1.0) return;
+         if(beta == 0.0) {
+            // BLAS semantics: C is not read when beta == 0 (NaNs are not propagated).
+            for(j = 0; j != n; ++j) {
+                memset(&C[(int64_t)j*ldc],0,(size_t)m*sizeof(double));
+            }
+            return;
+         }
+         {
+            const __m512d vb = _mm512_set1_pd(beta);
+            for(j = 0; j != n; ++j) {
+                double * __restrict c = &C[(int64_t)j*ldc];
+                for(i = 0; i+8 <= m; i += 8) {
+                    _mm512_storeu_pd(&c[i],_mm512_mul_pd(vb,_mm512_loadu_pd(&c[i])));
+                }
+                if(i < m) {
+                   const __mmask8 k = (__mmask8)((1U << (m-i))-1U);
+                   _mm512_mask_storeu_pd(&c[i],k,_mm512_mul_pd(vb,_mm512_maskz_loadu_pd(k,&c[i])));
+                }
+            }
+         }
+}
+
+
+/*
+     Serial blocked product on the sub-problem C(m0:m0+m,n0:n0+n) += alpha*op(A)*op(B).
+     C must already be scaled by beta.
+*/
+static
+void dgemm_skx_blocked(const int32_t transa,
+                       const int32_t transb,
+                       const int32_t m0,
+                       const int32_t m,
+                       const int32_t n0,
+                       const int32_t n,
+                       const int32_t k,
+                       const double alpha,
+                       const double * __restrict A,
+                       const int32_t lda,
+                       const double * __restrict B,
+                       const int32_t ldb,
+                       double * __restrict C,
+                       const int32_t ldc,
+                       const gemm_blocking_t * __restrict blk,
+                       double * __restrict Ap,
+                       double * __restrict Bp) {
+
+         int32_t jc,pc,ic,nb,kb,mb;
+         for(jc = 0; jc < n; jc += blk->nc) {
+             nb = (n-jc < blk->nc) ? n-jc : blk->nc;
+             for(pc = 0; pc < k; pc += blk->kc) {
+                 kb = (k-pc < blk->kc) ? k-pc : blk->kc;
+                 dgemm_pack_b(transb,kb,nb,B,ldb,pc,n0+jc,Bp);
+                 for(ic = 0; ic < m; ic += blk->mc) {
+                     mb = (m-ic < blk->mc) ? m-ic : blk->mc;
+                     dgemm_pack_a(transa,mb,kb,A,lda,m0+ic,pc,Ap);
+                     dgemm_kernel_4x8_skx(mb,nb,kb,alpha,Ap,Bp,
+                                          &C[(int64_t)(m0+ic)+(int64_t)(n0+jc)*ldc],ldc);
+                 }
+             }
+         }
+}
+
+
+int32_t dgemm_skx(const char transa,
+                  const char transb,
+                  const int32_t m,
+                  const int32_t n,
+                  const int32_t k,
+                  const double alpha,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  const double beta,
+                  double * __restrict C,
+                  const int32_t ldc) {
+
+         const gemm_blocking_t * __restrict blk;
+         double * __restrict Ap = NULL;
+         double * __restrict Bp = NULL;
+         int32_t ta,tb,mcb,ncb;
+         if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+            return (-1);
+         }
+         if(m == 0 || n == 0) return (0);
+         dgemm_scale_c(m,n,beta,C,ldc);
+         if(k == 0 || alpha == 0.0) return (0);
+         ta  = (gemm_op(transa) != GEMM_OP_N);
+         tb  = (gemm_op(transb) != GEMM_OP_N);
+         blk = dgemm_skx_blocking();
+         mcb = (m < blk->mc) ? m : blk->mc;
+         ncb = (n < blk->nc) ? n : blk->nc;
+         Ap  = (double*)_mm_malloc((size_t)(mcb+8)*(size_t)blk->kc*sizeof(double),64);
+         Bp  = (double*)_mm_malloc((size_t)(ncb+8)*(size_t)blk->kc*sizeof(double),64);
+         if(__builtin_expect(NULL==Ap || NULL==Bp,0)) {
+            if(Ap) _mm_free(Ap);
+            if(Bp) _mm_free(Bp);
+            return (-2);
+         }
+         dgemm_skx_blocked(ta,tb,0,m,0,n,k,alpha,A,lda,B,ldb,C,ldc,blk,Ap,Bp);
+         _mm_free(Ap);
+         _mm_free(Bp);
+         return (0);
+}
+
+
+int32_t dgemm_skx_omp(const char transa,
+                      const char transb,
+                      const int32_t m,
+                      const int32_t n,
+                      const int32_t k,
+                      const double alpha,
+                      const double * __restrict A,
+                      const int32_t lda,
+                      const double * __restrict B,
+                      const int32_t ldb,
+                      const double beta,
+                      double * __restrict C,
+                      const int32_t ldc) {
+
+#if defined(_OPENMP)
+         const gemm_blocking_t * __restrict blk;
+         double * __restrict buf = NULL;
+         int64_t szA,szB;
+         int32_t ta,tb,nth,tm,tn;
+         if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+            return (-1);
+         }
+         if(m == 0 || n == 0) return (0);
+         nth = omp_get_max_threads();
+         if(nth <= 1 || (double)m*(double)n*(double)k < (double)GEMM_SKX_OMP_MIN_FLOP) {
+            return (dgemm_skx(transa,transb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc));
+         }
+         ta  = (gemm_op(transa) != GEMM_OP_N);
+         tb  = (gemm_op(transb) != GEMM_OP_N);
+         blk = dgemm_skx_blocking();
+         gemm_thread_grid(nth,m,n,&tm,&tn);
+         // Private packing buffers, one pair per thread, each 64-byte aligned.
+         szA = (int64_t)(blk->mc+8)*blk->kc;
+         szB = (int64_t)(blk->nc+8)*blk->kc;
+         buf = (double*)_mm_malloc((size_t)nth*(size_t)(szA+szB)*sizeof(double),64);
+         if(__builtin_expect(NULL==buf,0)) return (-2);
+#pragma omp parallel num_threads(nth) default(none) \
+        shared(A,B,C,buf,blk) \
+        firstprivate(ta,tb,m,n,k,alpha,beta,lda,ldb,ldc,tm,tn,szA,szB)
+         {
+              const int32_t tid  = omp_get_thread_num();
+              const int32_t nthr = omp_get_num_threads();
+              double * __restrict Ap = &buf[(int64_t)tid*(szA+szB)];
+              double * __restrict Bp = Ap+szA;
+              int32_t t,ti,tj,m0,mb,n0,nb;
+              for(t = tid; t < tm*tn; t += nthr) {
+                  ti = t / tn;
+                  tj = t % tn;
+                  gemm_partition(m,tm,ti,8,&m0,&mb);
+                  gemm_partition(n,tn,tj,8,&n0,&nb);
+                  if(mb == 0 || nb == 0) continue;
+                  dgemm_scale_c(mb,nb,beta,&C[(int64_t)m0+(int64_t)n0*ldc],ldc);
+                  if(k == 0 || alpha == 0.0) continue;
+                  dgemm_skx_blocked(ta,tb,m0,mb,n0,nb,k,alpha,A,lda,B,ldb,C,ldc,blk,Ap,Bp);
+              }
+         }
+         _mm_free(buf);
+         return (0);
+#else
+         return (dgemm_skx(transa,transb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc));
+#endif
+}
+
+
+/*
+     Benchmark.
+*/
+#if defined(__cplusplus)
+extern "C"
+#endif
+void dgemm_(const char *, const char *, const int *, const int *, const int *,
+            const double *, const double *, const int *, const double *, const int *,
+            const double *, double *, const int *) __attribute__((weak));
+
+
+static inline
+double dgemm_skx_wtime(void) {
+#if defined(_OPENMP)
+         return (omp_get_wtime());
+#else
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+#endif
+}
+
+
+void dgemm_skx_bench(FILE * __restrict fp,
+                     const int32_t nmin,
+                     const int32_t nmax,
+                     const int32_t nstep,
+                     const int32_t nrep) {
+
+         double * __restrict A = NULL;
+         double * __restrict B = NULL;
+         double * __restrict C = NULL;
+         double * __restrict R = NULL;
+         int64_t nn,i;
+         int32_t n,r;
+         if(NULL==fp) fp = stdout;
+         if(__builtin_expect(nmin<=0 || nmax<nmin || nstep<=0 || nrep<=0,0)) return;
+         nn = (int64_t)nmax*nmax;
+         A  = (double*)_mm_malloc((size_t)nn*sizeof(double),64);
+         B  = (double*)_mm_malloc((size_t)nn*sizeof(double),64);
+         C  = (double*)_mm_malloc((size_t)nn*sizeof(double),64);
+         R  = (double*)_mm_malloc((size_t)nn*sizeof(double),64);
+         if(__builtin_expect(NULL==A || NULL==B || NULL==C || NULL==R,0)) goto done;
+         for(i = 0; i != nn; ++i) {
+             A[i] = (double)((i*7919)%1013)/1013.0-0.5;
+             B[i] = (double)((i*104729)%997)/997.0-0.5;
+         }
+         {
+            gemm_blocking_t blk;
+            dgemm_skx_get_blocking(&blk);
+            fprintf(fp,"# MC=%d KC=%d NC=%d MRxNR=%dx%d reference=%s\n",blk.mc,blk.kc,blk.nc,
+                    blk.mr,blk.nr,(dgemm_ ? "dgemm_" : "none (sampled naive check)"));
+         }
+         fprintf(fp,"# %8s %14s %14s %14s %14s\n","n","GFLOP/s_skx","GFLOP/s_omp","GFLOP/s_ref","max|diff|");
+         for(n = nmin; n <= nmax; n += nstep) {
+             const double flop = 2.0*(double)n*(double)n*(double)n*(double)nrep;
+             const double one = 1.0, zero = 0.0;
+             double t0,ts,to,tr,err;
+             t0 = dgemm_skx_wtime();
+             for(r = 0; r != nrep; ++r) dgemm_skx('N','N',n,n,n,1.0,A,n,B,n,0.0,C,n);
+             ts = dgemm_skx_wtime()-t0;
+             t0 = dgemm_skx_wtime();
+             for(r = 0; r != nrep; ++r) dgemm_skx_omp('N','N',n,n,n,1.0,A,n,B,n,0.0,C,n);
+             to = dgemm_skx_wtime()-t0;
+             err = 0.0;
+             tr  = 0.0;
+             if(dgemm_) {
+                t0 = dgemm_skx_wtime();
+                for(r = 0; r != nrep; ++r) dgemm_("N","N",&n,&n,&n,&one,A,&n,B,&n,&zero,R,&n);
+                tr = dgemm_skx_wtime()-t0;
+                for(i = 0; i != (int64_t)n*n; ++i) {
+                    const double d = fabs(C[i]-R[i]);
+                    if(d > err) err = d;
+                }
+             }
+             else {
+                int32_t s,ii,jj,p;
+                for(s = 0; s != 64; ++s) {
+                    double acc = 0.0;
+                    ii = (int32_t)(((int64_t)s*2654435761LL) % n);
+                    jj = (int32_t)(((int64_t)s*40503LL+17) % n);
+                    for(p = 0; p != n; ++p) acc += A[ii+(int64_t)p*n]*B[p+(int64_t)jj*n];
+                    if(fabs(acc-C[ii+(int64_t)jj*n]) > err) err = fabs(acc-C[ii+(int64_t)jj*n]);
+                }
+             }
+             fprintf(fp,"  %8d %14.3f %14.3f %14.3f %14.3e\n",n,1.0e-9*flop/ts,1.0e-9*flop/to,
+                     (tr > 0.0) ? 1.0e-9*flop/tr : 0.0,err);
+         }
+done:
+         if(A) _mm_free(A);
+         if(B) _mm_free(B);
+         if(C) _mm_free(C);
+         if(R) _mm_free(R);
+}
@@ -0,0 +1,99 @@
+
+
+#ifndef __GMS_DGEMM_DRIVER_SKX_H__
+#define __GMS_DGEMM_DRIVER_SKX_H__
+
+//
+// Complete (packed, cache-blocked, threaded) DGEMM driver built on
+// dgemm_kernel_4x8_skx (OpenBLAS SkylakeX micro-kernel, GMS_dgemm_kernel_4x8_skx.c).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 16:00 PM +00200
+//
+// C := alpha*op(A)*op(B) + beta*C, column-major (Fortran/BLAS) storage,
+// op(X) = X ('N') or X^T ('T','C').
+// Loop structure (Goto/BLIS):
+//    jc over N in steps of NC   -> op(B) panel KCxNC packed (L3 resident)
+//    pc over K in steps of KC   -> C scaled by beta once, before the first pc
+//    ic over M in steps of MC   -> op(A) block MCxKC packed (L2 resident)
+//    micro-kernel over 24/16/8/4/2/1 x 8/4/2/1 tiles (B micro-panel L1 resident)
+// Packed A is laid out in row panels of 8 (then 4,2,1 for the M remainder),
+// packed B in column panels of 8 (then 4,2,1), each panel k-major, exactly as
+// dgemm_kernel_4x8_skx consumes them. Edge tiles are handled by the 4/2/1
+// variants of the micro-kernel, so no zero padding is needed.
+// The blocking parameters are derived from get_cacheinfo (GMS_cpuid_x86.c)
+// by gemm_cache_blocking (GMS_gemm_driver_skx.c) and may be overridden.
+// The _omp version partitions C into a 2D grid of thread tiles (tm x tn),
+// each thread packing its own A and B blocks into private buffers.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include "GMS_gemm_driver_skx.h"
+
+
+#if !defined(DGEMM_SKX_MR)
+    #define DGEMM_SKX_MR 24
+#endif
+
+#if !defined(DGEMM_SKX_NR)
+    #define DGEMM_SKX_NR 8
+#endif
+
+            void dgemm_skx_get_blocking(gemm_blocking_t * __restrict) __attribute__((cold))
+                                                                      __attribute__((aligned(32)));
+
+            // Zero arguments keep the current values.
+            void dgemm_skx_set_blocking(const int32_t,
+                                        const int32_t,
+                                        const int32_t)    __attribute__((cold))
+                                                          __attribute__((aligned(32)));
+
+
+            int32_t dgemm_skx(const char,
+                              const char,
+                              const int32_t,
+                              const int32_t,
+                              const int32_t,
+                              const double,
+                              const double * __restrict,
+                              const int32_t,
+                              const double * __restrict,
+                              const int32_t,
+                              const double,
+                              double * __restrict,
+                              const int32_t)   __attribute__((noinline))
+                                               __attribute__((hot))
+                                               __attribute__((aligned(32)));
+
+
+            int32_t dgemm_skx_omp(const char,
+                                  const char,
+                                  const int32_t,
+                                  const int32_t,
+                                  const int32_t,
+                                  const double,
+                                  const double * __restrict,
+                                  const int32_t,
+                                  const double * __restrict,
+                                  const int32_t,
+                                  const double,
+                                  double * __restrict,
+                                  const int32_t)   __attribute__((noinline))
+                                                   __attribute__((hot))
+                                                   __attribute__((aligned(32)));
+
+
+            // GFLOP/s benchmark over square sizes [nmin,nmax] in steps of nstep.
+            // Compares against the reference BLAS dgemm_ (MKL, OpenBLAS) when one
+            // is linked in (weak symbol), and reports the max. abs. difference.
+            void dgemm_skx_bench(FILE * __restrict,
+                                 const int32_t,
+                                 const int32_t,
+                                 const int32_t,
+                                 const int32_t)    __attribute__((cold))
+                                                   __attribute__((aligned(32)));
+
+
+
+#endif /*__GMS_DGEMM_DRIVER_SKX_H__*/
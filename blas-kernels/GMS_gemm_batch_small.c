@@ -0,0 +1,691 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_gemm_batch_small.h"
+#include "GMS_dgemm_driver_skx.h"
+
+
+/*
+     Per-matrix kernel signature. The size-specialized variants ignore
+     the m,n,k arguments (their sizes are compile-time constants).
+*/
+typedef void (*dgemm_small_fn)(const int32_t,
+                               const int32_t,
+                               const int32_t,
+                               const double,
+                               const double * __restrict,
+                               const int32_t,
+                               const double * __restrict,
+                               const int32_t,
+                               const double,
+                               double * __restrict,
+                               const int32_t);
+
+
+/*
+     C := alpha*A*B + beta*C, M,N,K <= 16, column-major.
+     Columns of A are held in (at most) 2 x K ZMM registers, loaded once
+     through masks (masked-off lanes do not fault), then every column of C
+     is one (M <= 8) or two (M > 8) broadcast-FMA chains of length K.
+     beta == 0 -> C is not read (BLAS semantics).
+     Inlined with constant M,N,K the loops are fully unrolled.
+*/
+__attribute__((always_inline))
+static inline
+void dgemm_small_nn_zmm(const int32_t M,
+                        const int32_t N,
+                        const int32_t K,
+                        const double alpha,
+                        const double * __restrict A,
+                        const int32_t lda,
+                        const double * __restrict B,
+                        const int32_t ldb,
+                        const double beta,
+                        double * __restrict C,
+                        const int32_t ldc) {
+
+         __m512d a0[GEMM_BATCH_SMALL_MAX];
+         __m512d a1[GEMM_BATCH_SMALL_MAX];
+         const __mmask8 k0  = (M >= 8) ? (__mmask8)0xFF : (__mmask8)((1U << M)-1U);
+         const __mmask8 k1  = (M >  8) ? (__mmask8)((1U << (M-8))-1U) : (__mmask8)0;
+         const __m512d  va  = _mm512_set1_pd(alpha);
+         const __m512d  vb  = _mm512_set1_pd(beta);
+         int32_t j,p;
+         for(p = 0; p != K; ++p) {
+             a0[p] = _mm512_maskz_loadu_pd(k0,&A[(int64_t)p*lda]);
+             if(M > 8) a1[p] = _mm512_maskz_loadu_pd(k1,&A[(int64_t)p*lda+8]);
+         }
+         for(j = 0; j != N; ++j) {
+             const double * __restrict b = &B[(int64_t)j*ldb];
+             double * __restrict c       = &C[(int64_t)j*ldc];
+             __m512d c0 = _mm512_setzero_pd();
+             __m512d c1 = _mm512_setzero_pd();
+             for(p = 0; p != K; ++p) {
+                 const __m512d bp = _mm512_set1_pd(b[p]);
+                 c0 = _mm512_fmadd_pd(a0[p],bp,c0);
+                 if(M > 8) c1 = _mm512_fmadd_pd(a1[p],bp,c1);
+             }
+             c0 = _mm512_mul_pd(va,c0);
+             if(beta != 0.0) c0 = _mm512_fmadd_pd(vb,_mm512_maskz_loadu_pd(k0,c),c0);
+             _mm512_mask_storeu_pd(c,k0,c0);
+             if(M > 8) {
+                c1 = _mm512_mul_pd(va,c1);
+                if(beta != 0.0) c1 = _mm512_fmadd_pd(vb,_mm512_maskz_loadu_pd(k1,c+8),c1);
+                _mm512_mask_storeu_pd(c+8,k1,c1);
+             }
+         }
+}
+
+
+static
+void dgemm_small_nn_gen(const int32_t m,
+                        const int32_t n,
+                        const int32_t k,
+                        const double alpha,
+                        const double * __restrict A,
+                        const int32_t lda,
+                        const double * __restrict B,
+                        const int32_t ldb,
+                        const double beta,
+                        double * __restrict C,
+                        const int32_t ldc) {
+
+         dgemm_small_nn_zmm(m,n,k,alpha,A,lda,B,ldb,beta,C,ldc);
+}
+
+
+#define DGEMM_SMALL_NN_SPEC(M,N,K)                                              \
+static                                                                          \
+void dgemm_small_nn_##M##x##N##x##K(const int32_t m,                             \
+                                    const int32_t n,                             \
+                                    const int32_t k,                             \
+                                    const double alpha,                          \
+                                    const double * __restrict A,                 \
+                                    const int32_t lda,                           \
+                                    const double * __restrict B,                 \
+                                    const int32_t ldb,                           \
+                                    const double beta,                           \
+                                    double * __restrict C,                       \
+                                    const int32_t ldc) {                         \
+         (void)m; (void)n; (void)k;                                             \
+         dgemm_small_nn_zmm(M,N,K,alpha,A,lda,B,ldb,beta,C,ldc);                 \
+}
+
+DGEMM_SMALL_NN_SPEC(3,3,3)
+DGEMM_SMALL_NN_SPEC(4,4,4)
+DGEMM_SMALL_NN_SPEC(6,6,6)
+DGEMM_SMALL_NN_SPEC(8,8,8)
+DGEMM_SMALL_NN_SPEC(9,9,9)
+DGEMM_SMALL_NN_SPEC(12,12,12)
+DGEMM_SMALL_NN_SPEC(16,16,16)
+DGEMM_SMALL_NN_SPEC(3,1,3)
+DGEMM_SMALL_NN_SPEC(4,1,4)
+DGEMM_SMALL_NN_SPEC(6,1,6)
+
+
+static inline
+dgemm_small_fn dgemm_small_select(const int32_t m,
+                                  const int32_t n,
+                                  const int32_t k) {
+
+         if(m == k) {
+            if(n == m) {
+               switch(m) {
+                   case 3:  return (dgemm_small_nn_3x3x3);
+                   case 4:  return (dgemm_small_nn_4x4x4);
+                   case 6:  return (dgemm_small_nn_6x6x6);
+                   case 8:  return (dgemm_small_nn_8x8x8);
+                   case 9:  return (dgemm_small_nn_9x9x9);
+                   case 12: return (dgemm_small_nn_12x12x12);
+                   case 16: return (dgemm_small_nn_16x16x16);
+                   default: break;
+               }
+            }
+            else if(n == 1) {
+               switch(m) {
+                   case 3:  return (dgemm_small_nn_3x1x3);
+                   case 4:  return (dgemm_small_nn_4x1x4);
+                   case 6:  return (dgemm_small_nn_6x1x6);
+                   default: break;
+               }
+            }
+         }
+         return (dgemm_small_nn_gen);
+}
+
+
+/*
+     One product. Transposed operands are copied into a 16x16 stack tile
+     (ld = rows of op(X)), so the kernel always runs the 'N','N' case.
+*/
+__attribute__((always_inline))
+static inline
+void dgemm_small_one(const dgemm_small_fn fn,
+                     const int32_t ta,
+                     const int32_t tb,
+                     const int32_t m,
+                     const int32_t n,
+                     const int32_t k,
+                     const double alpha,
+                     const double * __restrict A,
+                     const int32_t lda,
+                     const double * __restrict B,
+                     const int32_t ldb,
+                     const double beta,
+                     double * __restrict C,
+                     const int32_t ldc) {
+
+         __attribute__((aligned(64))) double at[GEMM_BATCH_SMALL_MAX*GEMM_BATCH_SMALL_MAX];
+         __attribute__((aligned(64))) double bt[GEMM_BATCH_SMALL_MAX*GEMM_BATCH_SMALL_MAX];
+         const double * __restrict pa = A;
+         const double * __restrict pb = B;
+         int32_t la = lda;
+         int32_t lb = ldb;
+         int32_t i,j;
+         if(ta) {
+            for(j = 0; j != k; ++j) {
+                for(i = 0; i != m; ++i) at[i+j*m] = A[j+(int64_t)i*lda];
+            }
+            pa = &at[0];
+            la = m;
+         }
+         if(tb) {
+            for(j = 0; j != n; ++j) {
+                for(i = 0; i != k; ++i) bt[i+j*k] = B[j+(int64_t)i*ldb];
+            }
+            pb = &bt[0];
+            lb = k;
+         }
+         fn(m,n,k,alpha,pa,la,pb,lb,beta,C,ldc);
+}
+
+
+static inline
+int32_t dgemm_batch_check(const char transa,
+                          const char transb,
+                          const int32_t m,
+                          const int32_t n,
+                          const int32_t k,
+                          const int32_t lda,
+                          const int32_t ldb,
+                          const int32_t ldc,
+                          const int64_t batch) {
+
+         if(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc) != 0) return (-1);
+         if(batch < 0) return (-1);
+         return (0);
+}
+
+
+static inline
+int32_t dgemm_batch_strides_ok(const int32_t m,
+                               const int32_t n,
+                               const int32_t ldc,
+                               const int64_t strideA,
+                               const int64_t strideB,
+                               const int64_t strideC,
+                               const int64_t batch) {
+
+         // strideA/strideB == 0 is allowed (one operand shared by the whole batch),
+         // the outputs must not overlap.
+         if(strideA < 0 || strideB < 0) return (0);
+         if(batch > 1 && m > 0 && n > 0 &&
+            strideC < (int64_t)ldc*(int64_t)(n-1)+(int64_t)m) return (0);
+         return (1);
+}
+
+
+int32_t dgemm_batch_strided(const char transa,
+                            const char transb,
+                            const int32_t m,
+                            const int32_t n,
+                            const int32_t k,
+                            const double alpha,
+                            const double * __restrict A,
+                            const int32_t lda,
+                            const int64_t strideA,
+                            const double * __restrict B,
+                            const int32_t ldb,
+                            const int64_t strideB,
+                            const double beta,
+                            double * __restrict C,
+                            const int32_t ldc,
+                            const int64_t strideC,
+                            const int64_t batch) {
+
+         dgemm_small_fn fn;
+         int64_t l;
+         int32_t ta,tb,stat;
+         if(__builtin_expect(dgemm_batch_check(transa,transb,m,n,k,lda,ldb,ldc,batch)!=0,0) ||
+            __builtin_expect(!dgemm_batch_strides_ok(m,n,ldc,strideA,strideB,strideC,batch),0)) {
+            return (-1);
+         }
+         if(batch == 0 || m == 0 || n == 0) return (0);
+         if(m > GEMM_BATCH_SMALL_MAX || n > GEMM_BATCH_SMALL_MAX || k > GEMM_BATCH_SMALL_MAX) {
+            for(l = 0; l != batch; ++l) {
+                stat = dgemm_skx(transa,transb,m,n,k,alpha,A+l*strideA,lda,
+                                 B+l*strideB,ldb,beta,C+l*strideC,ldc);
+                if(stat != 0) return (stat);
+            }
+            return (0);
+         }
+         ta = (gemm_op(transa) != GEMM_OP_N);
+         tb = (gemm_op(transb) != GEMM_OP_N);
+         fn = dgemm_small_select(m,n,k);
+         for(l = 0; l != batch; ++l) {
+             dgemm_small_one(fn,ta,tb,m,n,k,alpha,A+l*strideA,lda,
+                             B+l*strideB,ldb,beta,C+l*strideC,ldc);
+         }
+         return (0);
+}
+
+
+int32_t dgemm_batch_strided_omp(const char transa,
+                                const char transb,
+                                const int32_t m,
+                                const int32_t n,
+                                const int32_t k,
+                                const double alpha,
+                                const double * __restrict A,
+                                const int32_t lda,
+                                const int64_t strideA,
+                                const double * __restrict B,
+                                const int32_t ldb,
+                                const int64_t strideB,
+                                const double beta,
+                                double * __restrict C,
+                                const int32_t ldc,
+                                const int64_t strideC,
+                                const int64_t batch) {
+
+         dgemm_small_fn fn;
+         int64_t l;
+         int32_t ta,tb,stat;
+         if(__builtin_expect(dgemm_batch_check(transa,transb,m,n,k,lda,ldb,ldc,batch)!=0,0) ||
+            __builtin_expect(!dgemm_batch_strides_ok(m,n,ldc,strideA,strideB,strideC,batch),0)) {
+            return (-1);
+         }
+         if(batch == 0 || m == 0 || n == 0) return (0);
+         if(batch < GEMM_BATCH_OMP_MIN) {
+            return (dgemm_batch_strided(transa,transb,m,n,k,alpha,A,lda,strideA,
+                                        B,ldb,strideB,beta,C,ldc,strideC,batch));
+         }
+         stat = 0;
+         if(m > GEMM_BATCH_SMALL_MAX || n > GEMM_BATCH_SMALL_MAX || k > GEMM_BATCH_SMALL_MAX) {
+#pragma omp parallel for schedule(dynamic,1) default(none)         \
+            shared(A,B,C) firstprivate(transa,transb,m,n,k,alpha,lda,ldb,beta,ldc, \
+            strideA,strideB,strideC,batch) private(l) reduction(min:stat)
+            for(l = 0; l < batch; ++l) {
+                const int32_t s = dgemm_skx(transa,transb,m,n,k,alpha,A+l*strideA,lda,
+                                            B+l*strideB,ldb,beta,C+l*strideC,ldc);
+                if(s < stat) stat = s;
+            }
+            return (stat);
+         }
+         ta = (gemm_op(transa) != GEMM_OP_N);
+         tb = (gemm_op(transb) != GEMM_OP_N);
+         fn = dgemm_small_select(m,n,k);
+#pragma omp parallel for schedule(static) default(none)            \
+         shared(A,B,C) firstprivate(fn,ta,tb,m,n,k,alpha,lda,ldb,beta,ldc, \
+         strideA,strideB,strideC,batch) private(l)
+         for(l = 0; l < batch; ++l) {
+             dgemm_small_one(fn,ta,tb,m,n,k,alpha,A+l*strideA,lda,
+                             B+l*strideB,ldb,beta,C+l*strideC,ldc);
+         }
+         return (stat);
+}
+
+
+static inline
+int32_t dgemm_batch_ptr_ok(const double * const * __restrict A,
+                           const double * const * __restrict B,
+                           double * const * __restrict C,
+                           const int64_t batch) {
+
+         int64_t l;
+         if(NULL == A || NULL == B || NULL == C) return (0);
+         for(l = 0; l != batch; ++l) {
+             if(NULL == A[l] || NULL == B[l] || NULL == C[l]) return (0);
+         }
+         return (1);
+}
+
+
+int32_t dgemm_batch_ptr(const char transa,
+                        const char transb,
+                        const int32_t m,
+                        const int32_t n,
+                        const int32_t k,
+                        const double alpha,
+                        const double * const * __restrict A,
+                        const int32_t lda,
+                        const double * const * __restrict B,
+                        const int32_t ldb,
+                        const double beta,
+                        double * const * __restrict C,
+                        const int32_t ldc,
+                        const int64_t batch) {
+
+         dgemm_small_fn fn;
+         int64_t l;
+         int32_t ta,tb,stat;
+         if(__builtin_expect(dgemm_batch_check(transa,transb,m,n,k,lda,ldb,ldc,batch)!=0,0)) {
+            return (-1);
+         }
+         if(batch == 0 || m == 0 || n == 0) return (0);
+         if(__builtin_expect(!dgemm_batch_ptr_ok(A,B,C,batch),0)) return (-1);
+         if(m > GEMM_BATCH_SMALL_MAX || n > GEMM_BATCH_SMALL_MAX || k > GEMM_BATCH_SMALL_MAX) {
+            for(l = 0; l != batch; ++l) {
+                stat = dgemm_skx(transa,transb,m,n,k,alpha,A[l],lda,B[l],ldb,beta,C[l],ldc);
+                if(stat != 0) return (stat);
+            }
+            return (0);
+         }
+         ta = (gemm_op(transa) != GEMM_OP_N);
+         tb = (gemm_op(transb) != GEMM_OP_N);
+         fn = dgemm_small_select(m,n,k);
+         for(l = 0; l != batch; ++l) {
+             if(l+2 < batch) {
+                _mm_prefetch((const char*)A[l+2],_MM_HINT_T0);
+                _mm_prefetch((const char*)B[l+2],_MM_HINT_T0);
+             }
+             dgemm_small_one(fn,ta,tb,m,n,k,alpha,A[l],lda,B[l],ldb,beta,C[l],ldc);
+         }
+         return (0);
+}
+
+
+int32_t dgemm_batch_ptr_omp(const char transa,
+                            const char transb,
+                            const int32_t m,
+                            const int32_t n,
+                            const int32_t k,
+                            const double alpha,
+                            const double * const * __restrict A,
+                            const int32_t lda,
+                            const double * const * __restrict B,
+                            const int32_t ldb,
+                            const double beta,
+                            double * const * __restrict C,
+                            const int32_t ldc,
+                            const int64_t batch) {
+
+         dgemm_small_fn fn;
+         int64_t l;
+         int32_t ta,tb,stat;
+         if(__builtin_expect(dgemm_batch_check(transa,transb,m,n,k,lda,ldb,ldc,batch)!=0,0)) {
+            return (-1);
+         }
+         if(batch == 0 || m == 0 || n == 0) return (0);
+         if(batch < GEMM_BATCH_OMP_MIN) {
+            return (dgemm_batch_ptr(transa,transb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc,batch));
+         }
+         if(__builtin_expect(!dgemm_batch_ptr_ok(A,B,C,batch),0)) return (-1);
+         stat = 0;
+         if(m > GEMM_BATCH_SMALL_MAX || n > GEMM_BATCH_SMALL_MAX || k > GEMM_BATCH_SMALL_MAX) {
+#pragma omp parallel for schedule(dynamic,1) default(none)         \
+            shared(A,B,C) firstprivate(transa,transb,m,n,k,alpha,lda,ldb,beta,ldc,batch) \
+            private(l) reduction(min:stat)
+            for(l = 0; l < batch; ++l) {
+                const int32_t s = dgemm_skx(transa,transb,m,n,k,alpha,A[l],lda,
+                                            B[l],ldb,beta,C[l],ldc);
+                if(s < stat) stat = s;
+            }
+            return (stat);
+         }
+         ta = (gemm_op(transa) != GEMM_OP_N);
+         tb = (gemm_op(transb) != GEMM_OP_N);
+         fn = dgemm_small_select(m,n,k);
+#pragma omp parallel for schedule(static) default(none)            \
+         shared(A,B,C) firstprivate(fn,ta,tb,m,n,k,alpha,lda,ldb,beta,ldc,batch) private(l)
+         for(l = 0; l < batch; ++l) {
+             dgemm_small_one(fn,ta,tb,m,n,k,alpha,A[l],lda,B[l],ldb,beta,C[l],ldc);
+         }
+         return (stat);
+}
+
+
+/*
+     Interleaved layout: one group = 8 matrices, element (i,j) of all 8
+     is one ZMM (64 bytes). Every scalar operation of the textbook triple
+     loop becomes one vector operation across the group; nothing is masked
+     and the whole group of 3x3/4x4 operands fits in the register file.
+*/
+__attribute__((always_inline))
+static inline
+void dgemm_il_group(const int32_t M,
+                    const int32_t N,
+                    const int32_t K,
+                    const __m512d va,
+                    const __m512d vb,
+                    const int32_t beta0,
+                    const double * __restrict A,
+                    const double * __restrict B,
+                    double * __restrict C) {
+
+         int32_t i,j,p;
+         for(j = 0; j != N; ++j) {
+             for(i = 0; i != M; ++i) {
+                 __m512d acc = _mm512_mul_pd(_mm512_loadu_pd(&A[(int64_t)i*8]),
+                                             _mm512_loadu_pd(&B[(int64_t)j*K*8]));
+                 for(p = 1; p < K; ++p) {
+                     acc = _mm512_fmadd_pd(_mm512_loadu_pd(&A[((int64_t)i+(int64_t)p*M)*8]),
+                                           _mm512_loadu_pd(&B[((int64_t)p+(int64_t)j*K)*8]),acc);
+                 }
+                 double * __restrict c = &C[((int64_t)i+(int64_t)j*M)*8];
+                 acc = _mm512_mul_pd(va,acc);
+                 if(!beta0) acc = _mm512_fmadd_pd(vb,_mm512_loadu_pd(c),acc);
+                 _mm512_storeu_pd(c,acc);
+             }
+         }
+}
+
+
+typedef void (*dgemm_il_fn)(const int32_t,
+                            const int32_t,
+                            const int32_t,
+                            const __m512d,
+                            const __m512d,
+                            const int32_t,
+                            const double * __restrict,
+                            const double * __restrict,
+                            double * __restrict);
+
+
+static
+void dgemm_il_gen(const int32_t m,
+                  const int32_t n,
+                  const int32_t k,
+                  const __m512d va,
+                  const __m512d vb,
+                  const int32_t beta0,
+                  const double * __restrict A,
+                  const double * __restrict B,
+                  double * __restrict C) {
+
+         dgemm_il_group(m,n,k,va,vb,beta0,A,B,C);
+}
+
+
+#define DGEMM_IL_SPEC(M,N,K)                                                    \
+static                                                                          \
+void dgemm_il_##M##x##N##x##K(const int32_t m,                                   \
+                              const int32_t n,                                   \
+                              const int32_t k,                                   \
+                              const __m512d va,                                  \
+                              const __m512d vb,                                  \
+                              const int32_t beta0,                               \
+                              const double * __restrict A,                       \
+                              const double * __restrict B,                       \
+                              double * __restrict C) {                           \
+         (void)m; (void)n; (void)k;                                             \
+         dgemm_il_group(M,N,K,va,vb,beta0,A,B,C);                                \
+}
+
+DGEMM_IL_SPEC(3,3,3)
+DGEMM_IL_SPEC(4,4,4)
+DGEMM_IL_SPEC(6,6,6)
+DGEMM_IL_SPEC(3,1,3)
+DGEMM_IL_SPEC(4,1,4)
+DGEMM_IL_SPEC(6,1,6)
+
+
+static inline
+dgemm_il_fn dgemm_il_select(const int32_t m,
+                            const int32_t n,
+                            const int32_t k) {
+
+         if(m == k) {
+            if(n == m) {
+               if(m == 3) return (dgemm_il_3x3x3);
+               if(m == 4) return (dgemm_il_4x4x4);
+               if(m == 6) return (dgemm_il_6x6x6);
+            }
+            else if(n == 1) {
+               if(m == 3) return (dgemm_il_3x1x3);
+               if(m == 4) return (dgemm_il_4x1x4);
+               if(m == 6) return (dgemm_il_6x1x6);
+            }
+         }
+         return (dgemm_il_gen);
+}
+
+
+static inline
+int32_t dgemm_il_check(const int32_t m,
+                       const int32_t n,
+                       const int32_t k,
+                       const double * __restrict A,
+                       const double * __restrict B,
+                       double * __restrict C,
+                       const int64_t batch) {
+
+         if(m < 1 || n < 1 || k < 1) return (-1);
+         if(m > GEMM_BATCH_SMALL_MAX || n > GEMM_BATCH_SMALL_MAX || k > GEMM_BATCH_SMALL_MAX) return (-1);
+         if(batch < 0) return (-1);
+         if(batch > 0 && (NULL == A || NULL == B || NULL == C)) return (-1);
+         return (0);
+}
+
+
+int32_t dgemm_batch_interleaved_zmm8r8(const int32_t m,
+                                       const int32_t n,
+                                       const int32_t k,
+                                       const double alpha,
+                                       const double * __restrict A,
+                                       const double * __restrict B,
+                                       const double beta,
+                                       double * __restrict C,
+                                       const int64_t batch) {
+
+         dgemm_il_fn fn;
+         int64_t g,ng;
+         if(__builtin_expect(dgemm_il_check(m,n,k,A,B,C,batch)!=0,0)) return (-1);
+         const int64_t sa = (int64_t)m*(int64_t)k*8LL;
+         const int64_t sb = (int64_t)k*(int64_t)n*8LL;
+         const int64_t sc = (int64_t)m*(int64_t)n*8LL;
+         const __m512d va = _mm512_set1_pd(alpha);
+         const __m512d vb = _mm512_set1_pd(beta);
+         const int32_t beta0 = (beta == 0.0);
+         ng = (batch+7LL) >> 3;
+         fn = dgemm_il_select(m,n,k);
+         for(g = 0; g != ng; ++g) {
+             fn(m,n,k,va,vb,beta0,A+g*sa,B+g*sb,C+g*sc);
+         }
+         return (0);
+}
+
+
+int32_t dgemm_batch_interleaved_zmm8r8_omp(const int32_t m,
+                                           const int32_t n,
+                                           const int32_t k,
+                                           const double alpha,
+                                           const double * __restrict A,
+                                           const double * __restrict B,
+                                           const double beta,
+                                           double * __restrict C,
+                                           const int64_t batch) {
+
+         dgemm_il_fn fn;
+         int64_t g,ng;
+         if(__builtin_expect(dgemm_il_check(m,n,k,A,B,C,batch)!=0,0)) return (-1);
+         if(batch < GEMM_BATCH_OMP_MIN) {
+            return (dgemm_batch_interleaved_zmm8r8(m,n,k,alpha,A,B,beta,C,batch));
+         }
+         const int64_t sa = (int64_t)m*(int64_t)k*8LL;
+         const int64_t sb = (int64_t)k*(int64_t)n*8LL;
+         const int64_t sc = (int64_t)m*(int64_t)n*8LL;
+         const double  bz = beta;
+         const int32_t beta0 = (bz == 0.0);
+         ng = (batch+7LL) >> 3;
+         fn = dgemm_il_select(m,n,k);
+#pragma omp parallel for schedule(static) default(none)            \
+         shared(A,B,C) firstprivate(fn,m,n,k,alpha,bz,beta0,sa,sb,sc,ng) private(g)
+         for(g = 0; g < ng; ++g) {
+             fn(m,n,k,_mm512_set1_pd(alpha),_mm512_set1_pd(bz),beta0,A+g*sa,B+g*sb,C+g*sc);
+         }
+         return (0);
+}
+
+
+void dgemm_batch_interleave(const int32_t rows,
+                            const int32_t cols,
+                            const double * __restrict X,
+                            const int32_t ldx,
+                            const int64_t strideX,
+                            double * __restrict Xi,
+                            const int64_t batch) {
+
+         const int64_t rc = (int64_t)rows*(int64_t)cols;
+         int64_t l,g,e;
+         int32_t i,j,lane;
+         if(__builtin_expect(rows < 1 || cols < 1 || batch < 1,0)) return;
+         for(l = 0; l != batch; ++l) {
+             const double * __restrict x = X+l*strideX;
+             double * __restrict xi      = Xi+(l >> 3)*rc*8LL;
+             lane = (int32_t)(l & 7LL);
+             for(j = 0; j != cols; ++j) {
+                 for(i = 0; i != rows; ++i) {
+                     xi[((int64_t)i+(int64_t)j*rows)*8+lane] = x[i+(int64_t)j*ldx];
+                 }
+             }
+         }
+         // Zero the unused lanes of the last group.
+         if(batch & 7LL) {
+            g = batch >> 3;
+            for(e = 0; e != rc; ++e) {
+                for(lane = (int32_t)(batch & 7LL); lane != 8; ++lane) {
+                    Xi[(g*rc+e)*8+lane] = 0.0;
+                }
+            }
+         }
+}
+
+
+void dgemm_batch_deinterleave(const int32_t rows,
+                              const int32_t cols,
+                              const double * __restrict Xi,
+                              double * __restrict X,
+                              const int32_t ldx,
+                              const int64_t strideX,
+                              const int64_t batch) {
+
+         const int64_t rc = (int64_t)rows*(int64_t)cols;
+         int64_t l;
+         int32_t i,j,lane;
+         if(__builtin_expect(rows < 1 || cols < 1 || batch < 1,0)) return;
+         for(l = 0; l != batch; ++l) {
+             const double * __restrict xi = Xi+(l >> 3)*rc*8LL;
+             double * __restrict x        = X+l*strideX;
+             lane = (int32_t)(l & 7LL);
+             for(j = 0; j != cols; ++j) {
+                 for(i = 0; i != rows; ++i) {
+                     x[i+(int64_t)j*ldx] = xi[((int64_t)i+(int64_t)j*rows)*8+lane];
+                 }
+             }
+         }
+}
@@ -0,0 +1,169 @@
+
+
+#ifndef __GMS_GEMM_BATCH_SMALL_H__
+#define __GMS_GEMM_BATCH_SMALL_H__
+
+//
+// Batched GEMM for large numbers of small (up to 16x16) matrices.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 18:00 PM +00200
+//
+// C_l := alpha*op(A_l)*op(B_l) + beta*C_l, l = 0..batch-1, column-major.
+// Forms:
+//   1) strided batch   -> A_l = A + l*strideA (cuBLAS/MKL gemm_batch_strided)
+//   2) pointer array   -> A_l = A[l]
+//   3) interleaved     -> groups of 8 matrices stored element-wise interleaved,
+//                         element (i,j) of matrix l is X[((l/8)*rows*cols+i+j*rows)*8+l%8],
+//                         one ZMM lane per matrix (no masking, no shuffles).
+//                         Best layout for 3x3/4x4 chains (rotations, Mueller matrices).
+// No packing, no blocking, no allocation per call: each product runs directly
+// from the operands held in registers. Square sizes 3,4,6,8,9,12,16 with
+// op = 'N','N' dispatch to kernels specialized at compile time (fully unrolled);
+// other sizes up to 16 use the same kernel with run-time bounds; transposed
+// operands are first copied into a register-sized local tile.
+// Sizes above 16 fall back on dgemm_skx (GMS_dgemm_driver_skx.c) per matrix.
+// The _omp versions split the batch statically over the threads.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+
+
+#define GEMM_BATCH_SMALL_MAX 16
+
+// Below this batch size the _omp versions run serially.
+#if !defined(GEMM_BATCH_OMP_MIN)
+    #define GEMM_BATCH_OMP_MIN 64
+#endif
+
+
+int32_t dgemm_batch_strided(const char,
+                            const char,
+                            const int32_t,
+                            const int32_t,
+                            const int32_t,
+                            const double,
+                            const double * __restrict,
+                            const int32_t,
+                            const int64_t,
+                            const double * __restrict,
+                            const int32_t,
+                            const int64_t,
+                            const double,
+                            double * __restrict,
+                            const int32_t,
+                            const int64_t,
+                            const int64_t)        __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+int32_t dgemm_batch_strided_omp(const char,
+                                const char,
+                                const int32_t,
+                                const int32_t,
+                                const int32_t,
+                                const double,
+                                const double * __restrict,
+                                const int32_t,
+                                const int64_t,
+                                const double * __restrict,
+                                const int32_t,
+                                const int64_t,
+                                const double,
+                                double * __restrict,
+                                const int32_t,
+                                const int64_t,
+                                const int64_t)    __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+int32_t dgemm_batch_ptr(const char,
+                        const char,
+                        const int32_t,
+                        const int32_t,
+                        const int32_t,
+                        const double,
+                        const double * const * __restrict,
+                        const int32_t,
+                        const double * const * __restrict,
+                        const int32_t,
+                        const double,
+                        double * const * __restrict,
+                        const int32_t,
+                        const int64_t)            __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+int32_t dgemm_batch_ptr_omp(const char,
+                            const char,
+                            const int32_t,
+                            const int32_t,
+                            const int32_t,
+                            const double,
+                            const double * const * __restrict,
+                            const int32_t,
+                            const double * const * __restrict,
+                            const int32_t,
+                            const double,
+                            double * const * __restrict,
+                            const int32_t,
+                            const int64_t)        __attribute__((noinline))
+                                                  __attribute__((hot))
+                                                  __attribute__((aligned(32)));
+
+
+// Interleaved form, op = 'N','N'. Arrays hold ceil(batch/8) groups.
+int32_t dgemm_batch_interleaved_zmm8r8(const int32_t,
+                                       const int32_t,
+                                       const int32_t,
+                                       const double,
+                                       const double * __restrict,
+                                       const double * __restrict,
+                                       const double,
+                                       double * __restrict,
+                                       const int64_t)     __attribute__((noinline))
+                                                          __attribute__((hot))
+                                                          __attribute__((aligned(32)));
+
+
+int32_t dgemm_batch_interleaved_zmm8r8_omp(const int32_t,
+                                           const int32_t,
+                                           const int32_t,
+                                           const double,
+                                           const double * __restrict,
+                                           const double * __restrict,
+                                           const double,
+                                           double * __restrict,
+                                           const int64_t) __attribute__((noinline))
+                                                          __attribute__((hot))
+                                                          __attribute__((aligned(32)));
+
+
+// Layout conversion: strided batch (ld, stride) <-> interleaved groups of 8.
+// The padding lanes of the last group are zero-filled.
+void dgemm_batch_interleave(const int32_t,
+                            const int32_t,
+                            const double * __restrict,
+                            const int32_t,
+                            const int64_t,
+                            double * __restrict,
+                            const int64_t)                __attribute__((hot))
+                                                          __attribute__((aligned(32)));
+
+
+void dgemm_batch_deinterleave(const int32_t,
+                              const int32_t,
+                              const double * __restrict,
+                              double * __restrict,
+                              const int32_t,
+                              const int64_t,
+                              const int64_t)              __attribute__((hot))
+                                                          __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_GEMM_BATCH_SMALL_H__*/
@@ -0,0 +1,287 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_gemm_driver_skx.h"
+#include "GMS_cpuid.h"
+
+
+// Implemented in GMS_cpuid_x86.c
+extern int get_cacheinfo(int, cache_info_t *);
+
+
+void gemm_cache_blocking(const int32_t esize,
+                         const int32_t mr,
+                         const int32_t nr,
+                         gemm_blocking_t * __restrict blk) {
+
+         cache_info_t l1,l2,l3;
+         int64_t L1,L2,L3,kc,mc,nc;
+         if(__builtin_expect(NULL==blk || esize<=0 || mr<=0 || nr<=0,0)) return;
+         memset(&l1,0,sizeof(l1));
+         memset(&l2,0,sizeof(l2));
+         memset(&l3,0,sizeof(l3));
+         // Sizes are reported in KiB, 0 when the level is absent.
+         get_cacheinfo(CACHE_INFO_L1_D,&l1);
+         get_cacheinfo(CACHE_INFO_L2,&l2);
+         get_cacheinfo(CACHE_INFO_L3,&l3);
+         L1 = (l1.size > 0) ? (int64_t)l1.size*1024LL : 32768LL;
+         L2 = (l2.size > 0) ? (int64_t)l2.size*1024LL : 1048576LL;
+         L3 = (l3.size > 0) ? (int64_t)l3.size*1024LL : 8LL*L2;
+         kc = (L1/2)/((int64_t)nr*esize);
+         kc &= ~7LL;
+         if(kc < 64)   kc = 64;
+         if(kc > 1024) kc = 1024;
+         mc = (L2/2)/(kc*esize);
+         mc = (mc/mr)*mr;
+         if(mc < mr)   mc = mr;
+         nc = (L3/2)/(kc*esize);
+         nc = (nc/nr)*nr;
+         if(nc < nr)   nc = nr;
+         if(nc > GEMM_SKX_NC_MAX) nc = (GEMM_SKX_NC_MAX/nr)*nr;
+         blk->mc = (int32_t)mc;
+         blk->kc = (int32_t)kc;
+         blk->nc = (int32_t)nc;
+         blk->mr = mr;
+         blk->nr = nr;
+}
+
+
+void gemm_thread_grid(const int32_t nth,
+                      const int32_t m,
+                      const int32_t n,
+                      int32_t * __restrict tm,
+                      int32_t * __restrict tn) {
+
+         double best,cost;
+         int32_t t;
+         best = 1.0e300;
+         *tm = nth;
+         *tn = 1;
+         for(t = 1; t <= nth; ++t) {
+             if(nth % t) continue;
+             // Tiles narrower than a micro-tile only add edge-kernel work.
+             if(t > 1 && m/t < 8) continue;
+             if(nth/t > 1 && n/(nth/t) < 8) continue;
+             // Each thread packs m/tm rows of A and n/tn columns of B.
+             cost = (double)m/(double)t+(double)n/(double)(nth/t);
+             if(cost < best) {
+                best = cost;
+                *tm  = t;
+                *tn  = nth/t;
+             }
+         }
+}
+
+
+void gemm_partition(const int32_t len,
+                    const int32_t np,
+                    const int32_t p,
+                    const int32_t q,
+                    int32_t * __restrict lo,
+                    int32_t * __restrict cnt) {
+
+         const int32_t nblk = (len+q-1)/q;
+         const int32_t b0   = (int32_t)(((int64_t)nblk*p)/np);
+         const int32_t b1   = (int32_t)(((int64_t)nblk*(p+1))/np);
+         int32_t hi;
+         *lo = b0*q;
+         hi  = b1*q;
+         if(hi > len) hi = len;
+         *cnt = (hi > *lo) ? hi-*lo : 0;
+}
+
+
+int32_t gemm_op(const char t) {
+
+         switch(t) {
+             case 'N': case 'n': return (GEMM_OP_N);
+             case 'T': case 't': return (GEMM_OP_T);
+             case 'C': case 'c': return (GEMM_OP_C);
+             default:            return (-1);
+         }
+}
+
+
+int32_t gemm_check_args(const char transa,
+                        const char transb,
+                        const int32_t m,
+                        const int32_t n,
+                        const int32_t k,
+                        const int32_t lda,
+                        const int32_t ldb,
+                        const int32_t ldc) {
+
+         const int32_t ta = gemm_op(transa);
+         const int32_t tb = gemm_op(transb);
+         int32_t nra,nrb;
+         if(ta < 0 || tb < 0) return (-1);
+         if(m < 0 || n < 0 || k < 0) return (-1);
+         nra = (ta != GEMM_OP_N) ? k : m;
+         nrb = (tb != GEMM_OP_N) ? n : k;
+         if(lda < ((nra > 1) ? nra : 1)) return (-1);
+         if(ldb < ((nrb > 1) ? nrb : 1)) return (-1);
+         if(ldc < ((m > 1)   ? m   : 1)) return (-1);
+         return (0);
+}
+
+
+/*
+     Serial blocked product on C(m0:m0+m,n0:n0+n) += alpha*op(A)*op(B).
+     C must already be scaled by beta.
+*/
+static
+void gemm_blocked_skx(const gemm_ukr_desc_t * __restrict d,
+                      const gemm_blocking_t * __restrict blk,
+                      const int32_t opa,
+                      const int32_t opb,
+                      const int32_t m0,
+                      const int32_t m,
+                      const int32_t n0,
+                      const int32_t n,
+                      const int32_t k,
+                      const void * __restrict alpha,
+                      const void * __restrict A,
+                      const int32_t lda,
+                      const void * __restrict B,
+                      const int32_t ldb,
+                      void * __restrict C,
+                      const int32_t ldc,
+                      unsigned char * __restrict Ap,
+                      unsigned char * __restrict Bp) {
+
+         const int64_t esp = d->esize_p;
+         const int64_t esc = d->esize_c;
+         unsigned char * __restrict Cb = (unsigned char*)C;
+         int32_t jc,pc,ic,jr,ir,nb,kb,mb,mrem,nrem;
+         for(jc = 0; jc < n; jc += blk->nc) {
+             nb = (n-jc < blk->nc) ? n-jc : blk->nc;
+             for(pc = 0; pc < k; pc += blk->kc) {
+                 kb = (k-pc < blk->kc) ? k-pc : blk->kc;
+                 d->pack_b(opb,nb,kb,B,ldb,n0+jc,pc,Bp);
+                 for(ic = 0; ic < m; ic += blk->mc) {
+                     mb = (m-ic < blk->mc) ? m-ic : blk->mc;
+                     d->pack_a(opa,mb,kb,A,lda,m0+ic,pc,Ap);
+                     for(jr = 0; jr < nb; jr += d->nr) {
+                         nrem = (nb-jr < d->nr) ? nb-jr : d->nr;
+                         const unsigned char * __restrict bp = &Bp[(int64_t)jr*kb*esp];
+                         for(ir = 0; ir < mb; ir += d->mr) {
+                             mrem = (mb-ir < d->mr) ? mb-ir : d->mr;
+                             d->ukr(kb,alpha,&Ap[(int64_t)ir*kb*esp],bp,
+                                    &Cb[((int64_t)(m0+ic+ir)+(int64_t)(n0+jc+jr)*ldc)*esc],
+                                    ldc,mrem,nrem);
+                         }
+                     }
+                 }
+             }
+         }
+}
+
+
+static inline
+void gemm_buffer_sizes(const gemm_ukr_desc_t * __restrict d,
+                       const gemm_blocking_t * __restrict blk,
+                       const int32_t m,
+                       const int32_t n,
+                       int64_t * __restrict sa,
+                       int64_t * __restrict sb) {
+
+         const int32_t mcb = (m < blk->mc) ? m : blk->mc;
+         const int32_t ncb = (n < blk->nc) ? n : blk->nc;
+         const int64_t mp  = ((int64_t)(mcb+d->mr-1)/d->mr)*d->mr;
+         const int64_t np  = ((int64_t)(ncb+d->nr-1)/d->nr)*d->nr;
+         // Rounded up to whole cache lines so that consecutive buffers stay aligned.
+         *sa = ((mp*blk->kc*d->esize_p)+63) & ~63LL;
+         *sb = ((np*blk->kc*d->esize_p)+63) & ~63LL;
+}
+
+
+int32_t gemm_driver_skx(const gemm_ukr_desc_t * __restrict d,
+                        const gemm_blocking_t * __restrict blk,
+                        const int32_t opa,
+                        const int32_t opb,
+                        const int32_t m,
+                        const int32_t n,
+                        const int32_t k,
+                        const void * __restrict alpha,
+                        const void * __restrict A,
+                        const int32_t lda,
+                        const void * __restrict B,
+                        const int32_t ldb,
+                        const void * __restrict beta,
+                        void * __restrict C,
+                        const int32_t ldc) {
+
+         unsigned char * __restrict buf = NULL;
+         int64_t sa,sb;
+         if(__builtin_expect(NULL==d || NULL==blk,0)) return (-1);
+         if(m == 0 || n == 0) return (0);
+         d->scal(m,n,beta,C,ldc);
+         if(k == 0) return (0);
+         gemm_buffer_sizes(d,blk,m,n,&sa,&sb);
+         buf = (unsigned char*)_mm_malloc((size_t)(sa+sb),64);
+         if(__builtin_expect(NULL==buf,0)) return (-2);
+         gemm_blocked_skx(d,blk,opa,opb,0,m,0,n,k,alpha,A,lda,B,ldb,C,ldc,buf,buf+sa);
+         _mm_free(buf);
+         return (0);
+}
+
+
+int32_t gemm_driver_skx_omp(const gemm_ukr_desc_t * __restrict d,
+                            const gemm_blocking_t * __restrict blk,
+                            const int32_t opa,
+                            const int32_t opb,
+                            const int32_t m,
+                            const int32_t n,
+                            const int32_t k,
+                            const void * __restrict alpha,
+                            const void * __restrict A,
+                            const int32_t lda,
+                            const void * __restrict B,
+                            const int32_t ldb,
+                            const void * __restrict beta,
+                            void * __restrict C,
+                            const int32_t ldc) {
+
+#if defined(_OPENMP)
+         unsigned char * __restrict buf = NULL;
+         int64_t sa,sb;
+         int32_t nth,tm,tn;
+         if(__builtin_expect(NULL==d || NULL==blk,0)) return (-1);
+         if(m == 0 || n == 0) return (0);
+         nth = omp_get_max_threads();
+         if(nth <= 1 || (double)m*(double)n*(double)k < (double)GEMM_SKX_OMP_MIN_FLOP) {
+            return (gemm_driver_skx(d,blk,opa,opb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc));
+         }
+         gemm_thread_grid(nth,m,n,&tm,&tn);
+         gemm_buffer_sizes(d,blk,m,n,&sa,&sb);
+         buf = (unsigned char*)_mm_malloc((size_t)nth*(size_t)(sa+sb),64);
+         if(__builtin_expect(NULL==buf,0)) return (-2);
+#pragma omp parallel num_threads(nth) default(none) \
+        shared(d,blk,alpha,beta,A,B,C,buf) \
+        firstprivate(opa,opb,m,n,k,lda,ldb,ldc,tm,tn,sa,sb)
+         {
+              const int32_t tid  = omp_get_thread_num();
+              const int32_t nthr = omp_get_num_threads();
+              unsigned char * __restrict Ap = &buf[(int64_t)tid*(sa+sb)];
+              unsigned char * __restrict Bp = Ap+sa;
+              unsigned char * __restrict Cb = (unsigned char*)C;
+              int32_t t,m0,mb,n0,nb;
+              for(t = tid; t < tm*tn; t += nthr) {
+                  gemm_partition(m,tm,t/tn,d->mr,&m0,&mb);
+                  gemm_partition(n,tn,t%tn,d->nr,&n0,&nb);
+                  if(mb == 0 || nb == 0) continue;
+                  d->scal(mb,nb,beta,&Cb[((int64_t)m0+(int64_t)n0*ldc)*d->esize_c],ldc);
+                  if(k == 0) continue;
+                  gemm_blocked_skx(d,blk,opa,opb,m0,mb,n0,nb,k,alpha,A,lda,B,ldb,C,ldc,Ap,Bp);
+              }
+         }
+         _mm_free(buf);
+         return (0);
+#else
+         return (gemm_driver_skx(d,blk,opa,opb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc));
+#endif
+}
@@ -0,0 +1,179 @@
+
+
+#ifndef __GMS_GEMM_DRIVER_SKX_H__
+#define __GMS_GEMM_DRIVER_SKX_H__
+
+//
+// Type-generic packing/blocking GEMM driver shared by the SkylakeX GEMM
+// micro-kernels (sgemm 32x12, sgemm fp64-accumulate 16x8, zgemm 8x6) and
+// the cache blocking / thread partitioning helpers used by dgemm_skx.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 17:00 PM +00200
+//
+// C := alpha*op(A)*op(B) + beta*C, column-major storage.
+// Loop structure (Goto/BLIS):
+//    jc over N step NC -> pack op(B) KCxNC into NR-wide panels (zero padded)
+//    pc over K step KC
+//    ic over M step MC -> pack op(A) MCxKC into MR-high panels (zero padded)
+//    jr over NC step NR, ir over MC step MR -> micro-kernel
+// The element type is opaque to the driver: a descriptor supplies the packing
+// routines, the micro-kernel, the beta scaling and the element sizes.
+// Micro-kernels compute C(mrem x nrem) += alpha * Ap(MR x kb) * Bp(kb x NR)
+// and must honour partial tiles (mrem < MR or nrem < NR).
+//
+
+#include <stdint.h>
+
+
+#define GEMM_OP_N 0
+#define GEMM_OP_T 1
+#define GEMM_OP_C 2   // conjugate transpose (complex types)
+
+// Upper limit of the outer (NC) block.
+#if !defined(GEMM_SKX_NC_MAX)
+    #define GEMM_SKX_NC_MAX 4096
+#endif
+
+// Below this value of m*n*k the _omp drivers run serially.
+#if !defined(GEMM_SKX_OMP_MIN_FLOP)
+    #define GEMM_SKX_OMP_MIN_FLOP 2097152
+#endif
+
+
+            typedef struct gemm_blocking_t {
+
+                    int32_t mc;
+                    int32_t kc;
+                    int32_t nc;
+                    int32_t mr;
+                    int32_t nr;
+            } gemm_blocking_t;
+
+
+            // Packs op(X) rows/cols [x0,x0+len) times k-range [p0,p0+kb) into
+            // zero-padded panels (MR rows for A, NR columns for B), k-major.
+            typedef void (*gemm_pack_fn)(const int32_t,     // op
+                                         const int32_t,     // len
+                                         const int32_t,     // kb
+                                         const void * __restrict,
+                                         const int32_t,     // ld
+                                         const int32_t,     // x0
+                                         const int32_t,     // p0
+                                         void * __restrict);
+
+            typedef void (*gemm_ukr_fn)(const int32_t,      // kb
+                                        const void * __restrict, // alpha
+                                        const void * __restrict, // Ap
+                                        const void * __restrict, // Bp
+                                        void * __restrict,       // C
+                                        const int32_t,      // ldc
+                                        const int32_t,      // mrem
+                                        const int32_t);     // nrem
+
+            typedef void (*gemm_scal_fn)(const int32_t,
+                                         const int32_t,
+                                         const void * __restrict, // beta
+                                         void * __restrict,
+                                         const int32_t);
+
+
+            typedef struct gemm_ukr_desc_t {
+
+                    int32_t       esize_p;  // bytes per packed element
+                    int32_t       esize_c;  // bytes per element of C
+                    int32_t       mr;
+                    int32_t       nr;
+                    gemm_pack_fn  pack_a;
+                    gemm_pack_fn  pack_b;
+                    gemm_ukr_fn   ukr;
+                    gemm_scal_fn  scal;
+            } gemm_ukr_desc_t;
+
+
+            // Analytical blocking: KC such that the NR x KC micro-panel of B
+            // takes half of L1D, MC such that the MC x KC block of A takes half
+            // of L2, NC such that the KC x NC panel of B takes half of the LLC
+            // (sizes from get_cacheinfo).
+            void gemm_cache_blocking(const int32_t,
+                                     const int32_t,
+                                     const int32_t,
+                                     gemm_blocking_t * __restrict) __attribute__((cold))
+                                                                   __attribute__((aligned(32)));
+
+
+            // Thread grid tm x tn = nth minimizing the per-thread packing volume.
+            void gemm_thread_grid(const int32_t,
+                                  const int32_t,
+                                  const int32_t,
+                                  int32_t * __restrict,
+                                  int32_t * __restrict)  __attribute__((cold))
+                                                         __attribute__((aligned(32)));
+
+
+            // Start and length of part p of [0,len) split in np parts on multiples of q.
+            void gemm_partition(const int32_t,
+                                const int32_t,
+                                const int32_t,
+                                const int32_t,
+                                int32_t * __restrict,
+                                int32_t * __restrict)    __attribute__((hot))
+                                                         __attribute__((aligned(32)));
+
+
+            // Returns GEMM_OP_N/T/C or -1.
+            int32_t gemm_op(const char)                  __attribute__((hot))
+                                                         __attribute__((aligned(32)));
+
+
+            // Argument check, BLAS rules. Returns 0 or -1.
+            int32_t gemm_check_args(const char,
+                                    const char,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t)       __attribute__((hot))
+                                                         __attribute__((aligned(32)));
+
+
+            int32_t gemm_driver_skx(const gemm_ukr_desc_t * __restrict,
+                                    const gemm_blocking_t * __restrict,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const int32_t,
+                                    const void * __restrict,
+                                    const void * __restrict,
+                                    const int32_t,
+                                    const void * __restrict,
+                                    const int32_t,
+                                    const void * __restrict,
+                                    void * __restrict,
+                                    const int32_t)       __attribute__((noinline))
+                                                         __attribute__((hot))
+                                                         __attribute__((aligned(32)));
+
+
+            int32_t gemm_driver_skx_omp(const gemm_ukr_desc_t * __restrict,
+                                        const gemm_blocking_t * __restrict,
+                                        const int32_t,
+                                        const int32_t,
+                                        const int32_t,
+                                        const int32_t,
+                                        const int32_t,
+                                        const void * __restrict,
+                                        const void * __restrict,
+                                        const int32_t,
+                                        const void * __restrict,
+                                        const int32_t,
+                                        const void * __restrict,
+                                        void * __restrict,
+                                        const int32_t)   __attribute__((noinline))
+                                                         __attribute__((hot))
+                                                         __attribute__((aligned(32)));
+
+
+
+#endif /*__GMS_GEMM_DRIVER_SKX_H__*/
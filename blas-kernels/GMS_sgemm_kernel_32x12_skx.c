@@ -0,0 +1,437 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#include "GMS_sgemm_kernel_32x12_skx.h"
+
+
+static gemm_blocking_t sgemm_skx_blk      = {0,0,0,0,0};
+static gemm_blocking_t sgemm_dacc_skx_blk = {0,0,0,0,0};
+static volatile int32_t sgemm_skx_blk_ready = 0;
+
+
+static inline
+void sgemm_skx_blocking_init(void) {
+
+        if(__builtin_expect(!__atomic_load_n(&sgemm_skx_blk_ready,__ATOMIC_ACQUIRE),0)) {
+           gemm_blocking_t b0,b1;
+           gemm_cache_blocking((int32_t)sizeof(float),SGEMM_SKX_MR,SGEMM_SKX_NR,&b0);
+           gemm_cache_blocking((int32_t)sizeof(float),SGEMM_DACC_SKX_MR,SGEMM_DACC_SKX_NR,&b1);
+           sgemm_skx_blk      = b0;
+           sgemm_dacc_skx_blk = b1;
+           __atomic_store_n(&sgemm_skx_blk_ready,1,__ATOMIC_RELEASE);
+        }
+}
+
+
+static inline
+__mmask16 sgemm_mask16(const int32_t n) {
+        return ((n >= 16) ? (__mmask16)0xFFFF : (n <= 0) ? (__mmask16)0 : (__mmask16)((1U << n)-1U));
+}
+
+
+/*
+     Packing (fp32): op(A) -> MR-row panels, op(B) -> NR-column panels,
+     zero padded, k-major.
+*/
+static inline
+void sgemm_pack_a_mr(const int32_t mr,
+                     const int32_t op,
+                     const int32_t mb,
+                     const int32_t kb,
+                     const float * __restrict A,
+                     const int32_t lda,
+                     const int32_t i0,
+                     const int32_t p0,
+                     float * __restrict Ap) {
+
+        int32_t i,w,p,r;
+        for(i = 0; i < mb; i += mr) {
+            w = (mb-i < mr) ? mb-i : mr;
+            if(op == GEMM_OP_N) {
+               const float * __restrict a = &A[(int64_t)(i0+i)+(int64_t)p0*lda];
+               const __mmask16 k0 = sgemm_mask16(w);
+               const __mmask16 k1 = sgemm_mask16(w-16);
+               for(p = 0; p != kb; ++p) {
+                   _mm512_storeu_ps(&Ap[p*mr],_mm512_maskz_loadu_ps(k0,&a[(int64_t)p*lda]));
+                   if(mr == 32)
+                      _mm512_storeu_ps(&Ap[p*mr+16],_mm512_maskz_loadu_ps(k1,&a[(int64_t)p*lda+16]));
+               }
+            }
+            else {
+               for(r = 0; r != w; ++r) {
+                   const float * __restrict a = &A[(int64_t)p0+(int64_t)(i0+i+r)*lda];
+                   for(p = 0; p != kb; ++p) Ap[p*mr+r] = a[p];
+               }
+               for(r = w; r < mr; ++r) {
+                   for(p = 0; p != kb; ++p) Ap[p*mr+r] = 0.0f;
+               }
+            }
+            Ap += (int64_t)mr*kb;
+        }
+}
+
+
+static inline
+void sgemm_pack_b_nr(const int32_t nr,
+                     const int32_t op,
+                     const int32_t nb,
+                     const int32_t kb,
+                     const float * __restrict B,
+                     const int32_t ldb,
+                     const int32_t j0,
+                     const int32_t p0,
+                     float * __restrict Bp) {
+
+        int32_t j,w,p,c;
+        for(j = 0; j < nb; j += nr) {
+            w = (nb-j < nr) ? nb-j : nr;
+            if(op != GEMM_OP_N) {
+               const float * __restrict b = &B[(int64_t)(j0+j)+(int64_t)p0*ldb];
+               const __mmask16 k0 = sgemm_mask16(w);
+               const __mmask16 ks = sgemm_mask16(nr);
+               for(p = 0; p != kb; ++p) {
+                   _mm512_mask_storeu_ps(&Bp[p*nr],ks,_mm512_maskz_loadu_ps(k0,&b[(int64_t)p*ldb]));
+               }
+            }
+            else {
+               for(c = 0; c != w; ++c) {
+                   const float * __restrict b = &B[(int64_t)p0+(int64_t)(j0+j+c)*ldb];
+                   for(p = 0; p != kb; ++p) Bp[p*nr+c] = b[p];
+               }
+               for(c = w; c < nr; ++c) {
+                   for(p = 0; p != kb; ++p) Bp[p*nr+c] = 0.0f;
+               }
+            }
+            Bp += (int64_t)nr*kb;
+        }
+}
+
+
+static void
+sgemm_pack_a_32(const int32_t op, const int32_t mb, const int32_t kb,
+                const void * __restrict A, const int32_t lda,
+                const int32_t i0, const int32_t p0, void * __restrict Ap) {
+        sgemm_pack_a_mr(SGEMM_SKX_MR,op,mb,kb,(const float*)A,lda,i0,p0,(float*)Ap);
+}
+
+
+static void
+sgemm_pack_b_12(const int32_t op, const int32_t nb, const int32_t kb,
+                const void * __restrict B, const int32_t ldb,
+                const int32_t j0, const int32_t p0, void * __restrict Bp) {
+        sgemm_pack_b_nr(SGEMM_SKX_NR,op,nb,kb,(const float*)B,ldb,j0,p0,(float*)Bp);
+}
+
+
+static void
+sgemm_pack_a_16(const int32_t op, const int32_t mb, const int32_t kb,
+                const void * __restrict A, const int32_t lda,
+                const int32_t i0, const int32_t p0, void * __restrict Ap) {
+        sgemm_pack_a_mr(SGEMM_DACC_SKX_MR,op,mb,kb,(const float*)A,lda,i0,p0,(float*)Ap);
+}
+
+
+static void
+sgemm_pack_b_8(const int32_t op, const int32_t nb, const int32_t kb,
+               const void * __restrict B, const int32_t ldb,
+               const int32_t j0, const int32_t p0, void * __restrict Bp) {
+        sgemm_pack_b_nr(SGEMM_DACC_SKX_NR,op,nb,kb,(const float*)B,ldb,j0,p0,(float*)Bp);
+}
+
+
+static void
+sgemm_scale_c(const int32_t m,
+              const int32_t n,
+              const void * __restrict vbeta,
+              void * __restrict vC,
+              const int32_t ldc) {
+
+        const float beta = *(const float*)vbeta;
+        float * __restrict C = (float*)vC;
+        int32_t i,j;
+        if(beta == 1.0f) return;
+        if(beta == 0.0f) {
+           for(j = 0; j != n; ++j) memset(&C[(int64_t)j*ldc],0,(size_t)m*sizeof(float));
+           return;
+        }
+        {
+           const __m512 vb = _mm512_set1_ps(beta);
+           for(j = 0; j != n; ++j) {
+               float * __restrict c = &C[(int64_t)j*ldc];
+               for(i = 0; i+16 <= m; i += 16) {
+                   _mm512_storeu_ps(&c[i],_mm512_mul_ps(vb,_mm512_loadu_ps(&c[i])));
+               }
+               if(i < m) {
+                  const __mmask16 k = sgemm_mask16(m-i);
+                  _mm512_mask_storeu_ps(&c[i],k,_mm512_mul_ps(vb,_mm512_maskz_loadu_ps(k,&c[i])));
+               }
+           }
+        }
+}
+
+
+/*
+     32x12 fp32 micro-kernel.
+*/
+#define SGEMM_FMA_COL(j,jj)                                         \
+        b = _mm512_set1_ps(bp[jj]);                                  \
+        c0##j = _mm512_fmadd_ps(a0,b,c0##j);                        \
+        c1##j = _mm512_fmadd_ps(a1,b,c1##j);
+
+#define SGEMM_STORE_COL(j,jj)                                                          \
+        if(jj < nrem) {                                                                \
+           float * __restrict cj = &C[(int64_t)jj*ldc];                                 \
+           if(full) {                                                                  \
+              _mm512_storeu_ps(&cj[0], _mm512_fmadd_ps(va,c0##j,_mm512_loadu_ps(&cj[0])));  \
+              _mm512_storeu_ps(&cj[16],_mm512_fmadd_ps(va,c1##j,_mm512_loadu_ps(&cj[16]))); \
+           }                                                                           \
+           else {                                                                      \
+              _mm512_mask_storeu_ps(&cj[0],k0,                                         \
+                    _mm512_fmadd_ps(va,c0##j,_mm512_maskz_loadu_ps(k0,&cj[0])));       \
+              _mm512_mask_storeu_ps(&cj[16],k1,                                        \
+                    _mm512_fmadd_ps(va,c1##j,_mm512_maskz_loadu_ps(k1,&cj[16])));      \
+           }                                                                           \
+        }
+
+static void
+sgemm_ukr_32x12(const int32_t kb,
+                const void * __restrict valpha,
+                const void * __restrict vAp,
+                const void * __restrict vBp,
+                void * __restrict vC,
+                const int32_t ldc,
+                const int32_t mrem,
+                const int32_t nrem) {
+
+        const float * __restrict ap = (const float*)vAp;
+        const float * __restrict bp = (const float*)vBp;
+        float * __restrict C = (float*)vC;
+        __m512 c00,c01,c02,c03,c04,c05,c06,c07,c08,c09,c0a,c0b;
+        __m512 c10,c11,c12,c13,c14,c15,c16,c17,c18,c19,c1a,c1b;
+        __m512 a0,a1,b;
+        int32_t p;
+        c00 = c01 = c02 = c03 = c04 = c05 = _mm512_setzero_ps();
+        c06 = c07 = c08 = c09 = c0a = c0b = _mm512_setzero_ps();
+        c10 = c11 = c12 = c13 = c14 = c15 = _mm512_setzero_ps();
+        c16 = c17 = c18 = c19 = c1a = c1b = _mm512_setzero_ps();
+        for(p = 0; p != kb; ++p) {
+            _mm_prefetch((const char*)&ap[8*SGEMM_SKX_MR],_MM_HINT_T0);
+            a0 = _mm512_loadu_ps(&ap[0]);
+            a1 = _mm512_loadu_ps(&ap[16]);
+            SGEMM_FMA_COL(0,0)
+            SGEMM_FMA_COL(1,1)
+            SGEMM_FMA_COL(2,2)
+            SGEMM_FMA_COL(3,3)
+            SGEMM_FMA_COL(4,4)
+            SGEMM_FMA_COL(5,5)
+            SGEMM_FMA_COL(6,6)
+            SGEMM_FMA_COL(7,7)
+            SGEMM_FMA_COL(8,8)
+            SGEMM_FMA_COL(9,9)
+            SGEMM_FMA_COL(a,10)
+            SGEMM_FMA_COL(b,11)
+            ap += SGEMM_SKX_MR;
+            bp += SGEMM_SKX_NR;
+        }
+        {
+           const __m512 va = _mm512_set1_ps(*(const float*)valpha);
+           const int32_t full = (mrem == SGEMM_SKX_MR);
+           const __mmask16 k0 = sgemm_mask16(mrem);
+           const __mmask16 k1 = sgemm_mask16(mrem-16);
+           SGEMM_STORE_COL(0,0)
+           SGEMM_STORE_COL(1,1)
+           SGEMM_STORE_COL(2,2)
+           SGEMM_STORE_COL(3,3)
+           SGEMM_STORE_COL(4,4)
+           SGEMM_STORE_COL(5,5)
+           SGEMM_STORE_COL(6,6)
+           SGEMM_STORE_COL(7,7)
+           SGEMM_STORE_COL(8,8)
+           SGEMM_STORE_COL(9,9)
+           SGEMM_STORE_COL(a,10)
+           SGEMM_STORE_COL(b,11)
+        }
+}
+
+#undef SGEMM_FMA_COL
+#undef SGEMM_STORE_COL
+
+
+/*
+     16x8 micro-kernel, fp32 in/out, fp64 accumulation.
+*/
+#define SDACC_FMA_COL(j)                                            \
+        b = _mm512_set1_pd((double)bp[j]);                          \
+        c0##j = _mm512_fmadd_pd(a0,b,c0##j);                        \
+        c1##j = _mm512_fmadd_pd(a1,b,c1##j);
+
+#define SDACC_STORE_COL(j)                                                              \
+        if(j < nrem) {                                                                  \
+           float * __restrict cj = &C[(int64_t)j*ldc];                                  \
+           const __m512d o0 = _mm512_fmadd_pd(va,c0##j,                                 \
+                                  _mm512_cvtps_pd(_mm256_maskz_loadu_ps(k0,&cj[0])));   \
+           const __m512d o1 = _mm512_fmadd_pd(va,c1##j,                                 \
+                                  _mm512_cvtps_pd(_mm256_maskz_loadu_ps(k1,&cj[8])));   \
+           _mm256_mask_storeu_ps(&cj[0],k0,_mm512_cvtpd_ps(o0));                        \
+           _mm256_mask_storeu_ps(&cj[8],k1,_mm512_cvtpd_ps(o1));                        \
+        }
+
+static void
+sgemm_dacc_ukr_16x8(const int32_t kb,
+                    const void * __restrict valpha,
+                    const void * __restrict vAp,
+                    const void * __restrict vBp,
+                    void * __restrict vC,
+                    const int32_t ldc,
+                    const int32_t mrem,
+                    const int32_t nrem) {
+
+        const float * __restrict ap = (const float*)vAp;
+        const float * __restrict bp = (const float*)vBp;
+        float * __restrict C = (float*)vC;
+        __m512d c00,c01,c02,c03,c04,c05,c06,c07;
+        __m512d c10,c11,c12,c13,c14,c15,c16,c17;
+        __m512d a0,a1,b;
+        int32_t p;
+        c00 = c01 = c02 = c03 = c04 = c05 = c06 = c07 = _mm512_setzero_pd();
+        c10 = c11 = c12 = c13 = c14 = c15 = c16 = c17 = _mm512_setzero_pd();
+        for(p = 0; p != kb; ++p) {
+            const __m512 a = _mm512_loadu_ps(ap);
+            a0 = _mm512_cvtps_pd(_mm512_castps512_ps256(a));
+            a1 = _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a),1)));
+            SDACC_FMA_COL(0)
+            SDACC_FMA_COL(1)
+            SDACC_FMA_COL(2)
+            SDACC_FMA_COL(3)
+            SDACC_FMA_COL(4)
+            SDACC_FMA_COL(5)
+            SDACC_FMA_COL(6)
+            SDACC_FMA_COL(7)
+            ap += SGEMM_DACC_SKX_MR;
+            bp += SGEMM_DACC_SKX_NR;
+        }
+        {
+           const __m512d va = _mm512_set1_pd((double)*(const float*)valpha);
+           const __mmask8 k0 = (__mmask8)sgemm_mask16((mrem > 8) ? 8 : mrem);
+           const __mmask8 k1 = (__mmask8)sgemm_mask16(mrem-8);
+           SDACC_STORE_COL(0)
+           SDACC_STORE_COL(1)
+           SDACC_STORE_COL(2)
+           SDACC_STORE_COL(3)
+           SDACC_STORE_COL(4)
+           SDACC_STORE_COL(5)
+           SDACC_STORE_COL(6)
+           SDACC_STORE_COL(7)
+        }
+}
+
+#undef SDACC_FMA_COL
+#undef SDACC_STORE_COL
+
+
+static const gemm_ukr_desc_t sgemm_skx_desc = {
+        (int32_t)sizeof(float),(int32_t)sizeof(float),SGEMM_SKX_MR,SGEMM_SKX_NR,
+        sgemm_pack_a_32,sgemm_pack_b_12,sgemm_ukr_32x12,sgemm_scale_c
+};
+
+static const gemm_ukr_desc_t sgemm_dacc_skx_desc = {
+        (int32_t)sizeof(float),(int32_t)sizeof(float),SGEMM_DACC_SKX_MR,SGEMM_DACC_SKX_NR,
+        sgemm_pack_a_16,sgemm_pack_b_8,sgemm_dacc_ukr_16x8,sgemm_scale_c
+};
+
+
+int32_t sgemm_skx(const char transa,
+                  const char transb,
+                  const int32_t m,
+                  const int32_t n,
+                  const int32_t k,
+                  const float alpha,
+                  const float * __restrict A,
+                  const int32_t lda,
+                  const float * __restrict B,
+                  const int32_t ldb,
+                  const float beta,
+                  float * __restrict C,
+                  const int32_t ldc) {
+
+        const float a = alpha;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        sgemm_skx_blocking_init();
+        return (gemm_driver_skx(&sgemm_skx_desc,&sgemm_skx_blk,gemm_op(transa),gemm_op(transb),
+                                m,n,(0.0f==alpha)?0:k,&a,A,lda,B,ldb,&beta,C,ldc));
+}
+
+
+int32_t sgemm_skx_omp(const char transa,
+                      const char transb,
+                      const int32_t m,
+                      const int32_t n,
+                      const int32_t k,
+                      const float alpha,
+                      const float * __restrict A,
+                      const int32_t lda,
+                      const float * __restrict B,
+                      const int32_t ldb,
+                      const float beta,
+                      float * __restrict C,
+                      const int32_t ldc) {
+
+        const float a = alpha;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        sgemm_skx_blocking_init();
+        return (gemm_driver_skx_omp(&sgemm_skx_desc,&sgemm_skx_blk,gemm_op(transa),gemm_op(transb),
+                                    m,n,(0.0f==alpha)?0:k,&a,A,lda,B,ldb,&beta,C,ldc));
+}
+
+
+int32_t sgemm_skx_dacc(const char transa,
+                       const char transb,
+                       const int32_t m,
+                       const int32_t n,
+                       const int32_t k,
+                       const float alpha,
+                       const float * __restrict A,
+                       const int32_t lda,
+                       const float * __restrict B,
+                       const int32_t ldb,
+                       const float beta,
+                       float * __restrict C,
+                       const int32_t ldc) {
+
+        const float a = alpha;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        sgemm_skx_blocking_init();
+        return (gemm_driver_skx(&sgemm_dacc_skx_desc,&sgemm_dacc_skx_blk,gemm_op(transa),gemm_op(transb),
+                                m,n,(0.0f==alpha)?0:k,&a,A,lda,B,ldb,&beta,C,ldc));
+}
+
+
+int32_t sgemm_skx_dacc_omp(const char transa,
+                           const char transb,
+                           const int32_t m,
+                           const int32_t n,
+                           const int32_t k,
+                           const float alpha,
+                           const float * __restrict A,
+                           const int32_t lda,
+                           const float * __restrict B,
+                           const int32_t ldb,
+                           const float beta,
+                           float * __restrict C,
+                           const int32_t ldc) {
+
+        const float a = alpha;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        sgemm_skx_blocking_init();
+        return (gemm_driver_skx_omp(&sgemm_dacc_skx_desc,&sgemm_dacc_skx_blk,gemm_op(transa),gemm_op(transb),
+                                    m,n,(0.0f==alpha)?0:k,&a,A,lda,B,ldb,&beta,C,ldc));
+}
@@ -0,0 +1,104 @@
+
+
+#ifndef __GMS_SGEMM_KERNEL_32X12_SKX_H__
+#define __GMS_SGEMM_KERNEL_32X12_SKX_H__
+
+//
+// AVX512 SGEMM micro-kernels and drivers (SkylakeX and later).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 17:00 PM +00200
+//
+// sgemm_skx       -> fp32 inputs, fp32 accumulation, 32x12 register tile
+//                    (2 ZMM rows x 12 broadcast columns = 24 accumulators).
+// sgemm_skx_dacc  -> fp32 inputs and output, fp64 accumulation, 16x8 tile
+//                    (packed fp32 panels are widened in registers, C is updated
+//                    with one fp64->fp32 rounding per KC block instead of one
+//                    per product term).
+// Both share the packing/blocking driver in GMS_gemm_driver_skx.c: A packed in
+// zero-padded MR-row panels, B in zero-padded NR-column panels, k-major.
+// Partial tiles are stored through AVX512 masks.
+// Column-major storage, op(X) = X ('N') or X^T ('T','C').
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include "GMS_gemm_driver_skx.h"
+
+
+#define SGEMM_SKX_MR      32
+#define SGEMM_SKX_NR      12
+#define SGEMM_DACC_SKX_MR 16
+#define SGEMM_DACC_SKX_NR 8
+
+
+int32_t sgemm_skx(const char,
+                  const char,
+                  const int32_t,
+                  const int32_t,
+                  const int32_t,
+                  const float,
+                  const float * __restrict,
+                  const int32_t,
+                  const float * __restrict,
+                  const int32_t,
+                  const float,
+                  float * __restrict,
+                  const int32_t)         __attribute__((noinline))
+                                         __attribute__((hot))
+                                         __attribute__((aligned(32)));
+
+
+int32_t sgemm_skx_omp(const char,
+                      const char,
+                      const int32_t,
+                      const int32_t,
+                      const int32_t,
+                      const float,
+                      const float * __restrict,
+                      const int32_t,
+                      const float * __restrict,
+                      const int32_t,
+                      const float,
+                      float * __restrict,
+                      const int32_t)     __attribute__((noinline))
+                                         __attribute__((hot))
+                                         __attribute__((aligned(32)));
+
+
+int32_t sgemm_skx_dacc(const char,
+                       const char,
+                       const int32_t,
+                       const int32_t,
+                       const int32_t,
+                       const float,
+                       const float * __restrict,
+                       const int32_t,
+                       const float * __restrict,
+                       const int32_t,
+                       const float,
+                       float * __restrict,
+                       const int32_t)    __attribute__((noinline))
+                                         __attribute__((hot))
+                                         __attribute__((aligned(32)));
+
+
+int32_t sgemm_skx_dacc_omp(const char,
+                           const char,
+                           const int32_t,
+                           const int32_t,
+                           const int32_t,
+                           const float,
+                           const float * __restrict,
+                           const int32_t,
+                           const float * __restrict,
+                           const int32_t,
+                           const float,
+                           float * __restrict,
+                           const int32_t) __attribute__((noinline))
+                                          __attribute__((hot))
+                                          __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_SGEMM_KERNEL_32X12_SKX_H__*/
@@ -0,0 +1,301 @@
+
+
+#include <immintrin.h>
+#include <string.h>
+#include "GMS_zgemm_kernel_8x6_skx.h"
+
+
+static gemm_blocking_t zgemm_skx_blk = {0,0,0,0,0};
+static volatile int32_t zgemm_skx_blk_ready = 0;
+
+
+static inline
+const gemm_blocking_t * zgemm_skx_blocking(void) {
+
+        if(__builtin_expect(!__atomic_load_n(&zgemm_skx_blk_ready,__ATOMIC_ACQUIRE),0)) {
+           gemm_blocking_t b;
+           gemm_cache_blocking((int32_t)(2*sizeof(double)),ZGEMM_SKX_MR,ZGEMM_SKX_NR,&b);
+           zgemm_skx_blk = b;
+           __atomic_store_n(&zgemm_skx_blk_ready,1,__ATOMIC_RELEASE);
+        }
+        return (&zgemm_skx_blk);
+}
+
+
+// Mask of the doubles holding complex elements [lo,lo+4) of a row of n elements.
+static inline
+__mmask8 zgemm_mask4(const int32_t n) {
+        return ((n >= 4) ? (__mmask8)0xFF : (n <= 0) ? (__mmask8)0 : (__mmask8)((1U << (2*n))-1U));
+}
+
+
+/*
+     Packing: op(A) -> 8-row complex panels, op(B) -> 6-column complex panels,
+     interleaved re,im, zero padded, k-major. Conjugation is folded in here.
+*/
+static void
+zgemm_pack_a_8(const int32_t op,
+               const int32_t mb,
+               const int32_t kb,
+               const void * __restrict vA,
+               const int32_t lda,
+               const int32_t i0,
+               const int32_t p0,
+               void * __restrict vAp) {
+
+        const double * __restrict A = (const double*)vA;
+        double * __restrict Ap = (double*)vAp;
+        int32_t i,w,p,r;
+        for(i = 0; i < mb; i += ZGEMM_SKX_MR) {
+            w = (mb-i < ZGEMM_SKX_MR) ? mb-i : ZGEMM_SKX_MR;
+            if(op == GEMM_OP_N) {
+               const double * __restrict a = &A[2*((int64_t)(i0+i)+(int64_t)p0*lda)];
+               const __mmask8 k0 = zgemm_mask4(w);
+               const __mmask8 k1 = zgemm_mask4(w-4);
+               for(p = 0; p != kb; ++p) {
+                   _mm512_storeu_pd(&Ap[p*16],  _mm512_maskz_loadu_pd(k0,&a[2*(int64_t)p*lda]));
+                   _mm512_storeu_pd(&Ap[p*16+8],_mm512_maskz_loadu_pd(k1,&a[2*(int64_t)p*lda+8]));
+               }
+            }
+            else {
+               const double s = (op == GEMM_OP_C) ? -1.0 : 1.0;
+               for(r = 0; r != w; ++r) {
+                   const double * __restrict a = &A[2*((int64_t)p0+(int64_t)(i0+i+r)*lda)];
+                   for(p = 0; p != kb; ++p) {
+                       Ap[p*16+2*r]   = a[2*p];
+                       Ap[p*16+2*r+1] = s*a[2*p+1];
+                   }
+               }
+               for(r = w; r < ZGEMM_SKX_MR; ++r) {
+                   for(p = 0; p != kb; ++p) {
+                       Ap[p*16+2*r]   = 0.0;
+                       Ap[p*16+2*r+1] = 0.0;
+                   }
+               }
+            }
+            Ap += (int64_t)16*kb;
+        }
+}
+
+
+static void
+zgemm_pack_b_6(const int32_t op,
+               const int32_t nb,
+               const int32_t kb,
+               const void * __restrict vB,
+               const int32_t ldb,
+               const int32_t j0,
+               const int32_t p0,
+               void * __restrict vBp) {
+
+        const double * __restrict B = (const double*)vB;
+        double * __restrict Bp = (double*)vBp;
+        int32_t j,w,p,c;
+        for(j = 0; j < nb; j += ZGEMM_SKX_NR) {
+            w = (nb-j < ZGEMM_SKX_NR) ? nb-j : ZGEMM_SKX_NR;
+            if(op == GEMM_OP_N) {
+               for(c = 0; c != w; ++c) {
+                   const double * __restrict b = &B[2*((int64_t)p0+(int64_t)(j0+j+c)*ldb)];
+                   for(p = 0; p != kb; ++p) {
+                       Bp[p*12+2*c]   = b[2*p];
+                       Bp[p*12+2*c+1] = b[2*p+1];
+                   }
+               }
+            }
+            else {
+               const double s = (op == GEMM_OP_C) ? -1.0 : 1.0;
+               const double * __restrict b = &B[2*((int64_t)(j0+j)+(int64_t)p0*ldb)];
+               for(p = 0; p != kb; ++p) {
+                   for(c = 0; c != w; ++c) {
+                       Bp[p*12+2*c]   = b[2*((int64_t)p*ldb+c)];
+                       Bp[p*12+2*c+1] = s*b[2*((int64_t)p*ldb+c)+1];
+                   }
+               }
+            }
+            for(c = w; c < ZGEMM_SKX_NR; ++c) {
+                for(p = 0; p != kb; ++p) {
+                    Bp[p*12+2*c]   = 0.0;
+                    Bp[p*12+2*c+1] = 0.0;
+                }
+            }
+            Bp += (int64_t)12*kb;
+        }
+}
+
+
+// (x0+i*x1)*(br+i*bi) on interleaved pairs.
+static inline
+__m512d zgemm_cmul_bcast(const __m512d x,
+                         const __m512d br,
+                         const __m512d bi) {
+        return (_mm512_fmaddsub_pd(x,br,_mm512_mul_pd(_mm512_permute_pd(x,0x55),bi)));
+}
+
+
+static void
+zgemm_scale_c(const int32_t m,
+              const int32_t n,
+              const void * __restrict vbeta,
+              void * __restrict vC,
+              const int32_t ldc) {
+
+        const double br = ((const double*)vbeta)[0];
+        const double bi = ((const double*)vbeta)[1];
+        double * __restrict C = (double*)vC;
+        int32_t i,j;
+        if(br == 1.0 && bi == 0.0) return;
+        if(br == 0.0 && bi == 0.0) {
+           for(j = 0; j != n; ++j) memset(&C[2*(int64_t)j*ldc],0,(size_t)m*2*sizeof(double));
+           return;
+        }
+        {
+           const __m512d vbr = _mm512_set1_pd(br);
+           const __m512d vbi = _mm512_set1_pd(bi);
+           for(j = 0; j != n; ++j) {
+               double * __restrict c = &C[2*(int64_t)j*ldc];
+               for(i = 0; i+4 <= m; i += 4) {
+                   _mm512_storeu_pd(&c[2*i],zgemm_cmul_bcast(_mm512_loadu_pd(&c[2*i]),vbr,vbi));
+               }
+               if(i < m) {
+                  const __mmask8 k = zgemm_mask4(m-i);
+                  _mm512_mask_storeu_pd(&c[2*i],k,
+                                zgemm_cmul_bcast(_mm512_maskz_loadu_pd(k,&c[2*i]),vbr,vbi));
+               }
+           }
+        }
+}
+
+
+/*
+     8x6 complex micro-kernel.
+*/
+#define ZGEMM_FMA_COL(j)                                            \
+        br = _mm512_set1_pd(bp[2*j]);                               \
+        bi = _mm512_set1_pd(bp[2*j+1]);                             \
+        r0##j = _mm512_fmadd_pd(a0,br,r0##j);                       \
+        r1##j = _mm512_fmadd_pd(a1,br,r1##j);                       \
+        i0##j = _mm512_fmadd_pd(a0,bi,i0##j);                       \
+        i1##j = _mm512_fmadd_pd(a1,bi,i1##j);
+
+#define ZGEMM_STORE_COL(j)                                                              \
+        if(j < nrem) {                                                                  \
+           double * __restrict cj = &C[2*(int64_t)j*ldc];                               \
+           const __m512d s0 = _mm512_fmaddsub_pd(r0##j,one,_mm512_permute_pd(i0##j,0x55)); \
+           const __m512d s1 = _mm512_fmaddsub_pd(r1##j,one,_mm512_permute_pd(i1##j,0x55)); \
+           _mm512_mask_storeu_pd(&cj[0],k0,                                             \
+                 _mm512_add_pd(_mm512_maskz_loadu_pd(k0,&cj[0]),zgemm_cmul_bcast(s0,var,vai))); \
+           _mm512_mask_storeu_pd(&cj[8],k1,                                             \
+                 _mm512_add_pd(_mm512_maskz_loadu_pd(k1,&cj[8]),zgemm_cmul_bcast(s1,var,vai))); \
+        }
+
+static void
+zgemm_ukr_8x6(const int32_t kb,
+              const void * __restrict valpha,
+              const void * __restrict vAp,
+              const void * __restrict vBp,
+              void * __restrict vC,
+              const int32_t ldc,
+              const int32_t mrem,
+              const int32_t nrem) {
+
+        const double * __restrict ap = (const double*)vAp;
+        const double * __restrict bp = (const double*)vBp;
+        double * __restrict C = (double*)vC;
+        __m512d r00,r01,r02,r03,r04,r05,r10,r11,r12,r13,r14,r15;
+        __m512d i00,i01,i02,i03,i04,i05,i10,i11,i12,i13,i14,i15;
+        __m512d a0,a1,br,bi;
+        int32_t p;
+        r00 = r01 = r02 = r03 = r04 = r05 = _mm512_setzero_pd();
+        r10 = r11 = r12 = r13 = r14 = r15 = _mm512_setzero_pd();
+        i00 = i01 = i02 = i03 = i04 = i05 = _mm512_setzero_pd();
+        i10 = i11 = i12 = i13 = i14 = i15 = _mm512_setzero_pd();
+        for(p = 0; p != kb; ++p) {
+            _mm_prefetch((const char*)&ap[8*16],_MM_HINT_T0);
+            a0 = _mm512_loadu_pd(&ap[0]);
+            a1 = _mm512_loadu_pd(&ap[8]);
+            ZGEMM_FMA_COL(0)
+            ZGEMM_FMA_COL(1)
+            ZGEMM_FMA_COL(2)
+            ZGEMM_FMA_COL(3)
+            ZGEMM_FMA_COL(4)
+            ZGEMM_FMA_COL(5)
+            ap += 16;
+            bp += 12;
+        }
+        {
+           const __m512d one = _mm512_set1_pd(1.0);
+           const __m512d var = _mm512_set1_pd(((const double*)valpha)[0]);
+           const __m512d vai = _mm512_set1_pd(((const double*)valpha)[1]);
+           const __mmask8 k0 = zgemm_mask4(mrem);
+           const __mmask8 k1 = zgemm_mask4(mrem-4);
+           ZGEMM_STORE_COL(0)
+           ZGEMM_STORE_COL(1)
+           ZGEMM_STORE_COL(2)
+           ZGEMM_STORE_COL(3)
+           ZGEMM_STORE_COL(4)
+           ZGEMM_STORE_COL(5)
+        }
+}
+
+#undef ZGEMM_FMA_COL
+#undef ZGEMM_STORE_COL
+
+
+static const gemm_ukr_desc_t zgemm_skx_desc = {
+        (int32_t)(2*sizeof(double)),(int32_t)(2*sizeof(double)),ZGEMM_SKX_MR,ZGEMM_SKX_NR,
+        zgemm_pack_a_8,zgemm_pack_b_6,zgemm_ukr_8x6,zgemm_scale_c
+};
+
+
+int32_t zgemm_skx(const char transa,
+                  const char transb,
+                  const int32_t m,
+                  const int32_t n,
+                  const int32_t k,
+                  const double alpha_r,
+                  const double alpha_i,
+                  const double * __restrict A,
+                  const int32_t lda,
+                  const double * __restrict B,
+                  const int32_t ldb,
+                  const double beta_r,
+                  const double beta_i,
+                  double * __restrict C,
+                  const int32_t ldc) {
+
+        const double alpha[2] = {alpha_r,alpha_i};
+        const double beta[2]  = {beta_r,beta_i};
+        const int32_t kk = (alpha_r == 0.0 && alpha_i == 0.0) ? 0 : k;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        return (gemm_driver_skx(&zgemm_skx_desc,zgemm_skx_blocking(),gemm_op(transa),gemm_op(transb),
+                                m,n,kk,alpha,A,lda,B,ldb,beta,C,ldc));
+}
+
+
+int32_t zgemm_skx_omp(const char transa,
+                      const char transb,
+                      const int32_t m,
+                      const int32_t n,
+                      const int32_t k,
+                      const double alpha_r,
+                      const double alpha_i,
+                      const double * __restrict A,
+                      const int32_t lda,
+                      const double * __restrict B,
+                      const int32_t ldb,
+                      const double beta_r,
+                      const double beta_i,
+                      double * __restrict C,
+                      const int32_t ldc) {
+
+        const double alpha[2] = {alpha_r,alpha_i};
+        const double beta[2]  = {beta_r,beta_i};
+        const int32_t kk = (alpha_r == 0.0 && alpha_i == 0.0) ? 0 : k;
+        if(__builtin_expect(gemm_check_args(transa,transb,m,n,k,lda,ldb,ldc)!=0,0)) {
+           return (-1);
+        }
+        return (gemm_driver_skx_omp(&zgemm_skx_desc,zgemm_skx_blocking(),gemm_op(transa),gemm_op(transb),
+                                    m,n,kk,alpha,A,lda,B,ldb,beta,C,ldc));
+}
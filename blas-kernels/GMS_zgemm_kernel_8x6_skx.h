@@ -0,0 +1,72 @@
+
+
+#ifndef __GMS_ZGEMM_KERNEL_8X6_SKX_H__
+#define __GMS_ZGEMM_KERNEL_8X6_SKX_H__
+
+//
+// AVX512 ZGEMM micro-kernel and driver (SkylakeX and later).
+// Version callable from the Fortran interface (complex(kind=8) arrays are
+// passed as interleaved re,im double pairs, leading dimensions in complex elements).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 17:00 PM +00200
+//
+// Register tile: 8 complex rows (2 ZMM, interleaved re,im) x 6 complex columns.
+// The real and imaginary parts of B are broadcast separately and accumulated
+// into split accumulators (24 ZMM):
+//     Cr += A*Re(b),  Ci += A*Im(b)
+// and recombined once per tile:  C = Cr -+ swap(Ci)   (vfmaddsub).
+// Conjugation ('C') is applied while packing, so the inner loop is 4 FMAs
+// per 2 loads + 2 broadcasts for every column.
+// Shares the packing/blocking driver in GMS_gemm_driver_skx.c.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include "GMS_gemm_driver_skx.h"
+
+
+#define ZGEMM_SKX_MR 8
+#define ZGEMM_SKX_NR 6
+
+
+int32_t zgemm_skx(const char,
+                  const char,
+                  const int32_t,
+                  const int32_t,
+                  const int32_t,
+                  const double,
+                  const double,
+                  const double * __restrict,
+                  const int32_t,
+                  const double * __restrict,
+                  const int32_t,
+                  const double,
+                  const double,
+                  double * __restrict,
+                  const int32_t)         __attribute__((noinline))
+                                         __attribute__((hot))
+                                         __attribute__((aligned(32)));
+
+
+int32_t zgemm_skx_omp(const char,
+                      const char,
+                      const int32_t,
+                      const int32_t,
+                      const int32_t,
+                      const double,
+                      const double,
+                      const double * __restrict,
+                      const int32_t,
+                      const double * __restrict,
+                      const int32_t,
+                      const double,
+                      const double,
+                      double * __restrict,
+                      const int32_t)     __attribute__((noinline))
+                                         __attribute__((hot))
+                                         __attribute__((aligned(32)));
+
+
+
+
+#endif /*__GMS_ZGEMM_KERNEL_8X6_SKX_H__*/
@@ -39,6 +39,11 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Add definition of CONJ and XCONJ
 
 #include <string.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_zgemm_kernel_8x6_skx.h"
 #if !defined(NBMAX)
     #define NBMAX 1024
 #endif
@@ -66,6 +71,8 @@ int32_t zgemv_n(const int32_t m,
        double  * __restrict y_ptr = NULL;
        double  *ap[4];
        int32_t n1;
+       int32_t n2;
+       int32_t i;
        int32_t m1;
        int32_t m2;
        int32_t m3;
@@ -435,7 +442,7 @@ int32_t zgemv_n(const int32_t m,
 		return(0);
 	}
 
-
+       return (0);
 }
 
 
@@ -443,7 +450,8 @@ void  zgemv_n_kernel_4x4(const int32_t n,
 		       double ** __restrict ap,
 		       double  * __restrict x,
 		       double  * __restrict y) {
-      int32_t i = 0;
+      int64_t i = 0;
+      int64_t nc = (int64_t)n;  // asm in/out copy of the const count
      __asm__ __volatile__ (
 
         "vzeroupper			 \n\t"
@@ -527,7 +535,7 @@ void  zgemv_n_kernel_4x4(const int32_t n,
 
 	:
           "+r" (i),	// 0	
-	  "+r" (n)  	// 1
+	  "+r" (nc)  	// 1
 	:
           "r" (x),      // 2
           "r" (y),      // 3
@@ -550,7 +558,8 @@ void  zgemv_n_kernel_4x2(const int32_t n,
 		       double  * __restrict x,
 		       double  * __restrict y) {
 
-       int32_t i = 0;
+       int64_t i = 0;
+      int64_t nc = (int64_t)n;  // asm in/out copy of the const count
       __asm__ __volatile__ (
 
         "vzeroupper			 \n\t"
@@ -613,7 +622,7 @@ void  zgemv_n_kernel_4x2(const int32_t n,
 
 	:
           "+r" (i),	// 0	
-	  "+r" (n)  	// 1
+	  "+r" (nc)  	// 1
 	:
           "r" (x),      // 2
           "r" (y),      // 3
@@ -635,7 +644,8 @@ void  zgemv_n_kernel_4x1(const int32_t n,
 		       double * __restrict x,
 		       double * __restrict y) {
 
-         int32_t i = 0;
+         int64_t i = 0;
+      int64_t nc = (int64_t)n;  // asm in/out copy of the const count
 	__asm__ __volatile__ (
 
              "vzeroupper			 \n\t"
@@ -685,7 +695,7 @@ void  zgemv_n_kernel_4x1(const int32_t n,
 
 	:
           "+r" (i),	// 0	
-	  "+r" (n)  	// 1
+	  "+r" (nc)  	// 1
 	:
           "r" (x),      // 2
           "r" (y),      // 3
@@ -707,7 +717,8 @@ void add_y(const int32_t n,
 	   const double alpha_r,
 	   const double alpha_i) {
 
-     int32_t i;
+     int64_t i;
+     int64_t nc = (int64_t)n;  // asm in/out copy of the const count
      if(inc_dest != 2) {
         
         double temp_r = 0.0;
@@ -780,7 +791,7 @@ void add_y(const int32_t n,
 
 	:
           "+r" (i),	      // 0	
-	  "+r" (n)  	      // 1
+	  "+r" (nc)  	      // 1
 	:
           "r" (src),          // 2
           "r" (dest),         // 3
@@ -795,3 +806,350 @@ void add_y(const int32_t n,
      );
 }
                        
+
+
+/*
+     Multi-RHS path (AVX512).
+     Tile: MV ZMM rows (4*MV complex rows of A) x NR right-hand sides.
+     The real and imaginary parts of x are broadcast separately and
+     accumulated into split accumulators, Cr += A*Re(x), Ci += A*Im(x),
+     recombined once per tile: C = Cr -+ swap(Ci) (vfmaddsub), as in
+     zgemm_kernel_8x6_skx.
+*/
+__attribute__((always_inline))
+static inline
+__m512d zgemv_mrhs_cmul(const __m512d c,
+                        const __m512d vr,
+                        const __m512d vi) {
+       // c*(vr + i*vi) for interleaved re,im pairs.
+       return (_mm512_fmaddsub_pd(c,vr,_mm512_mul_pd(_mm512_permute_pd(c,0x55),vi)));
+}
+
+
+__attribute__((always_inline))
+static inline
+void zgemv_n_mrhs_tile(const int32_t MV,
+                       const int32_t NR,
+                       const int32_t mr,
+                       const int32_t kb,
+                       const double alpha_r,
+                       const double alpha_i,
+                       const double beta_r,
+                       const double beta_i,
+                       const int32_t rdy,
+                       const double * __restrict a,
+                       const int32_t lda2,
+                       const double * __restrict x,
+                       const int32_t ldx2,
+                       double * __restrict y,
+                       const int32_t ldy2) {
+
+       __m512d cr0[ZGEMV_N_MRHS_NR],ci0[ZGEMV_N_MRHS_NR];
+       __m512d cr1[ZGEMV_N_MRHS_NR],ci1[ZGEMV_N_MRHS_NR];
+       const __mmask8 k0 = (mr >= 4) ? (__mmask8)0xFF : (__mmask8)((1U << (2*mr))-1U);
+       const __mmask8 k1 = (mr >= 8) ? (__mmask8)0xFF :
+                           (mr >  4) ? (__mmask8)((1U << (2*(mr-4)))-1U) : (__mmask8)0;
+       const __m512d  one = _mm512_set1_pd(1.0);
+       int32_t j,p;
+       for(j = 0; j != NR; ++j) {
+           cr0[j] = _mm512_setzero_pd();
+           ci0[j] = _mm512_setzero_pd();
+           if(MV > 1) {
+              cr1[j] = _mm512_setzero_pd();
+              ci1[j] = _mm512_setzero_pd();
+           }
+       }
+       for(p = 0; p != kb; ++p) {
+           const double * __restrict ap = &a[(int64_t)p*lda2];
+           const __m512d a0 = _mm512_maskz_loadu_pd(k0,ap);
+           __m512d a1;
+           if(MV > 1) a1 = _mm512_maskz_loadu_pd(k1,ap+8);
+           for(j = 0; j != NR; ++j) {
+               const __m512d xr = _mm512_set1_pd(x[2*p+(int64_t)j*ldx2]);
+               const __m512d xi = _mm512_set1_pd(x[2*p+1+(int64_t)j*ldx2]);
+               cr0[j] = _mm512_fmadd_pd(a0,xr,cr0[j]);
+               ci0[j] = _mm512_fmadd_pd(a0,xi,ci0[j]);
+               if(MV > 1) {
+                  cr1[j] = _mm512_fmadd_pd(a1,xr,cr1[j]);
+                  ci1[j] = _mm512_fmadd_pd(a1,xi,ci1[j]);
+               }
+           }
+       }
+       {
+           const __m512d var = _mm512_set1_pd(alpha_r);
+           const __m512d vai = _mm512_set1_pd(alpha_i);
+           const __m512d vbr = _mm512_set1_pd(beta_r);
+           const __m512d vbi = _mm512_set1_pd(beta_i);
+           for(j = 0; j != NR; ++j) {
+               double * __restrict yj = &y[(int64_t)j*ldy2];
+               __m512d c0 = _mm512_fmaddsub_pd(cr0[j],one,_mm512_permute_pd(ci0[j],0x55));
+               c0 = zgemv_mrhs_cmul(c0,var,vai);
+               if(rdy) c0 = _mm512_add_pd(c0,zgemv_mrhs_cmul(_mm512_maskz_loadu_pd(k0,yj),vbr,vbi));
+               _mm512_mask_storeu_pd(yj,k0,c0);
+               if(MV > 1) {
+                  __m512d c1 = _mm512_fmaddsub_pd(cr1[j],one,_mm512_permute_pd(ci1[j],0x55));
+                  c1 = zgemv_mrhs_cmul(c1,var,vai);
+                  if(rdy) c1 = _mm512_add_pd(c1,zgemv_mrhs_cmul(_mm512_maskz_loadu_pd(k1,yj+8),vbr,vbi));
+                  _mm512_mask_storeu_pd(yj+8,k1,c1);
+               }
+           }
+       }
+}
+
+
+// Bytes of one packed MB x KB block of A (8-row panels, zero-padded).
+#define ZGEMV_MRHS_PACK_SZ ((size_t)(((ZGEMV_MRHS_MB+7)/8)*8)*(size_t)ZGEMV_MRHS_KB*2*sizeof(double))
+
+
+typedef void (*zgemv_n_mrhs_tile_fn)(const int32_t,
+                                     const int32_t,
+                                     const double,
+                                     const double,
+                                     const double,
+                                     const double,
+                                     const int32_t,
+                                     const double * __restrict,
+                                     const int32_t,
+                                     const double * __restrict,
+                                     const int32_t,
+                                     double * __restrict,
+                                     const int32_t);
+
+
+#define ZGEMV_N_MRHS_TILE(MV,NR)                                                  \
+static                                                                            \
+void zgemv_n_mrhs_tile_##MV##x##NR(const int32_t mr,                               \
+                                   const int32_t kb,                               \
+                                   const double alpha_r,                           \
+                                   const double alpha_i,                           \
+                                   const double beta_r,                            \
+                                   const double beta_i,                            \
+                                   const int32_t rdy,                              \
+                                   const double * __restrict a,                    \
+                                   const int32_t lda2,                             \
+                                   const double * __restrict x,                    \
+                                   const int32_t ldx2,                             \
+                                   double * __restrict y,                          \
+                                   const int32_t ldy2) {                           \
+       zgemv_n_mrhs_tile(MV,NR,mr,kb,alpha_r,alpha_i,beta_r,beta_i,rdy,           \
+                         a,lda2,x,ldx2,y,ldy2);                                   \
+}
+
+ZGEMV_N_MRHS_TILE(1,1)
+ZGEMV_N_MRHS_TILE(1,2)
+ZGEMV_N_MRHS_TILE(1,3)
+ZGEMV_N_MRHS_TILE(1,4)
+ZGEMV_N_MRHS_TILE(1,5)
+ZGEMV_N_MRHS_TILE(1,6)
+ZGEMV_N_MRHS_TILE(2,1)
+ZGEMV_N_MRHS_TILE(2,2)
+ZGEMV_N_MRHS_TILE(2,3)
+ZGEMV_N_MRHS_TILE(2,4)
+ZGEMV_N_MRHS_TILE(2,5)
+ZGEMV_N_MRHS_TILE(2,6)
+
+static const zgemv_n_mrhs_tile_fn zgemv_n_mrhs_tiles[2][ZGEMV_N_MRHS_NR] = {
+       {zgemv_n_mrhs_tile_1x1,zgemv_n_mrhs_tile_1x2,zgemv_n_mrhs_tile_1x3,
+        zgemv_n_mrhs_tile_1x4,zgemv_n_mrhs_tile_1x5,zgemv_n_mrhs_tile_1x6},
+       {zgemv_n_mrhs_tile_2x1,zgemv_n_mrhs_tile_2x2,zgemv_n_mrhs_tile_2x3,
+        zgemv_n_mrhs_tile_2x4,zgemv_n_mrhs_tile_2x5,zgemv_n_mrhs_tile_2x6}};
+
+
+/*
+     Copies the 8-row panels of A(ib:ie,p0:p0+kb) into Ap, k-major,
+     zero-padded to 8 rows (one 16-double line pair per column).
+*/
+static
+void zgemv_n_mrhs_pack(const int32_t ib,
+                       const int32_t ie,
+                       const int32_t p0,
+                       const int32_t kb,
+                       const double * __restrict A,
+                       const int32_t lda,
+                       double * __restrict Ap) {
+
+       int32_t i,mr,p;
+       for(i = ib; i < ie; i += 8) {
+           const double * __restrict a = &A[2*((int64_t)i+(int64_t)p0*lda)];
+           mr = (ie-i < 8) ? ie-i : 8;
+           const __mmask8 k0 = (mr >= 4) ? (__mmask8)0xFF : (__mmask8)((1U << (2*mr))-1U);
+           const __mmask8 k1 = (mr >= 8) ? (__mmask8)0xFF :
+                               (mr >  4) ? (__mmask8)((1U << (2*(mr-4)))-1U) : (__mmask8)0;
+           for(p = 0; p != kb; ++p) {
+               _mm512_store_pd(&Ap[16*p],  _mm512_maskz_loadu_pd(k0,&a[2*(int64_t)p*lda]));
+               _mm512_store_pd(&Ap[16*p+8],_mm512_maskz_loadu_pd(k1,&a[2*(int64_t)p*lda+8]));
+           }
+           Ap += 16*kb;
+       }
+}
+
+
+/*
+     Rows i0:i0+mlen of Y. Blocked over the columns of A in ZGEMV_MRHS_KB
+     chunks and over the rows in ZGEMV_MRHS_MB chunks. When more than one
+     group of right-hand sides reuses an MB x KB block of A, the block is first
+     copied into contiguous 8-row panels (Ap, 16*MB*KB doubles) so that the
+     reuse runs from L2 at unit stride; a single group reads A in place.
+     beta is applied by the first KB chunk only.
+*/
+static
+void zgemv_n_mrhs_rows(const int32_t i0,
+                       const int32_t mlen,
+                       const int32_t n,
+                       const int32_t nrhs,
+                       const double alpha_r,
+                       const double alpha_i,
+                       const double * __restrict A,
+                       const int32_t lda,
+                       const double * __restrict X,
+                       const int32_t ldx,
+                       const double beta_r,
+                       const double beta_i,
+                       double * __restrict Y,
+                       const int32_t ldy,
+                       double * __restrict Ap) {
+
+       const int32_t bnz = (beta_r != 0.0 || beta_i != 0.0);
+       int32_t p0,kb,ib,i,mr,j,nr,rdy;
+       double br,bi;
+       if(n == 0) {
+          for(j = 0; j != nrhs; ++j) {
+              double * __restrict y = &Y[2*((int64_t)i0+(int64_t)j*ldy)];
+              for(i = 0; i != mlen; ++i) {
+                  const double yr = y[2*i];
+                  const double yi = y[2*i+1];
+                  y[2*i]   = bnz ? beta_r*yr-beta_i*yi : 0.0;
+                  y[2*i+1] = bnz ? beta_r*yi+beta_i*yr : 0.0;
+              }
+          }
+          return;
+       }
+       for(p0 = 0; p0 < n; p0 += ZGEMV_MRHS_KB) {
+           kb  = (n-p0 < ZGEMV_MRHS_KB) ? n-p0 : ZGEMV_MRHS_KB;
+           rdy = (p0 > 0) || bnz;
+           br  = (p0 > 0) ? 1.0 : beta_r;
+           bi  = (p0 > 0) ? 0.0 : beta_i;
+           for(ib = i0; ib < i0+mlen; ib += ZGEMV_MRHS_MB) {
+               const int32_t ie = (i0+mlen-ib < ZGEMV_MRHS_MB) ? i0+mlen : ib+ZGEMV_MRHS_MB;
+               if(NULL != Ap) zgemv_n_mrhs_pack(ib,ie,p0,kb,A,lda,Ap);
+               for(j = 0; j < nrhs; j += ZGEMV_N_MRHS_NR) {
+                   nr = (nrhs-j < ZGEMV_N_MRHS_NR) ? nrhs-j : ZGEMV_N_MRHS_NR;
+                   for(i = ib; i < ie; i += 8) {
+                       const double * __restrict a = (NULL != Ap) ?
+                                                     &Ap[16*(int64_t)kb*((i-ib)/8)] :
+                                                     &A[2*((int64_t)i+(int64_t)p0*lda)];
+                       const int32_t  lda2 = (NULL != Ap) ? 16 : 2*lda;
+                       mr = (ie-i < 8) ? ie-i : 8;
+                       zgemv_n_mrhs_tiles[(mr > 4)][nr-1](mr,kb,alpha_r,alpha_i,br,bi,rdy,
+                                                a,lda2,
+                                                &X[2*((int64_t)p0+(int64_t)j*ldx)],2*ldx,
+                                                &Y[2*((int64_t)i+(int64_t)j*ldy)],2*ldy);
+                   }
+               }
+           }
+       }
+}
+
+
+static inline
+int32_t zgemv_n_mrhs_check(const int32_t m,
+                           const int32_t n,
+                           const int32_t nrhs,
+                           const int32_t lda,
+                           const int32_t ldx,
+                           const int32_t ldy) {
+
+       if(m < 0 || n < 0 || nrhs < 0) return (-1);
+       if(lda < ((m > 1) ? m : 1)) return (-1);
+       if(ldx < ((n > 1) ? n : 1)) return (-1);
+       if(ldy < ((m > 1) ? m : 1)) return (-1);
+       return (0);
+}
+
+
+int32_t zgemv_n_mrhs(const int32_t m,
+                     const int32_t n,
+                     const int32_t nrhs,
+                     const double alpha_r,
+                     const double alpha_i,
+                     const double * __restrict A,
+                     const int32_t lda,
+                     const double * __restrict X,
+                     const int32_t ldx,
+                     const double beta_r,
+                     const double beta_i,
+                     double * __restrict Y,
+                     const int32_t ldy) {
+
+       double * __restrict Ap = NULL;
+       if(__builtin_expect(zgemv_n_mrhs_check(m,n,nrhs,lda,ldx,ldy)!=0,0)) {
+          return (-1);
+       }
+       if(m == 0 || nrhs == 0) return (0);
+       if(nrhs > ZGEMV_MRHS_MAX) {
+          return (zgemm_skx('N','N',m,nrhs,n,alpha_r,alpha_i,A,lda,X,ldx,
+                            beta_r,beta_i,Y,ldy));
+       }
+       if(nrhs > ZGEMV_N_MRHS_NR) {
+          Ap = (double*)_mm_malloc(ZGEMV_MRHS_PACK_SZ,64);
+          if(__builtin_expect(NULL==Ap,0)) return (-2);
+       }
+       zgemv_n_mrhs_rows(0,m,n,nrhs,alpha_r,alpha_i,A,lda,X,ldx,beta_r,beta_i,Y,ldy,Ap);
+       if(NULL != Ap) _mm_free(Ap);
+       return (0);
+}
+
+
+int32_t zgemv_n_mrhs_omp(const int32_t m,
+                         const int32_t n,
+                         const int32_t nrhs,
+                         const double alpha_r,
+                         const double alpha_i,
+                         const double * __restrict A,
+                         const int32_t lda,
+                         const double * __restrict X,
+                         const int32_t ldx,
+                         const double beta_r,
+                         const double beta_i,
+                         double * __restrict Y,
+                         const int32_t ldy) {
+
+#if defined(_OPENMP)
+       double * __restrict Ap = NULL;
+       int32_t nth;
+       if(__builtin_expect(zgemv_n_mrhs_check(m,n,nrhs,lda,ldx,ldy)!=0,0)) {
+          return (-1);
+       }
+       if(m == 0 || nrhs == 0) return (0);
+       if(nrhs > ZGEMV_MRHS_MAX) {
+          return (zgemm_skx_omp('N','N',m,nrhs,n,alpha_r,alpha_i,A,lda,X,ldx,
+                                beta_r,beta_i,Y,ldy));
+       }
+       nth = omp_get_max_threads();
+       if(nth > (m+7)/8) nth = (m+7)/8;
+       if(nth <= 1 || 4.0*(double)m*(double)n*(double)nrhs < (double)GEMM_SKX_OMP_MIN_FLOP) {
+          return (zgemv_n_mrhs(m,n,nrhs,alpha_r,alpha_i,A,lda,X,ldx,beta_r,beta_i,Y,ldy));
+       }
+       if(nrhs > ZGEMV_N_MRHS_NR) {
+          Ap = (double*)_mm_malloc((size_t)nth*ZGEMV_MRHS_PACK_SZ,64);
+          if(__builtin_expect(NULL==Ap,0)) return (-2);
+       }
+#pragma omp parallel num_threads(nth) default(none) \
+        shared(A,X,Y,Ap) \
+        firstprivate(m,n,nrhs,alpha_r,alpha_i,lda,ldx,beta_r,beta_i,ldy)
+       {
+             const int32_t tid = omp_get_thread_num();
+             double * __restrict Apt = (NULL != Ap) ? &Ap[(int64_t)tid*(ZGEMV_MRHS_PACK_SZ/sizeof(double))] : NULL;
+             int32_t i0,mlen;
+             gemm_partition(m,omp_get_num_threads(),tid,8,&i0,&mlen);
+             if(mlen > 0) {
+                zgemv_n_mrhs_rows(i0,mlen,n,nrhs,alpha_r,alpha_i,A,lda,X,ldx,
+                                  beta_r,beta_i,Y,ldy,Apt);
+             }
+       }
+       if(NULL != Ap) _mm_free(Ap);
+       return (0);
+#else
+       return (zgemv_n_mrhs(m,n,nrhs,alpha_r,alpha_i,A,lda,X,ldx,beta_r,beta_i,Y,ldy));
+#endif
+}
@@ -76,7 +76,55 @@ void add_y(const int32_t,
 	   const double);
 
 
+// Multi-RHS variant (skinny ZGEMM):
+//     Y(m,nrhs) := alpha*A(m,n)*X(n,nrhs) + beta*Y(m,nrhs)
+// Complex arrays interleaved re,im; leading dimensions in complex elements.
+// An 8-row strip of A (2 ZMM per column) is loaded once per column and
+// multiplied with up to ZGEMV_N_MRHS_NR right-hand sides held as broadcasts;
+// A is streamed from memory once for all vectors instead of once per vector
+// (MB x KB blocks, copied to contiguous panels when several RHS groups reuse them).
+// Beyond ZGEMV_MRHS_MAX vectors zgemm_skx (packed A and B) is faster and is used instead.
+// The _omp version splits the rows over the threads.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
 
+#if !defined(ZGEMV_MRHS_MAX)
+    #define ZGEMV_MRHS_MAX 16
+#endif
+#if !defined(ZGEMV_MRHS_KB)
+    #define ZGEMV_MRHS_KB 256
+#endif
+#if !defined(ZGEMV_MRHS_MB)
+    #define ZGEMV_MRHS_MB 32
+#endif
+#define ZGEMV_N_MRHS_NR 6
+
+int32_t zgemv_n_mrhs(const int32_t,
+                     const int32_t,
+                     const int32_t,
+                     const double,
+                     const double,
+                     const double * __restrict,
+                     const int32_t,
+                     const double * __restrict,
+                     const int32_t,
+                     const double,
+                     const double,
+                     double * __restrict,
+                     const int32_t) __attribute__((aligned(32))) __attribute__((hot)) __attribute__((noinline));
+
+int32_t zgemv_n_mrhs_omp(const int32_t,
+                         const int32_t,
+                         const int32_t,
+                         const double,
+                         const double,
+                         const double * __restrict,
+                         const int32_t,
+                         const double * __restrict,
+                         const int32_t,
+                         const double,
+                         const double,
+                         double * __restrict,
+                         const int32_t) __attribute__((aligned(32))) __attribute__((hot)) __attribute__((noinline));
 
 
 
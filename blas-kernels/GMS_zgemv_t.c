@@ -36,7 +36,12 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *****************************************************************************/
 
 #include <string.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 #include "GMS_zgemv_t.h"
+#include "GMS_zgemm_kernel_8x6_skx.h"
 
 #if !defined(NBMAX)
     #define NBMAX 1024
@@ -103,8 +108,106 @@ int32_t zgemv_t(const int32_t m,
 	   ap[1] = a_ptr + lda;
 	   ap[2] = ap[1] + lda;
 	   ap[3] = ap[2] + lda;
-	   
+	   if(inc_x != 2) {
+	      xbuffer = buffer;
+	      for(i = 0; i < NB; ++i) {
+                  xbuffer[2*i]   = x_ptr[0];
+		  xbuffer[2*i+1] = x_ptr[1];
+		  x_ptr += inc_x;
+	      }
+	   }
+	   else {
+	      xbuffer = x_ptr;
+	   }
+
+	   if(inc_y == 2) {
+
+	         for(i = 0; i < n1; ++i) {
+                     zgemv_t_kernel_4x4(NB,ap,xbuffer,y_ptr,alpha);
+		     ap[0] += lda4;
+		     ap[1] += lda4;
+		     ap[2] += lda4;
+		     ap[3] += lda4;
+		     a_ptr += lda4;
+		     y_ptr += 8;
+		 }
+
+		 if(n2 & 2) {
+
+		    zgemv_t_kernel_4x2(NB,ap,xbuffer,y_ptr,alpha);
+		    a_ptr += lda * 2;
+		    y_ptr += 4;
+		 }
+
+		 if(n2 & 1) {
+
+		    ap[0] = a_ptr;
+		    zgemv_t_kernel_4x1(NB,ap,xbuffer,y_ptr,alpha);
+		 }
+	   }
+	   else {
+
+	         for(i = 0; i < n1; ++i) {
+                     memset(ybuffer,0,sizeof(ybuffer));
+		     zgemv_t_kernel_4x4(NB,ap,xbuffer,ybuffer,alpha);
+		     ap[0] += lda4;
+		     ap[1] += lda4;
+		     ap[2] += lda4;
+		     ap[3] += lda4;
+		     a_ptr += lda4;
+		     for(j = 0; j < 4; ++j) {
+                         y_ptr[0] += ybuffer[2*j];
+			 y_ptr[1] += ybuffer[2*j+1];
+			 y_ptr += inc_y;
+		     }
+		 }
+
+		 for(i = 0; i < n2; ++i) {
+                     memset(ybuffer,0,sizeof(ybuffer));
+		     ap[0] = a_ptr;
+		     zgemv_t_kernel_4x1(NB,ap,xbuffer,ybuffer,alpha);
+		     a_ptr += lda;
+		     y_ptr[0] += ybuffer[0];
+		     y_ptr[1] += ybuffer[1];
+		     y_ptr += inc_y;
+		 }
+	   }
+	   a += 2 * NB;
+	   x += NB * inc_x;
+      }
+
+      if(m3 == 0) {
+         return (0);
       }
+
+      // Last m%4 rows: one short dot product per column.
+      a_ptr = a;
+      y_ptr = y;
+      for(j = 0; j < n; ++j) {
+          double temp_r = 0.0;
+	  double temp_i = 0.0;
+	  x_ptr = x;
+	  for(i = 0; i < m3; ++i) {
+#if ( !defined(CONJ) && !defined(XCONJ) ) || ( defined(CONJ) && defined(XCONJ) )
+	      temp_r += a_ptr[2*i] * x_ptr[0] - a_ptr[2*i+1] * x_ptr[1];
+	      temp_i += a_ptr[2*i] * x_ptr[1] + a_ptr[2*i+1] * x_ptr[0];
+#else
+	      temp_r += a_ptr[2*i] * x_ptr[0] + a_ptr[2*i+1] * x_ptr[1];
+	      temp_i += a_ptr[2*i] * x_ptr[1] - a_ptr[2*i+1] * x_ptr[0];
+#endif
+	      x_ptr += inc_x;
+	  }
+#if !defined(XCONJ)
+	  y_ptr[0] += alpha_r * temp_r - alpha_i * temp_i;
+	  y_ptr[1] += alpha_r * temp_i + alpha_i * temp_r;
+#else
+	  y_ptr[0] += alpha_r * temp_r + alpha_i * temp_i;
+	  y_ptr[1] -= alpha_r * temp_i - alpha_i * temp_r;
+#endif
+	  a_ptr += lda;
+	  y_ptr += inc_y;
+      }
+      return (0);
 }
 
 
@@ -114,7 +217,8 @@ void zgemv_t_kernel_4x4(const int32_t n,
 			double  * __restrict y,
 			double  * __restrict alpha) {
 
-    int32_t register i = 0;
+    int64_t i = 0;
+    int64_t nc = (int64_t)n;  // asm in/out copy of the const count
     __asm__ __volatile__ (
 
         "vzeroupper			 \n\t"
@@ -264,7 +368,7 @@ void zgemv_t_kernel_4x4(const int32_t n,
 
 	:
           "+r" (i),	// 0	
-	  "+r" (n)  	// 1
+	  "+r" (nc)  	// 1
 	:
           "r" (x),      // 2
           "r" (y),      // 3
@@ -281,3 +385,357 @@ void zgemv_t_kernel_4x4(const int32_t n,
 	  "memory"
        );
 }
+
+
+// Remainder columns of zgemv_t: C versions of the 2- and 1-column kernels
+// (n a multiple of 4, as for zgemv_t_kernel_4x4).
+void zgemv_t_kernel_4x2(const int32_t n,
+                        double ** __restrict ap,
+			double  * __restrict x,
+			double  * __restrict y,
+			double  * __restrict alpha) {
+
+     const double * __restrict a0 = ap[0];
+     const double * __restrict a1 = ap[1];
+     double temp_r0 = 0.0;
+     double temp_i0 = 0.0;
+     double temp_r1 = 0.0;
+     double temp_i1 = 0.0;
+     int32_t i;
+     for(i = 0; i < 2*n; i += 2) {
+#if ( !defined(CONJ) && !defined(XCONJ) ) || ( defined(CONJ) && defined(XCONJ) )
+         temp_r0 += a0[i] * x[i]   - a0[i+1] * x[i+1];
+	 temp_i0 += a0[i] * x[i+1] + a0[i+1] * x[i];
+	 temp_r1 += a1[i] * x[i]   - a1[i+1] * x[i+1];
+	 temp_i1 += a1[i] * x[i+1] + a1[i+1] * x[i];
+#else
+         temp_r0 += a0[i] * x[i]   + a0[i+1] * x[i+1];
+	 temp_i0 += a0[i] * x[i+1] - a0[i+1] * x[i];
+	 temp_r1 += a1[i] * x[i]   + a1[i+1] * x[i+1];
+	 temp_i1 += a1[i] * x[i+1] - a1[i+1] * x[i];
+#endif
+     }
+#if !defined(XCONJ)
+     y[0] += alpha[0] * temp_r0 - alpha[1] * temp_i0;
+     y[1] += alpha[0] * temp_i0 + alpha[1] * temp_r0;
+     y[2] += alpha[0] * temp_r1 - alpha[1] * temp_i1;
+     y[3] += alpha[0] * temp_i1 + alpha[1] * temp_r1;
+#else
+     y[0] += alpha[0] * temp_r0 + alpha[1] * temp_i0;
+     y[1] -= alpha[0] * temp_i0 - alpha[1] * temp_r0;
+     y[2] += alpha[0] * temp_r1 + alpha[1] * temp_i1;
+     y[3] -= alpha[0] * temp_i1 - alpha[1] * temp_r1;
+#endif
+}
+
+
+void zgemv_t_kernel_4x1(const int32_t n,
+                        double ** __restrict ap,
+			double  * __restrict x,
+			double  * __restrict y,
+			double  * __restrict alpha) {
+
+     const double * __restrict a0 = ap[0];
+     double temp_r = 0.0;
+     double temp_i = 0.0;
+     int32_t i;
+     for(i = 0; i < 2*n; i += 2) {
+#if ( !defined(CONJ) && !defined(XCONJ) ) || ( defined(CONJ) && defined(XCONJ) )
+         temp_r += a0[i] * x[i]   - a0[i+1] * x[i+1];
+	 temp_i += a0[i] * x[i+1] + a0[i+1] * x[i];
+#else
+         temp_r += a0[i] * x[i]   + a0[i+1] * x[i+1];
+	 temp_i += a0[i] * x[i+1] - a0[i+1] * x[i];
+#endif
+     }
+#if !defined(XCONJ)
+     y[0] += alpha[0] * temp_r - alpha[1] * temp_i;
+     y[1] += alpha[0] * temp_i + alpha[1] * temp_r;
+#else
+     y[0] += alpha[0] * temp_r + alpha[1] * temp_i;
+     y[1] -= alpha[0] * temp_i - alpha[1] * temp_r;
+#endif
+}
+
+
+/*
+     Multi-RHS path (AVX512).
+     Tile: NC columns of A x NR right-hand sides, 4 complex rows per step.
+     For every (column,rhs) pair two partial-product vectors are kept:
+         P += a*x        = [ar*xr, ai*xi]
+         Q += a*swap(x)  = [ar*xi, ai*xr]
+     and reduced once per output:
+         'T':  re = sum(P_even) - sum(P_odd),  im = sum(Q_even) + sum(Q_odd)
+         'C':  re = sum(P_even) + sum(P_odd),  im = sum(Q_even) - sum(Q_odd)
+*/
+__attribute__((always_inline))
+static inline
+void zgemv_t_mrhs_tile(const int32_t NC,
+                       const int32_t NR,
+                       const int32_t conj,
+                       const int32_t kb,
+                       const double alpha_r,
+                       const double alpha_i,
+                       const double beta_r,
+                       const double beta_i,
+                       const int32_t rdy,
+                       const double * __restrict a,
+                       const int32_t lda2,
+                       const double * __restrict x,
+                       const int32_t ldx2,
+                       double * __restrict y,
+                       const int32_t ldy2) {
+
+       __m512d P[ZGEMV_T_MRHS_NC][ZGEMV_T_MRHS_NR];
+       __m512d Q[ZGEMV_T_MRHS_NC][ZGEMV_T_MRHS_NR];
+       __m512d av[ZGEMV_T_MRHS_NC];
+       const __m512d pm = _mm512_set_pd(-1.0,1.0,-1.0,1.0,-1.0,1.0,-1.0,1.0);
+       const __m512d pp = _mm512_set1_pd(1.0);
+       const __m512d sp = conj ? pp : pm;
+       const __m512d sq = conj ? pm : pp;
+       int32_t c,r,i;
+       for(c = 0; c != NC; ++c) {
+           for(r = 0; r != NR; ++r) {
+               P[c][r] = _mm512_setzero_pd();
+               Q[c][r] = _mm512_setzero_pd();
+           }
+       }
+       for(i = 0; i < kb; i += 4) {
+           const int32_t  rem = kb-i;
+           const __mmask8 k   = (rem >= 4) ? (__mmask8)0xFF : (__mmask8)((1U << (2*rem))-1U);
+           for(c = 0; c != NC; ++c) {
+               av[c] = _mm512_maskz_loadu_pd(k,&a[2*i+(int64_t)c*lda2]);
+           }
+           for(r = 0; r != NR; ++r) {
+               const __m512d xv = _mm512_maskz_loadu_pd(k,&x[2*i+(int64_t)r*ldx2]);
+               const __m512d xs = _mm512_permute_pd(xv,0x55);
+               for(c = 0; c != NC; ++c) {
+                   P[c][r] = _mm512_fmadd_pd(av[c],xv,P[c][r]);
+                   Q[c][r] = _mm512_fmadd_pd(av[c],xs,Q[c][r]);
+               }
+           }
+       }
+       for(r = 0; r != NR; ++r) {
+           for(c = 0; c != NC; ++c) {
+               const double tr = _mm512_reduce_add_pd(_mm512_mul_pd(P[c][r],sp));
+               const double ti = _mm512_reduce_add_pd(_mm512_mul_pd(Q[c][r],sq));
+               double * __restrict yc = &y[2*c+(int64_t)r*ldy2];
+               double yr = alpha_r*tr-alpha_i*ti;
+               double yi = alpha_r*ti+alpha_i*tr;
+               if(rdy) {
+                  yr += beta_r*yc[0]-beta_i*yc[1];
+                  yi += beta_r*yc[1]+beta_i*yc[0];
+               }
+               yc[0] = yr;
+               yc[1] = yi;
+           }
+       }
+}
+
+
+typedef void (*zgemv_t_mrhs_tile_fn)(const int32_t,
+                                     const int32_t,
+                                     const double,
+                                     const double,
+                                     const double,
+                                     const double,
+                                     const int32_t,
+                                     const double * __restrict,
+                                     const int32_t,
+                                     const double * __restrict,
+                                     const int32_t,
+                                     double * __restrict,
+                                     const int32_t);
+
+
+#define ZGEMV_T_MRHS_TILE(NC,NR)                                                  \
+static                                                                            \
+void zgemv_t_mrhs_tile_##NC##x##NR(const int32_t conj,                             \
+                                   const int32_t kb,                               \
+                                   const double alpha_r,                           \
+                                   const double alpha_i,                           \
+                                   const double beta_r,                            \
+                                   const double beta_i,                            \
+                                   const int32_t rdy,                              \
+                                   const double * __restrict a,                    \
+                                   const int32_t lda2,                             \
+                                   const double * __restrict x,                    \
+                                   const int32_t ldx2,                             \
+                                   double * __restrict y,                          \
+                                   const int32_t ldy2) {                           \
+       zgemv_t_mrhs_tile(NC,NR,conj,kb,alpha_r,alpha_i,beta_r,beta_i,rdy,         \
+                         a,lda2,x,ldx2,y,ldy2);                                   \
+}
+
+ZGEMV_T_MRHS_TILE(1,1)
+ZGEMV_T_MRHS_TILE(1,2)
+ZGEMV_T_MRHS_TILE(1,3)
+ZGEMV_T_MRHS_TILE(1,4)
+ZGEMV_T_MRHS_TILE(2,1)
+ZGEMV_T_MRHS_TILE(2,2)
+ZGEMV_T_MRHS_TILE(2,3)
+ZGEMV_T_MRHS_TILE(2,4)
+ZGEMV_T_MRHS_TILE(3,1)
+ZGEMV_T_MRHS_TILE(3,2)
+ZGEMV_T_MRHS_TILE(3,3)
+ZGEMV_T_MRHS_TILE(3,4)
+
+static const zgemv_t_mrhs_tile_fn zgemv_t_mrhs_tiles[ZGEMV_T_MRHS_NC][ZGEMV_T_MRHS_NR] = {
+       {zgemv_t_mrhs_tile_1x1,zgemv_t_mrhs_tile_1x2,zgemv_t_mrhs_tile_1x3,zgemv_t_mrhs_tile_1x4},
+       {zgemv_t_mrhs_tile_2x1,zgemv_t_mrhs_tile_2x2,zgemv_t_mrhs_tile_2x3,zgemv_t_mrhs_tile_2x4},
+       {zgemv_t_mrhs_tile_3x1,zgemv_t_mrhs_tile_3x2,zgemv_t_mrhs_tile_3x3,zgemv_t_mrhs_tile_3x4}};
+
+
+/*
+     Rows j0:j0+nlen of Y (columns of A). Blocked over the rows of A in
+     ZGEMV_MRHS_KB chunks: the KB x 3 segment of A stays in L1 while it is
+     multiplied with every right-hand side; beta is applied by the first
+     chunk only.
+*/
+static
+void zgemv_t_mrhs_cols(const int32_t conj,
+                       const int32_t j0,
+                       const int32_t nlen,
+                       const int32_t m,
+                       const int32_t nrhs,
+                       const double alpha_r,
+                       const double alpha_i,
+                       const double * __restrict A,
+                       const int32_t lda,
+                       const double * __restrict X,
+                       const int32_t ldx,
+                       const double beta_r,
+                       const double beta_i,
+                       double * __restrict Y,
+                       const int32_t ldy) {
+
+       const int32_t bnz = (beta_r != 0.0 || beta_i != 0.0);
+       int32_t i0,kb,j,nc,r,nr,rdy;
+       double br,bi;
+       if(m == 0) {
+          for(r = 0; r != nrhs; ++r) {
+              double * __restrict y = &Y[2*((int64_t)j0+(int64_t)r*ldy)];
+              for(j = 0; j != nlen; ++j) {
+                  const double yr = y[2*j];
+                  const double yi = y[2*j+1];
+                  y[2*j]   = bnz ? beta_r*yr-beta_i*yi : 0.0;
+                  y[2*j+1] = bnz ? beta_r*yi+beta_i*yr : 0.0;
+              }
+          }
+          return;
+       }
+       for(i0 = 0; i0 < m; i0 += ZGEMV_MRHS_KB) {
+           kb  = (m-i0 < ZGEMV_MRHS_KB) ? m-i0 : ZGEMV_MRHS_KB;
+           rdy = (i0 > 0) || bnz;
+           br  = (i0 > 0) ? 1.0 : beta_r;
+           bi  = (i0 > 0) ? 0.0 : beta_i;
+           for(j = j0; j < j0+nlen; j += ZGEMV_T_MRHS_NC) {
+               nc = (j0+nlen-j < ZGEMV_T_MRHS_NC) ? j0+nlen-j : ZGEMV_T_MRHS_NC;
+               for(r = 0; r < nrhs; r += ZGEMV_T_MRHS_NR) {
+                   nr = (nrhs-r < ZGEMV_T_MRHS_NR) ? nrhs-r : ZGEMV_T_MRHS_NR;
+                   zgemv_t_mrhs_tiles[nc-1][nr-1](conj,kb,alpha_r,alpha_i,br,bi,rdy,
+                                                &A[2*((int64_t)i0+(int64_t)j*lda)],2*lda,
+                                                &X[2*((int64_t)i0+(int64_t)r*ldx)],2*ldx,
+                                                &Y[2*((int64_t)j+(int64_t)r*ldy)],2*ldy);
+               }
+           }
+       }
+}
+
+
+static inline
+int32_t zgemv_t_mrhs_check(const char trans,
+                           const int32_t m,
+                           const int32_t n,
+                           const int32_t nrhs,
+                           const int32_t lda,
+                           const int32_t ldx,
+                           const int32_t ldy) {
+
+       const int32_t op = gemm_op(trans);
+       if(op != GEMM_OP_T && op != GEMM_OP_C) return (-1);
+       if(m < 0 || n < 0 || nrhs < 0) return (-1);
+       if(lda < ((m > 1) ? m : 1)) return (-1);
+       if(ldx < ((m > 1) ? m : 1)) return (-1);
+       if(ldy < ((n > 1) ? n : 1)) return (-1);
+       return (0);
+}
+
+
+int32_t zgemv_t_mrhs(const char trans,
+                     const int32_t m,
+                     const int32_t n,
+                     const int32_t nrhs,
+                     const double alpha_r,
+                     const double alpha_i,
+                     const double * __restrict A,
+                     const int32_t lda,
+                     const double * __restrict X,
+                     const int32_t ldx,
+                     const double beta_r,
+                     const double beta_i,
+                     double * __restrict Y,
+                     const int32_t ldy) {
+
+       if(__builtin_expect(zgemv_t_mrhs_check(trans,m,n,nrhs,lda,ldx,ldy)!=0,0)) {
+          return (-1);
+       }
+       if(n == 0 || nrhs == 0) return (0);
+       if(nrhs > ZGEMV_MRHS_MAX) {
+          return (zgemm_skx(trans,'N',n,nrhs,m,alpha_r,alpha_i,A,lda,X,ldx,
+                            beta_r,beta_i,Y,ldy));
+       }
+       zgemv_t_mrhs_cols(gemm_op(trans)==GEMM_OP_C,0,n,m,nrhs,alpha_r,alpha_i,
+                         A,lda,X,ldx,beta_r,beta_i,Y,ldy);
+       return (0);
+}
+
+
+int32_t zgemv_t_mrhs_omp(const char trans,
+                         const int32_t m,
+                         const int32_t n,
+                         const int32_t nrhs,
+                         const double alpha_r,
+                         const double alpha_i,
+                         const double * __restrict A,
+                         const int32_t lda,
+                         const double * __restrict X,
+                         const int32_t ldx,
+                         const double beta_r,
+                         const double beta_i,
+                         double * __restrict Y,
+                         const int32_t ldy) {
+
+#if defined(_OPENMP)
+       int32_t nth,conj;
+       if(__builtin_expect(zgemv_t_mrhs_check(trans,m,n,nrhs,lda,ldx,ldy)!=0,0)) {
+          return (-1);
+       }
+       if(n == 0 || nrhs == 0) return (0);
+       if(nrhs > ZGEMV_MRHS_MAX) {
+          return (zgemm_skx_omp(trans,'N',n,nrhs,m,alpha_r,alpha_i,A,lda,X,ldx,
+                                beta_r,beta_i,Y,ldy));
+       }
+       conj = (gemm_op(trans) == GEMM_OP_C);
+       nth  = omp_get_max_threads();
+       if(nth > (n+ZGEMV_T_MRHS_NC-1)/ZGEMV_T_MRHS_NC) nth = (n+ZGEMV_T_MRHS_NC-1)/ZGEMV_T_MRHS_NC;
+       if(nth <= 1 || 4.0*(double)m*(double)n*(double)nrhs < (double)GEMM_SKX_OMP_MIN_FLOP) {
+          zgemv_t_mrhs_cols(conj,0,n,m,nrhs,alpha_r,alpha_i,A,lda,X,ldx,beta_r,beta_i,Y,ldy);
+          return (0);
+       }
+#pragma omp parallel num_threads(nth) default(none) \
+        shared(A,X,Y) \
+        firstprivate(conj,m,n,nrhs,alpha_r,alpha_i,lda,ldx,beta_r,beta_i,ldy)
+       {
+             int32_t j0,nlen;
+             gemm_partition(n,omp_get_num_threads(),omp_get_thread_num(),ZGEMV_T_MRHS_NC,&j0,&nlen);
+             if(nlen > 0) {
+                zgemv_t_mrhs_cols(conj,j0,nlen,m,nrhs,alpha_r,alpha_i,A,lda,X,ldx,
+                                  beta_r,beta_i,Y,ldy);
+             }
+       }
+       return (0);
+#else
+       return (zgemv_t_mrhs(trans,m,n,nrhs,alpha_r,alpha_i,A,lda,X,ldx,beta_r,beta_i,Y,ldy));
+#endif
+}
@@ -43,6 +43,8 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 
 
+// y += alpha*A^T x (A m x n, column-major, complex interleaved).
+// buffer holds 2*NBMAX doubles; x is packed into it when inc_x != 1.
 int32_t zgemv_t(const int32_t,
 		const int32_t,
 		const double,
@@ -74,12 +76,56 @@ void zgemv_t_kernel_4x1(const int32_t,
 			double ** __restrict,
 			double  * __restrict,
 			double  * __restrict,
-			double  * __restrict) __attribute__((aligned(32))) 
-
-
-
+			double  * __restrict) __attribute__((aligned(32))) __attribute__((hot)) __attribute__((noinline));
 
 
+// Multi-RHS variant (skinny ZGEMM):
+//     Y(n,nrhs) := alpha*op(A)(n,m)*X(m,nrhs) + beta*Y(n,nrhs),  op = 'T' or 'C'
+// Complex arrays interleaved re,im; leading dimensions in complex elements.
+// Each loaded 4-row segment of 3 columns of A is reused for ZGEMV_T_MRHS_NR
+// right-hand sides (split re/im partial products, reduced once per output).
+// Beyond ZGEMV_MRHS_MAX vectors zgemm_skx (packed A and B) is faster and is used instead.
+// The _omp version splits the columns of A (rows of Y) over the threads.
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+
+#if !defined(ZGEMV_MRHS_MAX)
+    #define ZGEMV_MRHS_MAX 16
+#endif
+#if !defined(ZGEMV_MRHS_KB)
+    #define ZGEMV_MRHS_KB 256
+#endif
+#define ZGEMV_T_MRHS_NC 3
+#define ZGEMV_T_MRHS_NR 4
+
+int32_t zgemv_t_mrhs(const char,
+                     const int32_t,
+                     const int32_t,
+                     const int32_t,
+                     const double,
+                     const double,
+                     const double * __restrict,
+                     const int32_t,
+                     const double * __restrict,
+                     const int32_t,
+                     const double,
+                     const double,
+                     double * __restrict,
+                     const int32_t) __attribute__((aligned(32))) __attribute__((hot)) __attribute__((noinline));
+
+int32_t zgemv_t_mrhs_omp(const char,
+                         const int32_t,
+                         const int32_t,
+                         const int32_t,
+                         const double,
+                         const double,
+                         const double * __restrict,
+                         const int32_t,
+                         const double * __restrict,
+                         const int32_t,
+                         const double,
+                         const double,
+                         double * __restrict,
+                         const int32_t) __attribute__((aligned(32))) __attribute__((hot)) __attribute__((noinline));
 
 
 
@@ -0,0 +1,167 @@
+
+
+#ifndef __GMS_CEPHES_VEC_H__
+#define __GMS_CEPHES_VEC_H__ 191020260100
+
+//
+// Reentrant scalar and AVX512 array versions of the Cephes single
+// precision special functions: gamma, lgamma, erf, erfc and the Bessel
+// J, Y, I and K families.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 01:00 AM +00200
+//
+// GMS_cephes.h keeps the sign of gamma in the static sgngamf, so its
+// gamma/lgamma cannot run in parallel regions. These versions have no
+// global state: lgamma returns the sign through an argument.
+// The polynomials and Chebyshev series are those of Cephes 2.2 (gammaf,
+// lgamf, ndtrf, j0f/j1f/y0f/y1f, i0f/i1f, k0f/k1f). erfc on [1,2) is a
+// refit of exp(x^2) x erfc(x) in 4/x - 3.
+// The changes to the algorithms are:
+//   - gamma reflects x < 0 through Gamma(-x), lgamma through Gamma(1-x),
+//     both with sin(pi x) reduced exactly; Stirling always splits pow(x,x-0.5);
+//   - exp(-x^2) in erfc carries the rounding error of x^2 (one FMA);
+//   - J0, J1, Y0, Y1 for x > 2 take one sincos of x and expand the phase
+//     correction, rather than cos(x + phase) in fp32;
+//   - Jn: forward recurrence from J0, J1 when |x| >= n, otherwise the
+//     continued fraction and backward recurrence of ratios (no overflow
+//     for small x). Yn and Kn use forward recurrence.
+// The scalar functions (cephes_*_r4) are the reference and the fallback
+// of the array drivers. The AVX512 kernels run the same arithmetic with
+// lane masks. Branches run only when a lane of the vector needs them.
+// exp/log/sin/sincos/pow are the CEPHV_TIER kernels of GMS_vmath.h.
+// The array drivers use AVX512 when vmath_get_isa() reports it.
+// They run blocks of CEPHV_BLOCK elements in parallel (OpenMP) when
+// n >= CEPHV_OMP_MIN.
+//
+// Special values follow C99: gamma(+-0) = +-Inf, gamma and lgamma of a
+// negative integer NaN and +Inf, Yn(0) = -Inf and Kn(0) = +Inf.
+// Y and K of x < 0 are NaN. I0, I1 overflow above |x| = 88.7.
+// cephes_vec_validate measures the error against fp64 references
+// (libm, and quadratures for I and K). Relative error, or error relative
+// to the envelope min(1, sqrt(2/(pi x))) for J and Y:
+//   gamma 8e-7, lgamma 1e-6 (absolute where |lgamma| < 1), erf 4e-7,
+//   erfc 1.2e-6, J0/J1/Y0/Y1 6e-7, Jn/Yn (n <= 50) 4e-6, I0/I0e 8e-7,
+//   I1/I1e 2e-6, K0/K0e/K1/K1e 1.2e-6, Kn (n <= 50) 4e-6.
+// Return values: 0 success, -1 invalid argument.
+//
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Elements per parallel block.
+#if !defined(CEPHV_BLOCK)
+#define CEPHV_BLOCK 4096
+#endif
+
+// Smallest n that runs the blocks in parallel.
+#if !defined(CEPHV_OMP_MIN)
+#define CEPHV_OMP_MIN 32768
+#endif
+
+// vmath accuracy tier of exp/log/sin/sincos/pow in the AVX512 kernels.
+#if !defined(CEPHV_TIER)
+#define CEPHV_TIER VMATH_U10
+#endif
+
+
+/*
+     Scalar reentrant functions.
+*/
+float cephes_gamma_r4(const float);
+// log|gamma(x)|, *sgn = sign of gamma(x) (sgn may be NULL).
+float cephes_lgamma_r4(const float, int32_t * __restrict);
+float cephes_erf_r4(const float);
+float cephes_erfc_r4(const float);
+float cephes_j0_r4(const float);
+float cephes_j1_r4(const float);
+float cephes_jn_r4(const int32_t, const float);
+float cephes_y0_r4(const float);
+float cephes_y1_r4(const float);
+float cephes_yn_r4(const int32_t, const float);
+float cephes_i0_r4(const float);
+float cephes_i0e_r4(const float);    // exp(-|x|) I0(x)
+float cephes_i1_r4(const float);
+float cephes_i1e_r4(const float);    // exp(-|x|) I1(x)
+float cephes_k0_r4(const float);
+float cephes_k0e_r4(const float);    // exp(x) K0(x)
+float cephes_k1_r4(const float);
+float cephes_k1e_r4(const float);    // exp(x) K1(x)
+float cephes_kn_r4(const int32_t, const float);
+
+
+/*
+     Array drivers: y[i] = f(x[i]), i < n.
+*/
+#define CEPHV_DECL_ARR(fn)                                                    \
+int32_t cephes_##fn##_vec(const float * __restrict,                           \
+                          float * __restrict,                                 \
+                          const int64_t)  __attribute__((hot));
+
+CEPHV_DECL_ARR(gamma)
+CEPHV_DECL_ARR(erf)
+CEPHV_DECL_ARR(erfc)
+CEPHV_DECL_ARR(j0)
+CEPHV_DECL_ARR(j1)
+CEPHV_DECL_ARR(y0)
+CEPHV_DECL_ARR(y1)
+CEPHV_DECL_ARR(i0)
+CEPHV_DECL_ARR(i0e)
+CEPHV_DECL_ARR(i1)
+CEPHV_DECL_ARR(i1e)
+CEPHV_DECL_ARR(k0)
+CEPHV_DECL_ARR(k0e)
+CEPHV_DECL_ARR(k1)
+CEPHV_DECL_ARR(k1e)
+
+// sgn may be NULL.
+int32_t cephes_lgamma_vec(const float * __restrict,   // x
+                          float * __restrict,         // log|gamma(x)|
+                          int32_t * __restrict,       // sign of gamma(x)
+                          const int64_t)  __attribute__((hot));
+
+// Integer order: y[i] = Jn(x[i]), Yn(x[i]), Kn(x[i]).
+#define CEPHV_DECL_ORD(fn)                                                    \
+int32_t cephes_##fn##_vec(const int32_t,                                      \
+                          const float * __restrict,                           \
+                          float * __restrict,                                 \
+                          const int64_t)  __attribute__((hot));
+
+CEPHV_DECL_ORD(jn)
+CEPHV_DECL_ORD(yn)
+CEPHV_DECL_ORD(kn)
+
+// Compares the array drivers with fp64 references on npts random
+// arguments per function (seeded), prints one line per function and
+// returns the number of functions over their bound.
+int32_t cephes_vec_validate(FILE * __restrict,
+                            const int64_t,      // npts
+                            const uint64_t);    // seed
+
+#if defined(__AVX512F__)
+__m512 cephes_gamma_zmm16r4(const __m512);
+__m512 cephes_lgamma_zmm16r4(const __m512, __m512 * __restrict);  // sign as +-1
+__m512 cephes_erf_zmm16r4(const __m512);
+__m512 cephes_erfc_zmm16r4(const __m512);
+__m512 cephes_j0_zmm16r4(const __m512);
+__m512 cephes_j1_zmm16r4(const __m512);
+__m512 cephes_jn_zmm16r4(const int32_t, const __m512);
+__m512 cephes_y0_zmm16r4(const __m512);
+__m512 cephes_y1_zmm16r4(const __m512);
+__m512 cephes_yn_zmm16r4(const int32_t, const __m512);
+__m512 cephes_i0_zmm16r4(const __m512);
+__m512 cephes_i0e_zmm16r4(const __m512);
+__m512 cephes_i1_zmm16r4(const __m512);
+__m512 cephes_i1e_zmm16r4(const __m512);
+__m512 cephes_k0_zmm16r4(const __m512);
+__m512 cephes_k0e_zmm16r4(const __m512);
+__m512 cephes_k1_zmm16r4(const __m512);
+__m512 cephes_k1e_zmm16r4(const __m512);
+__m512 cephes_kn_zmm16r4(const int32_t, const __m512);
+#endif
+
+
+
+
+#endif /*__GMS_CEPHES_VEC_H__*/
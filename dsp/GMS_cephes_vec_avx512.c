@@ -0,0 +1,718 @@
+
+
+//
+// AVX512 kernels of the Cephes array functions (GMS_cephes_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 01:00 AM +00200
+//
+// The unit carries its own target; GMS_cephes_vec.c calls into it only
+// when vmath_get_isa() reports AVX512. Each branch of the scalar code is
+// evaluated for the whole vector when one lane needs it and merged under
+// its mask; data-dependent loops run until no lane is left.
+//
+
+#pragma GCC target("avx512f")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <math.h>
+#include "GMS_vmath.h"
+#include "GMS_cephes_vec_private.h"
+
+
+typedef __m512    vf;
+typedef __mmask16 mf;
+
+#define CV_INL static inline __attribute__((always_inline))
+
+#define CV_J0 1
+#define CV_J1 2
+#define CV_Y0 4
+#define CV_Y1 8
+
+
+CV_INL vf vf_c(const float c)                    { return _mm512_set1_ps(c); }
+CV_INL vf vf_abs(const vf x)                     { return _mm512_abs_ps(x); }
+CV_INL vf vf_neg(const vf x) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x),
+                                   _mm512_set1_epi32(INT32_MIN)));
+}
+// |a| with the sign of b (a >= 0).
+CV_INL vf vf_signed(const vf a, const vf b) {
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a),
+                                   _mm512_and_si512(_mm512_castps_si512(b),
+                                                    _mm512_set1_epi32(INT32_MIN))));
+}
+CV_INL vf vf_rcp(const vf x)                     { return _mm512_div_ps(vf_c(1.0f),x); }
+CV_INL mf vf_lt(const vf a, const float b)       { return _mm512_cmp_ps_mask(a,vf_c(b),_CMP_LT_OQ); }
+CV_INL mf vf_le(const vf a, const float b)       { return _mm512_cmp_ps_mask(a,vf_c(b),_CMP_LE_OQ); }
+CV_INL mf vf_gt(const vf a, const float b)       { return _mm512_cmp_ps_mask(a,vf_c(b),_CMP_GT_OQ); }
+CV_INL mf vf_ge(const vf a, const float b)       { return _mm512_cmp_ps_mask(a,vf_c(b),_CMP_GE_OQ); }
+CV_INL mf vf_eq(const vf a, const float b)       { return _mm512_cmp_ps_mask(a,vf_c(b),_CMP_EQ_OQ); }
+CV_INL vf vf_exp(const vf x)                     { return vmath_exp_zmm16r4(x,CEPHV_TIER); }
+CV_INL vf vf_log(const vf x)                     { return vmath_log_zmm16r4(x,CEPHV_TIER); }
+
+// Polynomial of degree deg, highest power first.
+CV_INL vf cv_polevl(const vf x,
+                    const float * __restrict c,
+                    const int32_t deg) {
+
+        vf a = vf_c(c[0]);
+        int32_t i;
+        for(i = 1; i <= deg; ++i) a = _mm512_fmadd_ps(a,x,vf_c(c[i]));
+        return (a);
+}
+
+// Chebyshev series of n terms (Clenshaw), as chbevlf.
+CV_INL vf cv_chbevl(const vf x,
+                    const float * __restrict c,
+                    const int32_t n) {
+
+        vf b0 = vf_c(c[0]),b1 = _mm512_setzero_ps(),b2 = b1;
+        int32_t i;
+        for(i = 1; i != n; ++i) {
+            b2 = b1;
+            b1 = b0;
+            b0 = _mm512_add_ps(_mm512_fmsub_ps(x,b1,b2),vf_c(c[i]));
+        }
+        return (_mm512_mul_ps(vf_c(0.5f),_mm512_sub_ps(b0,b2)));
+}
+
+// sin(pi x) = (-1)^k sin(pi (x-k)), k = rint(x).
+CV_INL vf cv_sinpi(const vf x) {
+
+        const vf k = _mm512_roundscale_ps(x,_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+        const vf s = vmath_sin_zmm16r4(_mm512_mul_ps(vf_c(CEPHV_PI),_mm512_sub_ps(x,k)),
+                                       CEPHV_TIER);
+        const mf odd = _mm512_test_epi32_mask(_mm512_cvtps_epi32(k),_mm512_set1_epi32(1));
+        return (_mm512_mask_mov_ps(s,odd,vf_neg(s)));
+}
+
+
+/*
+     gamma, lgamma
+*/
+// gamma(w), w > 0 or NaN.
+CV_INL vf cv_gamma_pos(const vf w) {
+
+        const mf mst = vf_ge(w,10.0f);
+        const mf msm = vf_lt(w,1.0e-4f);
+        const mf mid = (mf)(~(mst|msm));
+        vf t = w,num = vf_c(1.0f),den = num,r;
+        mf m;
+        int32_t i;
+        for(i = 0; i != 7; ++i) {
+            m = vf_ge(t,3.0f) & mid;
+            if(!m) break;
+            t   = _mm512_mask_sub_ps(t,m,t,vf_c(1.0f));
+            num = _mm512_mask_mul_ps(num,m,num,t);
+        }
+        for(i = 0; i != 2; ++i) {
+            m = vf_lt(t,2.0f) & mid;
+            if(!m) break;
+            den = _mm512_mask_mul_ps(den,m,den,t);
+            t   = _mm512_mask_add_ps(t,m,t,vf_c(1.0f));
+        }
+        r = _mm512_div_ps(_mm512_mul_ps(num,cv_polevl(_mm512_sub_ps(t,vf_c(2.0f)),cephv_gam_P,7)),den);
+        if(msm) {
+           const vf s = _mm512_mul_ps(_mm512_fmadd_ps(vf_c(CEPHV_EUL),w,vf_c(1.0f)),w);
+           r = _mm512_mask_div_ps(r,msm,vf_c(1.0f),s);
+        }
+        if(mst) {
+           // Stirling: sqrt(2pi) w^(w-1/2) exp(-w) (1 + STIR(1/w)/w).
+           const vf z = vf_rcp(w);
+           const vf v = vmath_pow_zmm16r4(w,_mm512_fmsub_ps(vf_c(0.5f),w,vf_c(0.25f)),CEPHV_TIER);
+           vf y = _mm512_mul_ps(_mm512_mul_ps(vf_exp(vf_neg(w)),v),v);
+           y = _mm512_mul_ps(_mm512_mul_ps(vf_c(CEPHV_S2PI),y),
+                             _mm512_fmadd_ps(z,cv_polevl(z,cephv_gam_STIR,2),vf_c(1.0f)));
+           r = _mm512_mask_mov_ps(r,mst,y);
+           r = _mm512_mask_mov_ps(r,vf_gt(w,CEPHV_GMAX),vf_c(INFINITY));
+        }
+        return (r);
+}
+
+__m512 cephes_gamma_zmm16r4(const __m512 x) {
+
+        const mf neg = vf_lt(x,0.0f);
+        const vf w = vf_abs(x);
+        vf r = cv_gamma_pos(w);
+        mf z;
+        if(neg) {
+           // gamma(x) = pi/(sin(pi x) gamma(1-x)), gamma(1-x) = -x gamma(-x)
+           // (the last division underflows gradually).
+           const mf nint = neg & _mm512_cmp_ps_mask(x,_mm512_roundscale_ps(x,_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC),
+                                                  _CMP_EQ_OQ);
+           const vf v = _mm512_div_ps(vf_c(CEPHV_PI),_mm512_mul_ps(cv_sinpi(x),r));
+           r = _mm512_mask_div_ps(r,neg,v,vf_neg(x));
+           r = _mm512_mask_mov_ps(r,nint,vf_c(NAN));
+        }
+        z = vf_eq(x,0.0f);
+        if(z) r = _mm512_mask_mov_ps(r,z,vf_signed(vf_c(INFINITY),x));
+        return (r);
+}
+
+// log gamma(w), w > 0 or NaN.
+CV_INL vf cv_lgamma_pos(const vf w) {
+
+        const mf masy = vf_ge(w,6.5f);
+        const mf mc   = vf_ge(w,0.75f) & vf_lt(w,1.25f);
+        const mf mid  = (mf)(~(masy|mc));
+        const mf up   = vf_lt(w,1.5f) & mid;
+        vf t = w,num = vf_c(1.0f),den = num,u,p,L,r;
+        mf m;
+        int32_t i;
+        for(i = 0; i != 4; ++i) {
+            m = vf_gt(t,2.5f) & mid;
+            if(!m) break;
+            t   = _mm512_mask_sub_ps(t,m,t,vf_c(1.0f));
+            num = _mm512_mask_mul_ps(num,m,num,t);
+        }
+        for(i = 0; i != 2; ++i) {
+            m = vf_lt(t,1.5f) & mid;
+            if(!m) break;
+            den = _mm512_mask_mul_ps(den,m,den,t);
+            t   = _mm512_mask_add_ps(t,m,t,vf_c(1.0f));
+        }
+        u = _mm512_sub_ps(t,vf_c(2.0f));
+        p = _mm512_mul_ps(u,cv_polevl(u,cephv_lgam_B,7));
+        if(mc) {
+           const vf uc = _mm512_sub_ps(w,vf_c(1.0f));
+           p = _mm512_mask_mul_ps(p,mc,uc,cv_polevl(uc,cephv_lgam_C,7));
+        }
+        // One log: w (asymptotic), den (upward shifts), num (downward).
+        L = _mm512_mask_mov_ps(_mm512_mask_mov_ps(num,up,den),masy,w);
+        L = vf_log(L);
+        r = _mm512_add_ps(p,_mm512_mask_mov_ps(L,up,vf_neg(L)));
+        if(masy) {
+           const vf z  = vf_rcp(w);
+           const vf z2 = _mm512_mul_ps(z,z);
+           vf s = _mm512_fmsub_ps(vf_c(6.789774945028216E-004f),z2,vf_c(2.769887652139868E-003f));
+           s = _mm512_mul_ps(_mm512_fmadd_ps(s,z2,vf_c(8.333316229807355E-002f)),z);
+           s = _mm512_add_ps(_mm512_fmadd_ps(_mm512_sub_ps(w,vf_c(0.5f)),L,
+                                             _mm512_sub_ps(vf_c(CEPHV_LS2PI),w)),s);
+           r = _mm512_mask_mov_ps(r,masy,s);
+           r = _mm512_mask_mov_ps(r,vf_eq(w,INFINITY),w);
+        }
+        return (r);
+}
+
+__m512 cephes_lgamma_zmm16r4(const __m512 x,
+                             __m512 * __restrict sgn) {
+
+        const mf neg = vf_lt(x,0.0f);
+        const vf w = _mm512_mask_sub_ps(x,neg,vf_c(1.0f),x);
+        vf r = cv_lgamma_pos(w);
+        vf s = vf_c(1.0f);
+        if(neg) {
+           // log|gamma(x)| = -log(|sin(pi x)|/pi) - log gamma(1-x)
+           const mf nint = neg & _mm512_cmp_ps_mask(x,_mm512_roundscale_ps(x,_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC),
+                                                  _CMP_EQ_OQ);
+           const vf sp = cv_sinpi(x);
+           const vf l  = vf_log(_mm512_mul_ps(vf_abs(sp),vf_c(CEPHV_IPI)));
+           r = _mm512_mask_sub_ps(r,neg,vf_neg(l),r);
+           s = _mm512_mask_mov_ps(s,neg & vf_lt(sp,0.0f),vf_c(-1.0f));
+           r = _mm512_mask_mov_ps(r,nint,vf_c(INFINITY));
+           s = _mm512_mask_mov_ps(s,nint,vf_c(1.0f));
+        }
+        s = _mm512_mask_mov_ps(s,vf_eq(x,0.0f) &
+                               _mm512_test_epi32_mask(_mm512_castps_si512(x),_mm512_set1_epi32(INT32_MIN)),
+                               vf_c(-1.0f));
+        *sgn = s;
+        return (r);
+}
+
+
+/*
+     erf, erfc
+*/
+// erfc(ax), ax >= 1: exp(-ax^2) with the rounding error of ax^2 (FMA)
+// times P(4/ax - 3)/ax (ax < 2) or R(1/ax^2)/ax.
+CV_INL vf cv_erfc_big(const vf ax) {
+
+        const vf a  = _mm512_min_ps(vf_c(11.0f),ax);     // NaN stays NaN
+        const vf t  = vf_rcp(a);
+        const vf hi = _mm512_mul_ps(a,a);
+        const vf lo = _mm512_fmsub_ps(a,a,hi);
+        const mf m2 = vf_lt(a,2.0f);
+        vf e = vf_exp(vf_neg(hi)),p;
+        e = _mm512_fnmadd_ps(e,lo,e);
+        p = cv_polevl(_mm512_mul_ps(t,t),cephv_erfc_R,7);
+        if(m2) p = _mm512_mask_mov_ps(p,m2,cv_polevl(_mm512_fmsub_ps(vf_c(4.0f),t,vf_c(3.0f)),cephv_erfc_P,7));
+        return (_mm512_mul_ps(e,_mm512_mul_ps(t,p)));
+}
+
+__m512 cephes_erf_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        const mf mb = (mf)~vf_lt(ax,1.0f);
+        vf r = _mm512_mul_ps(x,cv_polevl(_mm512_mul_ps(x,x),cephv_erf_T,6));
+        if(mb) {
+           const vf y = _mm512_sub_ps(vf_c(1.0f),cv_erfc_big(ax));
+           r = _mm512_mask_mov_ps(r,mb,vf_signed(y,x));
+        }
+        return (r);
+}
+
+__m512 cephes_erfc_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        const mf mb = (mf)~vf_lt(ax,1.0f);
+        vf r = _mm512_fnmadd_ps(x,cv_polevl(_mm512_mul_ps(x,x),cephv_erf_T,6),vf_c(1.0f));
+        if(mb) {
+           const vf y = cv_erfc_big(ax);
+           r = _mm512_mask_mov_ps(r,mb,y);
+           r = _mm512_mask_sub_ps(r,mb & vf_lt(x,0.0f),vf_c(2.0f),y);
+        }
+        return (r);
+}
+
+
+/*
+     J0, J1, Y0, Y1
+*/
+// Requested (CV_J0|CV_J1|CV_Y0|CV_Y1) functions of ax >= 0 (odd J1 and
+// the domain of Y left to the callers). x > 2: one sincos of ax for all.
+CV_INL void cv_jy01(const vf ax,
+                    const int32_t want,
+                    vf * __restrict j0,
+                    vf * __restrict j1,
+                    vf * __restrict y0,
+                    vf * __restrict y1) {
+
+        const mf ms = vf_le(ax,2.0f);
+        const mf mb = (mf)~ms;
+        if(ms) {
+           const vf z = _mm512_mul_ps(ax,ax);
+           vf sj0 = _mm512_setzero_ps(),sj1 = sj0,L = sj0;
+           if(want & (CV_J0|CV_Y0)) {
+              sj0 = _mm512_mul_ps(_mm512_sub_ps(z,vf_c(CEPHV_DR1)),cv_polevl(z,cephv_j0_JP,4));
+              sj0 = _mm512_mask_mov_ps(sj0,vf_lt(ax,1.0e-3f),
+                                       _mm512_fnmadd_ps(vf_c(0.25f),z,vf_c(1.0f)));
+           }
+           if(want & (CV_J1|CV_Y1))
+              sj1 = _mm512_mul_ps(_mm512_mul_ps(_mm512_sub_ps(z,vf_c(CEPHV_J1Z1)),ax),
+                                  cv_polevl(z,cephv_j1_JP,4));
+           if(want & (CV_Y0|CV_Y1)) L = vf_log(ax);
+           if(want & CV_J0) *j0 = sj0;
+           if(want & CV_J1) *j1 = sj1;
+           if(want & CV_Y0)
+              *y0 = _mm512_fmadd_ps(_mm512_mul_ps(vf_c(CEPHV_TWOOPI),L),sj0,
+                                    _mm512_mul_ps(_mm512_sub_ps(z,vf_c(CEPHV_YZ1)),
+                                                  cv_polevl(z,cephv_y0_YP,4)));
+           if(want & CV_Y1)
+              *y1 = _mm512_fmadd_ps(vf_c(CEPHV_TWOOPI),_mm512_fmsub_ps(sj1,L,vf_rcp(ax)),
+                                    _mm512_mul_ps(_mm512_mul_ps(_mm512_sub_ps(z,vf_c(CEPHV_YO1)),ax),
+                                                  cv_polevl(z,cephv_y1_YP,4)));
+        }
+        if(mb) {
+           const vf q  = vf_rcp(ax);
+           const vf sq = _mm512_sqrt_ps(q);
+           const vf q2 = _mm512_mul_ps(q,q);
+           const mf mi = vf_eq(ax,INFINITY);
+           vf s,c;
+           vmath_sincos_zmm16r4(ax,&s,&c,CEPHV_TIER);
+           s = _mm512_mul_ps(s,vf_c(CEPHV_SQRTH));
+           c = _mm512_mul_ps(c,vf_c(CEPHV_SQRTH));
+#define CV_PHASE(MO,PH,CA,SA,JV,YV,FJ,FY)                                          \
+           {                                                                   \
+              const vf p  = _mm512_mul_ps(sq,cv_polevl(q,MO,7));               \
+              const vf d  = _mm512_mul_ps(q,cv_polevl(q2,PH,7));               \
+              const vf d2 = _mm512_mul_ps(d,d);                                \
+              const vf cd = _mm512_fnmadd_ps(d2,_mm512_fnmadd_ps(d2,vf_c(1.0f/24.0f),vf_c(0.5f)),vf_c(1.0f)); \
+              const vf sd = _mm512_mul_ps(d,_mm512_fnmadd_ps(d2,_mm512_fnmadd_ps(d2,vf_c(1.0f/120.0f), \
+                                          vf_c(1.0f/6.0f)),vf_c(1.0f)));       \
+              const vf ca = (CA);                                              \
+              const vf sa = (SA);                                              \
+              if(want & (FJ)) {                                                \
+                 const vf v = _mm512_mul_ps(p,_mm512_fmsub_ps(ca,cd,_mm512_mul_ps(sa,sd))); \
+                 *(JV) = _mm512_mask_mov_ps(*(JV),mb,_mm512_mask_mov_ps(v,mi,_mm512_setzero_ps())); \
+              }                                                                \
+              if(want & (FY)) {                                                \
+                 const vf v = _mm512_mul_ps(p,_mm512_fmadd_ps(sa,cd,_mm512_mul_ps(ca,sd))); \
+                 *(YV) = _mm512_mask_mov_ps(*(YV),mb,_mm512_mask_mov_ps(v,mi,_mm512_setzero_ps())); \
+              }                                                                \
+           }
+           if(want & (CV_J0|CV_Y0))
+              CV_PHASE(cephv_j0_MO,cephv_j0_PH,_mm512_add_ps(c,s),_mm512_sub_ps(s,c),j0,y0,CV_J0,CV_Y0)
+           if(want & (CV_J1|CV_Y1))
+              CV_PHASE(cephv_j1_MO,cephv_j1_PH,_mm512_sub_ps(s,c),vf_neg(_mm512_add_ps(s,c)),j1,y1,CV_J1,CV_Y1)
+#undef CV_PHASE
+        }
+}
+
+__m512 cephes_j0_zmm16r4(const __m512 x) {
+
+        vf j0 = _mm512_setzero_ps();
+        cv_jy01(vf_abs(x),CV_J0,&j0,NULL,NULL,NULL);
+        return (j0);
+}
+
+__m512 cephes_j1_zmm16r4(const __m512 x) {
+
+        vf j1 = _mm512_setzero_ps();
+        cv_jy01(vf_abs(x),CV_J1,NULL,&j1,NULL,NULL);
+        return (_mm512_mask_mov_ps(j1,vf_lt(x,0.0f),vf_neg(j1)));
+}
+
+// Y of x < 0: NaN; Y(0) = -Inf.
+CV_INL vf cv_ydom(const vf x, const vf y) {
+
+        const vf r = _mm512_mask_mov_ps(y,vf_eq(x,0.0f),vf_c(-INFINITY));
+        return (_mm512_mask_mov_ps(r,vf_lt(x,0.0f),vf_c(NAN)));
+}
+
+__m512 cephes_y0_zmm16r4(const __m512 x) {
+
+        vf y0 = _mm512_setzero_ps();
+        cv_jy01(x,CV_Y0,NULL,NULL,&y0,NULL);
+        return (cv_ydom(x,y0));
+}
+
+__m512 cephes_y1_zmm16r4(const __m512 x) {
+
+        vf y1 = _mm512_setzero_ps();
+        cv_jy01(x,CV_Y1,NULL,NULL,NULL,&y1);
+        return (cv_ydom(x,y1));
+}
+
+__m512 cephes_jn_zmm16r4(const int32_t n,
+                         const __m512 x) {
+
+        const int64_t na = (n < 0) ? -(int64_t)n : (int64_t)n;
+        const vf ax = vf_abs(x);
+        const float fn = (float)na;
+        vf j0 = _mm512_setzero_ps(),j1 = j0,r;
+        mf mf_,mb,flip;
+        int64_t k;
+        if(na == 0) return (cephes_j0_zmm16r4(x));
+        flip = (na & 1) ? (mf)(vf_lt(x,0.0f) ^ ((n < 0) ? 0xFFFF : 0)) : 0;
+        if(na == 1) {
+           cv_jy01(ax,CV_J1,NULL,&j1,NULL,NULL);
+           r = j1;
+        } else {
+           cv_jy01(ax,CV_J0|CV_J1,&j0,&j1,NULL,NULL);
+           mf_ = vf_ge(ax,fn);
+           mb  = (mf)~mf_;
+           r   = _mm512_setzero_ps();
+           if(mf_) {
+              // Forward recurrence (stable while k < x).
+              const vf xinv = vf_rcp(ax);
+              vf jm = j0,j = j1,t;
+              for(k = 1; k != na; ++k) {
+                  t  = _mm512_fmsub_ps(_mm512_mul_ps(vf_c((float)(2*k)),xinv),j,jm);
+                  jm = j;
+                  j  = t;
+              }
+              r = j;
+           }
+           if(mb) {
+              // Continued fraction for J_n/J_{n-1}, ratios r_k = x/(2k - x r_{k+1}).
+              const vf xx = _mm512_mul_ps(ax,ax);
+              float pk = (float)(2*(na+24));
+              vf ans = vf_c(pk),rk,prod,r1,v;
+              for(k = 24; k != 0; --k) {
+                  pk -= 2.0f;
+                  ans = _mm512_sub_ps(vf_c(pk),_mm512_div_ps(xx,ans));
+              }
+              rk = _mm512_div_ps(ax,ans);
+              prod = rk;
+              for(k = na-1; k >= 2; --k) {
+                  rk = _mm512_div_ps(ax,_mm512_fnmadd_ps(ax,rk,vf_c((float)(2*k))));
+                  prod = _mm512_mul_ps(prod,rk);
+              }
+              r1 = _mm512_div_ps(ax,_mm512_fnmadd_ps(ax,rk,vf_c(2.0f)));
+              v  = _mm512_mask_mov_ps(_mm512_mul_ps(j0,r1),vf_gt(vf_abs(r1),1.0f),j1);
+              r  = _mm512_mask_mul_ps(r,mb,prod,v);
+           }
+           r = _mm512_mask_mov_ps(r,vf_eq(ax,INFINITY),_mm512_setzero_ps());
+        }
+        return (_mm512_mask_mov_ps(r,flip,vf_neg(r)));
+}
+
+__m512 cephes_yn_zmm16r4(const int32_t n,
+                         const __m512 x) {
+
+        const int64_t na = (n < 0) ? -(int64_t)n : (int64_t)n;
+        const int32_t neg = (na & 1) && n < 0;
+        vf y0 = _mm512_setzero_ps(),y1 = y0,r;
+        int64_t k;
+        if(na == 0) return (cephes_y0_zmm16r4(x));
+        cv_jy01(x,CV_Y0|CV_Y1,NULL,NULL,&y0,&y1);
+        if(na == 1) {
+           r = y1;
+        } else {
+           // Forward recurrence; lanes stop at -Inf.
+           const vf xinv = vf_rcp(x);
+           vf ym = y0,t;
+           mf live = (mf)~vf_eq(y1,-INFINITY);
+           r = y1;
+           for(k = 1; k != na && live; ++k) {
+               t  = _mm512_fmsub_ps(_mm512_mul_ps(vf_c((float)(2*k)),xinv),r,ym);
+               ym = _mm512_mask_mov_ps(ym,live,r);
+               r  = _mm512_mask_mov_ps(r,live,t);
+               live &= (mf)~vf_eq(r,-INFINITY);
+           }
+        }
+        r = cv_ydom(x,r);
+        return (neg ? vf_neg(r) : r);
+}
+
+
+/*
+     I0, I1, K0, K1
+*/
+// exp(-|x|) I0(x) and exp(-|x|) I1(|x|) of ax = |x|.
+CV_INL vf cv_i0e(const vf ax, const mf ms) {
+
+        vf r = cv_chbevl(_mm512_fmsub_ps(vf_c(0.5f),ax,vf_c(2.0f)),cephv_i0_A,18);
+        const mf mb = (mf)~ms;
+        if(mb) {
+           const vf v = _mm512_div_ps(cv_chbevl(_mm512_sub_ps(_mm512_div_ps(vf_c(32.0f),ax),vf_c(2.0f)),
+                                                cephv_i0_B,7),_mm512_sqrt_ps(ax));
+           r = _mm512_mask_mov_ps(r,mb,v);
+        }
+        return (r);
+}
+
+CV_INL vf cv_i1e(const vf ax, const mf ms) {
+
+        vf r = _mm512_mul_ps(cv_chbevl(_mm512_fmsub_ps(vf_c(0.5f),ax,vf_c(2.0f)),cephv_i1_A,17),ax);
+        const mf mb = (mf)~ms;
+        if(mb) {
+           const vf v = _mm512_div_ps(cv_chbevl(_mm512_sub_ps(_mm512_div_ps(vf_c(32.0f),ax),vf_c(2.0f)),
+                                                cephv_i1_B,7),_mm512_sqrt_ps(ax));
+           r = _mm512_mask_mov_ps(r,mb,v);
+        }
+        return (r);
+}
+
+__m512 cephes_i0_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        const vf r = _mm512_mul_ps(vf_exp(ax),cv_i0e(ax,vf_le(ax,8.0f)));
+        return (_mm512_mask_mov_ps(r,vf_eq(ax,INFINITY),ax));
+}
+
+__m512 cephes_i0e_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        return (cv_i0e(ax,vf_le(ax,8.0f)));
+}
+
+__m512 cephes_i1_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        vf r = _mm512_mul_ps(vf_exp(ax),cv_i1e(ax,vf_le(ax,8.0f)));
+        r = _mm512_mask_mov_ps(r,vf_eq(ax,INFINITY),ax);
+        return (_mm512_mask_mov_ps(r,vf_lt(x,0.0f),vf_neg(r)));
+}
+
+__m512 cephes_i1e_zmm16r4(const __m512 x) {
+
+        const vf ax = vf_abs(x);
+        const vf r = cv_i1e(ax,vf_le(ax,8.0f));
+        return (_mm512_mask_mov_ps(r,vf_lt(x,0.0f),vf_neg(r)));
+}
+
+// K0 and K1 of x (scaled by exp(x) when sc != 0). x <= 2: series with
+// log(x/2) I(x); x > 2: Chebyshev in 8/x. One exp: exp(x) on the series
+// lanes (I0, I1 and the scaling), exp(-x) on the others.
+CV_INL void cv_k01(const vf x,
+                   const int32_t want0,
+                   const int32_t want1,
+                   const int32_t sc,
+                   vf * __restrict k0,
+                   vf * __restrict k1) {
+
+        const mf ms = vf_le(x,2.0f);
+        const mf mb = (mf)~ms;
+        const vf e  = (sc && !ms) ? _mm512_setzero_ps()
+                                  : vf_exp(_mm512_mask_mov_ps(vf_neg(x),ms,x));
+        vf r0 = _mm512_setzero_ps(),r1 = r0;
+        if(ms) {
+           const vf z = _mm512_fmsub_ps(x,x,vf_c(2.0f));
+           const vf L = vf_log(_mm512_mul_ps(vf_c(0.5f),x));
+           const vf u = _mm512_fmsub_ps(vf_c(0.5f),x,vf_c(2.0f));
+           if(want0) {
+              const vf i0 = _mm512_mul_ps(e,cv_chbevl(u,cephv_i0_A,18));
+              r0 = _mm512_fnmadd_ps(L,i0,cv_chbevl(z,cephv_k0_A,7));
+              if(sc) r0 = _mm512_mul_ps(r0,e);
+           }
+           if(want1) {
+              const vf i1 = _mm512_mul_ps(_mm512_mul_ps(e,cv_chbevl(u,cephv_i1_A,17)),x);
+              r1 = _mm512_fmadd_ps(L,i1,_mm512_div_ps(cv_chbevl(z,cephv_k1_A,7),x));
+              if(sc) r1 = _mm512_mul_ps(r1,e);
+           }
+        }
+        if(mb) {
+           const vf z  = _mm512_sub_ps(_mm512_div_ps(vf_c(8.0f),x),vf_c(2.0f));
+           const vf sq = _mm512_sqrt_ps(x);
+           if(want0) {
+              vf v = _mm512_div_ps(cv_chbevl(z,cephv_k0_B,10),sq);
+              if(!sc) v = _mm512_mul_ps(v,e);
+              r0 = _mm512_mask_mov_ps(r0,mb,v);
+           }
+           if(want1) {
+              vf v = _mm512_div_ps(cv_chbevl(z,cephv_k1_B,10),sq);
+              if(!sc) v = _mm512_mul_ps(v,e);
+              r1 = _mm512_mask_mov_ps(r1,mb,v);
+           }
+        }
+        if(want0) *k0 = r0;
+        if(want1) *k1 = r1;
+}
+
+// K of x < 0: NaN; K(0) = +Inf.
+CV_INL vf cv_kdom(const vf x, const vf k) {
+
+        const vf r = _mm512_mask_mov_ps(k,vf_eq(x,0.0f),vf_c(INFINITY));
+        return (_mm512_mask_mov_ps(r,vf_lt(x,0.0f),vf_c(NAN)));
+}
+
+__m512 cephes_k0_zmm16r4(const __m512 x) {
+
+        vf k0 = _mm512_setzero_ps();
+        cv_k01(x,1,0,0,&k0,NULL);
+        return (cv_kdom(x,k0));
+}
+
+__m512 cephes_k0e_zmm16r4(const __m512 x) {
+
+        vf k0 = _mm512_setzero_ps();
+        cv_k01(x,1,0,1,&k0,NULL);
+        return (cv_kdom(x,k0));
+}
+
+__m512 cephes_k1_zmm16r4(const __m512 x) {
+
+        vf k1 = _mm512_setzero_ps();
+        cv_k01(x,0,1,0,NULL,&k1);
+        return (cv_kdom(x,k1));
+}
+
+__m512 cephes_k1e_zmm16r4(const __m512 x) {
+
+        vf k1 = _mm512_setzero_ps();
+        cv_k01(x,0,1,1,NULL,&k1);
+        return (cv_kdom(x,k1));
+}
+
+__m512 cephes_kn_zmm16r4(const int32_t n,
+                         const __m512 x) {
+
+        const int64_t na = (n < 0) ? -(int64_t)n : (int64_t)n;
+        vf k0 = _mm512_setzero_ps(),k1 = k0,r;
+        int64_t k;
+        cv_k01(x,1,1,0,&k0,&k1);
+        if(na == 0) {
+           r = k0;
+        } else if(na == 1) {
+           r = k1;
+        } else {
+           // Forward recurrence; lanes stop at +Inf.
+           const vf xinv = vf_rcp(x);
+           vf km = k0,t;
+           mf live = (mf)~vf_eq(k1,INFINITY);
+           r = k1;
+           for(k = 1; k != na && live; ++k) {
+               t  = _mm512_fmadd_ps(_mm512_mul_ps(vf_c((float)(2*k)),xinv),r,km);
+               km = _mm512_mask_mov_ps(km,live,r);
+               r  = _mm512_mask_mov_ps(r,live,t);
+               live &= (mf)~vf_eq(r,INFINITY);
+           }
+        }
+        return (cv_kdom(x,r));
+}
+
+
+/*
+     Array loops; the tail runs masked with 1.0f in the idle lanes.
+*/
+#define CV_TAIL_MASK(r) ((mf)((1U << (r)) - 1U))
+
+#define CV_DEF_LOOP(fn)                                                       \
+static void cv_##fn##_loop(const float * __restrict x,                        \
+                           float * __restrict y,                              \
+                           const int64_t n) {                                 \
+        int64_t i;                                                            \
+        for(i = 0; i+16 <= n; i += 16)                                        \
+            _mm512_storeu_ps(&y[i],cephes_##fn##_zmm16r4(_mm512_loadu_ps(&x[i]))); \
+        if(i < n) {                                                           \
+           const mf m = CV_TAIL_MASK(n-i);                                    \
+           _mm512_mask_storeu_ps(&y[i],m,cephes_##fn##_zmm16r4(               \
+                                 _mm512_mask_loadu_ps(vf_c(1.0f),m,&x[i]))); \
+        }                                                                     \
+}
+
+#define CV_DEF_ORD_LOOP(fn)                                                   \
+static void cv_##fn##_loop(const int32_t nord,                                \
+                           const float * __restrict x,                        \
+                           float * __restrict y,                              \
+                           const int64_t n) {                                 \
+        int64_t i;                                                            \
+        for(i = 0; i+16 <= n; i += 16)                                        \
+            _mm512_storeu_ps(&y[i],cephes_##fn##_zmm16r4(nord,_mm512_loadu_ps(&x[i]))); \
+        if(i < n) {                                                           \
+           const mf m = CV_TAIL_MASK(n-i);                                    \
+           _mm512_mask_storeu_ps(&y[i],m,cephes_##fn##_zmm16r4(nord,          \
+                                 _mm512_mask_loadu_ps(vf_c(1.0f),m,&x[i]))); \
+        }                                                                     \
+}
+
+CV_DEF_LOOP(gamma)
+CV_DEF_LOOP(erf)
+CV_DEF_LOOP(erfc)
+CV_DEF_LOOP(j0)
+CV_DEF_LOOP(j1)
+CV_DEF_LOOP(y0)
+CV_DEF_LOOP(y1)
+CV_DEF_LOOP(i0)
+CV_DEF_LOOP(i0e)
+CV_DEF_LOOP(i1)
+CV_DEF_LOOP(i1e)
+CV_DEF_LOOP(k0)
+CV_DEF_LOOP(k0e)
+CV_DEF_LOOP(k1)
+CV_DEF_LOOP(k1e)
+CV_DEF_ORD_LOOP(jn)
+CV_DEF_ORD_LOOP(yn)
+CV_DEF_ORD_LOOP(kn)
+
+static void cv_lgamma_loop(const float * __restrict x,
+                           float * __restrict y,
+                           int32_t * __restrict sgn,
+                           const int64_t n) {
+
+        int64_t i;
+        vf s;
+        for(i = 0; i < n; i += 16) {
+            const mf m = (n-i >= 16) ? (mf)0xFFFF : CV_TAIL_MASK(n-i);
+            _mm512_mask_storeu_ps(&y[i],m,cephes_lgamma_zmm16r4(
+                                  _mm512_mask_loadu_ps(vf_c(1.0f),m,&x[i]),&s));
+            if(NULL != sgn)
+               _mm512_mask_storeu_epi32(&sgn[i],m,_mm512_cvtps_epi32(s));
+        }
+}
+
+
+const cephv_isa_tab_t cephv_tab_avx512 = {
+        cv_gamma_loop,
+        cv_erf_loop,
+        cv_erfc_loop,
+        cv_j0_loop,
+        cv_j1_loop,
+        cv_y0_loop,
+        cv_y1_loop,
+        cv_i0_loop,
+        cv_i0e_loop,
+        cv_i1_loop,
+        cv_i1e_loop,
+        cv_k0_loop,
+        cv_k0e_loop,
+        cv_k1_loop,
+        cv_k1e_loop,
+        cv_lgamma_loop,
+        cv_jn_loop,
+        cv_yn_loop,
+        cv_kn_loop
+};
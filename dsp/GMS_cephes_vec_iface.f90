@@ -0,0 +1,407 @@
+
+
+module cephes_vec_iface
+
+
+!===========================================================!
+! Interfaces to the reentrant Cephes array functions        !
+! GMS_cephes_vec.c: y(i) = f(x(i)), i = 1..n (fp32).        !
+! AVX512 kernels when the host has them, OpenMP blocks     !
+! for n >= CEPHV_OMP_MIN. stat: 0 success, -1 invalid arg.  !
+!===========================================================!
+
+
+use, intrinsic :: ISO_C_BINDING
+implicit none
+public
+
+
+#if 0
+int32_t cephes_gamma_vec(const float * __restrict x,
+                         float * __restrict y,
+                         const int64_t n);
+#endif
+
+interface
+
+   function cephes_gamma_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_gamma_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_erf_vec(const float * __restrict x,
+                       float * __restrict y,
+                       const int64_t n);
+#endif
+
+interface
+
+   function cephes_erf_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_erf_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_erfc_vec(const float * __restrict x,
+                        float * __restrict y,
+                        const int64_t n);
+#endif
+
+interface
+
+   function cephes_erfc_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_erfc_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_j0_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_j0_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_j0_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_j1_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_j1_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_j1_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_y0_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_y0_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_y0_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_y1_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_y1_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_y1_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_i0_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_i0_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_i0_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_i0e_vec(const float * __restrict x,
+                       float * __restrict y,
+                       const int64_t n);
+#endif
+
+interface
+
+   function cephes_i0e_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_i0e_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_i1_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_i1_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_i1_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_i1e_vec(const float * __restrict x,
+                       float * __restrict y,
+                       const int64_t n);
+#endif
+
+interface
+
+   function cephes_i1e_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_i1e_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_k0_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_k0_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_k0_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_k0e_vec(const float * __restrict x,
+                       float * __restrict y,
+                       const int64_t n);
+#endif
+
+interface
+
+   function cephes_k0e_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_k0e_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_k1_vec(const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_k1_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_k1_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_k1e_vec(const float * __restrict x,
+                       float * __restrict y,
+                       const int64_t n);
+#endif
+
+interface
+
+   function cephes_k1e_vec(x,y,n) result(stat) &
+                      bind(c,name='cephes_k1e_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_lgamma_vec(const float * __restrict x,
+                          float * __restrict y,
+                          int32_t * __restrict sgn,
+                          const int64_t n);
+#endif
+
+interface
+
+   function cephes_lgamma_vec(x,y,sgn,n) result(stat) &
+                      bind(c,name='cephes_lgamma_vec')
+            use, intrinsic :: ISO_C_BINDING
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int32_t), dimension(*), intent(out)     :: sgn
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_jn_vec(const int32_t nord,
+                      const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_jn_vec(nord,x,y,n) result(stat) &
+                      bind(c,name='cephes_jn_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int32_t),             intent(in), value :: nord
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_yn_vec(const int32_t nord,
+                      const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_yn_vec(nord,x,y,n) result(stat) &
+                      bind(c,name='cephes_yn_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int32_t),             intent(in), value :: nord
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+#if 0
+int32_t cephes_kn_vec(const int32_t nord,
+                      const float * __restrict x,
+                      float * __restrict y,
+                      const int64_t n);
+#endif
+
+interface
+
+   function cephes_kn_vec(nord,x,y,n) result(stat) &
+                      bind(c,name='cephes_kn_vec')
+            use, intrinsic :: ISO_C_BINDING
+            integer(c_int32_t),             intent(in), value :: nord
+            real(c_float),  dimension(*),   intent(in)        :: x
+            real(c_float),  dimension(*),   intent(out)       :: y
+            integer(c_int64_t),             intent(in), value :: n
+            integer(c_int32_t) :: stat
+   end function
+
+end interface
+
+
+end module cephes_vec_iface
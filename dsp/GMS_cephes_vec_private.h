@@ -0,0 +1,98 @@
+
+
+#ifndef __GMS_CEPHES_VEC_PRIVATE_H__
+#define __GMS_CEPHES_VEC_PRIVATE_H__
+
+//
+// Coefficient tables and kernel loops of the Cephes array functions
+// (GMS_cephes_vec.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 01:00 AM +00200
+//
+
+#include <stdint.h>
+#include "GMS_cephes_vec.h"
+
+
+// Polynomials (highest power first) and Chebyshev series (GMS_cephes_vec.c).
+extern const float cephv_gam_P[8];      // gamma(x+2), 0 <= x < 1
+extern const float cephv_gam_STIR[3];   // Stirling correction in 1/x
+extern const float cephv_lgam_B[8];     // lgamma(x+2)/x, |x| <= 0.5
+extern const float cephv_lgam_C[8];     // lgamma(x+1)/x, |x| <= 0.25
+extern const float cephv_erf_T[7];      // erf(x)/x in x^2, |x| < 1
+extern const float cephv_erfc_P[8];     // x exp(x^2) erfc(x) in 4/x - 3, 1 <= x < 2
+extern const float cephv_erfc_R[8];     // x exp(x^2) erfc(x) in 1/x^2, x >= 2
+extern const float cephv_j0_JP[5];
+extern const float cephv_y0_YP[5];
+extern const float cephv_j0_MO[8];      // modulus, phase of J0/Y0 in 1/x
+extern const float cephv_j0_PH[8];
+extern const float cephv_j1_JP[5];
+extern const float cephv_y1_YP[5];
+extern const float cephv_j1_MO[8];
+extern const float cephv_j1_PH[8];
+extern const float cephv_i0_A[18];      // Chebyshev: [0,8] and (8,inf)
+extern const float cephv_i0_B[7];
+extern const float cephv_i1_A[17];
+extern const float cephv_i1_B[7];
+extern const float cephv_k0_A[7];       // Chebyshev: [0,2] and (2,inf)
+extern const float cephv_k0_B[10];
+extern const float cephv_k1_A[7];
+extern const float cephv_k1_B[10];
+
+#define CEPHV_DR1   5.78318596294678452118f      // first zero of J0, squared
+#define CEPHV_J1Z1  14.6819706421238932572f      // first zero of J1, squared
+#define CEPHV_YZ1   0.43221455686510834878f
+#define CEPHV_YO1   4.66539330185668857532f
+#define CEPHV_EUL   0.57721566490153286061f
+#define CEPHV_LS2PI 0.91893853320467274178f      // log(sqrt(2 pi))
+#define CEPHV_S2PI  2.50662827463100050242f      // sqrt(2 pi)
+#define CEPHV_PI    3.14159265358979323846f
+#define CEPHV_IPI   0.31830988618379067154f
+#define CEPHV_TWOOPI 0.63661977236758134308f
+#define CEPHV_SQRTH 0.70710678118654752440f
+#define CEPHV_GMAX  35.0401f                     // gamma(x) = Inf above
+
+// Unary loops over any n.
+typedef void (*cephv_un_fn)(const float * __restrict,
+                            float * __restrict,
+                            const int64_t);
+
+// Integer-order loops.
+typedef void (*cephv_ord_fn)(const int32_t,
+                             const float * __restrict,
+                             float * __restrict,
+                             const int64_t);
+
+typedef void (*cephv_lg_fn)(const float * __restrict,
+                            float * __restrict,
+                            int32_t * __restrict,
+                            const int64_t);
+
+typedef struct {
+        cephv_un_fn  gamma;
+        cephv_un_fn  erf;
+        cephv_un_fn  erfc;
+        cephv_un_fn  j0;
+        cephv_un_fn  j1;
+        cephv_un_fn  y0;
+        cephv_un_fn  y1;
+        cephv_un_fn  i0;
+        cephv_un_fn  i0e;
+        cephv_un_fn  i1;
+        cephv_un_fn  i1e;
+        cephv_un_fn  k0;
+        cephv_un_fn  k0e;
+        cephv_un_fn  k1;
+        cephv_un_fn  k1e;
+        cephv_lg_fn  lgamma;
+        cephv_ord_fn jn;
+        cephv_ord_fn yn;
+        cephv_ord_fn kn;
+} cephv_isa_tab_t;
+
+extern const cephv_isa_tab_t cephv_tab_avx512;
+
+
+
+
+#endif /*__GMS_CEPHES_VEC_PRIVATE_H__*/
@@ -0,0 +1,754 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_cfar.h"
+#include "GMS_cfar_private.h"
+#include "GMS_vmath.h"
+
+//
+// Scale factors, plans, row drivers and threading of the CFAR detectors;
+// the one-lane kernels; validation and benchmark.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+
+
+/*
+     One-lane instantiation of the kernels (fallback of the drivers).
+*/
+typedef float  vf;
+typedef double vd;
+
+#define VF_W 1
+#define VD_W 1
+
+#define CK_PRIM static inline __attribute__((always_inline))
+
+CK_PRIM vf vf_c(const float c)                   { return (c); }
+CK_PRIM vf vf_load(const float * __restrict p)   { return (*p); }
+CK_PRIM void vf_store(float * __restrict p, const vf x) { *p = x; }
+CK_PRIM vf vf_add(const vf a, const vf b)        { return (a+b); }
+CK_PRIM vf vf_mul(const vf a, const vf b)        { return (a*b); }
+CK_PRIM vf vf_min(const vf a, const vf b)        { return ((b < a) ? b : a); }
+CK_PRIM vf vf_max(const vf a, const vf b)        { return ((b > a) ? b : a); }
+CK_PRIM uint32_t vf_gtbits(const vf a, const vf b) { return ((uint32_t)(a > b)); }
+CK_PRIM vd vd_c(const double c)                  { return (c); }
+CK_PRIM vd vd_load(const double * __restrict p)  { return (*p); }
+CK_PRIM void vd_store(double * __restrict p, const vd x) { *p = x; }
+CK_PRIM vd vd_add(const vd a, const vd b)        { return (a+b); }
+CK_PRIM vd vd_sub(const vd a, const vd b)        { return (a-b); }
+CK_PRIM vd vd_mul(const vd a, const vd b)        { return (a*b); }
+CK_PRIM vd vd_min(const vd a, const vd b)        { return ((b < a) ? b : a); }
+CK_PRIM vd vd_max(const vd a, const vd b)        { return ((b > a) ? b : a); }
+CK_PRIM vd vd_cvt(const float * __restrict p)    { return ((double)*p); }
+CK_PRIM void vd_storef(float * __restrict p, const vd x) { *p = (float)x; }
+CK_PRIM vd vd_scan(const vd x)                   { return (x); }
+CK_PRIM vd vd_last(const vd x)                   { return (x); }
+typedef int32_t vi;
+CK_PRIM vi vi_c(const int32_t c)                 { return (c); }
+CK_PRIM vi vi_load(const int32_t * __restrict p) { return (*p); }
+CK_PRIM void vi_store(int32_t * __restrict p, const vi x) { *p = x; }
+CK_PRIM vi vi_or(const vi a, const vi b)         { return (a | b); }
+CK_PRIM vi vi_xor(const vi a, const vi b)        { return (a ^ b); }
+CK_PRIM vi vi_cntlt(const vi n, const vi a, const vi b) { return (n+(a < b)); }
+CK_PRIM vi vi_sel_lt(const vi a, const vi b, const vi x, const vi y) { return ((a < b) ? x : y); }
+// Order-preserving key of a float (an involution on the bits).
+CK_PRIM vi vi_key(const vf x) {
+        int32_t s;
+        memcpy(&s,&x,sizeof(s));
+        return (s ^ ((s >> 31) & 0x7FFFFFFF));
+}
+CK_PRIM vf vi_float(const vi s) {
+        const int32_t u = s ^ ((s >> 31) & 0x7FFFFFFF);
+        float x;
+        memcpy(&x,&u,sizeof(x));
+        return (x);
+}
+
+#include "GMS_cfar_kernels.h"
+
+const cfar_isa_tab_t cfar_tab_scalar = {
+        ck_vsum,
+        ck_pfx,
+        ck_sthr,
+        ck_osthr,
+        ck_mask,
+        VF_W
+};
+
+static const cfar_isa_tab_t * cf_tab(void) {
+
+         switch(vmath_get_isa()) {
+         case VMATH_ISA_AVX512: return (&cfar_tab_avx512);
+         case VMATH_ISA_AVX2:   return (&cfar_tab_avx2);
+         default:               return (&cfar_tab_scalar);
+         }
+}
+
+// Float rows of the work space are padded by a whole zmm.
+#define CF_PADW(n) ((int64_t)(n)+16)
+
+
+/*
+     Scale factors
+*/
+
+// Pfa of SO-CFAR with n cells per half at the scale a:
+// 2 (2+a)^-n sum_{j<n} C(n-1+j,j) (2+a)^-j, summed in logs.
+static double cf_pfa_so(const int32_t n,
+                        const double a) {
+
+         const double l2a = log(2.0+a);
+         const double lgn = lgamma((double)n);
+         double s = 0.0;
+         int32_t j;
+         for(j = 0; j != n; ++j)
+             s += exp(lgamma((double)(n+j))-lgamma((double)(j+1))-lgn-(double)(n+j)*l2a);
+         return (2.0*s);
+}
+
+static double cf_pfa(const int32_t type,
+                     const int32_t n,
+                     const int32_t k,
+                     const double a) {
+
+         double s = 0.0;
+         int32_t i;
+         switch(type) {
+         case CFAR_GO:
+              return (2.0*pow(1.0+a,-(double)n)-cf_pfa_so(n,a));
+         case CFAR_SO:
+              return (cf_pfa_so(n,a));
+         case CFAR_OS:
+              // prod_{i<k} (n-i)/(n-i+a)
+              for(i = 0; i != k; ++i) s += log((double)(n-i))-log((double)(n-i)+a);
+              return (exp(s));
+         default:
+              return (pow(1.0+a,-(double)n));
+         }
+}
+
+double cfar_scale(const int32_t type,
+                  const int32_t n,
+                  const int32_t k,
+                  const double pfa) {
+
+         double lo = 0.0,hi = 1.0;
+         int32_t it;
+         if(__builtin_expect(n<1 || !(pfa > 0.0 && pfa < 1.0),0)) return (-1.0);
+         if(__builtin_expect(type == CFAR_OS && (k<1 || k>n),0)) return (-1.0);
+         if(type == CFAR_CA) return (pow(pfa,-1.0/(double)n)-1.0);
+         // Pfa falls with the scale: bracket, then bisect.
+         while(cf_pfa(type,n,k,hi) > pfa && hi < 1.0e30) hi *= 2.0;
+         for(it = 0; it != 200 && hi-lo > 1.0e-14*hi; ++it) {
+             const double m = 0.5*(lo+hi);
+             if(cf_pfa(type,n,k,m) > pfa) lo = m;
+             else                         hi = m;
+         }
+         return (0.5*(lo+hi));
+}
+
+
+/*
+     Plan
+*/
+
+// Training rows [ta0,ta1) and [tb0,tb1) and guard rows [g0,g1) of row r.
+typedef struct {
+        int32_t ta0,ta1,tb0,tb1,g0,g1;
+} cf_rows_t;
+
+static cf_rows_t cf_rows(const cfar_plan_t * __restrict p,
+                         const int32_t r) {
+
+         const int32_t ro = p->gr+p->tr;
+         cf_rows_t w;
+         w.ta0 = (r-ro > 0) ? r-ro : 0;
+         w.ta1 = (r-p->gr > 0) ? r-p->gr : 0;
+         w.g0  = w.ta1;
+         w.g1  = (r+p->gr+1 < p->nrow) ? r+p->gr+1 : p->nrow;
+         w.tb0 = w.g1;
+         w.tb1 = (r+ro+1 < p->nrow) ? r+ro+1 : p->nrow;
+         return (w);
+}
+
+// Clipped window of column c: outer columns [e0,e1), guard columns [h0,h1).
+#define CF_COLS(p,c,e0,e1,h0,h1)                                                 \
+         const int32_t e0 = ((c)-(p)->gc-(p)->tc > 0) ? (c)-(p)->gc-(p)->tc : 0;  \
+         const int32_t e1 = ((c)+(p)->gc+(p)->tc+1 < (p)->ncol) ?                 \
+                            (c)+(p)->gc+(p)->tc+1 : (p)->ncol;                    \
+         const int32_t h0 = ((c)-(p)->gc > 0) ? (c)-(p)->gc : 0;                  \
+         const int32_t h1 = ((c)+(p)->gc+1 < (p)->ncol) ? (c)+(p)->gc+1 : (p)->ncol
+
+// Training cells of the (clipped) window of (r,c).
+static int32_t cf_count(const cfar_plan_t * __restrict p,
+                        const int32_t r,
+                        const int32_t c) {
+
+         const cf_rows_t w = cf_rows(p,r);
+         CF_COLS(p,c,e0,e1,h0,h1);
+         return ((w.ta1-w.ta0+w.tb1-w.tb0)*(e1-e0)+(w.g1-w.g0)*((h0-e0)+(e1-h1)));
+}
+
+static void cf_scale_at(cfar_plan_t * __restrict p,
+                        const int32_t r,
+                        const int32_t c) {
+
+         const int32_t co = p->gc+p->tc;
+         int32_t n;
+         if(p->type == CFAR_CA) return;
+         if(p->type == CFAR_OS) {
+            n = cf_count(p,r,c);
+            if(n > 0 && p->kos[n] == 0) {
+               int32_t k = (int32_t)(((int64_t)p->k*n+p->ntr/2)/p->ntr);
+               k = (k < 1) ? 1 : ((k > n) ? n : k);
+               p->kos[n]   = k;
+               p->scale[n] = (float)cfar_scale(CFAR_OS,n,k,(double)p->pfa);
+            }
+         } else if(c >= co && c < p->ncol-co) {
+            // GO, SO: the whole columns of the halves; border columns are CA.
+            const cf_rows_t w = cf_rows(p,r);
+            n = (w.ta1-w.ta0+w.tb1-w.tb0)*co+(w.g1-w.g0)*p->tc;
+            if(n > 0 && p->kos[n] == 0) {
+               p->kos[n]   = 1;
+               p->scale[n] = (float)cfar_scale(p->type,n,0,(double)p->pfa);
+            }
+         }
+}
+
+static void * cf_alloc(const int64_t n) {
+
+         void * __restrict p = _mm_malloc((size_t)(n > 0 ? n : 1),64);
+         if(NULL != p) memset(p,0,(size_t)(n > 0 ? n : 1));
+         return (p);
+}
+
+int32_t cfar_init(cfar_plan_t * __restrict p,
+                  const int32_t type,
+                  const int32_t nrow,
+                  const int32_t ncol,
+                  const int32_t gr,
+                  const int32_t gc,
+                  const int32_t tr,
+                  const int32_t tc,
+                  const int32_t k,
+                  const float pfa) {
+
+         int64_t ntr;
+         int32_t ro,co,r,c,n;
+         if(__builtin_expect(NULL==p,0)) return (-1);
+         memset(p,0,sizeof(*p));
+         if(__builtin_expect(type<CFAR_CA || type>CFAR_OS || nrow<1 || ncol<1,0)) return (-1);
+         if(__builtin_expect(gr<0 || gc<0 || tr<0 || tc<0 || !(pfa > 0.0f && pfa < 1.0f),0)) return (-1);
+         if(__builtin_expect((type == CFAR_GO || type == CFAR_SO) && tc<1,0)) return (-1);
+         ro  = gr+tr;
+         co  = gc+tc;
+         ntr = (int64_t)(2*ro+1)*(2*co+1)-(int64_t)(2*gr+1)*(2*gc+1);
+         if(__builtin_expect(ntr<1 || ntr>CFAR_MAXTRAIN,0)) return (-1);
+         if(__builtin_expect(type == CFAR_OS && (k<0 || k>ntr),0)) return (-1);
+         p->type = type;
+         p->nrow = nrow;
+         p->ncol = ncol;
+         p->gr   = gr;
+         p->gc   = gc;
+         p->tr   = tr;
+         p->tc   = tc;
+         p->ntr  = (int32_t)ntr;
+         p->k    = (k != 0) ? k : ((3*p->ntr/4 > 0) ? 3*p->ntr/4 : 1);
+         p->pfa  = pfa;
+         p->nthr = 1;
+#if defined(_OPENMP)
+         p->nthr = omp_get_max_threads();
+#endif
+         // Floats: training and guard column sums, thresholds, OS window
+         // values; doubles: two prefix sums.
+         p->wfs   = 3*CF_PADW(ncol)+ntr;
+         p->wds   = 2*((int64_t)ncol+8);
+         p->scale = (float*)cf_alloc((ntr+1)*(int64_t)sizeof(float));
+         p->beta  = (float*)cf_alloc((ntr+1)*(int64_t)sizeof(float));
+         p->kos   = (int32_t*)cf_alloc((ntr+1)*(int64_t)sizeof(int32_t));
+         p->wf    = (float*)cf_alloc(p->nthr*p->wfs*(int64_t)sizeof(float));
+         p->wd    = (double*)cf_alloc(p->nthr*p->wds*(int64_t)sizeof(double));
+         p->wo    = (int64_t*)cf_alloc(p->nthr*ntr*(int64_t)sizeof(int64_t));
+         p->wi    = (int32_t*)cf_alloc(p->nthr*ntr*16*(int64_t)sizeof(int32_t));
+         if(__builtin_expect(NULL==p->scale || NULL==p->beta || NULL==p->kos || NULL==p->wf ||
+                             NULL==p->wd || NULL==p->wo || NULL==p->wi,0)) {
+            cfar_free(p);
+            return (-2);
+         }
+         for(n = 1; n <= p->ntr; ++n) p->beta[n] = (float)cfar_scale(CFAR_CA,n,0,(double)pfa);
+         if(type == CFAR_CA) {
+            memcpy(p->scale,p->beta,(size_t)(ntr+1)*sizeof(float));
+            return (0);
+         }
+         // GO, SO and OS factors of the cell counts the map can produce:
+         // every clipped row state times every clipped column state.
+         for(r = 0; r < nrow; ++r) {
+             if(r > ro && r < nrow-1-ro) r = nrow-1-ro;
+             for(c = 0; c < ncol; ++c) {
+                 if(c > co && c < ncol-1-co) c = ncol-1-co;
+                 cf_scale_at(p,r,c);
+             }
+         }
+         return (0);
+}
+
+void cfar_free(cfar_plan_t * __restrict p) {
+
+         if(NULL==p) return;
+         if(NULL != p->scale) _mm_free(p->scale);
+         if(NULL != p->beta)  _mm_free(p->beta);
+         if(NULL != p->kos)   _mm_free(p->kos);
+         if(NULL != p->wf)    _mm_free(p->wf);
+         if(NULL != p->wd)    _mm_free(p->wd);
+         if(NULL != p->wo)    _mm_free(p->wo);
+         if(NULL != p->wi)    _mm_free(p->wi);
+         p->scale = p->beta = p->wf = NULL;
+         p->kos = p->wi = NULL;
+         p->wd  = NULL;
+         p->wo  = NULL;
+}
+
+
+/*
+     Rows
+*/
+
+// k-th smallest (0-based) of v[0..n), v reordered (Hoare selection).
+static float cf_select(float * __restrict v,
+                       const int32_t n,
+                       const int32_t k) {
+
+         int32_t lo = 0,hi = n-1;
+         while(lo < hi) {
+             const float x = v[lo+(hi-lo)/2];
+             int32_t i = lo,j = hi;
+             while(i <= j) {
+                 while(v[i] < x) ++i;
+                 while(v[j] > x) --j;
+                 if(i <= j) {
+                    const float t = v[i];
+                    v[i] = v[j];
+                    v[j] = t;
+                    ++i;
+                    --j;
+                 }
+             }
+             if(k <= j)      hi = j;
+             else if(k >= i) lo = i;
+             else            break;
+         }
+         return (v[k]);
+}
+
+// OS threshold of one cell with its clipped window.
+static float cf_os_cell(const cfar_plan_t * __restrict p,
+                        const float * __restrict map,
+                        const int64_t ldm,
+                        const int32_t r,
+                        const int32_t c,
+                        float * __restrict v) {
+
+         const cf_rows_t w = cf_rows(p,r);
+         int32_t n = 0,i,j;
+         CF_COLS(p,c,e0,e1,h0,h1);
+         for(i = w.ta0; i != w.tb1; ++i) {
+             const float * __restrict m = map+i*ldm;
+             if(i >= w.g0 && i < w.g1) {
+                for(j = e0; j != h0; ++j) v[n++] = m[j];
+                for(j = h1; j != e1; ++j) v[n++] = m[j];
+             } else {
+                for(j = e0; j != e1; ++j) v[n++] = m[j];
+             }
+         }
+         if(n == 0) return (HUGE_VALF);
+         return (p->scale[n]*cf_select(v,n,p->kos[n]-1));
+}
+
+static int64_t cf_row(const cfar_plan_t * __restrict p,
+                      const cfar_isa_tab_t * __restrict t,
+                      const float * __restrict map,
+                      const int64_t ldm,
+                      const int32_t r,
+                      uint64_t * __restrict d,
+                      float * __restrict thr,
+                      float * __restrict wf,
+                      double * __restrict wd,
+                      int64_t * __restrict wo,
+                      int32_t * __restrict wi) {
+
+         const int32_t ncol = p->ncol;
+         const int32_t co   = p->gc+p->tc;
+         const cf_rows_t w  = cf_rows(p,r);
+         const int32_t nt   = w.ta1-w.ta0+w.tb1-w.tb0;
+         const int32_t ng   = w.g1-w.g0;
+         int32_t c0 = co,c1 = ncol-co,c;
+         if(c1 <= c0) c0 = c1 = ncol;           // no whole window in the row
+         if(p->type != CFAR_OS) {
+            float  * __restrict vt = wf;
+            float  * __restrict vg = wf+CF_PADW(ncol);
+            double * __restrict pt = wd;
+            double * __restrict pg = wd+ncol+8;
+            if(p->tr > 0) {
+               t->vsum(map,ldm,w.ta0,w.ta1,w.tb0,w.tb1,ncol,vt);
+               t->pfx(vt,ncol,pt);
+            }
+            t->vsum(map,ldm,w.g0,w.g1,0,0,ncol,vg);
+            t->pfx(vg,ncol,pg);
+            if(c1 > c0) {
+               const int32_t n = (p->type == CFAR_CA) ? nt*(2*co+1)+ng*2*p->tc : nt*co+ng*p->tc;
+               if(n > 0) t->sthr(p->type,pt,pg,co,p->gc,c0,c1,(double)p->scale[n],thr);
+               else      for(c = c0; c != c1; ++c) thr[c] = HUGE_VALF;
+            }
+            // Border columns: CA over the clipped window.
+            for(c = 0; c != ncol; ++c) {
+                if(c == c0) c = c1;
+                if(c == ncol) break;
+                {
+                   CF_COLS(p,c,e0,e1,h0,h1);
+                   const int32_t n = nt*(e1-e0)+ng*((h0-e0)+(e1-h1));
+                   const double  s = (pt[e1]-pt[e0])+(pg[h0]-pg[e0])+(pg[e1]-pg[h1]);
+                   thr[c] = (n > 0) ? (float)((double)p->beta[n]*s) : HUGE_VALF;
+                }
+            }
+         } else {
+            float * __restrict v = wf+3*CF_PADW(ncol);
+            int32_t n = 0,i,j,ce = c0;
+            for(i = w.ta0; i != w.tb1; ++i) {
+                const int64_t dr = (int64_t)(i-r)*ldm;
+                for(j = -co; j <= co; ++j) {
+                    if(i >= w.g0 && i < w.g1 && j >= -p->gc && j <= p->gc) continue;
+                    wo[n++] = dr+j;
+                }
+            }
+            if(c1 > c0 && n > 0) ce = t->osthr(map+r*ldm,wo,n,p->kos[n],p->scale[n],c0,c1,wi,thr);
+            for(c = 0; c != ncol; ++c) {
+                if(c == c0) c = ce;
+                if(c == ncol) break;
+                thr[c] = cf_os_cell(p,map,ldm,r,c,v);
+            }
+         }
+         return (t->mask(map+r*ldm,thr,ncol,d));
+}
+
+int32_t cfar_run(const cfar_plan_t * __restrict p,
+                 const float * __restrict map,
+                 const int64_t ldm,
+                 uint64_t * __restrict det,
+                 float * __restrict thr,
+                 int64_t * __restrict ndet) {
+
+         const cfar_isa_tab_t * __restrict t = cf_tab();
+         int64_t nd = 0;
+         int32_t r,par;
+         if(__builtin_expect(NULL==p || NULL==p->wf || NULL==map || NULL==det,0)) return (-1);
+         if(__builtin_expect(ldm<p->ncol,0)) return (-1);
+         par = (p->nrow >= 2*CFAR_OMP_MIN && p->nthr > 1);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(p->nthr) if(par) default(none) \
+        shared(p,t,map,det,thr) firstprivate(ldm) reduction(+:nd)
+#endif
+         for(r = 0; r < p->nrow; ++r) {
+             const int64_t nw = ((int64_t)p->ncol+63)/64;
+             int32_t tid = 0;
+             float * __restrict wf;
+#if defined(_OPENMP)
+             tid = omp_get_thread_num();
+#endif
+             wf  = p->wf+tid*p->wfs;
+             nd += cf_row(p,t,map,ldm,r,det+r*nw,
+                          (NULL != thr) ? thr+r*ldm : wf+2*CF_PADW(p->ncol),
+                          wf,p->wd+tid*p->wds,p->wo+(int64_t)tid*p->ntr,
+                          p->wi+(int64_t)tid*16*p->ntr);
+         }
+         if(NULL != ndet) *ndet = nd;
+         return (0);
+}
+
+
+/*
+     Validation
+*/
+static uint64_t cf_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+// Unit-mean exponential sample (square-law detected Gaussian noise).
+static float cf_expo(uint64_t * __restrict s) {
+
+         const double u = (double)((cf_rng(s) >> 11)+1ULL) * 0x1.0p-53;
+         return ((float)(-log(u)));
+}
+
+typedef struct {
+        int32_t type,gr,gc,tr,tc,k;
+} cf_case_t;
+
+static const cf_case_t cf_cases[] = {
+        { CFAR_CA,0,2,0,16, 0 },
+        { CFAR_CA,1,2,2, 8, 0 },
+        { CFAR_GO,0,2,0,16, 0 },
+        { CFAR_GO,1,1,1, 6, 0 },
+        { CFAR_SO,0,3,0,12, 0 },
+        { CFAR_SO,2,2,1, 4, 0 },
+        { CFAR_OS,0,2,0,16, 0 },
+        { CFAR_OS,0,1,0, 4, 3 },
+        { CFAR_OS,1,2,2, 6, 0 },
+        { CFAR_OS,0,0,0,20,20 }
+};
+
+static const char * const cf_tname[4] = {"CA","GO","SO","OS"};
+
+#define CF_VROWS 37
+#define CF_VCOLS 203
+#define CF_VLD   211
+#define CF_VTOL  1.0e-5
+#define CF_PROWS 256
+#define CF_PCOLS 2048
+#define CF_PPFA  1.0e-3f
+
+static int32_t cf_cmp(const void * a,
+                      const void * b) {
+
+         const float x = *(const float*)a,y = *(const float*)b;
+         return ((x > y)-(x < y));
+}
+
+// Threshold of (r,c) from the cells of its window, in fp64.
+static double cf_ref(const cfar_plan_t * __restrict p,
+                     const float * __restrict map,
+                     const int64_t ldm,
+                     const int32_t r,
+                     const int32_t c,
+                     float * __restrict v) {
+
+         const int32_t ro = p->gr+p->tr,co = p->gc+p->tc;
+         double s = 0.0,sl = 0.0,sr = 0.0;
+         int32_t n = 0,nl = 0,nr = 0,i,j;
+         for(i = r-ro; i <= r+ro; ++i) {
+             if(i < 0 || i >= p->nrow) continue;
+             for(j = c-co; j <= c+co; ++j) {
+                 double x;
+                 if(j < 0 || j >= p->ncol) continue;
+                 if(abs(i-r) <= p->gr && abs(j-c) <= p->gc) continue;
+                 x = (double)map[i*ldm+j];
+                 v[n++] = map[i*ldm+j];
+                 s += x;
+                 if(j < c) { sl += x; ++nl; }
+                 if(j > c) { sr += x; ++nr; }
+             }
+         }
+         if(n == 0) return (HUGE_VAL);
+         switch(p->type) {
+         case CFAR_OS:
+              qsort(v,(size_t)n,sizeof(float),cf_cmp);
+              return ((double)p->scale[n]*(double)v[p->kos[n]-1]);
+         case CFAR_GO:
+         case CFAR_SO:
+              if(c-co >= 0 && c+co < p->ncol && nl == nr)
+                 return ((double)p->scale[nl]*((p->type == CFAR_GO) ? fmax(sl,sr) : fmin(sl,sr)));
+              return ((double)p->beta[n]*s);
+         default:
+              return ((double)p->beta[n]*s);
+         }
+}
+
+int32_t cfar_validate(FILE * __restrict fp,
+                      const uint64_t seed) {
+
+         const int32_t ncase = (int32_t)(sizeof(cf_cases)/sizeof(cf_cases[0]));
+         const int32_t isa0  = vmath_get_isa();
+         const int64_t nmap  = (int64_t)CF_PROWS*CF_PCOLS;
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float    *map = NULL,*thr = NULL,*v = NULL,*pm = NULL;
+         double   *rt  = NULL;
+         uint64_t *det = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t cs,isa,i;
+         if(NULL==fp) return (-1);
+         map = (float*)malloc((size_t)(CF_VROWS*CF_VLD)*sizeof(float));
+         thr = (float*)malloc((size_t)nmap*sizeof(float));
+         v   = (float*)malloc((size_t)CFAR_MAXTRAIN*sizeof(float));
+         pm  = (float*)malloc((size_t)nmap*sizeof(float));
+         rt  = (double*)malloc((size_t)(CF_VROWS*CF_VCOLS)*sizeof(double));
+         det = (uint64_t*)malloc((size_t)(CF_PROWS*(CF_PCOLS/64))*sizeof(uint64_t));
+         if(NULL==map || NULL==thr || NULL==v || NULL==pm || NULL==rt || NULL==det) {
+            nbad = -1;
+            goto done;
+         }
+         for(i = 0; i != CF_VROWS*CF_VLD; ++i) map[i] = cf_expo(&s);
+         // Strong point targets (+40 dB) against the prefix sums.
+         for(i = 0; i != 12; ++i)
+             map[(cf_rng(&s)%CF_VROWS)*CF_VLD+cf_rng(&s)%CF_VCOLS] = 1.0e4f*cf_expo(&s);
+         for(i = 0; i != (int32_t)nmap; ++i) pm[i] = cf_expo(&s);
+         fprintf(fp,"CFAR thresholds and masks vs fp64 windows (%dx%d, tol %.1e), "
+                    "false alarm rate on %dx%d noise at Pfa %.1e\n",
+                 CF_VROWS,CF_VCOLS,CF_VTOL,CF_PROWS,CF_PCOLS,(double)CF_PPFA);
+         for(cs = 0; cs != ncase; ++cs) {
+             const cf_case_t * __restrict q = &cf_cases[cs];
+             cfar_plan_t p,pp;
+             int32_t r,c;
+             if(cfar_init(&p,q->type,CF_VROWS,CF_VCOLS,q->gr,q->gc,q->tr,q->tc,q->k,1.0e-4f) ||
+                cfar_init(&pp,q->type,CF_PROWS,CF_PCOLS,q->gr,q->gc,q->tr,q->tc,q->k,CF_PPFA)) {
+                cfar_free(&p);
+                ++nbad;
+                continue;
+             }
+             for(r = 0; r != CF_VROWS; ++r)
+                 for(c = 0; c != CF_VCOLS; ++c)
+                     rt[r*CF_VCOLS+c] = cf_ref(&p,map,CF_VLD,r,c,v);
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 const int64_t nw = (CF_VCOLS+63)/64;
+                 double e = 0.0,fa;
+                 int64_t nd = 0,nd1,nb = 0,nm = 0;
+                 int32_t bad;
+                 if(vmath_set_isa(isa)) continue;
+                 cfar_run(&p,map,CF_VLD,det,thr,&nd);
+                 nd1 = nd;
+                 for(r = 0; r != CF_VROWS; ++r) {
+                     for(c = 0; c != CF_VCOLS; ++c) {
+                         const double t = rt[r*CF_VCOLS+c];
+                         const double x = (double)map[r*CF_VLD+c];
+                         const int32_t b = (int32_t)((det[r*nw+c/64] >> (c%64)) & 1ULL);
+                         if(isinf(t)) {
+                            if(!isinf(thr[r*CF_VLD+c])) e = fmax(e,1.0);
+                         } else {
+                            e = fmax(e,fabs((double)thr[r*CF_VLD+c]-t)/t);
+                         }
+                         nb += b;
+                         // Disagreement only within the tolerance of the threshold.
+                         if(b != (x > t) && fabs(x-t) > CF_VTOL*t) ++nm;
+                     }
+                 }
+                 cfar_run(&pp,pm,CF_PCOLS,det,NULL,&nd);
+                 fa  = (double)nd/((double)nmap*(double)CF_PPFA);
+                 bad = (e > CF_VTOL || nm != 0 || nb != nd1 || fa < 0.8 || fa > 1.25);
+                 nbad += bad;
+                 fprintf(fp,"  %s g=%d,%d t=%d,%d k=%3d n=%3d %-7s thr err %.2e, %lld mask errors,"
+                            " Pfa measured/set %.3f%s\n",
+                         cf_tname[q->type],q->gr,q->gc,q->tr,q->tc,(q->type == CFAR_OS) ? p.k : 0,
+                         p.ntr,isan[isa],e,(long long)nm,fa,bad ? "  FAIL" : "");
+             }
+             cfar_free(&p);
+             cfar_free(&pp);
+         }
+         vmath_set_isa(isa0);
+done:
+         free(map);
+         free(thr);
+         free(v);
+         free(pm);
+         free(rt);
+         free(det);
+         return (nbad);
+}
+
+
+/*
+     Benchmark
+*/
+static double cf_wtime(void) {
+
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+}
+
+typedef struct {
+        const char * name;
+        cf_case_t    q;
+} cf_bench_case_t;
+
+static const cf_bench_case_t cf_bench_cases[] = {
+        { "CA 1d g2 t16",        { CFAR_CA,0,2,0,16,0 } },
+        { "GO 1d g2 t16",        { CFAR_GO,0,2,0,16,0 } },
+        { "SO 1d g2 t16",        { CFAR_SO,0,2,0,16,0 } },
+        { "CA 2d g1,2 t2,8",     { CFAR_CA,1,2,2, 8,0 } },
+        { "OS 1d g1 t4 k6",      { CFAR_OS,0,1,0, 4,6 } },
+        { "OS 1d g2 t16 k24",    { CFAR_OS,0,2,0,16,0 } },
+        { "OS 2d g1,1 t1,3 k27", { CFAR_OS,1,1,1, 3,0 } },
+        { "OS 2d g1,2 t2,6 k78", { CFAR_OS,1,2,2, 6,0 } }
+};
+
+// Seconds per map (best of nrep after a warm-up).
+static double cf_bench_one(const cf_case_t * __restrict q,
+                           const float * __restrict map,
+                           uint64_t * __restrict det,
+                           const int32_t nrow,
+                           const int32_t ncol,
+                           const int32_t nrep) {
+
+         cfar_plan_t p;
+         double best = 1.0e30;
+         int64_t nd;
+         int32_t r;
+         if(cfar_init(&p,q->type,nrow,ncol,q->gr,q->gc,q->tr,q->tc,q->k,1.0e-6f)) return (-1.0);
+         cfar_run(&p,map,ncol,det,NULL,&nd);
+         for(r = 0; r != nrep; ++r) {
+             const double t0 = cf_wtime();
+             cfar_run(&p,map,ncol,det,NULL,&nd);
+             best = fmin(best,cf_wtime()-t0);
+         }
+         cfar_free(&p);
+         return (best);
+}
+
+void cfar_bench(FILE * __restrict fp,
+                const int32_t nrow,
+                const int32_t ncol,
+                const int32_t nrep) {
+
+         const int32_t ncase = (int32_t)(sizeof(cf_bench_cases)/sizeof(cf_bench_cases[0]));
+         const int32_t isa0  = vmath_get_isa();
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float    *map = NULL;
+         uint64_t *det = NULL;
+         uint64_t s = 0x5EED5EEDULL;
+         int32_t nthr = 1;
+         int32_t cs,isa;
+         int64_t i;
+         if(NULL==fp) fp = stdout;
+         if(__builtin_expect(nrow<1 || ncol<1 || nrep<1,0)) return;
+#if defined(_OPENMP)
+         nthr = omp_get_max_threads();
+#endif
+         map = (float*)_mm_malloc((size_t)nrow*(size_t)ncol*sizeof(float),64);
+         det = (uint64_t*)malloc((size_t)nrow*(size_t)((ncol+63)/64)*sizeof(uint64_t));
+         if(NULL==map || NULL==det) goto done;
+         for(i = 0; i != (int64_t)nrow*ncol; ++i) map[i] = cf_expo(&s);
+         fprintf(fp,"# %d x %d map, Mcells/s, best of %d\n",nrow,ncol,nrep);
+         fprintf(fp,"# %-20s %-7s %12s %12s\n","case","isa","1 thread","threads");
+         for(cs = 0; cs != ncase; ++cs) {
+             const cf_bench_case_t * __restrict b = &cf_bench_cases[cs];
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 const double mc = (double)nrow*(double)ncol*1.0e-6;
+                 double t1,tn;
+                 if(vmath_set_isa(isa)) continue;
+#if defined(_OPENMP)
+                 omp_set_num_threads(1);
+#endif
+                 t1 = cf_bench_one(&b->q,map,det,nrow,ncol,nrep);
+#if defined(_OPENMP)
+                 omp_set_num_threads(nthr);
+#endif
+                 tn = cf_bench_one(&b->q,map,det,nrow,ncol,nrep);
+                 fprintf(fp,"  %-20s %-7s %12.1f %12.1f\n",b->name,isan[isa],mc/t1,mc/tn);
+             }
+         }
+         vmath_set_isa(isa0);
+done:
+         if(NULL != map) _mm_free(map);
+         free(det);
+}
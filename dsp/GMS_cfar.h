@@ -0,0 +1,132 @@
+
+
+#ifndef __GMS_CFAR_H__
+#define __GMS_CFAR_H__ 191020260600
+
+//
+// Constant false alarm rate detectors over 2D range-Doppler maps: cell
+// averaging (CA), greatest-of (GO), smallest-of (SO) and ordered
+// statistic (OS) CFAR with rectangular guard and training windows,
+// bit-packed detection masks, SIMD (AVX2/AVX512) kernels and threading
+// over rows.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+// The map is nrow x ncol (rows: Doppler, columns: range, row-major with
+// leading dimension ldm). The window of the cell under test (CUT) spans
+// rows r-gr-tr..r+gr+tr and columns c-gc-tc..c+gc+tc; the guard block
+// rows r-gr..r+gr, columns c-gc..c+gc (with the CUT) is left out. tr = 0
+// or gr = tr = 0 gives the 1D range window.
+//  CA: T = beta(n) * (sum of the n training cells).
+//  GO, SO: T = alpha(n) * max (min) of the sums of the n training cells
+//      left and right of the CUT column (the column of the CUT itself
+//      does not enter); needs tc >= 1.
+//  OS: T = alpha(n,k) * (k-th smallest training cell).
+// The scale factors are solved at plan time for exponential (square-law)
+// noise cells at the requested Pfa. Cells near the map border get the
+// clipped window and the factors of its cell count (OS: k scaled to the
+// count); in the border columns GO and SO fall back to CA.
+// CA, GO and SO run on column sums of the training and guard rows and
+// sliding prefix sums in fp64 (no cancellation against strong targets).
+// OS selects the k-th smallest of each window for SIMD-width runs of
+// cells at once: up to 16 extreme values per lane are kept in registers
+// by a sorted min/max insertion chain (min(k, n-k+1) <= 16), larger
+// ranks use a radix search on integer keys of the cells.
+// Detection masks hold (ncol+63)/64 words per row, bit c%64 of word c/64
+// set for a detection at column c.
+// The ISA is the one of vmath_get_isa() (GMS_vmath.h).
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+#define CFAR_CA 0
+#define CFAR_GO 1
+#define CFAR_SO 2
+#define CFAR_OS 3
+
+// Largest training window (cells).
+#if !defined(CFAR_MAXTRAIN)
+#define CFAR_MAXTRAIN 1024
+#endif
+
+// Rows per thread before cfar_run goes parallel.
+#if !defined(CFAR_OMP_MIN)
+#define CFAR_OMP_MIN 8
+#endif
+
+
+typedef struct {
+        float   * __restrict scale;   // by training cell count: CA beta, GO/SO alpha of a half, OS alpha
+        float   * __restrict beta;    // CA beta by count (border columns of GO/SO)
+        int32_t * __restrict kos;     // OS rank by count
+        float   * __restrict wf;      // per-thread float work, wfs each
+        double  * __restrict wd;      // per-thread prefix sums, wds each
+        int64_t * __restrict wo;      // per-thread OS window offsets, ntr each
+        int32_t * __restrict wi;      // per-thread OS keys, 16*ntr each
+        int64_t  wfs;
+        int64_t  wds;
+        int32_t  type;
+        int32_t  nrow;
+        int32_t  ncol;
+        int32_t  gr,gc;               // guard half-widths (rows, columns)
+        int32_t  tr,tc;               // training depth beyond the guard
+        int32_t  k;                   // OS rank of the full window
+        int32_t  ntr;                 // training cells of the full window
+        int32_t  nthr;
+        float    pfa;
+        int32_t  pad;
+} cfar_plan_t;
+
+
+// k (OS only) is the rank in the full window, 1 <= k <= ntr; k = 0 selects
+// 3*ntr/4.
+int32_t cfar_init(cfar_plan_t * __restrict,
+                  const int32_t,        // type
+                  const int32_t,        // nrow
+                  const int32_t,        // ncol
+                  const int32_t,        // gr
+                  const int32_t,        // gc
+                  const int32_t,        // tr
+                  const int32_t,        // tc
+                  const int32_t,        // k
+                  const float);         // pfa
+
+void    cfar_free(cfar_plan_t * __restrict);
+
+// Scale factor of a window of n cells (OS: rank k) at the false alarm
+// rate pfa for exponential cells (GO/SO: n cells per half).
+double  cfar_scale(const int32_t,       // type
+                   const int32_t,       // n
+                   const int32_t,       // k
+                   const double);       // pfa
+
+// Detection over the map (ld ldm >= ncol) into det (nrow rows of
+// (ncol+63)/64 words); thr (may be NULL, ld ldm) receives the thresholds,
+// *ndet (may be NULL) the number of detections.
+int32_t cfar_run(const cfar_plan_t * __restrict,
+                 const float * __restrict,     // map
+                 const int64_t,                // ldm
+                 uint64_t * __restrict,        // det
+                 float * __restrict,           // thr
+                 int64_t * __restrict)         // ndet
+                                        __attribute__((hot));
+
+// Thresholds and masks against an fp64 per-cell reference, and measured
+// false alarm rates on exponential noise, for every type and ISA the host
+// runs; returns the number of failures.
+int32_t cfar_validate(FILE * __restrict,
+                      const uint64_t);        // seed
+
+// Mcells/s of cfar_run for every type and ISA, one thread and all.
+void    cfar_bench(FILE * __restrict,
+                   const int32_t,             // nrow
+                   const int32_t,             // ncol
+                   const int32_t);            // nrep
+
+
+
+
+#endif /*__GMS_CFAR_H__*/
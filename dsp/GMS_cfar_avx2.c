@@ -0,0 +1,97 @@
+
+
+//
+// AVX2/FMA instantiation of the CFAR row kernels (GMS_cfar.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+// The unit carries its own target; GMS_cfar.c calls into it only when
+// vmath_get_isa() reports AVX2.
+//
+
+#pragma GCC target("avx2,fma")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_cfar_private.h"
+
+
+typedef __m256  vf;
+typedef __m256d vd;
+typedef __m256i vi;
+
+#define VF_W 8
+#define VD_W 4
+
+#define CK_PRIM static inline __attribute__((always_inline))
+
+
+CK_PRIM vf vf_c(const float c)                   { return _mm256_set1_ps(c); }
+CK_PRIM vf vf_load(const float * __restrict p)   { return _mm256_loadu_ps(p); }
+CK_PRIM void vf_store(float * __restrict p, const vf x) { _mm256_storeu_ps(p,x); }
+CK_PRIM vf vf_add(const vf a, const vf b)        { return _mm256_add_ps(a,b); }
+CK_PRIM vf vf_mul(const vf a, const vf b)        { return _mm256_mul_ps(a,b); }
+CK_PRIM vf vf_min(const vf a, const vf b)        { return _mm256_min_ps(a,b); }
+CK_PRIM vf vf_max(const vf a, const vf b)        { return _mm256_max_ps(a,b); }
+// Lane bits of a > b.
+CK_PRIM uint32_t vf_gtbits(const vf a, const vf b) {
+        return ((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a,b,_CMP_GT_OQ)));
+}
+
+CK_PRIM vd vd_c(const double c)                  { return _mm256_set1_pd(c); }
+CK_PRIM vd vd_load(const double * __restrict p)  { return _mm256_loadu_pd(p); }
+CK_PRIM void vd_store(double * __restrict p, const vd x) { _mm256_storeu_pd(p,x); }
+CK_PRIM vd vd_add(const vd a, const vd b)        { return _mm256_add_pd(a,b); }
+CK_PRIM vd vd_sub(const vd a, const vd b)        { return _mm256_sub_pd(a,b); }
+CK_PRIM vd vd_mul(const vd a, const vd b)        { return _mm256_mul_pd(a,b); }
+CK_PRIM vd vd_min(const vd a, const vd b)        { return _mm256_min_pd(a,b); }
+CK_PRIM vd vd_max(const vd a, const vd b)        { return _mm256_max_pd(a,b); }
+// VD_W floats widened, and narrowed back.
+CK_PRIM vd vd_cvt(const float * __restrict p)    { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+CK_PRIM void vd_storef(float * __restrict p, const vd x) { _mm_storeu_ps(p,_mm256_cvtpd_ps(x)); }
+// Inclusive prefix sum across the lanes (shifts by 1 and 2 lanes).
+CK_PRIM vd vd_scan(vd x) {
+        const vd t = _mm256_permute4x64_pd(x,_MM_SHUFFLE(2,1,0,3));
+        x = _mm256_add_pd(x,_mm256_blend_pd(t,_mm256_setzero_pd(),0x1));
+        x = _mm256_add_pd(x,_mm256_permute2f128_pd(x,x,0x08));
+        return (x);
+}
+// Last lane in every lane.
+CK_PRIM vd vd_last(const vd x)                   { return _mm256_permute4x64_pd(x,0xFF); }
+
+// VF_W int32: order-preserving keys of floats (an involution on the
+// bits), lane counts and selects for the OS radix search.
+CK_PRIM vi vi_c(const int32_t c)                 { return _mm256_set1_epi32(c); }
+CK_PRIM vi vi_load(const int32_t * __restrict p) { return _mm256_loadu_si256((const __m256i*)p); }
+CK_PRIM void vi_store(int32_t * __restrict p, const vi x) { _mm256_storeu_si256((__m256i*)p,x); }
+CK_PRIM vi vi_or(const vi a, const vi b)         { return _mm256_or_si256(a,b); }
+CK_PRIM vi vi_xor(const vi a, const vi b)        { return _mm256_xor_si256(a,b); }
+// n + (a < b) per lane (the compare is -1 where true).
+CK_PRIM vi vi_cntlt(const vi n, const vi a, const vi b) {
+        return _mm256_sub_epi32(n,_mm256_cmpgt_epi32(b,a));
+}
+// (a < b) ? x : y per lane.
+CK_PRIM vi vi_sel_lt(const vi a, const vi b, const vi x, const vi y) {
+        return _mm256_blendv_epi8(y,x,_mm256_cmpgt_epi32(b,a));
+}
+CK_PRIM vi vi_key(const vf x) {
+        const vi s = _mm256_castps_si256(x);
+        return _mm256_xor_si256(s,_mm256_and_si256(_mm256_srai_epi32(s,31),_mm256_set1_epi32(0x7FFFFFFF)));
+}
+CK_PRIM vf vi_float(const vi s) {
+        return _mm256_castsi256_ps(_mm256_xor_si256(s,_mm256_and_si256(_mm256_srai_epi32(s,31),
+                                                                      _mm256_set1_epi32(0x7FFFFFFF))));
+}
+
+
+#include "GMS_cfar_kernels.h"
+
+
+const cfar_isa_tab_t cfar_tab_avx2 = {
+        ck_vsum,
+        ck_pfx,
+        ck_sthr,
+        ck_osthr,
+        ck_mask,
+        VF_W
+};
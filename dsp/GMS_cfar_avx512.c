@@ -0,0 +1,98 @@
+
+
+//
+// AVX512F instantiation of the CFAR row kernels (GMS_cfar.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+// The unit carries its own target; GMS_cfar.c calls into it only when
+// vmath_get_isa() reports AVX512.
+//
+
+#pragma GCC target("avx512f")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_cfar_private.h"
+
+
+typedef __m512  vf;
+typedef __m512d vd;
+typedef __m512i vi;
+
+#define VF_W 16
+#define VD_W 8
+
+#define CK_PRIM static inline __attribute__((always_inline))
+
+
+CK_PRIM vf vf_c(const float c)                   { return _mm512_set1_ps(c); }
+CK_PRIM vf vf_load(const float * __restrict p)   { return _mm512_loadu_ps(p); }
+CK_PRIM void vf_store(float * __restrict p, const vf x) { _mm512_storeu_ps(p,x); }
+CK_PRIM vf vf_add(const vf a, const vf b)        { return _mm512_add_ps(a,b); }
+CK_PRIM vf vf_mul(const vf a, const vf b)        { return _mm512_mul_ps(a,b); }
+CK_PRIM vf vf_min(const vf a, const vf b)        { return _mm512_min_ps(a,b); }
+CK_PRIM vf vf_max(const vf a, const vf b)        { return _mm512_max_ps(a,b); }
+// Lane bits of a > b.
+CK_PRIM uint32_t vf_gtbits(const vf a, const vf b) {
+        return ((uint32_t)_mm512_cmp_ps_mask(a,b,_CMP_GT_OQ));
+}
+
+CK_PRIM vd vd_c(const double c)                  { return _mm512_set1_pd(c); }
+CK_PRIM vd vd_load(const double * __restrict p)  { return _mm512_loadu_pd(p); }
+CK_PRIM void vd_store(double * __restrict p, const vd x) { _mm512_storeu_pd(p,x); }
+CK_PRIM vd vd_add(const vd a, const vd b)        { return _mm512_add_pd(a,b); }
+CK_PRIM vd vd_sub(const vd a, const vd b)        { return _mm512_sub_pd(a,b); }
+CK_PRIM vd vd_mul(const vd a, const vd b)        { return _mm512_mul_pd(a,b); }
+CK_PRIM vd vd_min(const vd a, const vd b)        { return _mm512_min_pd(a,b); }
+CK_PRIM vd vd_max(const vd a, const vd b)        { return _mm512_max_pd(a,b); }
+// VD_W floats widened, and narrowed back.
+CK_PRIM vd vd_cvt(const float * __restrict p)    { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+CK_PRIM void vd_storef(float * __restrict p, const vd x) { _mm256_storeu_ps(p,_mm512_cvtpd_ps(x)); }
+// Inclusive prefix sum across the lanes (shifts by 1, 2, 4 lanes).
+CK_PRIM vd vd_scan(vd x) {
+        const __m512i z = _mm512_setzero_si512();
+        x = _mm512_add_pd(x,_mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(x),z,7)));
+        x = _mm512_add_pd(x,_mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(x),z,6)));
+        x = _mm512_add_pd(x,_mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(x),z,4)));
+        return (x);
+}
+// Last lane in every lane.
+CK_PRIM vd vd_last(const vd x)                   { return _mm512_permutexvar_pd(_mm512_set1_epi64(7),x); }
+
+// VF_W int32: order-preserving keys of floats (an involution on the
+// bits), lane counts and selects for the OS radix search.
+CK_PRIM vi vi_c(const int32_t c)                 { return _mm512_set1_epi32(c); }
+CK_PRIM vi vi_load(const int32_t * __restrict p) { return _mm512_loadu_si512(p); }
+CK_PRIM void vi_store(int32_t * __restrict p, const vi x) { _mm512_storeu_si512(p,x); }
+CK_PRIM vi vi_or(const vi a, const vi b)         { return _mm512_or_si512(a,b); }
+CK_PRIM vi vi_xor(const vi a, const vi b)        { return _mm512_xor_si512(a,b); }
+// n + (a < b) per lane.
+CK_PRIM vi vi_cntlt(const vi n, const vi a, const vi b) {
+        return _mm512_mask_add_epi32(n,_mm512_cmplt_epi32_mask(a,b),n,_mm512_set1_epi32(1));
+}
+// (a < b) ? x : y per lane.
+CK_PRIM vi vi_sel_lt(const vi a, const vi b, const vi x, const vi y) {
+        return _mm512_mask_blend_epi32(_mm512_cmplt_epi32_mask(a,b),y,x);
+}
+CK_PRIM vi vi_key(const vf x) {
+        const vi s = _mm512_castps_si512(x);
+        return _mm512_xor_si512(s,_mm512_and_si512(_mm512_srai_epi32(s,31),_mm512_set1_epi32(0x7FFFFFFF)));
+}
+CK_PRIM vf vi_float(const vi s) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(s,_mm512_and_si512(_mm512_srai_epi32(s,31),
+                                                                      _mm512_set1_epi32(0x7FFFFFFF))));
+}
+
+
+#include "GMS_cfar_kernels.h"
+
+
+const cfar_isa_tab_t cfar_tab_avx512 = {
+        ck_vsum,
+        ck_pfx,
+        ck_sthr,
+        ck_osthr,
+        ck_mask,
+        VF_W
+};
@@ -0,0 +1,236 @@
+
+
+#ifndef __GMS_CFAR_KERNELS_H__
+#define __GMS_CFAR_KERNELS_H__
+
+//
+// CFAR row kernels over a per-ISA primitive layer; included by GMS_cfar.c
+// (one lane), GMS_cfar_avx2.c and GMS_cfar_avx512.c after they define vf
+// (VF_W floats), vd (VD_W doubles) and the vf_*, vd_* primitives.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+
+#include <math.h>
+#include <stdint.h>
+#include "GMS_cfar_private.h"
+
+
+#define CK_INLINE static inline __attribute__((always_inline))
+
+
+static void ck_vsum(const float * __restrict m,
+                    const int64_t ldm,
+                    const int32_t ra0,
+                    const int32_t ra1,
+                    const int32_t rb0,
+                    const int32_t rb1,
+                    const int32_t n,
+                    float * __restrict v) {
+         int32_t c,r;
+         for(c = 0; c+VF_W <= n; c += VF_W) {
+             vf s = vf_c(0.0f);
+             for(r = ra0; r < ra1; ++r) s = vf_add(s,vf_load(m+r*ldm+c));
+             for(r = rb0; r < rb1; ++r) s = vf_add(s,vf_load(m+r*ldm+c));
+             vf_store(v+c,s);
+         }
+         for(; c < n; ++c) {
+             float s = 0.0f;
+             for(r = ra0; r < ra1; ++r) s += m[r*ldm+c];
+             for(r = rb0; r < rb1; ++r) s += m[r*ldm+c];
+             v[c] = s;
+         }
+}
+
+static void ck_pfx(const float * __restrict v,
+                   const int32_t n,
+                   double * __restrict p) {
+         vd cy = vd_c(0.0);
+         int32_t c;
+         p[0] = 0.0;
+         for(c = 0; c+VD_W <= n; c += VD_W) {
+             const vd x = vd_add(vd_scan(vd_cvt(v+c)),cy);
+             vd_store(p+1+c,x);
+             cy = vd_last(x);
+         }
+         for(; c < n; ++c) p[c+1] = p[c]+(double)v[c];
+}
+
+// Training sum = outer columns of the training rows + non-guard columns
+// of the guard rows; lead and lag leave out the CUT column.
+static void ck_sthr(const int32_t type,
+                    const double * __restrict pt,
+                    const double * __restrict pg,
+                    const int32_t co,
+                    const int32_t gc,
+                    const int32_t c0,
+                    const int32_t c1,
+                    const double a,
+                    float * __restrict thr) {
+         const vd va = vd_c(a);
+         int32_t c = c0;
+         if(type == CFAR_CA) {
+            for(; c+VD_W <= c1; c += VD_W) {
+                const vd st = vd_sub(vd_load(pt+c+co+1),vd_load(pt+c-co));
+                const vd sl = vd_sub(vd_load(pg+c-gc),vd_load(pg+c-co));
+                const vd sr = vd_sub(vd_load(pg+c+co+1),vd_load(pg+c+gc+1));
+                vd_storef(thr+c,vd_mul(va,vd_add(st,vd_add(sl,sr))));
+            }
+            for(; c < c1; ++c)
+                thr[c] = (float)(a*((pt[c+co+1]-pt[c-co])+(pg[c-gc]-pg[c-co])+
+                                    (pg[c+co+1]-pg[c+gc+1])));
+         } else {
+            const int32_t go = (type == CFAR_GO);
+            for(; c+VD_W <= c1; c += VD_W) {
+                const vd l = vd_add(vd_sub(vd_load(pt+c),vd_load(pt+c-co)),
+                                    vd_sub(vd_load(pg+c-gc),vd_load(pg+c-co)));
+                const vd r = vd_add(vd_sub(vd_load(pt+c+co+1),vd_load(pt+c+1)),
+                                    vd_sub(vd_load(pg+c+co+1),vd_load(pg+c+gc+1)));
+                vd_storef(thr+c,vd_mul(va,go ? vd_max(l,r) : vd_min(l,r)));
+            }
+            for(; c < c1; ++c) {
+                const double l = (pt[c]-pt[c-co])+(pg[c-gc]-pg[c-co]);
+                const double r = (pt[c+co+1]-pt[c+1])+(pg[c+co+1]-pg[c+gc+1]);
+                thr[c] = (float)(a*(go ? fmax(l,r) : fmin(l,r)));
+            }
+         }
+}
+
+
+/*
+     Ordered statistic
+*/
+
+// The j-th extreme per lane of the n window cells at mc + off[i]: b[0..j)
+// kept sorted (ascending for the smallest, descending for the largest),
+// every new cell inserted by a min/max chain. With a literal j the chain
+// lives in registers.
+CK_INLINE vf ck_os_sel(const float * __restrict mc,
+                       const int64_t * __restrict off,
+                       const int32_t n,
+                       const int32_t j,
+                       const int32_t hi,
+                       vf * __restrict b) {
+         int32_t i,s;
+#pragma GCC unroll 16
+         for(s = 0; s != j; ++s) b[s] = vf_c(hi ? -HUGE_VALF : HUGE_VALF);
+         if(hi) {
+            for(i = 0; i != n; ++i) {
+                vf x = vf_load(mc+off[i]);
+#pragma GCC unroll 16
+                for(s = 0; s != j; ++s) {
+                    const vf t = vf_max(b[s],x);
+                    x = vf_min(b[s],x);
+                    b[s] = t;
+                }
+            }
+         } else {
+            for(i = 0; i != n; ++i) {
+                vf x = vf_load(mc+off[i]);
+#pragma GCC unroll 16
+                for(s = 0; s != j; ++s) {
+                    const vf t = vf_min(b[s],x);
+                    x = vf_max(b[s],x);
+                    b[s] = t;
+                }
+            }
+         }
+         return (b[j-1]);
+}
+
+// k-th smallest per lane by a radix search on order-preserving integer
+// keys: the largest u with #(key < u) < k, built from the top bit down
+// (32 counting passes over the window, for any k).
+static vf ck_os_radix(const float * __restrict mc,
+                      const int64_t * __restrict off,
+                      const int32_t n,
+                      const int32_t k,
+                      int32_t * __restrict key) {
+         const vi kk = vi_c(k);
+         const vi sb = vi_c(INT32_MIN);
+         vi r = vi_c(0);
+         int32_t i,b;
+         for(i = 0; i != n; ++i) vi_store(key+i*VF_W,vi_key(vf_load(mc+off[i])));
+         for(b = 31; b >= 0; --b) {
+             const vi cu = vi_or(r,vi_c((int32_t)(1U << b)));
+             const vi cs = vi_xor(cu,sb);       // unsigned pattern -> signed key
+             vi cnt = vi_c(0);
+             for(i = 0; i != n; ++i) cnt = vi_cntlt(cnt,vi_load(key+i*VF_W),cs);
+             r = vi_sel_lt(cnt,kk,cu,r);
+         }
+         return (vi_float(vi_xor(r,sb)));
+}
+
+#define CK_OS_CASE(J)                                                   \
+         case J:                                                        \
+              for(; c+VF_W <= c1; c += VF_W) {                          \
+                  vf b[J];                                              \
+                  vf_store(thr+c,vf_mul(va,ck_os_sel(m+c,off,n,J,hi,b))); \
+              }                                                         \
+              break;
+
+// j = min(k, n-k+1) extremes in registers up to 16, else the radix
+// search.
+static int32_t ck_osthr(const float * __restrict m,
+                        const int64_t * __restrict off,
+                        const int32_t n,
+                        const int32_t k,
+                        const float a,
+                        const int32_t c0,
+                        const int32_t c1,
+                        int32_t * __restrict key,
+                        float * __restrict thr) {
+         const vf va = vf_c(a);
+         const int32_t hi = (k > n-k+1);
+         const int32_t j  = hi ? n-k+1 : k;
+         int32_t c = c0;
+         switch(j) {
+         CK_OS_CASE(1)
+         CK_OS_CASE(2)
+         CK_OS_CASE(3)
+         CK_OS_CASE(4)
+         CK_OS_CASE(5)
+         CK_OS_CASE(6)
+         CK_OS_CASE(7)
+         CK_OS_CASE(8)
+         CK_OS_CASE(9)
+         CK_OS_CASE(10)
+         CK_OS_CASE(11)
+         CK_OS_CASE(12)
+         CK_OS_CASE(13)
+         CK_OS_CASE(14)
+         CK_OS_CASE(15)
+         CK_OS_CASE(16)
+         default:
+              for(; c+VF_W <= c1; c += VF_W)
+                  vf_store(thr+c,vf_mul(va,ck_os_radix(m+c,off,n,k,key)));
+              break;
+         }
+         return (c);
+}
+
+#undef CK_OS_CASE
+
+
+static int64_t ck_mask(const float * __restrict m,
+                       const float * __restrict t,
+                       const int32_t n,
+                       uint64_t * __restrict d) {
+         int64_t nd = 0;
+         int32_t c0,c;
+         for(c0 = 0; c0 < n; c0 += 64) {
+             const int32_t c1 = (c0+64 < n) ? c0+64 : n;
+             uint64_t b = 0ULL;
+             for(c = c0; c+VF_W <= c1; c += VF_W)
+                 b |= (uint64_t)vf_gtbits(vf_load(m+c),vf_load(t+c)) << (c-c0);
+             for(; c < c1; ++c) b |= (uint64_t)(m[c] > t[c]) << (c-c0);
+             d[c0/64] = b;
+             nd += __builtin_popcountll(b);
+         }
+         return (nd);
+}
+
+
+
+
+#endif /*__GMS_CFAR_KERNELS_H__*/
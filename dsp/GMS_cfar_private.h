@@ -0,0 +1,78 @@
+
+
+#ifndef __GMS_CFAR_PRIVATE_H__
+#define __GMS_CFAR_PRIVATE_H__
+
+//
+// Row kernel tables of the CFAR detectors (GMS_cfar.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 06:00 AM +00200
+//
+
+#include <stdint.h>
+#include "GMS_cfar.h"
+
+
+// V[c] = sum of the rows [ra0,ra1) and [rb0,rb1) of the map, c < n.
+typedef void (*cfar_vsum_fn)(const float * __restrict,  // map
+                             const int64_t,             // ldm
+                             const int32_t,             // ra0
+                             const int32_t,             // ra1
+                             const int32_t,             // rb0
+                             const int32_t,             // rb1
+                             const int32_t,             // n
+                             float * __restrict);       // V
+
+// P[0] = 0, P[c+1] = P[c] + V[c] in fp64, c < n.
+typedef void (*cfar_pfx_fn)(const float * __restrict,   // V
+                            const int32_t,              // n
+                            double * __restrict);       // P
+
+// CA, GO or SO thresholds of the columns [c0,c1), whole windows only, from
+// the prefix sums of the training rows (Pt) and guard rows (Pg).
+typedef void (*cfar_sthr_fn)(const int32_t,              // type
+                             const double * __restrict,  // Pt
+                             const double * __restrict,  // Pg
+                             const int32_t,              // co = gc + tc
+                             const int32_t,              // gc
+                             const int32_t,              // c0
+                             const int32_t,              // c1
+                             const double,               // scale
+                             float * __restrict);        // thr
+
+// OS thresholds of whole SIMD runs of the columns [c0,c1): scale times
+// the k-th smallest of the window cells at m + c + off[i], i < n; returns
+// the first column not done.
+typedef int32_t (*cfar_osthr_fn)(const float * __restrict,   // m (row of the CUT)
+                                 const int64_t * __restrict, // off
+                                 const int32_t,              // n
+                                 const int32_t,              // k
+                                 const float,                // scale
+                                 const int32_t,              // c0
+                                 const int32_t,              // c1
+                                 int32_t * __restrict,       // key, n*16 work
+                                 float * __restrict);        // thr
+
+// Bits of m[c] > t[c] into (n+63)/64 words; returns their count.
+typedef int64_t (*cfar_mask_fn)(const float * __restrict,    // m
+                                const float * __restrict,    // t
+                                const int32_t,               // n
+                                uint64_t * __restrict);      // d
+
+typedef struct {
+        cfar_vsum_fn  vsum;
+        cfar_pfx_fn   pfx;
+        cfar_sthr_fn  sthr;
+        cfar_osthr_fn osthr;
+        cfar_mask_fn  mask;
+        int32_t       width;     // floats per vector
+} cfar_isa_tab_t;
+
+extern const cfar_isa_tab_t cfar_tab_scalar;
+extern const cfar_isa_tab_t cfar_tab_avx2;
+extern const cfar_isa_tab_t cfar_tab_avx512;
+
+
+
+
+#endif /*__GMS_CFAR_PRIVATE_H__*/
@@ -0,0 +1,601 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_czt_batch.h"
+#include "GMS_fft_batch_private.h"
+#include "GMS_vmath.h"
+
+//
+// Plans, plan cache and block driver of the batched chirp-Z transform;
+// validation and benchmark.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 08:00 AM +00200
+//
+
+
+#define CZ_L FFTB_LANES
+
+static float * cz_alloc(const int64_t n) {
+
+         float * __restrict p = (float*)_mm_malloc((size_t)(n > 0 ? n : 1)*sizeof(float),64);
+         if(NULL != p) memset(p,0,(size_t)(n > 0 ? n : 1)*sizeof(float));
+         return (p);
+}
+
+// exp(q * (lr + i li)) in fp64.
+static void cz_cexp(const double q,
+                    const double lr,
+                    const double li,
+                    double * __restrict zr,
+                    double * __restrict zi) {
+
+         const double e = exp(q*lr);
+         const double f = q*li;
+         *zr = e*cos(f);
+         *zi = e*sin(f);
+}
+
+
+/*
+     Plan
+*/
+int32_t czt_init(czt_plan_t * __restrict p,
+                 const int32_t n,
+                 const int32_t m,
+                 const double * __restrict w,
+                 const double * __restrict a) {
+
+         float * __restrict h = NULL;
+         double lwr,lwi,lar,lai,hn,hm;
+         int64_t k;
+         int32_t st;
+         if(__builtin_expect(NULL==p || NULL==w || NULL==a,0)) return (-1);
+         memset(p,0,sizeof(*p));
+         if(__builtin_expect(n<1 || m<1 || n > (INT32_MAX/2)-m,0)) return (-1);
+         if(__builtin_expect(!(hypot(w[0],w[1]) > 0.0) || !(hypot(a[0],a[1]) > 0.0) ||
+                             !isfinite(w[0]+w[1]+a[0]+a[1]),0)) return (-1);
+         lwr = log(hypot(w[0],w[1]));
+         lwi = atan2(w[1],w[0]);
+         lar = log(hypot(a[0],a[1]));
+         lai = atan2(a[1],a[0]);
+         // Largest chirp magnitudes: input (n-1)|log A| + (n-1)^2/2 |log W|,
+         // kernel and output max(n-1,m-1)^2/2 |log W|.
+         hn = 0.5*(double)(n-1)*(double)(n-1);
+         hm = 0.5*(double)((n > m) ? n-1 : m-1)*(double)((n > m) ? n-1 : m-1);
+         if(__builtin_expect((double)(n-1)*fabs(lar)+hn*fabs(lwr) > CZT_MAXLOG ||
+                             hm*fabs(lwr) > CZT_MAXLOG,0)) return (-1);
+         p->n    = n;
+         p->m    = m;
+         p->nfft = fftb_good_size(n+m-1);
+         p->w[0] = w[0];
+         p->w[1] = w[1];
+         p->a[0] = a[0];
+         p->a[1] = a[1];
+         if((st = fftb_plan_init(&p->pl,p->nfft)) != 0) {
+            czt_free(p);
+            return (st);
+         }
+         p->are = cz_alloc(n);
+         p->aim = cz_alloc(n);
+         p->vre = cz_alloc(p->nfft);
+         p->vim = cz_alloc(p->nfft);
+         p->bre = cz_alloc(m);
+         p->bim = cz_alloc(m);
+         h = cz_alloc(2*(int64_t)p->nfft);
+         if(__builtin_expect(NULL==p->are || NULL==p->aim || NULL==p->vre || NULL==p->vim ||
+                             NULL==p->bre || NULL==p->bim || NULL==h,0)) {
+            if(NULL != h) _mm_free(h);
+            czt_free(p);
+            return (-2);
+         }
+         // A^-n W^(n^2/2) = exp(-n log A + n^2/2 log W); n^2 is exact in fp64
+         // for every n < 2^26.
+         for(k = 0; k != n; ++k) {
+             const double q = 0.5*(double)(k*k);
+             double zr,zi;
+             cz_cexp(1.0,q*lwr-(double)k*lar,q*lwi-(double)k*lai,&zr,&zi);
+             p->are[k] = (float)zr;
+             p->aim[k] = (float)zi;
+         }
+         for(k = 0; k != m; ++k) {
+             double zr,zi;
+             cz_cexp(0.5*(double)(k*k),lwr,lwi,&zr,&zi);
+             p->bre[k] = (float)zr;
+             p->bim[k] = (float)zi;
+         }
+         // Kernel W^(-j^2/2): lags 0..m-1 at the front, lags -(n-1)..-1 at
+         // the back; the rows between stay zero.
+         for(k = 0; k != m; ++k) {
+             double zr,zi;
+             cz_cexp(-0.5*(double)(k*k),lwr,lwi,&zr,&zi);
+             h[2*k]   = (float)zr;
+             h[2*k+1] = (float)zi;
+         }
+         for(k = 1; k != n; ++k) {
+             const int64_t j = p->nfft-k;
+             double zr,zi;
+             cz_cexp(-0.5*(double)(k*k),lwr,lwi,&zr,&zi);
+             h[2*j]   = (float)zr;
+             h[2*j+1] = (float)zi;
+         }
+         st = fftb_c2c(&p->pl,h,1,p->nfft,FFTB_FORWARD);
+         for(k = 0; k != p->nfft; ++k) {
+             p->vre[k] = h[2*k]/(float)p->nfft;
+             p->vim[k] = h[2*k+1]/(float)p->nfft;
+         }
+         _mm_free(h);
+         if(st != 0) {
+            czt_free(p);
+            return (st);
+         }
+         return (0);
+}
+
+void czt_free(czt_plan_t * __restrict p) {
+
+         if(NULL==p) return;
+         fftb_plan_free(&p->pl);
+         if(NULL != p->are) _mm_free(p->are);
+         if(NULL != p->aim) _mm_free(p->aim);
+         if(NULL != p->vre) _mm_free(p->vre);
+         if(NULL != p->vim) _mm_free(p->vim);
+         if(NULL != p->bre) _mm_free(p->bre);
+         if(NULL != p->bim) _mm_free(p->bim);
+         p->are = p->aim = p->vre = p->vim = p->bre = p->bim = NULL;
+}
+
+void czt_zoom(const double f0,
+              const double f1,
+              const double fs,
+              const int32_t m,
+              double * __restrict w,
+              double * __restrict a) {
+
+         const double tpi = 6.283185307179586476925286766559;
+         const double dw  = (m > 0 && fs != 0.0) ? tpi*(f1-f0)/((double)m*fs) : 0.0;
+         const double da  = (fs != 0.0) ? tpi*f0/fs : 0.0;
+         if(NULL==w || NULL==a) return;
+         w[0] =  cos(dw);
+         w[1] = -sin(dw);
+         a[0] =  cos(da);
+         a[1] =  sin(da);
+}
+
+
+/*
+     Batch
+*/
+int32_t czt_run(const czt_plan_t * __restrict p,
+                const float * __restrict x,
+                const int64_t nsig,
+                const int64_t ldx,
+                float * __restrict y,
+                const int64_t ldy) {
+
+         const fftb_isa_tab_t * __restrict t = fftb_tab();
+         int64_t nb;
+         int32_t par,fail = 0;
+         if(__builtin_expect(NULL==p || NULL==p->are || NULL==x || NULL==y,0)) return (-1);
+         if(__builtin_expect(nsig<0 || ldx<p->n || ldy<p->m,0)) return (-1);
+         if(nsig == 0) return (0);
+         nb  = (nsig+CZ_L-1)/CZ_L;
+         par = (nb >= 2*CZT_OMP_MIN);
+#if defined(_OPENMP)
+#pragma omp parallel if(par) default(none) \
+        shared(p,t,x,y,fail) firstprivate(nsig,ldx,ldy,nb)
+#endif
+         {
+             const int64_t nr = (int64_t)p->nfft*CZ_L;
+             float * __restrict re = (float*)_mm_malloc((size_t)(4*nr)*sizeof(float),64);
+             float * __restrict im = re+nr;
+             float * __restrict w0 = im+nr;
+             float * __restrict w1 = w0+nr;
+             int64_t j;
+             if(NULL==re) __atomic_store_n(&fail,1,__ATOMIC_RELAXED);
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+             for(j = 0; j < nb; ++j) {
+                 const int32_t ns = (int32_t)((nsig-j*CZ_L < CZ_L) ? nsig-j*CZ_L : CZ_L);
+                 if(NULL==re) continue;
+                 t->pack(x+2*j*CZ_L*ldx,ldx,ns,p->n,p->nfft,re,im);
+                 t->cmul(re,im,p->n,p->are,p->aim);
+                 t->blk(&p->pl,re,im,w0,w1);
+                 t->cmul(re,im,p->nfft,p->vre,p->vim);
+                 t->blk(&p->pl,im,re,w1,w0);
+                 t->cmul(re,im,p->m,p->bre,p->bim);
+                 t->unpack(re,im,p->m,1.0f,y+2*j*CZ_L*ldy,ldy,ns);
+             }
+             if(NULL != re) _mm_free(re);
+         }
+         return (fail ? -2 : 0);
+}
+
+
+/*
+     Plan cache
+*/
+typedef struct {
+        czt_plan_t p;
+        uint64_t   tick;                   // last use
+        int32_t    used;
+        int32_t    hold;                   // callers holding the plan
+} cz_slot_t;
+
+static cz_slot_t       cz_slots[CZT_CACHE_MAX];
+static uint64_t        cz_tick = 0;
+static pthread_mutex_t cz_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int32_t czt_cache_get(const int32_t n,
+                      const int32_t m,
+                      const double * __restrict w,
+                      const double * __restrict a,
+                      const czt_plan_t ** __restrict pp) {
+
+         cz_slot_t * __restrict sl = NULL;
+         int32_t st,k;
+         if(__builtin_expect(NULL==w || NULL==a || NULL==pp,0)) return (-1);
+         *pp = NULL;
+         pthread_mutex_lock(&cz_lock);
+         for(k = 0; k != CZT_CACHE_MAX; ++k) {
+             const czt_plan_t * __restrict q = &cz_slots[k].p;
+             if(cz_slots[k].used && q->n == n && q->m == m &&
+                q->w[0] == w[0] && q->w[1] == w[1] && q->a[0] == a[0] && q->a[1] == a[1]) {
+                sl = &cz_slots[k];
+                break;
+             }
+         }
+         if(NULL==sl) {
+            // A free slot, else the least recently used one nobody holds.
+            for(k = 0; k != CZT_CACHE_MAX; ++k) {
+                if(!cz_slots[k].used) {
+                   sl = &cz_slots[k];
+                   break;
+                }
+                if(cz_slots[k].hold == 0 && (NULL==sl || cz_slots[k].tick < sl->tick)) sl = &cz_slots[k];
+            }
+            if(NULL==sl) {
+               pthread_mutex_unlock(&cz_lock);
+               return (-2);
+            }
+            if(sl->used) czt_free(&sl->p);
+            sl->used = 0;
+            if((st = czt_init(&sl->p,n,m,w,a)) != 0) {
+               pthread_mutex_unlock(&cz_lock);
+               return (st);
+            }
+            sl->used = 1;
+            sl->hold = 0;
+         }
+         sl->hold += 1;
+         sl->tick  = ++cz_tick;
+         *pp = &sl->p;
+         pthread_mutex_unlock(&cz_lock);
+         return (0);
+}
+
+void czt_cache_release(const czt_plan_t * __restrict p) {
+
+         int32_t k;
+         if(NULL==p) return;
+         pthread_mutex_lock(&cz_lock);
+         for(k = 0; k != CZT_CACHE_MAX; ++k) {
+             if(&cz_slots[k].p == p && cz_slots[k].hold > 0) {
+                cz_slots[k].hold -= 1;
+                break;
+             }
+         }
+         pthread_mutex_unlock(&cz_lock);
+}
+
+int32_t czt_cache_clear(void) {
+
+         int32_t nh = 0;
+         int32_t k;
+         pthread_mutex_lock(&cz_lock);
+         for(k = 0; k != CZT_CACHE_MAX; ++k) {
+             if(!cz_slots[k].used) continue;
+             if(cz_slots[k].hold > 0) {
+                ++nh;
+                continue;
+             }
+             czt_free(&cz_slots[k].p);
+             cz_slots[k].used = 0;
+         }
+         pthread_mutex_unlock(&cz_lock);
+         return (nh);
+}
+
+int32_t czt_batch(const int32_t n,
+                  const int32_t m,
+                  const double * __restrict w,
+                  const double * __restrict a,
+                  const float * __restrict x,
+                  const int64_t nsig,
+                  const int64_t ldx,
+                  float * __restrict y,
+                  const int64_t ldy) {
+
+         const czt_plan_t * p = NULL;
+         int32_t st;
+         if((st = czt_cache_get(n,m,w,a,&p)) != 0) return (st);
+         st = czt_run(p,x,nsig,ldx,y,ldy);
+         czt_cache_release(p);
+         return (st);
+}
+
+
+/*
+     Validation
+*/
+static uint64_t cz_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double cz_draw(uint64_t * __restrict s,
+                      const double lo,
+                      const double hi) {
+
+         const double u = (double)(cz_rng(s) >> 11) * 0x1.0p-53;
+         return (lo*(1.0-u)+hi*u);
+}
+
+// Contours: zoom bands (f0, f1 in units of fs) when rw = 0, else the
+// spiral W = rw exp(-i tw), A = ra exp(i ta).
+typedef struct {
+        int32_t n,m;
+        double  f0,f1;
+        double  rw,tw,ra,ta;
+} cz_case_t;
+
+static const cz_case_t cz_cases[] = {
+        {   64,  64, 0.0,  1.0,   0.0,  0.0,  0.0, 0.0 },    // DFT
+        {  100,  37, 0.1,  0.15,  0.0,  0.0,  0.0, 0.0 },
+        {  257, 500,-0.5,  0.5,   0.0,  0.0,  0.0, 0.0 },
+        { 1000, 128, 0.2,  0.21,  0.0,  0.0,  0.0, 0.0 },
+        {  120,  90, 0.0,  0.0,   1.0002,0.05,0.999,0.3 },
+        {    1,   5, 0.0,  1.0,   0.0,  0.0,  0.0, 0.0 }
+};
+
+static void cz_contour(const cz_case_t * __restrict q,
+                       double * __restrict w,
+                       double * __restrict a) {
+
+         if(q->rw == 0.0) {
+            czt_zoom(q->f0,q->f1,1.0,q->m,w,a);
+         } else {
+            w[0] =  q->rw*cos(q->tw);
+            w[1] = -q->rw*sin(q->tw);
+            a[0] =  q->ra*cos(q->ta);
+            a[1] =  q->ra*sin(q->ta);
+         }
+}
+
+// Direct fp64 sum of nsig signals into r (m per signal).
+static void cz_ref(const cz_case_t * __restrict q,
+                   const double * __restrict w,
+                   const double * __restrict a,
+                   const float * __restrict x,
+                   const int64_t nsig,
+                   const int64_t ldx,
+                   double * __restrict r) {
+
+         const double lwr = log(hypot(w[0],w[1])),lwi = atan2(w[1],w[0]);
+         const double lar = log(hypot(a[0],a[1])),lai = atan2(a[1],a[0]);
+         int64_t s,k,j;
+         for(s = 0; s != nsig; ++s) {
+             const float * __restrict xs = x+2*s*ldx;
+             for(k = 0; k != q->m; ++k) {
+                 double sr = 0.0,si = 0.0;
+                 for(j = 0; j != q->n; ++j) {
+                     const double kj = (double)(k*j);
+                     double zr,zi;
+                     cz_cexp(1.0,kj*lwr-(double)j*lar,kj*lwi-(double)j*lai,&zr,&zi);
+                     sr += (double)xs[2*j]*zr-(double)xs[2*j+1]*zi;
+                     si += (double)xs[2*j]*zi+(double)xs[2*j+1]*zr;
+                 }
+                 r[2*(s*q->m+k)]   = sr;
+                 r[2*(s*q->m+k)+1] = si;
+             }
+         }
+}
+
+// Cache checks: one plan per key, czt_batch equal to czt_run, eviction
+// only of free plans, nothing held at the end.
+static int32_t cz_cache_check(FILE * __restrict fp,
+                              const float * __restrict x,
+                              const int64_t nsig,
+                              float * __restrict y0,
+                              float * __restrict y1) {
+
+         const czt_plan_t *p0 = NULL,*p1 = NULL;
+         const czt_plan_t *ph[CZT_CACHE_MAX+1];
+         double w[2],a[2];
+         int32_t bad = 0,k,st;
+         czt_zoom(0.1,0.2,1.0,48,w,a);
+         if(czt_cache_get(96,48,w,a,&p0) || czt_cache_get(96,48,w,a,&p1) || p0 != p1) ++bad;
+         if(0==bad && (czt_run(p0,x,nsig,96,y0,48) ||
+                       czt_batch(96,48,w,a,x,nsig,96,y1,48) ||
+                       memcmp(y0,y1,(size_t)(2*48*nsig)*sizeof(float)) != 0)) ++bad;
+         czt_cache_release(p0);
+         czt_cache_release(p1);
+         for(k = 0; k != CZT_CACHE_MAX+1; ++k) ph[k] = NULL;
+         for(k = 0; k != CZT_CACHE_MAX; ++k) {
+             czt_zoom(0.0,0.01*(double)(k+1),1.0,8,w,a);
+             if(czt_cache_get(16,8,w,a,&ph[k])) ++bad;
+         }
+         czt_zoom(0.0,0.5,1.0,8,w,a);
+         st = czt_cache_get(16,8,w,a,&ph[CZT_CACHE_MAX]);
+         if(st != -2) ++bad;
+         for(k = 0; k != CZT_CACHE_MAX+1; ++k) czt_cache_release(ph[k]);
+         if(czt_cache_clear() != 0) ++bad;
+         fprintf(fp,"  cache: shared plan, czt_batch == czt_run, full cache -> %d%s\n",
+                 st,bad ? "  FAIL" : "");
+         return (bad);
+}
+
+int32_t czt_validate(FILE * __restrict fp,
+                     const uint64_t seed) {
+
+         const int32_t ncase = (int32_t)(sizeof(cz_cases)/sizeof(cz_cases[0]));
+         const int32_t isa0  = vmath_get_isa();
+         const int64_t nsig  = 37;
+         const int64_t cap   = 1024;            // >= n + 3 and m + 5
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float  *x = NULL,*y = NULL,*y1 = NULL;
+         double *r = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t cs,isa;
+         if(NULL==fp) return (-1);
+         x  = (float*)malloc((size_t)(2*cap*nsig)*sizeof(float));
+         y  = (float*)malloc((size_t)(2*cap*nsig)*sizeof(float));
+         y1 = (float*)malloc((size_t)(2*cap*nsig)*sizeof(float));
+         r  = (double*)malloc((size_t)(2*cap*nsig)*sizeof(double));
+         if(NULL==x || NULL==y || NULL==y1 || NULL==r) {
+            nbad = -1;
+            goto done;
+         }
+         fprintf(fp,"Chirp-Z transform vs fp64 direct sum, %d signals, tol %.1e of max\n",
+                 (int32_t)nsig,(double)CZT_TOL);
+         for(cs = 0; cs != ncase; ++cs) {
+             const cz_case_t * __restrict q = &cz_cases[cs];
+             const int64_t ldx = q->n+3,ldy = q->m+5;
+             double w[2],a[2];
+             double rm = 0.0;
+             int64_t i,k;
+             cz_contour(q,w,a);
+             for(i = 0; i != 2*ldx*nsig; ++i) x[i] = (float)cz_draw(&s,-1.0,1.0);
+             cz_ref(q,w,a,x,nsig,ldx,r);
+             for(i = 0; i != 2*(int64_t)q->m*nsig; ++i) rm = fmax(rm,fabs(r[i]));
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 czt_plan_t p;
+                 double e = 0.0;
+                 if(vmath_set_isa(isa)) continue;
+                 if(czt_init(&p,q->n,q->m,w,a) || czt_run(&p,x,nsig,ldx,y,ldy)) {
+                    czt_free(&p);
+                    ++nbad;
+                    continue;
+                 }
+                 for(i = 0; i != nsig; ++i) {
+                     for(k = 0; k != q->m; ++k) {
+                         e = fmax(e,fabs((double)y[2*(i*ldy+k)]-r[2*(i*q->m+k)]));
+                         e = fmax(e,fabs((double)y[2*(i*ldy+k)+1]-r[2*(i*q->m+k)+1]));
+                     }
+                 }
+                 e /= rm;
+                 if(e > CZT_TOL) ++nbad;
+                 fprintf(fp,"  n=%4d m=%3d L=%4d %-7s err %.3e%s\n",
+                         q->n,q->m,p.nfft,isan[isa],e,(e > CZT_TOL) ? "  FAIL" : "");
+                 czt_free(&p);
+             }
+         }
+         for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+             if(vmath_set_isa(isa)) continue;
+             nbad += cz_cache_check(fp,x,nsig,y,y1);
+         }
+         vmath_set_isa(isa0);
+done:
+         free(x);
+         free(y);
+         free(y1);
+         free(r);
+         return (nbad);
+}
+
+
+/*
+     Benchmark
+*/
+static double cz_wtime(void) {
+
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+}
+
+// Seconds per pass over nsig signals (best of nrep after a warm-up), in
+// calls of nper signals.
+static double cz_bench_one(const czt_plan_t * __restrict p,
+                           const float * __restrict x,
+                           float * __restrict y,
+                           const int64_t nsig,
+                           const int64_t nper,
+                           const int32_t nrep) {
+
+         double best = 1.0e30;
+         int64_t j;
+         int32_t r;
+         for(r = 0; r <= nrep; ++r) {
+             const double t0 = cz_wtime();
+             for(j = 0; j < nsig; j += nper) {
+                 const int64_t ns = (nsig-j < nper) ? nsig-j : nper;
+                 czt_run(p,x+2*j*p->n,ns,p->n,y+2*j*p->m,p->m);
+             }
+             if(r > 0) best = fmin(best,cz_wtime()-t0);
+         }
+         return (best);
+}
+
+void czt_bench(FILE * __restrict fp,
+               const int32_t n,
+               const int32_t m,
+               const int64_t nsig,
+               const int32_t nrep) {
+
+         const int32_t isa0 = vmath_get_isa();
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float *x = NULL,*y = NULL;
+         uint64_t s = 0x5EED5EEDULL;
+         double w[2],a[2];
+         czt_plan_t p;
+         int32_t nthr = 1;
+         int32_t isa;
+         int64_t i;
+         if(NULL==fp) fp = stdout;
+         if(__builtin_expect(n<1 || m<1 || nsig<1 || nrep<1,0)) return;
+#if defined(_OPENMP)
+         nthr = omp_get_max_threads();
+#endif
+         czt_zoom(0.1,0.15,1.0,m,w,a);
+         x = (float*)_mm_malloc((size_t)(2*(int64_t)n*nsig)*sizeof(float),64);
+         y = (float*)_mm_malloc((size_t)(2*(int64_t)m*nsig)*sizeof(float),64);
+         if(NULL==x || NULL==y) goto done;
+         for(i = 0; i != 2*(int64_t)n*nsig; ++i) x[i] = (float)cz_draw(&s,-1.0,1.0);
+         fprintf(fp,"# zoom n=%d m=%d (L=%d), %lld signals, signals/s, best of %d\n",
+                 n,m,fftb_good_size(n+m-1),(long long)nsig,nrep);
+         fprintf(fp,"# %-7s %14s %14s %14s\n","isa","1 per call","batch 1 thr","batch all");
+         for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+             double t0,t1,tn;
+             if(vmath_set_isa(isa)) continue;
+             if(czt_init(&p,n,m,w,a)) break;
+#if defined(_OPENMP)
+             omp_set_num_threads(1);
+#endif
+             t0 = cz_bench_one(&p,x,y,nsig,1,nrep);
+             t1 = cz_bench_one(&p,x,y,nsig,nsig,nrep);
+#if defined(_OPENMP)
+             omp_set_num_threads(nthr);
+#endif
+             tn = cz_bench_one(&p,x,y,nsig,nsig,nrep);
+             czt_free(&p);
+             fprintf(fp,"  %-7s %14.1f %14.1f %14.1f\n",isan[isa],
+                     (double)nsig/t0,(double)nsig/t1,(double)nsig/tn);
+         }
+         vmath_set_isa(isa0);
+done:
+         if(NULL != x) _mm_free(x);
+         if(NULL != y) _mm_free(y);
+}
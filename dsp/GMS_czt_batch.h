@@ -0,0 +1,153 @@
+
+
+#ifndef __GMS_CZT_BATCH_H__
+#define __GMS_CZT_BATCH_H__ 191020260800
+
+//
+// Batched fp32 chirp-Z transforms (Bluestein) on the block FFTs of
+// GMS_fft_batch.h, with a process-wide cache of plans.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 08:00 AM +00200
+//
+// For N input samples x[n] the transform gives M outputs on the spiral
+// z_k = A W^-k:
+//
+//     X[k] = sum_{n<N} x[n] A^-n W^(n k),   k < M.
+//
+// With n k = (n^2 + k^2 - (k-n)^2)/2 this is a chirp multiply, a linear
+// convolution with the chirp W^(-m^2/2) and a second chirp multiply
+// (chrft/setwt of GMS_FFT_chirp_Z_Transform.f90, AS 117, does the same for
+// the DFT on one signal with power-of-2 FFTPACK lengths). A plan holds,
+// for one (N, M, W, A), the input chirp A^-n W^(n^2/2), the output chirp
+// W^(k^2/2) and the FFT of the convolution kernel with the 1/L of the
+// inverse folded in; L is the smallest 2^a 3^b 5^c >= N + M - 1, so the
+// convolution does not wrap. Chirps are computed in fp64 from log W and
+// log A; the kernel spectrum is taken once at plan time.
+// czt_run sends FFTB_LANES signals per block through pack, input chirp,
+// FFT, kernel multiply, inverse FFT, output chirp and unpack; the three
+// complex multiplies are the lane-batched row kernels of the FFT (every
+// lane of a row takes the same coefficient), so no per-signal loop is
+// left. Blocks run in parallel (OpenMP). A plan is read-only once made:
+// the work blocks (4 L FFTB_LANES floats per thread) are taken per call,
+// so a cached plan serves concurrent callers.
+// |W| and |A| may differ from 1 (spiral contours) as long as no chirp
+// exceeds exp(CZT_MAXLOG) in magnitude; the error then grows with the
+// ratio of the largest to the smallest chirp.
+// The ISA is the one of vmath_get_isa() (GMS_vmath.h).
+// Return values: 0 success, -1 invalid argument, -2 allocation failure
+// (for the cache also: every slot is held).
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include "GMS_fft_batch.h"
+
+
+// Blocks per thread of czt_run before it goes parallel.
+#if !defined(CZT_OMP_MIN)
+#define CZT_OMP_MIN 2
+#endif
+
+// Largest |log| of a chirp magnitude accepted by czt_init.
+#if !defined(CZT_MAXLOG)
+#define CZT_MAXLOG 30.0
+#endif
+
+// Plans kept by the cache.
+#if !defined(CZT_CACHE_MAX)
+#define CZT_CACHE_MAX 16
+#endif
+
+// Validation tolerance: |X - ref| relative to max|ref|.
+#if !defined(CZT_TOL)
+#define CZT_TOL 2.0e-5
+#endif
+
+
+typedef struct {
+        fftb_plan_t  pl;                   // length nfft
+        float   * __restrict are;          // input chirp A^-n W^(n^2/2), n
+        float   * __restrict aim;
+        float   * __restrict vre;          // FFT(W^(-m^2/2)) / nfft, nfft
+        float   * __restrict vim;
+        float   * __restrict bre;          // output chirp W^(k^2/2), m
+        float   * __restrict bim;
+        double   w[2];                     // W (re, im)
+        double   a[2];                     // A (re, im)
+        int32_t  n;                        // input samples
+        int32_t  m;                        // output points
+        int32_t  nfft;                     // L
+} czt_plan_t;
+
+
+// Plan of the N-point input, M-point output transform on (W, A).
+int32_t czt_init(czt_plan_t * __restrict,
+                 const int32_t,               // n
+                 const int32_t,               // m
+                 const double * __restrict,   // w (re, im)
+                 const double * __restrict);  // a (re, im)
+
+void    czt_free(czt_plan_t * __restrict);
+
+// W and A of the zoom transform: m bins f0 + k (f1 - f0)/m, k < m, of a
+// signal sampled at fs (f0 = 0, f1 = fs, m = n is the DFT).
+void    czt_zoom(const double,                // f0
+                 const double,                // f1
+                 const double,                // fs
+                 const int32_t,               // m
+                 double * __restrict,         // w (re, im)
+                 double * __restrict);        // a (re, im)
+
+// nsig interleaved complex signals of n samples, signal s at x[2*s*ldx],
+// into m outputs each at y[2*s*ldy]; x and y must not overlap.
+int32_t czt_run(const czt_plan_t * __restrict,
+                const float * __restrict,     // x
+                const int64_t,                // nsig
+                const int64_t,                // ldx (complex, >= n)
+                float * __restrict,           // y
+                const int64_t)                // ldy (complex, >= m)
+                                        __attribute__((hot));
+
+// Cached plan of (n, m, W, A), made on first use (keys compare exactly).
+// Every czt_cache_get is paired with a czt_cache_release; plans still held
+// are never evicted, the least recently used free one is.
+int32_t czt_cache_get(const int32_t,          // n
+                      const int32_t,          // m
+                      const double * __restrict, // w (re, im)
+                      const double * __restrict, // a (re, im)
+                      const czt_plan_t ** __restrict);
+
+void    czt_cache_release(const czt_plan_t * __restrict);
+
+// Frees the cached plans no caller holds; returns the number still held.
+int32_t czt_cache_clear(void);
+
+// czt_run through the cached plan of (n, m, W, A).
+int32_t czt_batch(const int32_t,              // n
+                  const int32_t,              // m
+                  const double * __restrict,  // w (re, im)
+                  const double * __restrict,  // a (re, im)
+                  const float * __restrict,   // x
+                  const int64_t,              // nsig
+                  const int64_t,              // ldx
+                  float * __restrict,         // y
+                  const int64_t);             // ldy
+
+// Compares czt_run with an fp64 direct sum for DFT, zoom and spiral
+// contours on every ISA the host runs, then checks the cache; prints one
+// line per case and ISA and returns the number of failures.
+int32_t czt_validate(FILE * __restrict,
+                     const uint64_t);         // seed
+
+// Signals per second of an n -> m zoom transform for every ISA: one
+// signal per call, then batches of nsig on one thread and on all.
+void    czt_bench(FILE * __restrict,
+                  const int32_t,              // n
+                  const int32_t,              // m
+                  const int64_t,              // nsig
+                  const int32_t);             // nrep
+
+
+
+
+#endif /*__GMS_CZT_BATCH_H__*/
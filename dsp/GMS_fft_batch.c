@@ -0,0 +1,294 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_fft_batch.h"
+#include "GMS_fft_batch_private.h"
+#include "GMS_vmath.h"
+
+//
+// Plans, ISA dispatch and block threading of the batched FFT; the one-lane
+// kernels; validation.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+
+
+/*
+     One-lane instantiation of the kernels (fallback of the drivers).
+*/
+typedef float   vf;
+typedef int32_t vm;
+
+#define VF_W 1
+
+#define FK_PRIM static inline __attribute__((always_inline))
+
+FK_PRIM vf vf_c(const float c)                   { return (c); }
+FK_PRIM vf vf_load(const float * __restrict p)   { return (*p); }
+FK_PRIM void vf_store(float * __restrict p, const vf x) { *p = x; }
+FK_PRIM vf vf_add(const vf a, const vf b)        { return (a+b); }
+FK_PRIM vf vf_sub(const vf a, const vf b)        { return (a-b); }
+FK_PRIM vf vf_mul(const vf a, const vf b)        { return (a*b); }
+FK_PRIM vf vf_fma(const vf a, const vf b, const vf c) { return (a*b+c); }
+FK_PRIM vf vf_fms(const vf a, const vf b, const vf c) { return (a*b-c); }
+FK_PRIM vm vf_mask(const int32_t nc)             { return (nc); }
+FK_PRIM void vf_storem(float * __restrict p, const vm k, const vf x) { if(k) *p = x; }
+
+#include "GMS_fft_batch_kernels.h"
+
+const fftb_isa_tab_t fftb_tab_scalar = {
+        fk_blk,
+        fk_pack,
+        fk_unpack,
+        fk_tr,
+        fk_cmul,
+        fk_win,
+        fk_pow,
+        VF_W
+};
+
+const fftb_isa_tab_t * fftb_tab(void) {
+
+         switch(vmath_get_isa()) {
+         case VMATH_ISA_AVX512: return (&fftb_tab_avx512);
+         case VMATH_ISA_AVX2:   return (&fftb_tab_avx2);
+         default:               return (&fftb_tab_scalar);
+         }
+}
+
+
+/*
+     Plans
+*/
+int32_t fftb_good_size(const int32_t n) {
+
+         int32_t m = (n > 1) ? n : 1;
+         for(;; ++m) {
+             int32_t r = m;
+             while(r%2 == 0) r /= 2;
+             while(r%3 == 0) r /= 3;
+             while(r%5 == 0) r /= 5;
+             if(r == 1) return (m);
+         }
+}
+
+int32_t fftb_plan_init(fftb_plan_t * __restrict pl,
+                       const int32_t n) {
+
+         const double tpi = 6.283185307179586476925286766559;
+         int64_t nt = 0,nc,p,k;
+         int32_t r = n,st;
+         if(__builtin_expect(NULL==pl || n<1,0)) return (-1);
+         pl->n = n;
+         pl->nstage = 0;
+         pl->tw = NULL;
+         // Radix-4 stages first (one radix-2 stage for an odd power of two),
+         // then 3 and 5.
+         while(r%4 == 0) { pl->rad[pl->nstage++] = 4; r /= 4; }
+         if(r%2 == 0)    { pl->rad[pl->nstage++] = 2; r /= 2; }
+         while(r%3 == 0) { pl->rad[pl->nstage++] = 3; r /= 3; }
+         while(r%5 == 0) { pl->rad[pl->nstage++] = 5; r /= 5; }
+         if(r != 1) return (-1);
+         for(st = 0,nc = n; st != pl->nstage; ++st) {
+             pl->toff[st] = nt;
+             nt += 2*(nc/pl->rad[st])*(pl->rad[st]-1);
+             nc /= pl->rad[st];
+         }
+         pl->tw = (float*)_mm_malloc((size_t)(nt > 0 ? nt : 1)*sizeof(float),64);
+         if(__builtin_expect(NULL==pl->tw,0)) return (-2);
+         for(st = 0,nc = n; st != pl->nstage; ++st) {
+             const int32_t rs = pl->rad[st];
+             const int64_t m  = nc/rs;
+             float * __restrict tw = pl->tw+pl->toff[st];
+             for(p = 0; p != m; ++p) {
+                 for(k = 1; k != rs; ++k) {
+                     const double a = -tpi*(double)(p*k)/(double)nc;
+                     tw[2*(p*(rs-1)+k-1)]   = (float)cos(a);
+                     tw[2*(p*(rs-1)+k-1)+1] = (float)sin(a);
+                 }
+             }
+             nc = m;
+         }
+         return (0);
+}
+
+void fftb_plan_free(fftb_plan_t * __restrict pl) {
+
+         if(NULL==pl) return;
+         if(NULL != pl->tw) _mm_free(pl->tw);
+         pl->tw = NULL;
+         pl->nstage = 0;
+}
+
+
+/*
+     Transforms
+*/
+void fftb_block(const fftb_plan_t * __restrict pl,
+                float * __restrict re,
+                float * __restrict im,
+                float * __restrict wre,
+                float * __restrict wim,
+                const int32_t dir) {
+
+         const fftb_isa_tab_t * __restrict t = fftb_tab();
+         // conj(F(conj x)) = swap(F(swap x)): the inverse runs on (im, re).
+         if(dir == FFTB_INVERSE) t->blk(pl,im,re,wim,wre);
+         else                    t->blk(pl,re,im,wre,wim);
+}
+
+int32_t fftb_c2c(const fftb_plan_t * __restrict pl,
+                 float * __restrict x,
+                 const int64_t nsig,
+                 const int64_t ld,
+                 const int32_t dir) {
+
+         const fftb_isa_tab_t * __restrict t = fftb_tab();
+         const int64_t n    = (NULL != pl) ? pl->n : 0;
+         const int64_t nblk = (nsig+FFTB_LANES-1)/FFTB_LANES;
+         const float scale  = (dir == FFTB_INVERSE) ? 1.0f/(float)n : 1.0f;
+         int32_t st = 0;
+         if(__builtin_expect(NULL==pl || NULL==x || nsig<0 || ld<n,0)) return (-1);
+         if(__builtin_expect(dir != FFTB_FORWARD && dir != FFTB_INVERSE,0)) return (-1);
+         if(nsig == 0) return (0);
+#if defined(_OPENMP)
+#pragma omp parallel if(nblk >= 2*FFTB_OMP_MIN) default(none) \
+        shared(pl,x,t) firstprivate(n,nblk,scale,nsig,ld,dir) reduction(min:st)
+#endif
+         {
+             float * __restrict w = (float*)_mm_malloc((size_t)(4*n*FFTB_LANES)*sizeof(float),64);
+             int64_t b;
+             if(NULL==w) st = -2;
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+             for(b = 0; b < nblk; ++b) {
+                 float * __restrict re = w;
+                 float * __restrict im = w+n*FFTB_LANES;
+                 float * __restrict xb = x+2*b*FFTB_LANES*ld;
+                 const int32_t ns = (int32_t)((nsig-b*FFTB_LANES < FFTB_LANES) ?
+                                               nsig-b*FFTB_LANES : FFTB_LANES);
+                 if(NULL==w) continue;
+                 t->pack(xb,ld,ns,n,n,re,im);
+                 if(dir == FFTB_INVERSE) t->blk(pl,im,re,w+3*n*FFTB_LANES,w+2*n*FFTB_LANES);
+                 else                    t->blk(pl,re,im,w+2*n*FFTB_LANES,w+3*n*FFTB_LANES);
+                 t->unpack(re,im,n,scale,xb,ld,ns);
+             }
+             if(NULL != w) _mm_free(w);
+         }
+         return (st);
+}
+
+
+/*
+     Validation
+*/
+static uint64_t fk_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double fk_draw(uint64_t * __restrict s,
+                      const double lo,
+                      const double hi) {
+
+         const double u = (double)(fk_rng(s) >> 11) * 0x1.0p-53;
+         return (lo*(1.0-u)+hi*u);
+}
+
+#define FK_VSIG 19
+#define FK_VTOL 1.0e-5
+
+static const int32_t fk_vlen[] = {
+        1,2,3,4,5,6,8,9,12,15,16,25,30,32,45,60,64,100,125,128,
+        243,256,360,500,512,625,768,1000,1024,1536
+};
+
+int32_t fftb_validate(FILE * __restrict fp,
+                      const uint64_t seed) {
+
+         const int32_t nlen = (int32_t)(sizeof(fk_vlen)/sizeof(fk_vlen[0]));
+         const int32_t isa0 = vmath_get_isa();
+         const int64_t nmax = 1536;
+         const int64_t ld   = nmax+3;
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float  *x = NULL,*y = NULL;
+         double *r = NULL,*c = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t il,isa;
+         if(NULL==fp) return (-1);
+         x = (float*)malloc((size_t)(2*FK_VSIG*ld)*sizeof(float));
+         y = (float*)malloc((size_t)(2*FK_VSIG*ld)*sizeof(float));
+         r = (double*)malloc((size_t)(2*FK_VSIG*nmax)*sizeof(double));
+         c = (double*)malloc((size_t)(2*nmax)*sizeof(double));
+         if(NULL==x || NULL==y || NULL==r || NULL==c) {
+            nbad = -1;
+            goto done;
+         }
+         fprintf(fp,"Batched FFT vs fp64 DFT, %d signals, tol %.1e of max|X|\n",FK_VSIG,FK_VTOL);
+         for(il = 0; il != nlen; ++il) {
+             const int64_t n = fk_vlen[il];
+             double xm = 0.0;
+             int64_t i,j,k;
+             for(i = 0; i != 2*FK_VSIG*ld; ++i) x[i] = (float)fk_draw(&s,-1.0,1.0);
+             for(k = 0; k != n; ++k) {
+                 const double a = -6.283185307179586476925286766559*(double)k/(double)n;
+                 c[2*k] = cos(a);
+                 c[2*k+1] = sin(a);
+             }
+             for(i = 0; i != FK_VSIG; ++i) {
+                 for(k = 0; k != n; ++k) {
+                     double sr = 0.0,si = 0.0;
+                     for(j = 0; j != n; ++j) {
+                         const int64_t e = (j*k)%n;
+                         const double xr = (double)x[2*(i*ld+j)],xi = (double)x[2*(i*ld+j)+1];
+                         sr += xr*c[2*e]-xi*c[2*e+1];
+                         si += xr*c[2*e+1]+xi*c[2*e];
+                     }
+                     r[2*(i*n+k)] = sr;
+                     r[2*(i*n+k)+1] = si;
+                     xm = fmax(xm,hypot(sr,si));
+                 }
+             }
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 fftb_plan_t pl;
+                 double ef = 0.0,ei = 0.0;
+                 if(vmath_set_isa(isa)) continue;
+                 if(fftb_plan_init(&pl,(int32_t)n)) {
+                    ++nbad;
+                    continue;
+                 }
+                 memcpy(y,x,(size_t)(2*FK_VSIG*ld)*sizeof(float));
+                 if(fftb_c2c(&pl,y,FK_VSIG,ld,FFTB_FORWARD)) ++nbad;
+                 for(i = 0; i != FK_VSIG; ++i)
+                     for(k = 0; k != 2*n; ++k)
+                         ef = fmax(ef,fabs((double)y[2*i*ld+k]-r[2*i*n+k]));
+                 ef /= xm;
+                 if(fftb_c2c(&pl,y,FK_VSIG,ld,FFTB_INVERSE)) ++nbad;
+                 for(i = 0; i != FK_VSIG; ++i)
+                     for(k = 0; k != 2*n; ++k)
+                         ei = fmax(ei,fabs((double)y[2*i*ld+k]-(double)x[2*i*ld+k]));
+                 fftb_plan_free(&pl);
+                 if(ef > FK_VTOL || ei > FK_VTOL) ++nbad;
+                 fprintf(fp,"  n=%5lld %-7s fwd %.3e  inv %.3e%s\n",(long long)n,isan[isa],ef,ei,
+                         (ef > FK_VTOL || ei > FK_VTOL) ? "  FAIL" : "");
+             }
+         }
+         vmath_set_isa(isa0);
+done:
+         free(x);
+         free(y);
+         free(r);
+         free(c);
+         return (nbad);
+}
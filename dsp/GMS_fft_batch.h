@@ -0,0 +1,95 @@
+
+
+#ifndef __GMS_FFT_BATCH_H__
+#define __GMS_FFT_BATCH_H__ 191020260400
+
+//
+// Batched fp32 complex FFTs across SIMD lanes (AVX2/AVX512) and the block
+// kernels of the radar signal chains (corner turns, spectral multiplies,
+// windows, power).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+// A block holds FFTB_LANES transforms of one length in split form: element
+// k of transform l at re[k*FFTB_LANES + l], im[k*FFTB_LANES + l]. Every
+// butterfly runs on whole vectors of transforms, so no lane shuffles are
+// needed inside the FFT and any length n = 2^a 3^b 5^c runs at the same
+// vector efficiency (radix-4, 2, 3 and 5 Stockham stages, autosorting,
+// ping-pong with a work block). The block layout is the same for every
+// ISA (one zmm or two ymm per row).
+// The inverse transform is the forward one on (im, re): fftb_block does
+// not scale it; fftb_c2c scales by 1/n as ZFFT1D of FFTE does.
+// Interleaved signals (complex float pairs, signal-major) enter and leave
+// blocks through in-register transposes (fftb_c2c, and the pack/unpack
+// steps of the range-Doppler pipeline, GMS_range_doppler.h).
+// Twiddles are computed in fp64 at plan time; the transform error is a
+// few fp32 ULP times log2(n) (fftb_validate measures it).
+// The ISA is the one of vmath_get_isa() (GMS_vmath.h).
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Transforms per block (fixed for every ISA).
+#define FFTB_LANES 16
+
+#define FFTB_MAXSTAGE 40
+
+#define FFTB_FORWARD (-1)
+#define FFTB_INVERSE (+1)
+
+// Blocks per thread of fftb_c2c before it goes parallel.
+#if !defined(FFTB_OMP_MIN)
+#define FFTB_OMP_MIN 4
+#endif
+
+
+typedef struct {
+        float   * __restrict tw;          // per stage: [n/r][r-1] (re,im) twiddles
+        int64_t  toff[FFTB_MAXSTAGE];     // offset of each stage in tw (floats)
+        int32_t  rad[FFTB_MAXSTAGE];      // radices, first stage first
+        int32_t  n;
+        int32_t  nstage;
+} fftb_plan_t;
+
+
+// Smallest 2^a 3^b 5^c >= n (n >= 1).
+int32_t fftb_good_size(const int32_t);
+
+// Plan of the length n = 2^a 3^b 5^c.
+int32_t fftb_plan_init(fftb_plan_t * __restrict,
+                       const int32_t);       // n
+
+void    fftb_plan_free(fftb_plan_t * __restrict);
+
+// Forward (FFTB_FORWARD) or unscaled inverse transform of one block in
+// place; wre, wim are n*FFTB_LANES floats of work space.
+void    fftb_block(const fftb_plan_t * __restrict,
+                   float * __restrict,       // re
+                   float * __restrict,       // im
+                   float * __restrict,       // wre
+                   float * __restrict,       // wim
+                   const int32_t)            // dir
+                                        __attribute__((hot));
+
+// nsig interleaved complex signals of n samples, signal s at x[2*s*ld],
+// transformed in place (inverse scaled by 1/n); blocks run in parallel.
+int32_t fftb_c2c(const fftb_plan_t * __restrict,
+                 float * __restrict,         // x
+                 const int64_t,              // nsig
+                 const int64_t,              // ld (complex elements, >= n)
+                 const int32_t)              // dir
+                                        __attribute__((hot));
+
+// Compares fftb_c2c with an fp64 DFT for several lengths on every ISA the
+// host runs; prints one line per length and ISA and returns the number of
+// errors over 1e-5 relative to max|X|.
+int32_t fftb_validate(FILE * __restrict,
+                      const uint64_t);       // seed
+
+
+
+
+#endif /*__GMS_FFT_BATCH_H__*/
@@ -0,0 +1,75 @@
+
+
+//
+// AVX2/FMA instantiation of the batched FFT block kernels (GMS_fft_batch.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+// The unit carries its own target; GMS_fft_batch.c and the range-Doppler
+// pipeline call into it only when vmath_get_isa() reports AVX2. One block
+// row is two ymm; transposes go 8 x 8.
+//
+
+#pragma GCC target("avx2,fma")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_fft_batch_private.h"
+
+
+typedef __m256  vf;
+typedef __m256i vm;
+
+#define VF_W 8
+
+#define FK_PRIM static inline __attribute__((always_inline))
+
+
+FK_PRIM vf vf_c(const float c)                   { return _mm256_set1_ps(c); }
+FK_PRIM vf vf_load(const float * __restrict p)   { return _mm256_loadu_ps(p); }
+FK_PRIM void vf_store(float * __restrict p, const vf x) { _mm256_storeu_ps(p,x); }
+FK_PRIM vf vf_add(const vf a, const vf b)        { return _mm256_add_ps(a,b); }
+FK_PRIM vf vf_sub(const vf a, const vf b)        { return _mm256_sub_ps(a,b); }
+FK_PRIM vf vf_mul(const vf a, const vf b)        { return _mm256_mul_ps(a,b); }
+FK_PRIM vf vf_fma(const vf a, const vf b, const vf c) { return _mm256_fmadd_ps(a,b,c); }
+FK_PRIM vf vf_fms(const vf a, const vf b, const vf c) { return _mm256_fmsub_ps(a,b,c); }
+// Lanes 0..nc-1.
+FK_PRIM vm vf_mask(const int32_t nc) {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(nc),_mm256_setr_epi32(0,1,2,3,4,5,6,7));
+}
+FK_PRIM void vf_storem(float * __restrict p, const vm k, const vf x) { _mm256_maskstore_ps(p,k,x); }
+
+// 8 x 8 transpose in registers: v[j] lane i <- v[i] lane j.
+FK_PRIM void vf_tr(vf * __restrict v) {
+        __m256 t[8],u[8];
+        int32_t i,c;
+        for(i = 0; i != 4; ++i) {
+            t[2*i]   = _mm256_unpacklo_ps(v[2*i],v[2*i+1]);
+            t[2*i+1] = _mm256_unpackhi_ps(v[2*i],v[2*i+1]);
+        }
+        for(i = 0; i != 8; i += 4) {
+            u[i]   = _mm256_shuffle_ps(t[i],t[i+2],0x44);
+            u[i+1] = _mm256_shuffle_ps(t[i],t[i+2],0xEE);
+            u[i+2] = _mm256_shuffle_ps(t[i+1],t[i+3],0x44);
+            u[i+3] = _mm256_shuffle_ps(t[i+1],t[i+3],0xEE);
+        }
+        for(c = 0; c != 4; ++c) {
+            v[c]   = _mm256_permute2f128_ps(u[c],u[4+c],0x20);
+            v[4+c] = _mm256_permute2f128_ps(u[c],u[4+c],0x31);
+        }
+}
+
+
+#include "GMS_fft_batch_kernels.h"
+
+
+const fftb_isa_tab_t fftb_tab_avx2 = {
+        fk_blk,
+        fk_pack,
+        fk_unpack,
+        fk_tr,
+        fk_cmul,
+        fk_win,
+        fk_pow,
+        VF_W
+};
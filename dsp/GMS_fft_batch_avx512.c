@@ -0,0 +1,84 @@
+
+
+//
+// AVX512F instantiation of the batched FFT block kernels (GMS_fft_batch.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+// The unit carries its own target; GMS_fft_batch.c and the range-Doppler
+// pipeline call into it only when vmath_get_isa() reports AVX512. One
+// block row is one zmm.
+//
+
+#pragma GCC target("avx512f")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_fft_batch_private.h"
+
+
+typedef __m512    vf;
+typedef __mmask16 vm;
+
+#define VF_W 16
+
+#define FK_PRIM static inline __attribute__((always_inline))
+
+
+FK_PRIM vf vf_c(const float c)                   { return _mm512_set1_ps(c); }
+FK_PRIM vf vf_load(const float * __restrict p)   { return _mm512_loadu_ps(p); }
+FK_PRIM void vf_store(float * __restrict p, const vf x) { _mm512_storeu_ps(p,x); }
+FK_PRIM vf vf_add(const vf a, const vf b)        { return _mm512_add_ps(a,b); }
+FK_PRIM vf vf_sub(const vf a, const vf b)        { return _mm512_sub_ps(a,b); }
+FK_PRIM vf vf_mul(const vf a, const vf b)        { return _mm512_mul_ps(a,b); }
+FK_PRIM vf vf_fma(const vf a, const vf b, const vf c) { return _mm512_fmadd_ps(a,b,c); }
+FK_PRIM vf vf_fms(const vf a, const vf b, const vf c) { return _mm512_fmsub_ps(a,b,c); }
+// Lanes 0..nc-1.
+FK_PRIM vm vf_mask(const int32_t nc)             { return (vm)((1U << nc)-1U); }
+FK_PRIM void vf_storem(float * __restrict p, const vm k, const vf x) { _mm512_mask_storeu_ps(p,k,x); }
+
+// 16 x 16 transpose in registers: v[j] lane i <- v[i] lane j.
+FK_PRIM void vf_tr(vf * __restrict v) {
+        __m512 t[16],u[16],r[16];
+        int32_t i,c;
+        for(i = 0; i != 8; ++i) {
+            t[2*i]   = _mm512_unpacklo_ps(v[2*i],v[2*i+1]);
+            t[2*i+1] = _mm512_unpackhi_ps(v[2*i],v[2*i+1]);
+        }
+        for(i = 0; i != 16; i += 4) {
+            const __m512d a = _mm512_castps_pd(t[i]),  b = _mm512_castps_pd(t[i+1]);
+            const __m512d e = _mm512_castps_pd(t[i+2]),f = _mm512_castps_pd(t[i+3]);
+            u[i]   = _mm512_castpd_ps(_mm512_unpacklo_pd(a,e));
+            u[i+1] = _mm512_castpd_ps(_mm512_unpackhi_pd(a,e));
+            u[i+2] = _mm512_castpd_ps(_mm512_unpacklo_pd(b,f));
+            u[i+3] = _mm512_castpd_ps(_mm512_unpackhi_pd(b,f));
+        }
+        // u[4j+c], 128-bit lane b: column 4b+c of the rows 4j..4j+3.
+        for(c = 0; c != 4; ++c) {
+            r[c]    = _mm512_shuffle_f32x4(u[c],u[4+c],0x88);
+            r[4+c]  = _mm512_shuffle_f32x4(u[c],u[4+c],0xDD);
+            r[8+c]  = _mm512_shuffle_f32x4(u[8+c],u[12+c],0x88);
+            r[12+c] = _mm512_shuffle_f32x4(u[8+c],u[12+c],0xDD);
+        }
+        for(c = 0; c != 4; ++c) {
+            v[c]    = _mm512_shuffle_f32x4(r[c],r[8+c],0x88);
+            v[8+c]  = _mm512_shuffle_f32x4(r[c],r[8+c],0xDD);
+            v[4+c]  = _mm512_shuffle_f32x4(r[4+c],r[12+c],0x88);
+            v[12+c] = _mm512_shuffle_f32x4(r[4+c],r[12+c],0xDD);
+        }
+}
+
+
+#include "GMS_fft_batch_kernels.h"
+
+
+const fftb_isa_tab_t fftb_tab_avx512 = {
+        fk_blk,
+        fk_pack,
+        fk_unpack,
+        fk_tr,
+        fk_cmul,
+        fk_win,
+        fk_pow,
+        VF_W
+};
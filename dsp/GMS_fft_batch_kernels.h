@@ -0,0 +1,440 @@
+
+
+#ifndef __GMS_FFT_BATCH_KERNELS_H__
+#define __GMS_FFT_BATCH_KERNELS_H__
+
+//
+// Batched FFT block kernels over a per-ISA primitive layer; included by
+// GMS_fft_batch.c (one lane), GMS_fft_batch_avx2.c and
+// GMS_fft_batch_avx512.c after they define vf/vm, VF_W and the vf_*
+// primitives (vf_tr: in-register transpose of VF_W vectors).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+// Stockham stage of radix r on a sub-transform length n = r*m with stride
+// s (rows), w = exp(-2*pi*i/n):
+//   a_j = x[q + s*(p + j*m)],  y[q + s*(r*p + k)] = w^(p*k) * DFT_r(a)_k
+// for p < m, q < s; after the stage n = m, s = s*r. The output is in
+// natural order after the last stage.
+//
+
+#include <string.h>
+#include <stdint.h>
+#include "GMS_fft_batch_private.h"
+
+
+#define FK_INLINE static inline __attribute__((always_inline))
+
+#define FL FFTB_LANES
+
+#define FK_SQRT3_2 0.866025403784438646763723170752936183f
+#define FK_C5_1    0.309016994374947424102293417182819059f    // cos(2pi/5)
+#define FK_C5_2   -0.809016994374947424102293417182819059f    // cos(4pi/5)
+#define FK_S5_1    0.951056516295153572116439333379382143f    // sin(2pi/5)
+#define FK_S5_2    0.587785252292473129168705954639072769f    // sin(4pi/5)
+
+
+// (r + i*im) *= (wr + i*wi)
+FK_INLINE void fk_twid(vf * __restrict r,
+                       vf * __restrict im,
+                       const vf wr,
+                       const vf wi) {
+         const vf a = *r;
+         *r  = vf_fms(a,wr,vf_mul(*im,wi));
+         *im = vf_fma(a,wi,vf_mul(*im,wr));
+}
+
+
+/*
+     Stockham stages
+*/
+static void fk_r2(const float * __restrict tw,
+                  const int64_t m,
+                  const int64_t s,
+                  const float * __restrict xr,
+                  const float * __restrict xi,
+                  float * __restrict yr,
+                  float * __restrict yi) {
+         const int64_t sm = s*m*FL;
+         const int64_t so = s*FL;
+         int64_t p,q;
+         int32_t l;
+         for(p = 0; p != m; ++p) {
+             const vf w1r = vf_c(tw[2*p]),w1i = vf_c(tw[2*p+1]);
+             for(q = 0; q != s; ++q) {
+                 const int64_t i0 = (q+s*p)*FL;
+                 const int64_t o0 = (q+s*2*p)*FL;
+                 for(l = 0; l != FL; l += VF_W) {
+                     const vf a0r = vf_load(xr+i0+l),    a0i = vf_load(xi+i0+l);
+                     const vf a1r = vf_load(xr+i0+sm+l), a1i = vf_load(xi+i0+sm+l);
+                     vf y1r = vf_sub(a0r,a1r),y1i = vf_sub(a0i,a1i);
+                     fk_twid(&y1r,&y1i,w1r,w1i);
+                     vf_store(yr+o0+l,vf_add(a0r,a1r));
+                     vf_store(yi+o0+l,vf_add(a0i,a1i));
+                     vf_store(yr+o0+so+l,y1r);
+                     vf_store(yi+o0+so+l,y1i);
+                 }
+             }
+         }
+}
+
+static void fk_r3(const float * __restrict tw,
+                  const int64_t m,
+                  const int64_t s,
+                  const float * __restrict xr,
+                  const float * __restrict xi,
+                  float * __restrict yr,
+                  float * __restrict yi) {
+         const int64_t sm = s*m*FL;
+         const int64_t so = s*FL;
+         const vf h  = vf_c(0.5f);
+         const vf s3 = vf_c(FK_SQRT3_2);
+         int64_t p,q;
+         int32_t l;
+         for(p = 0; p != m; ++p) {
+             const float * __restrict w = tw+4*p;
+             const vf w1r = vf_c(w[0]),w1i = vf_c(w[1]);
+             const vf w2r = vf_c(w[2]),w2i = vf_c(w[3]);
+             for(q = 0; q != s; ++q) {
+                 const int64_t i0 = (q+s*p)*FL;
+                 const int64_t o0 = (q+s*3*p)*FL;
+                 for(l = 0; l != FL; l += VF_W) {
+                     const vf a0r = vf_load(xr+i0+l),      a0i = vf_load(xi+i0+l);
+                     const vf a1r = vf_load(xr+i0+sm+l),   a1i = vf_load(xi+i0+sm+l);
+                     const vf a2r = vf_load(xr+i0+2*sm+l), a2i = vf_load(xi+i0+2*sm+l);
+                     const vf t1r = vf_add(a1r,a2r),t1i = vf_add(a1i,a2i);
+                     const vf t2r = vf_sub(a0r,vf_mul(h,t1r)),t2i = vf_sub(a0i,vf_mul(h,t1i));
+                     const vf t3r = vf_mul(s3,vf_sub(a1r,a2r)),t3i = vf_mul(s3,vf_sub(a1i,a2i));
+                     vf y1r = vf_add(t2r,t3i),y1i = vf_sub(t2i,t3r);
+                     vf y2r = vf_sub(t2r,t3i),y2i = vf_add(t2i,t3r);
+                     fk_twid(&y1r,&y1i,w1r,w1i);
+                     fk_twid(&y2r,&y2i,w2r,w2i);
+                     vf_store(yr+o0+l,vf_add(a0r,t1r));
+                     vf_store(yi+o0+l,vf_add(a0i,t1i));
+                     vf_store(yr+o0+so+l,y1r);
+                     vf_store(yi+o0+so+l,y1i);
+                     vf_store(yr+o0+2*so+l,y2r);
+                     vf_store(yi+o0+2*so+l,y2i);
+                 }
+             }
+         }
+}
+
+static void fk_r4(const float * __restrict tw,
+                  const int64_t m,
+                  const int64_t s,
+                  const float * __restrict xr,
+                  const float * __restrict xi,
+                  float * __restrict yr,
+                  float * __restrict yi) {
+         const int64_t sm = s*m*FL;
+         const int64_t so = s*FL;
+         int64_t p,q;
+         int32_t l;
+         for(p = 0; p != m; ++p) {
+             const float * __restrict w = tw+6*p;
+             const vf w1r = vf_c(w[0]),w1i = vf_c(w[1]);
+             const vf w2r = vf_c(w[2]),w2i = vf_c(w[3]);
+             const vf w3r = vf_c(w[4]),w3i = vf_c(w[5]);
+             for(q = 0; q != s; ++q) {
+                 const int64_t i0 = (q+s*p)*FL;
+                 const int64_t o0 = (q+s*4*p)*FL;
+                 for(l = 0; l != FL; l += VF_W) {
+                     const vf a0r = vf_load(xr+i0+l),      a0i = vf_load(xi+i0+l);
+                     const vf a1r = vf_load(xr+i0+sm+l),   a1i = vf_load(xi+i0+sm+l);
+                     const vf a2r = vf_load(xr+i0+2*sm+l), a2i = vf_load(xi+i0+2*sm+l);
+                     const vf a3r = vf_load(xr+i0+3*sm+l), a3i = vf_load(xi+i0+3*sm+l);
+                     const vf t0r = vf_add(a0r,a2r),t0i = vf_add(a0i,a2i);
+                     const vf t1r = vf_sub(a0r,a2r),t1i = vf_sub(a0i,a2i);
+                     const vf t2r = vf_add(a1r,a3r),t2i = vf_add(a1i,a3i);
+                     const vf t3r = vf_sub(a1r,a3r),t3i = vf_sub(a1i,a3i);
+                     // y1 = t1 - i*t3, y3 = t1 + i*t3
+                     vf y1r = vf_add(t1r,t3i),y1i = vf_sub(t1i,t3r);
+                     vf y2r = vf_sub(t0r,t2r),y2i = vf_sub(t0i,t2i);
+                     vf y3r = vf_sub(t1r,t3i),y3i = vf_add(t1i,t3r);
+                     fk_twid(&y1r,&y1i,w1r,w1i);
+                     fk_twid(&y2r,&y2i,w2r,w2i);
+                     fk_twid(&y3r,&y3i,w3r,w3i);
+                     vf_store(yr+o0+l,vf_add(t0r,t2r));
+                     vf_store(yi+o0+l,vf_add(t0i,t2i));
+                     vf_store(yr+o0+so+l,y1r);
+                     vf_store(yi+o0+so+l,y1i);
+                     vf_store(yr+o0+2*so+l,y2r);
+                     vf_store(yi+o0+2*so+l,y2i);
+                     vf_store(yr+o0+3*so+l,y3r);
+                     vf_store(yi+o0+3*so+l,y3i);
+                 }
+             }
+         }
+}
+
+static void fk_r5(const float * __restrict tw,
+                  const int64_t m,
+                  const int64_t s,
+                  const float * __restrict xr,
+                  const float * __restrict xi,
+                  float * __restrict yr,
+                  float * __restrict yi) {
+         const int64_t sm = s*m*FL;
+         const int64_t so = s*FL;
+         const vf c1 = vf_c(FK_C5_1),c2 = vf_c(FK_C5_2);
+         const vf s1 = vf_c(FK_S5_1),s2 = vf_c(FK_S5_2);
+         int64_t p,q;
+         int32_t l;
+         for(p = 0; p != m; ++p) {
+             const float * __restrict w = tw+8*p;
+             for(q = 0; q != s; ++q) {
+                 const int64_t i0 = (q+s*p)*FL;
+                 const int64_t o0 = (q+s*5*p)*FL;
+                 for(l = 0; l != FL; l += VF_W) {
+                     const vf a0r = vf_load(xr+i0+l),      a0i = vf_load(xi+i0+l);
+                     const vf a1r = vf_load(xr+i0+sm+l),   a1i = vf_load(xi+i0+sm+l);
+                     const vf a2r = vf_load(xr+i0+2*sm+l), a2i = vf_load(xi+i0+2*sm+l);
+                     const vf a3r = vf_load(xr+i0+3*sm+l), a3i = vf_load(xi+i0+3*sm+l);
+                     const vf a4r = vf_load(xr+i0+4*sm+l), a4i = vf_load(xi+i0+4*sm+l);
+                     const vf t1r = vf_add(a1r,a4r),t1i = vf_add(a1i,a4i);
+                     const vf t2r = vf_add(a2r,a3r),t2i = vf_add(a2i,a3i);
+                     const vf t3r = vf_sub(a1r,a4r),t3i = vf_sub(a1i,a4i);
+                     const vf t4r = vf_sub(a2r,a3r),t4i = vf_sub(a2i,a3i);
+                     const vf b1r = vf_fma(c2,t2r,vf_fma(c1,t1r,a0r));
+                     const vf b1i = vf_fma(c2,t2i,vf_fma(c1,t1i,a0i));
+                     const vf b2r = vf_fma(c1,t2r,vf_fma(c2,t1r,a0r));
+                     const vf b2i = vf_fma(c1,t2i,vf_fma(c2,t1i,a0i));
+                     const vf d1r = vf_fma(s2,t4r,vf_mul(s1,t3r));
+                     const vf d1i = vf_fma(s2,t4i,vf_mul(s1,t3i));
+                     const vf d2r = vf_fms(s2,t3r,vf_mul(s1,t4r));
+                     const vf d2i = vf_fms(s2,t3i,vf_mul(s1,t4i));
+                     // y1,4 = b1 -+ i*d1, y2,3 = b2 -+ i*d2
+                     vf y1r = vf_add(b1r,d1i),y1i = vf_sub(b1i,d1r);
+                     vf y4r = vf_sub(b1r,d1i),y4i = vf_add(b1i,d1r);
+                     vf y2r = vf_add(b2r,d2i),y2i = vf_sub(b2i,d2r);
+                     vf y3r = vf_sub(b2r,d2i),y3i = vf_add(b2i,d2r);
+                     fk_twid(&y1r,&y1i,vf_c(w[0]),vf_c(w[1]));
+                     fk_twid(&y2r,&y2i,vf_c(w[2]),vf_c(w[3]));
+                     fk_twid(&y3r,&y3i,vf_c(w[4]),vf_c(w[5]));
+                     fk_twid(&y4r,&y4i,vf_c(w[6]),vf_c(w[7]));
+                     vf_store(yr+o0+l,vf_add(a0r,vf_add(t1r,t2r)));
+                     vf_store(yi+o0+l,vf_add(a0i,vf_add(t1i,t2i)));
+                     vf_store(yr+o0+so+l,y1r);
+                     vf_store(yi+o0+so+l,y1i);
+                     vf_store(yr+o0+2*so+l,y2r);
+                     vf_store(yi+o0+2*so+l,y2i);
+                     vf_store(yr+o0+3*so+l,y3r);
+                     vf_store(yi+o0+3*so+l,y3i);
+                     vf_store(yr+o0+4*so+l,y4r);
+                     vf_store(yi+o0+4*so+l,y4i);
+                 }
+             }
+         }
+}
+
+static void fk_blk(const fftb_plan_t * __restrict pl,
+                   float * __restrict re,
+                   float * __restrict im,
+                   float * __restrict wre,
+                   float * __restrict wim) {
+         float * __restrict xr = re;
+         float * __restrict xi = im;
+         float * __restrict yr = wre;
+         float * __restrict yi = wim;
+         int64_t n = pl->n,s = 1;
+         int32_t st;
+         for(st = 0; st != pl->nstage; ++st) {
+             const int32_t r = pl->rad[st];
+             const int64_t m = n/r;
+             const float * __restrict tw = pl->tw+pl->toff[st];
+             float * __restrict t;
+             switch(r) {
+             case 4:  fk_r4(tw,m,s,xr,xi,yr,yi); break;
+             case 2:  fk_r2(tw,m,s,xr,xi,yr,yi); break;
+             case 3:  fk_r3(tw,m,s,xr,xi,yr,yi); break;
+             default: fk_r5(tw,m,s,xr,xi,yr,yi); break;
+             }
+             t = xr; xr = yr; yr = t;
+             t = xi; xi = yi; yi = t;
+             n = m;
+             s *= r;
+         }
+         if(xr != re) {
+            memcpy(re,xr,(size_t)pl->n*FL*sizeof(float));
+            memcpy(im,xi,(size_t)pl->n*FL*sizeof(float));
+         }
+}
+
+
+/*
+     Corner turns
+*/
+
+// Interleaved element (signal l, sample k) <-> block row k, lane l, one at
+// a time, over rows [k0,k1) and lanes [l0,FL).
+FK_INLINE void fk_pack_rect(const float * __restrict x,
+                            const int64_t ld,
+                            const int32_t nsig,
+                            const int64_t k0,
+                            const int64_t k1,
+                            const int32_t l0,
+                            float * __restrict re,
+                            float * __restrict im) {
+         int64_t k;
+         int32_t l;
+         for(k = k0; k < k1; ++k) {
+             for(l = l0; l < FL; ++l) {
+                 re[k*FL+l] = (l < nsig) ? x[2*(l*ld+k)]   : 0.0f;
+                 im[k*FL+l] = (l < nsig) ? x[2*(l*ld+k)+1] : 0.0f;
+             }
+         }
+}
+
+static void fk_pack(const float * __restrict x,
+                    const int64_t ld,
+                    const int32_t nsig,
+                    const int64_t nc,
+                    const int64_t n,
+                    float * __restrict re,
+                    float * __restrict im) {
+         int64_t kv = 0;
+         int32_t ng = 0;
+#if VF_W > 1
+         ng = nsig/VF_W*VF_W;
+         for(kv = 0; kv+VF_W/2 <= nc && ng > 0; kv += VF_W/2) {
+             int32_t g,j;
+             for(g = 0; g != ng; g += VF_W) {
+                 vf v[VF_W];
+                 for(j = 0; j != VF_W; ++j) v[j] = vf_load(x+2*((g+j)*ld+kv));
+                 vf_tr(v);
+                 for(j = 0; j != VF_W; ++j)
+                     vf_store(((j & 1) ? im : re)+(kv+j/2)*FL+g,v[j]);
+             }
+         }
+#endif
+         fk_pack_rect(x,ld,nsig,0,kv,ng,re,im);
+         fk_pack_rect(x,ld,nsig,kv,nc,0,re,im);
+         if(n > nc) {
+            memset(re+nc*FL,0,(size_t)(n-nc)*FL*sizeof(float));
+            memset(im+nc*FL,0,(size_t)(n-nc)*FL*sizeof(float));
+         }
+}
+
+static void fk_unpack(const float * __restrict re,
+                      const float * __restrict im,
+                      const int64_t nc,
+                      const float scale,
+                      float * __restrict x,
+                      const int64_t ld,
+                      const int32_t nsig) {
+         int64_t kv = 0,k;
+         int32_t ng = 0,l;
+#if VF_W > 1
+         const vf sc = vf_c(scale);
+         ng = nsig/VF_W*VF_W;
+         for(kv = 0; kv+VF_W/2 <= nc && ng > 0; kv += VF_W/2) {
+             int32_t g,j;
+             for(g = 0; g != ng; g += VF_W) {
+                 vf v[VF_W];
+                 for(j = 0; j != VF_W; ++j)
+                     v[j] = vf_mul(sc,vf_load(((j & 1) ? im : re)+(kv+j/2)*FL+g));
+                 vf_tr(v);
+                 for(j = 0; j != VF_W; ++j) vf_store(x+2*((g+j)*ld+kv),v[j]);
+             }
+         }
+#endif
+         for(k = 0; k < nc; ++k) {
+             for(l = (k < kv) ? ng : 0; l < nsig; ++l) {
+                 x[2*(l*ld+k)]   = scale*re[k*FL+l];
+                 x[2*(l*ld+k)+1] = scale*im[k*FL+l];
+             }
+         }
+}
+
+static void fk_tr(const float * __restrict src,
+                  const int64_t ls,
+                  float * __restrict dst,
+                  const int64_t ld,
+                  const int32_t nrow) {
+#if VF_W > 1
+         int32_t i0,j0,i,j;
+         for(i0 = 0; i0 != FL; i0 += VF_W) {
+             for(j0 = 0; j0 < nrow; j0 += VF_W) {
+                 vf v[VF_W];
+                 for(i = 0; i != VF_W; ++i) v[i] = vf_load(src+(i0+i)*ls+j0);
+                 vf_tr(v);
+                 for(j = 0; j != VF_W && j0+j < nrow; ++j) vf_store(dst+(j0+j)*ld+i0,v[j]);
+             }
+         }
+#else
+         int32_t i,j;
+         for(j = 0; j < nrow; ++j)
+             for(i = 0; i != FL; ++i) dst[j*ld+i] = src[i*ls+j];
+#endif
+}
+
+
+/*
+     Row kernels
+*/
+static void fk_cmul(float * __restrict re,
+                    float * __restrict im,
+                    const int64_t n,
+                    const float * __restrict hre,
+                    const float * __restrict him) {
+         int64_t k;
+         int32_t l;
+         for(k = 0; k != n; ++k) {
+             const vf hr = vf_c(hre[k]),hi = vf_c(him[k]);
+             for(l = 0; l != FL; l += VF_W) {
+                 vf r = vf_load(re+k*FL+l),i = vf_load(im+k*FL+l);
+                 fk_twid(&r,&i,hr,hi);
+                 vf_store(re+k*FL+l,r);
+                 vf_store(im+k*FL+l,i);
+             }
+         }
+}
+
+static void fk_win(const float * __restrict sre,
+                   const float * __restrict sim,
+                   const float * __restrict w,
+                   const int64_t nv,
+                   const int64_t n,
+                   float * __restrict dre,
+                   float * __restrict dim) {
+         int64_t k;
+         int32_t l;
+         for(k = 0; k != nv; ++k) {
+             const vf wk = vf_c(w[k]);
+             for(l = 0; l != FL; l += VF_W) {
+                 vf_store(dre+k*FL+l,vf_mul(wk,vf_load(sre+k*FL+l)));
+                 vf_store(dim+k*FL+l,vf_mul(wk,vf_load(sim+k*FL+l)));
+             }
+         }
+         if(n > nv) {
+            memset(dre+nv*FL,0,(size_t)(n-nv)*FL*sizeof(float));
+            memset(dim+nv*FL,0,(size_t)(n-nv)*FL*sizeof(float));
+         }
+}
+
+static void fk_pow(const float * __restrict re,
+                   const float * __restrict im,
+                   const int64_t n,
+                   const int64_t shift,
+                   float * __restrict dst,
+                   const int64_t ld,
+                   const int32_t nl) {
+         int64_t k;
+         int32_t l;
+         for(k = 0; k != n; ++k) {
+             const int64_t kk = (k+shift < n) ? k+shift : k+shift-n;
+             float * __restrict d = dst+kk*ld;
+             for(l = 0; l < nl; l += VF_W) {
+                 const vf r = vf_load(re+k*FL+l),i = vf_load(im+k*FL+l);
+                 const vf p = vf_fma(r,r,vf_mul(i,i));
+                 if(l+VF_W <= nl) vf_store(d+l,p);
+                 else             vf_storem(d+l,vf_mask(nl-l),p);
+             }
+         }
+}
+
+
+
+
+#endif /*__GMS_FFT_BATCH_KERNELS_H__*/
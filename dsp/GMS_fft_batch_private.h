@@ -0,0 +1,100 @@
+
+
+#ifndef __GMS_FFT_BATCH_PRIVATE_H__
+#define __GMS_FFT_BATCH_PRIVATE_H__
+
+//
+// Block kernel tables of the batched FFT (GMS_fft_batch.h); used by the
+// range-Doppler pipeline as well.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 04:00 AM +00200
+//
+// Blocks are rows of FFTB_LANES floats (re and im apart). Row arguments
+// count rows, strides count floats unless noted.
+//
+
+#include <stdint.h>
+#include "GMS_fft_batch.h"
+
+
+// Forward transform of a block; the result is back in (re, im).
+typedef void (*fftb_blk_fn)(const fftb_plan_t * __restrict,
+                            float * __restrict,         // re
+                            float * __restrict,         // im
+                            float * __restrict,         // wre
+                            float * __restrict);        // wim
+
+// nsig <= FFTB_LANES interleaved signals (signal s at x[2*s*ld]), nc
+// samples each, into the rows 0..n-1 of a block (zero rows nc..n-1 and
+// zero lanes nsig..FFTB_LANES-1).
+typedef void (*fftb_pack_fn)(const float * __restrict,  // x
+                             const int64_t,             // ld (complex)
+                             const int32_t,             // nsig
+                             const int64_t,             // nc
+                             const int64_t,             // n
+                             float * __restrict,        // re
+                             float * __restrict);       // im
+
+// Rows 0..nc-1 of a block, times scale, back into nsig interleaved signals.
+typedef void (*fftb_unpack_fn)(const float * __restrict, // re
+                               const float * __restrict, // im
+                               const int64_t,            // nc
+                               const float,              // scale
+                               float * __restrict,       // x
+                               const int64_t,            // ld (complex)
+                               const int32_t);           // nsig
+
+// 16 x 16 transpose: dst[j*ld + i] = src[i*ls + j], i < 16, j < nrow.
+typedef void (*fftb_tr_fn)(const float * __restrict,    // src
+                           const int64_t,               // ls
+                           float * __restrict,          // dst
+                           const int64_t,               // ld
+                           const int32_t);              // nrow
+
+// Row k times the complex h[k] (same for every lane), k < n.
+typedef void (*fftb_cmul_fn)(float * __restrict,        // re
+                             float * __restrict,        // im
+                             const int64_t,             // n
+                             const float * __restrict,  // hre
+                             const float * __restrict); // him
+
+// dst row k = w[k] * src row k for k < nv, zero rows nv..n-1 (re and im).
+typedef void (*fftb_win_fn)(const float * __restrict,   // sre
+                            const float * __restrict,   // sim
+                            const float * __restrict,   // w
+                            const int64_t,              // nv
+                            const int64_t,              // n
+                            float * __restrict,         // dre
+                            float * __restrict);        // dim
+
+// |row k|^2 into dst[((k+shift)%n)*ld + l], l < nl (rows rotated by shift).
+typedef void (*fftb_pow_fn)(const float * __restrict,   // re
+                            const float * __restrict,   // im
+                            const int64_t,              // n
+                            const int64_t,              // shift
+                            float * __restrict,         // dst
+                            const int64_t,              // ld
+                            const int32_t);             // nl
+
+typedef struct {
+        fftb_blk_fn    blk;
+        fftb_pack_fn   pack;
+        fftb_unpack_fn unpack;
+        fftb_tr_fn     tr;
+        fftb_cmul_fn   cmul;
+        fftb_win_fn    win;
+        fftb_pow_fn    pow;
+        int32_t        width;     // floats per vector
+} fftb_isa_tab_t;
+
+extern const fftb_isa_tab_t fftb_tab_scalar;
+extern const fftb_isa_tab_t fftb_tab_avx2;
+extern const fftb_isa_tab_t fftb_tab_avx512;
+
+// The table of vmath_get_isa().
+const fftb_isa_tab_t * fftb_tab(void);
+
+
+
+
+#endif /*__GMS_FFT_BATCH_PRIVATE_H__*/
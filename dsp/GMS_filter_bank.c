@@ -0,0 +1,640 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_filter_bank.h"
+#include "GMS_filter_bank_private.h"
+#include "GMS_vmath.h"
+
+//
+// Plans, ISA dispatch, channel threading and history of the filter banks;
+// the one-lane kernels; validation and benchmark.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 03:00 AM +00200
+//
+
+
+/*
+     One-lane instantiation of the kernels (fallback of the drivers).
+*/
+typedef float   vf;
+typedef int32_t vm;
+
+#define VF_W  1
+#define FB_RB 4
+
+#define FB_PRIM static inline __attribute__((always_inline))
+
+FB_PRIM vf vf_c(const float c)                   { return (c); }
+FB_PRIM vf vf_load(const float * __restrict p)   { return (*p); }
+FB_PRIM void vf_store(float * __restrict p, const vf x) { *p = x; }
+FB_PRIM vf vf_mul(const vf a, const vf b)        { return (a*b); }
+FB_PRIM vf vf_fma(const vf a, const vf b, const vf c) { return (a*b+c); }
+FB_PRIM vm vf_mask(const int32_t nc)             { return (nc); }
+FB_PRIM vf vf_loadm(const float * __restrict p, const vm k) { return (k ? *p : 0.0f); }
+FB_PRIM void vf_storem(float * __restrict p, const vm k, const vf x) { if(k) *p = x; }
+
+#include "GMS_filter_bank_kernels.h"
+
+const fbank_isa_tab_t fbank_tab_scalar = {
+        fb_fir_kernel,
+        fb_iir_kernel,
+        VF_W
+};
+
+static const fbank_isa_tab_t * fb_tab(void) {
+
+         switch(vmath_get_isa()) {
+         case VMATH_ISA_AVX512: return (&fbank_tab_avx512);
+         case VMATH_ISA_AVX2:   return (&fbank_tab_avx2);
+         default:               return (&fbank_tab_scalar);
+         }
+}
+
+// FTZ | DAZ for the kernels of one chunk.
+#define FB_MXCSR_FTZ_DAZ 0x8040U
+
+// Coefficient rows and IIR delays are padded to whole zmm vectors.
+#define FB_PAD16(n) (((n)+15)/16*16)
+
+static float * fb_alloc(const int64_t n) {
+
+         float * __restrict p = (float*)_mm_malloc((size_t)(n > 0 ? n : 1)*sizeof(float),64);
+         if(NULL != p) memset(p,0,(size_t)(n > 0 ? n : 1)*sizeof(float));
+         return (p);
+}
+
+
+/*
+     FIR
+*/
+int32_t fbank_fir_init(fbank_fir_t * __restrict p,
+                       const float * __restrict h,
+                       const int32_t ntap,
+                       const int32_t nch,
+                       const int32_t up,
+                       const int32_t down,
+                       const int32_t pc) {
+
+         int64_t hs,ph,j,c;
+         if(__builtin_expect(NULL==p || NULL==h,0)) return (-1);
+         if(__builtin_expect(ntap<1 || nch<1 || up<1 || down<1,0)) return (-1);
+         p->nch  = nch;
+         p->ntap = ntap;
+         p->up   = up;
+         p->down = down;
+         p->lp   = (ntap+up-1)/up;
+         p->pc   = (pc != 0);
+         p->hs   = p->pc ? FB_PAD16(nch) : 1;
+         p->pad  = 0;
+         p->pos  = 0;
+         hs = p->hs;
+         p->hp = fb_alloc((int64_t)up*p->lp*hs);
+         p->z  = fb_alloc((int64_t)(p->lp-1)*nch);
+         if(__builtin_expect(NULL==p->hp || NULL==p->z,0)) {
+            fbank_fir_free(p);
+            return (-2);
+         }
+         // Phase ph holds the taps ph, ph+U, ph+2U, ... (zero-padded to lp).
+         for(ph = 0; ph != up; ++ph) {
+             for(j = 0; j != p->lp; ++j) {
+                 const int64_t k = j*up+ph;
+                 if(k >= ntap) continue;
+                 if(p->pc) {
+                    for(c = 0; c != nch; ++c) p->hp[(ph*p->lp+j)*hs+c] = h[c*ntap+k];
+                 } else {
+                    p->hp[ph*p->lp+j] = h[k];
+                 }
+             }
+         }
+         return (0);
+}
+
+int64_t fbank_fir_nout(const fbank_fir_t * __restrict p,
+                       const int64_t n) {
+
+         const int64_t nu = n*p->up-p->pos;
+         return ((nu > 0) ? (nu+p->down-1)/p->down : 0);
+}
+
+// History of the channels [c0,c1) after n more rows: the last lp-1 rows
+// of (z, x).
+static void fb_fir_hist(const fbank_fir_t * __restrict p,
+                        const float * __restrict x,
+                        const int64_t n,
+                        const int32_t c0,
+                        const int32_t c1) {
+
+         const int64_t nch = p->nch;
+         const int64_t hr  = p->lp-1;
+         const size_t  sz  = (size_t)(c1-c0)*sizeof(float);
+         int64_t r;
+         if(n >= hr) {
+            for(r = 0; r != hr; ++r) memcpy(&p->z[r*nch+c0],&x[(n-hr+r)*nch+c0],sz);
+         } else {
+            for(r = 0; r != hr-n; ++r) memcpy(&p->z[r*nch+c0],&p->z[(r+n)*nch+c0],sz);
+            for(; r != hr; ++r) memcpy(&p->z[r*nch+c0],&x[(r-hr+n)*nch+c0],sz);
+         }
+}
+
+int64_t fbank_fir_run(fbank_fir_t * __restrict p,
+                      const float * __restrict x,
+                      const int64_t n,
+                      float * __restrict y) {
+
+         const fbank_isa_tab_t * __restrict tab;
+         int64_t nout,nchk,b;
+         int32_t par,st = 0;
+         if(__builtin_expect(NULL==p || NULL==p->hp || n<0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         tab  = fb_tab();
+         nout = fbank_fir_nout(p,n);
+         nchk = (p->nch+FBANK_CHUNK-1)/FBANK_CHUNK;
+         par  = n*(int64_t)p->nch >= FBANK_OMP_MIN && nchk > 1;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(par) default(none) \
+        shared(tab,p,x,y) firstprivate(n,nout,nchk) reduction(min:st)
+#endif
+         for(b = 0; b < nchk; ++b) {
+             const int32_t c0  = (int32_t)(b*FBANK_CHUNK);
+             const int32_t c1  = (p->nch-c0 < FBANK_CHUNK) ? p->nch : c0+FBANK_CHUNK;
+             const uint32_t csr = _mm_getcsr();
+             int32_t sb;
+             _mm_setcsr(csr | FB_MXCSR_FTZ_DAZ);
+             sb = tab->fir(p,x,n,y,nout,c0,c1);
+             _mm_setcsr(csr);
+             if(sb < st) st = sb;
+         }
+         // The history moves only once every chunk has its outputs.
+         if(__builtin_expect(st != 0,0)) return (st);
+         fb_fir_hist(p,x,n,0,p->nch);
+         p->pos += nout*p->down-n*p->up;
+         return (nout);
+}
+
+void fbank_fir_reset(fbank_fir_t * __restrict p) {
+
+         if(NULL==p || NULL==p->z) return;
+         memset(p->z,0,(size_t)(p->lp-1)*(size_t)p->nch*sizeof(float));
+         p->pos = 0;
+}
+
+void fbank_fir_free(fbank_fir_t * __restrict p) {
+
+         if(NULL==p) return;
+         if(NULL != p->hp) _mm_free(p->hp);
+         if(NULL != p->z)  _mm_free(p->z);
+         p->hp = NULL;
+         p->z  = NULL;
+}
+
+
+/*
+     IIR
+*/
+int32_t fbank_iir_init(fbank_iir_t * __restrict p,
+                       const float * __restrict sos,
+                       const int32_t nsec,
+                       const int32_t nch,
+                       const int32_t pc) {
+
+         int64_t hs,nb,b,s,c;
+         if(__builtin_expect(NULL==p || NULL==sos,0)) return (-1);
+         if(__builtin_expect(nsec<1 || nch<1,0)) return (-1);
+         nb = (pc != 0) ? nch : 1;
+         for(b = 0; b != nb*nsec; ++b) if(sos[b*6+3] == 0.0f) return (-1);
+         p->nch  = nch;
+         p->nchp = FB_PAD16(nch);
+         p->nsec = nsec;
+         p->pc   = (pc != 0);
+         p->hs   = p->pc ? p->nchp : 1;
+         p->pad  = 0;
+         hs = p->hs;
+         p->c = fb_alloc((int64_t)nsec*5*hs);
+         p->z = fb_alloc((int64_t)nsec*2*p->nchp);
+         if(__builtin_expect(NULL==p->c || NULL==p->z,0)) {
+            fbank_iir_free(p);
+            return (-2);
+         }
+         for(c = 0; c != nb; ++c) {
+             for(s = 0; s != nsec; ++s) {
+                 const float * __restrict q = &sos[(c*nsec+s)*6];
+                 const double ra0 = 1.0/(double)q[3];
+                 float * __restrict d = &p->c[s*5*hs+c];
+                 d[0*hs] = (float)((double)q[0]*ra0);
+                 d[1*hs] = (float)((double)q[1]*ra0);
+                 d[2*hs] = (float)((double)q[2]*ra0);
+                 d[3*hs] = (float)(-(double)q[4]*ra0);
+                 d[4*hs] = (float)(-(double)q[5]*ra0);
+             }
+         }
+         return (0);
+}
+
+int32_t fbank_iir_run(fbank_iir_t * __restrict p,
+                      const float * x,
+                      const int64_t n,
+                      float * y) {
+
+         const fbank_isa_tab_t * __restrict tab;
+         int64_t nchk,b;
+         int32_t par;
+         if(__builtin_expect(NULL==p || NULL==p->c || n<0,0)) return (-1);
+         if(n == 0) return (0);
+         if(__builtin_expect(NULL==x || NULL==y,0)) return (-1);
+         tab  = fb_tab();
+         nchk = (p->nch+FBANK_CHUNK-1)/FBANK_CHUNK;
+         par  = n*(int64_t)p->nch >= FBANK_OMP_MIN && nchk > 1;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(par) default(none) \
+        shared(tab,p,x,y) firstprivate(n,nchk)
+#endif
+         for(b = 0; b < nchk; ++b) {
+             const int32_t c0  = (int32_t)(b*FBANK_CHUNK);
+             const int32_t c1  = (p->nch-c0 < FBANK_CHUNK) ? p->nch : c0+FBANK_CHUNK;
+             const uint32_t csr = _mm_getcsr();
+             _mm_setcsr(csr | FB_MXCSR_FTZ_DAZ);
+             tab->iir(p,x,n,y,c0,c1);
+             _mm_setcsr(csr);
+         }
+         return (0);
+}
+
+void fbank_iir_reset(fbank_iir_t * __restrict p) {
+
+         if(NULL==p || NULL==p->z) return;
+         memset(p->z,0,(size_t)p->nsec*2*(size_t)p->nchp*sizeof(float));
+}
+
+void fbank_iir_free(fbank_iir_t * __restrict p) {
+
+         if(NULL==p) return;
+         if(NULL != p->c) _mm_free(p->c);
+         if(NULL != p->z) _mm_free(p->z);
+         p->c = NULL;
+         p->z = NULL;
+}
+
+
+/*
+     Validation
+*/
+static uint64_t fb_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double fb_draw(uint64_t * __restrict s,
+                      const double lo,
+                      const double hi) {
+
+         const double u = (double)(fb_rng(s) >> 11) * 0x1.0p-53;
+         return (lo*(1.0-u)+hi*u);
+}
+
+// Rows per validation stream and the largest block fed at once.
+#define FB_VROWS  1200
+#define FB_VBLOCK 257
+
+typedef struct {
+        int32_t ntap,up,down,pc,nch;
+} fb_fir_case_t;
+
+typedef struct {
+        int32_t nsec,pc,nch;
+} fb_iir_case_t;
+
+static const fb_fir_case_t fb_fir_cases[] = {
+        {  31,1,1,0, 37 },
+        {  64,1,4,1, 64 },
+        {  48,4,1,0, 19 },
+        {  65,3,2,1, 33 },
+        {   1,1,1,0,  5 },
+        {  17,5,3,0,100 },
+        { 200,1,8,0, 16 },
+        {  12,2,5,1,  7 }
+};
+
+static const fb_iir_case_t fb_iir_cases[] = {
+        { 1,0, 21 },
+        { 3,1, 64 },
+        { 6,0, 17 },
+        { 9,1, 40 },
+        { 4,0,  1 }
+};
+
+// Largest |y - r| relative to max|r| over nr rows.
+static double fb_err(const float * __restrict y,
+                     const double * __restrict r,
+                     const int64_t nr) {
+
+         double e = 0.0,rm = 0.0;
+         int64_t i;
+         for(i = 0; i != nr; ++i) {
+             const double d = fabs((double)y[i]-r[i]);
+             if(d > e) e = d;
+             if(fabs(r[i]) > rm) rm = fabs(r[i]);
+         }
+         return ((rm > 0.0) ? e/rm : e);
+}
+
+// Feeds x (FB_VROWS rows) in random blocks, then once more after the reset
+// in one call; returns the larger error, or -1 for a wrong row count.
+static double fb_fir_stream(fbank_fir_t * __restrict p,
+                            const float * __restrict x,
+                            float * __restrict y,
+                            const double * __restrict r,
+                            const int64_t nr,
+                            uint64_t * __restrict s) {
+
+         const int64_t nch = p->nch;
+         int64_t t = 0,m = 0;
+         double e;
+         while(t < FB_VROWS) {
+             int64_t nb = (int64_t)(fb_rng(s) % (FB_VBLOCK+1));
+             if(nb > FB_VROWS-t) nb = FB_VROWS-t;
+             m += fbank_fir_run(p,&x[t*nch],nb,&y[m*nch]);
+             t += nb;
+         }
+         if(m*nch != nr) return (-1.0);
+         e = fb_err(y,r,nr);
+         fbank_fir_reset(p);
+         if(fbank_fir_run(p,x,FB_VROWS,y)*nch != nr) return (-1.0);
+         return (fmax(e,fb_err(y,r,nr)));
+}
+
+static double fb_iir_stream(fbank_iir_t * __restrict p,
+                            const float * __restrict x,
+                            float * __restrict y,
+                            const double * __restrict r,
+                            uint64_t * __restrict s) {
+
+         const int64_t nch = p->nch;
+         int64_t t = 0;
+         double e;
+         while(t < FB_VROWS) {
+             int64_t nb = (int64_t)(fb_rng(s) % (FB_VBLOCK+1));
+             if(nb > FB_VROWS-t) nb = FB_VROWS-t;
+             fbank_iir_run(p,&x[t*nch],nb,&y[t*nch]);
+             t += nb;
+         }
+         e = fb_err(y,r,FB_VROWS*nch);
+         // In place, one call.
+         fbank_iir_reset(p);
+         memcpy(y,x,(size_t)(FB_VROWS*nch)*sizeof(float));
+         fbank_iir_run(p,y,FB_VROWS,y);
+         return (fmax(e,fb_err(y,r,FB_VROWS*nch)));
+}
+
+int32_t fbank_validate(FILE * __restrict fp,
+                       const uint64_t seed) {
+
+         const int32_t nfir = (int32_t)(sizeof(fb_fir_cases)/sizeof(fb_fir_cases[0]));
+         const int32_t niir = (int32_t)(sizeof(fb_iir_cases)/sizeof(fb_iir_cases[0]));
+         const int32_t isa0 = vmath_get_isa();
+         const int64_t cap  = (int64_t)FB_VROWS*5*100;   // rows x channels, U <= 5, nch <= 100
+         float  *x = NULL,*y = NULL,*h = NULL;
+         double *r = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t cs,isa;
+         if(NULL==fp) return (-1);
+         x = (float*)malloc((size_t)cap*sizeof(float));
+         y = (float*)malloc((size_t)cap*sizeof(float));
+         h = (float*)malloc((size_t)(200*100)*sizeof(float));
+         r = (double*)malloc((size_t)cap*sizeof(double));
+         if(NULL==x || NULL==y || NULL==h || NULL==r) {
+            nbad = -1;
+            goto done;
+         }
+         fprintf(fp,"Filter banks vs fp64 direct forms, %d rows, blocks of 0..%d, tol %.1e\n",
+                 FB_VROWS,FB_VBLOCK,(double)FBANK_TOL);
+         for(cs = 0; cs != nfir; ++cs) {
+             const fb_fir_case_t * __restrict q = &fb_fir_cases[cs];
+             const int64_t nch = q->nch;
+             const int64_t nh  = q->pc ? nch : 1;
+             const int64_t nu  = (int64_t)FB_VROWS*q->up;
+             const int64_t nr  = (nu+q->down-1)/q->down;
+             int64_t i,c,m,l;
+             for(i = 0; i != FB_VROWS*nch; ++i) x[i] = (float)fb_draw(&s,-1.0,1.0);
+             for(i = 0; i != nh*q->ntap; ++i) h[i] = (float)fb_draw(&s,-1.0,1.0);
+             // Zero-stuffed convolution, kept every D-th output.
+             for(m = 0; m != nr; ++m) {
+                 for(c = 0; c != nch; ++c) {
+                     const float * __restrict hc = &h[(q->pc ? c : 0)*q->ntap];
+                     double acc = 0.0;
+                     for(l = 0; l != q->ntap; ++l) {
+                         const int64_t u = m*q->down-l;
+                         if(u >= 0 && u%q->up == 0) acc += (double)hc[l]*(double)x[(u/q->up)*nch+c];
+                     }
+                     r[m*nch+c] = acc;
+                 }
+             }
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 fbank_fir_t p;
+                 double e;
+                 if(vmath_set_isa(isa)) continue;
+                 if(fbank_fir_init(&p,h,q->ntap,q->nch,q->up,q->down,q->pc)) {
+                    ++nbad;
+                    continue;
+                 }
+                 e = fb_fir_stream(&p,x,y,r,nr*nch,&s);
+                 fbank_fir_free(&p);
+                 if(e < 0.0 || e > (double)FBANK_TOL) ++nbad;
+                 fprintf(fp,"  fir ntap=%3d U=%d D=%d pc=%d nch=%3d isa %d  err %.3e%s\n",
+                         q->ntap,q->up,q->down,q->pc,q->nch,isa,e,
+                         (e < 0.0) ? "  ROWS" : ((e > (double)FBANK_TOL) ? "  FAIL" : ""));
+             }
+         }
+         for(cs = 0; cs != niir; ++cs) {
+             const fb_iir_case_t * __restrict q = &fb_iir_cases[cs];
+             const int64_t nch = q->nch;
+             const int64_t nb  = q->pc ? nch : 1;
+             int64_t i,c,t,k;
+             for(i = 0; i != FB_VROWS*nch; ++i) x[i] = (float)fb_draw(&s,-1.0,1.0);
+             // Poles of radius 0.2..0.97, any zeros, a0 in [0.5,2].
+             for(i = 0; i != nb*q->nsec; ++i) {
+                 const double rp = fb_draw(&s,0.2,0.97);
+                 const double th = fb_draw(&s,0.0,3.14159265358979323846);
+                 const double a0 = fb_draw(&s,0.5,2.0);
+                 h[i*6+0] = (float)(a0*fb_draw(&s,-1.0,1.0));
+                 h[i*6+1] = (float)(a0*fb_draw(&s,-1.0,1.0));
+                 h[i*6+2] = (float)(a0*fb_draw(&s,-1.0,1.0));
+                 h[i*6+3] = (float)a0;
+                 h[i*6+4] = (float)(-2.0*a0*rp*cos(th));
+                 h[i*6+5] = (float)(a0*rp*rp);
+             }
+             for(c = 0; c != nch; ++c) {
+                 for(t = 0; t != FB_VROWS; ++t) r[t*nch+c] = (double)x[t*nch+c];
+                 for(k = 0; k != q->nsec; ++k) {
+                     const float * __restrict sc = &h[((q->pc ? c : 0)*q->nsec+k)*6];
+                     const double ra0 = 1.0/(double)sc[3];
+                     double s1 = 0.0,s2 = 0.0;
+                     for(t = 0; t != FB_VROWS; ++t) {
+                         const double v = r[t*nch+c];
+                         const double o = (double)sc[0]*ra0*v+s1;
+                         s1 = (double)sc[1]*ra0*v-(double)sc[4]*ra0*o+s2;
+                         s2 = (double)sc[2]*ra0*v-(double)sc[5]*ra0*o;
+                         r[t*nch+c] = o;
+                     }
+                 }
+             }
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 fbank_iir_t p;
+                 double e;
+                 if(vmath_set_isa(isa)) continue;
+                 if(fbank_iir_init(&p,h,q->nsec,q->nch,q->pc)) {
+                    ++nbad;
+                    continue;
+                 }
+                 e = fb_iir_stream(&p,x,y,r,&s);
+                 fbank_iir_free(&p);
+                 if(e > (double)FBANK_TOL) ++nbad;
+                 fprintf(fp,"  iir nsec=%d pc=%d nch=%3d isa %d  err %.3e%s\n",
+                         q->nsec,q->pc,q->nch,isa,e,(e > (double)FBANK_TOL) ? "  FAIL" : "");
+             }
+         }
+         vmath_set_isa(isa0);
+done:
+         free(x);
+         free(y);
+         free(h);
+         free(r);
+         return (nbad);
+}
+
+
+/*
+     Benchmark
+*/
+static double fb_wtime(void) {
+
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+}
+
+typedef struct {
+        const char * name;
+        int32_t iir;          // 0: FIR, else IIR
+        int32_t ntap;         // taps or sections
+        int32_t up,down,pc;
+} fb_bench_case_t;
+
+static const fb_bench_case_t fb_bench_cases[] = {
+        { "fir 64 taps",         0,64,1,1,0 },
+        { "fir 64 taps pc",      0,64,1,1,1 },
+        { "fir 64 taps /4",      0,64,1,4,0 },
+        { "fir 64 taps x4",      0,64,4,1,0 },
+        { "iir 2 sections",      1, 2,1,1,0 },
+        { "iir 4 sections",      1, 4,1,1,0 },
+        { "iir 8 sections pc",   1, 8,1,1,1 }
+};
+
+// Seconds per call of one case (best of nrep calls after a warm-up).
+static double fb_bench_one(const fb_bench_case_t * __restrict q,
+                           const float * __restrict h,
+                           const float * __restrict x,
+                           float * __restrict y,
+                           const int32_t nch,
+                           const int64_t n,
+                           const int32_t nrep) {
+
+         double best = 1.0e30;
+         int32_t r;
+         if(q->iir) {
+            fbank_iir_t p;
+            if(fbank_iir_init(&p,h,q->ntap,nch,q->pc)) return (-1.0);
+            fbank_iir_run(&p,x,n,y);
+            for(r = 0; r != nrep; ++r) {
+                const double t0 = fb_wtime();
+                fbank_iir_run(&p,x,n,y);
+                best = fmin(best,fb_wtime()-t0);
+            }
+            fbank_iir_free(&p);
+         } else {
+            fbank_fir_t p;
+            if(fbank_fir_init(&p,h,q->ntap,nch,q->up,q->down,q->pc)) return (-1.0);
+            fbank_fir_run(&p,x,n,y);
+            for(r = 0; r != nrep; ++r) {
+                const double t0 = fb_wtime();
+                fbank_fir_run(&p,x,n,y);
+                best = fmin(best,fb_wtime()-t0);
+            }
+            fbank_fir_free(&p);
+         }
+         return (best);
+}
+
+void fbank_bench(FILE * __restrict fp,
+                 const int32_t nch,
+                 const int64_t n,
+                 const int32_t nrep) {
+
+         const int32_t ncase = (int32_t)(sizeof(fb_bench_cases)/sizeof(fb_bench_cases[0]));
+         const int32_t isa0  = vmath_get_isa();
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float *x = NULL,*y = NULL,*h = NULL;
+         uint64_t s = 0x5EED5EEDULL;
+         int32_t nthr = 1;
+         int32_t cs,isa;
+         int64_t i;
+         if(NULL==fp) fp = stdout;
+         if(__builtin_expect(nch<1 || n<1 || nrep<1,0)) return;
+#if defined(_OPENMP)
+         nthr = omp_get_max_threads();
+#endif
+         x = (float*)_mm_malloc((size_t)n*(size_t)nch*sizeof(float),64);
+         y = (float*)_mm_malloc((size_t)n*4*(size_t)nch*sizeof(float),64);
+         h = (float*)malloc((size_t)64*6*(size_t)nch*sizeof(float));
+         if(NULL==x || NULL==y || NULL==h) goto done;
+         for(i = 0; i != n*nch; ++i) x[i] = (float)fb_draw(&s,-1.0,1.0);
+         for(i = 0; i != 64*(int64_t)nch; ++i) h[i] = (float)fb_draw(&s,-0.1,0.1);
+         fprintf(fp,"# nch=%d rows=%lld, Msamples/s (rows x channels per second), best of %d\n",
+                 nch,(long long)n,nrep);
+         fprintf(fp,"# %-20s %-7s %12s %12s\n","case","isa","1 thread","threads");
+         for(cs = 0; cs != ncase; ++cs) {
+             const fb_bench_case_t * __restrict q = &fb_bench_cases[cs];
+             if(q->iir) {
+                // Stable sections: poles at radius 0.9.
+                for(i = 0; i != q->ntap*(int64_t)nch; ++i) {
+                    const double th = fb_draw(&s,0.1,3.0);
+                    h[i*6+0] = 0.2f; h[i*6+1] = 0.1f; h[i*6+2] = 0.2f;
+                    h[i*6+3] = 1.0f;
+                    h[i*6+4] = (float)(-1.8*cos(th));
+                    h[i*6+5] = 0.81f;
+                }
+             } else {
+                for(i = 0; i != 64*(int64_t)nch; ++i) h[i] = (float)fb_draw(&s,-0.1,0.1);
+             }
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 const double sps = (double)n*(double)nch*1.0e-6;
+                 double t1,tn;
+                 if(vmath_set_isa(isa)) continue;
+#if defined(_OPENMP)
+                 omp_set_num_threads(1);
+#endif
+                 t1 = fb_bench_one(q,h,x,y,nch,n,nrep);
+#if defined(_OPENMP)
+                 omp_set_num_threads(nthr);
+#endif
+                 tn = fb_bench_one(q,h,x,y,nch,n,nrep);
+                 fprintf(fp,"  %-20s %-7s %12.1f %12.1f\n",q->name,isan[isa],sps/t1,sps/tn);
+             }
+         }
+         vmath_set_isa(isa0);
+done:
+         if(NULL != x) _mm_free(x);
+         if(NULL != y) _mm_free(y);
+         free(h);
+}
@@ -0,0 +1,159 @@
+
+
+#ifndef __GMS_FILTER_BANK_H__
+#define __GMS_FILTER_BANK_H__ 191020260300
+
+//
+// Streaming multi-channel FIR (polyphase resampling) and IIR biquad
+// cascade filter banks over AVX2/AVX512.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 03:00 AM +00200
+//
+// Samples are fp32 and channel-interleaved: x[t*nch + c] is sample t of
+// channel c (one row per time step, e.g. the element or beam outputs of
+// a seeker/radar front end). Channels run in the lanes of the vectors
+// (16 per zmm, 8 per ymm) and time runs in the loops, so every channel
+// of a bank may have its own coefficients (pc != 0) or share one set.
+// I/Q data with real coefficients is a bank of 2*nch channels.
+//
+// FIR: polyphase rational resampler y = (down-sample by D) of h * (up-
+// sample by U with zeros) of x. U = D = 1 is a plain FIR, U = 1 a
+// decimator, D = 1 an interpolator (h carries the gain U). The taps are
+// split into U phases of ceil(ntap/U) taps, and only the kept outputs
+// are computed: ntap/D multiply-adds per input sample and channel.
+// IIR: cascades of second-order sections in transposed direct form II,
+// sos = {b0,b1,b2,a0,a1,a2} per section (a0 normalises the rest).
+//
+// State (the last ceil(ntap/U)-1 input rows, the resampling phase, the
+// two delays of each section) is carried from one call to the next, so
+// a stream may be fed in blocks of any length with the same result as
+// one call over the whole stream. *_reset clears it.
+//
+// Channels are split into chunks of FBANK_CHUNK and the chunks run in
+// parallel (OpenMP) when n*nch >= FBANK_OMP_MIN. Inside a chunk, time is
+// tiled by FBANK_TILE input rows; the FIR packs the rows of a tile (and
+// the history before it) of one channel vector into a contiguous buffer,
+// so the taps walk 64-byte rows instead of nch-float strides (which alias
+// in L1 when nch is a power of two). Rows that are a multiple of 64 bytes
+// keep the chunks on separate cache lines. The kernels run with FTZ/DAZ
+// set (decaying IIR states do not fall into denormals) and restore MXCSR.
+// The ISA is the one of vmath_get_isa() (GMS_vmath.h).
+// Return values: 0 (or the number of output rows) success, -1 invalid
+// argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Channels per parallel chunk (multiple of 16).
+#if !defined(FBANK_CHUNK)
+#define FBANK_CHUNK 64
+#endif
+
+// Input rows per time tile.
+#if !defined(FBANK_TILE)
+#define FBANK_TILE 512
+#endif
+
+// Smallest n*nch that runs the chunks in parallel.
+#if !defined(FBANK_OMP_MIN)
+#define FBANK_OMP_MIN 65536
+#endif
+
+// Documented agreement with the fp64 direct-form references (relative to
+// max|y| of each test case).
+#define FBANK_TOL 1.0e-5f
+
+
+typedef struct {
+        float   * __restrict hp;   // polyphase taps [U][lp][hs]
+        float   * __restrict z;    // history [lp-1][nch]
+        int64_t  pos;              // next output, upsampled index rel. to the next row
+        int32_t  nch;
+        int32_t  ntap;
+        int32_t  up;               // U
+        int32_t  down;             // D
+        int32_t  lp;               // taps per phase, ceil(ntap/U)
+        int32_t  pc;               // per-channel taps
+        int32_t  hs;               // 1, or nch rounded up to 16 (pc)
+        int32_t  pad;
+} fbank_fir_t;
+
+typedef struct {
+        float   * __restrict c;    // {b0,b1,b2,-a1,-a2}/a0 per section [nsec][5][hs]
+        float   * __restrict z;    // delays [nsec][2][nchp]
+        int32_t  nch;
+        int32_t  nchp;             // nch rounded up to 16
+        int32_t  nsec;
+        int32_t  pc;               // per-channel sections
+        int32_t  hs;               // 1, or nchp (pc)
+        int32_t  pad;
+} fbank_iir_t;
+
+
+// Builds the FIR bank. h: ntap taps, or ntap taps per channel (pc != 0,
+// channel-major h[c*ntap + k]). up, down >= 1.
+int32_t fbank_fir_init(fbank_fir_t * __restrict,
+                       const float * __restrict,   // h
+                       const int32_t,              // ntap
+                       const int32_t,              // nch
+                       const int32_t,              // up
+                       const int32_t,              // down
+                       const int32_t);             // pc
+
+// Output rows of the next call with n input rows.
+int64_t fbank_fir_nout(const fbank_fir_t * __restrict,
+                       const int64_t);
+
+// Filters n input rows x into fbank_fir_nout(n) output rows y (x and y
+// must not overlap) and returns their number.
+int64_t fbank_fir_run(fbank_fir_t * __restrict,
+                      const float * __restrict,    // x
+                      const int64_t,               // n
+                      float * __restrict)          // y
+                                        __attribute__((hot));
+
+void    fbank_fir_reset(fbank_fir_t * __restrict);
+
+void    fbank_fir_free(fbank_fir_t * __restrict);
+
+// Builds the IIR bank. sos: nsec x {b0,b1,b2,a0,a1,a2}, or nsec sections
+// per channel (pc != 0, channel-major sos[(c*nsec + s)*6 + k]).
+int32_t fbank_iir_init(fbank_iir_t * __restrict,
+                       const float * __restrict,   // sos
+                       const int32_t,              // nsec
+                       const int32_t,              // nch
+                       const int32_t);             // pc
+
+// Filters n rows; y may be x (in place).
+int32_t fbank_iir_run(fbank_iir_t * __restrict,
+                      const float *,               // x
+                      const int64_t,               // n
+                      float *)                     // y
+                                        __attribute__((hot));
+
+void    fbank_iir_reset(fbank_iir_t * __restrict);
+
+void    fbank_iir_free(fbank_iir_t * __restrict);
+
+// Feeds random streams in random block lengths through every ISA the host
+// runs and compares with fp64 direct-form references (zero-stuffed
+// convolution, per-sample biquads); prints one line per case and ISA and
+// returns the number over FBANK_TOL.
+int32_t fbank_validate(FILE * __restrict,
+                       const uint64_t);            // seed
+
+// Throughput in Msamples/s (input rows x channels per second) of plain,
+// decimating and interpolating FIR banks and of IIR cascades, per ISA,
+// on one thread and on all threads.
+void    fbank_bench(FILE * __restrict,
+                    const int32_t,                 // nch
+                    const int64_t,                 // n rows per call
+                    const int32_t)                 // nrep
+                                        __attribute__((cold));
+
+
+
+
+#endif /*__GMS_FILTER_BANK_H__*/
@@ -0,0 +1,48 @@
+
+
+//
+// AVX2/FMA instantiation of the filter bank kernels (GMS_filter_bank.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 03:00 AM +00200
+//
+// The unit carries its own target; GMS_filter_bank.c calls into it only
+// when vmath_get_isa() reports AVX2. Tail channels use vmaskmovps.
+//
+
+#pragma GCC target("avx2,fma")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_filter_bank_private.h"
+
+
+typedef __m256  vf;
+typedef __m256i vm;
+
+#define VF_W  8
+#define FB_RB 8
+
+#define FB_PRIM static inline __attribute__((always_inline))
+
+
+FB_PRIM vf vf_c(const float c)                   { return _mm256_set1_ps(c); }
+FB_PRIM vf vf_load(const float * __restrict p)   { return _mm256_loadu_ps(p); }
+FB_PRIM void vf_store(float * __restrict p, const vf x) { _mm256_storeu_ps(p,x); }
+FB_PRIM vf vf_mul(const vf a, const vf b)        { return _mm256_mul_ps(a,b); }
+FB_PRIM vf vf_fma(const vf a, const vf b, const vf c) { return _mm256_fmadd_ps(a,b,c); }
+// Lanes 0..nc-1.
+FB_PRIM vm vf_mask(const int32_t nc) {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(nc),_mm256_setr_epi32(0,1,2,3,4,5,6,7));
+}
+FB_PRIM vf vf_loadm(const float * __restrict p, const vm k) { return _mm256_maskload_ps(p,k); }
+FB_PRIM void vf_storem(float * __restrict p, const vm k, const vf x) { _mm256_maskstore_ps(p,k,x); }
+
+
+#include "GMS_filter_bank_kernels.h"
+
+
+const fbank_isa_tab_t fbank_tab_avx2 = {
+        fb_fir_kernel,
+        fb_iir_kernel,
+        VF_W
+};
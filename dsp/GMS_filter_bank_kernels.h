@@ -0,0 +1,326 @@
+
+
+#ifndef __GMS_FILTER_BANK_KERNELS_H__
+#define __GMS_FILTER_BANK_KERNELS_H__
+
+//
+// Filter bank kernels over a per-ISA primitive layer; included by
+// GMS_filter_bank.c (one lane), GMS_filter_bank_avx2.c and
+// GMS_filter_bank_avx512.c after they define vf/vm, VF_W, FB_RB and the
+// vf_* primitives.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 03:00 AM +00200
+//
+// One lane per channel. The FIR packs a tile of one channel vector into
+// contiguous rows and computes FB_RB output rows of one phase at once, so each tap is
+// fetched (broadcast) once for FB_RB multiply-adds and the FB_RB
+// accumulators hide the FMA latency. Coefficients and IIR delays are
+// padded to whole vectors; only the samples use masks. The IIR runs FB_SP
+// sections per pass over a tile with the delays in registers; the
+// sections of one row depend on each other but row t+1 of section s
+// overlaps row t of section s+1.
+//
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_filter_bank_private.h"
+
+
+#define FB_INLINE static inline __attribute__((always_inline))
+
+// Sections per IIR pass.
+#define FB_SP 4
+
+
+FB_INLINE vf fb_ld(const float * __restrict p,
+                   const vm k,
+                   const int32_t full) {
+         return (full ? vf_load(p) : vf_loadm(p,k));
+}
+
+FB_INLINE void fb_st(float * __restrict p,
+                     const vm k,
+                     const vf v,
+                     const int32_t full) {
+         if(full) vf_store(p,v);
+         else     vf_storem(p,k,v);
+}
+
+// Coefficient j: broadcast, or the vector of the channels (pc, stride hs;
+// padded to whole vectors).
+FB_INLINE vf fb_coef(const float * __restrict h,
+                     const int64_t j,
+                     const int64_t hs,
+                     const int32_t pc) {
+         return (pc ? vf_load(h+j*hs) : vf_c(h[j]));
+}
+
+
+/*
+     FIR
+*/
+
+// First output whose input row is >= t.
+FB_INLINE int64_t fb_fir_first(const fbank_fir_t * __restrict p,
+                               const int64_t t,
+                               const int64_t nout) {
+         const int64_t nu = t*p->up-p->pos;
+         const int64_t m  = (nu > 0) ? (nu+p->down-1)/p->down : 0;
+         return ((m < nout) ? m : nout);
+}
+
+// Rows [t0-lp+1,t1) of the channel vector c, history first, into w.
+FB_INLINE void fb_fir_pack(const fbank_fir_t * __restrict p,
+                           const float * __restrict x,
+                           float * __restrict w,
+                           const int64_t t0,
+                           const int64_t t1,
+                           const int32_t c,
+                           const vm k,
+                           const int32_t full) {
+         const int64_t nch = p->nch;
+         const int64_t i0  = t0-(p->lp-1);
+         int64_t i = i0;
+         for(; i < 0; ++i)  vf_store(w+(i-i0)*VF_W,fb_ld(p->z+(i+p->lp-1)*nch+c,k,full));
+         for(; i < t1; ++i) vf_store(w+(i-i0)*VF_W,fb_ld(x+i*nch+c,k,full));
+}
+
+// One output: packed row wr of its input row, taps h of its phase.
+FB_INLINE vf fb_fir_dot(const float * __restrict wr,
+                        const float * __restrict h,
+                        const int64_t hs,
+                        const int64_t lp,
+                        const int32_t pc) {
+         vf acc = vf_c(0.0f);
+         int64_t j;
+         for(j = 0; j != lp; ++j) acc = vf_fma(fb_coef(h,j,hs,pc),vf_load(wr-j*VF_W),acc);
+         return (acc);
+}
+
+// FB_RB outputs of one phase, packed rows d apart from wr, y rows ys apart.
+FB_INLINE void fb_fir_blk1(const float * __restrict wr,
+                           const float * __restrict h,
+                           const int64_t hs,
+                           const int64_t lp,
+                           const int64_t d,
+                           float * __restrict y,
+                           const int64_t ys,
+                           const vm k,
+                           const int32_t full,
+                           const int32_t pc) {
+         vf a[FB_RB];
+         int64_t j;
+         int32_t i;
+#pragma GCC unroll 16
+         for(i = 0; i != FB_RB; ++i) a[i] = vf_c(0.0f);
+         for(j = 0; j != lp; ++j) {
+             const vf hj = fb_coef(h,j,hs,pc);
+             const float * __restrict r = wr-j*VF_W;
+#pragma GCC unroll 16
+             for(i = 0; i != FB_RB; ++i) a[i] = vf_fma(hj,vf_load(r+i*d*VF_W),a[i]);
+         }
+#pragma GCC unroll 16
+         for(i = 0; i != FB_RB; ++i) fb_st(y+i*ys,k,a[i],full);
+}
+
+// Outputs [m0,m1) of one packed tile starting at input row t0. The outputs
+// m = r, r+L, r+2L, ... (L = U/gcd(U,D)) use one phase and their rows
+// advance by d = D/gcd(U,D), so every residue class r is a plain FIR
+// with rows d apart and outputs L rows apart.
+FB_INLINE void fb_fir_tile(const fbank_fir_t * __restrict p,
+                           const float * __restrict w,
+                           float * __restrict y,
+                           const int64_t t0,
+                           const int64_t m0,
+                           const int64_t m1,
+                           const int32_t c,
+                           const vm k,
+                           const int32_t full,
+                           const int64_t L,
+                           const int64_t d,
+                           const int32_t pc) {
+         const int64_t nch = p->nch;
+         const int64_t lp  = p->lp;
+         const int64_t hs  = p->hs;
+         const int64_t U   = p->up;
+         const int64_t ys  = L*nch;
+         const int64_t w0  = lp-1-t0;      // packed row of input row 0
+         const float * __restrict h0 = p->hp+(pc ? c : 0);
+         int64_t r;
+         for(r = 0; r != L; ++r) {
+             const int64_t m = m0+((r-m0%L)+L)%L;
+             int64_t pm,idx,cnt,q;
+             const float * __restrict wr;
+             const float * __restrict h;
+             float * __restrict yr;
+             if(m >= m1) continue;
+             pm  = p->pos+m*p->down;
+             idx = pm/U;
+             cnt = (m1-m+L-1)/L;
+             wr  = w+(w0+idx)*VF_W;
+             h   = h0+(pm-idx*U)*lp*hs;
+             yr  = y+m*nch+c;
+             for(q = 0; q+FB_RB <= cnt; q += FB_RB)
+                 fb_fir_blk1(wr+q*d*VF_W,h,hs,lp,d,yr+q*ys,ys,k,full,pc);
+             for(; q < cnt; ++q)
+                 fb_st(yr+q*ys,k,fb_fir_dot(wr+q*d*VF_W,h,hs,lp,pc),full);
+         }
+}
+
+FB_INLINE void fb_fir_tile_pc(const fbank_fir_t * __restrict p,
+                              const float * __restrict w,
+                              float * __restrict y,
+                              const int64_t t0,
+                              const int64_t m0,
+                              const int64_t m1,
+                              const int32_t c,
+                              const vm k,
+                              const int32_t full,
+                              const int64_t L,
+                              const int64_t d) {
+         // Constant row step and tap kind in the inner loops.
+         if(d == 1) {
+            if(p->pc) fb_fir_tile(p,w,y,t0,m0,m1,c,k,full,L,1,1);
+            else      fb_fir_tile(p,w,y,t0,m0,m1,c,k,full,L,1,0);
+         } else {
+            if(p->pc) fb_fir_tile(p,w,y,t0,m0,m1,c,k,full,L,d,1);
+            else      fb_fir_tile(p,w,y,t0,m0,m1,c,k,full,L,d,0);
+         }
+}
+
+static int32_t fb_fir_kernel(const fbank_fir_t * __restrict p,
+                             const float * __restrict x,
+                             const int64_t n,
+                             float * __restrict y,
+                             const int64_t nout,
+                             const int32_t c0,
+                             const int32_t c1) {
+         const int32_t nv = (c1-c0)/VF_W*VF_W;
+         const vm k = vf_mask(c1-c0-nv);
+         int64_t g = p->up,h = p->down,L,d,t0;
+         float * __restrict w;
+         int32_t c;
+         while(h != 0) {
+               const int64_t t = g%h;
+               g = h;
+               h = t;
+         }
+         L = p->up/g;
+         d = p->down/g;
+         w = (float*)_mm_malloc((size_t)(p->lp-1+FBANK_TILE)*VF_W*sizeof(float),64);
+         if(__builtin_expect(NULL==w,0)) return (-2);
+         for(t0 = 0; t0 < n; t0 += FBANK_TILE) {
+             const int64_t t1 = (n-t0 < FBANK_TILE) ? n : t0+FBANK_TILE;
+             const int64_t m0 = fb_fir_first(p,t0,nout);
+             const int64_t m1 = fb_fir_first(p,t1,nout);
+             if(m0 == m1) continue;
+             for(c = c0; c != c0+nv; c += VF_W) {
+                 fb_fir_pack(p,x,w,t0,t1,c,k,1);
+                 fb_fir_tile_pc(p,w,y,t0,m0,m1,c,k,1,L,d);
+             }
+             if(c != c1) {
+                fb_fir_pack(p,x,w,t0,t1,c,k,0);
+                fb_fir_tile_pc(p,w,y,t0,m0,m1,c,k,0,L,d);
+             }
+         }
+         _mm_free(w);
+         return (0);
+}
+
+
+/*
+     IIR
+*/
+
+// Sections [s0,s0+ns) over rows [t0,t1) of one channel vector; src is x
+// for the first pass and y after it.
+FB_INLINE void fb_iir_pass(const fbank_iir_t * __restrict p,
+                           const float * src,
+                           float * y,
+                           const int64_t t0,
+                           const int64_t t1,
+                           const int32_t c,
+                           const vm k,
+                           const int32_t full,
+                           const int32_t s0,
+                           const int32_t ns) {
+         const int64_t nch = p->nch;
+         const int64_t hs  = p->hs;
+         const int64_t zs  = p->nchp;
+         const int32_t pc  = p->pc;
+         const float * __restrict cf = p->c+(int64_t)s0*5*hs+(pc ? c : 0);
+         float * __restrict z = p->z+(int64_t)s0*2*zs+c;
+         vf b0[FB_SP],b1[FB_SP],b2[FB_SP],na1[FB_SP],na2[FB_SP];
+         vf s1[FB_SP],s2[FB_SP];
+         int64_t t;
+         int32_t s;
+#pragma GCC unroll 4
+         for(s = 0; s < ns; ++s) {
+             b0[s]  = fb_coef(cf,s*5+0,hs,pc);
+             b1[s]  = fb_coef(cf,s*5+1,hs,pc);
+             b2[s]  = fb_coef(cf,s*5+2,hs,pc);
+             na1[s] = fb_coef(cf,s*5+3,hs,pc);
+             na2[s] = fb_coef(cf,s*5+4,hs,pc);
+             s1[s]  = vf_load(z+(2*s+0)*zs);
+             s2[s]  = vf_load(z+(2*s+1)*zs);
+         }
+         for(t = t0; t != t1; ++t) {
+             vf v = fb_ld(src+t*nch+c,k,full);
+#pragma GCC unroll 4
+             for(s = 0; s < ns; ++s) {
+                 const vf o = vf_fma(b0[s],v,s1[s]);
+                 s1[s] = vf_fma(na1[s],o,vf_fma(b1[s],v,s2[s]));
+                 s2[s] = vf_fma(na2[s],o,vf_mul(b2[s],v));
+                 v = o;
+             }
+             fb_st(y+t*nch+c,k,v,full);
+         }
+#pragma GCC unroll 4
+         for(s = 0; s < ns; ++s) {
+             vf_store(z+(2*s+0)*zs,s1[s]);
+             vf_store(z+(2*s+1)*zs,s2[s]);
+         }
+}
+
+FB_INLINE void fb_iir_span(const fbank_iir_t * __restrict p,
+                           const float * x,
+                           float * y,
+                           const int64_t t0,
+                           const int64_t t1,
+                           const int32_t c,
+                           const vm k,
+                           const int32_t full) {
+         const float * src = x;
+         int32_t s0;
+         for(s0 = 0; s0 < p->nsec; s0 += FB_SP) {
+             switch(p->nsec-s0) {
+             case 1:  fb_iir_pass(p,src,y,t0,t1,c,k,full,s0,1); break;
+             case 2:  fb_iir_pass(p,src,y,t0,t1,c,k,full,s0,2); break;
+             case 3:  fb_iir_pass(p,src,y,t0,t1,c,k,full,s0,3); break;
+             default: fb_iir_pass(p,src,y,t0,t1,c,k,full,s0,FB_SP); break;
+             }
+             src = y;
+         }
+}
+
+static void fb_iir_kernel(const fbank_iir_t * __restrict p,
+                          const float * x,
+                          const int64_t n,
+                          float * y,
+                          const int32_t c0,
+                          const int32_t c1) {
+         const int32_t nv = (c1-c0)/VF_W*VF_W;
+         const vm k = vf_mask(c1-c0-nv);
+         int64_t t0;
+         int32_t c;
+         for(t0 = 0; t0 < n; t0 += FBANK_TILE) {
+             const int64_t t1 = (n-t0 < FBANK_TILE) ? n : t0+FBANK_TILE;
+             for(c = c0; c != c0+nv; c += VF_W) fb_iir_span(p,x,y,t0,t1,c,k,1);
+             if(c != c1) fb_iir_span(p,x,y,t0,t1,c,k,0);
+         }
+}
+
+
+
+
+#endif /*__GMS_FILTER_BANK_KERNELS_H__*/
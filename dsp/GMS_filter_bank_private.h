@@ -0,0 +1,49 @@
+
+
+#ifndef __GMS_FILTER_BANK_PRIVATE_H__
+#define __GMS_FILTER_BANK_PRIVATE_H__
+
+//
+// Kernel tables of the filter banks (GMS_filter_bank.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 03:00 AM +00200
+//
+
+#include <stdint.h>
+#include "GMS_filter_bank.h"
+
+
+// FIR outputs m = 0..nout-1 of the channels [c0,c1) from the n rows x and
+// the history p->z (read only). Output m is at the upsampled index
+// p->pos + m*D: row idx = that/U of the input, phase = that%U.
+// Returns -2 when the packing buffer cannot be allocated.
+typedef int32_t (*fbank_fir_fn)(const fbank_fir_t * __restrict,
+                                const float * __restrict,   // x
+                                const int64_t,              // n
+                                float * __restrict,         // y
+                                const int64_t,              // nout
+                                const int32_t,              // c0
+                                const int32_t);             // c1
+
+// IIR rows 0..n-1 of the channels [c0,c1); updates p->z of the chunk.
+typedef void (*fbank_iir_fn)(const fbank_iir_t * __restrict,
+                             const float *,              // x
+                             const int64_t,              // n
+                             float *,                    // y
+                             const int32_t,              // c0
+                             const int32_t);             // c1
+
+typedef struct {
+        fbank_fir_fn fir;
+        fbank_iir_fn iir;
+        int32_t      width;     // floats per vector
+} fbank_isa_tab_t;
+
+extern const fbank_isa_tab_t fbank_tab_scalar;
+extern const fbank_isa_tab_t fbank_tab_avx2;
+extern const fbank_isa_tab_t fbank_tab_avx512;
+
+
+
+
+#endif /*__GMS_FILTER_BANK_PRIVATE_H__*/
@@ -0,0 +1,536 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <immintrin.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "GMS_range_doppler.h"
+#include "GMS_fft_batch_private.h"
+#include "GMS_vmath.h"
+
+//
+// Plan and CPI driver of the range-Doppler pipeline; validation and
+// benchmark.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 05:00 AM +00200
+//
+
+
+#define RD_L FFTB_LANES
+
+static float * rd_alloc(const int64_t n) {
+
+         float * __restrict p = (float*)_mm_malloc((size_t)(n > 0 ? n : 1)*sizeof(float),64);
+         if(NULL != p) memset(p,0,(size_t)(n > 0 ? n : 1)*sizeof(float));
+         return (p);
+}
+
+double rdm_window(const int32_t type,
+                  const int32_t k,
+                  const int32_t n) {
+
+         const double x = (n > 1) ? 6.283185307179586476925286766559*(double)k/(double)(n-1) : 0.0;
+         switch(type) {
+         case RDM_WIN_HANN:     return (0.5-0.5*cos(x));
+         case RDM_WIN_HAMMING:  return (0.54-0.46*cos(x));
+         case RDM_WIN_BLACKMAN: return (0.42-0.5*cos(x)+0.08*cos(2.0*x));
+         default:               return (1.0);
+         }
+}
+
+
+/*
+     Plan
+*/
+int32_t rdm_init(rdm_plan_t * __restrict p,
+                 const float * __restrict ref,
+                 const int32_t nref,
+                 const int32_t nsamp,
+                 const int32_t npulse,
+                 const int32_t ndop,
+                 const int32_t wr,
+                 const int32_t wd,
+                 const int32_t cft,
+                 const int32_t guard,
+                 const int32_t train,
+                 const float pfa) {
+
+         float * __restrict h = NULL;
+         int64_t k;
+         int32_t st;
+         if(__builtin_expect(NULL==p || NULL==ref,0)) return (-1);
+         memset(p,0,sizeof(*p));
+         if(__builtin_expect(nref<1 || nsamp<1 || npulse<1 || guard<0 || train<0,0)) return (-1);
+         if(__builtin_expect(wr<RDM_WIN_RECT || wr>RDM_WIN_BLACKMAN ||
+                             wd<RDM_WIN_RECT || wd>RDM_WIN_BLACKMAN,0)) return (-1);
+         if(__builtin_expect(ndop != 0 && (ndop < npulse || fftb_good_size(ndop) != ndop),0)) return (-1);
+         p->nref   = nref;
+         p->nsamp  = nsamp;
+         p->npulse = npulse;
+         p->nrange = nsamp;
+         p->nfft   = fftb_good_size(nsamp+nref-1);
+         p->ndop   = (ndop != 0) ? ndop : fftb_good_size(npulse);
+         p->nrb    = (nsamp+RD_L-1)/RD_L;
+         p->nrow   = p->nfft;
+         if(p->ndop > p->nrow)     p->nrow = p->ndop;
+         if(p->nrb*RD_L > p->nrow) p->nrow = p->nrb*RD_L;
+         p->cfon   = (train > 0);
+         p->nthr   = 1;
+#if defined(_OPENMP)
+         p->nthr   = omp_get_max_threads();
+#endif
+         if((st = fftb_plan_init(&p->pr,p->nfft)) != 0 ||
+            (st = fftb_plan_init(&p->pd,p->ndop)) != 0 ||
+            (p->cfon && (st = cfar_init(&p->cf,cft,p->ndop,nsamp,0,guard,0,train,0,pfa)) != 0)) {
+            rdm_free(p);
+            return (st);
+         }
+         p->hre  = rd_alloc(p->nfft);
+         p->him  = rd_alloc(p->nfft);
+         p->wd   = rd_alloc(npulse);
+         p->cre  = rd_alloc((int64_t)p->nrb*npulse*RD_L);
+         p->cim  = rd_alloc((int64_t)p->nrb*npulse*RD_L);
+         p->work = rd_alloc((int64_t)p->nthr*4*p->nrow*RD_L);
+         h = rd_alloc(2*(int64_t)p->nfft);
+         if(__builtin_expect(NULL==p->hre || NULL==p->him || NULL==p->wd || NULL==p->cre ||
+                             NULL==p->cim || NULL==p->work || NULL==h,0)) {
+            if(NULL != h) _mm_free(h);
+            rdm_free(p);
+            return (-2);
+         }
+         // Matched filter: conj(FFT(wr * ref)), with the 1/nfft of the
+         // unscaled inverse folded in.
+         for(k = 0; k != nref; ++k) {
+             const float w = (float)rdm_window(wr,(int32_t)k,nref);
+             h[2*k]   = w*ref[2*k];
+             h[2*k+1] = w*ref[2*k+1];
+         }
+         st = fftb_c2c(&p->pr,h,1,p->nfft,FFTB_FORWARD);
+         for(k = 0; k != p->nfft; ++k) {
+             p->hre[k] =  h[2*k]/(float)p->nfft;
+             p->him[k] = -h[2*k+1]/(float)p->nfft;
+         }
+         _mm_free(h);
+         if(st != 0) {
+            rdm_free(p);
+            return (st);
+         }
+         for(k = 0; k != npulse; ++k) p->wd[k] = (float)rdm_window(wd,(int32_t)k,npulse);
+         return (0);
+}
+
+void rdm_free(rdm_plan_t * __restrict p) {
+
+         if(NULL==p) return;
+         fftb_plan_free(&p->pr);
+         fftb_plan_free(&p->pd);
+         cfar_free(&p->cf);
+         if(NULL != p->hre)  _mm_free(p->hre);
+         if(NULL != p->him)  _mm_free(p->him);
+         if(NULL != p->wd)   _mm_free(p->wd);
+         if(NULL != p->cre)  _mm_free(p->cre);
+         if(NULL != p->cim)  _mm_free(p->cim);
+         if(NULL != p->work) _mm_free(p->work);
+         p->hre = p->him = p->wd = p->cre = p->cim = p->work = NULL;
+}
+
+
+/*
+     CPI
+*/
+int32_t rdm_run(rdm_plan_t * __restrict p,
+                const float * __restrict x,
+                const int64_t ldx,
+                float * __restrict map,
+                uint64_t * __restrict det,
+                int64_t * __restrict ndet) {
+
+         const fftb_isa_tab_t * __restrict t = fftb_tab();
+         int32_t npb,par;
+         if(__builtin_expect(NULL==p || NULL==p->work || NULL==x || NULL==map,0)) return (-1);
+         if(__builtin_expect(ldx<p->nsamp,0)) return (-1);
+         npb = (p->npulse+RD_L-1)/RD_L;
+         par = (npb >= 2*RDM_OMP_MIN || p->nrb >= 2*RDM_OMP_MIN) && p->nthr > 1;
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(p->nthr) if(par) default(none) \
+        shared(p,t,x,map) firstprivate(ldx,npb)
+#endif
+         {
+             const int64_t nr  = (int64_t)p->nrow*RD_L;
+             int32_t tid = 0;
+             float * __restrict re;
+             float * __restrict im;
+             float * __restrict w0;
+             float * __restrict w1;
+             int32_t j,b;
+#if defined(_OPENMP)
+             tid = omp_get_thread_num();
+#endif
+             re = p->work+4*nr*tid;
+             im = re+nr;
+             w0 = im+nr;
+             w1 = w0+nr;
+             // Pulse compression of 16 pulses per block, then the corner
+             // turn into the cube (gates in lanes).
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+             for(j = 0; j < npb; ++j) {
+                 const int32_t np = (p->npulse-j*RD_L < RD_L) ? p->npulse-j*RD_L : RD_L;
+                 t->pack(x+2*(int64_t)j*RD_L*ldx,ldx,np,p->nsamp,p->nfft,re,im);
+                 t->blk(&p->pr,re,im,w0,w1);
+                 t->cmul(re,im,p->nfft,p->hre,p->him);
+                 t->blk(&p->pr,im,re,w1,w0);
+                 for(b = 0; b < p->nrb; ++b) {
+                     const int64_t o = ((int64_t)b*p->npulse+(int64_t)j*RD_L)*RD_L;
+                     t->tr(re+b*RD_L*RD_L,RD_L,p->cre+o,RD_L,np);
+                     t->tr(im+b*RD_L*RD_L,RD_L,p->cim+o,RD_L,np);
+                 }
+             }
+             // Slow-time window, FFT and power of 16 gates per block.
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+             for(b = 0; b < p->nrb; ++b) {
+                 const int64_t o  = (int64_t)b*p->npulse*RD_L;
+                 const int32_t nl = (p->nrange-b*RD_L < RD_L) ? p->nrange-b*RD_L : RD_L;
+                 t->win(p->cre+o,p->cim+o,p->wd,p->npulse,p->ndop,re,im);
+                 t->blk(&p->pd,re,im,w0,w1);
+                 t->pow(re,im,p->ndop,p->ndop/2,map+b*RD_L,p->nrange,nl);
+             }
+         }
+         if(NULL != det && p->cfon) return (cfar_run(&p->cf,map,p->nrange,det,NULL,ndet));
+         if(NULL != ndet) *ndet = 0;
+         return (0);
+}
+
+
+/*
+     Validation
+*/
+static uint64_t rd_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static double rd_draw(uint64_t * __restrict s,
+                      const double lo,
+                      const double hi) {
+
+         const double u = (double)(rd_rng(s) >> 11) * 0x1.0p-53;
+         return (lo*(1.0-u)+hi*u);
+}
+
+// Unit-power complex Gaussian sample (Box-Muller).
+static void rd_cnoise(uint64_t * __restrict s,
+                      float * __restrict z) {
+
+         const double u = rd_draw(s,0x1.0p-53,1.0);
+         const double a = rd_draw(s,0.0,6.283185307179586476925286766559);
+         const double r = sqrt(-log(u));
+         z[0] = (float)(r*cos(a));
+         z[1] = (float)(r*sin(a));
+}
+
+typedef struct {
+        int32_t nsamp,nref,npulse,ndop,wr,wd;
+} rd_case_t;
+
+static const rd_case_t rd_cases[] = {
+        {  200, 31,40, 0,RDM_WIN_RECT,    RDM_WIN_HANN     },
+        {   77, 13,17,20,RDM_WIN_HANN,    RDM_WIN_RECT     },
+        { 1000,128,64, 0,RDM_WIN_HAMMING, RDM_WIN_BLACKMAN },
+        {   16,  1, 1, 0,RDM_WIN_RECT,    RDM_WIN_RECT     }
+};
+
+// Direct correlation and DFT of the whole CPI in fp64 into r (ndop x nsamp).
+static void rd_ref_map(const rd_case_t * __restrict q,
+                       const int32_t ndop,
+                       const float * __restrict x,
+                       const float * __restrict ref,
+                       double * __restrict y,
+                       double * __restrict r) {
+
+         const double tpi = 6.283185307179586476925286766559;
+         int64_t pl,k,j,f;
+         for(pl = 0; pl != q->npulse; ++pl) {
+             for(k = 0; k != q->nsamp; ++k) {
+                 double sr = 0.0,si = 0.0;
+                 for(j = 0; j != q->nref && k+j < q->nsamp; ++j) {
+                     const double w  = (double)(float)rdm_window(q->wr,(int32_t)j,q->nref);
+                     const double hr = w*(double)ref[2*j],hi = -w*(double)ref[2*j+1];
+                     const double xr = (double)x[2*(pl*q->nsamp+k+j)];
+                     const double xi = (double)x[2*(pl*q->nsamp+k+j)+1];
+                     sr += xr*hr-xi*hi;
+                     si += xr*hi+xi*hr;
+                 }
+                 y[2*(pl*q->nsamp+k)]   = sr;
+                 y[2*(pl*q->nsamp+k)+1] = si;
+             }
+         }
+         for(f = 0; f != ndop; ++f) {
+             double * __restrict rr = r+((f+ndop/2)%ndop)*q->nsamp;
+             for(k = 0; k != q->nsamp; ++k) {
+                 double sr = 0.0,si = 0.0;
+                 for(pl = 0; pl != q->npulse; ++pl) {
+                     const double w = (double)(float)rdm_window(q->wd,(int32_t)pl,q->npulse);
+                     const double a = -tpi*(double)((pl*f)%ndop)/(double)ndop;
+                     const double c = cos(a),s = sin(a);
+                     const double yr = w*y[2*(pl*q->nsamp+k)],yi = w*y[2*(pl*q->nsamp+k)+1];
+                     sr += yr*c-yi*s;
+                     si += yr*s+yi*c;
+                 }
+                 rr[k] = sr*sr+si*si;
+             }
+         }
+}
+
+// Detection check: LFM pulse, unit noise, two point targets; counts the
+// misses and the false alarms away from the targets.
+#define RD_DSAMP  1000
+#define RD_DREF   64
+#define RD_DPULSE 64
+#define RD_DPFA   1.0e-4f
+
+static int32_t rd_detect(FILE * __restrict fp,
+                         const char * __restrict isan,
+                         const int32_t cft,
+                         uint64_t * __restrict s) {
+
+         static const int32_t tg[2] = {300,700};     // gates
+         static const int32_t td[2] = {10,-20};      // Doppler bins
+         const int64_t nx = (int64_t)RD_DSAMP*RD_DPULSE;
+         rdm_plan_t p;
+         float *x = NULL,*map = NULL,*ref = NULL;
+         uint64_t *det = NULL;
+         int64_t nd = 0,nfa = 0,i,k,pl;
+         int32_t bad = 0,miss = 0,it,nw,f;
+         x   = (float*)malloc((size_t)(2*nx)*sizeof(float));
+         ref = (float*)malloc((size_t)(2*RD_DREF)*sizeof(float));
+         for(k = 0; k != RD_DREF; ++k) {
+             const double ph = 3.14159265358979323846*(double)(k*k)/(double)RD_DREF;
+             if(NULL != ref) {
+                ref[2*k]   = (float)cos(ph);
+                ref[2*k+1] = (float)sin(ph);
+             }
+         }
+         if(NULL==x || NULL==ref ||
+            rdm_init(&p,ref,RD_DREF,RD_DSAMP,RD_DPULSE,0,RDM_WIN_HAMMING,RDM_WIN_HANN,
+                     cft,2,16,RD_DPFA) != 0) {
+            free(x);
+            free(ref);
+            return (1);
+         }
+         nw  = (p.nrange+63)/64;
+         map = (float*)malloc((size_t)p.ndop*(size_t)p.nrange*sizeof(float));
+         det = (uint64_t*)malloc((size_t)p.ndop*(size_t)nw*sizeof(uint64_t));
+         if(NULL==map || NULL==det) {
+            bad = 1;
+            goto done;
+         }
+         for(i = 0; i != nx; ++i) rd_cnoise(s,&x[2*i]);
+         // Echo amplitude 0.5 (-6 dB per sample, +36 dB after integration).
+         for(it = 0; it != 2; ++it) {
+             for(pl = 0; pl != RD_DPULSE; ++pl) {
+                 const double ph = 6.283185307179586476925286766559*(double)(td[it]*pl)/(double)p.ndop;
+                 for(k = 0; k != RD_DREF; ++k) {
+                     const double er = 0.5*(ref[2*k]*cos(ph)-ref[2*k+1]*sin(ph));
+                     const double ei = 0.5*(ref[2*k]*sin(ph)+ref[2*k+1]*cos(ph));
+                     x[2*(pl*RD_DSAMP+tg[it]+k)]   += (float)er;
+                     x[2*(pl*RD_DSAMP+tg[it]+k)+1] += (float)ei;
+                 }
+             }
+         }
+         rdm_run(&p,x,RD_DSAMP,map,det,&nd);
+         for(it = 0; it != 2; ++it) {
+             const int64_t r = td[it]+p.ndop/2;
+             if(!((det[r*nw+tg[it]/64] >> (tg[it]%64)) & 1ULL)) ++miss;
+         }
+         for(f = 0; f != p.ndop; ++f) {
+             for(k = 0; k != p.nrange; ++k) {
+                 int32_t near = 0;
+                 if(!((det[(int64_t)f*nw+k/64] >> (k%64)) & 1ULL)) continue;
+                 for(it = 0; it != 2; ++it)
+                     near |= (abs(f-(td[it]+p.ndop/2)) <= 8 && labs((long)(k-tg[it])) <= RD_DREF);
+                 nfa += !near;
+             }
+         }
+         // Expected false alarms: Pfa x cells (about 6.5); allow 4x + 8.
+         bad = (miss != 0 || (double)nfa > 4.0*(double)RD_DPFA*(double)p.ndop*(double)p.nrange+8.0);
+         fprintf(fp,"  detection %s-CFAR %-7s %lld cells set, %d of 2 targets missed, %lld false alarms%s\n",
+                 (cft == CFAR_OS) ? "OS" : "CA",isan,(long long)nd,miss,(long long)nfa,bad ? "  FAIL" : "");
+done:
+         rdm_free(&p);
+         free(x);
+         free(ref);
+         free(map);
+         free(det);
+         return (bad);
+}
+
+int32_t rdm_validate(FILE * __restrict fp,
+                     const uint64_t seed) {
+
+         const int32_t ncase = (int32_t)(sizeof(rd_cases)/sizeof(rd_cases[0]));
+         const int32_t isa0  = vmath_get_isa();
+         const int64_t cap   = 1000*64;               // samples x pulses
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float  *x = NULL,*ref = NULL,*map = NULL;
+         double *y = NULL,*r = NULL;
+         uint64_t s = seed;
+         int32_t nbad = 0;
+         int32_t cs,isa;
+         if(NULL==fp) return (-1);
+         x   = (float*)malloc((size_t)(2*cap)*sizeof(float));
+         ref = (float*)malloc((size_t)(2*128)*sizeof(float));
+         map = (float*)malloc((size_t)cap*sizeof(float));
+         y   = (double*)malloc((size_t)(2*cap)*sizeof(double));
+         r   = (double*)malloc((size_t)cap*sizeof(double));
+         if(NULL==x || NULL==ref || NULL==map || NULL==y || NULL==r) {
+            nbad = -1;
+            goto done;
+         }
+         fprintf(fp,"Range-Doppler map vs fp64 correlation and DFT, tol %.1e of max\n",(double)RDM_TOL);
+         for(cs = 0; cs != ncase; ++cs) {
+             const rd_case_t * __restrict q = &rd_cases[cs];
+             const int32_t ndop = (q->ndop != 0) ? q->ndop : fftb_good_size(q->npulse);
+             const int64_t nm = (int64_t)ndop*q->nsamp;
+             double rm = 0.0;
+             int64_t i;
+             for(i = 0; i != 2*(int64_t)q->nsamp*q->npulse; ++i) x[i] = (float)rd_draw(&s,-1.0,1.0);
+             for(i = 0; i != 2*(int64_t)q->nref; ++i) ref[i] = (float)rd_draw(&s,-1.0,1.0);
+             rd_ref_map(q,ndop,x,ref,y,r);
+             for(i = 0; i != nm; ++i) rm = fmax(rm,r[i]);
+             for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+                 rdm_plan_t p;
+                 double e = 0.0;
+                 if(vmath_set_isa(isa)) continue;
+                 if(rdm_init(&p,ref,q->nref,q->nsamp,q->npulse,q->ndop,q->wr,q->wd,CFAR_CA,0,0,0.0f) ||
+                    rdm_run(&p,x,q->nsamp,map,NULL,NULL)) {
+                    rdm_free(&p);
+                    ++nbad;
+                    continue;
+                 }
+                 rdm_free(&p);
+                 for(i = 0; i != nm; ++i) e = fmax(e,fabs((double)map[i]-r[i]));
+                 e /= rm;
+                 if(e > (double)RDM_TOL) ++nbad;
+                 fprintf(fp,"  nsamp=%4d nref=%3d npulse=%2d ndop=%2d %-7s err %.3e%s\n",
+                         q->nsamp,q->nref,q->npulse,ndop,isan[isa],e,
+                         (e > (double)RDM_TOL) ? "  FAIL" : "");
+             }
+         }
+         for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+             if(vmath_set_isa(isa)) continue;
+             nbad += rd_detect(fp,isan[isa],CFAR_CA,&s);
+             nbad += rd_detect(fp,isan[isa],CFAR_OS,&s);
+         }
+         vmath_set_isa(isa0);
+done:
+         free(x);
+         free(ref);
+         free(map);
+         free(y);
+         free(r);
+         return (nbad);
+}
+
+
+/*
+     Benchmark
+*/
+static double rd_wtime(void) {
+
+         struct timespec ts;
+         clock_gettime(CLOCK_MONOTONIC,&ts);
+         return ((double)ts.tv_sec+1.0e-9*(double)ts.tv_nsec);
+}
+
+// Seconds per CPI (best of nrep after a warm-up); the plan is made for
+// the current thread count.
+static double rd_bench_one(const float * __restrict x,
+                           const float * __restrict ref,
+                           float * __restrict map,
+                           uint64_t * __restrict det,
+                           const int32_t nsamp,
+                           const int32_t nref,
+                           const int32_t npulse,
+                           const int32_t nrep) {
+
+         rdm_plan_t p;
+         double best = 1.0e30;
+         int64_t nd;
+         int32_t r;
+         if(rdm_init(&p,ref,nref,nsamp,npulse,0,RDM_WIN_HAMMING,RDM_WIN_HANN,CFAR_CA,2,16,1.0e-6f)) return (-1.0);
+         rdm_run(&p,x,nsamp,map,det,&nd);
+         for(r = 0; r != nrep; ++r) {
+             const double t0 = rd_wtime();
+             rdm_run(&p,x,nsamp,map,det,&nd);
+             best = fmin(best,rd_wtime()-t0);
+         }
+         rdm_free(&p);
+         return (best);
+}
+
+void rdm_bench(FILE * __restrict fp,
+               const int32_t nsamp,
+               const int32_t nref,
+               const int32_t npulse,
+               const int32_t nrep) {
+
+         const int32_t isa0 = vmath_get_isa();
+         const int32_t ndop = fftb_good_size(npulse);
+         static const char * const isan[3] = {"scalar","avx2","avx512"};
+         float *x = NULL,*ref = NULL,*map = NULL;
+         uint64_t *det = NULL;
+         uint64_t s = 0x5EED5EEDULL;
+         int32_t nthr = 1;
+         int32_t isa;
+         int64_t i;
+         if(NULL==fp) fp = stdout;
+         if(__builtin_expect(nsamp<1 || nref<1 || npulse<1 || nrep<1,0)) return;
+#if defined(_OPENMP)
+         nthr = omp_get_max_threads();
+#endif
+         x   = (float*)_mm_malloc((size_t)(2*(int64_t)nsamp*npulse)*sizeof(float),64);
+         ref = (float*)malloc((size_t)(2*nref)*sizeof(float));
+         map = (float*)_mm_malloc((size_t)ndop*(size_t)nsamp*sizeof(float),64);
+         det = (uint64_t*)malloc((size_t)ndop*(size_t)((nsamp+63)/64)*sizeof(uint64_t));
+         if(NULL==x || NULL==ref || NULL==map || NULL==det) goto done;
+         for(i = 0; i != 2*(int64_t)nsamp*npulse; ++i) x[i] = (float)rd_draw(&s,-1.0,1.0);
+         for(i = 0; i != nref; ++i) {
+             const double ph = 3.14159265358979323846*(double)(i*i)/(double)nref;
+             ref[2*i]   = (float)cos(ph);
+             ref[2*i+1] = (float)sin(ph);
+         }
+         fprintf(fp,"# nsamp=%d nref=%d npulse=%d (nfft=%d ndop=%d), CPI/s and Msamples/s, best of %d\n",
+                 nsamp,nref,npulse,fftb_good_size(nsamp+nref-1),ndop,nrep);
+         fprintf(fp,"# %-7s %12s %12s %12s %12s\n","isa","CPI/s 1 thr","Ms/s 1 thr","CPI/s all","Ms/s all");
+         for(isa = VMATH_ISA_SCALAR; isa <= VMATH_ISA_AVX512; ++isa) {
+             const double ms = (double)nsamp*(double)npulse*1.0e-6;
+             double t1,tn;
+             if(vmath_set_isa(isa)) continue;
+#if defined(_OPENMP)
+             omp_set_num_threads(1);
+#endif
+             t1 = rd_bench_one(x,ref,map,det,nsamp,nref,npulse,nrep);
+#if defined(_OPENMP)
+             omp_set_num_threads(nthr);
+#endif
+             tn = rd_bench_one(x,ref,map,det,nsamp,nref,npulse,nrep);
+             fprintf(fp,"  %-7s %12.1f %12.1f %12.1f %12.1f\n",isan[isa],1.0/t1,ms/t1,1.0/tn,ms/tn);
+         }
+         vmath_set_isa(isa0);
+done:
+         if(NULL != x)   _mm_free(x);
+         if(NULL != map) _mm_free(map);
+         free(ref);
+         free(det);
+}
@@ -0,0 +1,129 @@
+
+
+#ifndef __GMS_RANGE_DOPPLER_H__
+#define __GMS_RANGE_DOPPLER_H__ 191020260500
+
+//
+// Pulse-Doppler processing of one coherent interval (CPI): pulse
+// compression by fast convolution, corner turn, windowed slow-time FFT,
+// power map and CFAR detection (GMS_cfar.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 19-10-2026 05:00 AM +00200
+//
+// All transforms are the batched FFTs of GMS_fft_batch.h: 16 pulses are
+// compressed per block (pack, FFT, spectral multiply by the conjugate
+// reference spectrum, inverse FFT), the compressed block is turned into
+// the corner-turn cube with 16 x 16 register transposes, and 16 range
+// gates per block go through the Doppler window and FFT straight from the
+// cube. Plans, the reference spectrum, the cube and the per-thread work
+// blocks are made once by rdm_init; rdm_run allocates nothing. Pulse
+// blocks, gate blocks and the CFAR rows run in parallel (OpenMP) inside
+// one parallel region; the CFAR rows follow in parallel.
+// Range gate k of the map is the correlation lag k (0 <= k < nsamp); the
+// FFT length is the smallest 2^a 3^b 5^c >= nsamp + nref - 1, so there is
+// no circular wrap. Doppler rows are fft-shifted (zero Doppler at row
+// ndop/2).
+// Return values: 0 success, -1 invalid argument, -2 allocation failure.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include "GMS_fft_batch.h"
+#include "GMS_cfar.h"
+
+
+#define RDM_WIN_RECT     0
+#define RDM_WIN_HANN     1
+#define RDM_WIN_HAMMING  2
+#define RDM_WIN_BLACKMAN 3
+
+// Blocks (16 pulses or 16 gates) per thread before the pipeline goes
+// parallel.
+#if !defined(RDM_OMP_MIN)
+#define RDM_OMP_MIN 2
+#endif
+
+// Validation tolerance: |map - ref| relative to max(ref).
+#if !defined(RDM_TOL)
+#define RDM_TOL 2.0e-5f
+#endif
+
+
+typedef struct {
+        fftb_plan_t  pr;                   // fast time, nfft
+        fftb_plan_t  pd;                   // slow time, ndop
+        float   * __restrict hre;          // conj(FFT(wr * ref)) / nfft
+        float   * __restrict him;
+        float   * __restrict wd;           // Doppler window, npulse
+        float   * __restrict cre;          // cube [nrb][npulse][16], gates in lanes
+        float   * __restrict cim;
+        float   * __restrict work;         // nthr blocks of 4*nrow*16 floats
+        int32_t  nsamp;                    // samples per pulse
+        int32_t  nref;                     // reference (transmit) samples
+        int32_t  npulse;
+        int32_t  nrange;                   // range gates (= nsamp)
+        int32_t  nfft;
+        int32_t  ndop;                     // Doppler bins (>= npulse)
+        int32_t  nrb;                      // gate blocks of 16
+        int32_t  nrow;                     // rows of a work block
+        int32_t  nthr;
+        int32_t  cfon;                     // detection on
+        cfar_plan_t cf;                    // ndop x nrange detector
+} rdm_plan_t;
+
+
+// Windows of the pulse-compression reference (wr) and of the slow-time
+// FFT (wd) are RDM_WIN_*. ndop = 0 selects the smallest 2^a 3^b 5^c >=
+// npulse. The CFAR of type cft (CFAR_*) runs along range with guard and
+// train cells on each side at the false alarm rate pfa (OS: rank 3/4 of
+// the window); train = 0 turns detection off.
+int32_t rdm_init(rdm_plan_t * __restrict,
+                 const float * __restrict,    // ref, nref interleaved complex
+                 const int32_t,               // nref
+                 const int32_t,               // nsamp
+                 const int32_t,               // npulse
+                 const int32_t,               // ndop
+                 const int32_t,               // wr
+                 const int32_t,               // wd
+                 const int32_t,               // cft
+                 const int32_t,               // guard
+                 const int32_t,               // train
+                 const float);                // pfa
+
+void    rdm_free(rdm_plan_t * __restrict);
+
+// Window coefficient k of n (RDM_WIN_*).
+double  rdm_window(const int32_t,              // type
+                   const int32_t,              // k
+                   const int32_t);             // n
+
+// One CPI: npulse pulses of nsamp interleaved complex samples, pulse p at
+// x[2*p*ldx]. map is ndop x nrange power (row-major, Doppler rows); det
+// (may be NULL) is ndop rows of (nrange+63)/64 words, bit k%64 of word
+// k/64 set for a detection at gate k. *ndet (may be NULL) is the number
+// of detections.
+int32_t rdm_run(rdm_plan_t * __restrict,
+                const float * __restrict,     // x
+                const int64_t,                // ldx (complex, >= nsamp)
+                float * __restrict,           // map
+                uint64_t * __restrict,        // det
+                int64_t * __restrict)         // ndet
+                                        __attribute__((hot));
+
+// Compares rdm_run with an fp64 direct correlation and DFT on every ISA
+// the host runs, then checks that injected point targets are detected;
+// returns the number of failures.
+int32_t rdm_validate(FILE * __restrict,
+                     const uint64_t);         // seed
+
+// CPIs per second of rdm_run for every ISA, on one thread and on all.
+void    rdm_bench(FILE * __restrict,
+                  const int32_t,              // nsamp
+                  const int32_t,              // nref
+                  const int32_t,              // npulse
+                  const int32_t);             // nrep
+
+
+
+
+#endif /*__GMS_RANGE_DOPPLER_H__*/
@@ -0,0 +1,318 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "GMS_vmath.h"
+#include "GMS_vmath_private.h"
+
+//
+// Run-time ISA selection and array drivers of the vector math library.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+
+
+static int32_t vm_isa = -1;
+
+
+static int32_t vm_host_isa(void) {
+
+         __builtin_cpu_init();
+         if(__builtin_cpu_supports("avx512f"))
+            return (VMATH_ISA_AVX512);
+         if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return (VMATH_ISA_AVX2);
+         return (VMATH_ISA_SCALAR);
+}
+
+
+// Widest host ISA, lowered by GMS_VMATH_ISA=avx2|avx512|scalar.
+// Idempotent, so concurrent first calls agree on the result.
+static int32_t vm_default_isa(void) {
+
+         const char * e = getenv("GMS_VMATH_ISA");
+         int32_t isa = vm_host_isa();
+         int32_t req = isa;
+         if(e != NULL) {
+            if(strcmp(e,"scalar") == 0)      req = VMATH_ISA_SCALAR;
+            else if(strcmp(e,"avx2") == 0)   req = VMATH_ISA_AVX2;
+            else if(strcmp(e,"avx512") == 0) req = VMATH_ISA_AVX512;
+         }
+         return (req < isa ? req : isa);
+}
+
+
+static inline
+const vmath_isa_tab_t * vm_tab(void) {
+
+         int32_t isa = __atomic_load_n(&vm_isa,__ATOMIC_RELAXED);
+         if(__builtin_expect(isa < 0,0)) {
+            isa = vm_default_isa();
+            __atomic_store_n(&vm_isa,isa,__ATOMIC_RELAXED);
+         }
+         if(isa == VMATH_ISA_AVX512) return (&vmath_tab_avx512);
+         if(isa == VMATH_ISA_AVX2)   return (&vmath_tab_avx2);
+         return (NULL);
+}
+
+
+int32_t vmath_get_isa(void) {
+
+         (void)vm_tab();
+         return (__atomic_load_n(&vm_isa,__ATOMIC_RELAXED));
+}
+
+
+int32_t vmath_set_isa(const int32_t isa) {
+
+         if(isa < VMATH_ISA_SCALAR || isa > VMATH_ISA_AVX512) return (-1);
+         if(isa > vm_host_isa()) return (-1);
+         __atomic_store_n(&vm_isa,isa,__ATOMIC_RELAXED);
+         return (0);
+}
+
+
+/*
+     Array drivers; the scalar ISA falls back to libm.
+*/
+#define VM_BAD_TIER(t) ((uint32_t)(t) >= (uint32_t)VMATH_NTIERS)
+
+// fp64 has a 0.5-ULP kernel for sqrt only; the other r8 drivers refuse U05.
+#define VM_BAD_TIER_R8(t,ID) (VM_BAD_TIER(t) || ((t) == VMATH_U05 && (ID) != VMATH_SQRT))
+
+#define VM_DRIVER_UN(fn,ID)                                                   \
+int32_t vmath_##fn##_r8(const double * __restrict x,                          \
+                        double * __restrict y,                                \
+                        const int64_t n,                                      \
+                        const int32_t tier) {                                 \
+         const vmath_isa_tab_t * t;                                           \
+         int64_t i;                                                           \
+         if(__builtin_expect(NULL==x || NULL==y || n < 0 || VM_BAD_TIER_R8(tier,ID),0)) \
+            return (-1);                                                      \
+         t = vm_tab();                                                        \
+         if(t != NULL) return (t->un_r8[ID](x,y,n,tier));                     \
+         for(i = 0; i != n; ++i) y[i] = fn(x[i]);                             \
+         return (0);                                                          \
+}                                                                             \
+int32_t vmath_##fn##_r4(const float * __restrict x,                           \
+                        float * __restrict y,                                 \
+                        const int64_t n,                                      \
+                        const int32_t tier) {                                 \
+         const vmath_isa_tab_t * t;                                           \
+         int64_t i;                                                           \
+         if(__builtin_expect(NULL==x || NULL==y || n < 0 || VM_BAD_TIER(tier),0)) \
+            return (-1);                                                      \
+         t = vm_tab();                                                        \
+         if(t != NULL) return (t->un_r4[ID](x,y,n,tier));                     \
+         for(i = 0; i != n; ++i) y[i] = fn##f(x[i]);                          \
+         return (0);                                                          \
+}
+
+#define VM_DRIVER_BIN(fn,ID)                                                  \
+int32_t vmath_##fn##_r8(const double * __restrict a,                          \
+                        const double * __restrict b,                          \
+                        double * __restrict r,                                \
+                        const int64_t n,                                      \
+                        const int32_t tier) {                                 \
+         const vmath_isa_tab_t * t;                                           \
+         int64_t i;                                                           \
+         if(__builtin_expect(NULL==a || NULL==b || NULL==r || n < 0 || VM_BAD_TIER_R8(tier,ID),0)) \
+            return (-1);                                                      \
+         t = vm_tab();                                                        \
+         if(t != NULL) return (t->bin_r8[ID](a,b,r,n,tier));                  \
+         for(i = 0; i != n; ++i) r[i] = fn(a[i],b[i]);                        \
+         return (0);                                                          \
+}                                                                             \
+int32_t vmath_##fn##_r4(const float * __restrict a,                           \
+                        const float * __restrict b,                           \
+                        float * __restrict r,                                 \
+                        const int64_t n,                                      \
+                        const int32_t tier) {                                 \
+         const vmath_isa_tab_t * t;                                           \
+         int64_t i;                                                           \
+         if(__builtin_expect(NULL==a || NULL==b || NULL==r || n < 0 || VM_BAD_TIER(tier),0)) \
+            return (-1);                                                      \
+         t = vm_tab();                                                        \
+         if(t != NULL) return (t->bin_r4[ID](a,b,r,n,tier));                  \
+         for(i = 0; i != n; ++i) r[i] = fn##f(a[i],b[i]);                     \
+         return (0);                                                          \
+}
+
+VM_DRIVER_UN(sin,VMATH_SIN)
+VM_DRIVER_UN(cos,VMATH_COS)
+VM_DRIVER_UN(tan,VMATH_TAN)
+VM_DRIVER_UN(exp,VMATH_EXP)
+VM_DRIVER_UN(log,VMATH_LOG)
+VM_DRIVER_UN(sqrt,VMATH_SQRT)
+VM_DRIVER_UN(cbrt,VMATH_CBRT)
+VM_DRIVER_BIN(atan2,VMATH_ATAN2)
+VM_DRIVER_BIN(pow,VMATH_POW)
+
+
+int32_t vmath_sincos_r8(const double * __restrict x,
+                        double * __restrict s,
+                        double * __restrict c,
+                        const int64_t n,
+                        const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t i;
+         if(__builtin_expect(NULL==x || NULL==s || NULL==c || n < 0 || VM_BAD_TIER_R8(tier,VMATH_SINCOS),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->sincos_r8(x,s,c,n,tier));
+         for(i = 0; i != n; ++i) {
+             s[i] = sin(x[i]);
+             c[i] = cos(x[i]);
+         }
+         return (0);
+}
+
+
+int32_t vmath_sincos_r4(const float * __restrict x,
+                        float * __restrict s,
+                        float * __restrict c,
+                        const int64_t n,
+                        const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t i;
+         if(__builtin_expect(NULL==x || NULL==s || NULL==c || n < 0 || VM_BAD_TIER(tier),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->sincos_r4(x,s,c,n,tier));
+         for(i = 0; i != n; ++i) {
+             s[i] = sinf(x[i]);
+             c[i] = cosf(x[i]);
+         }
+         return (0);
+}
+
+
+int32_t vmath_cis_r8(const double * __restrict x,
+                     double * __restrict z,
+                     const int64_t n,
+                     const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t i;
+         if(__builtin_expect(NULL==x || NULL==z || n < 0 || VM_BAD_TIER_R8(tier,VMATH_SINCOS),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->cis_r8(x,z,n,tier));
+         for(i = 0; i != n; ++i) {
+             z[2*i]   = cos(x[i]);
+             z[2*i+1] = sin(x[i]);
+         }
+         return (0);
+}
+
+
+int32_t vmath_cis_r4(const float * __restrict x,
+                     float * __restrict z,
+                     const int64_t n,
+                     const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t i;
+         if(__builtin_expect(NULL==x || NULL==z || n < 0 || VM_BAD_TIER(tier),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->cis_r4(x,z,n,tier));
+         for(i = 0; i != n; ++i) {
+             z[2*i]   = cosf(x[i]);
+             z[2*i+1] = sinf(x[i]);
+         }
+         return (0);
+}
+
+
+#define VM_2PI_H 6.283185307179586231995926937088
+#define VM_2PI_L 2.4492935982947063697e-16
+
+// s + e = a + b exactly.
+static inline
+void vm_two_sum(const double a,
+                const double b,
+                double * __restrict s,
+                double * __restrict e) {
+
+         const double v = (*s = a+b)-a;
+         *e = (a-(*s-v))+(b-v);
+}
+
+
+// Chirp phase phi0 + w0*k + a*k*k/2 in double-double, reduced to
+// [-pi,pi] (scalar form of vm_chirp_arg_r8 in GMS_vmath_kernels.h).
+static inline
+double vm_chirp_arg(const double phi0,
+                    const double w0,
+                    const double a,
+                    const int64_t k) {
+
+         const double dk = (double)k;
+         const double ha = 0.5*a;
+         const double kk = dk*dk;
+         double h,l,p,e,q;
+         h = ha*kk;
+         l = fma(ha,kk,-h)+ha*fma(dk,dk,-kk);
+         p = w0*dk;
+         l += fma(w0,dk,-p);
+         vm_two_sum(h,p,&h,&e);
+         l += e;
+         vm_two_sum(h,phi0,&h,&e);
+         l += e;
+         q = nearbyint(h*(1.0/(2.0*M_PI)));
+         p = q*VM_2PI_H;
+         l -= fma(q,VM_2PI_H,-p)+q*VM_2PI_L;
+         return ((h-p)+l);
+}
+
+
+#define VM_BAD_MODE(m) ((m) != VMATH_CIS_DIRECT && (m) != VMATH_CIS_ROTATE)
+
+int32_t vmath_cis_chirp_r8(const double phi0,
+                           const double w0,
+                           const double a,
+                           double * __restrict z,
+                           const int64_t n,
+                           const int32_t mode,
+                           const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t k;
+         if(__builtin_expect(NULL==z || n < 0 || VM_BAD_MODE(mode) || VM_BAD_TIER_R8(tier,VMATH_SINCOS),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->chirp_r8(phi0,w0,a,z,n,mode,tier));
+         for(k = 0; k != n; ++k) {
+             const double th = vm_chirp_arg(phi0,w0,a,k);
+             z[2*k]   = cos(th);
+             z[2*k+1] = sin(th);
+         }
+         return (0);
+}
+
+
+int32_t vmath_cis_chirp_r4(const double phi0,
+                           const double w0,
+                           const double a,
+                           float * __restrict z,
+                           const int64_t n,
+                           const int32_t mode,
+                           const int32_t tier) {
+
+         const vmath_isa_tab_t * t;
+         int64_t k;
+         if(__builtin_expect(NULL==z || n < 0 || VM_BAD_MODE(mode) || VM_BAD_TIER(tier),0))
+            return (-1);
+         t = vm_tab();
+         if(t != NULL) return (t->chirp_r4(phi0,w0,a,z,n,mode,tier));
+         for(k = 0; k != n; ++k) {
+             const double th = vm_chirp_arg(phi0,w0,a,k);
+             z[2*k]   = (float)cos(th);
+             z[2*k+1] = (float)sin(th);
+         }
+         return (0);
+}
@@ -0,0 +1,268 @@
+
+
+#ifndef __GMS_VMATH_H__
+#define __GMS_VMATH_H__ 181020262300
+
+//
+// Vector math library: one API over AVX2 and AVX512 with selectable
+// accuracy tiers.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+// Functions: sin, cos, sincos, tan, atan2, exp, log, pow, sqrt, cbrt
+// in fp32 (r4) and fp64 (r8), plus cis (interleaved complex) and chirp
+// phasor generation. The kernels are the SLEEF algorithms of
+// LibSIMD/GMS_sleefsimd{dp,sp}.h, rewritten once over a small per-ISA
+// primitive layer (GMS_vmath_kernels.h), and compiled twice:
+// GMS_vmath_avx2.c (ymm, AVX2+FMA) and GMS_vmath_avx512.c (zmm, AVX512F).
+// Both units set their own target, so they build with any -march; the
+// array drivers (vmath_*_r8/_r4) pick the widest ISA of the host at run
+// time (override: vmath_set_isa or GMS_VMATH_ISA=avx2|avx512|scalar).
+// The scalar ISA loops over libm, whose accuracy then applies instead of
+// the tiers below.
+//
+// Accuracy tiers (maximum error in ULP, finite arguments):
+//                 fp64                         fp32
+//   VMATH_U05     sqrt 0.5; the other r8       0.501 (evaluated in fp64
+//                 drivers return -1 (no        by the U35 r8 kernels)
+//                 0.5-ULP fp64 kernels)
+//   VMATH_U10     1.0  (double-double SLEEF    as U05
+//                 u1 kernels; exp, pow: 1.0)
+//   VMATH_U35     3.5  (SLEEF u35 kernels)     3.5 (native fp32 kernels;
+//                                                   pow evaluated in fp64)
+//   VMATH_FAST    U35 polynomials without special-value handling and
+//                 with a single-step argument reduction:
+//                 sin/cos/sincos/tan |x| <= 1e7 (r8), 39000 (r4); exp
+//                 -708 <= x <= 709 (r8), -87 <= x <= 88 (r4); log, pow
+//                 x > 0 finite; pow = exp(y*log(x)) with an error of
+//                 about 2|y*log(x)| + 3.5 ULP; sqrt r4 via rsqrt and one
+//                 Newton step (1 ULP on AVX512, 2.5 on AVX2).
+// Out-of-range trigonometric arguments (|x| > 1e14 r8, > 39000 r4) take
+// the fp64 path or libm for those lanes only, in every tier but FAST.
+// IEEE special values (NaN, +-Inf, +-0, subnormals) follow C99 Annex F
+// in all tiers except VMATH_FAST.
+// vmath_ulp_test / vmath_ulp_report (GMS_vmath_ulp.c) measure the tiers
+// against long double libm references.
+// Return values of the array drivers: 0 success, -1 invalid argument
+// (also VMATH_U05 for an r8 function other than sqrt). The register-level
+// r8 entry points have no status and run U10 for U05.
+//
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Accuracy tiers.
+#define VMATH_U05   0
+#define VMATH_U10   1
+#define VMATH_U35   2
+#define VMATH_FAST  3
+#define VMATH_NTIERS 4
+
+// Function identifiers (ULP harness, dispatch tables).
+#define VMATH_SIN    0
+#define VMATH_COS    1
+#define VMATH_SINCOS 2
+#define VMATH_TAN    3
+#define VMATH_ATAN2  4
+#define VMATH_EXP    5
+#define VMATH_LOG    6
+#define VMATH_POW    7
+#define VMATH_SQRT   8
+#define VMATH_CBRT   9
+#define VMATH_NFUNCS 10
+
+// Instruction sets of the array drivers.
+#define VMATH_ISA_SCALAR 0
+#define VMATH_ISA_AVX2   1
+#define VMATH_ISA_AVX512 2
+
+
+// ISA used by the array drivers (the widest one available by default).
+int32_t vmath_get_isa(void);
+
+// Returns -1 if the host cannot execute the requested ISA.
+int32_t vmath_set_isa(const int32_t);
+
+
+/*
+     Array drivers (n elements, unit stride, any alignment; x and y must not overlap).
+*/
+#define VMATH_DECL_UNARY(fn)                                                  \
+int32_t vmath_##fn##_r8(const double * __restrict,                            \
+                        double * __restrict,                                  \
+                        const int64_t,                                        \
+                        const int32_t)   __attribute__((hot));                \
+int32_t vmath_##fn##_r4(const float * __restrict,                             \
+                        float * __restrict,                                   \
+                        const int64_t,                                        \
+                        const int32_t)   __attribute__((hot));
+
+VMATH_DECL_UNARY(sin)
+VMATH_DECL_UNARY(cos)
+VMATH_DECL_UNARY(tan)
+VMATH_DECL_UNARY(exp)
+VMATH_DECL_UNARY(log)
+VMATH_DECL_UNARY(sqrt)
+VMATH_DECL_UNARY(cbrt)
+
+// s[i] = sin(x[i]), c[i] = cos(x[i])
+int32_t vmath_sincos_r8(const double * __restrict,
+                        double * __restrict,
+                        double * __restrict,
+                        const int64_t,
+                        const int32_t)   __attribute__((hot));
+
+int32_t vmath_sincos_r4(const float * __restrict,
+                        float * __restrict,
+                        float * __restrict,
+                        const int64_t,
+                        const int32_t)   __attribute__((hot));
+
+// Complex exponential, interleaved: z[2i] = cos(x[i]), z[2i+1] = sin(x[i])
+// (z holds 2n elements; one range reduction per element).
+int32_t vmath_cis_r8(const double * __restrict,
+                     double * __restrict,
+                     const int64_t,
+                     const int32_t)      __attribute__((hot));
+
+int32_t vmath_cis_r4(const float * __restrict,
+                     float * __restrict,
+                     const int64_t,
+                     const int32_t)      __attribute__((hot));
+
+// Modes of vmath_cis_chirp_r8/r4.
+#define VMATH_CIS_DIRECT 0   // cis of every phase (tier accuracy)
+#define VMATH_CIS_ROTATE 1   // phase-rotation recurrence, re-anchored
+
+// Samples between the exact re-anchors of VMATH_CIS_ROTATE.
+#if !defined(VMATH_CIS_REANCHOR)
+#define VMATH_CIS_REANCHOR 256
+#endif
+
+// Chirp (LFM) phasors, interleaved: z[k] = cis(phi0 + w0*k + a*k*k/2),
+// k = 0..n-1 (phi0 in rad, w0 in rad/sample, a in rad/sample^2; a = 0 is
+// a tone). The phase is formed and reduced mod 2pi in double-double, so
+// long chirps do not lose phase accuracy. VMATH_CIS_ROTATE replaces the sin/cos of each sample by
+// two complex multiplies per vector (z *= d, d *= cis(a*W*W)) and restarts
+// from exact values every VMATH_CIS_REANCHOR samples; the drift between
+// anchors is below 1e-12 (r8) and the r4 variant runs the recurrence in
+// fp64, so it stays within the tier bound. The scalar ISA evaluates every
+// sample directly.
+int32_t vmath_cis_chirp_r8(const double,           // phi0
+                           const double,           // w0
+                           const double,           // a
+                           double * __restrict,    // z (2n)
+                           const int64_t,          // n
+                           const int32_t,          // mode
+                           const int32_t)          // tier
+                           __attribute__((hot));
+
+int32_t vmath_cis_chirp_r4(const double,
+                           const double,
+                           const double,
+                           float * __restrict,
+                           const int64_t,
+                           const int32_t,
+                           const int32_t)
+                           __attribute__((hot));
+
+// r[i] = atan2(y[i],x[i])
+int32_t vmath_atan2_r8(const double * __restrict,  // y
+                       const double * __restrict,  // x
+                       double * __restrict,
+                       const int64_t,
+                       const int32_t)    __attribute__((hot));
+
+int32_t vmath_atan2_r4(const float * __restrict,
+                       const float * __restrict,
+                       float * __restrict,
+                       const int64_t,
+                       const int32_t)    __attribute__((hot));
+
+// r[i] = pow(x[i],y[i])
+int32_t vmath_pow_r8(const double * __restrict,    // x
+                     const double * __restrict,    // y
+                     double * __restrict,
+                     const int64_t,
+                     const int32_t)      __attribute__((hot));
+
+int32_t vmath_pow_r4(const float * __restrict,
+                     const float * __restrict,
+                     float * __restrict,
+                     const int64_t,
+                     const int32_t)      __attribute__((hot));
+
+
+/*
+     Register-level entry points (tier is a run-time argument; inside the
+     array drivers the tier is resolved outside the loops).
+*/
+#define VMATH_DECL_VEC(T,sfx)                                                 \
+T vmath_sin_##sfx(const T, const int32_t);                                    \
+T vmath_cos_##sfx(const T, const int32_t);                                    \
+T vmath_tan_##sfx(const T, const int32_t);                                    \
+T vmath_exp_##sfx(const T, const int32_t);                                    \
+T vmath_log_##sfx(const T, const int32_t);                                    \
+T vmath_sqrt_##sfx(const T, const int32_t);                                   \
+T vmath_cbrt_##sfx(const T, const int32_t);                                   \
+T vmath_atan2_##sfx(const T, const T, const int32_t);                         \
+T vmath_pow_##sfx(const T, const T, const int32_t);                           \
+void vmath_sincos_##sfx(const T, T * __restrict, T * __restrict, const int32_t);
+
+#if defined(__AVX2__)
+VMATH_DECL_VEC(__m256d,ymm4r8)
+VMATH_DECL_VEC(__m256,ymm8r4)
+#endif
+#if defined(__AVX512F__)
+VMATH_DECL_VEC(__m512d,zmm8r8)
+VMATH_DECL_VEC(__m512,zmm16r4)
+#endif
+
+
+/*
+     Accuracy-test harness (GMS_vmath_ulp.c).
+*/
+typedef struct {
+        double  max_ulp;      // largest error over the random arguments
+        double  mean_ulp;
+        double  x_at_max;     // arguments of the largest error
+        double  y_at_max;
+        double  bound;        // documented bound of (func,prec,tier)
+        int64_t npts;
+        int32_t nspecial;     // special-value cases checked
+        int32_t nspecial_bad; // special-value mismatches against libm
+} vmath_ulp_report_t;
+
+// Documented error bound in ULP of (func, prec = 4|8, tier); -1 if the
+// tier is not offered.
+double  vmath_ulp_bound(const int32_t,
+                        const int32_t,
+                        const int32_t);
+
+// Random arguments: x in [xlo,xhi], y in [ylo,yhi] for atan2/pow; when a
+// range spans more than 4 binades half of the draws are log-uniform in |x|.
+// Special values are checked in every tier but VMATH_FAST.
+// Reference: long double libm (64-bit significand).
+int32_t vmath_ulp_test(const int32_t,         // func
+                       const int32_t,         // prec (4 or 8)
+                       const int32_t,         // tier
+                       const double,          // xlo
+                       const double,          // xhi
+                       const double,          // ylo
+                       const double,          // yhi
+                       const int64_t,         // npts
+                       const uint64_t,        // seed
+                       vmath_ulp_report_t * __restrict);
+
+// Runs every (func, prec, tier) over its default domains on the current
+// ISA and prints one line per case; returns the number of cases whose
+// error exceeds the documented bound.
+int32_t vmath_ulp_report(FILE * __restrict,
+                         const int64_t);
+
+
+
+
+#endif /*__GMS_VMATH_H__*/
@@ -0,0 +1,376 @@
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+#include "GMS_vmath_approx.h"
+#include "GMS_vmath_private.h"
+
+//
+// Construction, error report and scalar evaluation of the piecewise
+// approximations (GMS_vmath_approx.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:30 PM +00200
+//
+
+
+#define VM_AX_BAD_CRIT(c) ((c) != VMATH_APPROX_ABS && (c) != VMATH_APPROX_REL)
+
+
+/*
+     Scalar evaluators; the operation order is that of
+     GMS_vmath_approx_avx512.c.
+*/
+double vmath_approx_eval_r8(const vmath_approx_t * __restrict ap,
+                            const double x) {
+
+         const int32_t d = ap->deg;
+         const double top = (double)(ap->nseg-1);
+         const double t = (x-ap->a)*ap->scale;
+         const double * __restrict c;
+         double fi = floor(t);
+         double u,u2,pe,po = 0.0;
+         int32_t j;
+         fi = fi > 0.0 ? fi : 0.0;    // NaN -> segment 0
+         fi = fi < top ? fi : top;
+         u  = fma(2.0,t-fi,-1.0);
+         c  = &ap->c8[(int64_t)fi*(d+1)];
+         u2 = u*u;
+         j  = d & ~1;
+         pe = c[j];
+         for(j -= 2; j >= 0; j -= 2) pe = fma(pe,u2,c[j]);
+         if(d > 0) {
+            j  = (d-1) | 1;
+            po = c[j];
+            for(j -= 2; j >= 1; j -= 2) po = fma(po,u2,c[j]);
+         }
+         return (fma(po,u,pe));
+}
+
+
+float vmath_approx_eval_r4(const vmath_approx_t * __restrict ap,
+                           const float x) {
+
+         const int32_t d = ap->deg;
+         const float top = (float)(ap->nseg-1);
+         const float t = (x-ap->a4)*ap->scale4;
+         const float * __restrict c;
+         float fi = floorf(t);
+         float u,u2,pe,po = 0.0f;
+         int32_t j;
+         fi = fi > 0.0f ? fi : 0.0f;
+         fi = fi < top ? fi : top;
+         u  = fmaf(2.0f,t-fi,-1.0f);
+         c  = &ap->c4[(int64_t)fi*(d+1)];
+         u2 = u*u;
+         j  = d & ~1;
+         pe = c[j];
+         for(j -= 2; j >= 0; j -= 2) pe = fmaf(pe,u2,c[j]);
+         if(d > 0) {
+            j  = (d-1) | 1;
+            po = c[j];
+            for(j -= 2; j >= 1; j -= 2) po = fmaf(po,u2,c[j]);
+         }
+         return (fmaf(po,u,pe));
+}
+
+
+/*
+     Construction
+*/
+// Degree-deg Chebyshev interpolant of f on every segment, converted to
+// monomial coefficients in u (x = mid + u*h/2).
+static void vm_ax_fit(vmath_approx_t * __restrict ap,
+                      vmath_approx_fn f,
+                      void * ctx) {
+
+         const int32_t np = ap->deg+1;
+         double fk[VMATH_APPROX_MAXDEG+1],ch[VMATH_APPROX_MAXDEG+1];
+         double t0[VMATH_APPROX_MAXDEG+1],t1[VMATH_APPROX_MAXDEG+1],t2[VMATH_APPROX_MAXDEG+1];
+         double cs[VMATH_APPROX_MAXDEG+1][VMATH_APPROX_MAXDEG+1]; // T_j at the nodes
+         double un[VMATH_APPROX_MAXDEG+1];                        // nodes
+         int32_t i,j,k;
+         for(k = 0; k != np; ++k) un[k] = cos(M_PI*((double)k+0.5)/(double)np);
+         for(j = 0; j != np; ++j)
+             for(k = 0; k != np; ++k)
+                 cs[j][k] = cos(M_PI*(double)j*((double)k+0.5)/(double)np);
+         for(i = 0; i != ap->nseg; ++i) {
+             const double lo  = ap->a+(ap->b-ap->a)*((double)i/(double)ap->nseg);
+             const double hi  = ap->a+(ap->b-ap->a)*((double)(i+1)/(double)ap->nseg);
+             const double mid = 0.5*(lo+hi);
+             const double hw  = 0.5*(hi-lo);
+             double * __restrict c = &ap->c8[(int64_t)i*np];
+             for(k = 0; k != np; ++k)
+                 fk[k] = f(mid+hw*un[k],ctx);
+             ap->nevals += np;
+             for(j = 0; j != np; ++j) {
+                 double s = 0.0;
+                 for(k = 0; k != np; ++k) s += fk[k]*cs[j][k];
+                 ch[j] = (j == 0 ? 1.0 : 2.0)*s/(double)np;
+             }
+             // sum ch[j]*T_j(u), T_j+1 = 2u*T_j - T_j-1
+             memset(c,0,(size_t)np*sizeof(double));
+             memset(t0,0,sizeof(t0));
+             memset(t1,0,sizeof(t1));
+             memset(t2,0,sizeof(t2));
+             t0[0] = 1.0;
+             t1[1] = 1.0;
+             c[0]  = ch[0];
+             if(np > 1) c[1] = ch[1];
+             for(j = 2; j < np; ++j) {
+                 t2[0] = -t0[0];
+                 for(k = 1; k <= j; ++k) t2[k] = 2.0*t1[k-1]-t0[k];
+                 for(k = 0; k <= j; ++k) c[k] += ch[j]*t2[k];
+                 memcpy(t0,t1,sizeof(t0));
+                 memcpy(t1,t2,sizeof(t1));
+             }
+         }
+}
+
+static inline
+double vm_ax_err(const double p,
+                 const double fx,
+                 const int32_t crit) {
+
+         const double e = fabs(p-fx);
+         if(crit == VMATH_APPROX_REL && fx != 0.0) return (e/fabs(fx));
+         return (p == fx ? 0.0 : e);     // NaN -> NaN
+}
+
+static uint64_t vm_ax_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+// Position of a float in the ordered set of floats.
+static inline int64_t vm_ax_ford(const float x) {
+
+         int32_t i;
+         memcpy(&i,&x,sizeof(i));
+         return (i < 0 ? -(int64_t)(i & 0x7fffffff) : (int64_t)i);
+}
+
+static inline void vm_ax_max_r4(vmath_approx_t * __restrict ap,
+                                vmath_approx_fn f,
+                                void * ctx,
+                                const float xf) {
+
+         const double e = vm_ax_err((double)vmath_approx_eval_r4(ap,xf),f((double)xf,ctx),ap->crit);
+         if(!(e <= ap->err_r4) && !isnan(ap->err_r4)) {
+            ap->err_r4 = e;
+            ap->x_at_max_r4 = (double)xf;
+         }
+}
+
+// Dense check of the fp32 evaluator. Its error comes mostly from the fp32
+// rounding of x - a4, of the scaling and of the Horner chains, which
+// varies from one float to the next, so the per-segment points miss its
+// peaks. Every float of [a,b] is taken when there are at most
+// VMATH_APPROX_NCHECK4, otherwise VMATH_APPROX_NCHECK4 points, one drawn
+// at random in each of as many equal cells. Returns the points checked.
+static int64_t vm_ax_check_r4(vmath_approx_t * __restrict ap,
+                              vmath_approx_fn f,
+                              void * ctx) {
+
+         const double h = (ap->b-ap->a)/(double)VMATH_APPROX_NCHECK4;
+         uint64_t s = 0x2545F4914F6CDD1DULL;
+         float lo = (float)ap->a;
+         float hi = (float)ap->b;
+         int64_t i;
+         if((double)lo < ap->a) lo = nextafterf(lo,INFINITY);
+         if((double)hi > ap->b) hi = nextafterf(hi,-INFINITY);
+         if(!(lo <= hi)) return (0);
+         if(vm_ax_ford(hi)-vm_ax_ford(lo) < (int64_t)VMATH_APPROX_NCHECK4) {
+            float xf = lo;
+            for(i = 1; ; ++i) {
+                vm_ax_max_r4(ap,f,ctx,xf);
+                if(xf == hi) return (i);
+                xf = nextafterf(xf,INFINITY);
+            }
+         }
+         for(i = 0; i != (int64_t)VMATH_APPROX_NCHECK4; ++i) {
+             const double u = (double)(vm_ax_rng(&s) >> 11) * 0x1.0p-53;
+             float xf = (float)(ap->a+h*((double)i+u));
+             xf = xf < lo ? lo : xf;
+             xf = xf > hi ? hi : xf;
+             vm_ax_max_r4(ap,f,ctx,xf);
+         }
+         return (i);
+}
+
+// Largest error of the fp64 (and, if r4, the fp32) evaluator.
+static void vm_ax_check(vmath_approx_t * __restrict ap,
+                        vmath_approx_fn f,
+                        void * ctx,
+                        const int32_t r4) {
+
+         const double h = (ap->b-ap->a)/(double)ap->nseg;
+         int64_t i,m,np = 0;
+         ap->err_r8 = ap->err_r4 = 0.0;
+         ap->x_at_max_r8 = ap->x_at_max_r4 = ap->a;
+         for(i = 0; i <= ap->nseg; ++i) {
+             for(m = 0; m != VMATH_APPROX_NCHECK; ++m) {
+                 double x = ap->a+h*((double)i+((double)m+0.5)/(double)VMATH_APPROX_NCHECK);
+                 double e;
+                 if(i == ap->nseg) {
+                    if(m != 0) break;
+                    x = ap->b;
+                 }
+                 e = vm_ax_err(vmath_approx_eval_r8(ap,x),f(x,ctx),ap->crit);
+                 if(!(e <= ap->err_r8) && !isnan(ap->err_r8)) {
+                    ap->err_r8 = e;
+                    ap->x_at_max_r8 = x;
+                 }
+                 ++np;
+                 if(r4) {
+                    vm_ax_max_r4(ap,f,ctx,(float)x);
+                    ++np;
+                 }
+             }
+         }
+         if(r4) np += vm_ax_check_r4(ap,f,ctx);
+         ap->ncheck  = np;
+         ap->nevals += np;
+}
+
+static void vm_ax_release(vmath_approx_t * __restrict ap) {
+
+         if(ap->c8 != NULL) _mm_free(ap->c8);
+         if(ap->c4 != NULL) _mm_free(ap->c4);
+         if(ap->l8 != NULL) _mm_free(ap->l8);
+         if(ap->l4 != NULL) _mm_free(ap->l4);
+         ap->c8 = NULL;
+         ap->c4 = NULL;
+         ap->l8 = NULL;
+         ap->l4 = NULL;
+}
+
+
+int32_t vmath_approx_init(vmath_approx_t * __restrict ap,
+                          vmath_approx_fn f,
+                          void * ctx,
+                          const double a,
+                          const double b,
+                          const int32_t deg,
+                          const double tol,
+                          const int32_t crit) {
+
+         int32_t nseg,np,i,j;
+         if(NULL==ap || NULL==f || !isfinite(a) || !isfinite(b) || !(a < b) ||
+            !isfinite(b-a) || deg < 0 || deg > VMATH_APPROX_MAXDEG || !(tol > 0.0) ||
+            VM_AX_BAD_CRIT(crit)) return (-1);
+         memset(ap,0,sizeof(*ap));
+         np       = deg+1;
+         ap->a    = a;
+         ap->b    = b;
+         ap->deg  = deg;
+         ap->crit = crit;
+         ap->tol  = tol;
+         for(nseg = 1; ; nseg *= 2) {
+             ap->c8 = (double*)_mm_malloc((size_t)nseg*(size_t)np*sizeof(double),64);
+             if(NULL==ap->c8) return (-2);
+             ap->nseg  = nseg;
+             ap->scale = (double)nseg/(b-a);
+             vm_ax_fit(ap,f,ctx);
+             vm_ax_check(ap,f,ctx,0);
+             if(ap->err_r8 <= tol || 2*nseg > VMATH_APPROX_MAXSEG) break;
+             _mm_free(ap->c8);
+             ap->c8 = NULL;
+         }
+         ap->a4     = (float)a;
+         ap->scale4 = (float)ap->scale;
+         ap->c4 = (float*)_mm_malloc((size_t)nseg*(size_t)np*sizeof(float),64);
+         if(NULL==ap->c4) {
+            vm_ax_release(ap);
+            return (-2);
+         }
+         for(i = 0; i != nseg*np; ++i) ap->c4[i] = (float)ap->c8[i];
+         // Register tables, power-major, for the permute paths.
+         if(nseg <= 32) {
+            ap->l8 = (double*)_mm_malloc((size_t)np*32*sizeof(double),64);
+            if(NULL==ap->l8) {
+               vm_ax_release(ap);
+               return (-2);
+            }
+            memset(ap->l8,0,(size_t)np*32*sizeof(double));
+            for(j = 0; j != np; ++j)
+                for(i = 0; i != nseg; ++i) ap->l8[32*j+i] = ap->c8[i*np+j];
+         }
+         if(nseg <= 64) {
+            ap->l4 = (float*)_mm_malloc((size_t)np*64*sizeof(float),64);
+            if(NULL==ap->l4) {
+               vm_ax_release(ap);
+               return (-2);
+            }
+            memset(ap->l4,0,(size_t)np*64*sizeof(float));
+            for(j = 0; j != np; ++j)
+                for(i = 0; i != nseg; ++i) ap->l4[64*j+i] = ap->c4[i*np+j];
+         }
+         vm_ax_check(ap,f,ctx,1);
+         return (ap->err_r8 <= tol ? 0 : 1);
+}
+
+
+void vmath_approx_free(vmath_approx_t * __restrict ap) {
+
+         if(NULL==ap) return;
+         vm_ax_release(ap);
+         ap->nseg = 0;
+}
+
+
+/*
+     Array evaluators
+*/
+int32_t vmath_approx_r8(const vmath_approx_t * __restrict ap,
+                        const double * __restrict x,
+                        double * __restrict y,
+                        const int64_t n) {
+
+         int64_t i;
+         if(__builtin_expect(NULL==ap || NULL==ap->c8 || NULL==x || NULL==y || n < 0,0))
+            return (-1);
+         if(vmath_get_isa() == VMATH_ISA_AVX512) {
+            vmath_approx_avx512_r8(ap,x,y,n);
+            return (0);
+         }
+         for(i = 0; i != n; ++i) y[i] = vmath_approx_eval_r8(ap,x[i]);
+         return (0);
+}
+
+
+int32_t vmath_approx_r4(const vmath_approx_t * __restrict ap,
+                        const float * __restrict x,
+                        float * __restrict y,
+                        const int64_t n) {
+
+         int64_t i;
+         if(__builtin_expect(NULL==ap || NULL==ap->c4 || NULL==x || NULL==y || n < 0,0))
+            return (-1);
+         if(vmath_get_isa() == VMATH_ISA_AVX512) {
+            vmath_approx_avx512_r4(ap,x,y,n);
+            return (0);
+         }
+         for(i = 0; i != n; ++i) y[i] = vmath_approx_eval_r4(ap,x[i]);
+         return (0);
+}
+
+
+void vmath_approx_report(FILE * __restrict fp,
+                         const vmath_approx_t * __restrict ap,
+                         const char * __restrict label) {
+
+         if(NULL==fp || NULL==ap) return;
+         fprintf(fp,"%s: [%.17g, %.17g] deg %d, %d segment(s), %s error, tol %.3e\n",
+                 label != NULL ? label : "approx",ap->a,ap->b,ap->deg,ap->nseg,
+                 ap->crit == VMATH_APPROX_REL ? "relative" : "absolute",ap->tol);
+         fprintf(fp,"   r8 max %.3e at x = %.17g%s\n",ap->err_r8,ap->x_at_max_r8,
+                 ap->err_r8 <= ap->tol ? "" : "  (tol not met)");
+         fprintf(fp,"   r4 max %.3e at x = %.9g\n",ap->err_r4,ap->x_at_max_r4);
+         fprintf(fp,"   %lld points checked, %lld evaluations of f\n",
+                 (long long)ap->ncheck,(long long)ap->nevals);
+}
@@ -0,0 +1,149 @@
+
+
+#ifndef __GMS_VMATH_APPROX_H__
+#define __GMS_VMATH_APPROX_H__ 181020262330
+
+//
+// Init-time piecewise-Chebyshev approximations of bounded-domain functions
+// with AVX512 evaluators.
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:30 PM +00200
+//
+// vmath_approx_init samples a user function f on [a,b] and builds nseg
+// equal segments, each with the degree-deg Chebyshev interpolant (within
+// a small factor of the minimax polynomial). nseg is doubled from 1 until
+// the measured error meets tol. Each segment is stored as monomial
+// coefficients in the local variable u in [-1,1], in fp64 and fp32.
+// The evaluators locate the segment, fetch the coefficients and run an
+// even/odd split Horner scheme (two independent chains in u^2, joined by
+// one FMA):
+//   - nseg <= 16/32/64 (r4) or 8/16/32 (r8): coefficients come from
+//     register tables of 1, 2 or 4 vectors per power (vpermps,
+//     vpermt2ps, two vpermt2ps and a blend);
+//   - otherwise: table gathers, which cost about 3x more per element.
+// Doubling deg usually removes far more segments than it adds FMAs.
+// Arguments outside [a,b] extrapolate the edge segments; NaN propagates.
+// The error report is measured against f itself and covers the fp64 and
+// fp32 evaluators, which match the vector kernels bit for bit. The fp64
+// error is taken on VMATH_APPROX_NCHECK points per segment. The fp32 error
+// is dominated by rounding and changes from one float to the next, so it
+// is also taken on every float of [a,b] when there are at most
+// VMATH_APPROX_NCHECK4, else on VMATH_APPROX_NCHECK4 jittered points: it
+// is then a close lower bound (within a few percent of a dense 1M-point
+// scan), not a guaranteed maximum.
+//
+// Use: exp(-h/H) over an altitude band, pow(x,p) over a known range, or
+// the atan of y/x within a seeker field of view (atan2(y,x) for x > 0).
+// These replace the full-range exp_ymm8r4_ymm8r4 / pow_zmm16r4_zmm16r4
+// calls of the VOLK-derived kernels.
+// Keep deg <= 8 for fp32: higher monomial degrees lose digits to
+// cancellation, which the report shows.
+//
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+#if !defined(VMATH_APPROX_MAXDEG)
+#define VMATH_APPROX_MAXDEG 15
+#endif
+
+#if !defined(VMATH_APPROX_MAXSEG)
+#define VMATH_APPROX_MAXSEG 4096
+#endif
+
+// Error check points per segment.
+#if !defined(VMATH_APPROX_NCHECK)
+#define VMATH_APPROX_NCHECK 64
+#endif
+
+// fp32 error check points over [a,b] (every float when there are fewer).
+#if !defined(VMATH_APPROX_NCHECK4)
+#define VMATH_APPROX_NCHECK4 (1 << 20)
+#endif
+
+// Error criteria.
+#define VMATH_APPROX_ABS 0   // |p(x) - f(x)|
+#define VMATH_APPROX_REL 1   // |p(x) - f(x)|/|f(x)| (absolute where f(x) = 0)
+
+typedef double (*vmath_approx_fn)(const double, void *);
+
+typedef struct {
+        double   a;
+        double   b;
+        double   scale;       // nseg/(b-a)
+        float    a4;
+        float    scale4;
+        int32_t  nseg;
+        int32_t  deg;
+        int32_t  crit;
+        int32_t  pad;
+        double  * __restrict c8;   // nseg*(deg+1), segment-major, u^0 first
+        float   * __restrict c4;
+        double  * __restrict l8;   // (deg+1)*32 register tables (nseg <= 32)
+        float   * __restrict l4;   // (deg+1)*64 register tables (nseg <= 64)
+        // Error report.
+        double   tol;
+        double   err_r8;      // largest error of the fp64 evaluator
+        double   err_r4;      // largest error of the fp32 evaluator
+        double   x_at_max_r8;
+        double   x_at_max_r4;
+        int64_t  ncheck;      // points checked
+        int64_t  nevals;      // calls of f during the build
+} vmath_approx_t;
+
+
+// Builds the approximation of f(x,ctx) over [a,b] with the degree deg
+// (0 <= deg <= VMATH_APPROX_MAXDEG) and the error tol in the criterion crit
+// (met by the fp64 evaluator).
+// Returns: 0 success, 1 tol not met with VMATH_APPROX_MAXSEG segments (the
+// approximation is usable and the report holds the achieved error),
+// -1 invalid argument, -2 allocation failure.
+int32_t vmath_approx_init(vmath_approx_t * __restrict,
+                          vmath_approx_fn,
+                          void *,               // ctx
+                          const double,         // a
+                          const double,         // b
+                          const int32_t,        // deg
+                          const double,         // tol
+                          const int32_t);       // crit
+
+void    vmath_approx_free(vmath_approx_t * __restrict);
+
+// Scalar evaluators (the reference of the vector kernels).
+double  vmath_approx_eval_r8(const vmath_approx_t * __restrict,
+                             const double);
+
+float   vmath_approx_eval_r4(const vmath_approx_t * __restrict,
+                             const float);
+
+// Array evaluators: AVX512 when vmath_get_isa() reports it, the scalar
+// evaluators otherwise. Returns 0, or -1 for invalid arguments.
+int32_t vmath_approx_r8(const vmath_approx_t * __restrict,
+                        const double * __restrict,
+                        double * __restrict,
+                        const int64_t)    __attribute__((hot));
+
+int32_t vmath_approx_r4(const vmath_approx_t * __restrict,
+                        const float * __restrict,
+                        float * __restrict,
+                        const int64_t)    __attribute__((hot));
+
+// Prints the error report.
+void    vmath_approx_report(FILE * __restrict,
+                            const vmath_approx_t * __restrict,
+                            const char * __restrict);   // label
+
+#if defined(__AVX512F__)
+__m512d vmath_approx_zmm8r8(const vmath_approx_t * __restrict,
+                            const __m512d);
+
+__m512  vmath_approx_zmm16r4(const vmath_approx_t * __restrict,
+                             const __m512);
+#endif
+
+
+
+
+#endif /*__GMS_VMATH_APPROX_H__*/
@@ -0,0 +1,218 @@
+
+
+//
+// AVX512 evaluators of the piecewise approximations (GMS_vmath_approx.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:30 PM +00200
+//
+// The unit carries its own target; GMS_vmath_approx.c calls into it only
+// when the host reports AVX512F. Operation order matches
+// vmath_approx_eval_r8/r4 exactly.
+//
+
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_vmath_approx.h"
+#include "GMS_vmath_private.h"
+
+
+// Coefficient fetch by table size: register tables of 1, 2 or 4 vectors
+// per power (vperm*, vpermt2*, two vpermt2* and a blend) or gathers.
+#define VM_AX_PERM1 0
+#define VM_AX_PERM2 1
+#define VM_AX_PERM4 2
+#define VM_AX_GATHER 3
+
+#define VM_AX_INLINE static inline __attribute__((always_inline))
+
+VM_AX_INLINE int32_t vm_ax_kind(const int32_t nseg, const int32_t w) {
+         if(nseg <= w)   return (VM_AX_PERM1);
+         if(nseg <= 2*w) return (VM_AX_PERM2);
+         if(nseg <= 4*w) return (VM_AX_PERM4);
+         return (VM_AX_GATHER);
+}
+
+// Coefficient of u^j for the lanes' segments.
+VM_AX_INLINE __m512d vm_ax_coef_r8(const vmath_approx_t * __restrict ap,
+                                   const __m512i seg,
+                                   const __mmask8 hi,
+                                   const __m256i idx,
+                                   const int32_t j,
+                                   const int32_t kind) {
+
+         const double * __restrict l = &ap->l8[32*j];
+         switch(kind) {
+         case VM_AX_PERM1:
+              return (_mm512_permutexvar_pd(seg,_mm512_load_pd(l)));
+         case VM_AX_PERM2:
+              return (_mm512_permutex2var_pd(_mm512_load_pd(l),seg,_mm512_load_pd(l+8)));
+         case VM_AX_PERM4:
+              return (_mm512_mask_blend_pd(hi,
+                      _mm512_permutex2var_pd(_mm512_load_pd(l),seg,_mm512_load_pd(l+8)),
+                      _mm512_permutex2var_pd(_mm512_load_pd(l+16),seg,_mm512_load_pd(l+24))));
+         default:
+              return (_mm512_i32gather_pd(idx,&ap->c8[j],8));
+         }
+}
+
+VM_AX_INLINE __m512 vm_ax_coef_r4(const vmath_approx_t * __restrict ap,
+                                  const __m512i seg,
+                                  const __mmask16 hi,
+                                  const __m512i idx,
+                                  const int32_t j,
+                                  const int32_t kind) {
+
+         const float * __restrict l = &ap->l4[64*j];
+         switch(kind) {
+         case VM_AX_PERM1:
+              return (_mm512_permutexvar_ps(seg,_mm512_load_ps(l)));
+         case VM_AX_PERM2:
+              return (_mm512_permutex2var_ps(_mm512_load_ps(l),seg,_mm512_load_ps(l+16)));
+         case VM_AX_PERM4:
+              return (_mm512_mask_blend_ps(hi,
+                      _mm512_permutex2var_ps(_mm512_load_ps(l),seg,_mm512_load_ps(l+16)),
+                      _mm512_permutex2var_ps(_mm512_load_ps(l+32),seg,_mm512_load_ps(l+48))));
+         default:
+              return (_mm512_i32gather_ps(idx,&ap->c4[j],4));
+         }
+}
+
+
+VM_AX_INLINE __m512d vm_ax_eval_r8(const vmath_approx_t * __restrict ap,
+                                   const __m512d x,
+                                   const int32_t kind) {
+
+         const int32_t d = ap->deg;
+         const __m512d t = _mm512_mul_pd(_mm512_sub_pd(x,_mm512_set1_pd(ap->a)),
+                                         _mm512_set1_pd(ap->scale));
+         __m512d fi = _mm512_roundscale_pd(t,_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC);
+         __m512d u,u2,pe,po = _mm512_setzero_pd();
+         __m256i s32,idx;
+         __m512i seg;
+         __mmask8 hi;
+         int32_t j;
+         // max(NaN,0) = 0: NaN lanes read segment 0 and stay NaN through u.
+         fi  = _mm512_min_pd(_mm512_max_pd(fi,_mm512_setzero_pd()),
+                             _mm512_set1_pd((double)(ap->nseg-1)));
+         u   = _mm512_fmsub_pd(_mm512_set1_pd(2.0),_mm512_sub_pd(t,fi),_mm512_set1_pd(1.0));
+         s32 = _mm512_cvttpd_epi32(fi);
+         seg = _mm512_cvtepi32_epi64(s32);
+         hi  = _mm512_test_epi64_mask(seg,_mm512_set1_epi64(16));
+         idx = _mm256_mullo_epi32(s32,_mm256_set1_epi32(d+1));
+         u2  = _mm512_mul_pd(u,u);
+         j   = d & ~1;
+         pe  = vm_ax_coef_r8(ap,seg,hi,idx,j,kind);
+         for(j -= 2; j >= 0; j -= 2)
+             pe = _mm512_fmadd_pd(pe,u2,vm_ax_coef_r8(ap,seg,hi,idx,j,kind));
+         if(d > 0) {
+            j  = (d-1) | 1;
+            po = vm_ax_coef_r8(ap,seg,hi,idx,j,kind);
+            for(j -= 2; j >= 1; j -= 2)
+                po = _mm512_fmadd_pd(po,u2,vm_ax_coef_r8(ap,seg,hi,idx,j,kind));
+         }
+         return (_mm512_fmadd_pd(po,u,pe));
+}
+
+VM_AX_INLINE __m512 vm_ax_eval_r4(const vmath_approx_t * __restrict ap,
+                                  const __m512 x,
+                                  const int32_t kind) {
+
+         const int32_t d = ap->deg;
+         const __m512 t = _mm512_mul_ps(_mm512_sub_ps(x,_mm512_set1_ps(ap->a4)),
+                                        _mm512_set1_ps(ap->scale4));
+         __m512 fi = _mm512_roundscale_ps(t,_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC);
+         __m512 u,u2,pe,po = _mm512_setzero_ps();
+         __m512i seg,idx;
+         __mmask16 hi;
+         int32_t j;
+         fi  = _mm512_min_ps(_mm512_max_ps(fi,_mm512_setzero_ps()),
+                             _mm512_set1_ps((float)(ap->nseg-1)));
+         u   = _mm512_fmsub_ps(_mm512_set1_ps(2.0f),_mm512_sub_ps(t,fi),_mm512_set1_ps(1.0f));
+         seg = _mm512_cvttps_epi32(fi);
+         hi  = _mm512_test_epi32_mask(seg,_mm512_set1_epi32(32));
+         idx = _mm512_mullo_epi32(seg,_mm512_set1_epi32(d+1));
+         u2  = _mm512_mul_ps(u,u);
+         j   = d & ~1;
+         pe  = vm_ax_coef_r4(ap,seg,hi,idx,j,kind);
+         for(j -= 2; j >= 0; j -= 2)
+             pe = _mm512_fmadd_ps(pe,u2,vm_ax_coef_r4(ap,seg,hi,idx,j,kind));
+         if(d > 0) {
+            j  = (d-1) | 1;
+            po = vm_ax_coef_r4(ap,seg,hi,idx,j,kind);
+            for(j -= 2; j >= 1; j -= 2)
+                po = _mm512_fmadd_ps(po,u2,vm_ax_coef_r4(ap,seg,hi,idx,j,kind));
+         }
+         return (_mm512_fmadd_ps(po,u,pe));
+}
+
+#define VM_AX_KIND_SWITCH(kind,BODY)                                        \
+        switch(kind) {                                                      \
+        case VM_AX_PERM1: { const int32_t _k = VM_AX_PERM1; BODY; } break;  \
+        case VM_AX_PERM2: { const int32_t _k = VM_AX_PERM2; BODY; } break;  \
+        case VM_AX_PERM4: { const int32_t _k = VM_AX_PERM4; BODY; } break;  \
+        default:          { const int32_t _k = VM_AX_GATHER; BODY; } break; \
+        }
+
+
+__m512d vmath_approx_zmm8r8(const vmath_approx_t * __restrict ap,
+                            const __m512d x) {
+
+         __m512d y;
+         VM_AX_KIND_SWITCH(vm_ax_kind(ap->nseg,8),y = vm_ax_eval_r8(ap,x,_k))
+         return (y);
+}
+
+
+__m512 vmath_approx_zmm16r4(const vmath_approx_t * __restrict ap,
+                            const __m512 x) {
+
+         __m512 y;
+         VM_AX_KIND_SWITCH(vm_ax_kind(ap->nseg,16),y = vm_ax_eval_r4(ap,x,_k))
+         return (y);
+}
+
+
+#define VM_AX_LOOP_R8(ap,x,y,n,K)                                           \
+        do {                                                                \
+           int64_t _i;                                                      \
+           for(_i = 0; _i+8 <= (n); _i += 8)                                \
+               _mm512_storeu_pd(&(y)[_i],vm_ax_eval_r8(ap,_mm512_loadu_pd(&(x)[_i]),K)); \
+           if(_i < (n)) {                                                   \
+              const __mmask8 _m = (__mmask8)((1U << ((n)-_i))-1U);          \
+              _mm512_mask_storeu_pd(&(y)[_i],_m,vm_ax_eval_r8(ap,           \
+                    _mm512_mask_loadu_pd(_mm512_set1_pd((ap)->a),_m,&(x)[_i]),K)); \
+           }                                                                \
+        } while(0)
+
+#define VM_AX_LOOP_R4(ap,x,y,n,K)                                           \
+        do {                                                                \
+           int64_t _i;                                                      \
+           for(_i = 0; _i+16 <= (n); _i += 16)                              \
+               _mm512_storeu_ps(&(y)[_i],vm_ax_eval_r4(ap,_mm512_loadu_ps(&(x)[_i]),K)); \
+           if(_i < (n)) {                                                   \
+              const __mmask16 _m = (__mmask16)((1U << ((n)-_i))-1U);        \
+              _mm512_mask_storeu_ps(&(y)[_i],_m,vm_ax_eval_r4(ap,           \
+                    _mm512_mask_loadu_ps(_mm512_set1_ps((ap)->a4),_m,&(x)[_i]),K)); \
+           }                                                                \
+        } while(0)
+
+
+void vmath_approx_avx512_r8(const vmath_approx_t * __restrict ap,
+                            const double * __restrict x,
+                            double * __restrict y,
+                            const int64_t n) {
+
+         VM_AX_KIND_SWITCH(vm_ax_kind(ap->nseg,8),VM_AX_LOOP_R8(ap,x,y,n,_k))
+}
+
+
+void vmath_approx_avx512_r4(const vmath_approx_t * __restrict ap,
+                            const float * __restrict x,
+                            float * __restrict y,
+                            const int64_t n) {
+
+         VM_AX_KIND_SWITCH(vm_ax_kind(ap->nseg,16),VM_AX_LOOP_R4(ap,x,y,n,_k))
+}
@@ -0,0 +1,198 @@
+
+
+//
+// AVX2/FMA instantiation of the vector math library (GMS_vmath.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+// The unit carries its own target, so it builds with any -march;
+// GMS_vmath.c calls into it only when the host reports AVX2 and FMA.
+// Contraction is disabled: the double-double steps of the kernels rely on
+// separately rounded products and sums.
+//
+
+#pragma GCC target("avx2,fma")
+#pragma GCC optimize("fp-contract=off")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_vmath.h"
+#include "GMS_vmath_private.h"
+
+
+typedef __m256d vd;
+typedef __m256d md;
+typedef __m256  vf;
+typedef __m256  mf;
+
+#define VD_W 4
+#define VF_W 8
+#define VM_SFX_R8 ymm4r8
+#define VM_SFX_R4 ymm8r4
+#define VM_TAB    vmath_tab_avx2
+
+#define VM_PRIM static inline __attribute__((always_inline))
+
+
+/*
+     fp64 primitives (lane masks are all-ones/all-zeros doubles)
+*/
+VM_PRIM vd vd_c(const double c)                  { return _mm256_set1_pd(c); }
+VM_PRIM vd vd_load(const double * __restrict p)  { return _mm256_loadu_pd(p); }
+VM_PRIM void vd_store(double * __restrict p, const vd x) { _mm256_storeu_pd(p,x); }
+// Interleaved complex store: p[2j] = re[j], p[2j+1] = im[j].
+VM_PRIM void vd_store_cplx(double * __restrict p, const vd re, const vd im) {
+        const __m256d lo = _mm256_unpacklo_pd(re,im);
+        const __m256d hi = _mm256_unpackhi_pd(re,im);
+        _mm256_storeu_pd(p,  _mm256_permute2f128_pd(lo,hi,0x20));
+        _mm256_storeu_pd(p+4,_mm256_permute2f128_pd(lo,hi,0x31));
+}
+VM_PRIM vd vd_add(const vd a, const vd b)        { return _mm256_add_pd(a,b); }
+VM_PRIM vd vd_sub(const vd a, const vd b)        { return _mm256_sub_pd(a,b); }
+VM_PRIM vd vd_mul(const vd a, const vd b)        { return _mm256_mul_pd(a,b); }
+VM_PRIM vd vd_div(const vd a, const vd b)        { return _mm256_div_pd(a,b); }
+VM_PRIM vd vd_fma(const vd a, const vd b, const vd c)  { return _mm256_fmadd_pd(a,b,c); }
+VM_PRIM vd vd_fms(const vd a, const vd b, const vd c)  { return _mm256_fmsub_pd(a,b,c); }
+VM_PRIM vd vd_fnma(const vd a, const vd b, const vd c) { return _mm256_fnmadd_pd(a,b,c); }
+VM_PRIM vd vd_sqrt(const vd x)                   { return _mm256_sqrt_pd(x); }
+VM_PRIM vd vd_abs(const vd x)   { return _mm256_andnot_pd(_mm256_set1_pd(-0.0),x); }
+VM_PRIM vd vd_neg(const vd x)   { return _mm256_xor_pd(_mm256_set1_pd(-0.0),x); }
+VM_PRIM vd vd_max(const vd a, const vd b)        { return _mm256_max_pd(a,b); }
+VM_PRIM vd vd_rint(const vd x) {
+        return _mm256_round_pd(x,_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vd vd_trunc(const vd x) {
+        return _mm256_round_pd(x,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vd vd_mulsign(const vd x, const vd y) {
+        return _mm256_xor_pd(x,_mm256_and_pd(y,_mm256_set1_pd(-0.0)));
+}
+VM_PRIM md vd_lt(const vd a, const vd b)         { return _mm256_cmp_pd(a,b,_CMP_LT_OQ); }
+VM_PRIM md vd_gt(const vd a, const vd b)         { return _mm256_cmp_pd(a,b,_CMP_GT_OQ); }
+VM_PRIM md vd_eq(const vd a, const vd b)         { return _mm256_cmp_pd(a,b,_CMP_EQ_OQ); }
+VM_PRIM vd vd_sel(const md m, const vd a, const vd b) { return _mm256_blendv_pd(b,a,m); }
+VM_PRIM md md_or(const md a, const md b)         { return _mm256_or_pd(a,b); }
+VM_PRIM md md_and(const md a, const md b)        { return _mm256_and_pd(a,b); }
+VM_PRIM md md_andnot(const md a, const md b)     { return _mm256_andnot_pd(a,b); }
+VM_PRIM uint32_t md_bits(const md m)             { return (uint32_t)_mm256_movemask_pd(m); }
+VM_PRIM int32_t md_any(const md m)               { return _mm256_movemask_pd(m) != 0; }
+VM_PRIM md vd_isinf(const vd x) { return vd_eq(vd_abs(x),vd_c(__builtin_inf())); }
+VM_PRIM md vd_isnan(const vd x) { return _mm256_cmp_pd(x,x,_CMP_UNORD_Q); }
+VM_PRIM md vd_isnegzero(const vd x) {
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_castpd_si256(x),
+                                                      _mm256_set1_epi64x(INT64_MIN)));
+}
+VM_PRIM md vd_signbit(const vd x) {
+        return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_setzero_si256(),
+                                                      _mm256_castpd_si256(x)));
+}
+// Bit 'bit' of the integer-valued q (|q| < 2^51).
+VM_PRIM md vd_qbit(const vd q, const int64_t bit) {
+        const __m256i b = _mm256_and_si256(_mm256_castpd_si256(_mm256_add_pd(q,_mm256_set1_pd(0x1.8p52))),
+                                           _mm256_set1_epi64x(bit));
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(b,_mm256_set1_epi64x(bit)));
+}
+// 2^q, integer-valued q in [-1022,1023].
+VM_PRIM vd vd_pow2i(const vd q) {
+        const __m256i b = _mm256_castpd_si256(_mm256_add_pd(q,_mm256_set1_pd(1023.0+0x1.8p52)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(b,52));
+}
+// floor(log2|d|); subnormals are pre-scaled by 2^300.
+VM_PRIM vd vd_ilogbk(vd d) {
+        const md o = vd_lt(vd_abs(d),vd_c(4.9090934652977266E-91));
+        __m256i q;
+        d = vd_sel(o,vd_mul(d,vd_c(2.037035976334486E90)),d);
+        q = _mm256_and_si256(_mm256_srli_epi64(_mm256_castpd_si256(d),52),_mm256_set1_epi64x(0x7ff));
+        d = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(q,_mm256_castpd_si256(vd_c(0x1p52)))),
+                          vd_c(0x1p52));
+        return vd_sub(d,vd_sel(o,vd_c(300.0+1023.0),vd_c(1023.0)));
+}
+// d = m*2^e, m in [0.75,1.5).
+VM_PRIM vd vd_split75(const vd d, vd * __restrict m) {
+        const vd e = vd_ilogbk(vd_mul(d,vd_c(1.0/0.75)));
+        const vd a = vd_trunc(vd_mul(e,vd_c(-0.5)));
+        *m = vd_mul(vd_mul(d,vd_pow2i(a)),vd_pow2i(vd_sub(vd_neg(e),a)));
+        return e;
+}
+
+
+/*
+     fp32 primitives
+*/
+VM_PRIM vf vf_c(const float c)                   { return _mm256_set1_ps(c); }
+VM_PRIM vf vf_load(const float * __restrict p)   { return _mm256_loadu_ps(p); }
+VM_PRIM void vf_store(float * __restrict p, const vf x) { _mm256_storeu_ps(p,x); }
+VM_PRIM vf vf_add(const vf a, const vf b)        { return _mm256_add_ps(a,b); }
+VM_PRIM vf vf_sub(const vf a, const vf b)        { return _mm256_sub_ps(a,b); }
+VM_PRIM vf vf_mul(const vf a, const vf b)        { return _mm256_mul_ps(a,b); }
+VM_PRIM vf vf_div(const vf a, const vf b)        { return _mm256_div_ps(a,b); }
+VM_PRIM vf vf_fma(const vf a, const vf b, const vf c)  { return _mm256_fmadd_ps(a,b,c); }
+VM_PRIM vf vf_fnma(const vf a, const vf b, const vf c) { return _mm256_fnmadd_ps(a,b,c); }
+VM_PRIM vf vf_sqrt(const vf x)                   { return _mm256_sqrt_ps(x); }
+VM_PRIM vf vf_rsqrt(const vf x)                  { return _mm256_rsqrt_ps(x); }
+VM_PRIM vf vf_abs(const vf x)   { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f),x); }
+VM_PRIM vf vf_neg(const vf x)   { return _mm256_xor_ps(_mm256_set1_ps(-0.0f),x); }
+VM_PRIM vf vf_max(const vf a, const vf b)        { return _mm256_max_ps(a,b); }
+VM_PRIM vf vf_rint(const vf x) {
+        return _mm256_round_ps(x,_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vf vf_trunc(const vf x) {
+        return _mm256_round_ps(x,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vf vf_mulsign(const vf x, const vf y) {
+        return _mm256_xor_ps(x,_mm256_and_ps(y,_mm256_set1_ps(-0.0f)));
+}
+VM_PRIM mf vf_lt(const vf a, const vf b)         { return _mm256_cmp_ps(a,b,_CMP_LT_OQ); }
+VM_PRIM mf vf_gt(const vf a, const vf b)         { return _mm256_cmp_ps(a,b,_CMP_GT_OQ); }
+VM_PRIM mf vf_eq(const vf a, const vf b)         { return _mm256_cmp_ps(a,b,_CMP_EQ_OQ); }
+VM_PRIM vf vf_sel(const mf m, const vf a, const vf b) { return _mm256_blendv_ps(b,a,m); }
+VM_PRIM mf mf_or(const mf a, const mf b)         { return _mm256_or_ps(a,b); }
+VM_PRIM int32_t mf_any(const mf m)               { return _mm256_movemask_ps(m) != 0; }
+VM_PRIM mf vf_isinf(const vf x) { return vf_eq(vf_abs(x),vf_c(__builtin_inff())); }
+VM_PRIM mf vf_isnan(const vf x) { return _mm256_cmp_ps(x,x,_CMP_UNORD_Q); }
+VM_PRIM mf vf_isnegzero(const vf x) {
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_castps_si256(x),
+                                                      _mm256_set1_epi32(INT32_MIN)));
+}
+VM_PRIM mf vf_signbit(const vf x) {
+        return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(x),31));
+}
+VM_PRIM mf vf_qbit(const vf q, const int32_t bit) {
+        const __m256i b = _mm256_and_si256(_mm256_cvtps_epi32(q),_mm256_set1_epi32(bit));
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(b,_mm256_set1_epi32(bit)));
+}
+// 2^q, integer-valued q in [-126,127].
+VM_PRIM vf vf_pow2i(const vf q) {
+        const __m256i b = _mm256_add_epi32(_mm256_cvtps_epi32(q),_mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(b,23));
+}
+// floor(log2|d|); subnormals are pre-scaled by 2^64.
+VM_PRIM vf vf_ilogbk(vf d) {
+        const mf o = vf_lt(vf_abs(d),vf_c(5.421010862427522E-20f));
+        __m256i q;
+        d = vf_sel(o,vf_mul(d,vf_c(1.8446744073709552E19f)),d);
+        q = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(d),23),_mm256_set1_epi32(0xff));
+        return vf_sub(_mm256_cvtepi32_ps(q),vf_sel(o,vf_c(64.0f+127.0f),vf_c(127.0f)));
+}
+VM_PRIM vf vf_split75(const vf d, vf * __restrict m) {
+        const vf e = vf_ilogbk(vf_mul(d,vf_c(1.0f/0.75f)));
+        const vf a = vf_trunc(vf_mul(e,vf_c(-0.5f)));
+        *m = vf_mul(vf_mul(d,vf_pow2i(a)),vf_pow2i(vf_sub(vf_neg(e),a)));
+        return e;
+}
+// Interleaved complex store: p[2j] = re[j], p[2j+1] = im[j].
+VM_PRIM void vf_store_cplx(float * __restrict p, const vf re, const vf im) {
+        const __m256 lo = _mm256_unpacklo_ps(re,im);
+        const __m256 hi = _mm256_unpackhi_ps(re,im);
+        _mm256_storeu_ps(p,  _mm256_permute2f128_ps(lo,hi,0x20));
+        _mm256_storeu_ps(p+8,_mm256_permute2f128_ps(lo,hi,0x31));
+}
+VM_PRIM vd vf_to_vd_lo(const vf x) { return _mm256_cvtps_pd(_mm256_castps256_ps128(x)); }
+VM_PRIM vd vf_to_vd_hi(const vf x) { return _mm256_cvtps_pd(_mm256_extractf128_ps(x,1)); }
+VM_PRIM vf vd_to_vf(const vd lo, const vd hi) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)),
+                                    _mm256_cvtpd_ps(hi),1);
+}
+
+
+#include "GMS_vmath_kernels.h"
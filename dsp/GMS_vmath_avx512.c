@@ -0,0 +1,187 @@
+
+
+//
+// AVX512 instantiation of the vector math library (GMS_vmath.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+// The unit carries its own target, so it builds with any -march;
+// GMS_vmath.c calls into it only when the host reports AVX512F.
+// Contraction is disabled: the double-double steps of the kernels rely on
+// separately rounded products and sums.
+//
+
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "GMS_vmath.h"
+#include "GMS_vmath_private.h"
+
+
+typedef __m512d   vd;
+typedef __mmask8  md;
+typedef __m512    vf;
+typedef __mmask16 mf;
+
+#define VD_W 8
+#define VF_W 16
+#define VM_SFX_R8 zmm8r8
+#define VM_SFX_R4 zmm16r4
+#define VM_TAB    vmath_tab_avx512
+
+#define VM_PRIM static inline __attribute__((always_inline))
+
+
+/*
+     fp64 primitives
+*/
+VM_PRIM vd vd_c(const double c)                  { return _mm512_set1_pd(c); }
+VM_PRIM vd vd_load(const double * __restrict p)  { return _mm512_loadu_pd(p); }
+VM_PRIM void vd_store(double * __restrict p, const vd x) { _mm512_storeu_pd(p,x); }
+// Interleaved complex store: p[2j] = re[j], p[2j+1] = im[j].
+VM_PRIM void vd_store_cplx(double * __restrict p, const vd re, const vd im) {
+        const __m512i i0 = _mm512_setr_epi64(0,8,1,9,2,10,3,11);
+        const __m512i i1 = _mm512_setr_epi64(4,12,5,13,6,14,7,15);
+        _mm512_storeu_pd(p,  _mm512_permutex2var_pd(re,i0,im));
+        _mm512_storeu_pd(p+8,_mm512_permutex2var_pd(re,i1,im));
+}
+VM_PRIM vd vd_add(const vd a, const vd b)        { return _mm512_add_pd(a,b); }
+VM_PRIM vd vd_sub(const vd a, const vd b)        { return _mm512_sub_pd(a,b); }
+VM_PRIM vd vd_mul(const vd a, const vd b)        { return _mm512_mul_pd(a,b); }
+VM_PRIM vd vd_div(const vd a, const vd b)        { return _mm512_div_pd(a,b); }
+VM_PRIM vd vd_fma(const vd a, const vd b, const vd c)  { return _mm512_fmadd_pd(a,b,c); }
+VM_PRIM vd vd_fms(const vd a, const vd b, const vd c)  { return _mm512_fmsub_pd(a,b,c); }
+VM_PRIM vd vd_fnma(const vd a, const vd b, const vd c) { return _mm512_fnmadd_pd(a,b,c); }
+VM_PRIM vd vd_sqrt(const vd x)                   { return _mm512_sqrt_pd(x); }
+VM_PRIM vd vd_abs(const vd x)                    { return _mm512_abs_pd(x); }
+VM_PRIM vd vd_max(const vd a, const vd b)        { return _mm512_max_pd(a,b); }
+VM_PRIM vd vd_rint(const vd x) {
+        return _mm512_roundscale_pd(x,_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vd vd_trunc(const vd x) {
+        return _mm512_roundscale_pd(x,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vd vd_neg(const vd x) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x),
+                                   _mm512_set1_epi64(INT64_MIN)));
+}
+VM_PRIM vd vd_mulsign(const vd x, const vd y) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x),
+                                   _mm512_and_si512(_mm512_castpd_si512(y),
+                                                    _mm512_set1_epi64(INT64_MIN))));
+}
+VM_PRIM md vd_lt(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_LT_OQ); }
+VM_PRIM md vd_gt(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_GT_OQ); }
+VM_PRIM md vd_eq(const vd a, const vd b)         { return _mm512_cmp_pd_mask(a,b,_CMP_EQ_OQ); }
+VM_PRIM vd vd_sel(const md m, const vd a, const vd b) { return _mm512_mask_blend_pd(m,b,a); }
+VM_PRIM md md_or(const md a, const md b)         { return (md)(a|b); }
+VM_PRIM md md_and(const md a, const md b)        { return (md)(a&b); }
+VM_PRIM md md_andnot(const md a, const md b)     { return (md)(~a&b); }
+VM_PRIM uint32_t md_bits(const md m)             { return (uint32_t)m; }
+VM_PRIM int32_t md_any(const md m)               { return m != 0; }
+VM_PRIM md vd_isinf(const vd x) { return vd_eq(vd_abs(x),vd_c(__builtin_inf())); }
+VM_PRIM md vd_isnan(const vd x) { return _mm512_cmp_pd_mask(x,x,_CMP_UNORD_Q); }
+VM_PRIM md vd_isnegzero(const vd x) {
+        return _mm512_cmpeq_epi64_mask(_mm512_castpd_si512(x),_mm512_set1_epi64(INT64_MIN));
+}
+VM_PRIM md vd_signbit(const vd x) {
+        return _mm512_test_epi64_mask(_mm512_castpd_si512(x),_mm512_set1_epi64(INT64_MIN));
+}
+// Bit 'bit' of the integer-valued q (|q| < 2^51).
+VM_PRIM md vd_qbit(const vd q, const int64_t bit) {
+        const __m512i b = _mm512_castpd_si512(_mm512_add_pd(q,_mm512_set1_pd(0x1.8p52)));
+        return _mm512_test_epi64_mask(b,_mm512_set1_epi64(bit));
+}
+// 2^q, integer-valued q in [-1022,1023].
+VM_PRIM vd vd_pow2i(const vd q) {
+        const __m512i b = _mm512_castpd_si512(_mm512_add_pd(q,_mm512_set1_pd(1023.0+0x1.8p52)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(b,52));
+}
+// floor(log2|d|), subnormals included.
+VM_PRIM vd vd_ilogbk(const vd d) { return _mm512_getexp_pd(d); }
+// d = m*2^e, m in [0.75,1.5).
+VM_PRIM vd vd_split75(const vd d, vd * __restrict m) {
+        const vd e = _mm512_getexp_pd(_mm512_mul_pd(d,_mm512_set1_pd(1.0/0.75)));
+        *m = _mm512_getmant_pd(d,_MM_MANT_NORM_p75_1p5,_MM_MANT_SIGN_nan);
+        return vd_sel(vd_eq(e,vd_c(__builtin_inf())),vd_c(1024.0),e);
+}
+
+
+/*
+     fp32 primitives
+*/
+VM_PRIM vf vf_c(const float c)                   { return _mm512_set1_ps(c); }
+VM_PRIM vf vf_load(const float * __restrict p)   { return _mm512_loadu_ps(p); }
+VM_PRIM void vf_store(float * __restrict p, const vf x) { _mm512_storeu_ps(p,x); }
+VM_PRIM void vf_store_cplx(float * __restrict p, const vf re, const vf im) {
+        const __m512i i0 = _mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);
+        const __m512i i1 = _mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31);
+        _mm512_storeu_ps(p,   _mm512_permutex2var_ps(re,i0,im));
+        _mm512_storeu_ps(p+16,_mm512_permutex2var_ps(re,i1,im));
+}
+VM_PRIM vf vf_add(const vf a, const vf b)        { return _mm512_add_ps(a,b); }
+VM_PRIM vf vf_sub(const vf a, const vf b)        { return _mm512_sub_ps(a,b); }
+VM_PRIM vf vf_mul(const vf a, const vf b)        { return _mm512_mul_ps(a,b); }
+VM_PRIM vf vf_div(const vf a, const vf b)        { return _mm512_div_ps(a,b); }
+VM_PRIM vf vf_fma(const vf a, const vf b, const vf c)  { return _mm512_fmadd_ps(a,b,c); }
+VM_PRIM vf vf_fnma(const vf a, const vf b, const vf c) { return _mm512_fnmadd_ps(a,b,c); }
+VM_PRIM vf vf_sqrt(const vf x)                   { return _mm512_sqrt_ps(x); }
+VM_PRIM vf vf_rsqrt(const vf x)                  { return _mm512_rsqrt14_ps(x); }
+VM_PRIM vf vf_abs(const vf x)                    { return _mm512_abs_ps(x); }
+VM_PRIM vf vf_max(const vf a, const vf b)        { return _mm512_max_ps(a,b); }
+VM_PRIM vf vf_rint(const vf x) {
+        return _mm512_roundscale_ps(x,_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vf vf_trunc(const vf x) {
+        return _mm512_roundscale_ps(x,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+}
+VM_PRIM vf vf_neg(const vf x) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x),
+                                   _mm512_set1_epi32(INT32_MIN)));
+}
+VM_PRIM vf vf_mulsign(const vf x, const vf y) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x),
+                                   _mm512_and_si512(_mm512_castps_si512(y),
+                                                    _mm512_set1_epi32(INT32_MIN))));
+}
+VM_PRIM mf vf_lt(const vf a, const vf b)         { return _mm512_cmp_ps_mask(a,b,_CMP_LT_OQ); }
+VM_PRIM mf vf_gt(const vf a, const vf b)         { return _mm512_cmp_ps_mask(a,b,_CMP_GT_OQ); }
+VM_PRIM mf vf_eq(const vf a, const vf b)         { return _mm512_cmp_ps_mask(a,b,_CMP_EQ_OQ); }
+VM_PRIM vf vf_sel(const mf m, const vf a, const vf b) { return _mm512_mask_blend_ps(m,b,a); }
+VM_PRIM mf mf_or(const mf a, const mf b)         { return (mf)(a|b); }
+VM_PRIM int32_t mf_any(const mf m)               { return m != 0; }
+VM_PRIM mf vf_isinf(const vf x) { return vf_eq(vf_abs(x),vf_c(__builtin_inff())); }
+VM_PRIM mf vf_isnan(const vf x) { return _mm512_cmp_ps_mask(x,x,_CMP_UNORD_Q); }
+VM_PRIM mf vf_isnegzero(const vf x) {
+        return _mm512_cmpeq_epi32_mask(_mm512_castps_si512(x),_mm512_set1_epi32(INT32_MIN));
+}
+VM_PRIM mf vf_signbit(const vf x) {
+        return _mm512_test_epi32_mask(_mm512_castps_si512(x),_mm512_set1_epi32(INT32_MIN));
+}
+VM_PRIM mf vf_qbit(const vf q, const int32_t bit) {
+        return _mm512_test_epi32_mask(_mm512_cvtps_epi32(q),_mm512_set1_epi32(bit));
+}
+// 2^q, integer-valued q in [-126,127].
+VM_PRIM vf vf_pow2i(const vf q) {
+        const __m512i b = _mm512_add_epi32(_mm512_cvtps_epi32(q),_mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(b,23));
+}
+VM_PRIM vf vf_ilogbk(const vf d) { return _mm512_getexp_ps(d); }
+VM_PRIM vf vf_split75(const vf d, vf * __restrict m) {
+        const vf e = _mm512_getexp_ps(_mm512_mul_ps(d,_mm512_set1_ps(1.0f/0.75f)));
+        *m = _mm512_getmant_ps(d,_MM_MANT_NORM_p75_1p5,_MM_MANT_SIGN_nan);
+        return vf_sel(vf_eq(e,vf_c(__builtin_inff())),vf_c(128.0f),e);
+}
+VM_PRIM vd vf_to_vd_lo(const vf x) { return _mm512_cvtps_pd(_mm512_castps512_ps256(x)); }
+VM_PRIM vd vf_to_vd_hi(const vf x) {
+        return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x),1)));
+}
+VM_PRIM vf vd_to_vf(const vd lo, const vd hi) {
+        const __m512d l = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(lo)));
+        return _mm512_castpd_ps(_mm512_insertf64x4(l,_mm256_castps_pd(_mm512_cvtpd_ps(hi)),1));
+}
+
+
+#include "GMS_vmath_kernels.h"
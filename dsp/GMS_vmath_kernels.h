@@ -0,0 +1,1569 @@
+
+
+//
+// ISA-generic kernels of the vector math library (GMS_vmath.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+// No include guard: GMS_vmath_avx2.c and GMS_vmath_avx512.c include this
+// file once each, after defining the primitive layer
+//     vd, md (fp64 vector, lane mask), vf, mf (fp32), VD_W, VF_W,
+//     vd_c, vd_add, vd_sub, vd_mul, vd_div, vd_fma (a*b+c), vd_fms (a*b-c),
+//     vd_fnma (c-a*b), vd_sqrt, vd_abs, vd_neg, vd_max, vd_rint, vd_trunc,
+//     vd_lt, vd_gt, vd_eq, vd_sel (m ? a : b), md_or, md_and, md_andnot
+//     (~a & b), md_any, md_bits, vd_mulsign, vd_isinf, vd_isnan,
+//     vd_isnegzero, vd_signbit, vd_qbit (bit of the integer held in a
+//     double), vd_pow2i, vd_ilogbk, vd_split75, vd_load, vd_store,
+//     vd_store_cplx (interleaved re,im)
+// and their vf_/mf_ counterparts (plus vf_rsqrt, vf_to_vd_lo/hi and
+// vd_to_vf).
+// Algorithms and coefficients are those of SLEEF 2.x
+// (LibSIMD/GMS_sleefsimddp.h, GMS_sleefsimdsp.h, Boost Software License
+// 1.0, Naoki Shibata); the double-double arithmetic is the FMA variant of
+// SLEEF's dd.h.
+//
+
+#include <math.h>
+
+
+#define VM_TRIGRANGEMAX   1.0e+14
+#define VM_TRIGRANGEMAXF  39000.0f
+
+#define VM_PI_A  3.1415926218032836914
+#define VM_PI_B  3.1786509424591713469e-08
+#define VM_PI_C  1.2246467864107188502e-16
+#define VM_PI_D  1.2736634327021899816e-24
+
+#define VM_PI4_A 0.78539816290140151978
+#define VM_PI4_B 4.9604678871439933374e-10
+#define VM_PI4_C 1.1258708853173288931e-18
+#define VM_PI4_D 1.7607799325916000908e-27
+
+#define VM_PI_AF 3.140625f
+#define VM_PI_BF 0.0009670257568359375f
+#define VM_PI_CF 6.2771141529083251953e-07f
+#define VM_PI_DF 1.2154201256553420762e-10f
+
+#define VM_M_PI      3.141592653589793238462643383279502884
+#define VM_M_1_PI    0.318309886183790671537767526745028724
+#define VM_M_2_PI_H  0.63661977236758138243
+#define VM_M_2_PI_L  -3.9357353350364971764e-17
+#define VM_TWO24     16777216.0
+#define VM_TWO23     8388608.0
+
+#define VM_L2U   .69314718055966295651160180568695068359375
+#define VM_L2L   .28235290563031577122588448175013436025525412068e-12
+#define VM_R_LN2 1.442695040888963407359924681001892137426645954152985934135449406931
+#define VM_L2UF  0.693145751953125f
+#define VM_L2LF  1.428606765330187045e-06f
+#define VM_R_LN2F 1.442695040888963407359924681001892137426645954152985934135449406931f
+
+#define VM_INLINE static inline __attribute__((always_inline))
+
+
+/*
+     fp64 helpers
+*/
+VM_INLINE vd vd_negif(const md m, const vd x) { return vd_sel(m,vd_neg(x),x); }
+
+VM_INLINE vd vd_nanif(const md m, const vd x) { return vd_sel(m,vd_c(NAN),x); }
+
+// x*2^q, q integer-valued, |q| <= 2044 (two normal factors).
+VM_INLINE vd vd_ldexp2(const vd x, const vd q) {
+          const vd a = vd_trunc(vd_mul(q,vd_c(0.5)));
+          return vd_mul(vd_mul(x,vd_pow2i(a)),vd_pow2i(vd_sub(q,a)));
+}
+
+// x*2^q for any integer-valued q (clamped to +-2200, four factors).
+VM_INLINE vd vd_ldexp(const vd x, const vd q) {
+          const vd qc = vd_max(vd_c(-2200.0),vd_neg(vd_max(vd_c(-2200.0),vd_neg(q))));
+          const vd a  = vd_trunc(vd_mul(qc,vd_c(0.25)));
+          const vd m  = vd_pow2i(a);
+          return vd_mul(vd_mul(vd_mul(vd_mul(x,m),m),m),vd_pow2i(vd_fma(a,vd_c(-3.0),qc)));
+}
+
+/*
+     double-double arithmetic
+*/
+typedef struct { vd x, y; } vd2;
+
+VM_INLINE vd2 dd_(const vd x, const vd y) { vd2 r; r.x = x; r.y = y; return r; }
+
+VM_INLINE vd2 dd_c(const double x, const double y) { return dd_(vd_c(x),vd_c(y)); }
+
+VM_INLINE vd2 dd_sel(const md m, const vd2 a, const vd2 b) {
+          return dd_(vd_sel(m,a.x,b.x),vd_sel(m,a.y,b.y));
+}
+
+VM_INLINE vd2 dd_neg(const vd2 a) { return dd_(vd_neg(a.x),vd_neg(a.y)); }
+
+VM_INLINE vd2 dd_normalize(const vd2 t) {
+          const vd s = vd_add(t.x,t.y);
+          return dd_(s,vd_add(vd_sub(t.x,s),t.y));
+}
+
+VM_INLINE vd2 dd_scale(const vd2 d, const vd s) { return dd_(vd_mul(d.x,s),vd_mul(d.y,s)); }
+
+// |x| >= |y| variants (fast two-sum) and the general ones (add2).
+VM_INLINE vd2 dd_add_d_d(const vd x, const vd y) {
+          const vd s = vd_add(x,y);
+          return dd_(s,vd_add(vd_sub(x,s),y));
+}
+
+VM_INLINE vd2 dd_add2_d_d(const vd x, const vd y) {
+          const vd s = vd_add(x,y);
+          const vd v = vd_sub(s,x);
+          return dd_(s,vd_add(vd_sub(x,vd_sub(s,v)),vd_sub(y,v)));
+}
+
+VM_INLINE vd2 dd_add_dd_d(const vd2 x, const vd y) {
+          const vd s = vd_add(x.x,y);
+          return dd_(s,vd_add(vd_add(vd_sub(x.x,s),y),x.y));
+}
+
+VM_INLINE vd2 dd_add2_dd_d(const vd2 x, const vd y) {
+          const vd s = vd_add(x.x,y);
+          const vd v = vd_sub(s,x.x);
+          const vd w = vd_add(vd_sub(x.x,vd_sub(s,v)),vd_sub(y,v));
+          return dd_(s,vd_add(w,x.y));
+}
+
+VM_INLINE vd2 dd_add_d_dd(const vd x, const vd2 y) {
+          const vd s = vd_add(x,y.x);
+          return dd_(s,vd_add(vd_add(vd_sub(x,s),y.x),y.y));
+}
+
+VM_INLINE vd2 dd_add2_d_dd(const vd x, const vd2 y) {
+          const vd s = vd_add(x,y.x);
+          const vd v = vd_sub(s,x);
+          return dd_(s,vd_add(vd_add(vd_sub(x,vd_sub(s,v)),vd_sub(y.x,v)),y.y));
+}
+
+VM_INLINE vd2 dd_add_dd_dd(const vd2 x, const vd2 y) {
+          const vd s = vd_add(x.x,y.x);
+          return dd_(s,vd_add(vd_add(vd_add(vd_sub(x.x,s),y.x),x.y),y.y));
+}
+
+VM_INLINE vd2 dd_add2_dd_dd(const vd2 x, const vd2 y) {
+          const vd s = vd_add(x.x,y.x);
+          const vd v = vd_sub(s,x.x);
+          const vd t = vd_add(vd_sub(x.x,vd_sub(s,v)),vd_sub(y.x,v));
+          return dd_(s,vd_add(t,vd_add(x.y,y.y)));
+}
+
+VM_INLINE vd2 dd_mul_d_d(const vd x, const vd y) {
+          const vd s = vd_mul(x,y);
+          return dd_(s,vd_fms(x,y,s));
+}
+
+VM_INLINE vd2 dd_mul_dd_d(const vd2 x, const vd y) {
+          const vd s = vd_mul(x.x,y);
+          return dd_(s,vd_fma(x.y,y,vd_fms(x.x,y,s)));
+}
+
+VM_INLINE vd2 dd_mul_dd_dd(const vd2 x, const vd2 y) {
+          const vd s = vd_mul(x.x,y.x);
+          return dd_(s,vd_fma(x.x,y.y,vd_fma(x.y,y.x,vd_fms(x.x,y.x,s))));
+}
+
+VM_INLINE vd2 dd_squ(const vd2 x) {
+          const vd s = vd_mul(x.x,x.x);
+          return dd_(s,vd_fma(vd_add(x.x,x.x),x.y,vd_fms(x.x,x.x,s)));
+}
+
+VM_INLINE vd2 dd_div(const vd2 n, const vd2 d) {
+          const vd t = vd_div(vd_c(1.0),d.x);
+          const vd s = vd_mul(n.x,t);
+          const vd u = vd_fms(t,n.x,s);
+          const vd v = vd_fnma(d.y,t,vd_fnma(d.x,t,vd_c(1.0)));
+          return dd_(s,vd_fma(s,v,vd_fma(n.y,t,u)));
+}
+
+VM_INLINE vd2 dd_rec(const vd2 d) {
+          const vd s = vd_div(vd_c(1.0),d.x);
+          return dd_(s,vd_mul(s,vd_fnma(d.y,s,vd_fnma(d.x,s,vd_c(1.0)))));
+}
+
+
+/*
+     fp64 argument reduction by multiples of pi*k
+*/
+// Three-part Cody-Waite with the quotient split in dqh*2^24 + ql.
+VM_INLINE vd vm_cw7_r8(vd d, const vd dqh, const vd ql, const double k) {
+          d = vd_fma(dqh,vd_c(-VM_PI_A*k*VM_TWO24),d);
+          d = vd_fma(ql, vd_c(-VM_PI_A*k),d);
+          d = vd_fma(dqh,vd_c(-VM_PI_B*k*VM_TWO24),d);
+          d = vd_fma(ql, vd_c(-VM_PI_B*k),d);
+          d = vd_fma(dqh,vd_c(-VM_PI_C*k*VM_TWO24),d);
+          d = vd_fma(ql, vd_c(-VM_PI_C*k),d);
+          return vd_fma(vd_fma(dqh,vd_c(VM_TWO24),ql),vd_c(-VM_PI_D*k),d);
+}
+
+VM_INLINE vd2 vm_cw7dd_r8(const vd d, const vd dqh, const vd ql, const double k) {
+          vd2 s;
+          s = dd_add2_d_d(d,vd_mul(dqh,vd_c(-VM_PI_A*k*VM_TWO24)));
+          s = dd_add2_dd_d(s,vd_mul(ql, vd_c(-VM_PI_A*k)));
+          s = dd_add2_dd_d(s,vd_mul(dqh,vd_c(-VM_PI_B*k*VM_TWO24)));
+          s = dd_add2_dd_d(s,vd_mul(ql, vd_c(-VM_PI_B*k)));
+          s = dd_add2_dd_d(s,vd_mul(dqh,vd_c(-VM_PI_C*k*VM_TWO24)));
+          s = dd_add2_dd_d(s,vd_mul(ql, vd_c(-VM_PI_C*k)));
+          return dd_add2_dd_d(s,vd_mul(vd_fma(dqh,vd_c(VM_TWO24),ql),vd_c(-VM_PI_D*k)));
+}
+
+// Single quotient, four-part constant (VMATH_FAST).
+VM_INLINE vd vm_cw4_r8(vd d, const vd q, const double k) {
+          d = vd_fma(q,vd_c(-VM_PI4_A*4.0*k),d);
+          d = vd_fma(q,vd_c(-VM_PI4_B*4.0*k),d);
+          d = vd_fma(q,vd_c(-VM_PI4_C*4.0*k),d);
+          return vd_fma(q,vd_c(-VM_PI4_D*4.0*k),d);
+}
+
+// Quotient of d/(pi/2): dqh*2^24 + ql.
+VM_INLINE vd vm_q2pi_r8(const vd d, vd * __restrict ql) {
+          const vd dqh = vd_trunc(vd_mul(d,vd_c(2.0*VM_M_1_PI/VM_TWO24)));
+          *ql = vd_rint(vd_sub(vd_mul(d,vd_c(2.0*VM_M_1_PI)),vd_mul(dqh,vd_c(VM_TWO24))));
+          return dqh;
+}
+
+
+/*
+     sin, cos
+*/
+VM_INLINE vd vm_sinpoly9_r8(const vd s) {
+          vd u = vd_c(-7.97255955009037868891952e-18);
+          u = vd_fma(u,s,vd_c(2.81009972710863200091251e-15));
+          u = vd_fma(u,s,vd_c(-7.64712219118158833288484e-13));
+          u = vd_fma(u,s,vd_c(1.60590430605664501629054e-10));
+          u = vd_fma(u,s,vd_c(-2.50521083763502045810755e-08));
+          u = vd_fma(u,s,vd_c(2.75573192239198747630416e-06));
+          u = vd_fma(u,s,vd_c(-0.000198412698412696162806809));
+          u = vd_fma(u,s,vd_c(0.00833333333333332974823815));
+          return vd_fma(u,s,vd_c(-0.166666666666666657414808));
+}
+
+VM_INLINE vd vm_sinpoly7_r8(const vd s) {
+          vd u = vd_c(2.72052416138529567917983e-15);
+          u = vd_fma(u,s,vd_c(-7.6429259411395447190023e-13));
+          u = vd_fma(u,s,vd_c(1.60589370117277896211623e-10));
+          u = vd_fma(u,s,vd_c(-2.5052106814843123359368e-08));
+          u = vd_fma(u,s,vd_c(2.75573192104428224777379e-06));
+          u = vd_fma(u,s,vd_c(-0.000198412698412046454654947));
+          return vd_fma(u,s,vd_c(0.00833333333333318056201922));
+}
+
+// sin(t) for the reduced double-double argument t (|t| <= pi/2).
+VM_INLINE vd vm_sin_dd_r8(const vd2 t) {
+          const vd2 s = dd_squ(t);
+          const vd  u = vm_sinpoly7_r8(s.x);
+          vd2 x = dd_add_d_dd(vd_c(1.0),dd_mul_dd_dd(dd_add_d_d(vd_c(-0.166666666666666657414808),
+                                                             vd_mul(u,s.x)),s));
+          x = dd_mul_dd_dd(t,x);
+          return vd_add(x.x,x.y);
+}
+
+VM_INLINE vd vm_sin_u35_r8(vd d, const int32_t fast) {
+          const vd r = d;
+          vd u,s,ql;
+          if(fast) {
+             ql = vd_rint(vd_mul(d,vd_c(VM_M_1_PI)));
+             d  = vm_cw4_r8(d,ql,1.0);
+          } else {
+             const vd dqh = vd_trunc(vd_mul(d,vd_c(VM_M_1_PI/VM_TWO24)));
+             ql = vd_rint(vd_sub(vd_mul(d,vd_c(VM_M_1_PI)),vd_mul(dqh,vd_c(VM_TWO24))));
+             d  = vm_cw7_r8(d,dqh,ql,1.0);
+          }
+          s = vd_mul(d,d);
+          d = vd_negif(vd_qbit(ql,1),d);
+          u = vm_sinpoly9_r8(s);
+          u = vd_fma(s,vd_mul(u,d),d);
+          if(!fast) u = vd_sel(vd_isnegzero(r),vd_c(-0.0),u);
+          return u;
+}
+
+VM_INLINE vd vm_sin_u10_r8(const vd d) {
+          const vd dqh = vd_trunc(vd_mul(d,vd_c(VM_M_1_PI/VM_TWO24)));
+          const vd ql  = vd_rint(vd_sub(vd_mul(d,vd_c(VM_M_1_PI)),vd_mul(dqh,vd_c(VM_TWO24))));
+          vd u = vm_sin_dd_r8(vm_cw7dd_r8(d,dqh,ql,1.0));
+          u = vd_negif(vd_qbit(ql,1),u);
+          return vd_sel(vd_isnegzero(d),vd_c(-0.0),u);
+}
+
+// Quotient of d/pi - 1/2, returned as the odd multiple 2*q+1 of pi/2.
+VM_INLINE vd vm_qcos_r8(const vd d, vd * __restrict dqh) {
+          vd ql;
+          *dqh = vd_trunc(vd_fma(d,vd_c(VM_M_1_PI/VM_TWO23),vd_c(-0.5*VM_M_1_PI/VM_TWO23)));
+          ql   = vd_rint(vd_add(vd_mul(d,vd_c(VM_M_1_PI)),
+                                vd_fma(*dqh,vd_c(-VM_TWO23),vd_c(-0.5))));
+          return vd_fma(ql,vd_c(2.0),vd_c(1.0));
+}
+
+VM_INLINE vd vm_cos_u35_r8(vd d, const int32_t fast) {
+          vd u,s,ql;
+          if(fast) {
+             ql = vd_rint(vd_fma(d,vd_c(VM_M_1_PI),vd_c(-0.5)));
+             ql = vd_fma(ql,vd_c(2.0),vd_c(1.0));
+             d  = vm_cw4_r8(d,ql,0.5);
+          } else {
+             vd dqh;
+             ql = vm_qcos_r8(d,&dqh);
+             d  = vm_cw7_r8(d,dqh,ql,0.5);
+          }
+          s = vd_mul(d,d);
+          d = vd_sel(vd_qbit(ql,2),d,vd_neg(d));
+          u = vm_sinpoly9_r8(s);
+          return vd_fma(s,vd_mul(u,d),d);
+}
+
+VM_INLINE vd vm_cos_u10_r8(const vd d) {
+          vd dqh;
+          const vd ql = vm_qcos_r8(d,&dqh);
+          const vd u  = vm_sin_dd_r8(vm_cw7dd_r8(d,dqh,ql,0.5));
+          return vd_sel(vd_qbit(ql,2),u,vd_neg(u));
+}
+
+
+/*
+     sincos
+*/
+VM_INLINE void vm_sincos_u35_r8(const vd d, vd * __restrict ps, vd * __restrict pc,
+                                const int32_t fast) {
+          vd u,s,t,rx,ry,ql;
+          md o;
+          if(fast) {
+             ql = vd_rint(vd_mul(d,vd_c(2.0*VM_M_1_PI)));
+             s  = vm_cw4_r8(d,ql,0.5);
+          } else {
+             const vd dqh = vm_q2pi_r8(d,&ql);
+             s  = vm_cw7_r8(d,dqh,ql,0.5);
+          }
+          t = s;
+          s = vd_mul(s,s);
+          u = vd_c(1.58938307283228937328511e-10);
+          u = vd_fma(u,s,vd_c(-2.50506943502539773349318e-08));
+          u = vd_fma(u,s,vd_c(2.75573131776846360512547e-06));
+          u = vd_fma(u,s,vd_c(-0.000198412698278911770864914));
+          u = vd_fma(u,s,vd_c(0.0083333333333191845961746));
+          u = vd_fma(u,s,vd_c(-0.166666666666666130709393));
+          u = vd_mul(vd_mul(u,s),t);
+          rx = vd_add(t,u);
+          if(!fast) rx = vd_sel(vd_isnegzero(d),vd_c(-0.0),rx);
+          u = vd_c(-1.13615350239097429531523e-11);
+          u = vd_fma(u,s,vd_c(2.08757471207040055479366e-09));
+          u = vd_fma(u,s,vd_c(-2.75573144028847567498567e-07));
+          u = vd_fma(u,s,vd_c(2.48015872890001867311915e-05));
+          u = vd_fma(u,s,vd_c(-0.00138888888888714019282329));
+          u = vd_fma(u,s,vd_c(0.0416666666666665519592062));
+          u = vd_fma(u,s,vd_c(-0.5));
+          ry = vd_fma(s,u,vd_c(1.0));
+          o  = vd_qbit(ql,1);
+          *ps = vd_negif(vd_qbit(ql,2),vd_sel(o,ry,rx));
+          *pc = vd_negif(vd_qbit(vd_add(ql,vd_c(1.0)),2),vd_sel(o,rx,ry));
+}
+
+VM_INLINE void vm_sincos_u10_r8(const vd d, vd * __restrict ps, vd * __restrict pc) {
+          vd u,rx,ry,ql;
+          vd2 s,t,x;
+          md o;
+          const vd dqh = vm_q2pi_r8(d,&ql);
+          s = vm_cw7dd_r8(d,dqh,ql,0.5);
+          t = s;
+          s = dd_squ(s);
+          s.x = vd_add(s.x,s.y);
+          u = vd_c(1.58938307283228937328511e-10);
+          u = vd_fma(u,s.x,vd_c(-2.50506943502539773349318e-08));
+          u = vd_fma(u,s.x,vd_c(2.75573131776846360512547e-06));
+          u = vd_fma(u,s.x,vd_c(-0.000198412698278911770864914));
+          u = vd_fma(u,s.x,vd_c(0.0083333333333191845961746));
+          u = vd_fma(u,s.x,vd_c(-0.166666666666666130709393));
+          u = vd_mul(u,vd_mul(s.x,t.x));
+          x = dd_add_dd_d(t,u);
+          rx = vd_add(x.x,x.y);
+          rx = vd_sel(vd_isnegzero(d),vd_c(-0.0),rx);
+          u = vd_c(-1.13615350239097429531523e-11);
+          u = vd_fma(u,s.x,vd_c(2.08757471207040055479366e-09));
+          u = vd_fma(u,s.x,vd_c(-2.75573144028847567498567e-07));
+          u = vd_fma(u,s.x,vd_c(2.48015872890001867311915e-05));
+          u = vd_fma(u,s.x,vd_c(-0.00138888888888714019282329));
+          u = vd_fma(u,s.x,vd_c(0.0416666666666665519592062));
+          u = vd_fma(u,s.x,vd_c(-0.5));
+          x = dd_add_d_dd(vd_c(1.0),dd_mul_d_d(s.x,u));
+          ry = vd_add(x.x,x.y);
+          o  = vd_qbit(ql,1);
+          *ps = vd_negif(vd_qbit(ql,2),vd_sel(o,ry,rx));
+          *pc = vd_negif(vd_qbit(vd_add(ql,vd_c(1.0)),2),vd_sel(o,rx,ry));
+}
+
+
+/*
+     tan
+*/
+VM_INLINE vd vm_tan_u35_r8(const vd d, const int32_t fast) {
+          vd u,s,x,ql;
+          md o;
+          if(fast) {
+             ql = vd_rint(vd_mul(d,vd_c(2.0*VM_M_1_PI)));
+             x  = vm_cw4_r8(d,ql,0.5);
+          } else {
+             // Near the poles 1/u magnifies the reduction error, so the
+             // remainder is accumulated in double-double.
+             const vd dqh = vm_q2pi_r8(d,&ql);
+             const vd2 r  = vm_cw7dd_r8(d,dqh,ql,0.5);
+             x  = vd_add(r.x,r.y);
+          }
+          s = vd_mul(x,x);
+          o = vd_qbit(ql,1);
+          x = vd_negif(o,x);
+          u = vd_c(9.99583485362149960784268e-06);
+          u = vd_fma(u,s,vd_c(-4.31184585467324750724175e-05));
+          u = vd_fma(u,s,vd_c(0.000103573238391744000389851));
+          u = vd_fma(u,s,vd_c(-0.000137892809714281708733524));
+          u = vd_fma(u,s,vd_c(0.000157624358465342784274554));
+          u = vd_fma(u,s,vd_c(-6.07500301486087879295969e-05));
+          u = vd_fma(u,s,vd_c(0.000148898734751616411290179));
+          u = vd_fma(u,s,vd_c(0.000219040550724571513561967));
+          u = vd_fma(u,s,vd_c(0.000595799595197098359744547));
+          u = vd_fma(u,s,vd_c(0.00145461240472358871965441));
+          u = vd_fma(u,s,vd_c(0.0035923150771440177410343));
+          u = vd_fma(u,s,vd_c(0.00886321546662684547901456));
+          u = vd_fma(u,s,vd_c(0.0218694899718446938985394));
+          u = vd_fma(u,s,vd_c(0.0539682539049961967903002));
+          u = vd_fma(u,s,vd_c(0.133333333334818976423364));
+          u = vd_fma(u,s,vd_c(0.333333333333320047664472));
+          u = vd_fma(s,vd_mul(u,x),x);
+          u = vd_sel(o,vd_div(vd_c(1.0),u),u);
+          if(!fast) {
+             u = vd_nanif(vd_isinf(d),u);
+             u = vd_sel(vd_isnegzero(d),vd_c(-0.0),u);
+          }
+          return u;
+}
+
+VM_INLINE vd vm_tan_u10_r8(const vd d) {
+          vd u,ql;
+          vd2 s,t,x;
+          md o;
+          const vd dqh = vd_trunc(vd_mul(d,vd_c(2.0*VM_M_1_PI/VM_TWO24)));
+          s  = dd_add2_dd_d(dd_mul_dd_d(dd_c(VM_M_2_PI_H,VM_M_2_PI_L),d),
+                            vd_fma(dqh,vd_c(-VM_TWO24),
+                                   vd_sel(vd_lt(d,vd_c(0.0)),vd_c(-0.5),vd_c(0.5))));
+          ql = vd_trunc(vd_add(s.x,s.y));
+          s  = vm_cw7dd_r8(d,dqh,ql,0.5);
+          o  = vd_qbit(ql,1);
+          s  = dd_(vd_negif(o,s.x),vd_negif(o,s.y));
+          t  = s;
+          s  = dd_squ(s);
+          u = vd_c(1.01419718511083373224408e-05);
+          u = vd_fma(u,s.x,vd_c(-2.59519791585924697698614e-05));
+          u = vd_fma(u,s.x,vd_c(5.23388081915899855325186e-05));
+          u = vd_fma(u,s.x,vd_c(-3.05033014433946488225616e-05));
+          u = vd_fma(u,s.x,vd_c(7.14707504084242744267497e-05));
+          u = vd_fma(u,s.x,vd_c(8.09674518280159187045078e-05));
+          u = vd_fma(u,s.x,vd_c(0.000244884931879331847054404));
+          u = vd_fma(u,s.x,vd_c(0.000588505168743587154904506));
+          u = vd_fma(u,s.x,vd_c(0.00145612788922812427978848));
+          u = vd_fma(u,s.x,vd_c(0.00359208743836906619142924));
+          u = vd_fma(u,s.x,vd_c(0.00886323944362401618113356));
+          u = vd_fma(u,s.x,vd_c(0.0218694882853846389592078));
+          u = vd_fma(u,s.x,vd_c(0.0539682539781298417636002));
+          u = vd_fma(u,s.x,vd_c(0.133333333333125941821962));
+          x = dd_add_d_dd(vd_c(1.0),dd_mul_dd_dd(dd_add_d_d(vd_c(0.333333333333334980164153),
+                                                           vd_mul(u,s.x)),s));
+          x = dd_mul_dd_dd(t,x);
+          x = dd_sel(o,dd_rec(x),x);
+          u = vd_add(x.x,x.y);
+          u = vd_nanif(vd_isinf(d),u);
+          return vd_sel(vd_isnegzero(d),vd_c(-0.0),u);
+}
+
+
+/*
+     Lanes with |x| > VM_TRIGRANGEMAX (finite) are recomputed by libm.
+*/
+static __attribute__((noinline,cold))
+vd vm_trig_libm_r8(const vd x, const vd u, const md m, const int32_t fn) {
+          double xa[VD_W] __attribute__((aligned(64)));
+          double ua[VD_W] __attribute__((aligned(64)));
+          const uint32_t bits = md_bits(m);
+          int32_t i;
+          vd_store(&xa[0],x);
+          vd_store(&ua[0],u);
+          for(i = 0; i != VD_W; ++i) {
+              if(!((bits >> i) & 1U)) continue;
+              ua[i] = fn == 0 ? sin(xa[i]) : fn == 1 ? cos(xa[i]) : tan(xa[i]);
+          }
+          return vd_load(&ua[0]);
+}
+
+VM_INLINE md vm_trig_big_r8(const vd x) {
+          return md_andnot(vd_isinf(x),vd_gt(vd_abs(x),vd_c(VM_TRIGRANGEMAX)));
+}
+
+
+/*
+     atan2
+*/
+VM_INLINE vd vm_atan2k_r8(const vd y, vd x) {
+          vd s,t,u,q;
+          md p;
+          q = vd_sel(vd_lt(x,vd_c(0.0)),vd_c(-2.0),vd_c(0.0));
+          x = vd_abs(x);
+          p = vd_lt(x,y);
+          q = vd_sel(p,vd_add(q,vd_c(1.0)),q);
+          s = vd_sel(p,vd_neg(x),y);
+          t = vd_max(x,y);
+          s = vd_div(s,t);
+          t = vd_mul(s,s);
+          u = vd_c(-1.88796008463073496563746e-05);
+          u = vd_fma(u,t,vd_c(0.000209850076645816976906797));
+          u = vd_fma(u,t,vd_c(-0.00110611831486672482563471));
+          u = vd_fma(u,t,vd_c(0.00370026744188713119232403));
+          u = vd_fma(u,t,vd_c(-0.00889896195887655491740809));
+          u = vd_fma(u,t,vd_c(0.016599329773529201970117));
+          u = vd_fma(u,t,vd_c(-0.0254517624932312641616861));
+          u = vd_fma(u,t,vd_c(0.0337852580001353069993897));
+          u = vd_fma(u,t,vd_c(-0.0407629191276836500001934));
+          u = vd_fma(u,t,vd_c(0.0466667150077840625632675));
+          u = vd_fma(u,t,vd_c(-0.0523674852303482457616113));
+          u = vd_fma(u,t,vd_c(0.0587666392926673580854313));
+          u = vd_fma(u,t,vd_c(-0.0666573579361080525984562));
+          u = vd_fma(u,t,vd_c(0.0769219538311769618355029));
+          u = vd_fma(u,t,vd_c(-0.090908995008245008229153));
+          u = vd_fma(u,t,vd_c(0.111111105648261418443745));
+          u = vd_fma(u,t,vd_c(-0.14285714266771329383765));
+          u = vd_fma(u,t,vd_c(0.199999999996591265594148));
+          u = vd_fma(u,t,vd_c(-0.333333333333311110369124));
+          t = vd_fma(s,vd_mul(t,u),s);
+          return vd_fma(q,vd_c(VM_M_PI/2.0),t);
+}
+
+VM_INLINE vd vm_atan2k_u10_r8(const vd y, vd x) {
+          vd u,q;
+          vd2 s,t,xx,yy;
+          md p;
+          q  = vd_sel(vd_lt(x,vd_c(0.0)),vd_c(-2.0),vd_c(0.0));
+          x  = vd_abs(x);
+          p  = vd_lt(x,y);
+          q  = vd_sel(p,vd_add(q,vd_c(1.0)),q);
+          xx = dd_(x,vd_c(0.0));
+          yy = dd_(y,vd_c(0.0));
+          s  = dd_sel(p,dd_neg(xx),yy);
+          t  = dd_sel(p,yy,xx);
+          s  = dd_div(s,t);
+          t  = dd_normalize(dd_squ(s));
+          u = vd_c(1.06298484191448746607415e-05);
+          u = vd_fma(u,t.x,vd_c(-0.000125620649967286867384336));
+          u = vd_fma(u,t.x,vd_c(0.00070557664296393412389774));
+          u = vd_fma(u,t.x,vd_c(-0.00251865614498713360352999));
+          u = vd_fma(u,t.x,vd_c(0.00646262899036991172313504));
+          u = vd_fma(u,t.x,vd_c(-0.0128281333663399031014274));
+          u = vd_fma(u,t.x,vd_c(0.0208024799924145797902497));
+          u = vd_fma(u,t.x,vd_c(-0.0289002344784740315686289));
+          u = vd_fma(u,t.x,vd_c(0.0359785005035104590853656));
+          u = vd_fma(u,t.x,vd_c(-0.041848579703592507506027));
+          u = vd_fma(u,t.x,vd_c(0.0470843011653283988193763));
+          u = vd_fma(u,t.x,vd_c(-0.0524914210588448421068719));
+          u = vd_fma(u,t.x,vd_c(0.0587946590969581003860434));
+          u = vd_fma(u,t.x,vd_c(-0.0666620884778795497194182));
+          u = vd_fma(u,t.x,vd_c(0.0769225330296203768654095));
+          u = vd_fma(u,t.x,vd_c(-0.0909090442773387574781907));
+          u = vd_fma(u,t.x,vd_c(0.111111108376896236538123));
+          u = vd_fma(u,t.x,vd_c(-0.142857142756268568062339));
+          u = vd_fma(u,t.x,vd_c(0.199999999997977351284817));
+          u = vd_fma(u,t.x,vd_c(-0.333333333333317605173818));
+          t = dd_mul_dd_d(t,u);
+          t = dd_mul_dd_dd(s,dd_add_d_dd(vd_c(1.0),t));
+          t = dd_add2_dd_dd(dd_mul_dd_d(dd_c(1.570796326794896557998982,6.12323399573676603586882e-17),q),t);
+          return vd_add(t.x,t.y);
+}
+
+// Signed zeros, infinities and NaNs of atan2 (C99 F.9.1.4).
+VM_INLINE vd vm_atan2_fix_r8(vd r, const vd y, const vd x) {
+          const md xinf = vd_isinf(x);
+          const vd sx   = vd_mulsign(vd_c(1.0),x);
+          vd a;
+          r = vd_mulsign(r,x);
+          // x = +-Inf or 0: pi/2 - (x == +-Inf ? +-pi/2 : 0)
+          a = vd_sel(xinf,vd_mul(sx,vd_c(VM_M_PI/2.0)),vd_c(0.0));
+          r = vd_sel(md_or(xinf,vd_eq(x,vd_c(0.0))),vd_sub(vd_c(VM_M_PI/2.0),a),r);
+          a = vd_sel(xinf,vd_mul(sx,vd_c(VM_M_PI/4.0)),vd_c(0.0));
+          r = vd_sel(vd_isinf(y),vd_sub(vd_c(VM_M_PI/2.0),a),r);
+          r = vd_sel(vd_eq(y,vd_c(0.0)),vd_sel(vd_signbit(x),vd_c(VM_M_PI),vd_c(0.0)),r);
+          r = vd_mulsign(r,y);
+          return vd_nanif(md_or(vd_isnan(x),vd_isnan(y)),r);
+}
+
+
+/*
+     log, exp, pow
+*/
+VM_INLINE vd vm_log_fix_r8(vd x, const vd d) {
+          x = vd_sel(vd_eq(d,vd_c(INFINITY)),vd_c(INFINITY),x);
+          x = vd_nanif(vd_lt(d,vd_c(0.0)),x);
+          return vd_sel(vd_eq(d,vd_c(0.0)),vd_c(-INFINITY),x);
+}
+
+VM_INLINE vd vm_log_u35_r8(const vd d, const int32_t fast) {
+          vd x,x2,t,m,e;
+          e  = vd_split75(d,&m);
+          x  = vd_div(vd_add(vd_c(-1.0),m),vd_add(vd_c(1.0),m));
+          x2 = vd_mul(x,x);
+          t = vd_c(0.153487338491425068243146);
+          t = vd_fma(t,x2,vd_c(0.152519917006351951593857));
+          t = vd_fma(t,x2,vd_c(0.181863266251982985677316));
+          t = vd_fma(t,x2,vd_c(0.222221366518767365905163));
+          t = vd_fma(t,x2,vd_c(0.285714294746548025383248));
+          t = vd_fma(t,x2,vd_c(0.399999999950799600689777));
+          t = vd_fma(t,x2,vd_c(0.6666666666667778740063));
+          t = vd_fma(t,x2,vd_c(2.0));
+          x = vd_fma(x,t,vd_mul(vd_c(0.693147180559945286226764),e));
+          return fast ? x : vm_log_fix_r8(x,d);
+}
+
+VM_INLINE vd2 vm_logk_r8(const vd d) {
+          vd2 x,x2;
+          vd t,m,e;
+          e  = vd_split75(d,&m);
+          x  = dd_div(dd_add2_d_d(vd_c(-1.0),m),dd_add2_d_d(vd_c(1.0),m));
+          x2 = dd_squ(x);
+          t = vd_c(0.116255524079935043668677);
+          t = vd_fma(t,x2.x,vd_c(0.103239680901072952701192));
+          t = vd_fma(t,x2.x,vd_c(0.117754809412463995466069));
+          t = vd_fma(t,x2.x,vd_c(0.13332981086846273921509));
+          t = vd_fma(t,x2.x,vd_c(0.153846227114512262845736));
+          t = vd_fma(t,x2.x,vd_c(0.181818180850050775676507));
+          t = vd_fma(t,x2.x,vd_c(0.222222222230083560345903));
+          t = vd_fma(t,x2.x,vd_c(0.285714285714249172087875));
+          t = vd_fma(t,x2.x,vd_c(0.400000000000000077715612));
+          return dd_add2_dd_dd(dd_mul_dd_d(dd_c(0.693147180559945286226764,2.319046813846299558417771e-17),e),
+                               dd_add2_dd_dd(dd_scale(x,vd_c(2.0)),
+                                             dd_mul_dd_dd(dd_mul_dd_dd(x2,x),
+                                                          dd_add2_dd_dd(dd_mul_dd_d(x2,t),
+                                                                        dd_c(0.666666666666666629659233,
+                                                                             3.80554962542412056336616e-17)))));
+}
+
+VM_INLINE vd vm_log_u10_r8(const vd d) {
+          const vd2 s = vm_logk_r8(d);
+          return vm_log_fix_r8(vd_add(s.x,s.y),d);
+}
+
+VM_INLINE vd vm_exp_k_r8(const vd d, const int32_t fast) {
+          const vd q = vd_rint(vd_mul(d,vd_c(VM_R_LN2)));
+          vd s,u;
+          s = vd_fma(q,vd_c(-VM_L2U),d);
+          s = vd_fma(q,vd_c(-VM_L2L),s);
+          u = vd_c(2.08860621107283687536341e-09);
+          u = vd_fma(u,s,vd_c(2.51112930892876518610661e-08));
+          u = vd_fma(u,s,vd_c(2.75573911234900471893338e-07));
+          u = vd_fma(u,s,vd_c(2.75572362911928827629423e-06));
+          u = vd_fma(u,s,vd_c(2.4801587159235472998791e-05));
+          u = vd_fma(u,s,vd_c(0.000198412698960509205564975));
+          u = vd_fma(u,s,vd_c(0.00138888888889774492207962));
+          u = vd_fma(u,s,vd_c(0.00833333333331652721664984));
+          u = vd_fma(u,s,vd_c(0.0416666666666665047591422));
+          u = vd_fma(u,s,vd_c(0.166666666666666851703837));
+          u = vd_fma(u,s,vd_c(0.5));
+          u = vd_add(vd_c(1.0),vd_fma(vd_mul(s,s),u,s));
+          if(fast) return vd_mul(u,vd_pow2i(q));
+          u = vd_ldexp(u,q);
+          u = vd_sel(vd_gt(d,vd_c(709.78271114955742909217217426)),vd_c(INFINITY),u);
+          return vd_sel(vd_lt(d,vd_c(-1000.0)),vd_c(0.0),u);
+}
+
+VM_INLINE vd vm_expk_r8(const vd2 d) {
+          const vd q = vd_rint(vd_mul(vd_add(d.x,d.y),vd_c(VM_R_LN2)));
+          vd2 s,t;
+          vd u;
+          s = dd_add2_dd_d(d,vd_mul(q,vd_c(-VM_L2U)));
+          s = dd_add2_dd_d(s,vd_mul(q,vd_c(-VM_L2L)));
+          s = dd_normalize(s);
+          u = vd_c(2.51069683420950419527139e-08);
+          u = vd_fma(u,s.x,vd_c(2.76286166770270649116855e-07));
+          u = vd_fma(u,s.x,vd_c(2.75572496725023574143864e-06));
+          u = vd_fma(u,s.x,vd_c(2.48014973989819794114153e-05));
+          u = vd_fma(u,s.x,vd_c(0.000198412698809069797676111));
+          u = vd_fma(u,s.x,vd_c(0.0013888888939977128960529));
+          u = vd_fma(u,s.x,vd_c(0.00833333333332371417601081));
+          u = vd_fma(u,s.x,vd_c(0.0416666666665409524128449));
+          u = vd_fma(u,s.x,vd_c(0.166666666666666740681535));
+          u = vd_fma(u,s.x,vd_c(0.500000000000000999200722));
+          t = dd_add_dd_dd(s,dd_mul_dd_d(dd_squ(s),u));
+          t = dd_add_d_dd(vd_c(1.0),t);
+          u = vd_ldexp(vd_add(t.x,t.y),q);
+          return vd_sel(vd_lt(d.x,vd_c(-1000.0)),vd_c(0.0),u);
+}
+
+VM_INLINE vd vm_pow_u10_r8(const vd x, const vd y) {
+          const md yisint = vd_eq(vd_trunc(y),y);
+          const vd h      = vd_mul(y,vd_c(0.5));
+          const md yisodd = md_and(yisint,md_andnot(vd_eq(vd_trunc(h),h),vd_eq(y,y)));
+          const vd2 d     = dd_mul_dd_d(vm_logk_r8(vd_abs(x)),y);
+          vd r,efx,sg;
+          r  = vm_expk_r8(d);
+          r  = vd_sel(vd_gt(d.x,vd_c(709.78271114955742909217217426)),vd_c(INFINITY),r);
+          sg = vd_sel(yisint,vd_sel(yisodd,vd_c(-1.0),vd_c(1.0)),vd_c(NAN));
+          r  = vd_mul(r,vd_sel(vd_gt(x,vd_c(0.0)),vd_c(1.0),sg));
+          efx = vd_mulsign(vd_sub(vd_abs(x),vd_c(1.0)),y);
+          r  = vd_sel(vd_isinf(y),
+                      vd_sel(vd_lt(efx,vd_c(0.0)),vd_c(0.0),
+                             vd_sel(vd_eq(efx,vd_c(0.0)),vd_c(1.0),vd_c(INFINITY))),r);
+          r  = vd_sel(md_or(vd_isinf(x),vd_eq(x,vd_c(0.0))),
+                      vd_mul(vd_sel(yisodd,vd_mulsign(vd_c(1.0),x),vd_c(1.0)),
+                             vd_sel(vd_lt(vd_sel(vd_eq(x,vd_c(0.0)),vd_neg(y),y),vd_c(0.0)),
+                                    vd_c(0.0),vd_c(INFINITY))),r);
+          r  = vd_nanif(md_or(vd_isnan(x),vd_isnan(y)),r);
+          return vd_sel(md_or(vd_eq(y,vd_c(0.0)),vd_eq(x,vd_c(1.0))),vd_c(1.0),r);
+}
+
+
+/*
+     cbrt
+*/
+VM_INLINE vd vm_cbrt_fix_r8(const vd z, const vd s) {
+          vd r = vd_sel(vd_isinf(s),vd_mulsign(vd_c(INFINITY),s),z);
+          return vd_sel(vd_eq(s,vd_c(0.0)),s,r);
+}
+
+// Exponent split of cbrt: d = m*2^e, e = 3*(qu-2048) + re - 6144.
+VM_INLINE vd vm_cbrt_split_r8(const vd d, vd * __restrict m, vd * __restrict qu, vd * __restrict re) {
+          const vd e = vd_add(vd_ilogbk(vd_abs(d)),vd_c(1.0));
+          const vd t = vd_add(e,vd_c(6144.0));
+          *m  = vd_ldexp2(d,vd_neg(e));
+          *qu = vd_trunc(vd_mul(t,vd_c(1.0/3.0)));
+          *re = vd_trunc(vd_sub(t,vd_mul(*qu,vd_c(3.0))));
+          return e;
+}
+
+VM_INLINE vd vm_cbrt_poly_r8(const vd d) {
+          vd x,y;
+          x = vd_c(-0.640245898480692909870982);
+          x = vd_fma(x,d,vd_c(2.96155103020039511818595));
+          x = vd_fma(x,d,vd_c(-5.73353060922947843636166));
+          x = vd_fma(x,d,vd_c(6.03990368989458747961407));
+          x = vd_fma(x,d,vd_c(-3.85841935510444988821632));
+          x = vd_fma(x,d,vd_c(2.2307275302496609725722));
+          y = vd_mul(x,x);
+          y = vd_mul(y,y);
+          return vd_sub(x,vd_mul(vd_fms(d,y,x),vd_c(1.0/3.0)));
+}
+
+VM_INLINE vd vm_cbrt_u35_r8(const vd s, const int32_t fast) {
+          vd d,q,qu,re,x,y;
+          (void)vm_cbrt_split_r8(s,&d,&qu,&re);
+          q = vd_sel(vd_eq(re,vd_c(1.0)),vd_c(1.2599210498948731647672106),vd_c(1.0));
+          q = vd_sel(vd_eq(re,vd_c(2.0)),vd_c(1.5874010519681994747517056),q);
+          q = vd_ldexp2(q,vd_sub(qu,vd_c(2048.0)));
+          q = vd_mulsign(q,d);
+          d = vd_abs(d);
+          x = vm_cbrt_poly_r8(d);
+          y = vd_mul(vd_mul(d,x),x);
+          y = vd_mul(vd_sub(y,vd_mul(vd_mul(vd_c(2.0/3.0),y),vd_fma(y,x,vd_c(-1.0)))),q);
+          return fast ? y : vm_cbrt_fix_r8(y,s);
+}
+
+VM_INLINE vd vm_cbrt_u10_r8(const vd s) {
+          vd d,qu,re,x,y,z;
+          vd2 q2,u,v;
+          (void)vm_cbrt_split_r8(s,&d,&qu,&re);
+          q2 = dd_sel(vd_eq(re,vd_c(1.0)),dd_c(1.2599210498948731907,-2.5899333753005069177e-17),
+                      dd_c(1.0,0.0));
+          q2 = dd_sel(vd_eq(re,vd_c(2.0)),dd_c(1.5874010519681995834,-1.0869008194197822986e-16),q2);
+          q2 = dd_(vd_mulsign(q2.x,d),vd_mulsign(q2.y,d));
+          d  = vd_abs(d);
+          x  = vm_cbrt_poly_r8(d);
+          z  = x;
+          u  = dd_mul_d_d(x,x);
+          u  = dd_mul_dd_dd(u,u);
+          u  = dd_mul_dd_d(u,d);
+          u  = dd_add2_dd_d(u,vd_neg(x));
+          y  = vd_add(u.x,u.y);
+          y  = vd_mul(vd_mul(vd_c(-2.0/3.0),y),z);
+          v  = dd_add2_dd_d(dd_mul_d_d(z,z),y);
+          v  = dd_mul_dd_d(v,d);
+          v  = dd_mul_dd_dd(v,q2);
+          z  = vd_ldexp2(vd_add(v.x,v.y),vd_sub(qu,vd_c(2048.0)));
+          return vm_cbrt_fix_r8(z,s);
+}
+
+
+/*
+     fp64 tier dispatch
+*/
+VM_INLINE vd vm_sin_r8(const vd x, const int32_t tier) {
+          vd u;
+          md m;
+          if(tier == VMATH_FAST) return vm_sin_u35_r8(x,1);
+          u = tier == VMATH_U35 ? vm_sin_u35_r8(x,0) : vm_sin_u10_r8(x);
+          m = vm_trig_big_r8(x);
+          if(__builtin_expect(md_any(m),0)) u = vm_trig_libm_r8(x,u,m,0);
+          return u;
+}
+
+VM_INLINE vd vm_cos_r8(const vd x, const int32_t tier) {
+          vd u;
+          md m;
+          if(tier == VMATH_FAST) return vm_cos_u35_r8(x,1);
+          u = tier == VMATH_U35 ? vm_cos_u35_r8(x,0) : vm_cos_u10_r8(x);
+          m = vm_trig_big_r8(x);
+          if(__builtin_expect(md_any(m),0)) u = vm_trig_libm_r8(x,u,m,1);
+          return u;
+}
+
+VM_INLINE void vm_sincos_r8(const vd x, vd * __restrict s, vd * __restrict c,
+                            const int32_t tier) {
+          md m;
+          if(tier == VMATH_FAST) {
+             vm_sincos_u35_r8(x,s,c,1);
+             return;
+          }
+          if(tier == VMATH_U35)
+             vm_sincos_u35_r8(x,s,c,0);
+          else
+             vm_sincos_u10_r8(x,s,c);
+          m = vm_trig_big_r8(x);
+          if(__builtin_expect(md_any(m),0)) {
+             *s = vm_trig_libm_r8(x,*s,m,0);
+             *c = vm_trig_libm_r8(x,*c,m,1);
+          }
+}
+
+VM_INLINE vd vm_tan_r8(const vd x, const int32_t tier) {
+          vd u;
+          md m;
+          if(tier == VMATH_FAST) return vm_tan_u35_r8(x,1);
+          u = tier == VMATH_U35 ? vm_tan_u35_r8(x,0) : vm_tan_u10_r8(x);
+          m = vm_trig_big_r8(x);
+          if(__builtin_expect(md_any(m),0)) u = vm_trig_libm_r8(x,u,m,2);
+          return u;
+}
+
+VM_INLINE vd vm_atan2_r8(const vd y, const vd x, const int32_t tier) {
+          if(tier == VMATH_FAST)
+             return vd_mulsign(vd_mulsign(vm_atan2k_r8(vd_abs(y),x),x),y);
+          if(tier == VMATH_U35)
+             return vm_atan2_fix_r8(vm_atan2k_r8(vd_abs(y),x),y,x);
+          return vm_atan2_fix_r8(vm_atan2k_u10_r8(vd_abs(y),x),y,x);
+}
+
+VM_INLINE vd vm_exp_r8(const vd x, const int32_t tier) {
+          return vm_exp_k_r8(x,tier == VMATH_FAST);
+}
+
+VM_INLINE vd vm_log_r8(const vd x, const int32_t tier) {
+          if(tier == VMATH_FAST || tier == VMATH_U35) return vm_log_u35_r8(x,tier == VMATH_FAST);
+          return vm_log_u10_r8(x);
+}
+
+VM_INLINE vd vm_pow_r8(const vd x, const vd y, const int32_t tier) {
+          if(tier == VMATH_FAST) return vm_exp_k_r8(vd_mul(y,vm_log_u35_r8(x,1)),1);
+          return vm_pow_u10_r8(x,y);
+}
+
+VM_INLINE vd vm_sqrt_r8(const vd x, const int32_t tier) {
+          (void)tier;
+          return vd_sqrt(x);
+}
+
+VM_INLINE vd vm_cbrt_r8(const vd x, const int32_t tier) {
+          if(tier == VMATH_FAST || tier == VMATH_U35) return vm_cbrt_u35_r8(x,tier == VMATH_FAST);
+          return vm_cbrt_u10_r8(x);
+}
+
+
+/*
+     fp32 helpers
+*/
+VM_INLINE vf vf_negif(const mf m, const vf x) { return vf_sel(m,vf_neg(x),x); }
+
+VM_INLINE vf vf_nanif(const mf m, const vf x) { return vf_sel(m,vf_c(NAN),x); }
+
+// x*2^q for any integer-valued q (clamped to +-300, four factors).
+VM_INLINE vf vf_ldexp(const vf x, const vf q) {
+          const vf qc = vf_max(vf_c(-300.0f),vf_neg(vf_max(vf_c(-300.0f),vf_neg(q))));
+          const vf a  = vf_trunc(vf_mul(qc,vf_c(0.25f)));
+          const vf m  = vf_pow2i(a);
+          return vf_mul(vf_mul(vf_mul(vf_mul(x,m),m),m),vf_pow2i(vf_fma(a,vf_c(-3.0f),qc)));
+}
+
+// fp32 vector evaluated as two fp64 vectors.
+#define VM_PROMOTE_R4(x,expr)                                               \
+        ({ const vd _lo = vf_to_vd_lo(x);                                   \
+           const vd _hi = vf_to_vd_hi(x);                                   \
+           vd _r0,_r1;                                                      \
+           { const vd _a = _lo; _r0 = (expr); }                             \
+           { const vd _a = _hi; _r1 = (expr); }                             \
+           vd_to_vf(_r0,_r1); })
+
+#define VM_PROMOTE2_R4(x,y,expr)                                            \
+        ({ const vd _xl = vf_to_vd_lo(x), _xh = vf_to_vd_hi(x);             \
+           const vd _yl = vf_to_vd_lo(y), _yh = vf_to_vd_hi(y);             \
+           vd _r0,_r1;                                                      \
+           { const vd _a = _xl, _b = _yl; _r0 = (expr); }                   \
+           { const vd _a = _xh, _b = _yh; _r1 = (expr); }                   \
+           vd_to_vf(_r0,_r1); })
+
+VM_INLINE vf vm_cw4_r4(vf d, const vf q, const float k) {
+          d = vf_fma(q,vf_c(-VM_PI_AF*k),d);
+          d = vf_fma(q,vf_c(-VM_PI_BF*k),d);
+          d = vf_fma(q,vf_c(-VM_PI_CF*k),d);
+          return vf_fma(q,vf_c(-VM_PI_DF*k),d);
+}
+
+
+/*
+     fp32 kernels (SLEEF u35)
+*/
+VM_INLINE vf vm_sin_u35_r4(vf d, const int32_t fast) {
+          const vf r = d;
+          const vf q = vf_rint(vf_mul(d,vf_c((float)VM_M_1_PI)));
+          vf u,s;
+          d = vm_cw4_r4(d,q,1.0f);
+          s = vf_mul(d,d);
+          d = vf_negif(vf_qbit(q,1),d);
+          u = vf_c(2.6083159809786593541503e-06f);
+          u = vf_fma(u,s,vf_c(-0.0001981069071916863322258f));
+          u = vf_fma(u,s,vf_c(0.00833307858556509017944336f));
+          u = vf_fma(u,s,vf_c(-0.166666597127914428710938f));
+          u = vf_fma(s,vf_mul(u,d),d);
+          if(!fast) u = vf_sel(vf_isnegzero(r),vf_c(-0.0f),u);
+          return u;
+}
+
+VM_INLINE vf vm_cos_u35_r4(vf d) {
+          vf q,u,s;
+          q = vf_rint(vf_sub(vf_mul(d,vf_c((float)VM_M_1_PI)),vf_c(0.5f)));
+          q = vf_fma(q,vf_c(2.0f),vf_c(1.0f));
+          d = vm_cw4_r4(d,q,0.5f);
+          s = vf_mul(d,d);
+          d = vf_sel(vf_qbit(q,2),d,vf_neg(d));
+          u = vf_c(2.6083159809786593541503e-06f);
+          u = vf_fma(u,s,vf_c(-0.0001981069071916863322258f));
+          u = vf_fma(u,s,vf_c(0.00833307858556509017944336f));
+          u = vf_fma(u,s,vf_c(-0.166666597127914428710938f));
+          return vf_fma(s,vf_mul(u,d),d);
+}
+
+VM_INLINE void vm_sincos_u35_r4(const vf d, vf * __restrict ps, vf * __restrict pc,
+                                const int32_t fast) {
+          const vf q = vf_rint(vf_mul(d,vf_c((float)(2.0*VM_M_1_PI))));
+          vf u,s,t,rx,ry;
+          mf o;
+          s = vm_cw4_r4(d,q,0.5f);
+          t = s;
+          s = vf_mul(s,s);
+          u = vf_c(-0.000195169282960705459117889f);
+          u = vf_fma(u,s,vf_c(0.00833215750753879547119141f));
+          u = vf_fma(u,s,vf_c(-0.166666537523269653320312f));
+          u = vf_mul(vf_mul(u,s),t);
+          rx = vf_add(t,u);
+          if(!fast) rx = vf_sel(vf_isnegzero(d),vf_c(-0.0f),rx);
+          u = vf_c(-2.71811842367242206819355e-07f);
+          u = vf_fma(u,s,vf_c(2.47990446951007470488548e-05f));
+          u = vf_fma(u,s,vf_c(-0.00138888787478208541870117f));
+          u = vf_fma(u,s,vf_c(0.0416666641831398010253906f));
+          u = vf_fma(u,s,vf_c(-0.5f));
+          ry = vf_fma(s,u,vf_c(1.0f));
+          o  = vf_qbit(q,1);
+          *ps = vf_negif(vf_qbit(q,2),vf_sel(o,ry,rx));
+          *pc = vf_negif(vf_qbit(vf_add(q,vf_c(1.0f)),2),vf_sel(o,rx,ry));
+}
+
+VM_INLINE vf vm_tan_u35_r4(const vf d) {
+          const vf q = vf_rint(vf_mul(d,vf_c((float)(2.0*VM_M_1_PI))));
+          vf u,s,x;
+          mf o;
+          x = vm_cw4_r4(d,q,0.5f);
+          s = vf_mul(x,x);
+          o = vf_qbit(q,1);
+          x = vf_negif(o,x);
+          u = vf_c(0.00927245803177356719970703f);
+          u = vf_fma(u,s,vf_c(0.00331984995864331722259521f));
+          u = vf_fma(u,s,vf_c(0.0242998078465461730957031f));
+          u = vf_fma(u,s,vf_c(0.0534495301544666290283203f));
+          u = vf_fma(u,s,vf_c(0.133383005857467651367188f));
+          u = vf_fma(u,s,vf_c(0.333331853151321411132812f));
+          u = vf_fma(s,vf_mul(u,x),x);
+          return vf_sel(o,vf_div(vf_c(1.0f),u),u);
+}
+
+VM_INLINE mf vm_trig_big_r4(const vf x) {
+          return vf_gt(vf_abs(x),vf_c(VM_TRIGRANGEMAXF));
+}
+
+VM_INLINE vf vm_atan2k_r4(const vf y, vf x) {
+          vf s,t,u,q;
+          mf p;
+          q = vf_sel(vf_lt(x,vf_c(0.0f)),vf_c(-2.0f),vf_c(0.0f));
+          x = vf_abs(x);
+          p = vf_lt(x,y);
+          q = vf_sel(p,vf_add(q,vf_c(1.0f)),q);
+          s = vf_sel(p,vf_neg(x),y);
+          t = vf_max(x,y);
+          s = vf_div(s,t);
+          t = vf_mul(s,s);
+          u = vf_c(0.00282363896258175373077393f);
+          u = vf_fma(u,t,vf_c(-0.0159569028764963150024414f));
+          u = vf_fma(u,t,vf_c(0.0425049886107444763183594f));
+          u = vf_fma(u,t,vf_c(-0.0748900920152664184570312f));
+          u = vf_fma(u,t,vf_c(0.106347933411598205566406f));
+          u = vf_fma(u,t,vf_c(-0.142027363181114196777344f));
+          u = vf_fma(u,t,vf_c(0.199926957488059997558594f));
+          u = vf_fma(u,t,vf_c(-0.333331018686294555664062f));
+          t = vf_fma(s,vf_mul(t,u),s);
+          return vf_fma(q,vf_c((float)(VM_M_PI/2.0)),t);
+}
+
+VM_INLINE vf vm_atan2_fix_r4(vf r, const vf y, const vf x) {
+          const mf xinf = vf_isinf(x);
+          const vf sx   = vf_mulsign(vf_c(1.0f),x);
+          vf a;
+          r = vf_mulsign(r,x);
+          a = vf_sel(xinf,vf_mul(sx,vf_c((float)(VM_M_PI/2.0))),vf_c(0.0f));
+          r = vf_sel(mf_or(xinf,vf_eq(x,vf_c(0.0f))),vf_sub(vf_c((float)(VM_M_PI/2.0)),a),r);
+          a = vf_sel(xinf,vf_mul(sx,vf_c((float)(VM_M_PI/4.0))),vf_c(0.0f));
+          r = vf_sel(vf_isinf(y),vf_sub(vf_c((float)(VM_M_PI/2.0)),a),r);
+          r = vf_sel(vf_eq(y,vf_c(0.0f)),vf_sel(vf_signbit(x),vf_c((float)VM_M_PI),vf_c(0.0f)),r);
+          r = vf_mulsign(r,y);
+          return vf_nanif(mf_or(vf_isnan(x),vf_isnan(y)),r);
+}
+
+VM_INLINE vf vm_log_u35_r4(const vf d, const int32_t fast) {
+          vf x,x2,t,m,e;
+          e  = vf_split75(d,&m);
+          x  = vf_div(vf_add(vf_c(-1.0f),m),vf_add(vf_c(1.0f),m));
+          x2 = vf_mul(x,x);
+          t = vf_c(0.2392828464508056640625f);
+          t = vf_fma(t,x2,vf_c(0.28518211841583251953125f));
+          t = vf_fma(t,x2,vf_c(0.400005877017974853515625f));
+          t = vf_fma(t,x2,vf_c(0.666666686534881591796875f));
+          t = vf_fma(t,x2,vf_c(2.0f));
+          x = vf_fma(x,t,vf_mul(vf_c(0.693147180559945286226764f),e));
+          if(fast) return x;
+          x = vf_sel(vf_eq(d,vf_c(INFINITY)),vf_c(INFINITY),x);
+          x = vf_nanif(vf_lt(d,vf_c(0.0f)),x);
+          return vf_sel(vf_eq(d,vf_c(0.0f)),vf_c(-INFINITY),x);
+}
+
+VM_INLINE vf vm_exp_u35_r4(const vf d, const int32_t fast) {
+          const vf q = vf_rint(vf_mul(d,vf_c(VM_R_LN2F)));
+          vf s,u;
+          s = vf_fma(q,vf_c(-VM_L2UF),d);
+          s = vf_fma(q,vf_c(-VM_L2LF),s);
+          u = vf_c(0.000198527617612853646278381f);
+          u = vf_fma(u,s,vf_c(0.00139304355252534151077271f));
+          u = vf_fma(u,s,vf_c(0.00833336077630519866943359f));
+          u = vf_fma(u,s,vf_c(0.0416664853692054748535156f));
+          u = vf_fma(u,s,vf_c(0.166666671633720397949219f));
+          u = vf_fma(u,s,vf_c(0.5f));
+          u = vf_add(vf_c(1.0f),vf_fma(vf_mul(s,s),u,s));
+          if(fast) return vf_mul(u,vf_pow2i(q));
+          u = vf_ldexp(u,q);
+          u = vf_sel(vf_gt(d,vf_c(88.72283905206835f)),vf_c(INFINITY),u);
+          return vf_sel(vf_lt(d,vf_c(-104.0f)),vf_c(0.0f),u);
+}
+
+VM_INLINE vf vm_cbrt_u35_r4(const vf s, const int32_t fast) {
+          vf d,e,t,q,qu,re,x,y;
+          e  = vf_add(vf_ilogbk(vf_abs(s)),vf_c(1.0f));
+          d  = vf_ldexp(s,vf_neg(e));
+          t  = vf_add(e,vf_c(6144.0f));
+          qu = vf_trunc(vf_mul(t,vf_c(1.0f/3.0f)));
+          re = vf_trunc(vf_sub(t,vf_mul(qu,vf_c(3.0f))));
+          q  = vf_sel(vf_eq(re,vf_c(1.0f)),vf_c(1.2599210498948731647672106f),vf_c(1.0f));
+          q  = vf_sel(vf_eq(re,vf_c(2.0f)),vf_c(1.5874010519681994747517056f),q);
+          q  = vf_ldexp(q,vf_sub(qu,vf_c(2048.0f)));
+          q  = vf_mulsign(q,d);
+          d  = vf_abs(d);
+          x = vf_c(-0.601564466953277587890625f);
+          x = vf_fma(x,d,vf_c(2.8208892345428466796875f));
+          x = vf_fma(x,d,vf_c(-5.532182216644287109375f));
+          x = vf_fma(x,d,vf_c(5.898262500762939453125f));
+          x = vf_fma(x,d,vf_c(-3.8095417022705078125f));
+          x = vf_fma(x,d,vf_c(2.2241256237030029296875f));
+          y = vf_mul(vf_mul(d,x),x);
+          y = vf_mul(vf_sub(y,vf_mul(vf_mul(vf_c(2.0f/3.0f),y),vf_fma(y,x,vf_c(-1.0f)))),q);
+          if(fast) return y;
+          y = vf_sel(vf_isinf(s),vf_mulsign(vf_c(INFINITY),s),y);
+          return vf_sel(vf_eq(s,vf_c(0.0f)),s,y);
+}
+
+
+/*
+     fp32 tier dispatch: U05/U10 evaluate the U35 fp64 kernels and round
+     once; U35 lanes outside the fp32 reduction range do the same.
+*/
+VM_INLINE vf vm_sin_r4(const vf x, const int32_t tier) {
+          vf u;
+          mf m;
+          if(tier == VMATH_FAST) return vm_sin_u35_r4(x,1);
+          if(tier != VMATH_U35)  return VM_PROMOTE_R4(x,vm_sin_r8(_a,VMATH_U35));
+          u = vm_sin_u35_r4(x,0);
+          m = vm_trig_big_r4(x);
+          if(__builtin_expect(mf_any(m),0))
+             u = vf_sel(m,VM_PROMOTE_R4(x,vm_sin_r8(_a,VMATH_U35)),u);
+          return u;
+}
+
+VM_INLINE vf vm_cos_r4(const vf x, const int32_t tier) {
+          vf u;
+          mf m;
+          if(tier == VMATH_FAST) return vm_cos_u35_r4(x);
+          if(tier != VMATH_U35)  return VM_PROMOTE_R4(x,vm_cos_r8(_a,VMATH_U35));
+          u = vm_cos_u35_r4(x);
+          m = vm_trig_big_r4(x);
+          if(__builtin_expect(mf_any(m),0))
+             u = vf_sel(m,VM_PROMOTE_R4(x,vm_cos_r8(_a,VMATH_U35)),u);
+          return u;
+}
+
+VM_INLINE void vm_sincos_r4(const vf x, vf * __restrict s, vf * __restrict c,
+                            const int32_t tier) {
+          mf m;
+          vd s0,c0,s1,c1;
+          if(tier == VMATH_FAST) {
+             vm_sincos_u35_r4(x,s,c,1);
+             return;
+          }
+          if(tier == VMATH_U35) {
+             vm_sincos_u35_r4(x,s,c,0);
+             m = vm_trig_big_r4(x);
+             if(__builtin_expect(!mf_any(m),1)) return;
+          }
+          vm_sincos_r8(vf_to_vd_lo(x),&s0,&c0,VMATH_U35);
+          vm_sincos_r8(vf_to_vd_hi(x),&s1,&c1,VMATH_U35);
+          if(tier == VMATH_U35) {
+             *s = vf_sel(m,vd_to_vf(s0,s1),*s);
+             *c = vf_sel(m,vd_to_vf(c0,c1),*c);
+          } else {
+             *s = vd_to_vf(s0,s1);
+             *c = vd_to_vf(c0,c1);
+          }
+}
+
+VM_INLINE vf vm_tan_r4(const vf x, const int32_t tier) {
+          vf u;
+          mf m;
+          if(tier == VMATH_FAST) return vm_tan_u35_r4(x);
+          if(tier != VMATH_U35)  return VM_PROMOTE_R4(x,vm_tan_r8(_a,VMATH_U35));
+          u = vm_tan_u35_r4(x);
+          m = vm_trig_big_r4(x);
+          if(__builtin_expect(mf_any(m),0))
+             u = vf_sel(m,VM_PROMOTE_R4(x,vm_tan_r8(_a,VMATH_U35)),u);
+          return vf_sel(vf_isnegzero(x),vf_c(-0.0f),u);
+}
+
+VM_INLINE vf vm_atan2_r4(const vf y, const vf x, const int32_t tier) {
+          if(tier == VMATH_FAST)
+             return vf_mulsign(vf_mulsign(vm_atan2k_r4(vf_abs(y),x),x),y);
+          if(tier == VMATH_U35)
+             return vm_atan2_fix_r4(vm_atan2k_r4(vf_abs(y),x),y,x);
+          return VM_PROMOTE2_R4(y,x,vm_atan2_r8(_a,_b,VMATH_U35));
+}
+
+VM_INLINE vf vm_exp_r4(const vf x, const int32_t tier) {
+          if(tier == VMATH_FAST) return vm_exp_u35_r4(x,1);
+          if(tier == VMATH_U35)  return vm_exp_u35_r4(x,0);
+          return VM_PROMOTE_R4(x,vm_exp_k_r8(_a,0));
+}
+
+VM_INLINE vf vm_log_r4(const vf x, const int32_t tier) {
+          if(tier == VMATH_FAST) return vm_log_u35_r4(x,1);
+          if(tier == VMATH_U35)  return vm_log_u35_r4(x,0);
+          return VM_PROMOTE_R4(x,vm_log_u35_r8(_a,0));
+}
+
+VM_INLINE vf vm_pow_r4(const vf x, const vf y, const int32_t tier) {
+          if(tier == VMATH_FAST) return vm_exp_u35_r4(vf_mul(y,vm_log_u35_r4(x,1)),1);
+          return VM_PROMOTE2_R4(x,y,vm_pow_u10_r8(_a,_b));
+}
+
+VM_INLINE vf vm_sqrt_r4(const vf x, const int32_t tier) {
+          if(tier == VMATH_FAST) {
+             // s = x*rsqrt(x) plus one Newton-Raphson correction on the
+             // residual x - s*s; sqrt(0) = 0.
+             const vf r0 = vf_rsqrt(x);
+             const vf s  = vf_mul(x,r0);
+             const vf e  = vf_fnma(s,s,x);
+             return vf_sel(vf_eq(x,vf_c(0.0f)),x,vf_fma(vf_mul(vf_c(0.5f),r0),e,s));
+          }
+          return vf_sqrt(x);
+}
+
+VM_INLINE vf vm_cbrt_r4(const vf x, const int32_t tier) {
+          if(tier == VMATH_FAST) return vm_cbrt_u35_r4(x,1);
+          if(tier == VMATH_U35)  return vm_cbrt_u35_r4(x,0);
+          return VM_PROMOTE_R4(x,vm_cbrt_u35_r8(_a,0));
+}
+
+
+/*
+     Array loops: the tier switch sits outside the loop, the remainder goes
+     through a padded stack buffer.
+*/
+#define VM_TIER_SWITCH(tier,BODY)                                           \
+        switch(tier) {                                                      \
+        case VMATH_U05:  { const int32_t _t = VMATH_U05;  BODY; } break;    \
+        case VMATH_U10:  { const int32_t _t = VMATH_U10;  BODY; } break;    \
+        case VMATH_U35:  { const int32_t _t = VMATH_U35;  BODY; } break;    \
+        default:         { const int32_t _t = VMATH_FAST; BODY; } break;    \
+        }
+
+#define VM_LOOP_UN(T,V,W,LD,ST,KERN,x,y,n,pad)                              \
+        do {                                                                \
+           int64_t _i;                                                      \
+           for(_i = 0; _i+(W) <= (n); _i += (W))                            \
+               ST(&(y)[_i],KERN(LD(&(x)[_i]),_t));                          \
+           if(_i < (n)) {                                                   \
+              T _bx[W] __attribute__((aligned(64)));                        \
+              T _by[W] __attribute__((aligned(64)));                        \
+              int64_t _j;                                                   \
+              for(_j = 0; _j != (W); ++_j)                                  \
+                  _bx[_j] = _i+_j < (n) ? (x)[_i+_j] : (T)(pad);            \
+              ST(&_by[0],KERN(LD(&_bx[0]),_t));                             \
+              for(_j = 0; _i+_j < (n); ++_j) (y)[_i+_j] = _by[_j];          \
+           }                                                                \
+        } while(0)
+
+#define VM_LOOP_BIN(T,V,W,LD,ST,KERN,a,b,r,n,pad)                           \
+        do {                                                                \
+           int64_t _i;                                                      \
+           for(_i = 0; _i+(W) <= (n); _i += (W))                            \
+               ST(&(r)[_i],KERN(LD(&(a)[_i]),LD(&(b)[_i]),_t));             \
+           if(_i < (n)) {                                                   \
+              T _ba[W] __attribute__((aligned(64)));                        \
+              T _bb[W] __attribute__((aligned(64)));                        \
+              T _br[W] __attribute__((aligned(64)));                        \
+              int64_t _j;                                                   \
+              for(_j = 0; _j != (W); ++_j) {                                \
+                  _ba[_j] = _i+_j < (n) ? (a)[_i+_j] : (T)(pad);            \
+                  _bb[_j] = _i+_j < (n) ? (b)[_i+_j] : (T)(pad);            \
+              }                                                             \
+              ST(&_br[0],KERN(LD(&_ba[0]),LD(&_bb[0]),_t));                 \
+              for(_j = 0; _i+_j < (n); ++_j) (r)[_i+_j] = _br[_j];          \
+           }                                                                \
+        } while(0)
+
+#define VM_LOOP_SC(T,V,W,LD,ST,KERN,x,s,c,n)                                \
+        do {                                                                \
+           int64_t _i;                                                      \
+           V _s,_c;                                                         \
+           for(_i = 0; _i+(W) <= (n); _i += (W)) {                          \
+               KERN(LD(&(x)[_i]),&_s,&_c,_t);                               \
+               ST(&(s)[_i],_s);                                             \
+               ST(&(c)[_i],_c);                                             \
+           }                                                                \
+           if(_i < (n)) {                                                   \
+              T _bx[W] __attribute__((aligned(64)));                        \
+              T _bs[W] __attribute__((aligned(64)));                        \
+              T _bc[W] __attribute__((aligned(64)));                        \
+              int64_t _j;                                                   \
+              for(_j = 0; _j != (W); ++_j)                                  \
+                  _bx[_j] = _i+_j < (n) ? (x)[_i+_j] : (T)0;                \
+              KERN(LD(&_bx[0]),&_s,&_c,_t);                                 \
+              ST(&_bs[0],_s);                                               \
+              ST(&_bc[0],_c);                                               \
+              for(_j = 0; _i+_j < (n); ++_j) {                              \
+                  (s)[_i+_j] = _bs[_j];                                     \
+                  (c)[_i+_j] = _bc[_j];                                     \
+              }                                                             \
+           }                                                                \
+        } while(0)
+
+#define VM_DEF_UN(fn,kr8,kr4,pad)                                           \
+static int32_t vm_##fn##_loop_r8(const double * __restrict x,               \
+                                 double * __restrict y,                     \
+                                 const int64_t n,                           \
+                                 const int32_t tier) {                      \
+        VM_TIER_SWITCH(tier,VM_LOOP_UN(double,vd,VD_W,vd_load,vd_store,     \
+                                       kr8,x,y,n,pad))                      \
+        return 0;                                                           \
+}                                                                           \
+static int32_t vm_##fn##_loop_r4(const float * __restrict x,                \
+                                 float * __restrict y,                      \
+                                 const int64_t n,                           \
+                                 const int32_t tier) {                      \
+        VM_TIER_SWITCH(tier,VM_LOOP_UN(float,vf,VF_W,vf_load,vf_store,      \
+                                       kr4,x,y,n,pad))                      \
+        return 0;                                                           \
+}
+
+#define VM_DEF_BIN(fn,kr8,kr4,pad)                                          \
+static int32_t vm_##fn##_loop_r8(const double * __restrict a,               \
+                                 const double * __restrict b,               \
+                                 double * __restrict r,                     \
+                                 const int64_t n,                           \
+                                 const int32_t tier) {                      \
+        VM_TIER_SWITCH(tier,VM_LOOP_BIN(double,vd,VD_W,vd_load,vd_store,    \
+                                        kr8,a,b,r,n,pad))                   \
+        return 0;                                                           \
+}                                                                           \
+static int32_t vm_##fn##_loop_r4(const float * __restrict a,                \
+                                 const float * __restrict b,                \
+                                 float * __restrict r,                      \
+                                 const int64_t n,                           \
+                                 const int32_t tier) {                      \
+        VM_TIER_SWITCH(tier,VM_LOOP_BIN(float,vf,VF_W,vf_load,vf_store,     \
+                                        kr4,a,b,r,n,pad))                   \
+        return 0;                                                           \
+}
+
+VM_DEF_UN(sin,vm_sin_r8,vm_sin_r4,0.0)
+VM_DEF_UN(cos,vm_cos_r8,vm_cos_r4,0.0)
+VM_DEF_UN(tan,vm_tan_r8,vm_tan_r4,0.0)
+VM_DEF_UN(exp,vm_exp_r8,vm_exp_r4,0.0)
+VM_DEF_UN(log,vm_log_r8,vm_log_r4,1.0)
+VM_DEF_UN(sqrt,vm_sqrt_r8,vm_sqrt_r4,1.0)
+VM_DEF_UN(cbrt,vm_cbrt_r8,vm_cbrt_r4,1.0)
+VM_DEF_BIN(atan2,vm_atan2_r8,vm_atan2_r4,1.0)
+VM_DEF_BIN(pow,vm_pow_r8,vm_pow_r4,1.0)
+
+static int32_t vm_sincos_loop_r8(const double * __restrict x,
+                                 double * __restrict s,
+                                 double * __restrict c,
+                                 const int64_t n,
+                                 const int32_t tier) {
+        VM_TIER_SWITCH(tier,VM_LOOP_SC(double,vd,VD_W,vd_load,vd_store,
+                                       vm_sincos_r8,x,s,c,n))
+        return 0;
+}
+
+static int32_t vm_sincos_loop_r4(const float * __restrict x,
+                                 float * __restrict s,
+                                 float * __restrict c,
+                                 const int64_t n,
+                                 const int32_t tier) {
+        VM_TIER_SWITCH(tier,VM_LOOP_SC(float,vf,VF_W,vf_load,vf_store,
+                                       vm_sincos_r4,x,s,c,n))
+        return 0;
+}
+
+/*
+     Complex exponential and chirp phasors (interleaved re,im output).
+*/
+#define VM_2PI_H 6.283185307179586231995926937088
+#define VM_2PI_L 2.4492935982947063697e-16
+
+static const double vm_iota_r8[16] __attribute__((aligned(64))) = {
+        0.0,1.0,2.0,3.0,4.0,5.0,6.0,7.0,8.0,9.0,10.0,11.0,12.0,13.0,14.0,15.0
+};
+
+#define VM_LOOP_CIS(T,V,W,LD,STC,KERN,x,z,n)                                \
+        do {                                                                \
+           int64_t _i;                                                      \
+           V _s,_c;                                                         \
+           for(_i = 0; _i+(W) <= (n); _i += (W)) {                          \
+               KERN(LD(&(x)[_i]),&_s,&_c,_t);                               \
+               STC(&(z)[2*_i],_c,_s);                                       \
+           }                                                                \
+           if(_i < (n)) {                                                   \
+              T _bx[W] __attribute__((aligned(64)));                        \
+              T _bz[2*(W)] __attribute__((aligned(64)));                    \
+              int64_t _j;                                                   \
+              for(_j = 0; _j != (W); ++_j)                                  \
+                  _bx[_j] = _i+_j < (n) ? (x)[_i+_j] : (T)0;                \
+              KERN(LD(&_bx[0]),&_s,&_c,_t);                                 \
+              STC(&_bz[0],_c,_s);                                           \
+              for(_j = 0; _j != 2*((n)-_i); ++_j) (z)[2*_i+_j] = _bz[_j];   \
+           }                                                                \
+        } while(0)
+
+static int32_t vm_cis_loop_r8(const double * __restrict x,
+                              double * __restrict z,
+                              const int64_t n,
+                              const int32_t tier) {
+        VM_TIER_SWITCH(tier,VM_LOOP_CIS(double,vd,VD_W,vd_load,vd_store_cplx,
+                                        vm_sincos_r8,x,z,n))
+        return 0;
+}
+
+static int32_t vm_cis_loop_r4(const float * __restrict x,
+                              float * __restrict z,
+                              const int64_t n,
+                              const int32_t tier) {
+        VM_TIER_SWITCH(tier,VM_LOOP_CIS(float,vf,VF_W,vf_load,vf_store_cplx,
+                                        vm_sincos_r4,x,z,n))
+        return 0;
+}
+
+// Phase phi0 + w0*k + ha*k*k of the integer sample indices k, formed in
+// double-double and reduced to [-pi,pi] against a two-part 2pi, so long
+// chirps keep their phase to about 2^-100*|phase|.
+VM_INLINE vd vm_chirp_arg_r8(const double phi0, const double w0, const double ha, const vd k) {
+          vd2 t = dd_mul_dd_d(dd_mul_d_d(k,k),vd_c(ha));
+          vd q;
+          t = dd_add2_dd_dd(t,dd_mul_d_d(vd_c(w0),k));
+          t = dd_add2_dd_d(t,vd_c(phi0));
+          q = vd_rint(vd_mul(t.x,vd_c(1.0/(2.0*VM_M_PI))));
+          t = dd_add2_dd_dd(t,dd_mul_d_d(q,vd_c(-VM_2PI_H)));
+          t = dd_add2_dd_d(t,vd_mul(q,vd_c(-VM_2PI_L)));
+          return vd_add(t.x,t.y);
+}
+
+// (xr,xi) *= (yr,yi)
+VM_INLINE void vm_cmul_r8(vd * __restrict xr, vd * __restrict xi, const vd yr, const vd yi) {
+          const vd t = vd_fms(*xr,yr,vd_mul(*xi,yi));
+          *xi = vd_fma(*xr,yi,vd_mul(*xi,yr));
+          *xr = t;
+}
+
+// Anchor of the recurrence: z = cis(theta(k)) and the per-block rotation
+// d = cis(theta(k+w) - theta(k)).
+VM_INLINE void vm_chirp_anchor_r8(const double phi0, const double w0, const double a,
+                                  const double w, const vd k, const int32_t tier,
+                                  vd * __restrict zr, vd * __restrict zi,
+                                  vd * __restrict dr, vd * __restrict di) {
+          const vd t0 = vm_chirp_arg_r8(phi0,w0,0.5*a,k);
+          const vd t1 = vm_chirp_arg_r8(phi0,w0,0.5*a,vd_add(k,vd_c(w)));
+          vm_sincos_r8(t0,zi,zr,tier);
+          vm_sincos_r8(vd_sub(t1,t0),di,dr,tier);
+}
+
+// Blocks between anchors of the rotation mode.
+#define VM_CIS_NBLK(W) (VMATH_CIS_REANCHOR/(W) > 0 ? VMATH_CIS_REANCHOR/(W) : 1)
+
+VM_INLINE void vm_chirp_r8(const double phi0, const double w0, const double a,
+                           double * __restrict z, const int64_t n,
+                           const int32_t mode, const int32_t tier) {
+          double bz[2*VD_W] __attribute__((aligned(64)));
+          const vd iota = vd_load(&vm_iota_r8[0]);
+          vd zr = vd_c(1.0),zi = vd_c(0.0),dr = vd_c(1.0),di = vd_c(0.0),rr,ri;
+          int64_t i,j,left = 0;
+          // Lane increments advance by cis(a*W*W) per block.
+          vm_sincos_r8(vm_chirp_arg_r8(0.0,0.0,a,vd_c((double)VD_W)),&ri,&rr,tier);
+          for(i = 0; i < n; i += VD_W) {
+              const vd k = vd_add(vd_c((double)i),iota);
+              if(mode == VMATH_CIS_DIRECT) {
+                 vm_sincos_r8(vm_chirp_arg_r8(phi0,w0,0.5*a,k),&zi,&zr,tier);
+              } else if(left-- == 0) {
+                 vm_chirp_anchor_r8(phi0,w0,a,(double)VD_W,k,tier,&zr,&zi,&dr,&di);
+                 left = VM_CIS_NBLK(VD_W)-1;
+              }
+              if(i+VD_W <= n) {
+                 vd_store_cplx(&z[2*i],zr,zi);
+              } else {
+                 vd_store_cplx(&bz[0],zr,zi);
+                 for(j = 0; j != 2*(n-i); ++j) z[2*i+j] = bz[j];
+              }
+              if(mode != VMATH_CIS_DIRECT) {
+                 vm_cmul_r8(&zr,&zi,dr,di);
+                 vm_cmul_r8(&dr,&di,rr,ri);
+              }
+          }
+}
+
+// fp32 output: the phase, the anchors and the recurrence are carried in
+// fp64 (two vd halves per vf) and rounded once at the store, so both
+// modes keep full fp32 accuracy (the direct mode takes the fp64 sincos
+// of the reduced phase rather than rounding the phase to fp32 first).
+VM_INLINE void vm_chirp_r4(const double phi0, const double w0, const double a,
+                           float * __restrict z, const int64_t n,
+                           const int32_t mode, const int32_t tier) {
+          float bz[2*VF_W] __attribute__((aligned(64)));
+          const int32_t t8 = tier == VMATH_FAST ? VMATH_FAST : VMATH_U35;
+          const vd iota0 = vd_load(&vm_iota_r8[0]);
+          const vd iota1 = vd_load(&vm_iota_r8[VD_W]);
+          vd zr0 = vd_c(1.0),zi0 = vd_c(0.0),dr0 = vd_c(1.0),di0 = vd_c(0.0);
+          vd zr1 = vd_c(1.0),zi1 = vd_c(0.0),dr1 = vd_c(1.0),di1 = vd_c(0.0),rr,ri;
+          vf s,c;
+          int64_t i,j,left = 0;
+          vm_sincos_r8(vm_chirp_arg_r8(0.0,0.0,a,vd_c((double)VF_W)),&ri,&rr,t8);
+          for(i = 0; i < n; i += VF_W) {
+              const vd k0 = vd_add(vd_c((double)i),iota0);
+              const vd k1 = vd_add(vd_c((double)i),iota1);
+              if(mode == VMATH_CIS_DIRECT) {
+                 vm_sincos_r8(vm_chirp_arg_r8(phi0,w0,0.5*a,k0),&zi0,&zr0,t8);
+                 vm_sincos_r8(vm_chirp_arg_r8(phi0,w0,0.5*a,k1),&zi1,&zr1,t8);
+                 c = vd_to_vf(zr0,zr1);
+                 s = vd_to_vf(zi0,zi1);
+              } else {
+                 if(left-- == 0) {
+                    vm_chirp_anchor_r8(phi0,w0,a,(double)VF_W,k0,t8,&zr0,&zi0,&dr0,&di0);
+                    vm_chirp_anchor_r8(phi0,w0,a,(double)VF_W,k1,t8,&zr1,&zi1,&dr1,&di1);
+                    left = VM_CIS_NBLK(VF_W)-1;
+                 }
+                 c = vd_to_vf(zr0,zr1);
+                 s = vd_to_vf(zi0,zi1);
+                 vm_cmul_r8(&zr0,&zi0,dr0,di0);
+                 vm_cmul_r8(&zr1,&zi1,dr1,di1);
+                 vm_cmul_r8(&dr0,&di0,rr,ri);
+                 vm_cmul_r8(&dr1,&di1,rr,ri);
+              }
+              if(i+VF_W <= n) {
+                 vf_store_cplx(&z[2*i],c,s);
+              } else {
+                 vf_store_cplx(&bz[0],c,s);
+                 for(j = 0; j != 2*(n-i); ++j) z[2*i+j] = bz[j];
+              }
+          }
+}
+
+static int32_t vm_chirp_loop_r8(const double phi0,
+                                const double w0,
+                                const double a,
+                                double * __restrict z,
+                                const int64_t n,
+                                const int32_t mode,
+                                const int32_t tier) {
+        VM_TIER_SWITCH(tier,vm_chirp_r8(phi0,w0,a,z,n,mode,_t))
+        return 0;
+}
+
+static int32_t vm_chirp_loop_r4(const double phi0,
+                                const double w0,
+                                const double a,
+                                float * __restrict z,
+                                const int64_t n,
+                                const int32_t mode,
+                                const int32_t tier) {
+        VM_TIER_SWITCH(tier,vm_chirp_r4(phi0,w0,a,z,n,mode,_t))
+        return 0;
+}
+
+// Dispatch table of this ISA (GMS_vmath_private.h).
+const vmath_isa_tab_t VM_TAB = {
+        .un_r8  = { [VMATH_SIN]  = vm_sin_loop_r8,  [VMATH_COS]  = vm_cos_loop_r8,
+                    [VMATH_TAN]  = vm_tan_loop_r8,  [VMATH_EXP]  = vm_exp_loop_r8,
+                    [VMATH_LOG]  = vm_log_loop_r8,  [VMATH_SQRT] = vm_sqrt_loop_r8,
+                    [VMATH_CBRT] = vm_cbrt_loop_r8 },
+        .un_r4  = { [VMATH_SIN]  = vm_sin_loop_r4,  [VMATH_COS]  = vm_cos_loop_r4,
+                    [VMATH_TAN]  = vm_tan_loop_r4,  [VMATH_EXP]  = vm_exp_loop_r4,
+                    [VMATH_LOG]  = vm_log_loop_r4,  [VMATH_SQRT] = vm_sqrt_loop_r4,
+                    [VMATH_CBRT] = vm_cbrt_loop_r4 },
+        .bin_r8 = { [VMATH_ATAN2] = vm_atan2_loop_r8, [VMATH_POW] = vm_pow_loop_r8 },
+        .bin_r4 = { [VMATH_ATAN2] = vm_atan2_loop_r4, [VMATH_POW] = vm_pow_loop_r4 },
+        .sincos_r8 = vm_sincos_loop_r8,
+        .sincos_r4 = vm_sincos_loop_r4,
+        .cis_r8    = vm_cis_loop_r8,
+        .cis_r4    = vm_cis_loop_r4,
+        .chirp_r8  = vm_chirp_loop_r8,
+        .chirp_r4  = vm_chirp_loop_r4
+};
+
+
+/*
+     Register-level entry points.
+*/
+#define VM_CAT_(a,b) a##_##b
+#define VM_CAT(a,b)  VM_CAT_(a,b)
+
+#define VM_DEF_VEC(V,sfx,kind)                                              \
+V VM_CAT(vmath_sin,sfx)(const V x, const int32_t tier)  { return vm_sin_##kind(x,tier); }  \
+V VM_CAT(vmath_cos,sfx)(const V x, const int32_t tier)  { return vm_cos_##kind(x,tier); }  \
+V VM_CAT(vmath_tan,sfx)(const V x, const int32_t tier)  { return vm_tan_##kind(x,tier); }  \
+V VM_CAT(vmath_exp,sfx)(const V x, const int32_t tier)  { return vm_exp_##kind(x,tier); }  \
+V VM_CAT(vmath_log,sfx)(const V x, const int32_t tier)  { return vm_log_##kind(x,tier); }  \
+V VM_CAT(vmath_sqrt,sfx)(const V x, const int32_t tier) { return vm_sqrt_##kind(x,tier); } \
+V VM_CAT(vmath_cbrt,sfx)(const V x, const int32_t tier) { return vm_cbrt_##kind(x,tier); } \
+V VM_CAT(vmath_atan2,sfx)(const V y, const V x, const int32_t tier) {       \
+        return vm_atan2_##kind(y,x,tier);                                   \
+}                                                                           \
+V VM_CAT(vmath_pow,sfx)(const V x, const V y, const int32_t tier) {         \
+        return vm_pow_##kind(x,y,tier);                                     \
+}                                                                           \
+void VM_CAT(vmath_sincos,sfx)(const V x, V * __restrict s, V * __restrict c, \
+                              const int32_t tier) {                         \
+        vm_sincos_##kind(x,s,c,tier);                                       \
+}
+
+VM_DEF_VEC(vd,VM_SFX_R8,r8)
+VM_DEF_VEC(vf,VM_SFX_R4,r4)
@@ -0,0 +1,99 @@
+
+
+#ifndef __GMS_VMATH_PRIVATE_H__
+#define __GMS_VMATH_PRIVATE_H__
+
+//
+// Internal dispatch tables of the vector math library (GMS_vmath.h).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+
+#include <stdint.h>
+#include "GMS_vmath.h"
+#include "GMS_vmath_approx.h"
+
+
+typedef int32_t (*vmath_un_r8_fn)(const double * __restrict,
+                                  double * __restrict,
+                                  const int64_t,
+                                  const int32_t);
+
+typedef int32_t (*vmath_un_r4_fn)(const float * __restrict,
+                                  float * __restrict,
+                                  const int64_t,
+                                  const int32_t);
+
+typedef int32_t (*vmath_bin_r8_fn)(const double * __restrict,
+                                   const double * __restrict,
+                                   double * __restrict,
+                                   const int64_t,
+                                   const int32_t);
+
+typedef int32_t (*vmath_bin_r4_fn)(const float * __restrict,
+                                   const float * __restrict,
+                                   float * __restrict,
+                                   const int64_t,
+                                   const int32_t);
+
+typedef int32_t (*vmath_sc_r8_fn)(const double * __restrict,
+                                  double * __restrict,
+                                  double * __restrict,
+                                  const int64_t,
+                                  const int32_t);
+
+typedef int32_t (*vmath_sc_r4_fn)(const float * __restrict,
+                                  float * __restrict,
+                                  float * __restrict,
+                                  const int64_t,
+                                  const int32_t);
+
+typedef int32_t (*vmath_chirp_r8_fn)(const double,
+                                     const double,
+                                     const double,
+                                     double * __restrict,
+                                     const int64_t,
+                                     const int32_t,
+                                     const int32_t);
+
+typedef int32_t (*vmath_chirp_r4_fn)(const double,
+                                     const double,
+                                     const double,
+                                     float * __restrict,
+                                     const int64_t,
+                                     const int32_t,
+                                     const int32_t);
+
+// Indexed by VMATH_SIN ... VMATH_CBRT; NULL where the arity differs.
+typedef struct {
+        vmath_un_r8_fn  un_r8[VMATH_NFUNCS];
+        vmath_un_r4_fn  un_r4[VMATH_NFUNCS];
+        vmath_bin_r8_fn bin_r8[VMATH_NFUNCS];
+        vmath_bin_r4_fn bin_r4[VMATH_NFUNCS];
+        vmath_sc_r8_fn  sincos_r8;
+        vmath_sc_r4_fn  sincos_r4;
+        vmath_un_r8_fn  cis_r8;
+        vmath_un_r4_fn  cis_r4;
+        vmath_chirp_r8_fn chirp_r8;
+        vmath_chirp_r4_fn chirp_r4;
+} vmath_isa_tab_t;
+
+extern const vmath_isa_tab_t vmath_tab_avx2;
+
+extern const vmath_isa_tab_t vmath_tab_avx512;
+
+// Array loops of GMS_vmath_approx_avx512.c.
+void vmath_approx_avx512_r8(const vmath_approx_t * __restrict,
+                            const double * __restrict,
+                            double * __restrict,
+                            const int64_t);
+
+void vmath_approx_avx512_r4(const vmath_approx_t * __restrict,
+                            const float * __restrict,
+                            float * __restrict,
+                            const int64_t);
+
+
+
+
+#endif /*__GMS_VMATH_PRIVATE_H__*/
@@ -0,0 +1,459 @@
+
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "GMS_vmath.h"
+
+//
+// Accuracy harness of the vector math library: ULP errors of the array
+// drivers against long double libm references (no MPFR dependency).
+// Programmer: Bernard Gingold, contact: beniekg@gmail.com
+// 18-10-2026 23:00 PM +00200
+//
+// The reference carries 64 significand bits, i.e. 2^-11 ULP of fp64, so
+// bounds are resolved to about 0.001 ULP. Each call tests the ISA selected
+// by vmath_set_isa.
+//
+
+
+#define VM_ULP_BATCH 1024
+
+static const char * const vm_fname[VMATH_NFUNCS] = {
+        "sin","cos","sincos","tan","atan2","exp","log","pow","sqrt","cbrt"
+};
+
+static const char * const vm_tname[VMATH_NTIERS] = {
+        "U05","U10","U35","FAST"
+};
+
+// Documented bounds (ULP) per function and tier; -1: the tier is not
+// offered (r8 U05 exists for sqrt only, the drivers return -1).
+static const double vm_bound_r8[VMATH_NFUNCS][VMATH_NTIERS] = {
+        //  U05   U10   U35   FAST
+        {  -1.0,  1.0,  3.5,  3.5 },   // sin
+        {  -1.0,  1.0,  3.5,  3.5 },   // cos
+        {  -1.0,  1.0,  3.5,  3.5 },   // sincos
+        {  -1.0,  1.0,  3.5,  3.5 },   // tan
+        {  -1.0,  1.0,  3.5,  3.5 },   // atan2
+        {  -1.0,  1.0,  1.0,  1.0 },   // exp
+        {  -1.0,  1.0,  3.5,  3.5 },   // log
+        {  -1.0,  1.0,  1.0,  132.0 }, // pow (FAST: 2|y*log(x)| + 3.5, |y*log(x)| <= 64)
+        {   0.5,  0.5,  0.5,  0.5 },   // sqrt
+        {  -1.0,  1.0,  3.5,  3.5 }    // cbrt
+};
+
+static const double vm_bound_r4[VMATH_NFUNCS][VMATH_NTIERS] = {
+        //  U05     U10     U35     FAST
+        {   0.501,  0.501,  3.5,    3.5 },   // sin
+        {   0.501,  0.501,  3.5,    3.5 },   // cos
+        {   0.501,  0.501,  3.5,    3.5 },   // sincos
+        {   0.501,  0.501,  3.5,    3.5 },   // tan
+        {   0.501,  0.501,  3.5,    3.5 },   // atan2
+        {   0.501,  0.501,  3.5,    3.5 },   // exp
+        {   0.501,  0.501,  3.5,    3.5 },   // log
+        {   0.501,  0.501,  0.501,  36.0 },  // pow (FAST: |y*log(x)| <= 16)
+        {   0.5,    0.5,    0.5,    2.5 },   // sqrt (FAST: AVX2 rsqrt)
+        {   0.501,  0.501,  3.5,    3.5 }    // cbrt
+};
+
+
+double vmath_ulp_bound(const int32_t func,
+                       const int32_t prec,
+                       const int32_t tier) {
+
+         if(func < 0 || func >= VMATH_NFUNCS || tier < 0 || tier >= VMATH_NTIERS)
+            return (-1.0);
+         if(prec == 8) return (vm_bound_r8[func][tier]);
+         if(prec == 4) return (vm_bound_r4[func][tier]);
+         return (-1.0);
+}
+
+
+/*
+     Arguments
+*/
+static inline
+uint64_t vm_rng(uint64_t * __restrict s) {
+
+         uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         return (z ^ (z >> 31));
+}
+
+static inline
+double vm_urand(uint64_t * __restrict s) {
+
+         return ((double)(vm_rng(s) >> 11) * 0x1.0p-53);
+}
+
+// Uniform in [lo,hi] or, with logm set, log-uniform magnitude over the
+// range (magnitudes down to min(hi*2^-60,2^-30) when it contains zero).
+static double vm_draw(uint64_t * __restrict s,
+                      const double lo,
+                      const double hi,
+                      const int32_t logm) {
+
+         double mlo,mhi,u,v;
+         u = vm_urand(s);
+         if(!logm) return (lo*(1.0-u)+hi*u); // hi-lo may overflow
+         if(lo > 0.0) {
+            mlo = lo;
+            mhi = hi;
+         } else if(hi < 0.0) {
+            mlo = -hi;
+            mhi = -lo;
+         } else {
+            mhi = fmax(-lo,hi);
+            mlo = fmin(mhi*0x1.0p-60,0x1.0p-30);
+         }
+         v = exp(log(mlo)*(1.0-u)+log(mhi)*u);
+         v = fmin(mhi,fmax(mlo,v));
+         if(lo > 0.0) return (v);
+         if(hi < 0.0) return (-v);
+         if(vm_rng(s) & 1ULL) v = -v;
+         v = fmin(hi,fmax(lo,v));
+         return (v);
+}
+
+static int32_t vm_wide(const double lo,
+                       const double hi) {
+
+         if(lo > 0.0)  return (hi > 16.0*lo);
+         if(hi < 0.0)  return (lo < 16.0*hi);
+         return (fmax(-lo,hi) > 16.0);
+}
+
+
+/*
+     References and errors
+*/
+static long double vm_ref(const int32_t func,
+                          const long double a,
+                          const long double b,
+                          const int32_t which) {
+
+         switch(func) {
+         case VMATH_SIN:    return (sinl(a));
+         case VMATH_COS:    return (cosl(a));
+         case VMATH_SINCOS: return (which ? cosl(a) : sinl(a));
+         case VMATH_TAN:    return (tanl(a));
+         case VMATH_ATAN2:  return (atan2l(a,b));
+         case VMATH_EXP:    return (expl(a));
+         case VMATH_LOG:    return (logl(a));
+         case VMATH_POW:    return (powl(a,b));
+         case VMATH_SQRT:   return (sqrtl(a));
+         default:           return (cbrtl(a));
+         }
+}
+
+// |got - ref| in units of the last place of the precision at ref.
+static double vm_ulp_err(const long double ref,
+                         const long double got,
+                         const int32_t prec) {
+
+         const int32_t emin = prec == 8 ? -1022 : -126;
+         const int32_t mant = prec == 8 ? 52 : 23;
+         const long double rr = prec == 8 ? (long double)(double)ref :
+                                            (long double)(float)ref;
+         int32_t e;
+         if(isnan(ref)) return (isnan(got) ? 0.0 : INFINITY);
+         if(isnan(got)) return (INFINITY);
+         if(isinf(rr) || isinf(got)) {
+            if(got == rr) return (0.0);
+            if(isinf(got)) return (INFINITY);
+            // ref overflows: measure in ULPs of the largest finite value
+            return ((double)((fabsl(ref)-fabsl(got))/ldexpl(1.0L,(prec == 8 ? 1023 : 127)-mant)));
+         }
+         e = ref == 0.0L ? emin : ilogbl(ref);
+         if(e < emin) e = emin;
+         return ((double)(fabsl(got-ref)/ldexpl(1.0L,e-mant)));
+}
+
+
+/*
+     Driver calls
+*/
+static int32_t vm_call_r8(const int32_t func,
+                          const int32_t tier,
+                          const double * __restrict a,
+                          const double * __restrict b,
+                          double * __restrict r,
+                          double * __restrict r2,
+                          const int64_t n) {
+
+         switch(func) {
+         case VMATH_SIN:    return (vmath_sin_r8(a,r,n,tier));
+         case VMATH_COS:    return (vmath_cos_r8(a,r,n,tier));
+         case VMATH_SINCOS: return (vmath_sincos_r8(a,r,r2,n,tier));
+         case VMATH_TAN:    return (vmath_tan_r8(a,r,n,tier));
+         case VMATH_ATAN2:  return (vmath_atan2_r8(a,b,r,n,tier));
+         case VMATH_EXP:    return (vmath_exp_r8(a,r,n,tier));
+         case VMATH_LOG:    return (vmath_log_r8(a,r,n,tier));
+         case VMATH_POW:    return (vmath_pow_r8(a,b,r,n,tier));
+         case VMATH_SQRT:   return (vmath_sqrt_r8(a,r,n,tier));
+         default:           return (vmath_cbrt_r8(a,r,n,tier));
+         }
+}
+
+static int32_t vm_call_r4(const int32_t func,
+                          const int32_t tier,
+                          const float * __restrict a,
+                          const float * __restrict b,
+                          float * __restrict r,
+                          float * __restrict r2,
+                          const int64_t n) {
+
+         switch(func) {
+         case VMATH_SIN:    return (vmath_sin_r4(a,r,n,tier));
+         case VMATH_COS:    return (vmath_cos_r4(a,r,n,tier));
+         case VMATH_SINCOS: return (vmath_sincos_r4(a,r,r2,n,tier));
+         case VMATH_TAN:    return (vmath_tan_r4(a,r,n,tier));
+         case VMATH_ATAN2:  return (vmath_atan2_r4(a,b,r,n,tier));
+         case VMATH_EXP:    return (vmath_exp_r4(a,r,n,tier));
+         case VMATH_LOG:    return (vmath_log_r4(a,r,n,tier));
+         case VMATH_POW:    return (vmath_pow_r4(a,b,r,n,tier));
+         case VMATH_SQRT:   return (vmath_sqrt_r4(a,r,n,tier));
+         default:           return (vmath_cbrt_r4(a,r,n,tier));
+         }
+}
+
+// Evaluates n points held (as doubles) in a,b; errors of both outputs of
+// sincos are reported. Returns the driver status.
+static int32_t vm_eval(const int32_t func,
+                       const int32_t prec,
+                       const int32_t tier,
+                       const double * __restrict a,
+                       const double * __restrict b,
+                       const int64_t n,
+                       double * __restrict err,      // n
+                       long double * __restrict ref, // n (first output)
+                       double * __restrict got) {    // n (first output)
+
+         double r8[2][VM_ULP_BATCH];
+         float  a4[VM_ULP_BATCH],b4[VM_ULP_BATCH],r4[2][VM_ULP_BATCH];
+         const int32_t nout = func == VMATH_SINCOS ? 2 : 1;
+         int64_t i;
+         int32_t k,stat;
+         if(prec == 8) {
+            stat = vm_call_r8(func,tier,a,b,r8[0],r8[1],n);
+         } else {
+            for(i = 0; i != n; ++i) {
+                a4[i] = (float)a[i];
+                b4[i] = (float)b[i];
+            }
+            stat = vm_call_r4(func,tier,a4,b4,r4[0],r4[1],n);
+         }
+         if(stat != 0) return (stat);
+         for(i = 0; i != n; ++i) {
+             err[i] = 0.0;
+             for(k = 0; k != nout; ++k) {
+                 const long double rf = vm_ref(func,(long double)a[i],(long double)b[i],k);
+                 const long double g  = prec == 8 ? (long double)r8[k][i] : (long double)r4[k][i];
+                 const double      e  = vm_ulp_err(rf,g,prec);
+                 if(k == 0) {
+                    ref[i] = rf;
+                    got[i] = (double)g;
+                 }
+                 if(!(e <= err[i])) err[i] = e;
+             }
+         }
+         return (0);
+}
+
+
+/*
+     Special values (C99 Annex F): NaN results must be NaN, zero and
+     infinite results must match bit for bit, finite ones must meet the
+     bound.
+*/
+static const double vm_sv_un[] = {
+        0.0,-0.0,INFINITY,-INFINITY,NAN,1.0,-1.0,0.5,2.0,
+        DBL_MIN,-DBL_MIN,DBL_TRUE_MIN,-DBL_TRUE_MIN,FLT_MIN,-FLT_MIN,
+        0x1.0p-149,-0x1.0p-149,FLT_MAX,-FLT_MAX,DBL_MAX,-DBL_MAX,
+        710.0,-710.0,746.0,-746.0,89.0,-89.0,105.0,-105.0
+};
+
+static const double vm_sv_bin[] = {
+        0.0,-0.0,1.0,-1.0,2.0,-2.0,3.0,-3.0,0.5,-0.5,INFINITY,-INFINITY,NAN
+};
+
+static int32_t vm_special(const int32_t func,
+                          const int32_t prec,
+                          const int32_t tier,
+                          const double bound,
+                          int32_t * __restrict nbad) {
+
+         const int32_t nun  = (int32_t)(sizeof(vm_sv_un)/sizeof(vm_sv_un[0]));
+         const int32_t nbin = (int32_t)(sizeof(vm_sv_bin)/sizeof(vm_sv_bin[0]));
+         double a[VM_ULP_BATCH],b[VM_ULP_BATCH],err[VM_ULP_BATCH],got[VM_ULP_BATCH];
+         long double ref[VM_ULP_BATCH];
+         int32_t n = 0,i,j;
+         if(func == VMATH_ATAN2 || func == VMATH_POW) {
+            for(i = 0; i != nbin; ++i) {
+                for(j = 0; j != nbin; ++j) {
+                    a[n] = vm_sv_bin[i];
+                    b[n] = vm_sv_bin[j];
+                    ++n;
+                }
+            }
+         } else {
+            for(i = 0; i != nun; ++i) {
+                a[n] = vm_sv_un[i];
+                b[n] = 1.0;
+                ++n;
+            }
+         }
+         if(prec == 4) {
+            // Arguments as the fp32 driver sees them.
+            for(i = 0; i != n; ++i) {
+                a[i] = (double)(float)a[i];
+                b[i] = (double)(float)b[i];
+            }
+         }
+         *nbad = 0;
+         if(vm_eval(func,prec,tier,a,b,n,err,ref,got) != 0) {
+            *nbad = n;
+            return (n);
+         }
+         for(i = 0; i != n; ++i) {
+             const long double rr = prec == 8 ? (long double)(double)ref[i] :
+                                                (long double)(float)ref[i];
+             int32_t ok;
+             if(isnan(rr))
+                ok = isnan(got[i]);
+             else if(rr == 0.0L || isinf(rr))
+                ok = ((long double)got[i] == rr) && (!signbit(got[i]) == !signbit(rr));
+             else
+                ok = err[i] <= bound;
+             if(!ok) ++*nbad;
+         }
+         return (n);
+}
+
+
+int32_t vmath_ulp_test(const int32_t func,
+                       const int32_t prec,
+                       const int32_t tier,
+                       const double xlo,
+                       const double xhi,
+                       const double ylo,
+                       const double yhi,
+                       const int64_t npts,
+                       const uint64_t seed,
+                       vmath_ulp_report_t * __restrict rep) {
+
+         double a[VM_ULP_BATCH],b[VM_ULP_BATCH],err[VM_ULP_BATCH],got[VM_ULP_BATCH];
+         long double ref[VM_ULP_BATCH];
+         const int32_t wx = vm_wide(xlo,xhi);
+         const int32_t wy = vm_wide(ylo,yhi);
+         uint64_t s = seed;
+         double sum = 0.0;
+         int64_t done = 0,i,m;
+         if(func < 0 || func >= VMATH_NFUNCS || tier < 0 || tier >= VMATH_NTIERS ||
+            (prec != 4 && prec != 8) || npts < 0 || !(xlo <= xhi) || !(ylo <= yhi) ||
+            NULL==rep) return (-1);
+         memset(rep,0,sizeof(*rep));
+         rep->bound = vmath_ulp_bound(func,prec,tier);
+         while(done < npts) {
+             m = npts-done < VM_ULP_BATCH ? npts-done : VM_ULP_BATCH;
+             for(i = 0; i != m; ++i) {
+                 a[i] = vm_draw(&s,xlo,xhi,wx && (i & 1));
+                 b[i] = vm_draw(&s,ylo,yhi,wy && (i & 2));
+                 if(prec == 4) {
+                    a[i] = (double)(float)a[i];
+                    b[i] = (double)(float)b[i];
+                 }
+             }
+             if(vm_eval(func,prec,tier,a,b,m,err,ref,got) != 0) return (-1);
+             for(i = 0; i != m; ++i) {
+                 if(err[i] > rep->max_ulp || isnan(err[i])) {
+                    rep->max_ulp  = err[i];
+                    rep->x_at_max = a[i];
+                    rep->y_at_max = b[i];
+                 }
+                 sum += err[i];
+             }
+             done += m;
+         }
+         rep->npts     = npts;
+         rep->mean_ulp = npts > 0 ? sum/(double)npts : 0.0;
+         if(tier != VMATH_FAST)
+            rep->nspecial = vm_special(func,prec,tier,rep->bound,&rep->nspecial_bad);
+         return (0);
+}
+
+
+/*
+     Default domains: {xlo,xhi,ylo,yhi}, full tiers and VMATH_FAST.
+*/
+typedef struct { double d[4]; } vm_dom_t;
+
+static const vm_dom_t vm_dom_r8[VMATH_NFUNCS][2] = {
+        { {{-1.0e14,1.0e14,0.0,0.0}},     {{-1.0e7,1.0e7,0.0,0.0}} },      // sin
+        { {{-1.0e14,1.0e14,0.0,0.0}},     {{-1.0e7,1.0e7,0.0,0.0}} },      // cos
+        { {{-1.0e14,1.0e14,0.0,0.0}},     {{-1.0e7,1.0e7,0.0,0.0}} },      // sincos
+        { {{-1.0e14,1.0e14,0.0,0.0}},     {{-1.0e7,1.0e7,0.0,0.0}} },      // tan
+        { {{-1.0e300,1.0e300,-1.0e300,1.0e300}}, {{-1.0e300,1.0e300,-1.0e300,1.0e300}} }, // atan2
+        { {{-745.0,709.7,0.0,0.0}},       {{-708.0,709.0,0.0,0.0}} },      // exp
+        { {{DBL_TRUE_MIN,DBL_MAX,0.0,0.0}}, {{DBL_MIN,DBL_MAX,0.0,0.0}} }, // log
+        { {{1.0e-10,1.0e10,-30.0,30.0}},  {{0.0625,16.0,-23.0,23.0}} },    // pow
+        { {{DBL_TRUE_MIN,DBL_MAX,0.0,0.0}}, {{DBL_TRUE_MIN,DBL_MAX,0.0,0.0}} }, // sqrt
+        { {{-DBL_MAX,DBL_MAX,0.0,0.0}},   {{-DBL_MAX,DBL_MAX,0.0,0.0}} }   // cbrt
+};
+
+static const vm_dom_t vm_dom_r4[VMATH_NFUNCS][2] = {
+        { {{-FLT_MAX,FLT_MAX,0.0,0.0}},   {{-39000.0,39000.0,0.0,0.0}} },  // sin
+        { {{-FLT_MAX,FLT_MAX,0.0,0.0}},   {{-39000.0,39000.0,0.0,0.0}} },  // cos
+        { {{-FLT_MAX,FLT_MAX,0.0,0.0}},   {{-39000.0,39000.0,0.0,0.0}} },  // sincos
+        { {{-FLT_MAX,FLT_MAX,0.0,0.0}},   {{-39000.0,39000.0,0.0,0.0}} },  // tan
+        { {{-1.0e38,1.0e38,-1.0e38,1.0e38}}, {{-1.0e38,1.0e38,-1.0e38,1.0e38}} }, // atan2
+        { {{-104.0,88.7,0.0,0.0}},        {{-87.0,88.0,0.0,0.0}} },        // exp
+        { {{0x1.0p-149,FLT_MAX,0.0,0.0}}, {{FLT_MIN,FLT_MAX,0.0,0.0}} },   // log
+        { {{1.0e-3,1.0e3,-12.0,12.0}},    {{0.0625,16.0,-5.7,5.7}} },      // pow
+        { {{0x1.0p-149,FLT_MAX,0.0,0.0}}, {{FLT_MIN,FLT_MAX,0.0,0.0}} },   // sqrt
+        { {{-FLT_MAX,FLT_MAX,0.0,0.0}},   {{-FLT_MAX,FLT_MAX,0.0,0.0}} }   // cbrt
+};
+
+
+int32_t vmath_ulp_report(FILE * __restrict fp,
+                         const int64_t npts) {
+
+         static const char * const isa[3] = {"scalar","avx2","avx512"};
+         vmath_ulp_report_t rep;
+         int32_t f,p,t,nfail = 0;
+         if(NULL==fp || npts < 0) return (-1);
+         fprintf(fp,"vmath ULP report, ISA: %s, %lld points per case\n",
+                 isa[vmath_get_isa()],(long long)npts);
+         fprintf(fp,"%-7s %-3s %-5s %10s %10s %8s %24s %24s %9s  %s\n",
+                 "func","prc","tier","max_ulp","mean_ulp","bound","x_at_max","y_at_max",
+                 "special","");
+         for(f = 0; f != VMATH_NFUNCS; ++f) {
+             for(p = 8; p >= 4; p -= 4) {
+                 for(t = 0; t != VMATH_NTIERS; ++t) {
+                     const vm_dom_t * d = p == 8 ? &vm_dom_r8[f][t == VMATH_FAST] :
+                                                   &vm_dom_r4[f][t == VMATH_FAST];
+                     int32_t bad;
+                     if(vmath_ulp_bound(f,p,t) < 0.0) {
+                        fprintf(fp,"%-7s r%d  %-5s  not offered\n",vm_fname[f],p,vm_tname[t]);
+                        continue;
+                     }
+                     if(vmath_ulp_test(f,p,t,d->d[0],d->d[1],d->d[2],d->d[3],npts,
+                                       0x5DEECE66DULL+(uint64_t)(131*f+17*p+t),&rep) != 0) {
+                        fprintf(fp,"%-7s r%d  %-5s  test failed\n",vm_fname[f],p,vm_tname[t]);
+                        ++nfail;
+                        continue;
+                     }
+                     bad = !(rep.max_ulp <= rep.bound) || rep.nspecial_bad != 0;
+                     nfail += bad;
+                     fprintf(fp,"%-7s r%d  %-5s %10.4f %10.4f %8.3f %24.17g %24.17g %4d/%-4d  %s\n",
+                             vm_fname[f],p,vm_tname[t],rep.max_ulp,rep.mean_ulp,rep.bound,
+                             rep.x_at_max,rep.y_at_max,rep.nspecial-rep.nspecial_bad,
+                             rep.nspecial,bad ? "FAIL" : "ok");
+                 }
+             }
+         }
+         return (nfail);
+}
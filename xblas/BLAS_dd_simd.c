@@ -0,0 +1,420 @@
+
+#include <stdlib.h>
+#include <math.h>
+#include <immintrin.h>
+#include "blas_dd_simd.h"
+
+/*
+ * Vector width abstraction: the kernels below are written once against
+ * these macros.
+ */
+#if defined(__AVX512F__)
+
+#define DD_SIMD 1
+#define DD_W    8
+typedef __m512d dd_vec;
+#define DD_LOADU(p)    _mm512_loadu_pd(p)
+#define DD_STOREU(p,v) _mm512_storeu_pd(p,v)
+#define DD_SET1(s)     _mm512_set1_pd(s)
+#define DD_ZERO()      _mm512_setzero_pd()
+#define DD_ADD(a,b)    _mm512_add_pd(a,b)
+#define DD_SUB(a,b)    _mm512_sub_pd(a,b)
+#define DD_MUL(a,b)    _mm512_mul_pd(a,b)
+#define DD_FMA(a,b,c)  _mm512_fmadd_pd(a,b,c)
+#define DD_FMS(a,b,c)  _mm512_fmsub_pd(a,b,c)
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+#define DD_SIMD 1
+#define DD_W    4
+typedef __m256d dd_vec;
+#define DD_LOADU(p)    _mm256_loadu_pd(p)
+#define DD_STOREU(p,v) _mm256_storeu_pd(p,v)
+#define DD_SET1(s)     _mm256_set1_pd(s)
+#define DD_ZERO()      _mm256_setzero_pd()
+#define DD_ADD(a,b)    _mm256_add_pd(a,b)
+#define DD_SUB(a,b)    _mm256_sub_pd(a,b)
+#define DD_MUL(a,b)    _mm256_mul_pd(a,b)
+#define DD_FMA(a,b,c)  _mm256_fmadd_pd(a,b,c)
+#define DD_FMS(a,b,c)  _mm256_fmsub_pd(a,b,c)
+
+#else
+
+#define DD_SIMD 0
+
+#endif
+
+/* Below this many multiply-adds the gemv kernel stays on one thread. */
+#define DD_OMP_MIN (1 << 16)
+
+/* Rows per L1-resident accumulator block of the column-layout kernel. */
+#define DD_COL_RB  256
+
+#if DD_SIMD
+
+/*
+ * Accumulate the term (p + pe) into the unevaluated sum (s + c):
+ * s := fl(s + p), c := c + TwoSum error + pe. A product a*(xh + xt) is
+ * passed as p = fl(a*xh), pe = fma(a,xh,-p) + a*xt.
+ */
+#define DD_VACC(s,c,p,pe) do {                                  \
+      const dd_vec t_ = DD_ADD(s,p);                            \
+      const dd_vec z_ = DD_SUB(t_,s);                           \
+      const dd_vec e_ = DD_ADD(DD_SUB(s,DD_SUB(t_,z_)),         \
+                               DD_SUB(p,z_));                   \
+      c = DD_ADD(c,DD_ADD(e_,pe));                              \
+      s = t_;                                                   \
+  } while (0)
+
+#define DD_VTERM(av,xh,xt,p,pe,has_tail) do {                   \
+      p  = DD_MUL(av,xh);                                       \
+      pe = DD_FMS(av,xh,p);                                     \
+      if (has_tail) pe = DD_FMA(av,xt,pe);                      \
+  } while (0)
+
+static inline void dd_two_sum(double a, double b, double *s, double *e)
+{
+  const double t = a + b;
+  const double z = t - a;
+  *s = t;
+  *e = (a - (t - z)) + (b - z);
+}
+
+static inline void dd_acc(double *s, double *c, double p, double pe)
+{
+  double t, e;
+  dd_two_sum(*s, p, &t, &e);
+  *s = t;
+  *c += e + pe;
+}
+
+/* Fold the lanes of (s, c) into (head, tail) += sum. */
+static inline void dd_fold(dd_vec s, dd_vec c, double *head, double *tail)
+{
+  double sv[DD_W], cv[DD_W];
+  int l;
+  DD_STOREU(sv, s);
+  DD_STOREU(cv, c);
+  for (l = 0; l < DD_W; l++)
+    dd_acc(head, tail, sv[l], cv[l]);
+}
+
+/* y := round( alpha * (head + tail) + beta * y ) in double-double. */
+static inline double dd_axpby(double head, double tail, double alpha,
+			      double beta, double y)
+{
+  double p, pe, h, t, q, qe, s, e;
+
+  /* An Inf term leaves head = +-Inf (NaN for Inf - Inf) and a NaN tail;
+     head alone is then the IEEE result of the plain sum. */
+  if (!isfinite(head))
+    return (beta == 0.0) ? head * alpha : head * alpha + y * beta;
+
+  /* renormalize the accumulated pair */
+  h = head + tail;
+  t = tail - (h - head);
+
+  /* double-double * double */
+  p = h * alpha;
+  pe = fma(h, alpha, -p) + t * alpha;
+  h = p + pe;
+  t = pe - (h - p);
+  if (beta == 0.0)
+    return h;
+
+  /* double-double + double * double */
+  q = y * beta;
+  qe = fma(y, beta, -q);
+  dd_two_sum(h, q, &s, &e);
+  e += t + qe;
+  return s + e;
+}
+
+/*
+ * Four contiguous rows against one contiguous x: the x loads are shared,
+ * the four (s, c) chains are independent.
+ */
+static inline __attribute__((always_inline))
+void dd_rows4(int n, const double *a0, const double *a1, const double *a2,
+	      const double *a3, const double *xh, const double *xt,
+	      const int has_tail, double *head, double *tail)
+{
+  dd_vec s0 = DD_ZERO(), c0 = DD_ZERO();
+  dd_vec s1 = DD_ZERO(), c1 = DD_ZERO();
+  dd_vec s2 = DD_ZERO(), c2 = DD_ZERO();
+  dd_vec s3 = DD_ZERO(), c3 = DD_ZERO();
+  dd_vec p, pe;
+  int j, r;
+
+  for (r = 0; r < 4; r++)
+    head[r] = tail[r] = 0.0;
+  for (j = 0; j + DD_W <= n; j += DD_W) {
+    const dd_vec vh = DD_LOADU(&xh[j]);
+    const dd_vec vt = has_tail ? DD_LOADU(&xt[j]) : DD_ZERO();
+    DD_VTERM(DD_LOADU(&a0[j]), vh, vt, p, pe, has_tail);
+    DD_VACC(s0, c0, p, pe);
+    DD_VTERM(DD_LOADU(&a1[j]), vh, vt, p, pe, has_tail);
+    DD_VACC(s1, c1, p, pe);
+    DD_VTERM(DD_LOADU(&a2[j]), vh, vt, p, pe, has_tail);
+    DD_VACC(s2, c2, p, pe);
+    DD_VTERM(DD_LOADU(&a3[j]), vh, vt, p, pe, has_tail);
+    DD_VACC(s3, c3, p, pe);
+  }
+  for (; j < n; j++) {
+    const double *ar[4];
+    ar[0] = a0; ar[1] = a1; ar[2] = a2; ar[3] = a3;
+    for (r = 0; r < 4; r++) {
+      const double q = ar[r][j] * xh[j];
+      double qe = fma(ar[r][j], xh[j], -q);
+      if (has_tail)
+	qe = fma(ar[r][j], xt[j], qe);
+      dd_acc(&head[r], &tail[r], q, qe);
+    }
+  }
+  dd_fold(s0, c0, &head[0], &tail[0]);
+  dd_fold(s1, c1, &head[1], &tail[1]);
+  dd_fold(s2, c2, &head[2], &tail[2]);
+  dd_fold(s3, c3, &head[3], &tail[3]);
+}
+
+/* One contiguous row, four (s, c) chains over j. */
+static inline __attribute__((always_inline))
+void dd_row1(int n, const double *a, const double *xh, const double *xt,
+	     const int has_tail, double *head, double *tail)
+{
+  dd_vec s0 = DD_ZERO(), c0 = DD_ZERO();
+  dd_vec s1 = DD_ZERO(), c1 = DD_ZERO();
+  dd_vec s2 = DD_ZERO(), c2 = DD_ZERO();
+  dd_vec s3 = DD_ZERO(), c3 = DD_ZERO();
+  const dd_vec z = DD_ZERO();
+  dd_vec p, pe;
+  int j;
+
+  *head = *tail = 0.0;
+  for (j = 0; j + 4 * DD_W <= n; j += 4 * DD_W) {
+    DD_VTERM(DD_LOADU(&a[j]), DD_LOADU(&xh[j]),
+	     has_tail ? DD_LOADU(&xt[j]) : z, p, pe, has_tail);
+    DD_VACC(s0, c0, p, pe);
+    DD_VTERM(DD_LOADU(&a[j + DD_W]), DD_LOADU(&xh[j + DD_W]),
+	     has_tail ? DD_LOADU(&xt[j + DD_W]) : z, p, pe, has_tail);
+    DD_VACC(s1, c1, p, pe);
+    DD_VTERM(DD_LOADU(&a[j + 2 * DD_W]), DD_LOADU(&xh[j + 2 * DD_W]),
+	     has_tail ? DD_LOADU(&xt[j + 2 * DD_W]) : z, p, pe, has_tail);
+    DD_VACC(s2, c2, p, pe);
+    DD_VTERM(DD_LOADU(&a[j + 3 * DD_W]), DD_LOADU(&xh[j + 3 * DD_W]),
+	     has_tail ? DD_LOADU(&xt[j + 3 * DD_W]) : z, p, pe, has_tail);
+    DD_VACC(s3, c3, p, pe);
+  }
+  for (; j + DD_W <= n; j += DD_W) {
+    DD_VTERM(DD_LOADU(&a[j]), DD_LOADU(&xh[j]),
+	     has_tail ? DD_LOADU(&xt[j]) : z, p, pe, has_tail);
+    DD_VACC(s0, c0, p, pe);
+  }
+  for (; j < n; j++) {
+    const double q = a[j] * xh[j];
+    double qe = fma(a[j], xh[j], -q);
+    if (has_tail)
+      qe = fma(a[j], xt[j], qe);
+    dd_acc(head, tail, q, qe);
+  }
+  dd_fold(s0, c0, head, tail);
+  dd_fold(s1, c1, head, tail);
+  dd_fold(s2, c2, head, tail);
+  dd_fold(s3, c3, head, tail);
+}
+
+/*
+ * Row layout (incaij == 1): y(i) is a dot product of row i with x.
+ */
+static inline __attribute__((always_inline))
+void dd_gemv_rows(int leny, int lenx, double alpha, const double *a,
+		  int incai, const double *xh, const double *xt,
+		  const int has_tail, double beta, double *y, int incy)
+{
+  const int ngrp = leny / 4;
+  int g, i;
+
+#pragma omp parallel for schedule(static) default(none) \
+        shared(a,xh,xt,y) firstprivate(ngrp,leny,lenx,incai,incy,alpha,beta,has_tail) \
+        private(g) if ((double)leny * lenx >= DD_OMP_MIN)
+  for (g = 0; g < ngrp; g++) {
+    double head[4], tail[4];
+    const int i0 = 4 * g;
+    int r;
+    dd_rows4(lenx, &a[(long)i0 * incai], &a[(long)(i0 + 1) * incai],
+	     &a[(long)(i0 + 2) * incai], &a[(long)(i0 + 3) * incai],
+	     xh, xt, has_tail, head, tail);
+    for (r = 0; r < 4; r++) {
+      double *yi = &y[(long)(i0 + r) * incy];
+      *yi = dd_axpby(head[r], tail[r], alpha, beta, *yi);
+    }
+  }
+  for (i = 4 * ngrp; i < leny; i++) {
+    double head, tail;
+    double *yi = &y[(long)i * incy];
+    dd_row1(lenx, &a[(long)i * incai], xh, xt, has_tail, &head, &tail);
+    *yi = dd_axpby(head, tail, alpha, beta, *yi);
+  }
+}
+
+/*
+ * Column layout (incai == 1): the (s, c) pairs of DD_COL_RB consecutive
+ * rows stay in L1 while the columns stream by, four columns per sweep
+ * (one load/store of the pairs per four terms, contiguous unit-stride
+ * reads of A). The lanes are independent rows, so no folding is needed.
+ */
+static inline __attribute__((always_inline))
+void dd_gemv_cols(int leny, int lenx, double alpha, const double *a,
+		  int incaij, const double *xh, const double *xt,
+		  const int has_tail, double beta, double *y, int incy)
+{
+  const int nblk = (leny + DD_COL_RB - 1) / DD_COL_RB;
+  int b;
+
+#pragma omp parallel for schedule(static) default(none) \
+        shared(a,xh,xt,y) firstprivate(nblk,leny,lenx,incaij,incy,alpha,beta,has_tail) \
+        private(b) if ((double)leny * lenx >= DD_OMP_MIN)
+  for (b = 0; b < nblk; b++) {
+    double sv[DD_COL_RB] __attribute__((aligned(64)));
+    double cv[DD_COL_RB] __attribute__((aligned(64)));
+    const int i0 = b * DD_COL_RB;
+    const int rb = (leny - i0 < DD_COL_RB) ? leny - i0 : DD_COL_RB;
+    const int rv = rb - rb % DD_W;
+    int j, r;
+
+    for (r = 0; r < rb; r++)
+      sv[r] = cv[r] = 0.0;
+    for (j = 0; j + 4 <= lenx; j += 4) {
+      const double *ac[4];
+      dd_vec vh[4], vt[4];
+      int q;
+      for (q = 0; q < 4; q++) {
+	ac[q] = &a[(long) (j + q) * incaij + i0];
+	vh[q] = DD_SET1(xh[j + q]);
+	vt[q] = has_tail ? DD_SET1(xt[j + q]) : DD_ZERO();
+      }
+      for (r = 0; r < rv; r += DD_W) {
+	dd_vec s = DD_LOADU(&sv[r]), c = DD_LOADU(&cv[r]);
+	dd_vec p, pe;
+	DD_VTERM(DD_LOADU(&ac[0][r]), vh[0], vt[0], p, pe, has_tail);
+	DD_VACC(s, c, p, pe);
+	DD_VTERM(DD_LOADU(&ac[1][r]), vh[1], vt[1], p, pe, has_tail);
+	DD_VACC(s, c, p, pe);
+	DD_VTERM(DD_LOADU(&ac[2][r]), vh[2], vt[2], p, pe, has_tail);
+	DD_VACC(s, c, p, pe);
+	DD_VTERM(DD_LOADU(&ac[3][r]), vh[3], vt[3], p, pe, has_tail);
+	DD_VACC(s, c, p, pe);
+	DD_STOREU(&sv[r], s);
+	DD_STOREU(&cv[r], c);
+      }
+      for (; r < rb; r++) {
+	for (q = 0; q < 4; q++) {
+	  const double aij = ac[q][r];
+	  const double t = aij * xh[j + q];
+	  double te = fma(aij, xh[j + q], -t);
+	  if (has_tail)
+	    te = fma(aij, xt[j + q], te);
+	  dd_acc(&sv[r], &cv[r], t, te);
+	}
+      }
+    }
+    /* The last lenx % 4 columns one at a time: no padded column slots,
+       so entries of A that meet no x (Inf, NaN) never reach y. */
+    for (; j < lenx; j++) {
+      const double *aj = &a[(long) j * incaij + i0];
+      const dd_vec vh = DD_SET1(xh[j]);
+      const dd_vec vt = has_tail ? DD_SET1(xt[j]) : DD_ZERO();
+      for (r = 0; r < rv; r += DD_W) {
+	dd_vec s = DD_LOADU(&sv[r]), c = DD_LOADU(&cv[r]);
+	dd_vec p, pe;
+	DD_VTERM(DD_LOADU(&aj[r]), vh, vt, p, pe, has_tail);
+	DD_VACC(s, c, p, pe);
+	DD_STOREU(&sv[r], s);
+	DD_STOREU(&cv[r], c);
+      }
+      for (; r < rb; r++) {
+	const double t = aj[r] * xh[j];
+	double te = fma(aj[r], xh[j], -t);
+	if (has_tail)
+	  te = fma(aj[r], xt[j], te);
+	dd_acc(&sv[r], &cv[r], t, te);
+      }
+    }
+    for (r = 0; r < rb; r++) {
+      double *yi = &y[(long) (i0 + r) * incy];
+      *yi = dd_axpby(sv[r], cv[r], alpha, beta, *yi);
+    }
+  }
+}
+
+#endif /* DD_SIMD */
+
+
+int BLAS_dgemv_dd_simd(int leny, int lenx, double alpha,
+		       const double *a, int incai, int incaij,
+		       const double *head_x, const double *tail_x, int incx,
+		       double beta, double *y, int incy)
+{
+#if DD_SIMD
+  const double *xh = head_x;
+  const double *xt = tail_x;
+  double *buf = NULL;
+  int j;
+
+  if (leny <= 0)
+    return 0;
+  if (incai != 1 && incaij != 1)
+    return -1;
+
+  /* strided x is packed once (head and tail side by side) */
+  if (incx != 1) {
+    buf = (double *) malloc((size_t) lenx * (tail_x ? 2 : 1) * sizeof(double));
+    if (buf == NULL)
+      return -1;
+    for (j = 0; j < lenx; j++)
+      buf[j] = head_x[(long) j * incx];
+    xh = buf;
+    if (tail_x) {
+      for (j = 0; j < lenx; j++)
+	buf[lenx + j] = tail_x[(long) j * incx];
+      xt = buf + lenx;
+    }
+  }
+
+  if (incaij == 1) {
+    if (xt)
+      dd_gemv_rows(leny, lenx, alpha, a, incai, xh, xt, 1, beta, y, incy);
+    else
+      dd_gemv_rows(leny, lenx, alpha, a, incai, xh, xh, 0, beta, y, incy);
+  } else {
+    if (xt)
+      dd_gemv_cols(leny, lenx, alpha, a, incaij, xh, xt, 1, beta, y, incy);
+    else
+      dd_gemv_cols(leny, lenx, alpha, a, incaij, xh, xh, 0, beta, y, incy);
+  }
+
+  free(buf);
+  return 0;
+#else
+  (void) leny; (void) lenx; (void) alpha; (void) a; (void) incai;
+  (void) incaij; (void) head_x; (void) tail_x; (void) incx;
+  (void) beta; (void) y; (void) incy;
+  return -1;
+#endif
+}
+
+
+int BLAS_ddot_dd_simd(int n, const double *x, const double *y,
+		      double *head_r, double *tail_r)
+{
+#if DD_SIMD
+  double h, t;
+  dd_row1(n, x, y, y, 0, &h, &t);
+  *head_r = h + t;
+  *tail_r = t - (*head_r - h);
+  return 0;
+#else
+  (void) n; (void) x; (void) y; (void) head_r; (void) tail_r;
+  return -1;
+#endif
+}
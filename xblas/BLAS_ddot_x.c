@@ -0,0 +1,146 @@
+
+#include <math.h>
+#include "blas_extended.h"
+#include "blas_extended_private.h"
+#include "blas_dd_simd.h"
+void BLAS_ddot_x(enum blas_conj_type conj, int n, double alpha,
+		 const double *x, int incx, double beta,
+		 const double *y, int incy,
+		 double *r, enum blas_prec_type prec)
+
+/*
+ * Purpose
+ * =======
+ *
+ * This routine computes the inner product:
+ *
+ *     r <- beta * r + alpha * SUM_{i=0, n-1} x[i] * y[i].
+ *
+ * Arguments
+ * =========
+ *
+ * conj   (input) enum blas_conj_type
+ *        When x and y are complex vectors, specifies whether vector
+ *        components x[i] are used unconjugated or conjugated.
+ *
+ * n      (input) int
+ *        The length of vectors x and y.
+ *
+ * alpha  (input) double
+ *
+ * x      (input) const double*
+ *        Array of length n.
+ *
+ * incx   (input) int
+ *        The stride used to access components x[i].
+ *
+ * beta   (input) double
+ *
+ * y      (input) const double*
+ *        Array of length n.
+ *
+ * incy   (input) int
+ *        The stride used to access components y[i].
+ *
+ * r      (input/output) double*
+ *
+ * prec   (input) enum blas_prec_type
+ *        Specifies the internal precision to be used.
+ *        = blas_prec_single: single precision.
+ *        = blas_prec_double: double precision.
+ *        = blas_prec_extra : anything at least 1.5 times as accurate
+ *                            than double, and wider than 80-bits.
+ *                            We use double-double in our implementation.
+ *
+ *        With unit strides the blas_prec_extra path runs the vectorized
+ *        double-double kernel of blas_dd_simd.h.
+ */
+{
+  static const char routine_name[] = "BLAS_ddot_x";
+
+  (void) conj;			/* real vectors: no conjugation */
+
+  /* Test the input parameters. */
+  if (n < 0)
+    BLAS_error(routine_name, -2, n, NULL);
+  else if (incx == 0)
+    BLAS_error(routine_name, -5, incx, NULL);
+  else if (incy == 0)
+    BLAS_error(routine_name, -8, incy, NULL);
+
+  /* Immediate return. */
+  if ((beta == 1.0) && ((n == 0) || (alpha == 0.0)))
+    return;
+
+  switch (prec) {
+  case blas_prec_single:
+  case blas_prec_double:
+  case blas_prec_indigenous:{
+
+      int i, ix, iy;
+      double sum = 0.0;
+
+      ix = (incx > 0) ? 0 : (1 - n) * incx;
+      iy = (incy > 0) ? 0 : (1 - n) * incy;
+      for (i = 0; i < n; ++i) {
+	sum += x[ix] * y[iy];
+	ix += incx;
+	iy += incy;
+      }
+      *r = (beta == 0.0) ? sum * alpha : sum * alpha + *r * beta;
+      break;
+    }
+
+  case blas_prec_extra:{
+
+      int i, ix, iy;
+      double head_sum = 0.0, tail_sum = 0.0;
+      double head_t, tail_t, bv, s1, s2, t1;
+      FPU_FIX_DECL;
+
+      FPU_FIX_START;
+
+      if (!(incx == 1 && incy == 1 &&
+	    BLAS_ddot_dd_simd(n, x, y, &head_sum, &tail_sum) == 0)) {
+	/* strided (or no SIMD): scalar FMA TwoProd / TwoSum */
+	head_sum = tail_sum = 0.0;
+	ix = (incx > 0) ? 0 : (1 - n) * incx;
+	iy = (incy > 0) ? 0 : (1 - n) * incy;
+	for (i = 0; i < n; ++i) {
+	  const double p = x[ix] * y[iy];
+	  const double pe = fma(x[ix], y[iy], -p);
+	  s1 = head_sum + p;
+	  bv = s1 - head_sum;
+	  tail_sum += ((p - bv) + (head_sum - (s1 - bv))) + pe;
+	  head_sum = s1;
+	  ix += incx;
+	  iy += incy;
+	}
+	t1 = head_sum + tail_sum;
+	tail_sum = tail_sum - (t1 - head_sum);
+	head_sum = t1;
+      }
+
+      /* Compute double-double = double-double * double (alpha). */
+      head_t = head_sum * alpha;
+      tail_t = fma(head_sum, alpha, -head_t) + tail_sum * alpha;
+      t1 = head_t + tail_t;
+      tail_t = tail_t - (t1 - head_t);
+      head_t = t1;
+
+      if (beta != 0.0) {
+	/* Compute double-double += double * double (r * beta). */
+	const double q = *r * beta;
+	const double qe = fma(*r, beta, -q);
+	s1 = head_t + q;
+	bv = s1 - head_t;
+	s2 = ((q - bv) + (head_t - (s1 - bv))) + tail_t + qe;
+	head_t = s1 + s2;
+      }
+      *r = head_t;
+
+      FPU_FIX_STOP;
+      break;
+    }
+  }
+}
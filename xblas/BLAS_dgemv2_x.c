@@ -2,11 +2,12 @@
 #include <omp.h>
 #include "blas_extended.h"
 #include "blas_extended_private.h"
+#include "blas_dd_simd.h"
 
 void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
-		   int m, int n, double alpha, const double __restrict *a, int lda,
-		   const double __restrict *head_x, const double __restrict  *tail_x, int incx,
-		   double beta, double __restrict  *y, int incy, enum blas_prec_type prec)
+		   int m, int n, double alpha, const double *a, int lda,
+		   const double *head_x, const double *tail_x, int incx,
+		   double beta, double *y, int incy, enum blas_prec_type prec)
 
 /*
  * Purpose
@@ -72,20 +73,12 @@ void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
       int ai, aij;
       int incai, incaij;
 
-      //double __restrict *a_i = a;
-      //double __restrict *head_x_i = head_x;
-      //double__restrict  *tail_x_i = tail_x;
-      //double __restrict *y_i = y;
       double alpha_i = alpha;
       double beta_i = beta;
-      double a_elem;
-      double x_elem;
       double y_elem;
-      double prod;
       double sum;
       double sum2;
       double tmp1;
-      double tmp2;
 
 
       /* all error calls */
@@ -120,20 +113,10 @@ void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
 	incaij = 1;
       }
 
-      if (lda < leny)
+      if ((order == blas_colmajor && lda < m) ||
+	  (order == blas_rowmajor && lda < n))
 	BLAS_error(routine_name, -7, lda, NULL);
 
-#if defined(__GNUC__) && (!defined(__INTEL_COMPILER) || !defined(__ICC))
-      a = (double*)__builtin_assume_aligned(a,64);
-      head_x = (double*)__builtin_assume_aligned(head_x,64);
-      tail_x = (double*)__builtin_assume_aligned(tail_x,64);
-      y = (double*)__builtin_assume_aligned(y,64);
-#elif defined(__INTEL_COMPILER) || defined(__ICC)
-      __assume_aligned(a,64);
-      __assume_aligned(head_x,64);
-      __assume_aligned(tail_x,64);
-      __assume_aligned(y,64);
-#endif
 
       
       if (incx > 0)
@@ -164,143 +147,87 @@ void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
 	}
       } else {			/* alpha != 0 */
 
+	/* Rows are independent: each iteration derives its own row offset
+	   (ai) and y index (iy), so the row loop can be split over threads. */
 	/* if beta = 0, we can save m multiplies:
 	   y = alpha*A*head_x + alpha*A*tail_x  */
 	if (beta_i == 0.0) {
 	  if (alpha_i == 1.0) {
 	    /* save m more multiplies if alpha = 1 */
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum,sum2) shared(a_i,head_x_i,tail_x_i,y_i) private(i,aij,jx,a_elem,prod,x_elem,j,ai,iy)
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,head_x,tail_x,y,leny,lenx,incai,incaij,incx,incy,kx,ky) \
+	private(i,j,ai,aij,jx,iy,sum,sum2)
 	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
 	      sum2 = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif
-#pragma omp simd linear(j:1)
+#pragma omp simd reduction(+:sum,sum2) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = head_x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		x_elem = tail_x[jx];
-		prod = a_elem * x_elem;
-		sum2 = sum2 + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * head_x[jx];
+		sum2 = sum2 + a[aij] * tail_x[jx];
 	      }
-	      sum = sum + sum2;
-	      y[iy] = sum;
-	      ai += incai;
-	      iy += incy;
+	      y[iy] = sum + sum2;
 	    }			/* end for */
 	  } else {		/* alpha != 1 */
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum,sum2) shared(a_i,head_x_i,tail_x_i,y_i) private(i,aij,jx,a_elem,prod,x_elem,j,ai,iy,tmp1,tmp2)	    
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,head_x,tail_x,y,leny,lenx,incai,incaij,incx,incy,kx,ky,alpha_i) \
+	private(i,j,ai,aij,jx,iy,sum,sum2)
 	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
 	      sum2 = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif
-#pragma omp simd linear(j:1)	      
+#pragma omp simd reduction(+:sum,sum2) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = head_x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		x_elem = tail_x[jx];
-		prod = a_elem * x_elem;
-		sum2 = sum2 + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * head_x[jx];
+		sum2 = sum2 + a[aij] * tail_x[jx];
 	      }
-	      tmp1 = sum * alpha_i;
-	      tmp2 = sum2 * alpha_i;
-	      tmp1 = tmp1 + tmp2;
-	      y[iy] = tmp1;
-	      ai += incai;
-	      iy += incy;
+	      y[iy] = sum * alpha_i + sum2 * alpha_i;
 	    }
 	  }
 	} else {		/* beta != 0 */
 	  if (alpha_i == 1.0) {
 	    /* save m multiplies if alpha = 1 */
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum,sum2) shared(a_i,head_x_i,tail_x_i,y_i) private(i,aij,jx,a_elem,prod,x_elem,j,ai,iy,tmp1,tmp2)	    
-	  for (i = 0; i < leny; i++) {
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,head_x,tail_x,y,leny,lenx,incai,incaij,incx,incy,kx,ky,beta_i) \
+	private(i,j,ai,aij,jx,iy,sum,sum2)
+	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
 	      sum2 = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif
-#pragma omp simd linear(j:1)
+#pragma omp simd reduction(+:sum,sum2) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = head_x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		x_elem = tail_x[jx];
-		prod = a_elem * x_elem;
-		sum2 = sum2 + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * head_x[jx];
+		sum2 = sum2 + a[aij] * tail_x[jx];
 	      }
-	      sum = sum + sum2;
-	      y_elem = y[iy];
-	      tmp1 = y_elem * beta_i;
-	      tmp2 = sum + tmp1;
-	      y[iy] = tmp2;
-	      ai += incai;
-	      iy += incy;
+	      y[iy] = (sum + sum2) + y[iy] * beta_i;
 	    }
 	  } else {		/* alpha != 1, the most general form:
 				   y = alpha*A*head_x + alpha*A*tail_x + beta*y */
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum,sum2) shared(a_i,head_x_i,tail_x_i,y_i) private(i,aij,jx,a_elem,prod,x_elem,j,ai,iy,tmp1,tmp2)	    
-	   for (i = 0; i < leny; i++) {
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,head_x,tail_x,y,leny,lenx,incai,incaij,incx,incy,kx,ky,alpha_i,beta_i) \
+	private(i,j,ai,aij,jx,iy,sum,sum2)
+	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
 	      sum2 = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif
-#pragma omp simd linear(j:1)	      
+#pragma omp simd reduction(+:sum,sum2) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = head_x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		x_elem = tail_x_i[jx];
-		prod = a_elem * x_elem;
-		sum2 = sum2 + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * head_x[jx];
+		sum2 = sum2 + a[aij] * tail_x[jx];
 	      }
-	      tmp1 = sum * alpha_i;
-	      tmp2 = sum2 * alpha_i;
-	      tmp1 = tmp1 + tmp2;
-	      y_elem = y[iy];
-	      tmp2 = y_elem * beta_i;
-	      tmp1 = tmp1 + tmp2;
-	      y[iy] = tmp1;
-	      ai += incai;
-	      iy += incy;
+	      y[iy] = (sum * alpha_i + sum2 * alpha_i) + y[iy] * beta_i;
 	    }
 	  }
 	}
@@ -367,7 +294,8 @@ void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
 	incaij = 1;
       }
 
-      if (lda < leny)
+      if ((order == blas_colmajor && lda < m) ||
+	  (order == blas_rowmajor && lda < n))
 	BLAS_error(routine_name, -7, lda, NULL);
 
       FPU_FIX_START;
@@ -386,6 +314,16 @@ void BLAS_dgemv2_x(enum blas_order_type order, enum blas_trans_type trans,
       else
 	ky = (1 - leny) * incy;
 
+      /* Vectorized double-double kernels (blas_dd_simd.h); the scalar
+         code below remains the fallback. */
+      if (alpha_i != 0.0 &&
+	  BLAS_dgemv_dd_simd(leny, lenx, alpha_i, a_i, incai, incaij,
+			     head_x_i + kx, tail_x_i + kx, incx, beta_i, y_i + ky,
+			     incy) == 0) {
+	FPU_FIX_STOP;
+	break;
+      }
+
       /* No extra-precision needed for alpha = 0 */
       if (alpha_i == 0.0) {
 	if (beta_i == 0.0) {
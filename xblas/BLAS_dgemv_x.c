@@ -2,9 +2,10 @@
 #include <omp.h>
 #include "blas_extended.h"
 #include "blas_extended_private.h"
+#include "blas_dd_simd.h"
 void BLAS_dgemv_x(enum blas_order_type order, enum blas_trans_type trans,
-		  int m, int n, double alpha, double *a, int lda,
-		  double *x, int incx, double beta, double *y,
+		  int m, int n, double alpha, const double *a, int lda,
+		  const double *x, int incx, double beta, double *y,
 		  int incy, enum blas_prec_type prec)
 
 /*
@@ -70,15 +71,9 @@ void BLAS_dgemv_x(enum blas_order_type order, enum blas_trans_type trans,
       int ai, aij;
       int incai, incaij;
 
-      //const double *a_i = a;
-      //const double *x_i = x;
-      //double *y_i = y;
       double alpha_i = alpha;
       double beta_i = beta;
-      double a_elem;
-      double x_elem;
       double y_elem;
-      double prod;
       double sum;
       double tmp1;
       double tmp2;
@@ -119,15 +114,6 @@ void BLAS_dgemv_x(enum blas_order_type order, enum blas_trans_type trans,
 	  (order == blas_rowmajor && lda < n))
 	BLAS_error(routine_name, -7, lda, NULL);
 
-#if defined(__GNUC__) && (!defined(__INTEL_COMPILER) || !defined(__ICC))
-      a = (double*)__builtin_assume_aligned(a,64);
-      x = (double*)__builtin_assume_aligned(x,64);
-      y = (double*)__builtin_assume_aligned(y,64);
-#elif defined(__INTEL_COMPILER) || defined(__ICC)
-      __assume_aligned(a,64);
-      __assume_aligned(x,64);
-      __assume_aligned(y,64);
-#endif
 
 
 
@@ -160,90 +146,62 @@ void BLAS_dgemv_x(enum blas_order_type order, enum blas_trans_type trans,
 	}
       } else {
 
+	/* Rows are independent: each iteration derives its own row offset
+	   (ai) and y index (iy), so the row loop can be split over threads. */
 	/* if beta = 0, we can save m multiplies: y = alpha*A*x */
 	if (beta_i == 0.0) {
 	  /* save m more multiplies if alpha = 1 */
 	  if (alpha_i == 1.0) {
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum) shared(a_i,x_i,y_i) private(i,aij,jx,j,a_elem,x_elem,prod,ai,yi)
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,x,y,leny,lenx,incai,incaij,incx,incy,kx,ky) \
+	private(i,j,ai,aij,jx,iy,sum)
 	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif
-#pragma omp simd linear(j:1)
+#pragma omp simd reduction(+:sum) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * x[jx];
 	      }
 	      y[iy] = sum;
-	      ai += incai;
-	      iy += incy;
 	    }
 	  } else {
-	    ai = 0;
-	    iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum) shared(a_i,x_i,y_i) private(i,aij,jx,j,a_elem,x_elem,prod,ai,yi,tmp1)	    
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,x,y,leny,lenx,incai,incaij,incx,incy,kx,ky,alpha_i) \
+	private(i,j,ai,aij,jx,iy,sum)
 	    for (i = 0; i < leny; i++) {
+	      ai = i * incai;
+	      iy = ky + i * incy;
 	      sum = 0.0;
-	      aij = ai;
-	      jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif	      
-#pragma omp simd linear(j:1)
+#pragma omp simd reduction(+:sum) private(aij,jx)
 	      for (j = 0; j < lenx; j++) {
-		a_elem = a[aij];
-
-		x_elem = x[jx];
-		prod = a_elem * x_elem;
-		sum = sum + prod;
-		aij += incaij;
-		jx += incx;
+		aij = ai + j * incaij;
+		jx = kx + j * incx;
+		sum = sum + a[aij] * x[jx];
 	      }
-	      tmp1 = sum * alpha_i;
-	      y[iy] = tmp1;
-	      ai += incai;
-	      iy += incy;
+	      y[iy] = sum * alpha_i;
 	    }
 	  }
 	} else {
 	  /* the most general form, y = alpha*A*x + beta*y */
-	  ai = 0;
-	  iy = ky;
-#pragma omp parallel for schedule(static,4) default(none) reduction(+:sum) shared(a_i,x_i,y_i) private(i,aij,jx,j,a_elem,x_elem,prod,ai,yi,tmp1,tmp2,y_elem)	  
+#pragma omp parallel for schedule(static,4) default(none) \
+	shared(a,x,y,leny,lenx,incai,incaij,incx,incy,kx,ky,alpha_i,beta_i) \
+	private(i,j,ai,aij,jx,iy,sum,tmp1,tmp2)
 	  for (i = 0; i < leny; i++) {
-	    sum = 0.0;;
-	    aij = ai;
-	    jx = kx;
-#if defined(__INTEL_COMPILER) || defined(__ICC)
-#pragma code_align(16)
-#endif	    
-#pragma omp simd linear(j:1)
+	    ai = i * incai;
+	    iy = ky + i * incy;
+	    sum = 0.0;
+#pragma omp simd reduction(+:sum) private(aij,jx)
 	    for (j = 0; j < lenx; j++) {
-	      a_elem = a[aij];
-
-	      x_elem = x[jx];
-	      prod = a_elem * x_elem;
-	      sum = sum + prod;
-	      aij += incaij;
-	      jx += incx;
+	      aij = ai + j * incaij;
+	      jx = kx + j * incx;
+	      sum = sum + a[aij] * x[jx];
 	    }
 	    tmp1 = sum * alpha_i;
-	    y_elem = y[iy];
-	    tmp2 = y_elem * beta_i;
-	    tmp1 = tmp1 + tmp2;
-	    y[iy] = tmp1;
-	    ai += incai;
-	    iy += incy;
+	    tmp2 = y[iy] * beta_i;
+	    y[iy] = tmp1 + tmp2;
 	  }
 	}
 
@@ -326,6 +284,16 @@ void BLAS_dgemv_x(enum blas_order_type order, enum blas_trans_type trans,
       else
 	ky = (1 - leny) * incy;
 
+      /* Vectorized double-double kernels (blas_dd_simd.h); the scalar
+         code below remains the fallback. */
+      if (alpha_i != 0.0 &&
+	  BLAS_dgemv_dd_simd(leny, lenx, alpha_i, a_i, incai, incaij,
+			     x_i + kx, NULL, incx, beta_i, y_i + ky,
+			     incy) == 0) {
+	FPU_FIX_STOP;
+	break;
+      }
+
       /* No extra-precision needed for alpha = 0 */
       if (alpha_i == 0.0) {
 	if (beta_i == 0.0) {
@@ -0,0 +1,32 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include "blas_extended.h"
+
+/*
+ * Purpose
+ * =======
+ *
+ * Error handler of the extended BLAS: reports an illegal argument
+ * (iflag < 0 is minus the argument position, ival its value) or prints
+ * the message form, then stops the program with iflag.
+ *
+ */
+void BLAS_error(const char *rname, int iflag, int ival, char *form, ...)
+{
+  va_list argptr;
+
+  va_start(argptr, form);
+  fprintf(stderr, "Error #%d from routine %s:\n", iflag, rname);
+  if (form)
+    vfprintf(stderr, form, argptr);
+  else if (iflag < 0)
+    fprintf(stderr,
+	    "  Parameter number %d to routine %s had the illegal value %d\n",
+	    -iflag, rname, ival);
+  else
+    fprintf(stderr, "  Unknown error code %d from routine %s\n",
+	    iflag, rname);
+  va_end(argptr);
+  exit(iflag);
+}
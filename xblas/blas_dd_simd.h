@@ -0,0 +1,37 @@
+#ifndef BLAS_DD_SIMD_H
+#define BLAS_DD_SIMD_H
+
+/*
+ * Vectorized double-double kernels for the blas_prec_extra paths.
+ *
+ * Products are split with FMA (TwoProd: p = a*b, e = fma(a,b,-p)) instead
+ * of Dekker's split, sums use Knuth's TwoSum, and the (head, tail) pairs
+ * live in AVX-512 (8 lanes) or AVX2/FMA (4 lanes) registers, selected at
+ * compile time from the target ISA. Lanes are folded to one double-double
+ * with TwoSum at the end of every dot product, so the result satisfies the
+ * prec_extra contract (at least 1.5x double precision); it is not bitwise
+ * equal to the scalar Dekker code.
+ *
+ * The kernels return 0 when they computed the result and -1 when the
+ * caller has to use its scalar path (no SIMD ISA, unsupported layout,
+ * allocation failure).
+ */
+
+/*
+ * y(i) = alpha * sum_j A(i,j) * (head_x(j) + tail_x(j)) + beta * y(i),
+ * i < leny, j < lenx. Element (i,j) is a[i*incai + j*incaij]; one of
+ * incai/incaij must be 1. x and y point to the first element of the
+ * traversal (x + kx, y + ky); tail_x may be NULL.
+ */
+int BLAS_dgemv_dd_simd(int leny, int lenx, double alpha,
+		       const double *a, int incai, int incaij,
+		       const double *head_x, const double *tail_x, int incx,
+		       double beta, double *y, int incy);
+
+/*
+ * (head_r, tail_r) = sum_i x(i) * y(i) in double-double, unit strides.
+ */
+int BLAS_ddot_dd_simd(int n, const double *x, const double *y,
+		      double *head_r, double *tail_r);
+
+#endif /* BLAS_DD_SIMD_H */